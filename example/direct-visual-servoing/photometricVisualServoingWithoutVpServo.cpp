@@ -367,19 +367,19 @@ int main(int argc, const char **argv)
     sId.buildFrom(Id);
 
     // Matrice d'interaction, Hessien, erreur,...
-    vpMatrix Lsd;      // matrice d'interaction a la position desiree
     vpMatrix Hsd;      // hessien a la position desiree
     vpMatrix H;        // Hessien utilise pour le levenberg-Marquartd
     vpColVector error; // Erreur I-I*
+    vpColVector LsdTe; // L^T e, L etant calcule a la position desiree
 
-    // Compute the interaction matrix
-    // link the variation of image intensity to camera motion
-
-    // here it is computed at the desired position
-    sId.interaction(Lsd);
-
-    // Compute the Hessian H = L^TL
-    Hsd = Lsd.AtA();
+    // The interaction matrix links the variation of image intensity to
+    // camera motion. Here it is computed at the desired position, and only
+    // the normal equations H = L^TL and L^Te are needed: they are
+    // accumulated without building the interaction matrix that has one row
+    // per pixel. Hsd is constant and computed once here, only L^Te is
+    // computed at each iteration
+    error.resize(sId.dimension_s());
+    sId.normalEquations(error, Hsd, LsdTe);
 
     // Compute the Hessian diagonal for the Levenberg-Marquartd
     // optimization process
@@ -457,8 +457,10 @@ int main(int argc, const char **argv)
         {
           H = ((mu * diagHsd) + Hsd).inverseByLU();
         }
-        //	compute the control law
-        e = H * Lsd.t() * error;
+        //	compute the control law, Hsd being constant only L^T e is
+        //	computed
+        sId.interactionTransposeTimes(error, LsdTe);
+        e = H * LsdTe;
 
         v = -lambda * e;
       }
@@ -0,0 +1,245 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Homogeneous matrix with inline storage.
+ *
+ *****************************************************************************/
+
+#ifndef vpFIXEDHOMOGENEOUSMATRIX_H
+#define vpFIXEDHOMOGENEOUSMATRIX_H
+
+/*!
+  \file vpFixedHomogeneousMatrix.h
+  \brief Homogeneous matrix with inline storage.
+*/
+
+#include <visp3/core/vpFixedRotationMatrix.h>
+#include <visp3/core/vpFixedThetaUVector.h>
+#include <visp3/core/vpFixedTranslationVector.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+
+/*!
+  \class vpFixedHomogeneousMatrix
+
+  \ingroup group_core_transformations
+
+  \brief Homogeneous matrix whose values are stored in the object itself.
+
+  This is the counterpart of vpHomogeneousMatrix that never allocates memory.
+  Only the first three rows \f$ [{\bf R} \; {\bf t}] \f$ are stored, row-major,
+  the last one being always \f$ [0 \; 0 \; 0 \; 1] \f$. Since this layout is
+  also the one of the first twelve values of a vpHomogeneousMatrix, the
+  unrolled compose(), inverse() and apply() kernels operate on both types.
+
+  \code
+#include <visp3/core/vpFixedHomogeneousMatrix.h>
+
+int main()
+{
+  vpFixedHomogeneousMatrix cMo(vpFixedTranslationVector(0.1, 0, 0.5), vpFixedThetaUVector(0, 0, M_PI / 4));
+  vpFixedHomogeneousMatrix oMc = cMo.inverse();
+  vpFixedHomogeneousMatrix cMc = cMo * oMc; // Identity
+
+  vpHomogeneousMatrix M = cMo; // Conversion when a vpHomogeneousMatrix is expected
+}
+  \endcode
+
+  \sa vpFixedRotationMatrix, vpFixedTranslationVector, vpFixedVelocityTwistMatrix
+*/
+class vpFixedHomogeneousMatrix
+{
+public:
+  //! Default constructor that initializes the matrix to identity.
+  vpFixedHomogeneousMatrix() { eye(); }
+
+  //! Construct an homogeneous matrix from a translation and a rotation matrix.
+  vpFixedHomogeneousMatrix(const vpFixedTranslationVector &t, const vpFixedRotationMatrix &R) { buildFrom(t, R); }
+
+  //! Construct an homogeneous matrix from a translation and a \f$\theta {\bf u}\f$ vector.
+  vpFixedHomogeneousMatrix(const vpFixedTranslationVector &t, const vpFixedThetaUVector &tu) { buildFrom(t, tu); }
+
+  //! Construct an homogeneous matrix from a vpHomogeneousMatrix.
+  explicit vpFixedHomogeneousMatrix(const vpHomogeneousMatrix &M)
+  {
+    for (unsigned int i = 0; i < 12; i++) {
+      m_data[i] = M.data[i];
+    }
+  }
+
+  //! Build the homogeneous matrix from a translation and a rotation matrix.
+  inline vpFixedHomogeneousMatrix &buildFrom(const vpFixedTranslationVector &t, const vpFixedRotationMatrix &R)
+  {
+    for (unsigned int i = 0; i < 3; i++) {
+      m_data[4 * i] = R[i][0];
+      m_data[4 * i + 1] = R[i][1];
+      m_data[4 * i + 2] = R[i][2];
+      m_data[4 * i + 3] = t[i];
+    }
+    return *this;
+  }
+
+  //! Build the homogeneous matrix from a translation and a \f$\theta {\bf u}\f$ vector.
+  inline vpFixedHomogeneousMatrix &buildFrom(const vpFixedTranslationVector &t, const vpFixedThetaUVector &tu)
+  {
+    return buildFrom(t, vpFixedRotationMatrix(tu));
+  }
+
+  //! Set the matrix to identity.
+  inline void eye()
+  {
+    for (unsigned int i = 0; i < 12; i++) {
+      m_data[i] = 0.;
+    }
+    m_data[0] = m_data[5] = m_data[10] = 1.;
+  }
+
+  //! Rotation part of the matrix.
+  inline vpFixedRotationMatrix getRotationMatrix() const
+  {
+    vpFixedRotationMatrix R;
+    for (unsigned int i = 0; i < 3; i++) {
+      R[i][0] = m_data[4 * i];
+      R[i][1] = m_data[4 * i + 1];
+      R[i][2] = m_data[4 * i + 2];
+    }
+    return R;
+  }
+
+  //! Translation part of the matrix.
+  inline vpFixedTranslationVector getTranslationVector() const
+  {
+    return vpFixedTranslationVector(m_data[3], m_data[7], m_data[11]);
+  }
+
+  //! Inverse of the homogeneous matrix.
+  inline vpFixedHomogeneousMatrix inverse() const
+  {
+    vpFixedHomogeneousMatrix Mi;
+    inverse(m_data, Mi.m_data);
+    return Mi;
+  }
+
+  //! Conversion to a vpHomogeneousMatrix.
+  inline operator vpHomogeneousMatrix() const
+  {
+    vpHomogeneousMatrix M;
+    for (unsigned int i = 0; i < 12; i++) {
+      M.data[i] = m_data[i];
+    }
+    return M;
+  }
+
+  /*!
+    Pointer to the row \e i < 3, so that \e M[i][j] is the element of row
+    \e i and column \e j.
+  */
+  inline double *operator[](unsigned int i) { return m_data + 4 * i; }
+  /*!
+    Pointer to the row \e i < 3, so that \e M[i][j] is the element of row
+    \e i and column \e j.
+  */
+  inline const double *operator[](unsigned int i) const { return m_data + 4 * i; }
+
+  //! Product of two homogeneous matrices.
+  inline vpFixedHomogeneousMatrix operator*(const vpFixedHomogeneousMatrix &M) const
+  {
+    vpFixedHomogeneousMatrix res;
+    compose(m_data, M.m_data, res.m_data);
+    return res;
+  }
+
+  //! Right-multiply the matrix by another homogeneous matrix.
+  inline vpFixedHomogeneousMatrix &operator*=(const vpFixedHomogeneousMatrix &M)
+  {
+    double res[12];
+    compose(m_data, M.m_data, res);
+    for (unsigned int i = 0; i < 12; i++) {
+      m_data[i] = res[i];
+    }
+    return *this;
+  }
+
+  //! Change of frame of a 3D point.
+  inline vpFixedTranslationVector operator*(const vpFixedTranslationVector &p) const
+  {
+    vpFixedTranslationVector res;
+    apply(m_data, &p[0], &res[0]);
+    return res;
+  }
+
+  /*!
+    Unrolled product \f$ {^a}{\bf M}_c = {^a}{\bf M}_b \; {^b}{\bf M}_c \f$
+    of two homogeneous matrices given by their first three rows stored
+    row-major. \e aMc must not be one of the inputs.
+  */
+  static inline void compose(const double *aMb, const double *bMc, double *aMc)
+  {
+    for (unsigned int i = 0; i < 12; i += 4) {
+      const double r0 = aMb[i], r1 = aMb[i + 1], r2 = aMb[i + 2];
+      aMc[i] = r0 * bMc[0] + r1 * bMc[4] + r2 * bMc[8];
+      aMc[i + 1] = r0 * bMc[1] + r1 * bMc[5] + r2 * bMc[9];
+      aMc[i + 2] = r0 * bMc[2] + r1 * bMc[6] + r2 * bMc[10];
+      aMc[i + 3] = r0 * bMc[3] + r1 * bMc[7] + r2 * bMc[11] + aMb[i + 3];
+    }
+  }
+
+  /*!
+    Unrolled inverse \f$ {^b}{\bf M}_a = [{\bf R}^\top \; -{\bf R}^\top
+    {\bf t}] \f$ of an homogeneous matrix given by its first three rows
+    stored row-major. \e bMa must not be \e aMb.
+  */
+  static inline void inverse(const double *aMb, double *bMa)
+  {
+    for (unsigned int i = 0; i < 3; i++) {
+      bMa[4 * i] = aMb[i];
+      bMa[4 * i + 1] = aMb[4 + i];
+      bMa[4 * i + 2] = aMb[8 + i];
+      bMa[4 * i + 3] = -(aMb[i] * aMb[3] + aMb[4 + i] * aMb[7] + aMb[8 + i] * aMb[11]);
+    }
+  }
+
+  /*!
+    Unrolled change of frame \f$ {^a}{\bf p} = {^a}{\bf M}_b \; {^b}{\bf p}
+    \f$ of a 3D point, the homogeneous matrix being given by its first three
+    rows stored row-major. \e a_p must not be \e b_p.
+  */
+  static inline void apply(const double *aMb, const double *b_p, double *a_p)
+  {
+    a_p[0] = aMb[0] * b_p[0] + aMb[1] * b_p[1] + aMb[2] * b_p[2] + aMb[3];
+    a_p[1] = aMb[4] * b_p[0] + aMb[5] * b_p[1] + aMb[6] * b_p[2] + aMb[7];
+    a_p[2] = aMb[8] * b_p[0] + aMb[9] * b_p[1] + aMb[10] * b_p[2] + aMb[11];
+  }
+
+private:
+  double m_data[12];
+};
+
+#endif
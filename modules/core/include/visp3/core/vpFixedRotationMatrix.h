@@ -0,0 +1,191 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Rotation matrix with inline storage.
+ *
+ *****************************************************************************/
+
+#ifndef vpFIXEDROTATIONMATRIX_H
+#define vpFIXEDROTATIONMATRIX_H
+
+/*!
+  \file vpFixedRotationMatrix.h
+  \brief Rotation matrix with inline storage.
+*/
+
+#include <cmath>
+
+#include <visp3/core/vpFixedThetaUVector.h>
+#include <visp3/core/vpFixedTranslationVector.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpRotationMatrix.h>
+
+/*!
+  \class vpFixedRotationMatrix
+
+  \ingroup group_core_transformations
+
+  \brief Rotation matrix whose nine values are stored row-major in the object
+  itself.
+
+  This is the counterpart of vpRotationMatrix that never allocates memory.
+  Products are unrolled, which makes this class suited for temporaries of
+  pose chains. It can be converted to and from a vpRotationMatrix.
+
+  \code
+#include <visp3/core/vpFixedRotationMatrix.h>
+
+int main()
+{
+  vpFixedRotationMatrix aRb(vpFixedThetaUVector(0, 0, M_PI / 2));
+  vpFixedTranslationVector b_p(1, 0, 0);
+  vpFixedTranslationVector a_p = aRb * b_p; // (0, 1, 0)
+
+  vpRotationMatrix R = aRb; // Conversion when a vpRotationMatrix is expected
+}
+  \endcode
+
+  \sa vpFixedHomogeneousMatrix
+*/
+class vpFixedRotationMatrix
+{
+public:
+  //! Default constructor that initializes the matrix to identity.
+  vpFixedRotationMatrix() { eye(); }
+
+  //! Construct a rotation matrix from a vpRotationMatrix.
+  explicit vpFixedRotationMatrix(const vpRotationMatrix &R)
+  {
+    for (unsigned int i = 0; i < 9; i++) {
+      m_data[i] = R.data[i];
+    }
+  }
+
+  //! Construct a rotation matrix from a \f$\theta {\bf u}\f$ vector.
+  explicit vpFixedRotationMatrix(const vpFixedThetaUVector &tu) { buildFrom(tu); }
+
+  /*!
+    Build the rotation matrix from a \f$\theta {\bf u}\f$ vector using the
+    Rodrigues formula, as vpRotationMatrix::buildFrom(const vpThetaUVector &).
+  */
+  inline vpFixedRotationMatrix &buildFrom(const vpFixedThetaUVector &tu)
+  {
+    const double theta = tu.getTheta();
+    const double si = sin(theta);
+    const double co = cos(theta);
+    const double sinc = vpMath::sinc(si, theta);
+    const double mcosc = vpMath::mcosc(co, theta);
+
+    m_data[0] = co + mcosc * tu[0] * tu[0];
+    m_data[1] = -sinc * tu[2] + mcosc * tu[0] * tu[1];
+    m_data[2] = sinc * tu[1] + mcosc * tu[0] * tu[2];
+    m_data[3] = sinc * tu[2] + mcosc * tu[1] * tu[0];
+    m_data[4] = co + mcosc * tu[1] * tu[1];
+    m_data[5] = -sinc * tu[0] + mcosc * tu[1] * tu[2];
+    m_data[6] = -sinc * tu[1] + mcosc * tu[2] * tu[0];
+    m_data[7] = sinc * tu[0] + mcosc * tu[2] * tu[1];
+    m_data[8] = co + mcosc * tu[2] * tu[2];
+
+    return *this;
+  }
+
+  //! Set the matrix to identity.
+  inline void eye()
+  {
+    m_data[0] = m_data[4] = m_data[8] = 1.;
+    m_data[1] = m_data[2] = m_data[3] = m_data[5] = m_data[6] = m_data[7] = 0.;
+  }
+
+  //! Inverse of the rotation, that is its transpose.
+  inline vpFixedRotationMatrix inverse() const { return t(); }
+
+  //! Transpose of the rotation matrix.
+  inline vpFixedRotationMatrix t() const
+  {
+    vpFixedRotationMatrix Rt;
+    Rt.m_data[0] = m_data[0];
+    Rt.m_data[1] = m_data[3];
+    Rt.m_data[2] = m_data[6];
+    Rt.m_data[3] = m_data[1];
+    Rt.m_data[4] = m_data[4];
+    Rt.m_data[5] = m_data[7];
+    Rt.m_data[6] = m_data[2];
+    Rt.m_data[7] = m_data[5];
+    Rt.m_data[8] = m_data[8];
+    return Rt;
+  }
+
+  //! Conversion to a vpRotationMatrix.
+  inline operator vpRotationMatrix() const
+  {
+    vpRotationMatrix R;
+    for (unsigned int i = 0; i < 9; i++) {
+      R.data[i] = m_data[i];
+    }
+    return R;
+  }
+
+  //! Pointer to the row \e i, so that \e R[i][j] is the element of row \e i and column \e j.
+  inline double *operator[](unsigned int i) { return m_data + 3 * i; }
+  //! Pointer to the row \e i, so that \e R[i][j] is the element of row \e i and column \e j.
+  inline const double *operator[](unsigned int i) const { return m_data + 3 * i; }
+
+  //! Product of two rotation matrices.
+  inline vpFixedRotationMatrix operator*(const vpFixedRotationMatrix &R) const
+  {
+    vpFixedRotationMatrix res;
+    const double *a = m_data, *b = R.m_data;
+    double *c = res.m_data;
+    c[0] = a[0] * b[0] + a[1] * b[3] + a[2] * b[6];
+    c[1] = a[0] * b[1] + a[1] * b[4] + a[2] * b[7];
+    c[2] = a[0] * b[2] + a[1] * b[5] + a[2] * b[8];
+    c[3] = a[3] * b[0] + a[4] * b[3] + a[5] * b[6];
+    c[4] = a[3] * b[1] + a[4] * b[4] + a[5] * b[7];
+    c[5] = a[3] * b[2] + a[4] * b[5] + a[5] * b[8];
+    c[6] = a[6] * b[0] + a[7] * b[3] + a[8] * b[6];
+    c[7] = a[6] * b[1] + a[7] * b[4] + a[8] * b[7];
+    c[8] = a[6] * b[2] + a[7] * b[5] + a[8] * b[8];
+    return res;
+  }
+
+  //! Rotation of a 3D vector.
+  inline vpFixedTranslationVector operator*(const vpFixedTranslationVector &t) const
+  {
+    return vpFixedTranslationVector(m_data[0] * t[0] + m_data[1] * t[1] + m_data[2] * t[2],
+                                    m_data[3] * t[0] + m_data[4] * t[1] + m_data[5] * t[2],
+                                    m_data[6] * t[0] + m_data[7] * t[1] + m_data[8] * t[2]);
+  }
+
+private:
+  double m_data[9];
+};
+
+#endif
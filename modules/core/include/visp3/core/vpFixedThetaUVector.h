@@ -0,0 +1,102 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Theta U rotation vector with inline storage.
+ *
+ *****************************************************************************/
+
+#ifndef vpFIXEDTHETAUVECTOR_H
+#define vpFIXEDTHETAUVECTOR_H
+
+/*!
+  \file vpFixedThetaUVector.h
+  \brief \f$\theta {\bf u}\f$ rotation vector with inline storage.
+*/
+
+#include <cmath>
+
+#include <visp3/core/vpThetaUVector.h>
+
+/*!
+  \class vpFixedThetaUVector
+
+  \ingroup group_core_transformations
+
+  \brief \f$\theta {\bf u}\f$ rotation vector whose three values are stored
+  in the object itself.
+
+  This is the counterpart of vpThetaUVector that never allocates memory. It
+  can be converted to and from a vpThetaUVector, and to a
+  vpFixedRotationMatrix.
+
+  \sa vpFixedRotationMatrix, vpFixedHomogeneousMatrix
+*/
+class vpFixedThetaUVector
+{
+public:
+  //! Default constructor that initializes the rotation to identity.
+  vpFixedThetaUVector() { m_data[0] = m_data[1] = m_data[2] = 0.; }
+
+  //! Construct a \f$\theta {\bf u}\f$ vector from its components in radians.
+  vpFixedThetaUVector(double tux, double tuy, double tuz)
+  {
+    m_data[0] = tux;
+    m_data[1] = tuy;
+    m_data[2] = tuz;
+  }
+
+  //! Construct a \f$\theta {\bf u}\f$ vector from a vpThetaUVector.
+  explicit vpFixedThetaUVector(const vpThetaUVector &tu)
+  {
+    m_data[0] = tu[0];
+    m_data[1] = tu[1];
+    m_data[2] = tu[2];
+  }
+
+  //! Rotation angle \f$ \theta \f$ in radians.
+  inline double getTheta() const
+  {
+    return sqrt(m_data[0] * m_data[0] + m_data[1] * m_data[1] + m_data[2] * m_data[2]);
+  }
+
+  //! Conversion to a vpThetaUVector.
+  inline operator vpThetaUVector() const { return vpThetaUVector(m_data[0], m_data[1], m_data[2]); }
+
+  //! Access to the component \e i of the vector.
+  inline double &operator[](unsigned int i) { return m_data[i]; }
+  //! Access to the component \e i of the vector.
+  inline const double &operator[](unsigned int i) const { return m_data[i]; }
+
+private:
+  double m_data[3];
+};
+
+#endif
@@ -0,0 +1,128 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Translation vector with inline storage.
+ *
+ *****************************************************************************/
+
+#ifndef vpFIXEDTRANSLATIONVECTOR_H
+#define vpFIXEDTRANSLATIONVECTOR_H
+
+/*!
+  \file vpFixedTranslationVector.h
+  \brief Translation vector with inline storage.
+*/
+
+#include <cmath>
+
+#include <visp3/core/vpTranslationVector.h>
+
+/*!
+  \class vpFixedTranslationVector
+
+  \ingroup group_core_transformations
+
+  \brief Translation vector whose three values are stored in the object
+  itself.
+
+  Contrary to vpTranslationVector that inherits from vpArray2D and allocates
+  its values on the heap, creating or copying a vpFixedTranslationVector
+  never allocates memory. It is intended for temporaries computed at high
+  rate, for example in pose chains. It can be converted to and from a
+  vpTranslationVector to call the functions that expect one.
+
+  \sa vpFixedRotationMatrix, vpFixedHomogeneousMatrix
+*/
+class vpFixedTranslationVector
+{
+public:
+  //! Default constructor that initializes the translation to zero.
+  vpFixedTranslationVector() { m_data[0] = m_data[1] = m_data[2] = 0.; }
+
+  //! Construct a translation vector from its components in meters.
+  vpFixedTranslationVector(double tx, double ty, double tz)
+  {
+    m_data[0] = tx;
+    m_data[1] = ty;
+    m_data[2] = tz;
+  }
+
+  //! Construct a translation vector from a vpTranslationVector.
+  explicit vpFixedTranslationVector(const vpTranslationVector &t)
+  {
+    m_data[0] = t[0];
+    m_data[1] = t[1];
+    m_data[2] = t[2];
+  }
+
+  //! Euclidean norm of the translation.
+  inline double frobeniusNorm() const
+  {
+    return sqrt(m_data[0] * m_data[0] + m_data[1] * m_data[1] + m_data[2] * m_data[2]);
+  }
+
+  //! Conversion to a vpTranslationVector.
+  inline operator vpTranslationVector() const { return vpTranslationVector(m_data[0], m_data[1], m_data[2]); }
+
+  //! Access to the component \e i of the translation.
+  inline double &operator[](unsigned int i) { return m_data[i]; }
+  //! Access to the component \e i of the translation.
+  inline const double &operator[](unsigned int i) const { return m_data[i]; }
+
+  //! Sum of two translation vectors.
+  inline vpFixedTranslationVector operator+(const vpFixedTranslationVector &t) const
+  {
+    return vpFixedTranslationVector(m_data[0] + t[0], m_data[1] + t[1], m_data[2] + t[2]);
+  }
+
+  //! Difference of two translation vectors.
+  inline vpFixedTranslationVector operator-(const vpFixedTranslationVector &t) const
+  {
+    return vpFixedTranslationVector(m_data[0] - t[0], m_data[1] - t[1], m_data[2] - t[2]);
+  }
+
+  //! Opposite of the translation vector.
+  inline vpFixedTranslationVector operator-() const
+  {
+    return vpFixedTranslationVector(-m_data[0], -m_data[1], -m_data[2]);
+  }
+
+  //! Multiplication by a scalar.
+  inline vpFixedTranslationVector operator*(double x) const
+  {
+    return vpFixedTranslationVector(m_data[0] * x, m_data[1] * x, m_data[2] * x);
+  }
+
+private:
+  double m_data[3];
+};
+
+#endif
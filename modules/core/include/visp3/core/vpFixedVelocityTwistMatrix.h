@@ -0,0 +1,172 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Velocity twist matrix with inline storage.
+ *
+ *****************************************************************************/
+
+#ifndef vpFIXEDVELOCITYTWISTMATRIX_H
+#define vpFIXEDVELOCITYTWISTMATRIX_H
+
+/*!
+  \file vpFixedVelocityTwistMatrix.h
+  \brief Velocity twist matrix with inline storage.
+*/
+
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpFixedHomogeneousMatrix.h>
+#include <visp3/core/vpVelocityTwistMatrix.h>
+
+/*!
+  \class vpFixedVelocityTwistMatrix
+
+  \ingroup group_core_transformations
+
+  \brief Velocity twist matrix whose values are stored in the object itself.
+
+  This is the counterpart of vpVelocityTwistMatrix that never allocates
+  memory. Only the two distinct \f$ 3 \times 3 \f$ blocks of
+  \f[ {\bf V} = \left[\begin{array}{cc} {\bf R} & [{\bf t}]_\times \; {\bf R}
+  \\ {\bf 0}_{3\times 3} & {\bf R} \end{array} \right] \f]
+  are stored, and products exploit this structure. It can be converted to and
+  from a vpVelocityTwistMatrix.
+
+  \sa vpFixedHomogeneousMatrix
+*/
+class vpFixedVelocityTwistMatrix
+{
+public:
+  //! Default constructor that initializes the matrix to identity.
+  vpFixedVelocityTwistMatrix() : m_R()
+  {
+    for (unsigned int i = 0; i < 9; i++) {
+      m_tR[i] = 0.;
+    }
+  }
+
+  //! Construct a velocity twist matrix from an homogeneous matrix.
+  explicit vpFixedVelocityTwistMatrix(const vpFixedHomogeneousMatrix &M) : m_R()
+  {
+    buildFrom(M.getTranslationVector(), M.getRotationMatrix());
+  }
+
+  //! Construct a velocity twist matrix from a translation and a rotation matrix.
+  vpFixedVelocityTwistMatrix(const vpFixedTranslationVector &t, const vpFixedRotationMatrix &R) : m_R()
+  {
+    buildFrom(t, R);
+  }
+
+  //! Construct a velocity twist matrix from a vpVelocityTwistMatrix.
+  explicit vpFixedVelocityTwistMatrix(const vpVelocityTwistMatrix &V) : m_R()
+  {
+    for (unsigned int i = 0; i < 3; i++) {
+      for (unsigned int j = 0; j < 3; j++) {
+        m_R[i][j] = V[i][j];
+        m_tR[3 * i + j] = V[i][j + 3];
+      }
+    }
+  }
+
+  //! Build the velocity twist matrix from a translation and a rotation matrix.
+  inline vpFixedVelocityTwistMatrix &buildFrom(const vpFixedTranslationVector &t, const vpFixedRotationMatrix &R)
+  {
+    m_R = R;
+    for (unsigned int j = 0; j < 3; j++) {
+      m_tR[j] = -t[2] * R[1][j] + t[1] * R[2][j];
+      m_tR[3 + j] = t[2] * R[0][j] - t[0] * R[2][j];
+      m_tR[6 + j] = -t[1] * R[0][j] + t[0] * R[1][j];
+    }
+    return *this;
+  }
+
+  //! Conversion to a vpVelocityTwistMatrix.
+  inline operator vpVelocityTwistMatrix() const
+  {
+    vpVelocityTwistMatrix V;
+    for (unsigned int i = 0; i < 3; i++) {
+      for (unsigned int j = 0; j < 3; j++) {
+        V[i][j] = V[i + 3][j + 3] = m_R[i][j];
+        V[i][j + 3] = m_tR[3 * i + j];
+        V[i + 3][j] = 0.;
+      }
+    }
+    return V;
+  }
+
+  //! Product of two velocity twist matrices.
+  inline vpFixedVelocityTwistMatrix operator*(const vpFixedVelocityTwistMatrix &V) const
+  {
+    vpFixedVelocityTwistMatrix res;
+    res.m_R = m_R * V.m_R;
+    // [t]x R of the product is R1 [t2]x R2 + [t1]x R1 R2
+    for (unsigned int i = 0; i < 3; i++) {
+      for (unsigned int j = 0; j < 3; j++) {
+        res.m_tR[3 * i + j] = m_R[i][0] * V.m_tR[j] + m_R[i][1] * V.m_tR[3 + j] + m_R[i][2] * V.m_tR[6 + j] +
+                              m_tR[3 * i] * V.m_R[0][j] + m_tR[3 * i + 1] * V.m_R[1][j] +
+                              m_tR[3 * i + 2] * V.m_R[2][j];
+      }
+    }
+    return res;
+  }
+
+  /*!
+    Change of frame of a velocity skew vector \f$ [v, \omega] \f$.
+
+    \param v : 6-dim input vector.
+    \param res : 6-dim output vector, must not be \e v.
+  */
+  inline void apply(const double *v, double *res) const
+  {
+    for (unsigned int i = 0; i < 3; i++) {
+      res[i] = m_R[i][0] * v[0] + m_R[i][1] * v[1] + m_R[i][2] * v[2] + m_tR[3 * i] * v[3] +
+               m_tR[3 * i + 1] * v[4] + m_tR[3 * i + 2] * v[5];
+      res[i + 3] = m_R[i][0] * v[3] + m_R[i][1] * v[4] + m_R[i][2] * v[5];
+    }
+  }
+
+  //! Change of frame of a 6-dim velocity skew vector.
+  inline vpColVector operator*(const vpColVector &v) const
+  {
+    if (v.size() != 6) {
+      throw(vpException(vpException::dimensionError,
+                        "Cannot multiply a velocity twist matrix by a %d-dim vector. Should be 6-dim.", v.size()));
+    }
+    vpColVector res(6);
+    apply(v.data, res.data);
+    return res;
+  }
+
+private:
+  vpFixedRotationMatrix m_R; //!< Rotation block
+  double m_tR[9];            //!< Skew matrix of the translation times the rotation, row-major
+};
+
+#endif
@@ -55,6 +55,9 @@
 #if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
 #include <visp3/core/vpThread.h>
 #endif
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <visp3/core/vpThreadPool.h>
+#endif
 
 #include <fstream>
 #include <iomanip> // std::setw
@@ -485,100 +488,52 @@ inline std::ostream &operator<<(std::ostream &s, const vpImage<double> &I)
   return s;
 }
 
-#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
 namespace
 {
-struct ImageLut_Param_t {
-  unsigned int m_start_index;
-  unsigned int m_end_index;
-
-  unsigned char m_lut[256];
-  unsigned char *m_bitmap;
-
-  ImageLut_Param_t() : m_start_index(0), m_end_index(0), m_lut(), m_bitmap(NULL) {}
-
-  ImageLut_Param_t(unsigned int start_index, unsigned int end_index, unsigned char *bitmap)
-    : m_start_index(start_index), m_end_index(end_index), m_lut(), m_bitmap(bitmap)
-  {
-  }
-};
-
-vpThread::Return performLutThread(vpThread::Args args)
+inline void performLutRange(const unsigned char *lut, unsigned char *bitmap, unsigned int start_index,
+                            unsigned int end_index)
 {
-  ImageLut_Param_t *imageLut_param = static_cast<ImageLut_Param_t *>(args);
-  unsigned int start_index = imageLut_param->m_start_index;
-  unsigned int end_index = imageLut_param->m_end_index;
-
-  unsigned char *bitmap = imageLut_param->m_bitmap;
-
   unsigned char *ptrStart = bitmap + start_index;
   unsigned char *ptrEnd = bitmap + end_index;
   unsigned char *ptrCurrent = ptrStart;
 
-  //    while(ptrCurrent != ptrEnd) {
-  //      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
-  //      ++ptrCurrent;
-  //    }
-
   if (end_index - start_index >= 8) {
     // Unroll loop version
     for (; ptrCurrent <= ptrEnd - 8;) {
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
+      *ptrCurrent = lut[*ptrCurrent];
       ++ptrCurrent;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
+      *ptrCurrent = lut[*ptrCurrent];
       ++ptrCurrent;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
+      *ptrCurrent = lut[*ptrCurrent];
       ++ptrCurrent;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
+      *ptrCurrent = lut[*ptrCurrent];
       ++ptrCurrent;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
+      *ptrCurrent = lut[*ptrCurrent];
       ++ptrCurrent;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
+      *ptrCurrent = lut[*ptrCurrent];
       ++ptrCurrent;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
+      *ptrCurrent = lut[*ptrCurrent];
       ++ptrCurrent;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
+      *ptrCurrent = lut[*ptrCurrent];
       ++ptrCurrent;
     }
   }
 
   for (; ptrCurrent != ptrEnd; ++ptrCurrent) {
-    *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
+    *ptrCurrent = lut[*ptrCurrent];
   }
-
-  return 0;
 }
 
-struct ImageLutRGBa_Param_t {
-  unsigned int m_start_index;
-  unsigned int m_end_index;
-
-  vpRGBa m_lut[256];
-  unsigned char *m_bitmap;
-
-  ImageLutRGBa_Param_t() : m_start_index(0), m_end_index(0), m_lut(), m_bitmap(NULL) {}
-
-  ImageLutRGBa_Param_t(unsigned int start_index, unsigned int end_index, unsigned char *bitmap)
-    : m_start_index(start_index), m_end_index(end_index), m_lut(), m_bitmap(bitmap)
-  {
-  }
-};
-
-vpThread::Return performLutRGBaThread(vpThread::Args args)
+inline void performLutRGBaRange(const vpRGBa *lut, unsigned char *bitmap, unsigned int start_index,
+                                unsigned int end_index)
 {
-  ImageLutRGBa_Param_t *imageLut_param = static_cast<ImageLutRGBa_Param_t *>(args);
-  unsigned int start_index = imageLut_param->m_start_index;
-  unsigned int end_index = imageLut_param->m_end_index;
-
-  unsigned char *bitmap = imageLut_param->m_bitmap;
-
   unsigned char *ptrStart = bitmap + start_index * 4;
   unsigned char *ptrEnd = bitmap + end_index * 4;
   unsigned char *ptrCurrent = ptrStart;
@@ -586,44 +541,92 @@ vpThread::Return performLutRGBaThread(vpThread::Args args)
   if (end_index - start_index >= 4 * 2) {
     // Unroll loop version
     for (; ptrCurrent <= ptrEnd - 4 * 2;) {
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].R;
+      *ptrCurrent = lut[*ptrCurrent].R;
       ptrCurrent++;
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].G;
+      *ptrCurrent = lut[*ptrCurrent].G;
       ptrCurrent++;
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].B;
+      *ptrCurrent = lut[*ptrCurrent].B;
       ptrCurrent++;
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].A;
+      *ptrCurrent = lut[*ptrCurrent].A;
       ptrCurrent++;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].R;
+      *ptrCurrent = lut[*ptrCurrent].R;
       ptrCurrent++;
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].G;
+      *ptrCurrent = lut[*ptrCurrent].G;
       ptrCurrent++;
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].B;
+      *ptrCurrent = lut[*ptrCurrent].B;
       ptrCurrent++;
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].A;
+      *ptrCurrent = lut[*ptrCurrent].A;
       ptrCurrent++;
     }
   }
 
   while (ptrCurrent != ptrEnd) {
-    *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].R;
+    *ptrCurrent = lut[*ptrCurrent].R;
     ptrCurrent++;
 
-    *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].G;
+    *ptrCurrent = lut[*ptrCurrent].G;
     ptrCurrent++;
 
-    *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].B;
+    *ptrCurrent = lut[*ptrCurrent].B;
     ptrCurrent++;
 
-    *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].A;
+    *ptrCurrent = lut[*ptrCurrent].A;
     ptrCurrent++;
   }
+}
+
+#if (VISP_CXX_STANDARD < VISP_CXX_STANDARD_11) &&                                                                     \
+    (defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0)))
+struct ImageLut_Param_t {
+  unsigned int m_start_index;
+  unsigned int m_end_index;
+
+  unsigned char m_lut[256];
+  unsigned char *m_bitmap;
+
+  ImageLut_Param_t() : m_start_index(0), m_end_index(0), m_lut(), m_bitmap(NULL) {}
+
+  ImageLut_Param_t(unsigned int start_index, unsigned int end_index, unsigned char *bitmap)
+    : m_start_index(start_index), m_end_index(end_index), m_lut(), m_bitmap(bitmap)
+  {
+  }
+};
+
+vpThread::Return performLutThread(vpThread::Args args)
+{
+  ImageLut_Param_t *imageLut_param = static_cast<ImageLut_Param_t *>(args);
+  performLutRange(imageLut_param->m_lut, imageLut_param->m_bitmap, imageLut_param->m_start_index,
+                  imageLut_param->m_end_index);
 
   return 0;
 }
+
+struct ImageLutRGBa_Param_t {
+  unsigned int m_start_index;
+  unsigned int m_end_index;
+
+  vpRGBa m_lut[256];
+  unsigned char *m_bitmap;
+
+  ImageLutRGBa_Param_t() : m_start_index(0), m_end_index(0), m_lut(), m_bitmap(NULL) {}
+
+  ImageLutRGBa_Param_t(unsigned int start_index, unsigned int end_index, unsigned char *bitmap)
+    : m_start_index(start_index), m_end_index(end_index), m_lut(), m_bitmap(bitmap)
+  {
+  }
+};
+
+vpThread::Return performLutRGBaThread(vpThread::Args args)
+{
+  ImageLutRGBa_Param_t *imageLut_param = static_cast<ImageLutRGBa_Param_t *>(args);
+  performLutRGBaRange(imageLut_param->m_lut, imageLut_param->m_bitmap, imageLut_param->m_start_index,
+                      imageLut_param->m_end_index);
+
+  return 0;
 }
 #endif
+}
 
 /*!
   \brief Image initialisation
@@ -1769,17 +1772,14 @@ template <class Type> void vpImage<Type>::performLut(const Type (&)[256], unsign
 
   \param lut : Look-up table (unsigned char array of size=256) which maps each
   intensity to his new value.
-  \param nbThreads : Number of threads to use for the computation.
+  \param nbThreads : Number of threads to use for the computation. When
+  c++11 is enabled, at most \e nbThreads threads of the pool returned by
+  vpThreadPool::getGlobalInstance() are used.
 */
 template <> inline void vpImage<unsigned char>::performLut(const unsigned char (&lut)[256], unsigned int nbThreads)
 {
-  unsigned int size = getWidth() * getHeight();
-  unsigned char *ptrStart = (unsigned char *)bitmap;
-  unsigned char *ptrEnd = ptrStart + size;
-  unsigned char *ptrCurrent = ptrStart;
-
   bool use_single_thread = (nbThreads == 0 || nbThreads == 1);
-#if !defined(VISP_HAVE_PTHREAD) && !defined(_WIN32)
+#if (VISP_CXX_STANDARD < VISP_CXX_STANDARD_11) && !defined(VISP_HAVE_PTHREAD) && !defined(_WIN32)
   use_single_thread = true;
 #endif
 
@@ -1789,15 +1789,16 @@ template <> inline void vpImage<unsigned char>::performLut(const unsigned char (
 
   if (use_single_thread) {
     // Single thread
-
-    while (ptrCurrent != ptrEnd) {
-      *ptrCurrent = lut[*ptrCurrent];
-      ++ptrCurrent;
-    }
+    performLutRange(lut, bitmap, 0, getSize());
   } else {
-#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+    // Multi-threads, using the pool of threads shared by the library
+    unsigned char *ptr = bitmap;
+    vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(getSize()), [&lut, ptr](int start, int end) {
+      performLutRange(lut, ptr, static_cast<unsigned int>(start), static_cast<unsigned int>(end));
+    }, nbThreads);
+#elif defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
     // Multi-threads
-
     std::vector<vpThread *> threadpool;
     std::vector<ImageLut_Param_t *> imageLutParams;
 
@@ -1848,17 +1849,14 @@ template <> inline void vpImage<unsigned char>::performLut(const unsigned char (
 
   \param lut : Look-up table (vpRGBa array of size=256) which maps each
   intensity to his new value.
-  \param nbThreads : Number of threads to use for the computation.
+  \param nbThreads : Number of threads to use for the computation. When
+  c++11 is enabled, at most \e nbThreads threads of the pool returned by
+  vpThreadPool::getGlobalInstance() are used.
 */
 template <> inline void vpImage<vpRGBa>::performLut(const vpRGBa (&lut)[256], unsigned int nbThreads)
 {
-  unsigned int size = getWidth() * getHeight();
-  unsigned char *ptrStart = (unsigned char *)bitmap;
-  unsigned char *ptrEnd = ptrStart + size * 4;
-  unsigned char *ptrCurrent = ptrStart;
-
   bool use_single_thread = (nbThreads == 0 || nbThreads == 1);
-#if !defined(VISP_HAVE_PTHREAD) && !defined(_WIN32)
+#if (VISP_CXX_STANDARD < VISP_CXX_STANDARD_11) && !defined(VISP_HAVE_PTHREAD) && !defined(_WIN32)
   use_single_thread = true;
 #endif
 
@@ -1868,21 +1866,15 @@ template <> inline void vpImage<vpRGBa>::performLut(const vpRGBa (&lut)[256], un
 
   if (use_single_thread) {
     // Single thread
-    while (ptrCurrent != ptrEnd) {
-      *ptrCurrent = lut[*ptrCurrent].R;
-      ++ptrCurrent;
-
-      *ptrCurrent = lut[*ptrCurrent].G;
-      ++ptrCurrent;
-
-      *ptrCurrent = lut[*ptrCurrent].B;
-      ++ptrCurrent;
-
-      *ptrCurrent = lut[*ptrCurrent].A;
-      ++ptrCurrent;
-    }
+    performLutRGBaRange(lut, (unsigned char *)bitmap, 0, getSize());
   } else {
-#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+    // Multi-threads, using the pool of threads shared by the library
+    unsigned char *ptr = (unsigned char *)bitmap;
+    vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(getSize()), [&lut, ptr](int start, int end) {
+      performLutRGBaRange(lut, ptr, static_cast<unsigned int>(start), static_cast<unsigned int>(end));
+    }, nbThreads);
+#elif defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
     // Multi-threads
     std::vector<vpThread *> threadpool;
     std::vector<ImageLutRGBa_Param_t *> imageLutParams;
@@ -52,6 +52,7 @@
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageView.h>
 // color
 #include <visp3/core/vpRGBa.h>
 
@@ -106,10 +107,31 @@ class VISP_EXPORT vpImageConvert
 {
 
 public:
+  /*!
+    Arrangement of the color filter array of a raw Bayer image, given by the
+    colors of the 2x2 block at the top left corner read in raster order.
+  */
+  typedef enum {
+    BAYER_BGGR, //!< Blue, green / green, red.
+    BAYER_GBRG, //!< Green, blue / red, green.
+    BAYER_GRBG, //!< Green, red / blue, green.
+    BAYER_RGGB  //!< Red, green / green, blue.
+  } vpBayerPattern;
+
+  /*!
+    Interpolation of the missing color channels of a raw Bayer image.
+  */
+  typedef enum {
+    DEMOSAIC_BILINEAR, //!< Mean of the closest samples of the same color.
+    DEMOSAIC_MALVAR    //!< Edge-aware, gradient-corrected interpolation of Malvar, He and Cutler.
+  } vpDemosaicMethod;
+
   static void createDepthHistogram(const vpImage<uint16_t> &src_depth, vpImage<vpRGBa> &dest_rgba);
   static void createDepthHistogram(const vpImage<uint16_t> &src_depth, vpImage<unsigned char> &dest_depth);
   static void convert(const vpImage<unsigned char> &src, vpImage<vpRGBa> &dest);
   static void convert(const vpImage<vpRGBa> &src, vpImage<unsigned char> &dest);
+  static void convert(const vpImageView<const unsigned char> &src, vpImage<vpRGBa> &dest);
+  static void convert(const vpImageView<const vpRGBa> &src, vpImage<unsigned char> &dest);
 
   static void convert(const vpImage<float> &src, vpImage<unsigned char> &dest);
   static void convert(const vpImage<unsigned char> &src, vpImage<float> &dest);
@@ -218,6 +240,14 @@ public:
   static void YV12ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height);
   static void YVU9ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height);
   static void YVU9ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height);
+  static void NV12ToRGBa(const unsigned char *nv12, unsigned char *rgba, unsigned int width, unsigned int height,
+                         unsigned int nbThreads = 0);
+  static void NV12ToRGB(const unsigned char *nv12, unsigned char *rgb, unsigned int width, unsigned int height,
+                        unsigned int nbThreads = 0);
+  static void NV21ToRGBa(const unsigned char *nv21, unsigned char *rgba, unsigned int width, unsigned int height,
+                         unsigned int nbThreads = 0);
+  static void NV21ToRGB(const unsigned char *nv21, unsigned char *rgb, unsigned int width, unsigned int height,
+                        unsigned int nbThreads = 0);
   static void RGBToRGBa(unsigned char *rgb, unsigned char *rgba, unsigned int size);
   static void RGBaToRGB(unsigned char *rgba, unsigned char *rgb, unsigned int size);
 
@@ -246,6 +276,19 @@ public:
   static void MONO16ToGrey(unsigned char *grey16, unsigned char *grey, unsigned int size);
   static void MONO16ToRGBa(unsigned char *grey16, unsigned char *rgba, unsigned int size);
 
+  static void demosaic(const unsigned char *bayer, vpImage<vpRGBa> &dest, unsigned int width, unsigned int height,
+                       vpBayerPattern pattern, vpDemosaicMethod method = DEMOSAIC_BILINEAR,
+                       unsigned int nbThreads = 0);
+  static void demosaic(const unsigned char *bayer, vpImage<unsigned char> &dest, unsigned int width,
+                       unsigned int height, vpBayerPattern pattern, vpDemosaicMethod method = DEMOSAIC_BILINEAR,
+                       unsigned int nbThreads = 0);
+  static void demosaic(const uint16_t *bayer, vpImage<vpRGBa> &dest, unsigned int width, unsigned int height,
+                       vpBayerPattern pattern, vpDemosaicMethod method = DEMOSAIC_BILINEAR,
+                       unsigned int bitDepth = 16, unsigned int nbThreads = 0);
+  static void demosaic(const uint16_t *bayer, vpImage<unsigned char> &dest, unsigned int width, unsigned int height,
+                       vpBayerPattern pattern, vpDemosaicMethod method = DEMOSAIC_BILINEAR,
+                       unsigned int bitDepth = 16, unsigned int nbThreads = 0);
+
   static void HSVToRGBa(const double *hue, const double *saturation, const double *value, unsigned char *rgba,
                         unsigned int size);
   static void HSVToRGBa(const unsigned char *hue, const unsigned char *saturation, const unsigned char *value,
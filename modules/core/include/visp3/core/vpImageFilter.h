@@ -47,6 +47,7 @@
 
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageException.h>
+#include <visp3/core/vpImageView.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpMatrix.h>
 #include <visp3/core/vpRGBa.h>
@@ -63,14 +64,24 @@
 
   \brief  Various image filter, convolution, etc...
 
+  The separable filters (filterX(), filterY(), filter(), gaussianBlur(),
+  getGradX(), getGradY(), getGradXGauss2D(), getGradYGauss2D() and
+  getGaussPyramidal()) are computed row by row with SSE2, AVX2 or NEON
+  instructions, the instruction set being selected at runtime. Only a few
+  rows of the intermediate results are stored and bands of rows are
+  processed in parallel. The double precision results are the same as the
+  ones of the per-pixel functions such as filterX(const vpImage<unsigned
+  char> &, unsigned int, unsigned int, const double *, unsigned int). The
+  overloads with a vpImage<float> output do the computations in single
+  precision.
 */
 class VISP_EXPORT vpImageFilter
 {
 public:
-#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
   static void canny(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ic, unsigned int gaussianFilterSize,
                     double thresholdCanny, unsigned int apertureSobel);
-#endif
+  static void canny(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ic, unsigned int gaussianFilterSize,
+                    double lowerThreshold, double upperThreshold, unsigned int apertureSobel);
 
   /*!
    Apply a 1x3 derivative filter to an image pixel.
@@ -166,6 +177,11 @@ public:
 
   static void filter(const vpImage<unsigned char> &I, vpImage<double> &GI, const double *filter, unsigned int size);
   static void filter(const vpImage<double> &I, vpImage<double> &GI, const double *filter, unsigned int size);
+  static void filter(const vpImage<unsigned char> &I, vpImage<float> &GI, const double *filter, unsigned int size);
+  static void filter(const vpImageView<const unsigned char> &I, vpImage<double> &GI, const double *filter,
+                     unsigned int size);
+  static void filter(const vpImageView<const unsigned char> &I, vpImage<float> &GI, const double *filter,
+                     unsigned int size);
 
   static inline unsigned char filterGaussXPyramidal(const vpImage<unsigned char> &I, unsigned int i, unsigned int j)
   {
@@ -180,6 +196,7 @@ public:
 
   static void filterX(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *filter, unsigned int size);
   static void filterX(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size);
+  static void filterX(const vpImage<unsigned char> &I, vpImage<float> &dIx, const double *filter, unsigned int size);
   static void filterX(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter, unsigned int size);
   static void filterXR(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter, unsigned int size);
   static void filterXG(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter, unsigned int size);
@@ -416,6 +433,7 @@ public:
   static void filterYG(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter, unsigned int size);
   static void filterYB(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter, unsigned int size);
   static void filterY(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size);
+  static void filterY(const vpImage<unsigned char> &I, vpImage<float> &dIy, const double *filter, unsigned int size);
   static inline double filterY(const vpImage<unsigned char> &I, unsigned int r, unsigned int c, const double *filter,
                                unsigned int size)
   {
@@ -641,10 +659,18 @@ public:
 
   static void gaussianBlur(const vpImage<unsigned char> &I, vpImage<double> &GI, unsigned int size = 7,
                            double sigma = 0., bool normalize = true);
+  static void gaussianBlur(const vpImage<unsigned char> &I, vpImage<float> &GI, unsigned int size = 7,
+                           double sigma = 0., bool normalize = true);
   static void gaussianBlur(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &GI, unsigned int size = 7,
                            double sigma = 0., bool normalize = true);
   static void gaussianBlur(const vpImage<double> &I, vpImage<double> &GI, unsigned int size = 7, double sigma = 0.,
                            bool normalize = true);
+  static void gaussianBlur(const vpImageView<const unsigned char> &I, vpImage<double> &GI, unsigned int size = 7,
+                           double sigma = 0., bool normalize = true);
+  static void gaussianBlur(const vpImageView<const unsigned char> &I, vpImage<float> &GI, unsigned int size = 7,
+                           double sigma = 0., bool normalize = true);
+  static void gaussianBlur(const vpImageView<const vpRGBa> &I, vpImage<vpRGBa> &GI, unsigned int size = 7,
+                           double sigma = 0., bool normalize = true);
   /*!
    Apply a 5x5 Gaussian filter to an image pixel.
 
@@ -678,6 +704,10 @@ public:
   static void getGradX(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size);
   static void getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *gaussianKernel,
                               const double *gaussianDerivativeKernel, unsigned int size);
+  static void getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<float> &dIx, const double *gaussianKernel,
+                              const double *gaussianDerivativeKernel, unsigned int size);
+  static void getGradXGauss2D(const vpImageView<const unsigned char> &I, vpImage<double> &dIx,
+                              const double *gaussianKernel, const double *gaussianDerivativeKernel, unsigned int size);
 
   // fonction renvoyant le gradient en Y de l'image I
   static void getGradY(const vpImage<unsigned char> &I, vpImage<double> &dIy);
@@ -685,6 +715,10 @@ public:
   static void getGradY(const vpImage<double> &I, vpImage<double> &dIy, const double *filter, unsigned int size);
   static void getGradYGauss2D(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *gaussianKernel,
                               const double *gaussianDerivativeKernel, unsigned int size);
+  static void getGradYGauss2D(const vpImage<unsigned char> &I, vpImage<float> &dIy, const double *gaussianKernel,
+                              const double *gaussianDerivativeKernel, unsigned int size);
+  static void getGradYGauss2D(const vpImageView<const unsigned char> &I, vpImage<double> &dIy,
+                              const double *gaussianKernel, const double *gaussianDerivativeKernel, unsigned int size);
 
   static double getSobelKernelX(double *filter, unsigned int size);
   static double getSobelKernelY(double *filter, unsigned int size);
@@ -54,6 +54,7 @@
 
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpImageException.h>
+#include <visp3/core/vpImageView.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpRect.h>
 #include <visp3/core/vpRectOriented.h>
@@ -67,6 +68,8 @@
 #include <omp.h>
 #endif
 
+#include <visp3/core/vpThreadPool.h>
+
 /*!
   \class vpImageTools
 
@@ -88,6 +91,9 @@ public:
   template <class Type>
   static inline void binarise(vpImage<Type> &I, Type threshold1, Type threshold2, Type value1, Type value2, Type value3,
                               bool useLUT = true);
+  template <class Type>
+  static inline void binarise(const vpImageView<Type> &I, Type threshold1, Type threshold2, Type value1, Type value2,
+                              Type value3);
   static void changeLUT(vpImage<unsigned char> &I, unsigned char A, unsigned char newA, unsigned char B,
                         unsigned char newB);
 
@@ -106,6 +112,8 @@ public:
   template <class Type>
   static void crop(const unsigned char *bitmap, unsigned int width, unsigned int height, const vpRect &roi,
                    vpImage<Type> &crop, unsigned int v_scale = 1, unsigned int h_scale = 1);
+  template <class Type> static void crop(const vpImageView<const Type> &view, vpImage<Type> &crop);
+  template <class Type> static void crop(const vpImageView<Type> &view, vpImage<Type> &crop);
 
   static void extract(const vpImage<unsigned char> &Src, vpImage<unsigned char> &Dst, const vpRectOriented &r);
   static void extract(const vpImage<unsigned char> &Src, vpImage<double> &Dst, const vpRectOriented &r);
@@ -212,10 +220,30 @@ private:
   static void resizeBilinear(const vpImage<Type> &I, vpImage<Type> &Ires, unsigned int i, unsigned int j,
                              float u, float v, float xFrac, float yFrac);
 
+  static void resizeBilinearFixedPointRows(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires, int rowStart,
+                                           int rowEnd);
+  static void resizeBilinearFixedPointRows(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires, int rowStart, int rowEnd);
+
   template <class Type>
   static void resizeNearest(const vpImage<Type> &I, vpImage<Type> &Ires, unsigned int i, unsigned int j,
                             float u, float v);
 
+  template <class Type>
+  static void resizeRows(const vpImage<Type> &I, vpImage<Type> &Ires, const vpImageInterpolationType &method,
+                         float scaleX, float scaleY, int rowStart, int rowEnd);
+
+  static void remapRows(const vpImage<unsigned char> &I, const vpArray2D<int> &mapU, const vpArray2D<int> &mapV,
+                        const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv, vpImage<unsigned char> &Iundist,
+                        int rowStart, int rowEnd);
+  static void remapRows(const vpImage<vpRGBa> &I, const vpArray2D<int> &mapU, const vpArray2D<int> &mapV,
+                        const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv, vpImage<vpRGBa> &Iundist,
+                        int rowStart, int rowEnd);
+
+  static void templateMatchingRows(const vpImage<double> &I, const vpImage<double> &I_tpl, const vpImage<double> &II,
+                                   const vpImage<double> &IIsq, const vpImage<double> &II_tpl,
+                                   const vpImage<double> &IIsq_tpl, vpImage<double> &I_score, unsigned int step_u,
+                                   unsigned int step_v, int rowStart, int rowEnd);
+
   template <class Type>
   static void warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<Type> &dst, bool affine, bool centerCorner, bool fixedPoint);
 
@@ -442,6 +470,32 @@ void vpImageTools::crop(const unsigned char *bitmap, unsigned int width, unsigne
   }
 }
 
+/*!
+  Copy the pixels of a view in an image, for example to keep a region of
+  interest after the parent image has changed.
+
+  \param view : Input view, possibly with padded rows.
+  \param crop : Image resized to the size of the view.
+*/
+template <class Type> void vpImageTools::crop(const vpImageView<const Type> &view, vpImage<Type> &crop)
+{
+  crop.resize(view.getHeight(), view.getWidth());
+  for (unsigned int i = 0; i < view.getHeight(); i++) {
+    memcpy(static_cast<void *>(crop[i]), static_cast<const void *>(view[i]), view.getWidth() * sizeof(Type));
+  }
+}
+
+/*!
+  Copy the pixels of a writable view in an image.
+
+  \param view : Input view, possibly with padded rows.
+  \param crop : Image resized to the size of the view.
+*/
+template <class Type> void vpImageTools::crop(const vpImageView<Type> &view, vpImage<Type> &crop)
+{
+  vpImageTools::crop(vpImageView<const Type>(view), crop);
+}
+
 /*!
   Binarise an image.
 
@@ -511,6 +565,59 @@ inline void vpImageTools::binarise(vpImage<unsigned char> &I, unsigned char thre
   }
 }
 
+/*!
+  Binarise in place the pixels of a view, the remaining pixels of the parent
+  image being left unchanged.
+
+  - Pixels whose values are less than \e threshold1 are set to \e value1
+
+  - Pixels whose values are greater then or equal to \e threshold1 and
+    less then or equal to \e threshold2 are set to \e value2
+
+  - Pixels whose values are greater than \e threshold2 are set to \e value3
+*/
+template <class Type>
+inline void vpImageTools::binarise(const vpImageView<Type> &I, Type threshold1, Type threshold2, Type value1,
+                                   Type value2, Type value3)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    Type *p = I[i];
+    Type *pend = p + I.getWidth();
+    for (; p < pend; p++) {
+      Type v = *p;
+      if (v < threshold1)
+        *p = value1;
+      else if (v > threshold2)
+        *p = value3;
+      else
+        *p = value2;
+    }
+  }
+}
+
+/*!
+  Binarise in place the pixels of a view using a look-up table, the
+  remaining pixels of the parent image being left unchanged.
+*/
+template <>
+inline void vpImageTools::binarise(const vpImageView<unsigned char> &I, unsigned char threshold1,
+                                   unsigned char threshold2, unsigned char value1, unsigned char value2,
+                                   unsigned char value3)
+{
+  unsigned char lut[256];
+  for (unsigned int i = 0; i < 256; i++) {
+    lut[i] = i < threshold1 ? value1 : (i > threshold2 ? value3 : value2);
+  }
+
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    unsigned char *p = I[i];
+    unsigned char *pend = p + I.getWidth();
+    for (; p < pend; p++) {
+      *p = lut[*p];
+    }
+  }
+}
+
 #ifdef VISP_HAVE_PTHREAD
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -1065,7 +1172,9 @@ void vpImageTools::resizeNearest(const vpImage<Type> &I, vpImage<Type> &Ires, un
   \param width : Resized width.
   \param height : Resized height.
   \param method : Interpolation method.
-  \param nThreads : Number of threads to use if OpenMP is available.
+  \param nThreads : Maximum number of threads to use, 0 to use all the threads
+  of the pool returned by vpThreadPool::getGlobalInstance() (or OpenMP when
+  c++11 is not enabled).
 
   \warning The input \e I and output \e Ires images must be different.
 */
@@ -1087,17 +1196,15 @@ void vpImageTools::resize(const vpImage<Type> &I, vpImage<Type> &Ires, unsigned
   \param Ires : Output image resized (you have to init the image \e Ires at
   the desired size).
   \param method : Interpolation method.
-  \param nThreads : Number of threads to use if OpenMP is available.
+  \param nThreads : Maximum number of threads to use, 0 to use all the threads
+  of the pool returned by vpThreadPool::getGlobalInstance() (or OpenMP when
+  c++11 is not enabled).
 
   \warning The input \e I and output \e Ires images must be different.
 */
 template <class Type>
 void vpImageTools::resize(const vpImage<Type> &I, vpImage<Type> &Ires, const vpImageInterpolationType &method,
-                          unsigned int
-                        #if defined _OPENMP
-                          nThreads
-                        #endif
-                          )
+                          unsigned int nThreads)
 {
   if (I.getWidth() < 2 || I.getHeight() < 2 || Ires.getWidth() < 2 || Ires.getHeight() < 2) {
     std::cerr << "Input or output image is too small!" << std::endl;
@@ -1112,222 +1219,131 @@ void vpImageTools::resize(const vpImage<Type> &I, vpImage<Type> &Ires, const vpI
     scaleX = I.getWidth() / static_cast<float>(Ires.getWidth() - 1);
   }
 
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(Ires.getHeight()), [&](int start, int end) {
+    resizeRows(I, Ires, method, scaleX, scaleY, start, end);
+  }, nThreads);
+#else
 #if defined _OPENMP
   if (nThreads > 0) {
     omp_set_num_threads(static_cast<int>(nThreads));
   }
   #pragma omp parallel for schedule(dynamic)
+#else
+  (void)nThreads;
 #endif
   for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
-    float v = i * scaleY;
-    float yFrac = v - static_cast<int>(v);
-
-    for (unsigned int j = 0; j < Ires.getWidth(); j++) {
-      float u = j * scaleX;
-      float xFrac = u - static_cast<int>(u);
-
-      if (method == INTERPOLATION_NEAREST) {
-        resizeNearest(I, Ires, static_cast<unsigned int>(i), j, u, v);
-      } else if (method == INTERPOLATION_LINEAR) {
-        resizeBilinear(I, Ires, static_cast<unsigned int>(i), j, u, v, xFrac, yFrac);
-      } else if (method == INTERPOLATION_CUBIC) {
-        resizeBicubic(I, Ires, static_cast<unsigned int>(i), j, u, v, xFrac, yFrac);
-      }
-    }
+    resizeRows(I, Ires, method, scaleX, scaleY, i, i + 1);
   }
+#endif
 }
 
 template <> inline
 void vpImageTools::resize(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
-                          const vpImageInterpolationType &method, unsigned int
-                                                                  #if defined _OPENMP
-                                                                    nThreads
-                                                                  #endif
-                          )
+                          const vpImageInterpolationType &method, unsigned int nThreads)
 {
   if (I.getWidth() < 2 || I.getHeight() < 2 || Ires.getWidth() < 2 || Ires.getHeight() < 2) {
     std::cerr << "Input or output image is too small!" << std::endl;
     return;
   }
 
-  if (method == INTERPOLATION_NEAREST || method == INTERPOLATION_CUBIC) {
-    float scaleY = (I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1);
-    float scaleX = (I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1);
+  float scaleY = (I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1);
+  float scaleX = (I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1);
 
-    if (method == INTERPOLATION_NEAREST) {
-      scaleY = I.getHeight() / static_cast<float>(Ires.getHeight() - 1);
-      scaleX = I.getWidth() / static_cast<float>(Ires.getWidth() - 1);
-    }
+  if (method == INTERPOLATION_NEAREST) {
+    scaleY = I.getHeight() / static_cast<float>(Ires.getHeight() - 1);
+    scaleX = I.getWidth() / static_cast<float>(Ires.getWidth() - 1);
+  }
 
-  #if defined _OPENMP
-    if (nThreads > 0) {
-      omp_set_num_threads(static_cast<int>(nThreads));
-    }
-    #pragma omp parallel for schedule(dynamic)
-  #endif
-    for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
-      float v = i * scaleY;
-      float yFrac = v - static_cast<int>(v);
-
-      for (unsigned int j = 0; j < Ires.getWidth(); j++) {
-        float u = j * scaleX;
-        float xFrac = u - static_cast<int>(u);
-
-        if (method == INTERPOLATION_NEAREST) {
-          resizeNearest(I, Ires, static_cast<unsigned int>(i), j, u, v);
-        } else if (method == INTERPOLATION_CUBIC) {
-          resizeBicubic(I, Ires, static_cast<unsigned int>(i), j, u, v, xFrac, yFrac);
-        }
-      }
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(Ires.getHeight()), [&](int start, int end) {
+    if (method == INTERPOLATION_LINEAR) {
+      resizeBilinearFixedPointRows(I, Ires, start, end);
+    } else {
+      resizeRows(I, Ires, method, scaleX, scaleY, start, end);
     }
-  } else if (method == INTERPOLATION_LINEAR) {
-    const int32_t precision = 1 << 16;
-    int64_t scaleY = static_cast<int64_t>((I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1) * precision);
-    int64_t scaleX = static_cast<int64_t>((I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1) * precision);
-
+  }, nThreads);
+#else
 #if defined _OPENMP
-    if (nThreads > 0) {
-      omp_set_num_threads(static_cast<int>(nThreads));
-    }
-#pragma omp parallel for schedule(dynamic)
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+  #pragma omp parallel for schedule(dynamic)
+#else
+  (void)nThreads;
 #endif
-    for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
-      int64_t v = i * scaleY;
-      int64_t vround = v & (~0xFFFF);
-      int64_t rratio = v - vround;
-      int64_t y_ = v >> 16;
-      int64_t rfrac = precision - rratio;
-
-      for (unsigned int j = 0; j < Ires.getWidth(); j++) {
-        int64_t u = j * scaleX;
-        int64_t uround = u & (~0xFFFF);
-        int64_t cratio = u - uround;
-        int64_t x_ = u >> 16;
-        int64_t cfrac = precision - cratio;
-
-        if (y_ + 1 < static_cast<int64_t>(I.getHeight()) && x_ + 1 < static_cast<int64_t>(I.getWidth())) {
-          uint16_t up = vpEndian::reinterpret_cast_uchar_to_uint16_LE(I.bitmap + y_ * I.getWidth() + x_);
-          uint16_t down = vpEndian::reinterpret_cast_uchar_to_uint16_LE(I.bitmap + (y_ + 1) * I.getWidth() + x_);
-
-          Ires[i][j] = static_cast<unsigned char>((((up & 0x00FF) * rfrac + (down & 0x00FF) * rratio) * cfrac +
-                                                  ((up >> 8) * rfrac + (down >> 8) * rratio) * cratio) >> 32);
-        } else if (y_ + 1 < static_cast<int64_t>(I.getHeight())) {
-          Ires[i][j] = static_cast<unsigned char>(((*(I.bitmap + y_ * I.getWidth() + x_)
-                                                  * rfrac + *(I.bitmap + (y_ + 1) * I.getWidth() + x_) * rratio)) >> 16);
-        } else if (x_ + 1 < static_cast<int64_t>(I.getWidth())) {
-          uint16_t up = vpEndian::reinterpret_cast_uchar_to_uint16_LE(I.bitmap + y_ * I.getWidth() + x_);
-          Ires[i][j] = static_cast<unsigned char>(((up & 0x00FF) * cfrac + (up >> 8) * cratio) >> 16);
-        } else {
-          Ires[i][j] = *(I.bitmap + y_ * I.getWidth() + x_);
-        }
-      }
+  for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
+    if (method == INTERPOLATION_LINEAR) {
+      resizeBilinearFixedPointRows(I, Ires, i, i + 1);
+    } else {
+      resizeRows(I, Ires, method, scaleX, scaleY, i, i + 1);
     }
   }
+#endif
 }
 
 template <> inline
 void vpImageTools::resize(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires,
-                          const vpImageInterpolationType &method, unsigned int
-                                                                  #if defined _OPENMP
-                                                                    nThreads
-                                                                  #endif
-                          )
+                          const vpImageInterpolationType &method, unsigned int nThreads)
 {
   if (I.getWidth() < 2 || I.getHeight() < 2 || Ires.getWidth() < 2 || Ires.getHeight() < 2) {
     std::cerr << "Input or output image is too small!" << std::endl;
     return;
   }
 
-  if (method == INTERPOLATION_NEAREST || method == INTERPOLATION_CUBIC) {
-    float scaleY = (I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1);
-    float scaleX = (I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1);
+  float scaleY = (I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1);
+  float scaleX = (I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1);
 
-    if (method == INTERPOLATION_NEAREST) {
-      scaleY = I.getHeight() / static_cast<float>(Ires.getHeight() - 1);
-      scaleX = I.getWidth() / static_cast<float>(Ires.getWidth() - 1);
-    }
+  if (method == INTERPOLATION_NEAREST) {
+    scaleY = I.getHeight() / static_cast<float>(Ires.getHeight() - 1);
+    scaleX = I.getWidth() / static_cast<float>(Ires.getWidth() - 1);
+  }
 
-  #if defined _OPENMP
-    if (nThreads > 0) {
-      omp_set_num_threads(static_cast<int>(nThreads));
-    }
-    #pragma omp parallel for schedule(dynamic)
-  #endif
-    for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
-      float v = i * scaleY;
-      float yFrac = v - static_cast<int>(v);
-
-      for (unsigned int j = 0; j < Ires.getWidth(); j++) {
-        float u = j * scaleX;
-        float xFrac = u - static_cast<int>(u);
-
-        if (method == INTERPOLATION_NEAREST) {
-          resizeNearest(I, Ires, static_cast<unsigned int>(i), j, u, v);
-        } else if (method == INTERPOLATION_CUBIC) {
-          resizeBicubic(I, Ires, static_cast<unsigned int>(i), j, u, v, xFrac, yFrac);
-        }
-      }
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(Ires.getHeight()), [&](int start, int end) {
+    if (method == INTERPOLATION_LINEAR) {
+      resizeBilinearFixedPointRows(I, Ires, start, end);
+    } else {
+      resizeRows(I, Ires, method, scaleX, scaleY, start, end);
     }
-  } else {
-    const int32_t precision = 1 << 16;
-    int64_t scaleY = static_cast<int64_t>((I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1) * precision);
-    int64_t scaleX = static_cast<int64_t>((I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1) * precision);
-
+  }, nThreads);
+#else
 #if defined _OPENMP
-    if (nThreads > 0) {
-      omp_set_num_threads(static_cast<int>(nThreads));
+  if (nThreads > 0) {
+    omp_set_num_threads(static_cast<int>(nThreads));
+  }
+  #pragma omp parallel for schedule(dynamic)
+#else
+  (void)nThreads;
+#endif
+  for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
+    if (method == INTERPOLATION_LINEAR) {
+      resizeBilinearFixedPointRows(I, Ires, i, i + 1);
+    } else {
+      resizeRows(I, Ires, method, scaleX, scaleY, i, i + 1);
     }
-#pragma omp parallel for schedule(dynamic)
+  }
 #endif
-    for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
-      int64_t v = i * scaleY;
-      int64_t vround = v & (~0xFFFF);
-      int64_t rratio = v - vround;
-      int64_t y_ = v >> 16;
-      int64_t rfrac = precision - rratio;
-
-      for (unsigned int j = 0; j < Ires.getWidth(); j++) {
-        int64_t u = j * scaleX;
-        int64_t uround = u & (~0xFFFF);
-        int64_t cratio = u - uround;
-        int64_t x_ = u >> 16;
-        int64_t cfrac = precision - cratio;
-
-        if (y_ + 1 < static_cast<int64_t>(I.getHeight()) && x_ + 1 < static_cast<int64_t>(I.getWidth())) {
-          int64_t col0 = lerp2((I.bitmap + y_ * I.getWidth() + x_)->R, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->R, rratio, rfrac);
-          int64_t col1 = lerp2((I.bitmap + y_ * I.getWidth() + x_ + 1)->R, (I.bitmap + (y_ + 1) * I.getWidth() + x_ + 1)->R, rratio, rfrac);
-          int64_t valueR = lerp2(col0, col1, cratio, cfrac);
-
-          col0 = lerp2((I.bitmap + y_ * I.getWidth() + x_)->G, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->G, rratio, rfrac);
-          col1 = lerp2((I.bitmap + y_ * I.getWidth() + x_ + 1)->G, (I.bitmap + (y_ + 1) * I.getWidth() + x_ + 1)->G, rratio, rfrac);
-          int64_t valueG = lerp2(col0, col1, cratio, cfrac);
-
-          col0 = lerp2((I.bitmap + y_ * I.getWidth() + x_)->B, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->B, rratio, rfrac);
-          col1 = lerp2((I.bitmap + y_ * I.getWidth() + x_ + 1)->B, (I.bitmap + (y_ + 1) * I.getWidth() + x_ + 1)->B, rratio, rfrac);
-          int64_t valueB = lerp2(col0, col1, cratio, cfrac);
-
-          Ires[i][j] = vpRGBa(static_cast<unsigned char>(valueR >> 32),
-                              static_cast<unsigned char>(valueG >> 32),
-                              static_cast<unsigned char>(valueB >> 32));
-        } else if (y_ + 1 < static_cast<int64_t>(I.getHeight())) {
-          int64_t valueR = lerp2((I.bitmap + y_ * I.getWidth() + x_)->R, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->R, rratio, rfrac);
-          int64_t valueG = lerp2((I.bitmap + y_ * I.getWidth() + x_)->G, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->G, rratio, rfrac);
-          int64_t valueB = lerp2((I.bitmap + y_ * I.getWidth() + x_)->B, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->B, rratio, rfrac);
-
-          Ires[i][j] = vpRGBa(static_cast<unsigned char>(valueR >> 16),
-                              static_cast<unsigned char>(valueG >> 16),
-                              static_cast<unsigned char>(valueB >> 16));
-        } else if (x_ + 1 < static_cast<int64_t>(I.getWidth())) {
-          int64_t valueR = lerp2((I.bitmap + x_)->R, (I.bitmap + x_ + 1)->R, cratio, cfrac);
-          int64_t valueG = lerp2((I.bitmap + x_)->G, (I.bitmap + x_ + 1)->G, cratio, cfrac);
-          int64_t valueB = lerp2((I.bitmap + x_)->B, (I.bitmap + x_ + 1)->B, cratio, cfrac);
-
-          Ires[i][j] = vpRGBa(static_cast<unsigned char>(valueR >> 16),
-                              static_cast<unsigned char>(valueG >> 16),
-                              static_cast<unsigned char>(valueB >> 16));
-        } else {
-          Ires[i][j] = *(I.bitmap + y_ * I.getWidth() + x_);
-        }
+}
+
+template <class Type>
+void vpImageTools::resizeRows(const vpImage<Type> &I, vpImage<Type> &Ires, const vpImageInterpolationType &method,
+                              float scaleX, float scaleY, int rowStart, int rowEnd)
+{
+  for (int i = rowStart; i < rowEnd; i++) {
+    float v = i * scaleY;
+    float yFrac = v - static_cast<int>(v);
+
+    for (unsigned int j = 0; j < Ires.getWidth(); j++) {
+      float u = j * scaleX;
+      float xFrac = u - static_cast<int>(u);
+
+      if (method == INTERPOLATION_NEAREST) {
+        resizeNearest(I, Ires, static_cast<unsigned int>(i), j, u, v);
+      } else if (method == INTERPOLATION_LINEAR) {
+        resizeBilinear(I, Ires, static_cast<unsigned int>(i), j, u, v, xFrac, yFrac);
+      } else if (method == INTERPOLATION_CUBIC) {
+        resizeBicubic(I, Ires, static_cast<unsigned int>(i), j, u, v, xFrac, yFrac);
       }
     }
   }
@@ -0,0 +1,220 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Non-owning view on a region of an image.
+ *
+ *****************************************************************************/
+
+#ifndef _vpImageView_h_
+#define _vpImageView_h_
+
+/*!
+  \file vpImageView.h
+  \brief Non-owning view on a region of an image.
+*/
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRect.h>
+
+#include <algorithm>
+#include <cmath>
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <type_traits>
+#endif
+
+/*!
+  \class vpImageView
+
+  \ingroup group_core_image
+
+  \brief Non-owning view on a rectangular region of an image.
+
+  Contrary to vpImage, a view does not allocate nor copy any pixel. It refers
+  to the memory of a parent image or of an external buffer, consecutive rows
+  being separated by a stride that may be larger than the width. This allows
+  to process a region of interest (ROI) without cropping it, or to wrap a
+  frame whose rows are padded, as returned by some frame grabbers.
+
+  A view with a \e const pixel type gives a read-only access to the pixels.
+  The view must not outlive the memory it refers to, and it becomes invalid
+  when the parent image is resized.
+
+  \code
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageView.h>
+
+int main()
+{
+  vpImage<unsigned char> I(480, 640, 128);
+
+  // Set a region of interest to 0 without copy
+  vpImageView<unsigned char> roi(I, vpRect(100, 50, 200, 150));
+  for (unsigned int i = 0; i < roi.getHeight(); i++) {
+    for (unsigned int j = 0; j < roi.getWidth(); j++) {
+      roi[i][j] = 0;
+    }
+  }
+
+  // Blur the region of interest only
+  vpImage<double> I_blur;
+  vpImageFilter::gaussianBlur(vpImageView<const unsigned char>(I, vpRect(100, 50, 200, 150)), I_blur);
+
+  // Wrap a frame whose rows are padded to 704 pixels
+  std::vector<unsigned char> frame(480 * 704);
+  vpImageView<const unsigned char> view(&frame[0], 480, 640, 704);
+}
+  \endcode
+
+  vpImageFilter, vpImageTools, vpImageConvert and vpImageIo provide functions
+  that take views as input.
+*/
+template <class Type> class vpImageView
+{
+public:
+  //! Empty view.
+  vpImageView() : m_data(NULL), m_height(0), m_width(0), m_stride(0) {}
+
+  /*!
+    View on an external buffer.
+    \param data : Pointer to the first pixel.
+    \param height, width : Size of the view.
+    \param stride : Number of pixels between the beginning of two
+    consecutive rows, greater than or equal to \e width. If 0, the rows are
+    supposed to be contiguous.
+  */
+  vpImageView(Type *data, unsigned int height, unsigned int width, unsigned int stride = 0)
+    : m_data(data), m_height(height), m_width(width), m_stride(stride == 0 ? width : stride)
+  {
+    if (m_stride < m_width) {
+      throw(vpException(vpException::dimensionError, "Cannot create a view with a stride of %u on %u pixels rows",
+                        m_stride, m_width));
+    }
+  }
+
+  //! View on the whole image.
+  template <class T>
+  explicit vpImageView(vpImage<T> &I)
+    : m_data(I.bitmap), m_height(I.getHeight()), m_width(I.getWidth()), m_stride(I.getWidth())
+  {
+  }
+
+  /*!
+    Read-only view on the whole image. Only available when \e Type is const,
+    so that a const image cannot be modified through a view.
+  */
+  template <class T>
+  explicit vpImageView(const vpImage<T> &I)
+    : m_data(static_cast<const T *>(I.bitmap)), m_height(I.getHeight()), m_width(I.getWidth()),
+      m_stride(I.getWidth())
+  {
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+    static_assert(std::is_const<Type>::value, "A view on a const image must have a const pixel type");
+#endif
+  }
+
+  /*!
+    View on a region of interest of an image. The region is clipped to the
+    image as in vpImageTools::crop(), so that the view has the size and
+    content of the image that would be cropped.
+  */
+  template <class T> vpImageView(vpImage<T> &I, const vpRect &roi) : m_data(NULL), m_height(0), m_width(0), m_stride(0)
+  {
+    *this = vpImageView<Type>(I).getView(roi);
+  }
+
+  /*!
+    Read-only view on a region of interest of an image. Only available when
+    \e Type is const.
+  */
+  template <class T>
+  vpImageView(const vpImage<T> &I, const vpRect &roi) : m_data(NULL), m_height(0), m_width(0), m_stride(0)
+  {
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+    static_assert(std::is_const<Type>::value, "A view on a const image must have a const pixel type");
+#endif
+    *this = vpImageView<Type>(I).getView(roi);
+  }
+
+  //! Conversion of a view to a read-only view.
+  template <class T>
+  vpImageView(const vpImageView<T> &view)
+    : m_data(view.getData()), m_height(view.getHeight()), m_width(view.getWidth()), m_stride(view.getStride())
+  {
+  }
+
+  //! Pointer to the first pixel.
+  inline Type *getData() const { return m_data; }
+  //! Number of rows.
+  inline unsigned int getHeight() const { return m_height; }
+  //! Number of pixels in a row.
+  inline unsigned int getWidth() const { return m_width; }
+  //! Number of pixels between the beginning of two consecutive rows.
+  inline unsigned int getStride() const { return m_stride; }
+  //! Number of pixels of the view.
+  inline unsigned int getSize() const { return m_height * m_width; }
+  //! True when the rows are contiguous in memory, as in a vpImage.
+  inline bool isContiguous() const { return m_stride == m_width || m_height <= 1; }
+
+  /*!
+    Sub-view on a region of interest defined in the coordinates of this view.
+    The region is clipped as in vpImageTools::crop().
+  */
+  vpImageView<Type> getView(const vpRect &roi) const
+  {
+    const int i_min = (std::max)(static_cast<int>(std::ceil(roi.getTop())), 0);
+    const int j_min = (std::max)(static_cast<int>(std::ceil(roi.getLeft())), 0);
+    const int i_max = (std::min)(static_cast<int>(std::ceil(roi.getTop() + static_cast<unsigned int>(roi.getHeight()))),
+                                 static_cast<int>(m_height));
+    const int j_max = (std::min)(static_cast<int>(std::ceil(roi.getLeft() + static_cast<unsigned int>(roi.getWidth()))),
+                                 static_cast<int>(m_width));
+    if (i_max <= i_min || j_max <= j_min) {
+      return vpImageView<Type>(m_data, 0, 0, m_stride);
+    }
+
+    return vpImageView<Type>(m_data + static_cast<size_t>(i_min) * m_stride + j_min,
+                             static_cast<unsigned int>(i_max - i_min), static_cast<unsigned int>(j_max - j_min),
+                             m_stride);
+  }
+
+  //! Pointer to the first pixel of row \e i.
+  inline Type *operator[](unsigned int i) const { return m_data + static_cast<size_t>(i) * m_stride; }
+  //! Pointer to the first pixel of row \e i.
+  inline Type *operator[](int i) const { return m_data + static_cast<size_t>(i) * m_stride; }
+
+private:
+  Type *m_data;
+  unsigned int m_height;
+  unsigned int m_width;
+  unsigned int m_stride;
+};
+
+#endif
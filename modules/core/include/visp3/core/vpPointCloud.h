@@ -0,0 +1,155 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Organized point cloud with contiguous coordinates.
+ *
+ *****************************************************************************/
+
+#ifndef vpPointCloud_h
+#define vpPointCloud_h
+
+/*!
+  \file vpPointCloud.h
+  \brief Organized point cloud with contiguous coordinates.
+*/
+
+#include <vector>
+
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpPointCloud
+  \ingroup group_core_geometry
+
+  \brief Organized point cloud, as delivered by a depth sensor, whose
+  coordinates are stored in contiguous arrays.
+
+  The point of index \f$ i \times width + j \f$ is the 3D point measured at
+  the pixel of row \e i and column \e j of the depth image. Contrary to a
+  <tt>std::vector<vpColVector></tt> that needs one allocation per point, the
+  X, Y and Z coordinates of all the points are stored in three contiguous
+  arrays of floats (structure of arrays). Resizing a point cloud to the size
+  it already has does not allocate memory, so that a point cloud can be
+  reused from one frame to the next at no cost.
+
+  A point cloud can also wrap an existing buffer without copying it, for
+  example the vertices computed by the sensor SDK. The coordinates of the
+  point of index \e i are then read at \e x[i*stride], \e y[i*stride] and
+  \e z[i*stride], which allows to wrap separate arrays (\e stride = 1) as
+  well as interleaved XYZ points:
+  \code
+#include <visp3/core/vpPointCloud.h>
+
+int main()
+{
+  const unsigned int width = 640, height = 480;
+  std::vector<float> xyz(3 * width * height); // x0 y0 z0 x1 y1 z1 ...
+
+  // No copy, the buffer must outlive the point cloud
+  vpPointCloud pointcloud(&xyz[0], &xyz[1], &xyz[2], width, height, 3);
+  float Z = pointcloud.getZ(10 * width + 20); // Depth of the pixel (10, 20)
+}
+  \endcode
+
+  Invalid points are expected to have a Z coordinate that is not strictly
+  positive, or NaN.
+*/
+class VISP_EXPORT vpPointCloud
+{
+public:
+  vpPointCloud();
+  vpPointCloud(unsigned int width, unsigned int height);
+  vpPointCloud(const float *x, const float *y, const float *z, unsigned int width, unsigned int height,
+               unsigned int stride = 1);
+  vpPointCloud(const vpPointCloud &pointcloud);
+
+  void buildFrom(const std::vector<vpColVector> &pointcloud, unsigned int width, unsigned int height);
+
+  void convert(std::vector<vpColVector> &pointcloud) const;
+
+  //! Number of rows of the organized point cloud.
+  inline unsigned int getHeight() const { return m_height; }
+  //! Number of points.
+  inline unsigned int getSize() const { return m_width * m_height; }
+  //! Distance in floats between two consecutive coordinates of the same axis.
+  inline unsigned int getStride() const { return m_stride; }
+  //! Number of columns of the organized point cloud.
+  inline unsigned int getWidth() const { return m_width; }
+
+  //! X coordinate of the point of index \e index.
+  inline float getX(unsigned int index) const { return m_x[index * m_stride]; }
+  //! Y coordinate of the point of index \e index.
+  inline float getY(unsigned int index) const { return m_y[index * m_stride]; }
+  //! Z coordinate of the point of index \e index.
+  inline float getZ(unsigned int index) const { return m_z[index * m_stride]; }
+
+  //! Pointer to the X coordinate of the first point.
+  inline const float *getX() const { return m_x; }
+  //! Pointer to the Y coordinate of the first point.
+  inline const float *getY() const { return m_y; }
+  //! Pointer to the Z coordinate of the first point.
+  inline const float *getZ() const { return m_z; }
+
+  //! Return true if the coordinates are stored in the point cloud, false if an external buffer is wrapped.
+  inline bool isOwner() const { return !m_data.empty() || getSize() == 0; }
+
+  vpPointCloud &operator=(const vpPointCloud &pointcloud);
+
+  void resize(unsigned int width, unsigned int height);
+
+  /*!
+    Set the coordinates of the point of index \e index. The point cloud must
+    own its coordinates, see resize().
+  */
+  inline void set(unsigned int index, float x, float y, float z)
+  {
+    const unsigned int size = m_width * m_height;
+    m_data[index] = x;
+    m_data[size + index] = y;
+    m_data[2 * size + index] = z;
+  }
+
+  void wrap(const float *x, const float *y, const float *z, unsigned int width, unsigned int height,
+            unsigned int stride = 1);
+
+private:
+  //! Storage of the X, then Y, then Z coordinates when the point cloud is not a wrapper
+  std::vector<float> m_data;
+  const float *m_x;
+  const float *m_y;
+  const float *m_z;
+  unsigned int m_width;
+  unsigned int m_height;
+  unsigned int m_stride;
+};
+
+#endif
@@ -54,6 +54,14 @@
   \brief Contains an M-Estimator and various influence function.
 
   Supported methods: M-estimation, Tukey, Cauchy and Huber
+
+  The containers used to compute the medians are kept from one call to the
+  next, so that an instance used at each iteration of a virtual visual
+  servoing loop doesn't allocate memory once the number of residues is
+  stable. The medians are selected in linear time, with a radix selection on
+  large sets of residues and std::nth_element() otherwise, and the weights
+  are computed with SSE2 instructions when available. The weights are the
+  same as with the scalar implementation.
 */
 class VISP_EXPORT vpRobust
 {
@@ -76,8 +84,6 @@ private:
   double sig_prev;
   //!
   unsigned int it;
-  //! Vairiable used in swap method
-  double swap;
   //! Size of the containers
   unsigned int size;
 
@@ -180,16 +186,7 @@ private:
 
   /** @name Sort function  */
   //@{
-  //! Swap two value
-  void exch(double &A, double &B)
-  {
-    swap = A;
-    A = B;
-    B = swap;
-  }
-  //! Sort function using partition method
-  int partition(vpColVector &a, int l, int r);
-  //! Sort the vector and select a value in the sorted vector
+  //! Partially sort the vector and select a value in the sorted vector
   double select(vpColVector &a, int l, int r, int k);
   //@}
 };
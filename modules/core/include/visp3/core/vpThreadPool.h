@@ -0,0 +1,125 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Pool of reusable worker threads.
+ *
+ *****************************************************************************/
+
+#ifndef _vpThreadPool_h_
+#define _vpThreadPool_h_
+
+#include <visp3/core/vpConfig.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+
+#include <functional>
+#include <vector>
+
+/*!
+  \class vpThreadPool
+
+  \ingroup group_core_threading
+
+  Pool of worker threads that are created once and reused to execute batches
+  of independent tasks. Contrary to vpThread, no thread is created or joined
+  when a batch is executed, which makes this class suited for short tasks
+  that are repeated at frame rate.
+
+  The number of threads includes the calling thread: a pool created with 4
+  threads owns 3 workers, the caller executing tasks too while it waits for
+  the end of the batch. With a single thread, tasks are executed sequentially
+  by the caller.
+
+  Each thread has its own queue of tasks. A thread that has emptied its queue
+  steals tasks from the other ones, so that the load stays balanced when the
+  tasks do not have the same cost. A task may itself run tasks on the same
+  pool: the waiting thread keeps executing pending tasks instead of blocking.
+
+  Loops over image rows are better written with parallelFor(), which splits
+  the range into chunks. The pool returned by getGlobalInstance() is shared
+  by the library functions that accept a number of threads, which avoids
+  creating threads at each call and oversubscribing the cores.
+
+  If a task throws an exception, the remaining tasks of the batch are still
+  executed and the first exception is rethrown by run().
+
+  \code
+#include <visp3/core/vpThreadPool.h>
+
+int main()
+{
+  std::vector<double> results(4);
+  std::vector<std::function<void()> > tasks;
+  for (size_t i = 0; i < results.size(); i++) {
+    tasks.push_back([&results, i]() { results[i] = static_cast<double>(i * i); });
+  }
+
+  vpThreadPool pool(2);
+  pool.run(tasks);
+
+  std::vector<double> squares(1000);
+  vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(squares.size()), [&squares](int start, int end) {
+    for (int i = start; i < end; i++) {
+      squares[i] = static_cast<double>(i * i);
+    }
+  });
+}
+  \endcode
+
+  \note This class requires c++11 or higher.
+*/
+class VISP_EXPORT vpThreadPool
+{
+public:
+  explicit vpThreadPool(unsigned int nbThreads = 0);
+  virtual ~vpThreadPool();
+
+  static vpThreadPool &getGlobalInstance();
+
+  unsigned int getNbThreads() const;
+
+  void parallelFor(int begin, int end, const std::function<void(int, int)> &body, unsigned int nbThreads = 0,
+                   int grainSize = 0);
+
+  void run(const std::vector<std::function<void()> > &tasks);
+
+  void setNbThreads(unsigned int nbThreads);
+
+private:
+  vpThreadPool(const vpThreadPool &);            // noncopyable
+  vpThreadPool &operator=(const vpThreadPool &); //
+
+  class Impl;
+  Impl *m_impl;
+};
+
+#endif
+#endif
@@ -0,0 +1,556 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bayer demosaicing and NV12/NV21 conversion kernels.
+ *
+ *****************************************************************************/
+
+#ifndef _vpBayerConversion_h_
+#define _vpBayerConversion_h_
+
+// Internal header included by vpImageConvert.cpp once the SSE macros are defined
+
+#include <cstring>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpThreadPool.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// The missing channels of a pixel are interpolated from the pixel itself, its
+// left and right neighbours, its top and bottom neighbours, its four diagonal
+// neighbours or its four direct neighbours
+enum vpBayerSource { BAYER_CENTER = 0, BAYER_HORIZONTAL, BAYER_VERTICAL, BAYER_DIAGONAL, BAYER_CROSS };
+
+// Source of the R, G and B channels for the even and odd columns of a row
+struct vpBayerRowLayout {
+  int src[2][3];
+};
+
+vpBayerRowLayout getBayerRowLayout(vpImageConvert::vpBayerPattern pattern, unsigned int y)
+{
+  enum { R = 0, G = 1, B = 2 };
+  static const int colors[4][2][2] = {
+      {{B, G}, {G, R}}, // BAYER_BGGR
+      {{G, B}, {R, G}}, // BAYER_GBRG
+      {{G, R}, {B, G}}, // BAYER_GRBG
+      {{R, G}, {G, B}}  // BAYER_RGGB
+  };
+
+  const int(&row)[2] = colors[pattern][y % 2];
+  vpBayerRowLayout layout;
+  for (int x = 0; x < 2; x++) {
+    int *src = layout.src[x];
+    if (row[x] == R) {
+      src[R] = BAYER_CENTER;
+      src[G] = BAYER_CROSS;
+      src[B] = BAYER_DIAGONAL;
+    } else if (row[x] == B) {
+      src[R] = BAYER_DIAGONAL;
+      src[G] = BAYER_CROSS;
+      src[B] = BAYER_CENTER;
+    } else {
+      const bool redOnRow = (row[1 - x] == R);
+      src[R] = redOnRow ? BAYER_HORIZONTAL : BAYER_VERTICAL;
+      src[G] = BAYER_CENTER;
+      src[B] = redOnRow ? BAYER_VERTICAL : BAYER_HORIZONTAL;
+    }
+  }
+
+  return layout;
+}
+
+// Mirror an index around the first and last samples, which keeps the parity
+// of the Bayer pattern
+inline int reflectBayerIndex(int i, int n)
+{
+  if (i < 0) {
+    i = -i;
+  }
+  if (i >= n) {
+    i = 2 * (n - 1) - i;
+  }
+  // Only reached by images smaller than the 5x5 neighbourhood
+  return i < 0 ? 0 : (i >= n ? n - 1 : i);
+}
+
+// Interpolate one source from the 5x5 neighbourhood given by the row pointers
+// and the column indexes, the result being clamped to [0, maxValue]
+template <typename T>
+inline int computeBayerSource(int source, const T *const rows[5], const int cols[5], bool malvar, int maxValue)
+{
+  const int c = rows[2][cols[2]];
+  if (source == BAYER_CENTER) {
+    return c;
+  }
+
+  const int n = rows[1][cols[2]], s = rows[3][cols[2]];
+  const int w = rows[2][cols[1]], e = rows[2][cols[3]];
+  const int diag = rows[1][cols[1]] + rows[1][cols[3]] + rows[3][cols[1]] + rows[3][cols[3]];
+
+  if (!malvar) {
+    switch (source) {
+    case BAYER_HORIZONTAL:
+      return (w + e + 1) >> 1;
+    case BAYER_VERTICAL:
+      return (n + s + 1) >> 1;
+    case BAYER_DIAGONAL:
+      return (diag + 2) >> 2;
+    default:
+      return (n + s + w + e + 2) >> 2;
+    }
+  }
+
+  // Gradient-corrected filters of Malvar, He and Cutler, scaled by 16
+  const int farH = rows[2][cols[0]] + rows[2][cols[4]];
+  const int farV = rows[0][cols[2]] + rows[4][cols[2]];
+  int v;
+  switch (source) {
+  case BAYER_HORIZONTAL:
+    v = 10 * c + 8 * (w + e) - 2 * (farH + diag) + farV;
+    break;
+  case BAYER_VERTICAL:
+    v = 10 * c + 8 * (n + s) - 2 * (farV + diag) + farH;
+    break;
+  case BAYER_DIAGONAL:
+    v = 12 * c + 4 * diag - 3 * (farH + farV);
+    break;
+  default:
+    v = 8 * c + 4 * (n + s + w + e) - 2 * (farH + farV);
+    break;
+  }
+
+  if (v < 0) {
+    return 0;
+  }
+  v = (v + 8) >> 4;
+  return v > maxValue ? maxValue : v;
+}
+
+// Same luminance weights as RGBaToGrey() in 8 bits fixed point
+inline unsigned char bayerRGBToGrey(int r, int g, int b)
+{
+  return static_cast<unsigned char>((54 * r + 183 * g + 19 * b + 128) >> 8);
+}
+
+#if VISP_HAVE_SSE2
+// Store 8 or 4 pixels whose channels are given as 16-bit integers in [0, 255]
+inline void storeBayerSSE2(const __m128i channels[3], int nbPixels, unsigned char *rgba, unsigned char *grey)
+{
+  const __m128i zero = _mm_setzero_si128();
+  if (rgba != NULL) {
+    const __m128i r = _mm_packus_epi16(channels[0], zero);
+    const __m128i g = _mm_packus_epi16(channels[1], zero);
+    const __m128i b = _mm_packus_epi16(channels[2], zero);
+    const __m128i a = _mm_set1_epi8(static_cast<char>(vpRGBa::alpha_default));
+    const __m128i rg = _mm_unpacklo_epi8(r, g);
+    const __m128i ba = _mm_unpacklo_epi8(b, a);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(rgba), _mm_unpacklo_epi16(rg, ba));
+    if (nbPixels == 8) {
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(rgba + 16), _mm_unpackhi_epi16(rg, ba));
+    }
+  } else {
+    // 54*255 + 183*255 + 19*255 + 128 < 65536: the weighted sum fits in unsigned 16-bit integers
+    __m128i sum = _mm_add_epi16(_mm_mullo_epi16(channels[0], _mm_set1_epi16(54)),
+                                _mm_mullo_epi16(channels[1], _mm_set1_epi16(183)));
+    sum = _mm_add_epi16(sum, _mm_mullo_epi16(channels[2], _mm_set1_epi16(19)));
+    sum = _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(128)), 8);
+    const __m128i values = _mm_packus_epi16(sum, zero);
+    if (nbPixels == 8) {
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(grey), values);
+    } else {
+      const int packed = _mm_cvtsi128_si32(values);
+      memcpy(grey, &packed, 4);
+    }
+  }
+}
+
+// Demosaic 8 pixels of an 8-bit mosaic starting at the even column x, the
+// rows of the 5x5 neighbourhood being given by p[0] to p[4]
+inline void demosaicBayer8SSE2(const unsigned char *const p[5], unsigned int x, bool malvar,
+                               const vpBayerRowLayout &layout, unsigned char *rgba, unsigned char *grey)
+{
+  const __m128i zero = _mm_setzero_si128();
+#define VP_LOAD_BAYER(row, offset)                                                                                     \
+  _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p[row] + x + (offset))), zero)
+
+  const __m128i c = VP_LOAD_BAYER(2, 0);
+  const __m128i hor = _mm_add_epi16(VP_LOAD_BAYER(2, -1), VP_LOAD_BAYER(2, 1));
+  const __m128i ver = _mm_add_epi16(VP_LOAD_BAYER(1, 0), VP_LOAD_BAYER(3, 0));
+  const __m128i diag = _mm_add_epi16(_mm_add_epi16(VP_LOAD_BAYER(1, -1), VP_LOAD_BAYER(1, 1)),
+                                     _mm_add_epi16(VP_LOAD_BAYER(3, -1), VP_LOAD_BAYER(3, 1)));
+
+  __m128i src[5];
+  src[BAYER_CENTER] = c;
+  if (!malvar) {
+    const __m128i one = _mm_set1_epi16(1), two = _mm_set1_epi16(2);
+    src[BAYER_HORIZONTAL] = _mm_srli_epi16(_mm_add_epi16(hor, one), 1);
+    src[BAYER_VERTICAL] = _mm_srli_epi16(_mm_add_epi16(ver, one), 1);
+    src[BAYER_DIAGONAL] = _mm_srli_epi16(_mm_add_epi16(diag, two), 2);
+    src[BAYER_CROSS] = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hor, ver), two), 2);
+  } else {
+    // Sums stay within [-12*255, 28*255] and fit in signed 16-bit integers
+    const __m128i farH = _mm_add_epi16(VP_LOAD_BAYER(2, -2), VP_LOAD_BAYER(2, 2));
+    const __m128i farV = _mm_add_epi16(VP_LOAD_BAYER(0, 0), VP_LOAD_BAYER(4, 0));
+    const __m128i far4 = _mm_add_epi16(farH, farV);
+    const __m128i c8 = _mm_slli_epi16(c, 3);
+    const __m128i c10 = _mm_add_epi16(c8, _mm_slli_epi16(c, 1));
+    const __m128i eight = _mm_set1_epi16(8);
+
+    __m128i v = _mm_sub_epi16(_mm_add_epi16(c10, _mm_slli_epi16(hor, 3)),
+                              _mm_slli_epi16(_mm_add_epi16(farH, diag), 1));
+    src[BAYER_HORIZONTAL] = _mm_srai_epi16(_mm_add_epi16(_mm_add_epi16(v, farV), eight), 4);
+
+    v = _mm_sub_epi16(_mm_add_epi16(c10, _mm_slli_epi16(ver, 3)), _mm_slli_epi16(_mm_add_epi16(farV, diag), 1));
+    src[BAYER_VERTICAL] = _mm_srai_epi16(_mm_add_epi16(_mm_add_epi16(v, farH), eight), 4);
+
+    v = _mm_add_epi16(_mm_add_epi16(c8, _mm_slli_epi16(c, 2)), _mm_slli_epi16(diag, 2));
+    v = _mm_sub_epi16(v, _mm_add_epi16(_mm_slli_epi16(far4, 1), far4));
+    src[BAYER_DIAGONAL] = _mm_srai_epi16(_mm_add_epi16(v, eight), 4);
+
+    v = _mm_add_epi16(c8, _mm_slli_epi16(_mm_add_epi16(hor, ver), 2));
+    v = _mm_sub_epi16(v, _mm_slli_epi16(far4, 1));
+    src[BAYER_CROSS] = _mm_srai_epi16(_mm_add_epi16(v, eight), 4);
+  }
+#undef VP_LOAD_BAYER
+
+  // Odd lanes take the sources of the odd columns, negative values and values
+  // above 255 are saturated by the packing
+  const __m128i odd = _mm_set_epi16(-1, 0, -1, 0, -1, 0, -1, 0);
+  __m128i channels[3];
+  for (int k = 0; k < 3; k++) {
+    channels[k] = _mm_or_si128(_mm_and_si128(odd, src[layout.src[1][k]]), _mm_andnot_si128(odd, src[layout.src[0][k]]));
+    channels[k] = _mm_unpacklo_epi8(_mm_packus_epi16(channels[k], channels[k]), zero);
+  }
+
+  storeBayerSSE2(channels, 8, rgba ? rgba + 4 * x : NULL, grey ? grey + x : NULL);
+}
+
+// Demosaic 4 pixels of a mosaic with more than 8 bits per sample starting at
+// the even column x, using 32-bit lanes
+inline void demosaicBayer16SSE2(const uint16_t *const p[5], unsigned int x, bool malvar, unsigned int shift,
+                                const vpBayerRowLayout &layout, unsigned char *rgba, unsigned char *grey)
+{
+  const __m128i zero = _mm_setzero_si128();
+#define VP_LOAD_BAYER(row, offset)                                                                                     \
+  _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p[row] + x + (offset))), zero)
+
+  const __m128i c = VP_LOAD_BAYER(2, 0);
+  const __m128i hor = _mm_add_epi32(VP_LOAD_BAYER(2, -1), VP_LOAD_BAYER(2, 1));
+  const __m128i ver = _mm_add_epi32(VP_LOAD_BAYER(1, 0), VP_LOAD_BAYER(3, 0));
+  const __m128i diag = _mm_add_epi32(_mm_add_epi32(VP_LOAD_BAYER(1, -1), VP_LOAD_BAYER(1, 1)),
+                                     _mm_add_epi32(VP_LOAD_BAYER(3, -1), VP_LOAD_BAYER(3, 1)));
+
+  __m128i src[5];
+  src[BAYER_CENTER] = c;
+  if (!malvar) {
+    const __m128i one = _mm_set1_epi32(1), two = _mm_set1_epi32(2);
+    src[BAYER_HORIZONTAL] = _mm_srli_epi32(_mm_add_epi32(hor, one), 1);
+    src[BAYER_VERTICAL] = _mm_srli_epi32(_mm_add_epi32(ver, one), 1);
+    src[BAYER_DIAGONAL] = _mm_srli_epi32(_mm_add_epi32(diag, two), 2);
+    src[BAYER_CROSS] = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(hor, ver), two), 2);
+  } else {
+    const __m128i farH = _mm_add_epi32(VP_LOAD_BAYER(2, -2), VP_LOAD_BAYER(2, 2));
+    const __m128i farV = _mm_add_epi32(VP_LOAD_BAYER(0, 0), VP_LOAD_BAYER(4, 0));
+    const __m128i far4 = _mm_add_epi32(farH, farV);
+    const __m128i c8 = _mm_slli_epi32(c, 3);
+    const __m128i c10 = _mm_add_epi32(c8, _mm_slli_epi32(c, 1));
+    const __m128i eight = _mm_set1_epi32(8);
+
+    __m128i v = _mm_sub_epi32(_mm_add_epi32(c10, _mm_slli_epi32(hor, 3)),
+                              _mm_slli_epi32(_mm_add_epi32(farH, diag), 1));
+    src[BAYER_HORIZONTAL] = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(v, farV), eight), 4);
+
+    v = _mm_sub_epi32(_mm_add_epi32(c10, _mm_slli_epi32(ver, 3)), _mm_slli_epi32(_mm_add_epi32(farV, diag), 1));
+    src[BAYER_VERTICAL] = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(v, farH), eight), 4);
+
+    v = _mm_add_epi32(_mm_add_epi32(c8, _mm_slli_epi32(c, 2)), _mm_slli_epi32(diag, 2));
+    v = _mm_sub_epi32(v, _mm_add_epi32(_mm_slli_epi32(far4, 1), far4));
+    src[BAYER_DIAGONAL] = _mm_srai_epi32(_mm_add_epi32(v, eight), 4);
+
+    v = _mm_add_epi32(c8, _mm_slli_epi32(_mm_add_epi32(hor, ver), 2));
+    v = _mm_sub_epi32(v, _mm_slli_epi32(far4, 1));
+    src[BAYER_CROSS] = _mm_srai_epi32(_mm_add_epi32(v, eight), 4);
+  }
+#undef VP_LOAD_BAYER
+
+  // Clamp to [0, maxValue] before scaling down to 8 bits, SSE2 having no min and max on 32-bit integers
+  const __m128i maxValue = _mm_set1_epi32((256 << shift) - 1);
+  const __m128i count = _mm_cvtsi32_si128(static_cast<int>(shift));
+  const __m128i odd = _mm_set_epi32(-1, 0, -1, 0);
+  __m128i channels[3];
+  for (int k = 0; k < 3; k++) {
+    __m128i v = _mm_or_si128(_mm_and_si128(odd, src[layout.src[1][k]]), _mm_andnot_si128(odd, src[layout.src[0][k]]));
+    v = _mm_andnot_si128(_mm_srai_epi32(v, 31), v);
+    const __m128i above = _mm_cmpgt_epi32(v, maxValue);
+    v = _mm_or_si128(_mm_and_si128(above, maxValue), _mm_andnot_si128(above, v));
+    channels[k] = _mm_packs_epi32(_mm_srl_epi32(v, count), zero);
+  }
+
+  storeBayerSSE2(channels, 4, rgba ? rgba + 4 * x : NULL, grey ? grey + x : NULL);
+}
+#endif
+
+// Demosaic the row y of a mosaic into either rgba or grey, the values of the
+// mosaic being divided by 2^shift to fit in 8 bits
+template <typename T>
+void demosaicBayerRow(const T *bayer, unsigned int width, unsigned int height, unsigned int y,
+                      vpImageConvert::vpBayerPattern pattern, vpImageConvert::vpDemosaicMethod method,
+                      unsigned int shift, bool useSSE2, unsigned char *rgba, unsigned char *grey)
+{
+  const bool malvar = (method == vpImageConvert::DEMOSAIC_MALVAR);
+  const int maxValue = (256 << shift) - 1;
+  const int w = static_cast<int>(width);
+  const vpBayerRowLayout layout = getBayerRowLayout(pattern, y);
+
+  const T *rows[5];
+  for (int k = 0; k < 5; k++) {
+    rows[k] = bayer + reflectBayerIndex(static_cast<int>(y) + k - 2, static_cast<int>(height)) * width;
+  }
+
+  int x = 0;
+  while (x < w) {
+#if VISP_HAVE_SSE2
+    // Columns away from the left and right borders, the rows being already mirrored
+    if (useSSE2 && sizeof(T) == 1 && x >= 2 && x + 10 <= w) {
+      const unsigned char *const p[5] = {
+          reinterpret_cast<const unsigned char *>(rows[0]), reinterpret_cast<const unsigned char *>(rows[1]),
+          reinterpret_cast<const unsigned char *>(rows[2]), reinterpret_cast<const unsigned char *>(rows[3]),
+          reinterpret_cast<const unsigned char *>(rows[4])};
+      for (; x + 10 <= w; x += 8) {
+        demosaicBayer8SSE2(p, static_cast<unsigned int>(x), malvar, layout, rgba, grey);
+      }
+      continue;
+    }
+    if (useSSE2 && sizeof(T) == 2 && x >= 2 && x + 6 <= w) {
+      const uint16_t *const p[5] = {
+          reinterpret_cast<const uint16_t *>(rows[0]), reinterpret_cast<const uint16_t *>(rows[1]),
+          reinterpret_cast<const uint16_t *>(rows[2]), reinterpret_cast<const uint16_t *>(rows[3]),
+          reinterpret_cast<const uint16_t *>(rows[4])};
+      for (; x + 6 <= w; x += 4) {
+        demosaicBayer16SSE2(p, static_cast<unsigned int>(x), malvar, shift, layout, rgba, grey);
+      }
+      continue;
+    }
+#else
+    (void)useSSE2;
+#endif
+
+    int cols[5];
+    if (x >= 2 && x + 2 < w) {
+      for (int k = 0; k < 5; k++) {
+        cols[k] = x + k - 2;
+      }
+    } else {
+      for (int k = 0; k < 5; k++) {
+        cols[k] = reflectBayerIndex(x + k - 2, w);
+      }
+    }
+
+    const int *src = layout.src[x % 2];
+    int rgb[3];
+    for (int k = 0; k < 3; k++) {
+      rgb[k] = computeBayerSource(src[k], rows, cols, malvar, maxValue) >> shift;
+      // Samples above the announced bit depth
+      rgb[k] = rgb[k] > 255 ? 255 : rgb[k];
+    }
+
+    if (rgba != NULL) {
+      unsigned char *dst = rgba + 4 * x;
+      dst[0] = static_cast<unsigned char>(rgb[0]);
+      dst[1] = static_cast<unsigned char>(rgb[1]);
+      dst[2] = static_cast<unsigned char>(rgb[2]);
+      dst[3] = vpRGBa::alpha_default;
+    } else {
+      grey[x] = bayerRGBToGrey(rgb[0], rgb[1], rgb[2]);
+    }
+    x++;
+  }
+}
+
+template <typename T>
+void demosaicBayerRows(const T *bayer, unsigned int width, unsigned int height, unsigned int rowStart,
+                       unsigned int rowEnd, vpImageConvert::vpBayerPattern pattern,
+                       vpImageConvert::vpDemosaicMethod method, unsigned int shift, bool useSSE2, unsigned char *rgba,
+                       unsigned char *grey)
+{
+  for (unsigned int y = rowStart; y < rowEnd; y++) {
+    demosaicBayerRow(bayer, width, height, y, pattern, method, shift, useSSE2, rgba ? rgba + 4 * y * width : NULL,
+                     grey ? grey + y * width : NULL);
+  }
+}
+
+// Demosaic the whole mosaic, split in bands of rows processed by the threads of the global pool
+template <typename T>
+void demosaicBayer(const T *bayer, unsigned int width, unsigned int height, vpImageConvert::vpBayerPattern pattern,
+                   vpImageConvert::vpDemosaicMethod method, unsigned int shift, unsigned int nbThreads,
+                   unsigned char *rgba, unsigned char *grey)
+{
+  bool useSSE2 = false;
+#if VISP_HAVE_SSE2
+  useSSE2 = vpCPUFeatures::checkSSE2();
+#endif
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(height), [=](int start, int end) {
+    demosaicBayerRows(bayer, width, height, static_cast<unsigned int>(start), static_cast<unsigned int>(end), pattern,
+                      method, shift, useSSE2, rgba, grey);
+  }, nbThreads);
+#else
+  (void)nbThreads;
+  demosaicBayerRows(bayer, width, height, 0, height, pattern, method, shift, useSSE2, rgba, grey);
+#endif
+}
+
+// Same rounding as YUV420ToRGBa(): chroma offsets multiplied by 0.354 and
+// 0.707 and truncated towards zero
+inline void nvPixelToRGB(int y, int u, int v, unsigned char *dst)
+{
+  const int U = ((u - 128) * 354) / 1000;
+  const int V = ((v - 128) * 707) / 1000;
+
+  int R = y + 2 * V;
+  int G = y - U - V;
+  int B = y + 5 * U;
+  dst[0] = static_cast<unsigned char>(R < 0 ? 0 : (R > 255 ? 255 : R));
+  dst[1] = static_cast<unsigned char>(G < 0 ? 0 : (G > 255 ? 255 : G));
+  dst[2] = static_cast<unsigned char>(B < 0 ? 0 : (B > 255 ? 255 : B));
+}
+
+#if VISP_HAVE_SSE2
+// Multiply signed 16-bit chroma offsets in [-128, 127] by k / 65536, truncating towards zero
+inline __m128i nvScaleChroma(const __m128i &d, short k)
+{
+  const __m128i sign = _mm_srai_epi16(d, 15);
+  const __m128i absD = _mm_sub_epi16(_mm_xor_si128(d, sign), sign);
+  const __m128i scaled = _mm_mulhi_epu16(absD, _mm_set1_epi16(k));
+  return _mm_sub_epi16(_mm_xor_si128(scaled, sign), sign);
+}
+
+// Convert 16 pixels of a NV12 or NV21 row to RGBa
+inline void nvToRGBa16SSE2(const unsigned char *luma, const unsigned char *chroma, bool nv21, unsigned char *rgba)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i offset = _mm_set1_epi16(128);
+  const __m128i lowMask = _mm_set1_epi16(0xFF);
+
+  const __m128i uv = _mm_loadu_si128(reinterpret_cast<const __m128i *>(chroma));
+  const __m128i first = _mm_sub_epi16(_mm_and_si128(uv, lowMask), offset);
+  const __m128i second = _mm_sub_epi16(_mm_srli_epi16(uv, 8), offset);
+
+  // 23199 / 65536 and 46328 / 65536 truncate like 0.354 and 0.707 for all offsets
+  const __m128i U = nvScaleChroma(nv21 ? second : first, 23199);
+  const __m128i V = nvScaleChroma(nv21 ? first : second, static_cast<short>(46328));
+
+  const __m128i V2 = _mm_slli_epi16(V, 1);
+  const __m128i UV = _mm_sub_epi16(zero, _mm_add_epi16(U, V));
+  const __m128i U5 = _mm_add_epi16(_mm_slli_epi16(U, 2), U);
+
+  const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(luma));
+  const __m128i yLo = _mm_unpacklo_epi8(y, zero);
+  const __m128i yHi = _mm_unpackhi_epi8(y, zero);
+
+  // Each chroma sample is shared by two consecutive pixels
+  const __m128i r = _mm_packus_epi16(_mm_add_epi16(yLo, _mm_unpacklo_epi16(V2, V2)),
+                                     _mm_add_epi16(yHi, _mm_unpackhi_epi16(V2, V2)));
+  const __m128i g = _mm_packus_epi16(_mm_add_epi16(yLo, _mm_unpacklo_epi16(UV, UV)),
+                                     _mm_add_epi16(yHi, _mm_unpackhi_epi16(UV, UV)));
+  const __m128i b = _mm_packus_epi16(_mm_add_epi16(yLo, _mm_unpacklo_epi16(U5, U5)),
+                                     _mm_add_epi16(yHi, _mm_unpackhi_epi16(U5, U5)));
+  const __m128i a = _mm_set1_epi8(static_cast<char>(vpRGBa::alpha_default));
+
+  const __m128i rgLo = _mm_unpacklo_epi8(r, g), rgHi = _mm_unpackhi_epi8(r, g);
+  const __m128i baLo = _mm_unpacklo_epi8(b, a), baHi = _mm_unpackhi_epi8(b, a);
+  __m128i *dst = reinterpret_cast<__m128i *>(rgba);
+  _mm_storeu_si128(dst, _mm_unpacklo_epi16(rgLo, baLo));
+  _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(rgLo, baLo));
+  _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(rgHi, baHi));
+  _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(rgHi, baHi));
+}
+#endif
+
+void nvToRGBRows(const unsigned char *nv, unsigned int width, unsigned int height, unsigned int rowStart,
+                 unsigned int rowEnd, bool nv21, unsigned int nbChannels, bool useSSE2, unsigned char *dst)
+{
+  // Interleaved chroma plane, one pair of samples for each 2x2 block of pixels
+  const unsigned char *chromaPlane = nv + width * height;
+  const unsigned int chromaStride = 2 * ((width + 1) / 2);
+  const unsigned int uIndex = nv21 ? 1 : 0;
+
+  for (unsigned int i = rowStart; i < rowEnd; i++) {
+    const unsigned char *luma = nv + i * width;
+    const unsigned char *chroma = chromaPlane + (i / 2) * chromaStride;
+    unsigned char *out = dst + i * width * nbChannels;
+
+    unsigned int j = 0;
+#if VISP_HAVE_SSE2
+    if (useSSE2 && nbChannels == 4) {
+      for (; j + 16 <= width; j += 16) {
+        nvToRGBa16SSE2(luma + j, chroma + j, nv21, out + 4 * j);
+      }
+    }
+#else
+    (void)useSSE2;
+#endif
+    for (; j < width; j++) {
+      const unsigned char *c = chroma + (j & ~1u);
+      nvPixelToRGB(luma[j], c[uIndex], c[1 - uIndex], out + nbChannels * j);
+      if (nbChannels == 4) {
+        out[4 * j + 3] = vpRGBa::alpha_default;
+      }
+    }
+  }
+}
+
+void nvToRGB(const unsigned char *nv, unsigned int width, unsigned int height, bool nv21, unsigned int nbChannels,
+             unsigned int nbThreads, unsigned char *dst)
+{
+  bool useSSE2 = false;
+#if VISP_HAVE_SSE2
+  useSSE2 = vpCPUFeatures::checkSSE2();
+#endif
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(height), [=](int start, int end) {
+    nvToRGBRows(nv, width, height, static_cast<unsigned int>(start), static_cast<unsigned int>(end), nv21, nbChannels,
+                useSSE2, dst);
+  }, nbThreads);
+#else
+  (void)nbThreads;
+  nvToRGBRows(nv, width, height, 0, height, nv21, nbChannels, useSSE2, dst);
+#endif
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
@@ -64,6 +64,8 @@
 #endif
 #endif
 
+#include "private/vpBayerConversion.h"
+
 bool vpImageConvert::YCbCrLUTcomputed = false;
 int vpImageConvert::vpCrr[256];
 int vpImageConvert::vpCgb[256];
@@ -95,6 +97,44 @@ void vpImageConvert::convert(const vpImage<vpRGBa> &src, vpImage<unsigned char>
   RGBaToGrey((unsigned char *)src.bitmap, dest.bitmap, src.getHeight() * src.getWidth());
 }
 
+/*!
+  Convert a region of interest or a padded image to a vpImage\<vpRGBa\>.
+  Tha alpha component is set to vpRGBa::alpha_default.
+  \param src : source view
+  \param dest : destination image, with the size of the view
+*/
+void vpImageConvert::convert(const vpImageView<const unsigned char> &src, vpImage<vpRGBa> &dest)
+{
+  dest.resize(src.getHeight(), src.getWidth());
+
+  if (src.isContiguous()) {
+    GreyToRGBa(const_cast<unsigned char *>(src.getData()), (unsigned char *)dest.bitmap, src.getSize());
+    return;
+  }
+  for (unsigned int i = 0; i < src.getHeight(); i++) {
+    GreyToRGBa(const_cast<unsigned char *>(src[i]), (unsigned char *)dest[i], src.getWidth());
+  }
+}
+
+/*!
+  Convert a region of interest or a padded color image to a
+  vpImage\<unsigned char\>.
+  \param src : source view
+  \param dest : destination image, with the size of the view
+*/
+void vpImageConvert::convert(const vpImageView<const vpRGBa> &src, vpImage<unsigned char> &dest)
+{
+  dest.resize(src.getHeight(), src.getWidth());
+
+  if (src.isContiguous()) {
+    RGBaToGrey((unsigned char *)src.getData(), dest.bitmap, src.getSize());
+    return;
+  }
+  for (unsigned int i = 0; i < src.getHeight(); i++) {
+    RGBaToGrey((unsigned char *)src[i], dest[i], src.getWidth());
+  }
+}
+
 /*!
   Convert a vpImage\<float\> to a vpImage\<unsigend char\> by renormalizing
   between 0 and 255. \param src : source image \param dest : destination image
@@ -3379,6 +3419,91 @@ void vpImageConvert::YVU9ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned
   }
 }
 
+/*!
+  Convert an image from NV12 (the Y plane followed by a plane of interleaved
+  U and V samples, both subsampled by 2 in each direction) to RGB32, as
+  delivered by many hardware video decoders and mobile cameras.
+  Destination rgba memory area has to be allocated before.
+
+  The conversion equations are the ones of YUV420ToRGBa() and the alpha
+  component of the converted image is set to vpRGBa::alpha_default.
+
+  \param nv12 : Pointer to the NV12 image.
+  \param rgba : Pointer to the 32-bit RGBA image of \e width x \e height pixels.
+  \param width : Image width.
+  \param height : Image height.
+  \param nbThreads : Maximum number of threads converting bands of rows. If 0,
+  all the threads of the pool returned by vpThreadPool::getGlobalInstance()
+  are used. Requires c++11, otherwise a single thread is used.
+
+  \sa NV21ToRGBa(), YUV420ToRGBa()
+*/
+void vpImageConvert::NV12ToRGBa(const unsigned char *nv12, unsigned char *rgba, unsigned int width,
+                                unsigned int height, unsigned int nbThreads)
+{
+  nvToRGB(nv12, width, height, false, 4, nbThreads, rgba);
+}
+
+/*!
+  Convert an image from NV12 to RGB24.
+  Destination rgb memory area has to be allocated before.
+
+  \param nv12 : Pointer to the NV12 image.
+  \param rgb : Pointer to the 24-bit RGB image of \e width x \e height pixels.
+  \param width : Image width.
+  \param height : Image height.
+  \param nbThreads : Maximum number of threads converting bands of rows, 0 for
+  all the threads of the pool.
+
+  \sa NV12ToRGBa()
+*/
+void vpImageConvert::NV12ToRGB(const unsigned char *nv12, unsigned char *rgb, unsigned int width, unsigned int height,
+                               unsigned int nbThreads)
+{
+  nvToRGB(nv12, width, height, false, 3, nbThreads, rgb);
+}
+
+/*!
+  Convert an image from NV21 to RGB32. NV21 only differs from NV12 by the
+  order of the chroma samples: V comes before U.
+  Destination rgba memory area has to be allocated before.
+
+  The alpha component of the converted image is set to vpRGBa::alpha_default.
+
+  \param nv21 : Pointer to the NV21 image.
+  \param rgba : Pointer to the 32-bit RGBA image of \e width x \e height pixels.
+  \param width : Image width.
+  \param height : Image height.
+  \param nbThreads : Maximum number of threads converting bands of rows, 0 for
+  all the threads of the pool.
+
+  \sa NV12ToRGBa()
+*/
+void vpImageConvert::NV21ToRGBa(const unsigned char *nv21, unsigned char *rgba, unsigned int width,
+                                unsigned int height, unsigned int nbThreads)
+{
+  nvToRGB(nv21, width, height, true, 4, nbThreads, rgba);
+}
+
+/*!
+  Convert an image from NV21 to RGB24.
+  Destination rgb memory area has to be allocated before.
+
+  \param nv21 : Pointer to the NV21 image.
+  \param rgb : Pointer to the 24-bit RGB image of \e width x \e height pixels.
+  \param width : Image width.
+  \param height : Image height.
+  \param nbThreads : Maximum number of threads converting bands of rows, 0 for
+  all the threads of the pool.
+
+  \sa NV21ToRGBa()
+*/
+void vpImageConvert::NV21ToRGB(const unsigned char *nv21, unsigned char *rgb, unsigned int width, unsigned int height,
+                               unsigned int nbThreads)
+{
+  nvToRGB(nv21, width, height, true, 3, nbThreads, rgb);
+}
+
 /*!
 
   Convert RGB into RGBa.
@@ -4803,3 +4928,112 @@ void vpImageConvert::RGBToHSV(const unsigned char *rgb, unsigned char *hue, unsi
     value[i] = (unsigned char)(255.0 * v);
   }
 }
+
+/*!
+  Demosaic a raw 8-bit Bayer image, as delivered by most industrial cameras,
+  into a color image.
+
+  The pixels are split in bands of rows processed by the threads of the pool
+  returned by vpThreadPool::getGlobalInstance(), and vectorized with SSE2
+  when available. Missing samples at the image borders are mirrored.
+
+  \param bayer : Pointer to the \e width x \e height raw image.
+  \param dest : Color image, resized to \e width x \e height. The alpha
+  component is set to vpRGBa::alpha_default.
+  \param width : Image width.
+  \param height : Image height.
+  \param pattern : Arrangement of the color filter array.
+  \param method : Interpolation method. DEMOSAIC_MALVAR reduces the color
+  fringes along edges at a slightly higher cost than DEMOSAIC_BILINEAR.
+  \param nbThreads : Maximum number of threads. If 0, all the threads of the
+  pool are used. Requires c++11, otherwise a single thread is used.
+*/
+void vpImageConvert::demosaic(const unsigned char *bayer, vpImage<vpRGBa> &dest, unsigned int width,
+                              unsigned int height, vpBayerPattern pattern, vpDemosaicMethod method,
+                              unsigned int nbThreads)
+{
+  dest.resize(height, width);
+  demosaicBayer(bayer, width, height, pattern, method, 0, nbThreads, reinterpret_cast<unsigned char *>(dest.bitmap),
+                NULL);
+}
+
+/*!
+  Demosaic a raw 8-bit Bayer image into a grayscale image, without going
+  through an intermediate color image. The luminance is computed with the
+  weights of RGBaToGrey().
+
+  \param bayer : Pointer to the \e width x \e height raw image.
+  \param dest : Grayscale image, resized to \e width x \e height.
+  \param width : Image width.
+  \param height : Image height.
+  \param pattern : Arrangement of the color filter array.
+  \param method : Interpolation method.
+  \param nbThreads : Maximum number of threads. If 0, all the threads of the
+  pool are used.
+*/
+void vpImageConvert::demosaic(const unsigned char *bayer, vpImage<unsigned char> &dest, unsigned int width,
+                              unsigned int height, vpBayerPattern pattern, vpDemosaicMethod method,
+                              unsigned int nbThreads)
+{
+  dest.resize(height, width);
+  demosaicBayer(bayer, width, height, pattern, method, 0, nbThreads, NULL, dest.bitmap);
+}
+
+/*!
+  Demosaic a raw Bayer image with more than 8 bits per sample into a color
+  image. The interpolation is done at the full bit depth and the result is
+  scaled down to 8 bits.
+
+  \param bayer : Pointer to the \e width x \e height raw image.
+  \param dest : Color image, resized to \e width x \e height.
+  \param width : Image width.
+  \param height : Image height.
+  \param pattern : Arrangement of the color filter array.
+  \param method : Interpolation method.
+  \param bitDepth : Number of significant bits of the samples, between 8 and
+  16, for example 10 or 12 for most machine vision sensors.
+  \param nbThreads : Maximum number of threads. If 0, all the threads of the
+  pool are used.
+
+  \exception vpException::badValue : If \e bitDepth is out of range.
+*/
+void vpImageConvert::demosaic(const uint16_t *bayer, vpImage<vpRGBa> &dest, unsigned int width, unsigned int height,
+                              vpBayerPattern pattern, vpDemosaicMethod method, unsigned int bitDepth,
+                              unsigned int nbThreads)
+{
+  if (bitDepth < 8 || bitDepth > 16) {
+    throw vpException(vpException::badValue, "Bit depth %u of the Bayer image is not in [8, 16]", bitDepth);
+  }
+
+  dest.resize(height, width);
+  demosaicBayer(bayer, width, height, pattern, method, bitDepth - 8, nbThreads,
+                reinterpret_cast<unsigned char *>(dest.bitmap), NULL);
+}
+
+/*!
+  Demosaic a raw Bayer image with more than 8 bits per sample into a
+  grayscale image.
+
+  \param bayer : Pointer to the \e width x \e height raw image.
+  \param dest : Grayscale image, resized to \e width x \e height.
+  \param width : Image width.
+  \param height : Image height.
+  \param pattern : Arrangement of the color filter array.
+  \param method : Interpolation method.
+  \param bitDepth : Number of significant bits of the samples, between 8 and 16.
+  \param nbThreads : Maximum number of threads. If 0, all the threads of the
+  pool are used.
+
+  \exception vpException::badValue : If \e bitDepth is out of range.
+*/
+void vpImageConvert::demosaic(const uint16_t *bayer, vpImage<unsigned char> &dest, unsigned int width,
+                              unsigned int height, vpBayerPattern pattern, vpDemosaicMethod method,
+                              unsigned int bitDepth, unsigned int nbThreads)
+{
+  if (bitDepth < 8 || bitDepth > 16) {
+    throw vpException(vpException::badValue, "Bit depth %u of the Bayer image is not in [8, 16]", bitDepth);
+  }
+
+  dest.resize(height, width);
+  demosaicBayer(bayer, width, height, pattern, method, bitDepth - 8, nbThreads, NULL, dest.bitmap);
+}
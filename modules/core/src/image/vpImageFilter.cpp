@@ -36,9 +36,36 @@
  *
  *****************************************************************************/
 
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageTools.h>
 #include <visp3/core/vpRGBa.h>
+#include <visp3/core/vpThreadPool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+// The AVX2 code is compiled for the functions that need it only, and selected
+// at runtime with vpCPUFeatures::checkAVX2()
+#if defined __AVX2__ || (defined _MSC_VER && _MSC_VER >= 1700 && (defined _M_X64 || defined _M_IX86))
+#include <immintrin.h>
+#define VISP_HAVE_AVX2 1
+#define VISP_AVX2_TARGET
+#elif (defined __GNUC__ && __GNUC__ >= 5 || defined __clang__) && (defined __x86_64__ || defined __i386__)
+#include <immintrin.h>
+#define VISP_HAVE_AVX2 1
+#define VISP_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#if defined __ARM_NEON && defined __aarch64__
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#endif
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
 #include <opencv2/imgproc/imgproc.hpp>
 #elif defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020101)
@@ -254,7 +281,271 @@ void vpImageFilter::sepFilter(const vpImage<unsigned char> &I, vpImage<double> &
   }
 }
 
-#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Index of a pixel outside the image mirrored without repeating the border
+// pixel (gfedcb|abcdefgh|gfedcba), as the OpenCV default border
+int reflectBorder(int x, int size)
+{
+  if (size == 1) {
+    return 0;
+  }
+
+  while (x < 0 || x >= size) {
+    x = x < 0 ? -x : 2 * size - 2 - x;
+  }
+  return x;
+}
+
+// Gaussian kernel with 8 fractional bits, whose coefficients sum to 256
+void getCannyGaussianKernel(unsigned int size, std::vector<unsigned short> &kernel)
+{
+  // Same kernels as cv::getGaussianKernel() with sigma computed from the size
+  static const unsigned short kernel3[] = {64, 128, 64};
+  static const unsigned short kernel5[] = {16, 64, 96, 64, 16};
+  static const unsigned short kernel7[] = {8, 28, 56, 72, 56, 28, 8};
+
+  kernel.resize(size);
+  if (size == 1) {
+    kernel[0] = 256;
+  } else if (size == 3) {
+    kernel.assign(kernel3, kernel3 + 3);
+  } else if (size == 5) {
+    kernel.assign(kernel5, kernel5 + 5);
+  } else if (size == 7) {
+    kernel.assign(kernel7, kernel7 + 7);
+  } else {
+    const double sigma = 0.3 * ((size - 1) * 0.5 - 1) + 0.8;
+    const int half_size = static_cast<int>(size / 2);
+    std::vector<double> kernel_d(size);
+    double sum = 0.0;
+    for (int i = -half_size; i <= half_size; i++) {
+      kernel_d[static_cast<size_t>(i + half_size)] = exp(-(i * i) / (2.0 * sigma * sigma));
+      sum += kernel_d[static_cast<size_t>(i + half_size)];
+    }
+
+    int sum_fixed = 0;
+    for (unsigned int i = 0; i < size; i++) {
+      kernel[i] = static_cast<unsigned short>(vpMath::round(256.0 * kernel_d[i] / sum));
+      sum_fixed += kernel[i];
+    }
+    // The rounding error is put on the central coefficient
+    kernel[static_cast<size_t>(half_size)] = static_cast<unsigned short>(kernel[static_cast<size_t>(half_size)] + 256 - sum_fixed);
+  }
+}
+
+// Separable Gaussian filter in fixed point: the horizontal pass keeps 8
+// fractional bits in 16-bit integers, the vertical one rounds the 16
+// fractional bits of the 32-bit sums
+void gaussianBlurFixedPoint(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI, unsigned int size,
+                            bool useSSE2)
+{
+  const int width = static_cast<int>(I.getWidth()), height = static_cast<int>(I.getHeight());
+  const int half_size = static_cast<int>(size / 2);
+  std::vector<unsigned short> kernel;
+  getCannyGaussianKernel(size, kernel);
+  GI.resize(I.getHeight(), I.getWidth(), false);
+
+  // The rows needed by the vertical pass of row i are rows i-half_size to
+  // i+half_size, even near the border, so that the horizontally filtered
+  // rows are kept in a ring buffer of size rows
+  std::vector<unsigned char> row(static_cast<size_t>(width + 2 * half_size));
+  std::vector<unsigned short> ring(static_cast<size_t>(width) * size);
+  std::vector<const unsigned short *> rows(size);
+  int next_row = 0;
+  for (int i = 0; i < height; i++) {
+    for (; next_row <= (std::min)(i + half_size, height - 1); next_row++) {
+      const unsigned char *src = I[next_row];
+      memcpy(&row[static_cast<size_t>(half_size)], src, static_cast<size_t>(width));
+      for (int j = 1; j <= half_size; j++) {
+        row[static_cast<size_t>(half_size - j)] = src[reflectBorder(-j, width)];
+        row[static_cast<size_t>(half_size + width - 1 + j)] = src[reflectBorder(width - 1 + j, width)];
+      }
+
+      unsigned short *dst = &ring[static_cast<size_t>((next_row % static_cast<int>(size)) * width)];
+      int j = 0;
+#if VISP_HAVE_SSE2
+      if (useSSE2) {
+        const __m128i zero = _mm_setzero_si128();
+        for (; j <= width - 8; j += 8) {
+          __m128i sum = zero;
+          for (unsigned int k = 0; k < size; k++) {
+            const __m128i v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&row[j + k]), zero);
+            sum = _mm_add_epi16(sum, _mm_mullo_epi16(v, _mm_set1_epi16(static_cast<short>(kernel[k]))));
+          }
+          _mm_storeu_si128((__m128i *)&dst[j], sum);
+        }
+      }
+#endif
+      for (; j < width; j++) {
+        unsigned int sum = 0;
+        for (unsigned int k = 0; k < size; k++) {
+          sum += kernel[k] * row[static_cast<size_t>(j) + k];
+        }
+        dst[j] = static_cast<unsigned short>(sum);
+      }
+    }
+
+    for (unsigned int k = 0; k < size; k++) {
+      const int r = reflectBorder(i - half_size + static_cast<int>(k), height);
+      rows[k] = &ring[static_cast<size_t>((r % static_cast<int>(size)) * width)];
+    }
+
+    unsigned char *dst = GI[i];
+    int j = 0;
+#if VISP_HAVE_SSE2
+    if (useSSE2) {
+      const __m128i zero = _mm_setzero_si128();
+      const __m128i delta = _mm_set1_epi32(1 << 15);
+      for (; j <= width - 8; j += 8) {
+        __m128i sum_lo = delta, sum_hi = delta;
+        for (unsigned int k = 0; k < size; k++) {
+          const __m128i v = _mm_loadu_si128((const __m128i *)&rows[k][j]);
+          const __m128i coeff = _mm_set1_epi16(static_cast<short>(kernel[k]));
+          // 32-bit products of the unsigned 16-bit values
+          const __m128i prod_lo = _mm_mullo_epi16(v, coeff);
+          const __m128i prod_hi = _mm_mulhi_epu16(v, coeff);
+          sum_lo = _mm_add_epi32(sum_lo, _mm_unpacklo_epi16(prod_lo, prod_hi));
+          sum_hi = _mm_add_epi32(sum_hi, _mm_unpackhi_epi16(prod_lo, prod_hi));
+        }
+        const __m128i res = _mm_packs_epi32(_mm_srli_epi32(sum_lo, 16), _mm_srli_epi32(sum_hi, 16));
+        _mm_storel_epi64((__m128i *)&dst[j], _mm_packus_epi16(res, zero));
+      }
+    }
+#else
+    (void)useSSE2;
+#endif
+    for (; j < width; j++) {
+      unsigned int sum = 1 << 15;
+      for (unsigned int k = 0; k < size; k++) {
+        sum += kernel[k] * static_cast<unsigned int>(rows[k][j]);
+      }
+      dst[j] = static_cast<unsigned char>(sum >> 16);
+    }
+  }
+}
+
+// Sobel derivatives and L1 gradient magnitude computed row by row. The
+// border is replicated and the derivatives are saturated to 16-bit integers
+// as with cv::Sobel().
+class vpSobelRows
+{
+public:
+  vpSobelRows(const vpImage<unsigned char> &I, unsigned int apertureSobel)
+    : m_I(I), m_aperture(static_cast<int>(apertureSobel)), m_half_size(static_cast<int>(apertureSobel / 2)),
+      m_width(static_cast<int>(I.getWidth())), m_height(static_cast<int>(I.getHeight())),
+      m_padded_width(m_width + 2 * m_half_size), m_next_row(-m_half_size), m_padded(), m_col_smooth(), m_col_deriv()
+  {
+    static const int smooth3[] = {1, 2, 1}, deriv3[] = {-1, 0, 1};
+    static const int smooth5[] = {1, 4, 6, 4, 1}, deriv5[] = {-1, -2, 0, 2, 1};
+    static const int smooth7[] = {1, 6, 15, 20, 15, 6, 1}, deriv7[] = {-1, -4, -5, 0, 5, 4, 1};
+    m_smooth = apertureSobel == 3 ? smooth3 : (apertureSobel == 5 ? smooth5 : smooth7);
+    m_deriv = apertureSobel == 3 ? deriv3 : (apertureSobel == 5 ? deriv5 : deriv7);
+
+    m_padded.resize(static_cast<size_t>(m_padded_width * m_aperture));
+    m_col_smooth.resize(static_cast<size_t>(m_padded_width));
+    m_col_deriv.resize(static_cast<size_t>(m_padded_width));
+  }
+
+  // Compute row i, rows being computed in increasing order
+  void compute(int i, int *dx, int *dy, int *mag, bool useSSE2)
+  {
+    // Ring buffer of the padded rows i-half_size to i+half_size
+    for (; m_next_row <= i + m_half_size; m_next_row++) {
+      const unsigned char *src = m_I[(std::min)((std::max)(m_next_row, 0), m_height - 1)];
+      unsigned char *dst = getPaddedRow(m_next_row);
+      memcpy(dst + m_half_size, src, static_cast<size_t>(m_width));
+      for (int j = 0; j < m_half_size; j++) {
+        dst[j] = src[0];
+        dst[m_half_size + m_width + j] = src[m_width - 1];
+      }
+    }
+
+    int j = 0;
+#if VISP_HAVE_SSE2
+    if (useSSE2 && m_aperture == 3) {
+      const __m128i zero = _mm_setzero_si128();
+      const unsigned char *r0 = getPaddedRow(i - 1);
+      const unsigned char *r1 = getPaddedRow(i);
+      const unsigned char *r2 = getPaddedRow(i + 1);
+      for (; j <= m_width - 8; j += 8) {
+        const __m128i p00 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&r0[j]), zero);
+        const __m128i p01 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&r0[j + 1]), zero);
+        const __m128i p02 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&r0[j + 2]), zero);
+        const __m128i p10 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&r1[j]), zero);
+        const __m128i p12 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&r1[j + 2]), zero);
+        const __m128i p20 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&r2[j]), zero);
+        const __m128i p21 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&r2[j + 1]), zero);
+        const __m128i p22 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&r2[j + 2]), zero);
+
+        // |dx| <= 1020 and |dy| <= 1020 fit in 16-bit integers
+        const __m128i d1 = _mm_sub_epi16(p12, p10);
+        const __m128i gx = _mm_add_epi16(_mm_add_epi16(_mm_sub_epi16(p02, p00), _mm_sub_epi16(p22, p20)),
+                                         _mm_add_epi16(d1, d1));
+        const __m128i d2 = _mm_sub_epi16(p21, p01);
+        const __m128i gy = _mm_add_epi16(_mm_add_epi16(_mm_sub_epi16(p20, p00), _mm_sub_epi16(p22, p02)),
+                                         _mm_add_epi16(d2, d2));
+        const __m128i m = _mm_add_epi16(_mm_max_epi16(gx, _mm_sub_epi16(zero, gx)),
+                                        _mm_max_epi16(gy, _mm_sub_epi16(zero, gy)));
+
+        // Sign extension to 32-bit integers
+        _mm_storeu_si128((__m128i *)&dx[j], _mm_srai_epi32(_mm_unpacklo_epi16(gx, gx), 16));
+        _mm_storeu_si128((__m128i *)&dx[j + 4], _mm_srai_epi32(_mm_unpackhi_epi16(gx, gx), 16));
+        _mm_storeu_si128((__m128i *)&dy[j], _mm_srai_epi32(_mm_unpacklo_epi16(gy, gy), 16));
+        _mm_storeu_si128((__m128i *)&dy[j + 4], _mm_srai_epi32(_mm_unpackhi_epi16(gy, gy), 16));
+        _mm_storeu_si128((__m128i *)&mag[j], _mm_unpacklo_epi16(m, zero));
+        _mm_storeu_si128((__m128i *)&mag[j + 4], _mm_unpackhi_epi16(m, zero));
+      }
+    }
+#else
+    (void)useSSE2;
+#endif
+
+    if (j < m_width) {
+      for (int c = j; c < m_width + 2 * m_half_size; c++) {
+        int sum_smooth = 0, sum_deriv = 0;
+        for (int k = 0; k < m_aperture; k++) {
+          const int v = getPaddedRow(i - m_half_size + k)[c];
+          sum_smooth += m_smooth[k] * v;
+          sum_deriv += m_deriv[k] * v;
+        }
+        m_col_smooth[static_cast<size_t>(c)] = sum_smooth;
+        m_col_deriv[static_cast<size_t>(c)] = sum_deriv;
+      }
+
+      for (; j < m_width; j++) {
+        int gx = 0, gy = 0;
+        for (int k = 0; k < m_aperture; k++) {
+          gx += m_deriv[k] * m_col_smooth[static_cast<size_t>(j + k)];
+          gy += m_smooth[k] * m_col_deriv[static_cast<size_t>(j + k)];
+        }
+        gx = (std::min)((std::max)(gx, -32768), 32767);
+        gy = (std::min)((std::max)(gy, -32768), 32767);
+        dx[j] = gx;
+        dy[j] = gy;
+        mag[j] = std::abs(gx) + std::abs(gy);
+      }
+    }
+  }
+
+private:
+  unsigned char *getPaddedRow(int i)
+  {
+    return &m_padded[static_cast<size_t>(((i + m_half_size) % m_aperture) * m_padded_width)];
+  }
+
+  const vpImage<unsigned char> &m_I;
+  const int m_aperture, m_half_size, m_width, m_height, m_padded_width;
+  int m_next_row;
+  const int *m_smooth;
+  const int *m_deriv;
+  std::vector<unsigned char> m_padded;
+  std::vector<int> m_col_smooth, m_col_deriv;
+};
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
   Apply the Canny edge operator on the image \e Isrc and return the resulting
   image \e Ires.
@@ -262,13 +553,11 @@ void vpImageFilter::sepFilter(const vpImage<unsigned char> &I, vpImage<double> &
   The following example shows how to use the method:
 
   \code
-#include <visp3/core/vpConfig.h>
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageFilter.h>
 
 int main()
 {
-#if VISP_HAVE_OPENCV_VERSION >= 0x020100 // Canny uses OpenCV >=2.1.0
   // Constants for the Canny operator.
   const unsigned int gaussianFilterSize = 5;
   const double thresholdCanny = 15;
@@ -282,8 +571,7 @@ int main()
 
   //Apply the Canny edge operator and set the Icanny image.
   vpImageFilter::canny(Isrc, Icanny, gaussianFilterSize, thresholdCanny, apertureSobel);
-#endif
- return (0);
+  return (0);
 }
   \endcode
 
@@ -294,270 +582,1138 @@ int main()
   \param thresholdCanny : The threshold for the Canny operator. Only value
   greater than this value are marked as an edge).
   \param apertureSobel : Size of the mask for the Sobel operator (odd number).
+
+  \sa canny(const vpImage<unsigned char> &, vpImage<unsigned char> &, unsigned int, double, double, unsigned int)
+*/
+void vpImageFilter::canny(const vpImage<unsigned char> &Isrc, vpImage<unsigned char> &Ires,
+                          unsigned int gaussianFilterSize, double thresholdCanny, unsigned int apertureSobel)
+{
+  canny(Isrc, Ires, gaussianFilterSize, thresholdCanny, thresholdCanny, apertureSobel);
+}
+
+/*!
+  Apply the Canny edge operator on the image \e Isrc and return the resulting
+  image \e Ires.
+
+  The image is first smoothed by a Gaussian filter computed in fixed point.
+  The derivatives are then computed with a Sobel filter and the edges are the
+  local maxima of the L1 gradient magnitude \f$ |I_x| + |I_y| \f$ along the
+  gradient direction. A local maximum whose magnitude is greater than \e
+  upperThreshold is an edge, as well as the local maxima greater than \e
+  lowerThreshold that are connected to an edge (hysteresis thresholding).
+
+  The result is the same as the one of <tt>cv::GaussianBlur()</tt> followed by
+  <tt>cv::Canny()</tt> with the default parameters, but OpenCV is not required
+  and the image is not converted. The Gaussian filter and the Sobel filter
+  with an aperture of 3 use SSE2 instructions when available.
+
+  \param Isrc : Image to apply the Canny edge detector to.
+  \param Ires : Filtered image (255 means an edge, 0 otherwise). Can be the
+  same image as \e Isrc.
+  \param gaussianFilterSize : The size of the mask of the Gaussian filter to
+  apply (an odd number, 1 to disable the filtering).
+  \param lowerThreshold : Lower threshold of the hysteresis.
+  \param upperThreshold : Upper threshold of the hysteresis.
+  \param apertureSobel : Size of the mask for the Sobel operator (3, 5 or 7).
+
+  \exception vpException::badValue : If the size of the Gaussian filter is
+  even or if the aperture of the Sobel filter is not 3, 5 or 7.
 */
 void vpImageFilter::canny(const vpImage<unsigned char> &Isrc, vpImage<unsigned char> &Ires,
-                          unsigned int gaussianFilterSize, double thresholdCanny,
+                          unsigned int gaussianFilterSize, double lowerThreshold, double upperThreshold,
                           unsigned int apertureSobel)
 {
-#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
-  IplImage *img_ipl = NULL;
-  vpImageConvert::convert(Isrc, img_ipl);
-  IplImage *edges_ipl;
-  edges_ipl = cvCreateImage(cvSize(img_ipl->width, img_ipl->height), img_ipl->depth, img_ipl->nChannels);
+  if (gaussianFilterSize % 2 == 0) {
+    throw vpException(vpException::badValue, "Gaussian filter size must be odd: %d", gaussianFilterSize);
+  }
+  if (apertureSobel != 3 && apertureSobel != 5 && apertureSobel != 7) {
+    throw vpException(vpException::badValue, "Sobel aperture must be 3, 5 or 7: %d", apertureSobel);
+  }
 
-  cvSmooth(img_ipl, img_ipl, CV_GAUSSIAN, (int)gaussianFilterSize, (int)gaussianFilterSize, 0, 0);
-  cvCanny(img_ipl, edges_ipl, thresholdCanny, thresholdCanny, (int)apertureSobel);
+  const int width = static_cast<int>(Isrc.getWidth()), height = static_cast<int>(Isrc.getHeight());
+  if (Isrc.getSize() == 0) {
+    Ires.resize(0, 0);
+    return;
+  }
 
-  vpImageConvert::convert(edges_ipl, Ires);
-  cvReleaseImage(&img_ipl);
-  cvReleaseImage(&edges_ipl);
-#else
-  cv::Mat img_cvmat, edges_cvmat;
-  vpImageConvert::convert(Isrc, img_cvmat);
-  cv::GaussianBlur(img_cvmat, img_cvmat, cv::Size((int)gaussianFilterSize, (int)gaussianFilterSize), 0, 0);
-  cv::Canny(img_cvmat, edges_cvmat, thresholdCanny, thresholdCanny, (int)apertureSobel);
-  vpImageConvert::convert(edges_cvmat, Ires);
+  bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+  checkSSE2 = false;
 #endif
+
+  vpImage<unsigned char> GI;
+  gaussianBlurFixedPoint(Isrc, GI, gaussianFilterSize, checkSSE2);
+
+  if (lowerThreshold > upperThreshold) {
+    std::swap(lowerThreshold, upperThreshold);
+  }
+  const int low = static_cast<int>(std::floor(lowerThreshold));
+  const int high = static_cast<int>(std::floor(upperThreshold));
+
+  // Ring buffers of the derivatives and of the magnitude of 3 rows. The rows
+  // of magnitude have a border of one pixel set to 0, as the rows above and
+  // below the image.
+  const int mag_width = width + 2;
+  std::vector<int> dx(static_cast<size_t>(3 * width)), dy(static_cast<size_t>(3 * width));
+  std::vector<int> mag(static_cast<size_t>(3 * mag_width), 0);
+  std::vector<int> zeros(static_cast<size_t>(mag_width), 0);
+  vpSobelRows sobel(GI, apertureSobel);
+  sobel.compute(0, &dx[0], &dy[0], &mag[1], checkSSE2);
+
+  // Non-maximum suppression. The map has a border of one pixel and contains
+  // 0 for a weak edge, 1 for a non-edge and 2 for an edge
+  const int map_width = width + 2;
+  std::vector<unsigned char> map(static_cast<size_t>(map_width * (height + 2)), 1);
+  std::vector<int> stack;
+
+  // tan(22.5 deg) with 15 fractional bits. The products are computed on 64
+  // bits since the derivatives exceed 2^15 with the apertures 5 and 7
+  const int shift = 15;
+  const int64_t tg22 = static_cast<int64_t>(0.4142135623730950488016887242097 * (1 << shift) + 0.5);
+  for (int i = 0; i < height; i++) {
+    const size_t slot = static_cast<size_t>(i % 3), next_slot = static_cast<size_t>((i + 1) % 3);
+    if (i + 1 < height) {
+      sobel.compute(i + 1, &dx[next_slot * width], &dy[next_slot * width], &mag[next_slot * mag_width + 1],
+                    checkSSE2);
+    }
+
+    const int *mag_row = &mag[slot * mag_width + 1];
+    const int *mag_prev = i > 0 ? &mag[static_cast<size_t>((i + 2) % 3) * mag_width + 1] : &zeros[1];
+    const int *mag_next = i + 1 < height ? &mag[next_slot * mag_width + 1] : &zeros[1];
+    const int *dx_row = &dx[slot * width];
+    const int *dy_row = &dy[slot * width];
+    unsigned char *map_row = &map[static_cast<size_t>((i + 1) * map_width + 1)];
+
+    for (int j = 0; j < width; j++) {
+      const int m = mag_row[j];
+      if (m <= low) {
+        continue;
+      }
+
+      const int xs = dx_row[j], ys = dy_row[j];
+      const int64_t x = std::abs(xs), y = static_cast<int64_t>(std::abs(ys)) << shift;
+      const int64_t tg22x = x * tg22;
+      bool is_max = false;
+      if (y < tg22x) {
+        // Horizontal gradient
+        is_max = m > mag_row[j - 1] && m >= mag_row[j + 1];
+      } else {
+        const int64_t tg67x = tg22x + (x << (shift + 1));
+        if (y > tg67x) {
+          // Vertical gradient
+          is_max = m > mag_prev[j] && m >= mag_next[j];
+        } else {
+          // Diagonal gradient
+          const int s = (xs ^ ys) < 0 ? -1 : 1;
+          is_max = m > mag_prev[j - s] && m > mag_next[j + s];
+        }
+      }
+
+      if (is_max) {
+        if (m > high) {
+          map_row[j] = 2;
+          stack.push_back((i + 1) * map_width + j + 1);
+        } else {
+          map_row[j] = 0;
+        }
+      }
+    }
+  }
+
+  // Hysteresis: the weak edges connected to an edge become edges
+  const int offsets[8] = {-map_width - 1, -map_width, -map_width + 1, -1, 1, map_width - 1, map_width, map_width + 1};
+  while (!stack.empty()) {
+    const int index = stack.back();
+    stack.pop_back();
+
+    for (int k = 0; k < 8; k++) {
+      const int neighbor = index + offsets[k];
+      if (map[static_cast<size_t>(neighbor)] == 0) {
+        map[static_cast<size_t>(neighbor)] = 2;
+        stack.push_back(neighbor);
+      }
+    }
+  }
+
+  Ires.resize(Isrc.getHeight(), Isrc.getWidth(), false);
+  for (int i = 0; i < height; i++) {
+    const unsigned char *map_row = &map[static_cast<size_t>((i + 1) * map_width + 1)];
+    unsigned char *dst = Ires[i];
+    for (int j = 0; j < width; j++) {
+      dst[j] = map_row[j] == 2 ? 255 : 0;
+    }
+  }
 }
-#endif
 
-/*!
-  Apply a separable filter.
- */
-void vpImageFilter::filter(const vpImage<unsigned char> &I, vpImage<double> &GI, const double *filter,
-                           unsigned int size)
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
 {
-  vpImage<double> GIx;
-  filterX(I, GIx, filter, size);
-  filterY(GIx, GI, filter, size);
-  GIx.destroy();
+// Instruction set used by the separable filtering engine, selected once at
+// runtime among the ones the library has been compiled with
+enum vpFilterSimd { vpFilterScalar, vpFilterSSE2, vpFilterAVX2, vpFilterNEON };
+
+vpFilterSimd detectFilterSimd()
+{
+#if VISP_HAVE_AVX2
+  if (vpCPUFeatures::checkAVX2()) {
+    return vpFilterAVX2;
+  }
+#endif
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    return vpFilterSSE2;
+  }
+#endif
+#if VISP_HAVE_NEON
+  return vpFilterNEON;
+#else
+  return vpFilterScalar;
+#endif
 }
 
-/*!
-  Apply a separable filter.
- */
-void vpImageFilter::filter(const vpImage<double> &I, vpImage<double> &GI, const double *filter, unsigned int size)
+vpFilterSimd getFilterSimd()
 {
-  vpImage<double> GIx;
-  filterX(I, GIx, filter, size);
-  filterY(GIx, GI, filter, size);
-  GIx.destroy();
+  static const vpFilterSimd simd = detectFilterSimd();
+  return simd;
 }
 
-void vpImageFilter::filterX(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *filter,
-                            unsigned int size)
+// Taps of a symmetric kernel, or antisymmetric for a derivative, applied to
+// rows that are already shifted. For each column c:
+//   dst[c] = sum_i kernel[i] * (plus[i-1][c] +/- minus[i-1][c]) (+ kernel[0] * center[c])
+// The terms are summed in the same order as in the per-pixel filterX(),
+// filterY(), derivativeFilterX() and derivativeFilterY() functions, which
+// makes the vectorized results bit exact with them.
+template <typename T> struct vpFilterTaps {
+  vpFilterTaps() : center(NULL), plus(), minus(), kernel(NULL), half(0), derivative(false) {}
+
+  const T *center;
+  std::vector<const T *> plus;
+  std::vector<const T *> minus;
+  const T *kernel;
+  unsigned int half;
+  bool derivative;
+};
+
+template <typename T> void combineTapsScalar(const vpFilterTaps<T> &taps, T *dst, int begin, int end)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::filterXLeftBorder(I, i, j, filter, size);
-      // dIx[i][j]=0;
-    }
-    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::filterX(I, i, j, filter, size);
-    }
-    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
-      dIx[i][j] = vpImageFilter::filterXRightBorder(I, i, j, filter, size);
-      // dIx[i][j]=0;
+  for (int c = begin; c < end; c++) {
+    T result = 0;
+    if (taps.derivative) {
+      for (unsigned int i = 1; i <= taps.half; i++) {
+        result += taps.kernel[i] * (taps.plus[i - 1][c] - taps.minus[i - 1][c]);
+      }
+    } else {
+      for (unsigned int i = 1; i <= taps.half; i++) {
+        result += taps.kernel[i] * (taps.plus[i - 1][c] + taps.minus[i - 1][c]);
+      }
+      result = result + taps.kernel[0] * taps.center[c];
     }
+    dst[c] = result;
   }
 }
-void vpImageFilter::filterX(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter,
-                            unsigned int size)
+
+#if VISP_HAVE_SSE2
+int combineTapsSSE2(const vpFilterTaps<double> &taps, double *dst, int begin, int end)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
-      dIx[i][j].R = static_cast<unsigned char>(vpImageFilter::filterXLeftBorderR(I, i, j, filter, size));
-      dIx[i][j].G = static_cast<unsigned char>(vpImageFilter::filterXLeftBorderG(I, i, j, filter, size));
-      dIx[i][j].B = static_cast<unsigned char>(vpImageFilter::filterXLeftBorderB(I, i, j, filter, size));
-    }
-    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
-      dIx[i][j].R = static_cast<unsigned char>(vpImageFilter::filterXR(I, i, j, filter, size));
-      dIx[i][j].G = static_cast<unsigned char>(vpImageFilter::filterXG(I, i, j, filter, size));
-      dIx[i][j].B = static_cast<unsigned char>(vpImageFilter::filterXB(I, i, j, filter, size));
+  int c = begin;
+  for (; c <= end - 4; c += 4) {
+    __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+    for (unsigned int i = 1; i <= taps.half; i++) {
+      const double *plus = taps.plus[i - 1] + c, *minus = taps.minus[i - 1] + c;
+      const __m128d k = _mm_set1_pd(taps.kernel[i]);
+      __m128d s0, s1;
+      if (taps.derivative) {
+        s0 = _mm_sub_pd(_mm_loadu_pd(plus), _mm_loadu_pd(minus));
+        s1 = _mm_sub_pd(_mm_loadu_pd(plus + 2), _mm_loadu_pd(minus + 2));
+      } else {
+        s0 = _mm_add_pd(_mm_loadu_pd(plus), _mm_loadu_pd(minus));
+        s1 = _mm_add_pd(_mm_loadu_pd(plus + 2), _mm_loadu_pd(minus + 2));
+      }
+      acc0 = _mm_add_pd(acc0, _mm_mul_pd(k, s0));
+      acc1 = _mm_add_pd(acc1, _mm_mul_pd(k, s1));
     }
-    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
-      dIx[i][j].R = static_cast<unsigned char>(vpImageFilter::filterXRightBorderR(I, i, j, filter, size));
-      dIx[i][j].G = static_cast<unsigned char>(vpImageFilter::filterXRightBorderG(I, i, j, filter, size));
-      dIx[i][j].B = static_cast<unsigned char>(vpImageFilter::filterXRightBorderB(I, i, j, filter, size));
+    if (!taps.derivative) {
+      const __m128d k = _mm_set1_pd(taps.kernel[0]);
+      acc0 = _mm_add_pd(acc0, _mm_mul_pd(k, _mm_loadu_pd(taps.center + c)));
+      acc1 = _mm_add_pd(acc1, _mm_mul_pd(k, _mm_loadu_pd(taps.center + c + 2)));
     }
+    _mm_storeu_pd(dst + c, acc0);
+    _mm_storeu_pd(dst + c + 2, acc1);
   }
+  return c;
 }
-void vpImageFilter::filterX(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size)
+
+int combineTapsSSE2(const vpFilterTaps<float> &taps, float *dst, int begin, int end)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::filterXLeftBorder(I, i, j, filter, size);
-      // dIx[i][j]=0;
-    }
-    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::filterX(I, i, j, filter, size);
+  int c = begin;
+  for (; c <= end - 8; c += 8) {
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    for (unsigned int i = 1; i <= taps.half; i++) {
+      const float *plus = taps.plus[i - 1] + c, *minus = taps.minus[i - 1] + c;
+      const __m128 k = _mm_set1_ps(taps.kernel[i]);
+      __m128 s0, s1;
+      if (taps.derivative) {
+        s0 = _mm_sub_ps(_mm_loadu_ps(plus), _mm_loadu_ps(minus));
+        s1 = _mm_sub_ps(_mm_loadu_ps(plus + 4), _mm_loadu_ps(minus + 4));
+      } else {
+        s0 = _mm_add_ps(_mm_loadu_ps(plus), _mm_loadu_ps(minus));
+        s1 = _mm_add_ps(_mm_loadu_ps(plus + 4), _mm_loadu_ps(minus + 4));
+      }
+      acc0 = _mm_add_ps(acc0, _mm_mul_ps(k, s0));
+      acc1 = _mm_add_ps(acc1, _mm_mul_ps(k, s1));
     }
-    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
-      dIx[i][j] = vpImageFilter::filterXRightBorder(I, i, j, filter, size);
-      // dIx[i][j]=0;
+    if (!taps.derivative) {
+      const __m128 k = _mm_set1_ps(taps.kernel[0]);
+      acc0 = _mm_add_ps(acc0, _mm_mul_ps(k, _mm_loadu_ps(taps.center + c)));
+      acc1 = _mm_add_ps(acc1, _mm_mul_ps(k, _mm_loadu_ps(taps.center + c + 4)));
     }
+    _mm_storeu_ps(dst + c, acc0);
+    _mm_storeu_ps(dst + c + 4, acc1);
   }
+  return c;
 }
-void vpImageFilter::filterY(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *filter,
-                            unsigned int size)
+#endif
+
+#if VISP_HAVE_AVX2
+// No FMA here: a fused multiply-add would change the rounding
+VISP_AVX2_TARGET int combineTapsAVX2(const vpFilterTaps<double> &taps, double *dst, int begin, int end)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterYTopBorder(I, i, j, filter, size);
-    }
-  }
-  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterY(I, i, j, filter, size);
+  int c = begin;
+  for (; c <= end - 8; c += 8) {
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    for (unsigned int i = 1; i <= taps.half; i++) {
+      const double *plus = taps.plus[i - 1] + c, *minus = taps.minus[i - 1] + c;
+      const __m256d k = _mm256_set1_pd(taps.kernel[i]);
+      __m256d s0, s1;
+      if (taps.derivative) {
+        s0 = _mm256_sub_pd(_mm256_loadu_pd(plus), _mm256_loadu_pd(minus));
+        s1 = _mm256_sub_pd(_mm256_loadu_pd(plus + 4), _mm256_loadu_pd(minus + 4));
+      } else {
+        s0 = _mm256_add_pd(_mm256_loadu_pd(plus), _mm256_loadu_pd(minus));
+        s1 = _mm256_add_pd(_mm256_loadu_pd(plus + 4), _mm256_loadu_pd(minus + 4));
+      }
+      acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(k, s0));
+      acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(k, s1));
     }
-  }
-  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterYBottomBorder(I, i, j, filter, size);
+    if (!taps.derivative) {
+      const __m256d k = _mm256_set1_pd(taps.kernel[0]);
+      acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(k, _mm256_loadu_pd(taps.center + c)));
+      acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(k, _mm256_loadu_pd(taps.center + c + 4)));
     }
+    _mm256_storeu_pd(dst + c, acc0);
+    _mm256_storeu_pd(dst + c + 4, acc1);
   }
+  return c;
 }
-void vpImageFilter::filterY(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIy, const double *filter,
-                            unsigned int size)
+
+VISP_AVX2_TARGET int combineTapsAVX2(const vpFilterTaps<float> &taps, float *dst, int begin, int end)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j].R = static_cast<unsigned char>(vpImageFilter::filterYTopBorderR(I, i, j, filter, size));
-      dIy[i][j].G = static_cast<unsigned char>(vpImageFilter::filterYTopBorderG(I, i, j, filter, size));
-      dIy[i][j].B = static_cast<unsigned char>(vpImageFilter::filterYTopBorderB(I, i, j, filter, size));
-    }
-  }
-  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j].R = static_cast<unsigned char>(vpImageFilter::filterYR(I, i, j, filter, size));
-      dIy[i][j].G = static_cast<unsigned char>(vpImageFilter::filterYG(I, i, j, filter, size));
-      dIy[i][j].B = static_cast<unsigned char>(vpImageFilter::filterYB(I, i, j, filter, size));
+  int c = begin;
+  for (; c <= end - 16; c += 16) {
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    for (unsigned int i = 1; i <= taps.half; i++) {
+      const float *plus = taps.plus[i - 1] + c, *minus = taps.minus[i - 1] + c;
+      const __m256 k = _mm256_set1_ps(taps.kernel[i]);
+      __m256 s0, s1;
+      if (taps.derivative) {
+        s0 = _mm256_sub_ps(_mm256_loadu_ps(plus), _mm256_loadu_ps(minus));
+        s1 = _mm256_sub_ps(_mm256_loadu_ps(plus + 8), _mm256_loadu_ps(minus + 8));
+      } else {
+        s0 = _mm256_add_ps(_mm256_loadu_ps(plus), _mm256_loadu_ps(minus));
+        s1 = _mm256_add_ps(_mm256_loadu_ps(plus + 8), _mm256_loadu_ps(minus + 8));
+      }
+      acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(k, s0));
+      acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(k, s1));
     }
-  }
-  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j].R = static_cast<unsigned char>(vpImageFilter::filterYBottomBorderR(I, i, j, filter, size));
-      dIy[i][j].G = static_cast<unsigned char>(vpImageFilter::filterYBottomBorderG(I, i, j, filter, size));
-      dIy[i][j].B = static_cast<unsigned char>(vpImageFilter::filterYBottomBorderB(I, i, j, filter, size));
+    if (!taps.derivative) {
+      const __m256 k = _mm256_set1_ps(taps.kernel[0]);
+      acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(k, _mm256_loadu_ps(taps.center + c)));
+      acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(k, _mm256_loadu_ps(taps.center + c + 8)));
     }
+    _mm256_storeu_ps(dst + c, acc0);
+    _mm256_storeu_ps(dst + c + 8, acc1);
   }
+  return c;
 }
-void vpImageFilter::filterY(const vpImage<double> &I, vpImage<double> &dIy, const double *filter, unsigned int size)
+#endif
+
+#if VISP_HAVE_NEON
+// vmlaq would be fused on some targets, multiplications and additions are kept separate
+int combineTapsNEON(const vpFilterTaps<double> &taps, double *dst, int begin, int end)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterYTopBorder(I, i, j, filter, size);
+  int c = begin;
+  for (; c <= end - 2; c += 2) {
+    float64x2_t acc = vdupq_n_f64(0.);
+    for (unsigned int i = 1; i <= taps.half; i++) {
+      const float64x2_t a = vld1q_f64(taps.plus[i - 1] + c), b = vld1q_f64(taps.minus[i - 1] + c);
+      const float64x2_t s = taps.derivative ? vsubq_f64(a, b) : vaddq_f64(a, b);
+      acc = vaddq_f64(acc, vmulq_f64(vdupq_n_f64(taps.kernel[i]), s));
     }
-  }
-  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterY(I, i, j, filter, size);
+    if (!taps.derivative) {
+      acc = vaddq_f64(acc, vmulq_f64(vdupq_n_f64(taps.kernel[0]), vld1q_f64(taps.center + c)));
     }
+    vst1q_f64(dst + c, acc);
   }
-  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterYBottomBorder(I, i, j, filter, size);
+  return c;
+}
+
+int combineTapsNEON(const vpFilterTaps<float> &taps, float *dst, int begin, int end)
+{
+  int c = begin;
+  for (; c <= end - 4; c += 4) {
+    float32x4_t acc = vdupq_n_f32(0.f);
+    for (unsigned int i = 1; i <= taps.half; i++) {
+      const float32x4_t a = vld1q_f32(taps.plus[i - 1] + c), b = vld1q_f32(taps.minus[i - 1] + c);
+      const float32x4_t s = taps.derivative ? vsubq_f32(a, b) : vaddq_f32(a, b);
+      acc = vaddq_f32(acc, vmulq_f32(vdupq_n_f32(taps.kernel[i]), s));
+    }
+    if (!taps.derivative) {
+      acc = vaddq_f32(acc, vmulq_f32(vdupq_n_f32(taps.kernel[0]), vld1q_f32(taps.center + c)));
     }
+    vst1q_f32(dst + c, acc);
   }
+  return c;
 }
+#endif
 
-/*!
-  Apply a Gaussian blur to an image.
-  \param I : Input image.
-  \param GI : Filtered image.
-  \param size : Filter size. This value should be odd.
-  \param sigma : Gaussian standard deviation. If it is equal to zero or
-  negative, it is computed from filter size as sigma = (size-1)/6.
-  \param normalize : Flag indicating whether to normalize the filter coefficients or
-  not.
-
-  \sa getGaussianKernel() to know which kernel is used.
- */
-void vpImageFilter::gaussianBlur(const vpImage<unsigned char> &I, vpImage<double> &GI, unsigned int size, double sigma,
-                                 bool normalize)
+template <typename T> void combineTaps(const vpFilterTaps<T> &taps, T *dst, int begin, int end)
 {
-  double *fg = new double[(size + 1) / 2];
-  vpImageFilter::getGaussianKernel(fg, size, sigma, normalize);
-  vpImage<double> GIx;
-  vpImageFilter::filterX(I, GIx, fg, size);
-  vpImageFilter::filterY(GIx, GI, fg, size);
-  GIx.destroy();
-  delete[] fg;
+  int c = begin;
+  switch (getFilterSimd()) {
+#if VISP_HAVE_AVX2
+  case vpFilterAVX2:
+    c = combineTapsAVX2(taps, dst, begin, end);
+    break;
+#endif
+#if VISP_HAVE_SSE2
+  case vpFilterSSE2:
+    c = combineTapsSSE2(taps, dst, begin, end);
+    break;
+#endif
+#if VISP_HAVE_NEON
+  case vpFilterNEON:
+    c = combineTapsNEON(taps, dst, begin, end);
+    break;
+#endif
+  default:
+    break;
+  }
+  combineTapsScalar(taps, dst, c, end);
 }
 
-/*!
-  Apply a Gaussian blur to RGB color image.
-  \param I : Input image.
-  \param GI : Filtered image.
-  \param size : Filter size. This value should be odd.
-  \param sigma : Gaussian standard deviation. If it is equal to zero or
-  negative, it is computed from filter size as sigma = (size-1)/6.
-  \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+// Values stored per pixel: color images are filtered as interleaved RGBA rows
+template <typename Type> struct vpFilterPixel {
+  typedef Type value_type;
+  static const unsigned int channels = 1;
+};
 
-  \sa getGaussianKernel() to know which kernel is used.
- */
-void vpImageFilter::gaussianBlur(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &GI, unsigned int size, double sigma,
-                                 bool normalize)
+template <> struct vpFilterPixel<vpRGBa> {
+  typedef unsigned char value_type;
+  static const unsigned int channels = 4;
+};
+
+// A stage of the pipeline produces the rows of an image on request. Only a
+// few rows are kept in cache-sized buffers, no intermediate image is stored.
+template <typename T> class vpFilterStage
 {
-  double *fg = new double[(size + 1) / 2];
-  vpImageFilter::getGaussianKernel(fg, size, sigma, normalize);
-  vpImage<vpRGBa> GIx;
-  vpImageFilter::filterX(I, GIx, fg, size);
-  vpImageFilter::filterY(GIx, GI, fg, size);
-  GIx.destroy();
-  delete[] fg;
-}
+public:
+  explicit vpFilterStage(unsigned int width) : m_width(width) {}
+  virtual ~vpFilterStage() {}
 
-/*!
-  Apply a Gaussian blur to a double image.
-  \param I : Input double image.
-  \param GI : Filtered image.
-  \param size : Filter size. This value should be odd.
-  \param sigma : Gaussian standard deviation. If it is equal to zero or
-  negative, it is computed from filter size as sigma = (size-1)/6.
-  \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+  // Number of values per row
+  unsigned int getWidth() const { return m_width; }
+  virtual void fillRow(int r, T *dst) = 0;
 
-  \sa getGaussianKernel() to know which kernel is used.
- */
-void vpImageFilter::gaussianBlur(const vpImage<double> &I, vpImage<double> &GI, unsigned int size, double sigma,
-                                 bool normalize)
+protected:
+  unsigned int m_width;
+};
+
+// Rows of the input image converted to the working type
+template <typename Type, typename T> class vpImageRows : public vpFilterStage<T>
 {
-  double *fg = new double[(size + 1) / 2];
-  vpImageFilter::getGaussianKernel(fg, size, sigma, normalize);
-  vpImage<double> GIx;
-  vpImageFilter::filterX(I, GIx, fg, size);
-  vpImageFilter::filterY(GIx, GI, fg, size);
-  GIx.destroy();
-  delete[] fg;
-}
+public:
+  vpImageRows(const Type *data, unsigned int width, size_t stride)
+    : vpFilterStage<T>(width), m_data(data), m_stride(stride)
+  {
+  }
 
-/*!
-  Return the coefficients \f$G_i\f$ of a Gaussian filter.
+  virtual void fillRow(int r, T *dst)
+  {
+    const Type *src = m_data + static_cast<size_t>(r) * m_stride;
+    for (unsigned int c = 0; c < this->m_width; c++) {
+      dst[c] = static_cast<T>(src[c]);
+    }
+  }
 
-  \param[out] filter : Pointer to the half size filter kernel that should refer to a
-  (size+1)/2 array. The first value refers to the central coefficient, the
-  next one to the right coefficients. Left coefficients could be deduced by
-  symmetry.
-  \param[in] size : Filter size. This value should be odd and positive.
-  \param[in] sigma : Gaussian standard deviation \f$ \sigma \f$. If it is equal to zero or negative, it is
-  computed from filter size as sigma = (size-1)/6.
-  \param[in] normalize : Flag indicating whether to normalize the filter coefficients or not. In that case \f$\Sigma G_i = 1 \f$.
+private:
+  const Type *m_data;
+  size_t m_stride;
+};
 
-  The function computes the \e (size+1)/2 values of the Gaussian filter cooefficients \f$ G_i \f$ as:
-  \f[ G_i = \frac{1}{\sigma  \sqrt{2 \pi}} \exp{(-i^2 / (2. * \sigma^2))}\f]
-*/
-void vpImageFilter::getGaussianKernel(double *filter, unsigned int size, double sigma, bool normalize)
+// Filtering along the rows. The border is reflected as in filterXLeftBorder()
+// and filterXRightBorder(), the derivative is set to 0 on the border as in
+// getGradX().
+template <typename T> class vpHorizontalStage : public vpFilterStage<T>
 {
-  if (size % 2 != 1)
-    throw(vpImageException(vpImageException::incorrectInitializationError, "Bad Gaussian filter size"));
+public:
+  vpHorizontalStage(vpFilterStage<T> &src, const T *kernel, unsigned int size, unsigned int channels, bool derivative,
+                    bool truncate)
+    : vpFilterStage<T>(src.getWidth()), m_src(src), m_half((size - 1) / 2), m_channels(channels),
+      m_truncate(truncate), m_padded(src.getWidth() + 2 * m_half * channels), m_taps()
+  {
+    T *row = &m_padded[m_half * m_channels];
+    m_taps.center = row;
+    m_taps.kernel = kernel;
+    m_taps.half = m_half;
+    m_taps.derivative = derivative;
+    for (unsigned int i = 1; i <= m_half; i++) {
+      m_taps.plus.push_back(row + i * m_channels);
+      m_taps.minus.push_back(row - static_cast<int>(i * m_channels));
+    }
+  }
 
-  if (sigma <= 0)
+  virtual void fillRow(int r, T *dst)
+  {
+    const int width = static_cast<int>(this->m_width);
+    const int nbPixels = width / static_cast<int>(m_channels);
+    const int half = static_cast<int>(m_half), channels = static_cast<int>(m_channels);
+    T *row = &m_padded[m_half * m_channels];
+    m_src.fillRow(r, row);
+
+    if (m_taps.derivative) {
+      if (nbPixels <= 2 * half) {
+        std::fill(dst, dst + width, T(0));
+        return;
+      }
+      std::fill(dst, dst + half * channels, T(0));
+      std::fill(dst + (nbPixels - half) * channels, dst + width, T(0));
+      combineTaps(m_taps, dst, half * channels, (nbPixels - half) * channels);
+    } else {
+      // Left border: -k -> k, right border: w-1+k -> w-k
+      for (int k = 1; k <= half; k++) {
+        const int src = (std::min)(k, nbPixels - 1);
+        for (int ch = 0; ch < channels; ch++) {
+          row[-k * channels + ch] = row[src * channels + ch];
+        }
+      }
+      for (int k = 0; k < half; k++) {
+        const int src = (std::max)(nbPixels - 1 - k, 0);
+        for (int ch = 0; ch < channels; ch++) {
+          row[(nbPixels + k) * channels + ch] = row[src * channels + ch];
+        }
+      }
+      combineTaps(m_taps, dst, 0, width);
+    }
+
+    if (m_truncate) {
+      for (int c = 0; c < width; c++) {
+        dst[c] = static_cast<T>(static_cast<unsigned char>(dst[c]));
+      }
+    }
+  }
+
+private:
+  vpFilterStage<T> &m_src;
+  unsigned int m_half;
+  unsigned int m_channels;
+  bool m_truncate;
+  std::vector<T> m_padded;
+  vpFilterTaps<T> m_taps;
+};
+
+// Filtering along the columns. The rows of the previous stage are kept in a
+// ring buffer of 2 * half + 1 rows, each of them being computed once per band. The
+// border is reflected as in filterYTopBorder() and filterYBottomBorder(), the
+// derivative is set to 0 on the border as in getGradY().
+template <typename T> class vpVerticalStage : public vpFilterStage<T>
+{
+public:
+  vpVerticalStage(vpFilterStage<T> &src, unsigned int height, const T *kernel, unsigned int size, bool derivative,
+                  bool truncate)
+    : vpFilterStage<T>(src.getWidth()), m_src(src), m_height(static_cast<int>(height)),
+      m_half(static_cast<int>((size - 1) / 2)), m_truncate(truncate),
+      m_ring((2 * static_cast<size_t>(m_half) + 1) * src.getWidth()), m_ringRows(2 * m_half + 1, -1), m_taps()
+  {
+    m_taps.kernel = kernel;
+    m_taps.half = (size - 1) / 2;
+    m_taps.derivative = derivative;
+    m_taps.plus.resize(m_taps.half);
+    m_taps.minus.resize(m_taps.half);
+  }
+
+  virtual void fillRow(int r, T *dst)
+  {
+    const int width = static_cast<int>(this->m_width);
+    if (m_taps.derivative && (r < m_half || r >= m_height - m_half)) {
+      std::fill(dst, dst + width, T(0));
+      return;
+    }
+
+    m_taps.center = getRow(r);
+    for (int i = 1; i <= m_half; i++) {
+      m_taps.plus[i - 1] = getRow(r + i < m_height ? r + i : 2 * m_height - r - i - 1);
+      m_taps.minus[i - 1] = getRow(r - i >= 0 ? r - i : i - r);
+    }
+    combineTaps(m_taps, dst, 0, width);
+
+    if (m_truncate) {
+      for (int c = 0; c < width; c++) {
+        dst[c] = static_cast<T>(static_cast<unsigned char>(dst[c]));
+      }
+    }
+  }
+
+private:
+  // All the rows needed for an output row lie in a window of 2 * half + 1 rows,
+  // which therefore never overwrite each other in the ring
+  const T *getRow(int r)
+  {
+    r = (std::max)((std::min)(r, m_height - 1), 0);
+    const size_t slot = static_cast<size_t>(r) % m_ringRows.size();
+    T *row = &m_ring[slot * this->m_width];
+    if (m_ringRows[slot] != r) {
+      m_src.fillRow(r, row);
+      m_ringRows[slot] = r;
+    }
+    return row;
+  }
+
+  vpFilterStage<T> &m_src;
+  int m_height;
+  int m_half;
+  bool m_truncate;
+  std::vector<T> m_ring;
+  std::vector<int> m_ringRows;
+  vpFilterTaps<T> m_taps;
+};
+
+// One pass of a separable filter
+template <typename T> struct vpFilterPass {
+  vpFilterPass(bool horizontal_, const T *kernel_, bool derivative_, bool truncate_ = false)
+    : horizontal(horizontal_), kernel(kernel_), derivative(derivative_), truncate(truncate_)
+  {
+  }
+
+  bool horizontal;
+  const T *kernel;
+  bool derivative;
+  bool truncate; // round the intermediate values as when they are stored in a vpImage<vpRGBa>
+};
+
+template <typename T> void storeRows(vpFilterStage<T> &stage, vpImage<T> &O, int start, int end)
+{
+  for (int r = start; r < end; r++) {
+    stage.fillRow(r, O[r]);
+  }
+}
+
+void storeRows(vpFilterStage<double> &stage, vpImage<vpRGBa> &O, int start, int end)
+{
+  std::vector<double> row(stage.getWidth());
+  for (int r = start; r < end; r++) {
+    stage.fillRow(r, &row[0]);
+    vpRGBa *dst = O[r];
+    for (unsigned int c = 0; c < O.getWidth(); c++) {
+      dst[c].R = static_cast<unsigned char>(row[4 * c]);
+      dst[c].G = static_cast<unsigned char>(row[4 * c + 1]);
+      dst[c].B = static_cast<unsigned char>(row[4 * c + 2]);
+    }
+  }
+}
+
+template <typename Type, typename T, typename Tout>
+void separableFilterRows(const vpImageView<const Type> &I, vpImage<Tout> &O,
+                         const std::vector<vpFilterPass<T> > &passes, unsigned int size, int start, int end)
+{
+  typedef typename vpFilterPixel<Type>::value_type value_type;
+  const unsigned int channels = vpFilterPixel<Type>::channels;
+
+  std::vector<vpFilterStage<T> *> stages;
+  stages.push_back(new vpImageRows<value_type, T>(reinterpret_cast<const value_type *>(I.getData()),
+                                                  I.getWidth() * channels,
+                                                  static_cast<size_t>(I.getStride()) * channels));
+  for (size_t i = 0; i < passes.size(); i++) {
+    const vpFilterPass<T> &pass = passes[i];
+    if (pass.horizontal) {
+      stages.push_back(
+          new vpHorizontalStage<T>(*stages.back(), pass.kernel, size, channels, pass.derivative, pass.truncate));
+    } else {
+      stages.push_back(
+          new vpVerticalStage<T>(*stages.back(), I.getHeight(), pass.kernel, size, pass.derivative, pass.truncate));
+    }
+  }
+
+  storeRows(*stages.back(), O, start, end);
+
+  for (size_t i = 0; i < stages.size(); i++) {
+    delete stages[i];
+  }
+}
+
+// Apply the passes to the image. The rows are processed by bands in
+// parallel, each band recomputing the few rows it shares with its neighbours.
+template <typename Type, typename T, typename Tout>
+void separableFilter(const vpImageView<const Type> &I, vpImage<Tout> &O, const std::vector<vpFilterPass<T> > &passes,
+                     unsigned int size)
+{
+  // The input may be the output image or a view on it
+  const char *begin = reinterpret_cast<const char *>(I.getData());
+  const char *end = reinterpret_cast<const char *>(I[I.getHeight()]);
+  const char *O_begin = reinterpret_cast<const char *>(O.bitmap);
+  const char *O_end = reinterpret_cast<const char *>(O.bitmap + O.getSize());
+  if (I.getSize() > 0 && O.getSize() > 0 && begin < O_end && O_begin < end) {
+    vpImage<Type> I_copy;
+    vpImageTools::crop(I, I_copy);
+    separableFilter(vpImageView<const Type>(I_copy), O, passes, size);
+    return;
+  }
+
+  O.resize(I.getHeight(), I.getWidth());
+  if (I.getSize() == 0) {
+    return;
+  }
+
+  const int height = static_cast<int>(I.getHeight());
+  const int bandSize = (std::max)(32, static_cast<int>(4 * size));
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, height, [&](int start, int end) {
+    separableFilterRows(I, O, passes, size, start, end);
+  }, 0, bandSize);
+#else
+  const int nbBands = (height + bandSize - 1) / bandSize;
+#if defined _OPENMP // only to disable warning: ignoring #pragma omp parallel [-Wunknown-pragmas]
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int band = 0; band < nbBands; band++) {
+    separableFilterRows(I, O, passes, size, band * bandSize, (std::min)((band + 1) * bandSize, height));
+  }
+#endif
+}
+
+template <typename Type, typename T, typename Tout>
+void separableFilter(const vpImageView<const Type> &I, vpImage<Tout> &O, const vpFilterPass<T> &pass,
+                     unsigned int size)
+{
+  separableFilter(I, O, std::vector<vpFilterPass<T> >(1, pass), size);
+}
+
+template <typename Type, typename T, typename Tout>
+void separableFilter(const vpImageView<const Type> &I, vpImage<Tout> &O, const vpFilterPass<T> &pass1,
+                     const vpFilterPass<T> &pass2, unsigned int size)
+{
+  std::vector<vpFilterPass<T> > passes;
+  passes.push_back(pass1);
+  passes.push_back(pass2);
+  separableFilter(I, O, passes, size);
+}
+
+template <typename Type, typename T, typename Tout>
+void separableFilter(const vpImage<Type> &I, vpImage<Tout> &O, const vpFilterPass<T> &pass, unsigned int size)
+{
+  separableFilter(vpImageView<const Type>(I), O, pass, size);
+}
+
+template <typename Type, typename T, typename Tout>
+void separableFilter(const vpImage<Type> &I, vpImage<Tout> &O, const vpFilterPass<T> &pass1,
+                     const vpFilterPass<T> &pass2, unsigned int size)
+{
+  separableFilter(vpImageView<const Type>(I), O, pass1, pass2, size);
+}
+
+// Single precision copy of a half kernel
+std::vector<float> toFloatKernel(const double *filter, unsigned int size)
+{
+  return std::vector<float>(filter, filter + (size + 1) / 2);
+}
+
+// 1-4-6-4-1 pyramidal filter along a row followed by a decimation, computed
+// on 16-bit integers. Truncating the sum shifted by 4 gives exactly the
+// value of filterGaussXPyramidal().
+void gaussXPyramidalRow(const unsigned char *src, unsigned int width, unsigned short *dst)
+{
+  const int w = static_cast<int>(width / 2);
+  int j = 1;
+#if VISP_HAVE_SSE2
+  if (getFilterSimd() != vpFilterScalar) {
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+    // The last load reads src[2 * j + 17], which must be lower than 2 * w
+    for (; j <= w - 9; j += 8) {
+      const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2 * j - 2));
+      const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2 * j));
+      const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 2 * j + 2));
+      const __m128i b_even = _mm_and_si128(b, mask);
+      const __m128i odd = _mm_add_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+      __m128i sum = _mm_add_epi16(_mm_and_si128(a, mask), _mm_and_si128(c, mask));
+      sum = _mm_add_epi16(sum, _mm_slli_epi16(odd, 2));
+      sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_slli_epi16(b_even, 2), _mm_slli_epi16(b_even, 1)));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + j), _mm_srli_epi16(sum, 4));
+    }
+  }
+#endif
+  for (; j < w - 1; j++) {
+    const unsigned char *p = src + 2 * j;
+    dst[j] = static_cast<unsigned short>((p[-2] + 4 * p[-1] + 6 * p[0] + 4 * p[1] + p[2]) >> 4);
+  }
+  dst[0] = src[0];
+  dst[w - 1] = src[2 * w - 1];
+}
+
+// 1-4-6-4-1 pyramidal filter along the columns
+void gaussYPyramidalRow(const unsigned short *const *rows, unsigned int width, unsigned char *dst)
+{
+  const int w = static_cast<int>(width);
+  int j = 0;
+#if VISP_HAVE_SSE2
+  if (getFilterSimd() != vpFilterScalar) {
+    for (; j <= w - 8; j += 8) {
+      const __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[0] + j));
+      const __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[1] + j));
+      const __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[2] + j));
+      const __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[3] + j));
+      const __m128i r4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[4] + j));
+      __m128i sum = _mm_add_epi16(r0, r4);
+      sum = _mm_add_epi16(sum, _mm_slli_epi16(_mm_add_epi16(r1, r3), 2));
+      sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_slli_epi16(r2, 2), _mm_slli_epi16(r2, 1)));
+      sum = _mm_srli_epi16(sum, 4);
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + j), _mm_packus_epi16(sum, sum));
+    }
+  }
+#endif
+  for (; j < w; j++) {
+    dst[j] = static_cast<unsigned char>(
+        (rows[0][j] + 4 * rows[1][j] + 6 * rows[2][j] + 4 * rows[3][j] + rows[4][j]) >> 4);
+  }
+}
+
+// Rows of the half size image. The rows filtered along x are kept in a ring
+// buffer of 5 rows. When filterX is false, the input rows are only widened,
+// which corresponds to getGaussYPyramidal() alone.
+void gaussPyramidalRows(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI, bool filterX, int start,
+                        int end)
+{
+  const unsigned int w = GI.getWidth();
+  const int h = static_cast<int>(GI.getHeight());
+  std::vector<unsigned short> ring(5 * w);
+  int ringRows[5] = {-1, -1, -1, -1, -1};
+  const unsigned short *rows[5];
+
+  for (int i = start; i < end; i++) {
+    // As in getGaussYPyramidal(), the first and last rows are not filtered
+    const bool border = (i == 0 || i == h - 1);
+    const int first = border ? (i == h - 1 ? 2 * h - 1 : 0) : 2 * i - 2;
+    const int last = border ? first : 2 * i + 2;
+    for (int k = first; k <= last; k++) {
+      const int slot = k % 5;
+      unsigned short *row = &ring[slot * w];
+      if (ringRows[slot] != k) {
+        if (filterX) {
+          gaussXPyramidalRow(I[k], I.getWidth(), row);
+        } else {
+          std::copy(I[k], I[k] + w, row);
+        }
+        ringRows[slot] = k;
+      }
+      rows[k - first] = row;
+    }
+
+    if (border) {
+      std::copy(rows[0], rows[0] + w, GI[i]);
+    } else {
+      gaussYPyramidalRow(rows, w, GI[i]);
+    }
+  }
+}
+
+void gaussPyramidal(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI, bool filterX)
+{
+  if (&I == &GI) {
+    const vpImage<unsigned char> I_copy(I);
+    gaussPyramidal(I_copy, GI, filterX);
+    return;
+  }
+
+  GI.resize(I.getHeight() / 2, filterX ? I.getWidth() / 2 : I.getWidth());
+  if (GI.getSize() == 0) {
+    return;
+  }
+
+  const int height = static_cast<int>(GI.getHeight());
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, height, [&](int start, int end) {
+    gaussPyramidalRows(I, GI, filterX, start, end);
+  }, 0, 32);
+#else
+  gaussPyramidalRows(I, GI, filterX, 0, height);
+#endif
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Apply a separable filter.
+ */
+void vpImageFilter::filter(const vpImage<unsigned char> &I, vpImage<double> &GI, const double *filter,
+                           unsigned int size)
+{
+  separableFilter(I, GI, vpFilterPass<double>(true, filter, false), vpFilterPass<double>(false, filter, false), size);
+}
+
+/*!
+  Apply a separable filter.
+ */
+void vpImageFilter::filter(const vpImage<double> &I, vpImage<double> &GI, const double *filter, unsigned int size)
+{
+  separableFilter(I, GI, vpFilterPass<double>(true, filter, false), vpFilterPass<double>(false, filter, false), size);
+}
+
+/*!
+  Apply a separable filter. The computations are done in single precision.
+
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param filter : Half size filter kernel, as for filter(const vpImage<unsigned char> &, vpImage<double> &, const
+  double *, unsigned int).
+  \param size : Filter size. This value should be odd.
+ */
+void vpImageFilter::filter(const vpImage<unsigned char> &I, vpImage<float> &GI, const double *filter,
+                           unsigned int size)
+{
+  const std::vector<float> kernel = toFloatKernel(filter, size);
+  separableFilter(I, GI, vpFilterPass<float>(true, &kernel[0], false), vpFilterPass<float>(false, &kernel[0], false),
+                  size);
+}
+
+/*!
+  Apply a separable filter to a region of interest or to a padded image,
+  without copying it.
+
+  \param I : Input view. It may refer to the memory of \e GI.
+  \param GI : Filtered image, with the size of the view.
+  \param filter : Half size filter kernel, as for filter(const vpImage<unsigned char> &, vpImage<double> &, const
+  double *, unsigned int).
+  \param size : Filter size. This value should be odd.
+ */
+void vpImageFilter::filter(const vpImageView<const unsigned char> &I, vpImage<double> &GI, const double *filter,
+                           unsigned int size)
+{
+  separableFilter(I, GI, vpFilterPass<double>(true, filter, false), vpFilterPass<double>(false, filter, false), size);
+}
+
+/*!
+  Apply a separable filter to a region of interest or to a padded image,
+  the computations being done in single precision.
+ */
+void vpImageFilter::filter(const vpImageView<const unsigned char> &I, vpImage<float> &GI, const double *filter,
+                           unsigned int size)
+{
+  const std::vector<float> kernel = toFloatKernel(filter, size);
+  separableFilter(I, GI, vpFilterPass<float>(true, &kernel[0], false), vpFilterPass<float>(false, &kernel[0], false),
+                  size);
+}
+
+void vpImageFilter::filterX(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *filter,
+                            unsigned int size)
+{
+  separableFilter(I, dIx, vpFilterPass<double>(true, filter, false), size);
+}
+
+/*!
+  Filter along the rows, the computations being done in single precision.
+ */
+void vpImageFilter::filterX(const vpImage<unsigned char> &I, vpImage<float> &dIx, const double *filter,
+                            unsigned int size)
+{
+  const std::vector<float> kernel = toFloatKernel(filter, size);
+  separableFilter(I, dIx, vpFilterPass<float>(true, &kernel[0], false), size);
+}
+
+void vpImageFilter::filterX(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter,
+                            unsigned int size)
+{
+  separableFilter(I, dIx, vpFilterPass<double>(true, filter, false), size);
+}
+
+void vpImageFilter::filterX(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size)
+{
+  separableFilter(I, dIx, vpFilterPass<double>(true, filter, false), size);
+}
+
+void vpImageFilter::filterY(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *filter,
+                            unsigned int size)
+{
+  separableFilter(I, dIy, vpFilterPass<double>(false, filter, false), size);
+}
+
+/*!
+  Filter along the columns, the computations being done in single precision.
+ */
+void vpImageFilter::filterY(const vpImage<unsigned char> &I, vpImage<float> &dIy, const double *filter,
+                            unsigned int size)
+{
+  const std::vector<float> kernel = toFloatKernel(filter, size);
+  separableFilter(I, dIy, vpFilterPass<float>(false, &kernel[0], false), size);
+}
+
+void vpImageFilter::filterY(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIy, const double *filter,
+                            unsigned int size)
+{
+  separableFilter(I, dIy, vpFilterPass<double>(false, filter, false), size);
+}
+
+void vpImageFilter::filterY(const vpImage<double> &I, vpImage<double> &dIy, const double *filter, unsigned int size)
+{
+  separableFilter(I, dIy, vpFilterPass<double>(false, filter, false), size);
+}
+
+/*!
+  Apply a Gaussian blur to an image.
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or
+  not.
+
+  \sa getGaussianKernel() to know which kernel is used.
+ */
+void vpImageFilter::gaussianBlur(const vpImage<unsigned char> &I, vpImage<double> &GI, unsigned int size, double sigma,
+                                 bool normalize)
+{
+  std::vector<double> fg((size + 1) / 2);
+  vpImageFilter::getGaussianKernel(&fg[0], size, sigma, normalize);
+  vpImageFilter::filter(I, GI, &fg[0], size);
+}
+
+/*!
+  Apply a Gaussian blur to an image, the computations being done in single
+  precision.
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or
+  not.
+
+  \sa getGaussianKernel() to know which kernel is used.
+ */
+void vpImageFilter::gaussianBlur(const vpImage<unsigned char> &I, vpImage<float> &GI, unsigned int size, double sigma,
+                                 bool normalize)
+{
+  std::vector<double> fg((size + 1) / 2);
+  vpImageFilter::getGaussianKernel(&fg[0], size, sigma, normalize);
+  vpImageFilter::filter(I, GI, &fg[0], size);
+}
+
+/*!
+  Apply a Gaussian blur to RGB color image.
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+
+  \sa getGaussianKernel() to know which kernel is used.
+ */
+void vpImageFilter::gaussianBlur(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &GI, unsigned int size, double sigma,
+                                 bool normalize)
+{
+  std::vector<double> fg((size + 1) / 2);
+  vpImageFilter::getGaussianKernel(&fg[0], size, sigma, normalize);
+  // The three channels are filtered in the same pass, the intermediate values
+  // being rounded as when they are stored in a color image
+  separableFilter(I, GI, vpFilterPass<double>(true, &fg[0], false, true), vpFilterPass<double>(false, &fg[0], false),
+                  size);
+}
+
+/*!
+  Apply a Gaussian blur to a double image.
+  \param I : Input double image.
+  \param GI : Filtered image.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+
+  \sa getGaussianKernel() to know which kernel is used.
+ */
+void vpImageFilter::gaussianBlur(const vpImage<double> &I, vpImage<double> &GI, unsigned int size, double sigma,
+                                 bool normalize)
+{
+  std::vector<double> fg((size + 1) / 2);
+  vpImageFilter::getGaussianKernel(&fg[0], size, sigma, normalize);
+  vpImageFilter::filter(I, GI, &fg[0], size);
+}
+
+/*!
+  Apply a Gaussian blur to a region of interest or to a padded image. The
+  borders of the view are handled as the borders of an image, so that the
+  result is the one obtained on the cropped image.
+  \param I : Input view.
+  \param GI : Filtered image, with the size of the view.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+
+  \sa getGaussianKernel() to know which kernel is used.
+ */
+void vpImageFilter::gaussianBlur(const vpImageView<const unsigned char> &I, vpImage<double> &GI, unsigned int size,
+                                 double sigma, bool normalize)
+{
+  std::vector<double> fg((size + 1) / 2);
+  vpImageFilter::getGaussianKernel(&fg[0], size, sigma, normalize);
+  vpImageFilter::filter(I, GI, &fg[0], size);
+}
+
+/*!
+  Apply a Gaussian blur to a region of interest or to a padded image, the
+  computations being done in single precision.
+ */
+void vpImageFilter::gaussianBlur(const vpImageView<const unsigned char> &I, vpImage<float> &GI, unsigned int size,
+                                 double sigma, bool normalize)
+{
+  std::vector<double> fg((size + 1) / 2);
+  vpImageFilter::getGaussianKernel(&fg[0], size, sigma, normalize);
+  vpImageFilter::filter(I, GI, &fg[0], size);
+}
+
+/*!
+  Apply a Gaussian blur to a region of interest or to a padded RGB color
+  image.
+ */
+void vpImageFilter::gaussianBlur(const vpImageView<const vpRGBa> &I, vpImage<vpRGBa> &GI, unsigned int size,
+                                 double sigma, bool normalize)
+{
+  std::vector<double> fg((size + 1) / 2);
+  vpImageFilter::getGaussianKernel(&fg[0], size, sigma, normalize);
+  separableFilter(I, GI, vpFilterPass<double>(true, &fg[0], false, true), vpFilterPass<double>(false, &fg[0], false),
+                  size);
+}
+
+/*!
+  Return the coefficients \f$G_i\f$ of a Gaussian filter.
+
+  \param[out] filter : Pointer to the half size filter kernel that should refer to a
+  (size+1)/2 array. The first value refers to the central coefficient, the
+  next one to the right coefficients. Left coefficients could be deduced by
+  symmetry.
+  \param[in] size : Filter size. This value should be odd and positive.
+  \param[in] sigma : Gaussian standard deviation \f$ \sigma \f$. If it is equal to zero or negative, it is
+  computed from filter size as sigma = (size-1)/6.
+  \param[in] normalize : Flag indicating whether to normalize the filter coefficients or not. In that case \f$\Sigma G_i = 1 \f$.
+
+  The function computes the \e (size+1)/2 values of the Gaussian filter cooefficients \f$ G_i \f$ as:
+  \f[ G_i = \frac{1}{\sigma  \sqrt{2 \pi}} \exp{(-i^2 / (2. * \sigma^2))}\f]
+*/
+void vpImageFilter::getGaussianKernel(double *filter, unsigned int size, double sigma, bool normalize)
+{
+  if (size % 2 != 1)
+    throw(vpImageException(vpImageException::incorrectInitializationError, "Bad Gaussian filter size"));
+
+  if (sigma <= 0)
     sigma = (size - 1) / 6.0;
 
   int middle = (int)(size - 1) / 2;
@@ -662,80 +1818,23 @@ void vpImageFilter::getGradY(const vpImage<unsigned char> &I, vpImage<double> &d
 void vpImageFilter::getGradX(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *filter,
                              unsigned int size)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  //#pragma omp parallel for
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
-      dIx[i][j] = 0;
-    }
-    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::derivativeFilterX(I, i, j, filter, size);
-    }
-    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
-      dIx[i][j] = 0;
-    }
-  }
+  separableFilter(I, dIx, vpFilterPass<double>(true, filter, true), size);
 }
+
 void vpImageFilter::getGradX(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  // dIx=0;
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
-      dIx[i][j] = 0;
-    }
-    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::derivativeFilterX(I, i, j, filter, size);
-    }
-    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
-      dIx[i][j] = 0;
-    }
-  }
+  separableFilter(I, dIx, vpFilterPass<double>(true, filter, true), size);
 }
 
 void vpImageFilter::getGradY(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *filter,
                              unsigned int size)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  //#pragma omp parallel for
-  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
-  //#pragma omp parallel for
-  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::derivativeFilterY(I, i, j, filter, size);
-    }
-  }
-  //#pragma omp parallel for
-  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
+  separableFilter(I, dIy, vpFilterPass<double>(false, filter, true), size);
 }
 
 void vpImageFilter::getGradY(const vpImage<double> &I, vpImage<double> &dIy, const double *filter, unsigned int size)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  // dIy=0;
-  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
-  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::derivativeFilterY(I, i, j, filter, size);
-    }
-  }
-  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
+  separableFilter(I, dIy, vpFilterPass<double>(false, filter, true), size);
 }
 
 /*!
@@ -750,9 +1849,45 @@ void vpImageFilter::getGradY(const vpImage<double> &I, vpImage<double> &dIy, con
 void vpImageFilter::getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *gaussianKernel,
                                     const double *gaussianDerivativeKernel, unsigned int size)
 {
-  vpImage<double> GIy;
-  vpImageFilter::filterY(I, GIy, gaussianKernel, size);
-  vpImageFilter::getGradX(GIy, dIx, gaussianDerivativeKernel, size);
+  separableFilter(I, dIx, vpFilterPass<double>(false, gaussianKernel, false),
+                  vpFilterPass<double>(true, gaussianDerivativeKernel, true), size);
+}
+
+/*!
+   Compute the gradient along X after applying a gaussian filter along Y, the
+   computations being done in single precision.
+   \param I : Input image
+   \param dIx : Gradient along X.
+   \param gaussianKernel : Gaussian kernel which values should be computed using vpImageFilter::getGaussianKernel().
+   \param gaussianDerivativeKernel : Gaussian derivative kernel which values should be computed using
+   vpImageFilter::getGaussianDerivativeKernel().
+   \param size : Size of the Gaussian and Gaussian derivative kernels.
+ */
+void vpImageFilter::getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<float> &dIx, const double *gaussianKernel,
+                                    const double *gaussianDerivativeKernel, unsigned int size)
+{
+  const std::vector<float> kernel = toFloatKernel(gaussianKernel, size);
+  const std::vector<float> derivativeKernel = toFloatKernel(gaussianDerivativeKernel, size);
+  separableFilter(I, dIx, vpFilterPass<float>(false, &kernel[0], false),
+                  vpFilterPass<float>(true, &derivativeKernel[0], true), size);
+}
+
+/*!
+   Compute the gradient along X of a region of interest or of a padded image,
+   after applying a gaussian filter along Y.
+   \param I : Input view.
+   \param dIx : Gradient along X, with the size of the view.
+   \param gaussianKernel : Gaussian kernel which values should be computed using vpImageFilter::getGaussianKernel().
+   \param gaussianDerivativeKernel : Gaussian derivative kernel which values should be computed using
+   vpImageFilter::getGaussianDerivativeKernel().
+   \param size : Size of the Gaussian and Gaussian derivative kernels.
+ */
+void vpImageFilter::getGradXGauss2D(const vpImageView<const unsigned char> &I, vpImage<double> &dIx,
+                                    const double *gaussianKernel, const double *gaussianDerivativeKernel,
+                                    unsigned int size)
+{
+  separableFilter(I, dIx, vpFilterPass<double>(false, gaussianKernel, false),
+                  vpFilterPass<double>(true, gaussianDerivativeKernel, true), size);
 }
 
 /*!
@@ -767,15 +1902,54 @@ void vpImageFilter::getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<dou
 void vpImageFilter::getGradYGauss2D(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *gaussianKernel,
                                     const double *gaussianDerivativeKernel, unsigned int size)
 {
-  vpImage<double> GIx;
-  vpImageFilter::filterX(I, GIx, gaussianKernel, size);
-  vpImageFilter::getGradY(GIx, dIy, gaussianDerivativeKernel, size);
+  separableFilter(I, dIy, vpFilterPass<double>(true, gaussianKernel, false),
+                  vpFilterPass<double>(false, gaussianDerivativeKernel, true), size);
 }
 
-// operation pour pyramide gaussienne
+/*!
+   Compute the gradient along Y after applying a gaussian filter along X, the
+   computations being done in single precision.
+   \param I : Input image
+   \param dIy : Gradient along Y.
+   \param gaussianKernel : Gaussian kernel which values should be computed  using vpImageFilter::getGaussianKernel().
+   \param gaussianDerivativeKernel : Gaussian derivative kernel which values should be computed using
+   vpImageFilter::getGaussianDerivativeKernel().
+   \param size : Size of the Gaussian and Gaussian derivative kernels.
+ */
+void vpImageFilter::getGradYGauss2D(const vpImage<unsigned char> &I, vpImage<float> &dIy, const double *gaussianKernel,
+                                    const double *gaussianDerivativeKernel, unsigned int size)
+{
+  const std::vector<float> kernel = toFloatKernel(gaussianKernel, size);
+  const std::vector<float> derivativeKernel = toFloatKernel(gaussianDerivativeKernel, size);
+  separableFilter(I, dIy, vpFilterPass<float>(true, &kernel[0], false),
+                  vpFilterPass<float>(false, &derivativeKernel[0], true), size);
+}
+
+/*!
+   Compute the gradient along Y of a region of interest or of a padded image,
+   after applying a gaussian filter along X.
+   \param I : Input view.
+   \param dIy : Gradient along Y, with the size of the view.
+   \param gaussianKernel : Gaussian kernel which values should be computed using vpImageFilter::getGaussianKernel().
+   \param gaussianDerivativeKernel : Gaussian derivative kernel which values should be computed using
+   vpImageFilter::getGaussianDerivativeKernel().
+   \param size : Size of the Gaussian and Gaussian derivative kernels.
+ */
+void vpImageFilter::getGradYGauss2D(const vpImageView<const unsigned char> &I, vpImage<double> &dIy,
+                                    const double *gaussianKernel, const double *gaussianDerivativeKernel,
+                                    unsigned int size)
+{
+  separableFilter(I, dIy, vpFilterPass<double>(true, gaussianKernel, false),
+                  vpFilterPass<double>(false, gaussianDerivativeKernel, true), size);
+}
+
+/*!
+  Filter the image with the 1-4-6-4-1 Gaussian kernel and halve its size.
+  Without OpenCV the filter is computed on 16-bit integers, rows and columns
+  being processed in one pass.
+ */
 void vpImageFilter::getGaussPyramidal(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI)
 {
-  vpImage<unsigned char> GIx;
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x030000)
   cv::Mat imgsrc, imgdest;
   vpImageConvert::convert(I, imgsrc);
@@ -800,63 +1974,33 @@ void vpImageFilter::getGaussPyramidal(const vpImage<unsigned char> &I, vpImage<u
 // vpImage<unsigned char> sGI;sGI=GI;
 
 #else
-  vpImageFilter::getGaussXPyramidal(I, GIx);
-  vpImageFilter::getGaussYPyramidal(GIx, GI);
+  gaussPyramidal(I, GI, true);
 #endif
 }
 
 void vpImageFilter::getGaussXPyramidal(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI)
 {
-#if 0
-  GI.resize(I.getHeight(),(int)((I.getWidth()+1.)/2.)) ;
-  for (unsigned int i=0 ; i < I.getHeight() ; i++)
-  {
-    GI[i][0]=I[i][0];
-    for (unsigned int j=1 ; j < ((I.getWidth()+1.)/2.)-1 ; j++)
-    {
-      GI[i][j]=vpImageFilter::filterGaussXPyramidal(I,i,2*j);
-    }
-    GI[i][(int)((I.getWidth()+1.)/2.)-1]=I[i][2*((int)((I.getWidth()+1.)/2.)-1)];
+  if (&I == &GI) {
+    const vpImage<unsigned char> I_copy(I);
+    getGaussXPyramidal(I_copy, GI);
+    return;
   }
-#else
-  unsigned int w = I.getWidth() / 2;
 
-  GI.resize(I.getHeight(), w);
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    GI[i][0] = I[i][0];
-    for (unsigned int j = 1; j < w - 1; j++) {
-      GI[i][j] = vpImageFilter::filterGaussXPyramidal(I, i, 2 * j);
-    }
-    GI[i][w - 1] = I[i][2 * w - 1];
+  GI.resize(I.getHeight(), I.getWidth() / 2);
+  if (GI.getSize() == 0) {
+    return;
   }
 
-#endif
+  std::vector<unsigned short> row(GI.getWidth());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    gaussXPyramidalRow(I[i], I.getWidth(), &row[0]);
+    std::copy(row.begin(), row.end(), GI[i]);
+  }
 }
+
 void vpImageFilter::getGaussYPyramidal(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI)
 {
-
-#ifdef ORIG
-  GI.resize((int)((I.getHeight() + 1.) / 2.), I.getWidth());
-  for (unsigned int j = 0; j < I.getWidth(); j++) {
-    GI[0][j] = I[0][j];
-    for (unsigned int i = 1; i < ((I.getHeight() + 1.) / 2.) - 1; i++) {
-      GI[i][j] = vpImageFilter::filterGaussYPyramidal(I, 2 * i, j);
-    }
-    GI[(int)((I.getHeight() + 1.) / 2.) - 1][j] = I[2 * ((int)((I.getHeight() + 1.) / 2.) - 1)][j];
-  }
-
-#else
-  unsigned int h = I.getHeight() / 2;
-
-  GI.resize(h, I.getWidth());
-  for (unsigned int j = 0; j < I.getWidth(); j++) {
-    GI[0][j] = I[0][j];
-    for (unsigned int i = 1; i < h - 1; i++) {
-      GI[i][j] = vpImageFilter::filterGaussYPyramidal(I, 2 * i, j);
-    }
-    GI[h - 1][j] = I[2 * h - 1][j];
-  }
-#endif
+  gaussPyramidal(I, GI, false);
 }
 
 /*!
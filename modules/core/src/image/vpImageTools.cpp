@@ -39,6 +39,7 @@
 #include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpThreadPool.h>
 
 #if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
 #include <emmintrin.h>
@@ -799,7 +800,7 @@ void vpImageTools::extract(const vpImage<unsigned char> &Src, vpImage<double> &D
   \param I_score : Output template matching score.
   \param step_u : Step in u-direction to speed-up the computation.
   \param step_v : Step in v-direction to speed-up the computation.
-  \param useOptimized : Use optimized version (SSE, OpenMP, integral images, ...) if true and available.
+  \param useOptimized : Use optimized version (SSE, multi-threading, integral images, ...) if true and available.
 */
 void vpImageTools::templateMatching(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
                                     vpImage<double> &I_score, unsigned int step_u, unsigned int step_v,
@@ -841,28 +842,18 @@ void vpImageTools::templateMatching(const vpImage<unsigned char> &I, const vpIma
       I_tpl_double.bitmap[cpt] -= mean2;
     }
 
-#if defined _OPENMP && _OPENMP >= 200711 // OpenMP 3.1
-#pragma omp parallel for schedule(dynamic)
-    for (unsigned int i = 0; i < I.getHeight() - height_tpl; i += step_v) {
-      for (unsigned int j = 0; j < I.getWidth() - width_tpl; j += step_u) {
-        I_score[i][j] = normalizedCorrelation(I_double, I_tpl_double, II, IIsq, II_tpl, IIsq_tpl, i, j);
-      }
-    }
+    // Rows of the score image are processed in parallel
+    const int nbRows = static_cast<int>((I_score.getHeight() + step_v - 1) / step_v);
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+    vpThreadPool::getGlobalInstance().parallelFor(0, nbRows, [&](int start, int end) {
+      templateMatchingRows(I_double, I_tpl_double, II, IIsq, II_tpl, IIsq_tpl, I_score, step_u, step_v, start, end);
+    });
 #else
-    // error C3016: 'i': index variable in OpenMP 'for' statement must have signed integral type
-    int end = (int)((I.getHeight() - height_tpl) / step_v) + 1;
-    std::vector<unsigned int> vec_step_v((size_t)end);
-    for (unsigned int cpt = 0, idx = 0; cpt < I.getHeight() - height_tpl; cpt += step_v, idx++) {
-      vec_step_v[(size_t)idx] = cpt;
-    }
 #if defined _OPENMP // only to disable warning: ignoring #pragma omp parallel [-Wunknown-pragmas]
 #pragma omp parallel for schedule(dynamic)
 #endif
-    for (int cpt = 0; cpt < end; cpt++) {
-      for (unsigned int j = 0; j < I.getWidth() - width_tpl; j += step_u) {
-        I_score[vec_step_v[cpt]][j] =
-            normalizedCorrelation(I_double, I_tpl_double, II, IIsq, II_tpl, IIsq_tpl, vec_step_v[cpt], j);
-      }
+    for (int cpt = 0; cpt < nbRows; cpt++) {
+      templateMatchingRows(I_double, I_tpl_double, II, IIsq, II_tpl, IIsq_tpl, I_score, step_u, step_v, cpt, cpt + 1);
     }
 #endif
   } else {
@@ -879,6 +870,20 @@ void vpImageTools::templateMatching(const vpImage<unsigned char> &I, const vpIma
   }
 }
 
+void vpImageTools::templateMatchingRows(const vpImage<double> &I, const vpImage<double> &I_tpl,
+                                        const vpImage<double> &II, const vpImage<double> &IIsq,
+                                        const vpImage<double> &II_tpl, const vpImage<double> &IIsq_tpl,
+                                        vpImage<double> &I_score, unsigned int step_u, unsigned int step_v,
+                                        int rowStart, int rowEnd)
+{
+  for (int cpt = rowStart; cpt < rowEnd; cpt++) {
+    const unsigned int i = static_cast<unsigned int>(cpt) * step_v;
+    for (unsigned int j = 0; j < I_score.getWidth(); j += step_u) {
+      I_score[i][j] = normalizedCorrelation(I, I_tpl, II, IIsq, II_tpl, IIsq_tpl, i, j);
+    }
+  }
+}
+
 // Reference:
 // http://blog.demofox.org/2015/08/15/resizing-images-with-bicubic-interpolation/
 // t is a value that goes from 0 to 1 to interpolate in a C1 continuous way
@@ -991,10 +996,54 @@ void vpImageTools::remap(const vpImage<unsigned char> &I, const vpArray2D<int> &
 {
   Iundist.resize(I.getHeight(), I.getWidth());
 
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(I.getHeight()), [&](int start, int end) {
+    remapRows(I, mapU, mapV, mapDu, mapDv, Iundist, start, end);
+  });
+#else
+#if defined _OPENMP // only to disable warning: ignoring #pragma omp parallel [-Wunknown-pragmas]
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int i = 0; i < static_cast<int>(I.getHeight()); i++) {
+    remapRows(I, mapU, mapV, mapDu, mapDv, Iundist, i, i + 1);
+  }
+#endif
+}
+
+/*!
+  Apply the transformation map to the image.
+
+  \param I : Input color image.
+  \param mapU : Map that contains at each destination coordinate the u-coordinate in the source image.
+  \param mapV : Map that contains at each destination coordinate the v-coordinate in the source image.
+  \param mapDu : Map that contains at each destination coordinate the \f$ \Delta u \f$ for the interpolation.
+  \param mapDv : Map that contains at each destination coordinate the \f$ \Delta v \f$ for the interpolation.
+  \param Iundist : Output transformed color image.
+*/
+void vpImageTools::remap(const vpImage<vpRGBa> &I, const vpArray2D<int> &mapU, const vpArray2D<int> &mapV,
+                         const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv, vpImage<vpRGBa> &Iundist)
+{
+  Iundist.resize(I.getHeight(), I.getWidth());
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(I.getHeight()), [&](int start, int end) {
+    remapRows(I, mapU, mapV, mapDu, mapDv, Iundist, start, end);
+  });
+#else
 #if defined _OPENMP // only to disable warning: ignoring #pragma omp parallel [-Wunknown-pragmas]
 #pragma omp parallel for schedule(dynamic)
 #endif
-  for (int i_ = 0; i_ < static_cast<int>(I.getHeight()); i_++) {
+  for (int i = 0; i < static_cast<int>(I.getHeight()); i++) {
+    remapRows(I, mapU, mapV, mapDu, mapDv, Iundist, i, i + 1);
+  }
+#endif
+}
+
+void vpImageTools::remapRows(const vpImage<unsigned char> &I, const vpArray2D<int> &mapU, const vpArray2D<int> &mapV,
+                             const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv,
+                             vpImage<unsigned char> &Iundist, int rowStart, int rowEnd)
+{
+  for (int i_ = rowStart; i_ < rowEnd; i_++) {
     const unsigned int i = static_cast<unsigned int>(i_);
     for (unsigned int j = 0; j < I.getWidth(); j++) {
 
@@ -1019,21 +1068,10 @@ void vpImageTools::remap(const vpImage<unsigned char> &I, const vpArray2D<int> &
   }
 }
 
-/*!
-  Apply the transformation map to the image.
-
-  \param I : Input color image.
-  \param mapU : Map that contains at each destination coordinate the u-coordinate in the source image.
-  \param mapV : Map that contains at each destination coordinate the v-coordinate in the source image.
-  \param mapDu : Map that contains at each destination coordinate the \f$ \Delta u \f$ for the interpolation.
-  \param mapDv : Map that contains at each destination coordinate the \f$ \Delta v \f$ for the interpolation.
-  \param Iundist : Output transformed color image.
-*/
-void vpImageTools::remap(const vpImage<vpRGBa> &I, const vpArray2D<int> &mapU, const vpArray2D<int> &mapV,
-                         const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv, vpImage<vpRGBa> &Iundist)
+void vpImageTools::remapRows(const vpImage<vpRGBa> &I, const vpArray2D<int> &mapU, const vpArray2D<int> &mapV,
+                             const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv, vpImage<vpRGBa> &Iundist,
+                             int rowStart, int rowEnd)
 {
-  Iundist.resize(I.getHeight(), I.getWidth());
-
   bool checkSSE2 = vpCPUFeatures::checkSSE2();
 #if !VISP_HAVE_SSE2
   checkSSE2 = false;
@@ -1041,10 +1079,7 @@ void vpImageTools::remap(const vpImage<vpRGBa> &I, const vpArray2D<int> &mapU, c
 
   if (checkSSE2) {
 #if defined VISP_HAVE_SSE2
-#if defined _OPENMP // only to disable warning: ignoring #pragma omp parallel [-Wunknown-pragmas]
-#pragma omp parallel for schedule(dynamic)
-#endif
-    for (int i_ = 0; i_ < static_cast<int>(I.getHeight()); i_++) {
+    for (int i_ = rowStart; i_ < rowEnd; i_++) {
       const unsigned int i = static_cast<unsigned int>(i_);
       for (unsigned int j = 0; j < I.getWidth(); j++) {
 
@@ -1094,10 +1129,7 @@ void vpImageTools::remap(const vpImage<vpRGBa> &I, const vpArray2D<int> &mapU, c
     }
 #endif
   } else {
-#if defined _OPENMP // only to disable warning: ignoring #pragma omp parallel [-Wunknown-pragmas]
-#pragma omp parallel for schedule(dynamic)
-#endif
-    for (int i_ = 0; i_ < static_cast<int>(I.getHeight()); i_++) {
+    for (int i_ = rowStart; i_ < rowEnd; i_++) {
       const unsigned int i = static_cast<unsigned int>(i_);
       for (unsigned int j = 0; j < I.getWidth(); j++) {
 
@@ -1141,6 +1173,106 @@ void vpImageTools::remap(const vpImage<vpRGBa> &I, const vpArray2D<int> &mapU, c
   }
 }
 
+void vpImageTools::resizeBilinearFixedPointRows(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                                                int rowStart, int rowEnd)
+{
+  const int32_t precision = 1 << 16;
+  int64_t scaleY = static_cast<int64_t>((I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1) * precision);
+  int64_t scaleX = static_cast<int64_t>((I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1) * precision);
+
+  for (int i = rowStart; i < rowEnd; i++) {
+    int64_t v = i * scaleY;
+    int64_t vround = v & (~0xFFFF);
+    int64_t rratio = v - vround;
+    int64_t y_ = v >> 16;
+    int64_t rfrac = precision - rratio;
+
+    for (unsigned int j = 0; j < Ires.getWidth(); j++) {
+      int64_t u = j * scaleX;
+      int64_t uround = u & (~0xFFFF);
+      int64_t cratio = u - uround;
+      int64_t x_ = u >> 16;
+      int64_t cfrac = precision - cratio;
+
+      if (y_ + 1 < static_cast<int64_t>(I.getHeight()) && x_ + 1 < static_cast<int64_t>(I.getWidth())) {
+        uint16_t up = vpEndian::reinterpret_cast_uchar_to_uint16_LE(I.bitmap + y_ * I.getWidth() + x_);
+        uint16_t down = vpEndian::reinterpret_cast_uchar_to_uint16_LE(I.bitmap + (y_ + 1) * I.getWidth() + x_);
+
+        Ires[i][j] = static_cast<unsigned char>((((up & 0x00FF) * rfrac + (down & 0x00FF) * rratio) * cfrac +
+                                                ((up >> 8) * rfrac + (down >> 8) * rratio) * cratio) >> 32);
+      } else if (y_ + 1 < static_cast<int64_t>(I.getHeight())) {
+        Ires[i][j] = static_cast<unsigned char>(((*(I.bitmap + y_ * I.getWidth() + x_)
+                                                * rfrac + *(I.bitmap + (y_ + 1) * I.getWidth() + x_) * rratio)) >> 16);
+      } else if (x_ + 1 < static_cast<int64_t>(I.getWidth())) {
+        uint16_t up = vpEndian::reinterpret_cast_uchar_to_uint16_LE(I.bitmap + y_ * I.getWidth() + x_);
+        Ires[i][j] = static_cast<unsigned char>(((up & 0x00FF) * cfrac + (up >> 8) * cratio) >> 16);
+      } else {
+        Ires[i][j] = *(I.bitmap + y_ * I.getWidth() + x_);
+      }
+    }
+  }
+}
+
+void vpImageTools::resizeBilinearFixedPointRows(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires, int rowStart,
+                                                int rowEnd)
+{
+  const int32_t precision = 1 << 16;
+  int64_t scaleY = static_cast<int64_t>((I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1) * precision);
+  int64_t scaleX = static_cast<int64_t>((I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1) * precision);
+
+  for (int i = rowStart; i < rowEnd; i++) {
+    int64_t v = i * scaleY;
+    int64_t vround = v & (~0xFFFF);
+    int64_t rratio = v - vround;
+    int64_t y_ = v >> 16;
+    int64_t rfrac = precision - rratio;
+
+    for (unsigned int j = 0; j < Ires.getWidth(); j++) {
+      int64_t u = j * scaleX;
+      int64_t uround = u & (~0xFFFF);
+      int64_t cratio = u - uround;
+      int64_t x_ = u >> 16;
+      int64_t cfrac = precision - cratio;
+
+      if (y_ + 1 < static_cast<int64_t>(I.getHeight()) && x_ + 1 < static_cast<int64_t>(I.getWidth())) {
+        int64_t col0 = lerp2((I.bitmap + y_ * I.getWidth() + x_)->R, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->R, rratio, rfrac);
+        int64_t col1 = lerp2((I.bitmap + y_ * I.getWidth() + x_ + 1)->R, (I.bitmap + (y_ + 1) * I.getWidth() + x_ + 1)->R, rratio, rfrac);
+        int64_t valueR = lerp2(col0, col1, cratio, cfrac);
+
+        col0 = lerp2((I.bitmap + y_ * I.getWidth() + x_)->G, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->G, rratio, rfrac);
+        col1 = lerp2((I.bitmap + y_ * I.getWidth() + x_ + 1)->G, (I.bitmap + (y_ + 1) * I.getWidth() + x_ + 1)->G, rratio, rfrac);
+        int64_t valueG = lerp2(col0, col1, cratio, cfrac);
+
+        col0 = lerp2((I.bitmap + y_ * I.getWidth() + x_)->B, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->B, rratio, rfrac);
+        col1 = lerp2((I.bitmap + y_ * I.getWidth() + x_ + 1)->B, (I.bitmap + (y_ + 1) * I.getWidth() + x_ + 1)->B, rratio, rfrac);
+        int64_t valueB = lerp2(col0, col1, cratio, cfrac);
+
+        Ires[i][j] = vpRGBa(static_cast<unsigned char>(valueR >> 32),
+                            static_cast<unsigned char>(valueG >> 32),
+                            static_cast<unsigned char>(valueB >> 32));
+      } else if (y_ + 1 < static_cast<int64_t>(I.getHeight())) {
+        int64_t valueR = lerp2((I.bitmap + y_ * I.getWidth() + x_)->R, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->R, rratio, rfrac);
+        int64_t valueG = lerp2((I.bitmap + y_ * I.getWidth() + x_)->G, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->G, rratio, rfrac);
+        int64_t valueB = lerp2((I.bitmap + y_ * I.getWidth() + x_)->B, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->B, rratio, rfrac);
+
+        Ires[i][j] = vpRGBa(static_cast<unsigned char>(valueR >> 16),
+                            static_cast<unsigned char>(valueG >> 16),
+                            static_cast<unsigned char>(valueB >> 16));
+      } else if (x_ + 1 < static_cast<int64_t>(I.getWidth())) {
+        int64_t valueR = lerp2((I.bitmap + x_)->R, (I.bitmap + x_ + 1)->R, cratio, cfrac);
+        int64_t valueG = lerp2((I.bitmap + x_)->G, (I.bitmap + x_ + 1)->G, cratio, cfrac);
+        int64_t valueB = lerp2((I.bitmap + x_)->B, (I.bitmap + x_ + 1)->B, cratio, cfrac);
+
+        Ires[i][j] = vpRGBa(static_cast<unsigned char>(valueR >> 16),
+                            static_cast<unsigned char>(valueG >> 16),
+                            static_cast<unsigned char>(valueB >> 16));
+      } else {
+        Ires[i][j] = *(I.bitmap + y_ * I.getWidth() + x_);
+      }
+    }
+  }
+}
+
 bool vpImageTools::checkFixedPoint(unsigned int x, unsigned int y, const vpMatrix &T, bool affine)
 {
   double a0 = T[0][0];  double a1 = T[0][1];  double a2 = T[0][2];
@@ -41,21 +41,89 @@
   \file vpRobust.cpp
 */
 
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpMath.h>
 
-#include <cmath>  // std::fabs
-#include <limits> // numeric_limits
+#include <algorithm> // std::nth_element
+#include <cmath>     // std::fabs
+#include <limits>    // numeric_limits
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <visp3/core/vpRobust.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
 #define vpITMAX 100
 #define vpEPS 3.0e-7
 #define vpCST 1
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Map the bits of a double to an unsigned integer with the same ordering
+inline uint64_t vp_doubleToKey(uint64_t bits)
+{
+  return (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
+}
+
+inline double vp_keyToDouble(uint64_t key)
+{
+  uint64_t bits = (key & 0x8000000000000000ULL) ? (key & ~0x8000000000000000ULL) : ~key;
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/*
+  Select the k-th smallest value of a with a radix selection: the histogram
+  of 11 bits digits of the values, from the most significant one, gives the
+  digit of the k-th value. The values that share this digit are moved at the
+  beginning of the array before the next digit is considered. Contrary to a
+  quickselect, the passes over the data are free of unpredictable branches.
+  The array is used as storage for the keys and its content is lost.
+*/
+double vp_radixSelect(double *a, unsigned int n, unsigned int k)
+{
+  uint64_t *keys = reinterpret_cast<uint64_t *>(a);
+  for (unsigned int i = 0; i < n; i++) {
+    uint64_t bits;
+    memcpy(&bits, a + i, sizeof(bits));
+    keys[i] = vp_doubleToKey(bits);
+  }
+
+  unsigned int count[2048];
+  int shift = 64;
+  while (n > 64 && shift > 0) {
+    shift = std::max(shift - 11, 0);
+    memset(count, 0, sizeof(count));
+    for (unsigned int i = 0; i < n; i++) {
+      count[(keys[i] >> shift) & 0x7FF]++;
+    }
+    uint64_t digit = 0;
+    while (k >= count[digit]) {
+      k -= count[digit];
+      digit++;
+    }
+    unsigned int m = 0;
+    for (unsigned int i = 0; i < n; i++) {
+      keys[m] = keys[i];
+      m += (((keys[i] >> shift) & 0x7FF) == digit) ? 1 : 0;
+    }
+    n = m;
+  }
+  std::nth_element(keys, keys + k, keys + n);
+  return vp_keyToDouble(keys[k]);
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 // ===================================================================
 /*!
   \brief Constructor.
@@ -63,7 +131,7 @@
 
 */
 vpRobust::vpRobust(unsigned int n_data)
-  : normres(), sorted_normres(), sorted_residues(), NoiseThreshold(0.0017), sig_prev(0), it(0), swap(0), size(n_data)
+  : normres(), sorted_normres(), sorted_residues(), NoiseThreshold(0.0017), sig_prev(0), it(0), size(n_data)
 {
   vpCDEBUG(2) << "vpRobust constructor reached" << std::endl;
 
@@ -77,7 +145,7 @@ vpRobust::vpRobust(unsigned int n_data)
   Default constructor.
 */
 vpRobust::vpRobust()
-  : normres(), sorted_normres(), sorted_residues(), NoiseThreshold(0.0017), sig_prev(0), it(0), swap(0), size(0)
+  : normres(), sorted_normres(), sorted_residues(), NoiseThreshold(0.0017), sig_prev(0), it(0), size(0)
 {
 }
 
@@ -97,7 +165,6 @@ vpRobust &vpRobust::operator=(const vpRobust &other)
   NoiseThreshold = other.NoiseThreshold;
   sig_prev = other.sig_prev;
   it = other.it;
-  swap = other.swap;
   size = other.size;
   return *this;
 }
@@ -114,7 +181,6 @@ vpRobust &vpRobust::operator=(const vpRobust &&other)
   NoiseThreshold = std::move(other.NoiseThreshold);
   sig_prev = std::move(other.sig_prev);
   it = std::move(other.it);
-  swap = std::move(other.swap);
   size = std::move(other.size);
   return *this;
 }
@@ -175,7 +241,6 @@ void vpRobust::resize(unsigned int n_data)
 // ===================================================================
 void vpRobust::MEstimator(const vpRobustEstimatorType method, const vpColVector &residues, vpColVector &weights)
 {
-
   double med = 0;        // median
   double normmedian = 0; // Normalized median
   double sigma = 0;      // Standard Deviation
@@ -183,20 +248,23 @@ void vpRobust::MEstimator(const vpRobustEstimatorType method, const vpColVector
   // resize vector only if the size of residue vector has changed
   unsigned int n_data = residues.getRows();
   resize(n_data);
-
-  sorted_residues = residues;
+  if (n_data == 0) {
+    return;
+  }
 
   unsigned int ind_med = (unsigned int)(ceil(n_data / 2.0)) - 1;
 
   // Calculate median
+  memcpy(sorted_residues.data, residues.data, n_data * sizeof(double));
   med = select(sorted_residues, 0, (int)n_data - 1, (int)ind_med /*(int)n_data/2*/);
   // residualMedian = med ;
 
   // Normalize residues
   for (unsigned int i = 0; i < n_data; i++) {
     normres[i] = (fabs(residues[i] - med));
-    sorted_normres[i] = (fabs(sorted_residues[i] - med));
   }
+  // The MAD is selected in a copy, normres has to keep the order of the weights
+  memcpy(sorted_normres.data, normres.data, n_data * sizeof(double));
 
   // Calculate MAD
   normmedian = select(sorted_normres, 0, (int)n_data - 1, (int)ind_med /*(int)n_data/2*/);
@@ -281,25 +349,16 @@ double vpRobust::computeNormalizedMedian(vpColVector &all_normres, const vpColVe
   // resize vector only if the size of residue vector has changed
   resize(n_data);
 
-  sorted_residues = residues;
-  vpColVector no_null_weight_residues;
-  no_null_weight_residues.resize(n_data);
-
-  // all_normres.resize(n_all_data); // Normalized Residue
-  // vpColVector sorted_normres(n_data); // Normalized Residue
-  // vpColVector sorted_residues = residues;
-  // vpColVector sorted_residues;
-
+  // Keep the residues with a non null weight
   unsigned int index = 0;
   for (unsigned int j = 0; j < n_data; j++) {
     // if(weights[j]!=0)
     if (std::fabs(weights[j]) > std::numeric_limits<double>::epsilon()) {
-      no_null_weight_residues[index] = residues[j];
+      sorted_residues[index] = residues[j];
+      sorted_normres[index] = residues[j];
       index++;
     }
   }
-  sorted_residues.resize(index);
-  memcpy(sorted_residues.data, no_null_weight_residues.data, index * sizeof(double));
   n_data = index;
 
   vpCDEBUG(2) << "vpRobust MEstimator reached. No. data = " << n_data << std::endl;
@@ -308,6 +367,9 @@ double vpRobust::computeNormalizedMedian(vpColVector &all_normres, const vpColVe
   // Be careful to not use the rejected residues for the
   // calculation.
 
+  if (n_data == 0) {
+    return 0;
+  }
   unsigned int ind_med = (unsigned int)(ceil(n_data / 2.0)) - 1;
   med = select(sorted_residues, 0, (int)n_data - 1, (int)ind_med /*(int)n_data/2*/);
 
@@ -318,7 +380,7 @@ double vpRobust::computeNormalizedMedian(vpColVector &all_normres, const vpColVe
   }
 
   for (i = 0; i < n_data; i++) {
-    sorted_normres[i] = (fabs(sorted_residues[i] - med));
+    sorted_normres[i] = (fabs(sorted_normres[i] - med));
   }
   // MAD calculated only on first iteration
 
@@ -346,13 +408,18 @@ vpColVector vpRobust::simultMEstimator(vpColVector &residues)
 
   unsigned int n_data = residues.getRows();
   vpColVector norm_res(n_data); // Normalized Residue
-  vpColVector w(n_data);
+  vpColVector w(n_data, 1);
+  if (n_data == 0) {
+    return w;
+  }
+  resize(n_data);
 
   vpCDEBUG(2) << "vpRobust MEstimator reached. No. data = " << n_data << std::endl;
 
-  // Calculate Median
+  // Calculate Median on a copy to keep the order of the residues
   unsigned int ind_med = (unsigned int)(ceil(n_data / 2.0)) - 1;
-  med = select(residues, 0, (int)n_data - 1, (int)ind_med /*(int)n_data/2*/);
+  memcpy(sorted_residues.data, residues.data, n_data * sizeof(double));
+  med = select(sorted_residues, 0, (int)n_data - 1, (int)ind_med /*(int)n_data/2*/);
 
   // Normalize residues
   for (unsigned int i = 0; i < n_data; i++)
@@ -362,7 +429,8 @@ vpColVector vpRobust::simultMEstimator(vpColVector &residues)
   // For Huber compute Simultaneous scale estimate
   // For Others use MAD calculated on first iteration
   if (it == 0) {
-    double normmedian = select(norm_res, 0, (int)n_data - 1, (int)ind_med /*(int)n_data/2*/); // Normalized Median
+    memcpy(sorted_normres.data, norm_res.data, n_data * sizeof(double));
+    double normmedian = select(sorted_normres, 0, (int)n_data - 1, (int)ind_med /*(int)n_data/2*/); // Normalized Median
     // 1.48 keeps scale estimate consistent for a normal probability dist.
     sigma = 1.4826 * normmedian; // Median Absolute Deviation
   } else {
@@ -526,6 +594,10 @@ double vpRobust::simult_chi_huber(double x)
 /*!
   \brief calculation of Tukey's influence function
 
+  The weights of two residues are computed at once with SSE2 when available.
+  The operations are the same as in the scalar code, so that the weights do
+  not depend on the instruction set.
+
   \param sigma : sigma parameters
   \param x : normalized residue vector
   \param weights : weight vector
@@ -533,18 +605,40 @@ double vpRobust::simult_chi_huber(double x)
 
 void vpRobust::psiTukey(double sig, vpColVector &x, vpColVector &weights)
 {
-
   unsigned int n_data = x.getRows();
   double cst_const = vpCST * 4.6851;
+  unsigned int i = 0;
 
-  for (unsigned int i = 0; i < n_data; i++) {
-    // if(sig==0 && weights[i]!=0)
-    if (std::fabs(sig) <= std::numeric_limits<double>::epsilon() &&
-        std::fabs(weights[i]) > std::numeric_limits<double>::epsilon()) {
-      weights[i] = 1;
-      continue;
+  // if(sig==0)
+  if (std::fabs(sig) <= std::numeric_limits<double>::epsilon()) {
+    for (; i < n_data; i++) {
+      // Points already rejected remain rejected
+      weights[i] = (std::fabs(weights[i]) > std::numeric_limits<double>::epsilon()) ? 1 : 0;
     }
+    return;
+  }
 
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2() && n_data >= 2) {
+    const __m128d sig_128 = _mm_set1_pd(sig);
+    const __m128d cst_128 = _mm_set1_pd(cst_const);
+    const __m128d eps_128 = _mm_set1_pd(std::numeric_limits<double>::epsilon());
+    const __m128d one_128 = _mm_set1_pd(1.0);
+    const __m128d sign_mask = _mm_set1_pd(-0.0);
+    for (; i <= n_data - 2; i += 2) {
+      __m128d xi_sig = _mm_div_pd(_mm_loadu_pd(x.data + i), sig_128);
+      __m128d w = _mm_loadu_pd(weights.data + i);
+      // Inliers among the points that are not already rejected
+      __m128d inlier = _mm_and_pd(_mm_cmple_pd(_mm_andnot_pd(sign_mask, xi_sig), cst_128),
+                                  _mm_cmpgt_pd(_mm_andnot_pd(sign_mask, w), eps_128));
+      __m128d r = _mm_div_pd(xi_sig, cst_128);
+      __m128d u = _mm_sub_pd(one_128, _mm_mul_pd(r, r));
+      _mm_storeu_pd(weights.data + i, _mm_and_pd(inlier, _mm_mul_pd(u, u)));
+    }
+  }
+#endif
+
+  for (; i < n_data; i++) {
     double xi_sig = x[i] / sig;
 
     // if((fabs(xi_sig)<=(cst_const)) && weights[i]!=0)
@@ -559,7 +653,7 @@ void vpRobust::psiTukey(double sig, vpColVector &x, vpColVector &weights)
 }
 
 /*!
-  \brief calculation of Tukey's influence function
+  \brief calculation of Huber's influence function
 
   \param sigma : sigma parameters
   \param x : normalized residue vector
@@ -569,8 +663,27 @@ void vpRobust::psiHuber(double sig, vpColVector &x, vpColVector &weights)
 {
   double c = 1.2107; // 1.345;
   unsigned int n_data = x.getRows();
+  unsigned int i = 0;
+
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2() && n_data >= 2) {
+    const __m128d sig_128 = _mm_set1_pd(sig);
+    const __m128d c_128 = _mm_set1_pd(c);
+    const __m128d eps_128 = _mm_set1_pd(std::numeric_limits<double>::epsilon());
+    const __m128d one_128 = _mm_set1_pd(1.0);
+    const __m128d sign_mask = _mm_set1_pd(-0.0);
+    for (; i <= n_data - 2; i += 2) {
+      __m128d w = _mm_loadu_pd(weights.data + i);
+      __m128d active = _mm_cmpgt_pd(_mm_andnot_pd(sign_mask, w), eps_128);
+      __m128d abs_xi_sig = _mm_andnot_pd(sign_mask, _mm_div_pd(_mm_loadu_pd(x.data + i), sig_128));
+      __m128d inlier = _mm_cmple_pd(abs_xi_sig, c_128);
+      __m128d huber = _mm_or_pd(_mm_and_pd(inlier, one_128), _mm_andnot_pd(inlier, _mm_div_pd(c_128, abs_xi_sig)));
+      _mm_storeu_pd(weights.data + i, _mm_or_pd(_mm_and_pd(active, huber), _mm_andnot_pd(active, w)));
+    }
+  }
+#endif
 
-  for (unsigned int i = 0; i < n_data; i++) {
+  for (; i < n_data; i++) {
     // if(weights[i]!=0)
     if (std::fabs(weights[i]) > std::numeric_limits<double>::epsilon()) {
       double xi_sig = x[i] / sig;
@@ -594,68 +707,44 @@ void vpRobust::psiCauchy(double sig, vpColVector &x, vpColVector &weights)
 {
   unsigned int n_data = x.getRows();
   double const_sig = 2.3849 * sig;
+  unsigned int i = 0;
+
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2() && n_data >= 2) {
+    const __m128d const_sig_128 = _mm_set1_pd(const_sig);
+    const __m128d one_128 = _mm_set1_pd(1.0);
+    for (; i <= n_data - 2; i += 2) {
+      __m128d r = _mm_div_pd(_mm_loadu_pd(x.data + i), const_sig_128);
+      _mm_storeu_pd(weights.data + i, _mm_div_pd(one_128, _mm_add_pd(one_128, _mm_mul_pd(r, r))));
+    }
+  }
+#endif
 
   // Calculate Cauchy's equation
-  for (unsigned int i = 0; i < n_data; i++) {
+  for (; i < n_data; i++) {
     weights[i] = 1 / (1 + vpMath::sqr(x[i] / (const_sig)));
-
-    // If one coordinate is an outlier the other is too!
-    // w[i] < 0.01 is a threshold to be set
-    /*if(w[i] < 0.01)
-      {
-      if(i%2 == 0)
-      {
-      w[i+1] = w[i];
-      i++;
-      }
-      else
-      w[i-1] = w[i];
-      }*/
   }
 }
 
 /*!
-  \brief partition function
-  \param a : vector to be sorted
-  \param l : first value to be considered
-  \param r : last value to be considered
-*/
-int vpRobust::partition(vpColVector &a, int l, int r)
-{
-  int i = l - 1;
-  int j = r;
-  double v = a[(unsigned int)r];
-
-  for (;;) {
-    while (a[(unsigned int)++i] < v)
-      ;
-    while (v < a[(unsigned int)--j])
-      if (j == l)
-        break;
-    if (i >= j)
-      break;
-    exch(a[(unsigned int)i], a[(unsigned int)j]);
-  }
-  exch(a[(unsigned int)i], a[(unsigned int)r]);
-  return i;
-}
+  \brief Select the k-th smallest value of a part of a vector.
 
-/*!
-  \brief sort a part of a vector and select a value of this new vector
-  \param a : vector to be sorted
+  Small vectors are handled by std::nth_element() (introselect) that avoids
+  the quadratic worst case of a plain quickselect. Large vectors are handled
+  by a radix selection that makes a few passes over the data. Both return the
+  exact k-th value.
+
+  \param a : vector used as scratch storage, its content is lost
   \param l : first value to be considered
   \param r : last value to be considered
   \param k : value to be selected
 */
 double vpRobust::select(vpColVector &a, int l, int r, int k)
 {
-  while (r > l) {
-    int i = partition(a, l, r);
-    if (i >= k)
-      r = i - 1;
-    if (i <= k)
-      l = i + 1;
+  if (r - l + 1 >= 1024) {
+    return vp_radixSelect(a.data + l, (unsigned int)(r - l + 1), (unsigned int)(k - l));
   }
+  std::nth_element(a.data + l, a.data + k, a.data + r + 1);
   return a[(unsigned int)k];
 }
 
@@ -38,6 +38,7 @@
  *****************************************************************************/
 
 #include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpFixedRotationMatrix.h>
 
 /*!
 
@@ -77,112 +78,69 @@ vpHomogeneousMatrix vpExponentialMap::direct(const vpColVector &v) { return vpEx
   \sa inverse(const vpHomogeneousMatrix &, const double &)
 */
 vpHomogeneousMatrix vpExponentialMap::direct(const vpColVector &v, const double &delta_t)
+{
+  vpHomogeneousMatrix Delta;
+  direct(v, delta_t, Delta);
+
+  return Delta;
+}
+
+/*!
+
+  Compute the exponential map without allocating memory. This is the
+  function to use in control or estimation loops where \e M is reused
+  between iterations.
+
+  \param v : Instantaneous velocity skew represented by a 6 dimension
+  vector \f$ {\bf v} = [v, \omega] \f$ where \f$ v \f$ is a translation
+  velocity vector and \f$ \omega \f$ is a rotation velocity vector.
+
+  \param delta_t : Sampling time \f$ \Delta t \f$. Time during which the
+  velocity \f$ \bf v \f$ is applied.
+
+  \param M : Homogeneous matrix \f${\bf M} = \exp{({\bf v})} \f$ updated
+  with the displacement of the object when the velocity \f$ \bf v \f$ is
+  applied during \f$\Delta t\f$ seconds.
+
+  \sa direct(const vpColVector &, const double &)
+*/
+void vpExponentialMap::direct(const vpColVector &v, const double &delta_t, vpHomogeneousMatrix &M)
 {
   if (v.size() != 6) {
     throw(vpException(vpException::dimensionError,
                       "Cannot compute direct exponential map from a %d-dim velocity vector. Should be 6-dim.",
                       v.size()));
   }
-  double theta, si, co, sinc, mcosc, msinc;
-  vpThetaUVector u;
-  vpRotationMatrix rd;
-  vpTranslationVector dt;
-
-  vpColVector v_dt = v * delta_t;
-
-  u[0] = v_dt[3];
-  u[1] = v_dt[4];
-  u[2] = v_dt[5];
-  rd.buildFrom(u);
-
-  theta = sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
-  si = sin(theta);
-  co = cos(theta);
-  sinc = vpMath::sinc(si, theta);
-  mcosc = vpMath::mcosc(co, theta);
-  msinc = vpMath::msinc(si, theta);
+  const double v_dt[6] = {v[0] * delta_t, v[1] * delta_t, v[2] * delta_t,
+                          v[3] * delta_t, v[4] * delta_t, v[5] * delta_t};
+  const vpFixedThetaUVector u(v_dt[3], v_dt[4], v_dt[5]);
+  const vpFixedRotationMatrix rd(u);
+
+  const double theta = u.getTheta();
+  const double si = sin(theta);
+  const double co = cos(theta);
+  const double sinc = vpMath::sinc(si, theta);
+  const double mcosc = vpMath::mcosc(co, theta);
+  const double msinc = vpMath::msinc(si, theta);
+
+  double *m = M.data;
+  for (unsigned int i = 0; i < 3; i++) {
+    m[4 * i] = rd[i][0];
+    m[4 * i + 1] = rd[i][1];
+    m[4 * i + 2] = rd[i][2];
+  }
 
-  dt[0] = v_dt[0] * (sinc + u[0] * u[0] * msinc) + v_dt[1] * (u[0] * u[1] * msinc - u[2] * mcosc) +
-          v_dt[2] * (u[0] * u[2] * msinc + u[1] * mcosc);
+  m[3] = v_dt[0] * (sinc + u[0] * u[0] * msinc) + v_dt[1] * (u[0] * u[1] * msinc - u[2] * mcosc) +
+         v_dt[2] * (u[0] * u[2] * msinc + u[1] * mcosc);
 
-  dt[1] = v_dt[0] * (u[0] * u[1] * msinc + u[2] * mcosc) + v_dt[1] * (sinc + u[1] * u[1] * msinc) +
-          v_dt[2] * (u[1] * u[2] * msinc - u[0] * mcosc);
+  m[7] = v_dt[0] * (u[0] * u[1] * msinc + u[2] * mcosc) + v_dt[1] * (sinc + u[1] * u[1] * msinc) +
+         v_dt[2] * (u[1] * u[2] * msinc - u[0] * mcosc);
 
-  dt[2] = v_dt[0] * (u[0] * u[2] * msinc - u[1] * mcosc) + v_dt[1] * (u[1] * u[2] * msinc + u[0] * mcosc) +
+  m[11] = v_dt[0] * (u[0] * u[2] * msinc - u[1] * mcosc) + v_dt[1] * (u[1] * u[2] * msinc + u[0] * mcosc) +
           v_dt[2] * (sinc + u[2] * u[2] * msinc);
 
-  vpHomogeneousMatrix Delta;
-  Delta.insert(rd);
-  Delta.insert(dt);
-
-  if (0) // test new version wrt old version
-  {
-    // old version
-    unsigned int i, j;
-
-    double s;
-    // double u[3];
-    //  vpRotationMatrix rd ;
-    //  vpTranslationVector dt ;
-
-    s = sqrt(v_dt[3] * v_dt[3] + v_dt[4] * v_dt[4] + v_dt[5] * v_dt[5]);
-    if (s > 1.e-15) {
-      for (i = 0; i < 3; i++)
-        u[i] = v_dt[3 + i] / s;
-      double sinu = sin(s);
-      double cosi = cos(s);
-      double mcosi = 1 - cosi;
-      rd[0][0] = cosi + mcosi * u[0] * u[0];
-      rd[0][1] = -sinu * u[2] + mcosi * u[0] * u[1];
-      rd[0][2] = sinu * u[1] + mcosi * u[0] * u[2];
-      rd[1][0] = sinu * u[2] + mcosi * u[1] * u[0];
-      rd[1][1] = cosi + mcosi * u[1] * u[1];
-      rd[1][2] = -sinu * u[0] + mcosi * u[1] * u[2];
-      rd[2][0] = -sinu * u[1] + mcosi * u[2] * u[0];
-      rd[2][1] = sinu * u[0] + mcosi * u[2] * u[1];
-      rd[2][2] = cosi + mcosi * u[2] * u[2];
-
-      dt[0] = v_dt[0] * (sinu / s + u[0] * u[0] * (1 - sinu / s)) +
-              v_dt[1] * (u[0] * u[1] * (1 - sinu / s) - u[2] * mcosi / s) +
-              v_dt[2] * (u[0] * u[2] * (1 - sinu / s) + u[1] * mcosi / s);
-
-      dt[1] = v_dt[0] * (u[0] * u[1] * (1 - sinu / s) + u[2] * mcosi / s) +
-              v_dt[1] * (sinu / s + u[1] * u[1] * (1 - sinu / s)) +
-              v_dt[2] * (u[1] * u[2] * (1 - sinu / s) - u[0] * mcosi / s);
-
-      dt[2] = v_dt[0] * (u[0] * u[2] * (1 - sinu / s) - u[1] * mcosi / s) +
-              v_dt[1] * (u[1] * u[2] * (1 - sinu / s) + u[0] * mcosi / s) +
-              v_dt[2] * (sinu / s + u[2] * u[2] * (1 - sinu / s));
-    } else {
-      for (i = 0; i < 3; i++) {
-        for (j = 0; j < 3; j++)
-          rd[i][j] = 0.0;
-        rd[i][i] = 1.0;
-        dt[i] = v_dt[i];
-      }
-    }
-    // end old version
-
-    // Test of the new version
-    vpHomogeneousMatrix Delta_old;
-    Delta_old.insert(rd);
-    Delta_old.insert(dt);
-
-    int pb = 0;
-    for (i = 0; i < 4; i++) {
-      for (j = 0; j < 4; j++)
-        if (fabs(Delta[i][j] - Delta_old[i][j]) > 1.e-5)
-          pb = 1;
-    }
-    if (pb == 1) {
-      printf("pb vpHomogeneousMatrix::expMap\n");
-      std::cout << " Delta : " << std::endl << Delta << std::endl;
-      std::cout << " Delta_old : " << std::endl << Delta_old << std::endl;
-    }
-    // end of the test
-  }
-
-  return Delta;
+  m[12] = m[13] = m[14] = 0.;
+  m[15] = 1.;
 }
 
 /*!
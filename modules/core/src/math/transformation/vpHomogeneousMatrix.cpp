@@ -44,6 +44,7 @@
 
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpException.h>
+#include <visp3/core/vpFixedHomogeneousMatrix.h>
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpMatrix.h>
 #include <visp3/core/vpPoint.h>
@@ -467,22 +468,7 @@ int main()
 vpHomogeneousMatrix vpHomogeneousMatrix::operator*(const vpHomogeneousMatrix &M) const
 {
   vpHomogeneousMatrix p;
-
-  vpRotationMatrix R1, R2, R;
-  vpTranslationVector T1, T2, T;
-
-  extract(T1);
-  M.extract(T2);
-
-  extract(R1);
-  M.extract(R2);
-
-  R = R1 * R2;
-
-  T = R1 * T2 + T1;
-
-  p.insert(T);
-  p.insert(R);
+  vpFixedHomogeneousMatrix::compose(data, M.data, p.data);
 
   return p;
 }
@@ -506,7 +492,11 @@ int main()
 */
 vpHomogeneousMatrix &vpHomogeneousMatrix::operator*=(const vpHomogeneousMatrix &M)
 {
-  (*this) = (*this) * M;
+  double p[12];
+  vpFixedHomogeneousMatrix::compose(data, M.data, p);
+  for (unsigned int i = 0; i < 12; i++) {
+    data[i] = p[i];
+  }
   return (*this);
 }
 
@@ -813,17 +803,7 @@ void vpHomogeneousMatrix::insert(const vpQuaternionVector &q) { insert(vpRotatio
 vpHomogeneousMatrix vpHomogeneousMatrix::inverse() const
 {
   vpHomogeneousMatrix Mi;
-
-  vpRotationMatrix R;
-  extract(R);
-  vpTranslationVector T;
-  extract(T);
-
-  vpTranslationVector RtT;
-  RtT = -(R.t() * T);
-
-  Mi.insert(R.t());
-  Mi.insert(RtT);
+  vpFixedHomogeneousMatrix::inverse(data, Mi.data);
 
   return Mi;
 }
@@ -858,7 +838,20 @@ void vpHomogeneousMatrix::eye()
   \right]\f$
 
 */
-void vpHomogeneousMatrix::inverse(vpHomogeneousMatrix &M) const { M = inverse(); }
+void vpHomogeneousMatrix::inverse(vpHomogeneousMatrix &M) const
+{
+  if (&M == this) {
+    double Mi[12];
+    vpFixedHomogeneousMatrix::inverse(data, Mi);
+    for (unsigned int i = 0; i < 12; i++) {
+      M.data[i] = Mi[i];
+    }
+  } else {
+    vpFixedHomogeneousMatrix::inverse(data, M.data);
+  }
+  M[3][0] = M[3][1] = M[3][2] = 0.;
+  M[3][3] = 1.;
+}
 
 /*!
   Write an homogeneous matrix in an output file stream.
@@ -0,0 +1,189 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Organized point cloud with contiguous coordinates.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpPointCloud.cpp
+  \brief Organized point cloud with contiguous coordinates.
+*/
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpPointCloud.h>
+
+/*!
+  Default constructor that creates an empty point cloud.
+*/
+vpPointCloud::vpPointCloud() : m_data(), m_x(NULL), m_y(NULL), m_z(NULL), m_width(0), m_height(0), m_stride(1) {}
+
+/*!
+  Create a point cloud of \e width x \e height points whose coordinates are
+  set to 0.
+*/
+vpPointCloud::vpPointCloud(unsigned int width, unsigned int height)
+  : m_data(), m_x(NULL), m_y(NULL), m_z(NULL), m_width(0), m_height(0), m_stride(1)
+{
+  resize(width, height);
+}
+
+/*!
+  Create a point cloud that wraps existing coordinates without copying them.
+  See wrap().
+*/
+vpPointCloud::vpPointCloud(const float *x, const float *y, const float *z, unsigned int width, unsigned int height,
+                           unsigned int stride)
+  : m_data(), m_x(NULL), m_y(NULL), m_z(NULL), m_width(0), m_height(0), m_stride(1)
+{
+  wrap(x, y, z, width, height, stride);
+}
+
+/*!
+  Copy constructor. The coordinates are always copied, even if \e pointcloud
+  wraps an external buffer.
+*/
+vpPointCloud::vpPointCloud(const vpPointCloud &pointcloud)
+  : m_data(), m_x(NULL), m_y(NULL), m_z(NULL), m_width(0), m_height(0), m_stride(1)
+{
+  *this = pointcloud;
+}
+
+/*!
+  Copy a point cloud stored as a vector of 3D points, for the code that still
+  uses this representation.
+
+  \param pointcloud : Vector of \e width x \e height points, each one being
+  at least 3-dim.
+  \param width : Number of columns of the point cloud.
+  \param height : Number of rows of the point cloud.
+*/
+void vpPointCloud::buildFrom(const std::vector<vpColVector> &pointcloud, unsigned int width, unsigned int height)
+{
+  if (pointcloud.size() != static_cast<size_t>(width) * height) {
+    throw vpException(vpException::dimensionError, "Cannot build a %dx%d point cloud from %d points", width, height,
+                      static_cast<int>(pointcloud.size()));
+  }
+
+  resize(width, height);
+  for (unsigned int i = 0; i < getSize(); i++) {
+    set(i, static_cast<float>(pointcloud[i][0]), static_cast<float>(pointcloud[i][1]),
+        static_cast<float>(pointcloud[i][2]));
+  }
+}
+
+/*!
+  Copy the point cloud into a vector of 4-dim homogeneous points, for the
+  code that still uses this representation.
+*/
+void vpPointCloud::convert(std::vector<vpColVector> &pointcloud) const
+{
+  pointcloud.resize(getSize());
+  for (unsigned int i = 0; i < getSize(); i++) {
+    pointcloud[i].resize(4, false);
+    pointcloud[i][0] = getX(i);
+    pointcloud[i][1] = getY(i);
+    pointcloud[i][2] = getZ(i);
+    pointcloud[i][3] = 1.0;
+  }
+}
+
+/*!
+  Copy operator. The coordinates are always copied, even if \e pointcloud
+  wraps an external buffer.
+*/
+vpPointCloud &vpPointCloud::operator=(const vpPointCloud &pointcloud)
+{
+  if (this != &pointcloud) {
+    resize(pointcloud.getWidth(), pointcloud.getHeight());
+    for (unsigned int i = 0; i < getSize(); i++) {
+      set(i, pointcloud.getX(i), pointcloud.getY(i), pointcloud.getZ(i));
+    }
+  }
+
+  return *this;
+}
+
+/*!
+  Resize the point cloud. Memory is only allocated when the number of points
+  increases, and a point cloud that wrapped an external buffer then owns its
+  coordinates. The coordinates are not initialized when the size is unchanged.
+
+  \param width : Number of columns of the point cloud.
+  \param height : Number of rows of the point cloud.
+*/
+void vpPointCloud::resize(unsigned int width, unsigned int height)
+{
+  const size_t size = static_cast<size_t>(width) * height;
+  if (m_data.size() != 3 * size) {
+    m_data.resize(3 * size);
+  }
+
+  m_width = width;
+  m_height = height;
+  m_stride = 1;
+  if (size > 0) {
+    m_x = &m_data[0];
+    m_y = &m_data[size];
+    m_z = &m_data[2 * size];
+  } else {
+    m_x = m_y = m_z = NULL;
+  }
+}
+
+/*!
+  Wrap existing coordinates without copying them. The buffer must remain
+  valid as long as the point cloud is used.
+
+  \param x : Pointer to the X coordinate of the first point.
+  \param y : Pointer to the Y coordinate of the first point.
+  \param z : Pointer to the Z coordinate of the first point.
+  \param width : Number of columns of the point cloud.
+  \param height : Number of rows of the point cloud.
+  \param stride : Distance in floats between two consecutive coordinates of
+  the same axis: 1 for separate arrays, 3 for interleaved XYZ points, 4 for
+  pcl::PointXYZ points.
+*/
+void vpPointCloud::wrap(const float *x, const float *y, const float *z, unsigned int width, unsigned int height,
+                        unsigned int stride)
+{
+  if (stride == 0) {
+    throw vpException(vpException::badValue, "The stride of a point cloud must be strictly positive");
+  }
+
+  m_data.clear();
+  m_x = x;
+  m_y = y;
+  m_z = z;
+  m_width = width;
+  m_height = height;
+  m_stride = stride;
+}
@@ -45,16 +45,63 @@
 
 */
 
+#include <algorithm>
 #include <stdlib.h>
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpHistogram.h>
 #include <visp3/core/vpImageConvert.h>
 
-#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <visp3/core/vpThreadPool.h>
+#elif defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
 #include <visp3/core/vpThread.h>
+#endif
 
 namespace
 {
+void computeHistogramRange(const unsigned char *bitmap, unsigned int start_index, unsigned int end_index,
+                           const unsigned int *lut, unsigned int *histogram)
+{
+  const unsigned char *ptrStart = bitmap + start_index;
+  const unsigned char *ptrEnd = bitmap + end_index;
+  const unsigned char *ptrCurrent = ptrStart;
+
+  if (end_index - start_index >= 8) {
+    // Unroll loop version
+    for (; ptrCurrent <= ptrEnd - 8;) {
+      histogram[lut[*ptrCurrent]]++;
+      ++ptrCurrent;
+
+      histogram[lut[*ptrCurrent]]++;
+      ++ptrCurrent;
+
+      histogram[lut[*ptrCurrent]]++;
+      ++ptrCurrent;
+
+      histogram[lut[*ptrCurrent]]++;
+      ++ptrCurrent;
+
+      histogram[lut[*ptrCurrent]]++;
+      ++ptrCurrent;
+
+      histogram[lut[*ptrCurrent]]++;
+      ++ptrCurrent;
+
+      histogram[lut[*ptrCurrent]]++;
+      ++ptrCurrent;
+
+      histogram[lut[*ptrCurrent]]++;
+      ++ptrCurrent;
+    }
+  }
+
+  for (; ptrCurrent != ptrEnd; ++ptrCurrent) {
+    histogram[lut[*ptrCurrent]]++;
+  }
+}
+
+#if (VISP_CXX_STANDARD < VISP_CXX_STANDARD_11) &&                                                                     \
+    (defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0)))
 struct Histogram_Param_t {
   unsigned int m_start_index;
   unsigned int m_end_index;
@@ -81,58 +128,13 @@ struct Histogram_Param_t {
 vpThread::Return computeHistogramThread(vpThread::Args args)
 {
   Histogram_Param_t *histogram_param = static_cast<Histogram_Param_t *>(args);
-  unsigned int start_index = histogram_param->m_start_index;
-  unsigned int end_index = histogram_param->m_end_index;
-
-  const vpImage<unsigned char> *I = histogram_param->m_I;
-
-  unsigned char *ptrStart = (unsigned char *)(I->bitmap) + start_index;
-  unsigned char *ptrEnd = (unsigned char *)(I->bitmap) + end_index;
-  unsigned char *ptrCurrent = ptrStart;
-
-  //    while(ptrCurrent != ptrEnd) {
-  //      histogram_param->m_histogram[ histogram_param->m_lut[ *ptrCurrent ]
-  //      ] ++;
-  //      ++ptrCurrent;
-  //    }
-
-  if (end_index - start_index >= 8) {
-    // Unroll loop version
-    for (; ptrCurrent <= ptrEnd - 8;) {
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-    }
-  }
-
-  for (; ptrCurrent != ptrEnd; ++ptrCurrent) {
-    histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-  }
+  computeHistogramRange(histogram_param->m_I->bitmap, histogram_param->m_start_index, histogram_param->m_end_index,
+                        histogram_param->m_lut, histogram_param->m_histogram);
 
   return 0;
 }
-}
 #endif
+}
 
 bool compare_vpHistogramPeak(vpHistogramPeak first, vpHistogramPeak second);
 
@@ -233,7 +235,9 @@ void vpHistogram::init(unsigned size_)
 
   \param I : Gray level image.
   \param nbins : Number of bins to compute the histogram.
-  \param nbThreads : Number of threads to use for the computation.
+  \param nbThreads : Number of threads to use for the computation. When
+  c++11 is enabled, at most \e nbThreads threads of the pool returned by
+  vpThreadPool::getGlobalInstance() are used.
 */
 void vpHistogram::calculate(const vpImage<unsigned char> &I, unsigned int nbins, unsigned int nbThreads)
 {
@@ -253,7 +257,7 @@ void vpHistogram::calculate(const vpImage<unsigned char> &I, unsigned int nbins,
   memset(histogram, 0, size * sizeof(unsigned int));
 
   bool use_single_thread;
-#if !defined(VISP_HAVE_PTHREAD) && !defined(_WIN32)
+#if (VISP_CXX_STANDARD < VISP_CXX_STANDARD_11) && !defined(VISP_HAVE_PTHREAD) && !defined(_WIN32)
   use_single_thread = true;
 #else
   use_single_thread = (nbThreads == 0 || nbThreads == 1);
@@ -270,18 +274,35 @@ void vpHistogram::calculate(const vpImage<unsigned char> &I, unsigned int nbins,
 
   if (use_single_thread) {
     // Single thread
+    computeHistogramRange(I.bitmap, 0, I.getSize(), lut, histogram);
+  } else {
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+    // Multi-threads, each chunk of the image is accumulated in its own
+    // histogram to avoid concurrent writes
+    const unsigned int image_size = I.getSize();
+    vpThreadPool &pool = vpThreadPool::getGlobalInstance();
+    const unsigned int nbChunks = (std::min)(nbThreads, pool.getNbThreads());
+    const unsigned int step = image_size / nbChunks;
+    std::vector<std::vector<unsigned int> > histograms(nbChunks, std::vector<unsigned int>(size, 0));
+
+    pool.parallelFor(0, static_cast<int>(nbChunks), [&](int start, int end) {
+      for (int index = start; index < end; index++) {
+        unsigned int start_index = index * step;
+        unsigned int end_index = (index == static_cast<int>(nbChunks) - 1) ? image_size : (index + 1) * step;
+        computeHistogramRange(I.bitmap, start_index, end_index, lut, histograms[index].data());
+      }
+    }, nbThreads, 1);
 
-    unsigned int size_ = I.getWidth() * I.getHeight();
-    unsigned char *ptrStart = (unsigned char *)I.bitmap;
-    unsigned char *ptrEnd = ptrStart + size_;
-    unsigned char *ptrCurrent = ptrStart;
+    for (unsigned int cpt1 = 0; cpt1 < size; cpt1++) {
+      unsigned int sum = 0;
 
-    while (ptrCurrent != ptrEnd) {
-      histogram[lut[*ptrCurrent]]++;
-      ++ptrCurrent;
+      for (size_t cpt2 = 0; cpt2 < histograms.size(); cpt2++) {
+        sum += histograms[cpt2][cpt1];
+      }
+
+      histogram[cpt1] = sum;
     }
-  } else {
-#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+#elif defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
     // Multi-threads
 
     std::vector<vpThread *> threadpool;
@@ -0,0 +1,369 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Pool of reusable worker threads.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpThreadPool.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+struct vpBatch {
+  vpBatch(const std::vector<std::function<void()> > &tasks_) : tasks(tasks_), remaining(tasks_.size()), error() {}
+
+  const std::vector<std::function<void()> > &tasks;
+  std::atomic<size_t> remaining;
+  std::exception_ptr error;
+};
+
+struct vpTask {
+  vpTask(vpBatch *batch_ = NULL, size_t index_ = 0) : batch(batch_), index(index_) {}
+
+  vpBatch *batch;
+  size_t index;
+};
+
+struct vpTaskQueue {
+  vpTaskQueue() : mutex(), tasks() {}
+
+  std::mutex mutex;
+  std::deque<vpTask> tasks;
+};
+}
+
+class vpThreadPool::Impl
+{
+public:
+  Impl()
+    : m_workers(), m_queues(), m_pending(0), m_mutex(), m_taskAvailable(), m_taskDone(), m_stop(false)
+  {
+  }
+
+  ~Impl()
+  {
+    stop();
+    clearQueues();
+  }
+
+  unsigned int getNbThreads() const { return static_cast<unsigned int>(m_queues.size()); }
+
+  void run(const std::vector<std::function<void()> > &tasks)
+  {
+    if (tasks.empty()) {
+      return;
+    }
+
+    vpBatch batch(tasks);
+    if (m_workers.empty() || tasks.size() == 1) {
+      for (size_t i = 0; i < tasks.size(); i++) {
+        execute(vpTask(&batch, i));
+      }
+    } else {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending += tasks.size();
+      }
+
+      // Tasks are dealt round-robin to the queues, each thread starting on
+      // its own share before stealing from the others
+      for (size_t q = 0; q < m_queues.size(); q++) {
+        std::lock_guard<std::mutex> lock(m_queues[q]->mutex);
+        for (size_t i = q; i < tasks.size(); i += m_queues.size()) {
+          m_queues[q]->tasks.push_back(vpTask(&batch, i));
+        }
+      }
+      m_taskAvailable.notify_all();
+      m_taskDone.notify_all();
+
+      // The calling thread helps the workers until the batch is done
+      while (batch.remaining > 0) {
+        vpTask task;
+        if (pop(0, task)) {
+          execute(task);
+        } else {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          m_taskDone.wait(lock, [this, &batch] { return batch.remaining == 0 || m_pending > 0; });
+        }
+      }
+    }
+
+    if (batch.error) {
+      std::rethrow_exception(batch.error);
+    }
+  }
+
+  void start(unsigned int nbThreads)
+  {
+    stop();
+    clearQueues();
+
+    if (nbThreads == 0) {
+      nbThreads = (std::max)(std::thread::hardware_concurrency(), 1u);
+    }
+
+    m_stop = false;
+    // Queue 0 is shared by the threads that call run(), the other ones belong to the workers
+    for (unsigned int i = 0; i < nbThreads; i++) {
+      m_queues.push_back(new vpTaskQueue);
+    }
+    for (unsigned int i = 1; i < nbThreads; i++) {
+      m_workers.push_back(std::thread(&Impl::workerLoop, this, i));
+    }
+  }
+
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_taskAvailable.notify_all();
+
+    for (size_t i = 0; i < m_workers.size(); i++) {
+      m_workers[i].join();
+    }
+    m_workers.clear();
+  }
+
+private:
+  void clearQueues()
+  {
+    for (size_t i = 0; i < m_queues.size(); i++) {
+      delete m_queues[i];
+    }
+    m_queues.clear();
+  }
+
+  void execute(const vpTask &task)
+  {
+    vpBatch *batch = task.batch;
+    try {
+      batch->tasks[task.index]();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!batch->error) {
+        batch->error = std::current_exception();
+      }
+    }
+
+    // The batch may be destroyed by its owner as soon as the counter reaches 0
+    if (--batch->remaining == 0) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_taskDone.notify_all();
+    }
+  }
+
+  // Pop the most recent task of the own queue, otherwise steal the oldest task of another queue
+  bool pop(size_t index, vpTask &task)
+  {
+    {
+      vpTaskQueue &queue = *m_queues[index];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.tasks.empty()) {
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+        m_pending--;
+        return true;
+      }
+    }
+
+    for (size_t k = 1; k < m_queues.size(); k++) {
+      vpTaskQueue &queue = *m_queues[(index + k) % m_queues.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.tasks.empty()) {
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        m_pending--;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void workerLoop(size_t index)
+  {
+    while (true) {
+      vpTask task;
+      if (pop(index, task)) {
+        execute(task);
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_taskAvailable.wait(lock, [this] { return m_stop || m_pending > 0; });
+      if (m_stop && m_pending == 0) {
+        return; // stop requested and nothing left to do
+      }
+    }
+  }
+
+  std::vector<std::thread> m_workers;
+  std::vector<vpTaskQueue *> m_queues;
+  std::atomic<size_t> m_pending;
+  std::mutex m_mutex;
+  std::condition_variable m_taskAvailable;
+  std::condition_variable m_taskDone;
+  bool m_stop;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Create a pool of threads.
+
+  \param nbThreads : Number of threads used to execute the tasks, including
+  the calling thread. If 0, the number of concurrent threads supported by the
+  hardware is used.
+*/
+vpThreadPool::vpThreadPool(unsigned int nbThreads) : m_impl(new Impl)
+{
+  m_impl->start(nbThreads);
+}
+
+/*!
+  Destructor that waits for the workers to terminate.
+*/
+vpThreadPool::~vpThreadPool() { delete m_impl; }
+
+/*!
+  Return the pool shared by the library, created on first use with as many
+  threads as supported by the hardware. Its size can be changed with
+  setNbThreads(), for example to leave cores to the application.
+*/
+vpThreadPool &vpThreadPool::getGlobalInstance()
+{
+  static vpThreadPool pool;
+  return pool;
+}
+
+/*!
+  Return the number of threads used to execute the tasks, including the
+  calling thread.
+*/
+unsigned int vpThreadPool::getNbThreads() const { return m_impl->getNbThreads(); }
+
+/*!
+  Execute \e body over the range [\e begin, \e end) split in chunks of
+  \e grainSize indices, and wait for the whole range to be processed. Idle
+  threads pick the next chunk, so that rows of unequal cost are balanced.
+
+  \param begin : First index of the range.
+  \param end : Index after the last one of the range.
+  \param body : Function called with the bounds [start, stop) of each chunk.
+  Chunks may be processed concurrently, they must not write to shared data.
+  \param nbThreads : Maximum number of threads working on the range. If 0,
+  all the threads of the pool are used.
+  \param grainSize : Number of indices per chunk. If 0, a size leading to
+  about 8 chunks per thread is chosen.
+
+  \exception Rethrows the first exception thrown by \e body.
+*/
+void vpThreadPool::parallelFor(int begin, int end, const std::function<void(int, int)> &body, unsigned int nbThreads,
+                               int grainSize)
+{
+  if (end <= begin) {
+    return;
+  }
+
+  unsigned int nbTasks = getNbThreads();
+  if (nbThreads > 0 && nbThreads < nbTasks) {
+    nbTasks = nbThreads;
+  }
+
+  const int range = end - begin;
+  if (nbTasks <= 1 || range == 1) {
+    body(begin, end);
+    return;
+  }
+
+  if (grainSize <= 0) {
+    grainSize = (std::max)(range / static_cast<int>(8 * nbTasks), 1);
+  }
+  const int nbChunks = (range + grainSize - 1) / grainSize;
+  nbTasks = (std::min)(nbTasks, static_cast<unsigned int>(nbChunks));
+
+  std::atomic<int> next(0);
+  std::function<void()> task = [&]() {
+    for (int chunk = next++; chunk < nbChunks; chunk = next++) {
+      const int start = begin + chunk * grainSize;
+      body(start, (std::min)(start + grainSize, end));
+    }
+  };
+  m_impl->run(std::vector<std::function<void()> >(nbTasks, task));
+}
+
+/*!
+  Execute a batch of tasks and wait for all of them to be completed. Tasks
+  may be executed in any order and concurrently, so they must not depend on
+  each other.
+
+  \param tasks : Tasks to execute.
+
+  \exception Rethrows the first exception thrown by a task.
+*/
+void vpThreadPool::run(const std::vector<std::function<void()> > &tasks) { m_impl->run(tasks); }
+
+/*!
+  Change the number of threads of the pool. Must not be called while tasks
+  are running.
+
+  \param nbThreads : Number of threads used to execute the tasks, including
+  the calling thread. If 0, the number of concurrent threads supported by the
+  hardware is used.
+*/
+void vpThreadPool::setNbThreads(unsigned int nbThreads)
+{
+  if (nbThreads == 0) {
+    nbThreads = (std::max)(std::thread::hardware_concurrency(), 1u);
+  }
+
+  if (nbThreads != m_impl->getNbThreads()) {
+    m_impl->start(nbThreads);
+  }
+}
+
+#else
+// Work arround to avoid warning:
+// libvisp_core.a(vpThreadPool.cpp.o) has no symbols
+void dummy_vpThreadPool(){};
+#endif
@@ -29,7 +29,7 @@
  * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
  *
  * Description:
- * Benchmark rgba to grayscale image conversion.
+ * Benchmark color conversions: rgba to grayscale, Bayer demosaicing and NV12/NV21.
  *
  *****************************************************************************/
 
@@ -41,11 +41,126 @@
 #include <catch.hpp>
 
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/io/vpImageIo.h>
 
 namespace {
 static std::string ipath = vpIoTools::getViSPImagesDataPath();
 
+const vpImageConvert::vpBayerPattern bayerPatterns[] = {vpImageConvert::BAYER_BGGR, vpImageConvert::BAYER_GBRG,
+                                                        vpImageConvert::BAYER_GRBG, vpImageConvert::BAYER_RGGB};
+const vpImageConvert::vpDemosaicMethod demosaicMethods[] = {vpImageConvert::DEMOSAIC_BILINEAR,
+                                                            vpImageConvert::DEMOSAIC_MALVAR};
+
+// Color (0: red, 1: green, 2: blue) of the Bayer sample at (i, j)
+int bayerColor(vpImageConvert::vpBayerPattern pattern, int i, int j)
+{
+  static const char *names[] = {"BGGR", "GBRG", "GRBG", "RGGB"};
+  const char c = names[pattern][2 * (i % 2) + (j % 2)];
+  return c == 'R' ? 0 : (c == 'G' ? 1 : 2);
+}
+
+int mirror(int i, int n)
+{
+  i = i < 0 ? -i : i;
+  i = i >= n ? 2 * (n - 1) - i : i;
+  return i < 0 ? 0 : (i >= n ? n - 1 : i);
+}
+
+template <typename T>
+int bayerAt(const std::vector<T> &bayer, int width, int height, int i, int j)
+{
+  return bayer[mirror(i, height) * width + mirror(j, width)];
+}
+
+template <typename T>
+void computeRegularDemosaic(const std::vector<T> &bayer, int width, int height,
+                            vpImageConvert::vpBayerPattern pattern, vpImageConvert::vpDemosaicMethod method,
+                            int bitDepth, vpImage<vpRGBa> &I)
+{
+  const int maxValue = (1 << bitDepth) - 1;
+  I.resize(height, width);
+  for (int i = 0; i < height; i++) {
+    for (int j = 0; j < width; j++) {
+#define P(di, dj) bayerAt(bayer, width, height, i + (di), j + (dj))
+      int horizontal, vertical, diagonal, cross;
+      if (method == vpImageConvert::DEMOSAIC_BILINEAR) {
+        horizontal = (P(0, -1) + P(0, 1) + 1) / 2;
+        vertical = (P(-1, 0) + P(1, 0) + 1) / 2;
+        diagonal = (P(-1, -1) + P(-1, 1) + P(1, -1) + P(1, 1) + 2) / 4;
+        cross = (P(0, -1) + P(0, 1) + P(-1, 0) + P(1, 0) + 2) / 4;
+      } else {
+        // Malvar, He and Cutler filters with coefficients multiplied by 16
+        const int c = P(0, 0);
+        const int d = P(-1, -1) + P(-1, 1) + P(1, -1) + P(1, 1);
+        horizontal = 10 * c + 8 * (P(0, -1) + P(0, 1)) - 2 * (P(0, -2) + P(0, 2)) - 2 * d + P(-2, 0) + P(2, 0);
+        vertical = 10 * c + 8 * (P(-1, 0) + P(1, 0)) - 2 * (P(-2, 0) + P(2, 0)) - 2 * d + P(0, -2) + P(0, 2);
+        diagonal = 12 * c + 4 * d - 3 * (P(0, -2) + P(0, 2) + P(-2, 0) + P(2, 0));
+        cross = 8 * c + 4 * (P(0, -1) + P(0, 1) + P(-1, 0) + P(1, 0)) - 2 * (P(0, -2) + P(0, 2) + P(-2, 0) + P(2, 0));
+
+        int *values[] = {&horizontal, &vertical, &diagonal, &cross};
+        for (int k = 0; k < 4; k++) {
+          *values[k] = *values[k] < 0 ? 0 : (std::min)((*values[k] + 8) / 16, maxValue);
+        }
+      }
+
+      int rgb[3];
+      const int color = bayerColor(pattern, i, j);
+      rgb[color] = P(0, 0);
+      if (color == 1) {
+        const int rowColor = bayerColor(pattern, i, j + 1);
+        rgb[rowColor] = horizontal;
+        rgb[2 - rowColor] = vertical;
+      } else {
+        rgb[1] = cross;
+        rgb[2 - color] = diagonal;
+      }
+#undef P
+
+      for (int k = 0; k < 3; k++) {
+        rgb[k] = (std::min)(rgb[k] >> (bitDepth - 8), 255);
+      }
+      I[i][j] = vpRGBa(rgb[0], rgb[1], rgb[2]);
+    }
+  }
+}
+
+void computeRegularGrey(const vpImage<vpRGBa> &I, vpImage<unsigned char> &I_gray)
+{
+  I_gray.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I_gray.bitmap[i] = (54 * I.bitmap[i].R + 183 * I.bitmap[i].G + 19 * I.bitmap[i].B + 128) >> 8;
+  }
+}
+
+template <typename T> std::vector<T> randomBayer(unsigned int width, unsigned int height, unsigned int bitDepth)
+{
+  std::vector<T> bayer(width * height);
+  for (size_t i = 0; i < bayer.size(); i++) {
+    bayer[i] = static_cast<T>(rand() % (1 << bitDepth));
+  }
+  return bayer;
+}
+
+// NV12 or NV21 image and the same image in the planar YUV 4:2:0 layout
+void randomNV(unsigned int width, unsigned int height, bool nv21, std::vector<unsigned char> &nv,
+              std::vector<unsigned char> &yuv420)
+{
+  const unsigned int size = width * height;
+  nv.resize(size + size / 2);
+  yuv420.resize(size + size / 2);
+  for (unsigned int i = 0; i < size; i++) {
+    nv[i] = yuv420[i] = static_cast<unsigned char>(rand() % 256);
+  }
+  for (unsigned int i = 0; i < size / 4; i++) {
+    const unsigned char u = static_cast<unsigned char>(rand() % 256), v = static_cast<unsigned char>(rand() % 256);
+    nv[size + 2 * i] = nv21 ? v : u;
+    nv[size + 2 * i + 1] = nv21 ? u : v;
+    yuv420[size + i] = u;
+    yuv420[size + size / 4 + i] = v;
+  }
+}
+
 void computeRegularRGBaToGrayscale(const unsigned char * rgba, unsigned char *grey, unsigned int size)
 {
   const unsigned char *pt_input = rgba;
@@ -154,8 +269,190 @@ TEST_CASE("Benchmark bgr to grayscale (OpenCV)", "[benchmark]") {
 }
 #endif
 
+TEST_CASE("Bayer demosaicing of a uniform color", "[demosaic]") {
+  const unsigned int width = 37, height = 23;
+  const unsigned char rgb[3] = {200, 30, 110};
+  for (size_t p = 0; p < 4; p++) {
+    std::vector<unsigned char> bayer(width * height);
+    for (unsigned int i = 0; i < height; i++) {
+      for (unsigned int j = 0; j < width; j++) {
+        bayer[i * width + j] = rgb[bayerColor(bayerPatterns[p], i, j)];
+      }
+    }
+
+    for (size_t m = 0; m < 2; m++) {
+      vpImage<vpRGBa> I;
+      vpImageConvert::demosaic(bayer.data(), I, width, height, bayerPatterns[p], demosaicMethods[m]);
+      vpImage<vpRGBa> I_ref(height, width, vpRGBa(rgb[0], rgb[1], rgb[2]));
+      CHECK((I == I_ref));
+    }
+  }
+}
+
+TEST_CASE("Bayer demosaicing (8-bit)", "[demosaic]") {
+  vpThreadPool::getGlobalInstance().setNbThreads(4);
+
+  const unsigned int sizes[][2] = {{64, 48}, {37, 29}, {5, 7}, {2, 2}, {1, 3}};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    const unsigned int width = sizes[s][0], height = sizes[s][1];
+    std::vector<unsigned char> bayer = randomBayer<unsigned char>(width, height, 8);
+
+    for (size_t p = 0; p < 4; p++) {
+      for (size_t m = 0; m < 2; m++) {
+        vpImage<vpRGBa> I_ref;
+        computeRegularDemosaic(bayer, width, height, bayerPatterns[p], demosaicMethods[m], 8, I_ref);
+        vpImage<unsigned char> I_gray_ref;
+        computeRegularGrey(I_ref, I_gray_ref);
+
+        for (unsigned int nbThreads = 0; nbThreads <= 1; nbThreads++) {
+          vpImage<vpRGBa> I;
+          vpImageConvert::demosaic(bayer.data(), I, width, height, bayerPatterns[p], demosaicMethods[m], nbThreads);
+          CHECK((I == I_ref));
+
+          vpImage<unsigned char> I_gray;
+          vpImageConvert::demosaic(bayer.data(), I_gray, width, height, bayerPatterns[p], demosaicMethods[m],
+                                   nbThreads);
+          CHECK((I_gray == I_gray_ref));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Bayer demosaicing (16-bit)", "[demosaic]") {
+  const unsigned int width = 45, height = 31;
+  const unsigned int bitDepths[] = {8, 10, 12, 16};
+  for (size_t b = 0; b < 4; b++) {
+    std::vector<uint16_t> bayer = randomBayer<uint16_t>(width, height, bitDepths[b]);
+
+    for (size_t p = 0; p < 4; p++) {
+      for (size_t m = 0; m < 2; m++) {
+        vpImage<vpRGBa> I_ref;
+        computeRegularDemosaic(bayer, width, height, bayerPatterns[p], demosaicMethods[m], bitDepths[b], I_ref);
+        vpImage<unsigned char> I_gray_ref;
+        computeRegularGrey(I_ref, I_gray_ref);
+
+        vpImage<vpRGBa> I;
+        vpImageConvert::demosaic(bayer.data(), I, width, height, bayerPatterns[p], demosaicMethods[m], bitDepths[b]);
+        CHECK((I == I_ref));
+
+        vpImage<unsigned char> I_gray;
+        vpImageConvert::demosaic(bayer.data(), I_gray, width, height, bayerPatterns[p], demosaicMethods[m],
+                                 bitDepths[b]);
+        CHECK((I_gray == I_gray_ref));
+      }
+    }
+  }
+
+  vpImage<vpRGBa> I;
+  std::vector<uint16_t> bayer(16);
+  CHECK_THROWS_AS(vpImageConvert::demosaic(bayer.data(), I, 4, 4, vpImageConvert::BAYER_RGGB,
+                                           vpImageConvert::DEMOSAIC_BILINEAR, 17),
+                  vpException);
+}
+
+TEST_CASE("NV12 and NV21 conversions", "[nv12]") {
+  const unsigned int sizes[][2] = {{640, 480}, {38, 22}};
+  for (size_t s = 0; s < 2; s++) {
+    const unsigned int width = sizes[s][0], height = sizes[s][1];
+    for (int nv21 = 0; nv21 <= 1; nv21++) {
+      std::vector<unsigned char> nv, yuv420;
+      randomNV(width, height, nv21 != 0, nv, yuv420);
+
+      vpImage<vpRGBa> I_ref(height, width), I(height, width);
+      vpImageConvert::YUV420ToRGBa(yuv420.data(), reinterpret_cast<unsigned char *>(I_ref.bitmap), width, height);
+      if (nv21) {
+        vpImageConvert::NV21ToRGBa(nv.data(), reinterpret_cast<unsigned char *>(I.bitmap), width, height);
+      } else {
+        vpImageConvert::NV12ToRGBa(nv.data(), reinterpret_cast<unsigned char *>(I.bitmap), width, height);
+      }
+      CHECK((I == I_ref));
+
+      std::vector<unsigned char> rgb_ref(width * height * 3), rgb(width * height * 3);
+      vpImageConvert::YUV420ToRGB(yuv420.data(), rgb_ref.data(), width, height);
+      if (nv21) {
+        vpImageConvert::NV21ToRGB(nv.data(), rgb.data(), width, height, 1);
+      } else {
+        vpImageConvert::NV12ToRGB(nv.data(), rgb.data(), width, height, 1);
+      }
+      CHECK(rgb == rgb_ref);
+    }
+  }
+}
+
+TEST_CASE("Benchmark Bayer demosaicing", "[benchmark]") {
+  const unsigned int width = 1920, height = 1080;
+  std::vector<unsigned char> bayer = randomBayer<unsigned char>(width, height, 8);
+  std::vector<uint16_t> bayer12 = randomBayer<uint16_t>(width, height, 12);
+  vpImage<vpRGBa> I;
+  vpImage<unsigned char> I_gray;
+
+  BENCHMARK("Benchmark Bayer to rgba bilinear (naive code)") {
+    computeRegularDemosaic(bayer, width, height, vpImageConvert::BAYER_RGGB, vpImageConvert::DEMOSAIC_BILINEAR, 8, I);
+    return I;
+  };
+
+  BENCHMARK("Benchmark Bayer to rgba bilinear (ViSP, 1 thread)") {
+    vpImageConvert::demosaic(bayer.data(), I, width, height, vpImageConvert::BAYER_RGGB,
+                             vpImageConvert::DEMOSAIC_BILINEAR, 1);
+    return I;
+  };
+
+  BENCHMARK("Benchmark Bayer to rgba bilinear (ViSP)") {
+    vpImageConvert::demosaic(bayer.data(), I, width, height, vpImageConvert::BAYER_RGGB,
+                             vpImageConvert::DEMOSAIC_BILINEAR);
+    return I;
+  };
+
+  BENCHMARK("Benchmark Bayer to rgba Malvar (naive code)") {
+    computeRegularDemosaic(bayer, width, height, vpImageConvert::BAYER_RGGB, vpImageConvert::DEMOSAIC_MALVAR, 8, I);
+    return I;
+  };
+
+  BENCHMARK("Benchmark Bayer to rgba Malvar (ViSP)") {
+    vpImageConvert::demosaic(bayer.data(), I, width, height, vpImageConvert::BAYER_RGGB,
+                             vpImageConvert::DEMOSAIC_MALVAR);
+    return I;
+  };
+
+  BENCHMARK("Benchmark Bayer to grayscale Malvar (ViSP)") {
+    vpImageConvert::demosaic(bayer.data(), I_gray, width, height, vpImageConvert::BAYER_RGGB,
+                             vpImageConvert::DEMOSAIC_MALVAR);
+    return I_gray;
+  };
+
+  BENCHMARK("Benchmark 12-bit Bayer to rgba Malvar (ViSP)") {
+    vpImageConvert::demosaic(bayer12.data(), I, width, height, vpImageConvert::BAYER_RGGB,
+                             vpImageConvert::DEMOSAIC_MALVAR, 12);
+    return I;
+  };
+}
+
+TEST_CASE("Benchmark NV12 to rgba", "[benchmark]") {
+  const unsigned int width = 1920, height = 1080;
+  std::vector<unsigned char> nv, yuv420;
+  randomNV(width, height, false, nv, yuv420);
+  vpImage<vpRGBa> I(height, width);
+
+  BENCHMARK("Benchmark YUV420 to rgba (ViSP)") {
+    vpImageConvert::YUV420ToRGBa(yuv420.data(), reinterpret_cast<unsigned char *>(I.bitmap), width, height);
+    return I;
+  };
+
+  BENCHMARK("Benchmark NV12 to rgba (ViSP, 1 thread)") {
+    vpImageConvert::NV12ToRGBa(nv.data(), reinterpret_cast<unsigned char *>(I.bitmap), width, height, 1);
+    return I;
+  };
+
+  BENCHMARK("Benchmark NV12 to rgba (ViSP)") {
+    vpImageConvert::NV12ToRGBa(nv.data(), reinterpret_cast<unsigned char *>(I.bitmap), width, height);
+    return I;
+  };
+}
+
 int main(int argc, char *argv[])
 {
+  srand(0);
   Catch::Session session; // There must be exactly one instance
 
   bool runBenchmark = false;
@@ -172,16 +469,18 @@ int main(int argc, char *argv[])
   // Let Catch (using Clara) parse the command line
   session.applyCommandLine(argc, argv);
 
-  if (runBenchmark) {
-    int numFailed = session.run();
-
-    // numFailed is clamped to 255 as some unices only use the lower 8 bits.
-    // This clamping has already been applied, so just return it here
-    // You can also do any post run clean-up here
-    return numFailed;
+  // Without --benchmark, only the conversions that do not rely on the ViSP
+  // images data set are checked
+  if (!runBenchmark && session.configData().testsOrTags.empty()) {
+    session.configData().testsOrTags.push_back("~[benchmark]");
   }
 
-  return EXIT_SUCCESS;
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
 }
 #else
 #include <iostream>
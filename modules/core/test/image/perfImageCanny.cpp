@@ -0,0 +1,390 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark Canny edge detector.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfImageCanny.cpp
+
+  \brief Check the native Canny edge detector against a naive implementation
+  and OpenCV, and benchmark them.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <algorithm>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpImageIo.h>
+
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+#include <opencv2/imgproc/imgproc.hpp>
+#endif
+
+namespace
+{
+bool runBenchmark = false;
+
+int clamp(int x, int size) { return (std::min)((std::max)(x, 0), size - 1); }
+
+int reflect(int x, int size)
+{
+  if (size == 1) {
+    return 0;
+  }
+  while (x < 0 || x >= size) {
+    x = x < 0 ? -x : 2 * size - 2 - x;
+  }
+  return x;
+}
+
+// Straightforward implementation of the Canny edge detector, with the same
+// fixed-point Gaussian kernels and rounding as OpenCV
+void cannyNaive(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ic, unsigned int gaussianFilterSize,
+                double lowerThreshold, double upperThreshold, unsigned int apertureSobel)
+{
+  const int gaussian3[] = {64, 128, 64}, gaussian5[] = {16, 64, 96, 64, 16},
+            gaussian7[] = {8, 28, 56, 72, 56, 28, 8};
+  const int smooth3[] = {1, 2, 1}, deriv3[] = {-1, 0, 1};
+  const int smooth5[] = {1, 4, 6, 4, 1}, deriv5[] = {-1, -2, 0, 2, 1};
+  const int smooth7[] = {1, 6, 15, 20, 15, 6, 1}, deriv7[] = {-1, -4, -5, 0, 5, 4, 1};
+  const int *gaussian = gaussianFilterSize == 3 ? gaussian3 : (gaussianFilterSize == 5 ? gaussian5 : gaussian7);
+  const int *smooth = apertureSobel == 3 ? smooth3 : (apertureSobel == 5 ? smooth5 : smooth7);
+  const int *deriv = apertureSobel == 3 ? deriv3 : (apertureSobel == 5 ? deriv5 : deriv7);
+  const int h = static_cast<int>(I.getHeight()), w = static_cast<int>(I.getWidth());
+  const int gs = static_cast<int>(gaussianFilterSize) / 2, as = static_cast<int>(apertureSobel) / 2;
+
+  vpImage<unsigned int> tmp(I.getHeight(), I.getWidth());
+  for (int i = 0; i < h; i++) {
+    for (int j = 0; j < w; j++) {
+      unsigned int sum = 0;
+      for (int k = -gs; k <= gs; k++) {
+        sum += gaussian[k + gs] * I[i][reflect(j + k, w)];
+      }
+      tmp[i][j] = sum;
+    }
+  }
+  vpImage<unsigned char> G(I.getHeight(), I.getWidth());
+  for (int i = 0; i < h; i++) {
+    for (int j = 0; j < w; j++) {
+      unsigned int sum = 1 << 15;
+      for (int k = -gs; k <= gs; k++) {
+        sum += gaussian[k + gs] * tmp[reflect(i + k, h)][j];
+      }
+      G[i][j] = static_cast<unsigned char>(sum >> 16);
+    }
+  }
+
+  vpImage<int> dx(I.getHeight(), I.getWidth()), dy(I.getHeight(), I.getWidth());
+  vpImage<int> mag(I.getHeight() + 2, I.getWidth() + 2, 0);
+  for (int i = 0; i < h; i++) {
+    for (int j = 0; j < w; j++) {
+      int gx = 0, gy = 0;
+      for (int a = -as; a <= as; a++) {
+        for (int b = -as; b <= as; b++) {
+          const int v = G[clamp(i + a, h)][clamp(j + b, w)];
+          gx += smooth[a + as] * deriv[b + as] * v;
+          gy += deriv[a + as] * smooth[b + as] * v;
+        }
+      }
+      // Derivatives saturated to 16-bit integers as in OpenCV
+      gx = (std::min)((std::max)(gx, -32768), 32767);
+      gy = (std::min)((std::max)(gy, -32768), 32767);
+      dx[i][j] = gx;
+      dy[i][j] = gy;
+      mag[i + 1][j + 1] = std::abs(gx) + std::abs(gy);
+    }
+  }
+
+  const double low = std::floor(lowerThreshold), high = std::floor(upperThreshold);
+  const double tan22 = 0.4142135623730950488016887242097;
+  // 0: weak edge, 1: not an edge, 2: edge
+  vpImage<unsigned char> map(I.getHeight() + 2, I.getWidth() + 2, 1);
+  for (int i = 1; i <= h; i++) {
+    for (int j = 1; j <= w; j++) {
+      const int m = mag[i][j];
+      if (m <= low) {
+        continue;
+      }
+      const int x = std::abs(dx[i - 1][j - 1]), y = std::abs(dy[i - 1][j - 1]);
+      bool is_max;
+      if (y < x * tan22) {
+        is_max = m > mag[i][j - 1] && m >= mag[i][j + 1];
+      } else if (y > x * (tan22 + 2)) {
+        is_max = m > mag[i - 1][j] && m >= mag[i + 1][j];
+      } else {
+        const int s = dx[i - 1][j - 1] * dy[i - 1][j - 1] < 0 ? -1 : 1;
+        is_max = m > mag[i - 1][j - s] && m > mag[i + 1][j + s];
+      }
+      if (is_max) {
+        map[i][j] = m > high ? 2 : 0;
+      }
+    }
+  }
+
+  // Propagate the edges until convergence
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (int i = 1; i <= h; i++) {
+      for (int j = 1; j <= w; j++) {
+        if (map[i][j] != 0) {
+          continue;
+        }
+        for (int a = -1; a <= 1 && map[i][j] == 0; a++) {
+          for (int b = -1; b <= 1; b++) {
+            if (map[i + a][j + b] == 2) {
+              map[i][j] = 2;
+              changed = true;
+              break;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  Ic.resize(I.getHeight(), I.getWidth());
+  for (int i = 0; i < h; i++) {
+    for (int j = 0; j < w; j++) {
+      Ic[i][j] = map[i + 1][j + 1] == 2 ? 255 : 0;
+    }
+  }
+}
+
+void generateImage(vpImage<unsigned char> &I, unsigned int height, unsigned int width)
+{
+  I.resize(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      // Blocks with noise
+      const bool block = ((i / 7) + (j / 5)) % 2 == 0;
+      I[i][j] = static_cast<unsigned char>((block ? 160 : 60) + rand() % 40);
+    }
+  }
+}
+
+unsigned int countDifferences(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2)
+{
+  unsigned int nb = 0;
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    nb += I1.bitmap[i] != I2.bitmap[i] ? 1 : 0;
+  }
+  return nb;
+}
+}
+
+TEST_CASE("Canny edges of a square", "[canny]") {
+  vpImage<unsigned char> I(60, 80, 0);
+  for (unsigned int i = 20; i < 40; i++) {
+    for (unsigned int j = 30; j < 50; j++) {
+      I[i][j] = 200;
+    }
+  }
+
+  vpImage<unsigned char> Ic;
+  vpImageFilter::canny(I, Ic, 5, 30, 90, 3);
+  REQUIRE(Ic.getHeight() == I.getHeight());
+  REQUIRE(Ic.getWidth() == I.getWidth());
+
+  unsigned int nbEdges = 0;
+  for (unsigned int i = 0; i < Ic.getHeight(); i++) {
+    for (unsigned int j = 0; j < Ic.getWidth(); j++) {
+      if (Ic[i][j]) {
+        nbEdges++;
+        // Edge pixels lie along the border of the square
+        const bool nearRows = i >= 18 && i <= 41, nearCols = j >= 28 && j <= 51;
+        const bool onBorder = (i <= 21 || i >= 38 || j <= 31 || j >= 48);
+        CHECK((nearRows && nearCols && onBorder));
+      }
+    }
+  }
+  CHECK(nbEdges >= 4 * 18);
+}
+
+TEST_CASE("Canny edges of a strong step with a large Sobel aperture", "[canny]") {
+  // The derivative of a step from 0 to 255 saturates at 32767 with an
+  // aperture of 7, its direction must still be horizontal and give a single
+  // vertical line
+  vpImage<unsigned char> I(40, 60, 0);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 30; j < I.getWidth(); j++) {
+      I[i][j] = 255;
+    }
+  }
+
+  for (unsigned int apertureSobel = 3; apertureSobel <= 7; apertureSobel += 2) {
+    vpImage<unsigned char> Ic;
+    vpImageFilter::canny(I, Ic, 5, 100, 300, apertureSobel);
+    INFO("Sobel " << apertureSobel);
+    for (unsigned int i = 0; i < Ic.getHeight(); i++) {
+      unsigned int nbEdges = 0;
+      for (unsigned int j = 0; j < Ic.getWidth(); j++) {
+        if (Ic[i][j]) {
+          nbEdges++;
+          // The saturated derivatives make a plateau around the step
+          CHECK((j >= 26 && j <= 33));
+          CHECK(Ic[0][j] == 255);
+        }
+      }
+      CHECK(nbEdges == 1);
+    }
+  }
+}
+
+TEST_CASE("Canny edge detector compared to a naive implementation", "[canny]") {
+  const unsigned int sizes[][2] = {{1, 1}, {2, 3}, {5, 17}, {31, 9}, {33, 64}, {48, 71}, {120, 161}};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    vpImage<unsigned char> I;
+    generateImage(I, sizes[s][0], sizes[s][1]);
+
+    for (unsigned int gaussianFilterSize = 3; gaussianFilterSize <= 7; gaussianFilterSize += 2) {
+      for (unsigned int apertureSobel = 3; apertureSobel <= 7; apertureSobel += 2) {
+        vpImage<unsigned char> Ic, Ic_naive;
+        vpImageFilter::canny(I, Ic, gaussianFilterSize, 40, 120, apertureSobel);
+        cannyNaive(I, Ic_naive, gaussianFilterSize, 40, 120, apertureSobel);
+
+        INFO("Image " << I.getHeight() << "x" << I.getWidth() << ", Gaussian " << gaussianFilterSize << ", Sobel "
+                      << apertureSobel);
+        CHECK(countDifferences(Ic, Ic_naive) == 0);
+      }
+    }
+
+    // In-place filtering with the same threshold for the hysteresis
+    vpImage<unsigned char> I_copy = I, Ic_naive;
+    vpImageFilter::canny(I_copy, I_copy, 5, 60, 3);
+    cannyNaive(I, Ic_naive, 5, 60, 60, 3);
+    CHECK(countDifferences(I_copy, Ic_naive) == 0);
+  }
+
+  vpImage<unsigned char> I(10, 10), Ic;
+  CHECK_THROWS_AS(vpImageFilter::canny(I, Ic, 4, 10, 3), vpException);
+  CHECK_THROWS_AS(vpImageFilter::canny(I, Ic, 5, 10, 4), vpException);
+}
+
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+TEST_CASE("Canny edge detector compared to OpenCV", "[canny]") {
+  vpImage<unsigned char> I;
+  generateImage(I, 240, 321);
+
+  for (unsigned int gaussianFilterSize = 3; gaussianFilterSize <= 7; gaussianFilterSize += 2) {
+    vpImage<unsigned char> Ic, Ic_opencv;
+    vpImageFilter::canny(I, Ic, gaussianFilterSize, 40, 120, 3);
+
+    cv::Mat img, img_blur, edges;
+    vpImageConvert::convert(I, img);
+    cv::GaussianBlur(img, img_blur, cv::Size((int)gaussianFilterSize, (int)gaussianFilterSize), 0, 0);
+    cv::Canny(img_blur, edges, 40, 120, 3);
+    vpImageConvert::convert(edges, Ic_opencv);
+
+    INFO("Gaussian " << gaussianFilterSize);
+    CHECK(countDifferences(Ic, Ic_opencv) == 0);
+  }
+}
+#endif
+
+TEST_CASE("Benchmark Canny edge detector", "[benchmark]") {
+  if (runBenchmark) {
+    vpImage<unsigned char> I;
+    std::string imgPath = vpIoTools::createFilePath(vpIoTools::getViSPImagesDataPath(), "Klimt/Klimt.pgm");
+    if (vpIoTools::checkFilename(imgPath)) {
+      vpImageIo::read(I, imgPath);
+    } else {
+      generateImage(I, 480, 640);
+    }
+    vpImage<unsigned char> Ic;
+
+    BENCHMARK("Benchmark Canny (naive code)") {
+      cannyNaive(I, Ic, 5, 40, 120, 3);
+      return Ic;
+    };
+
+    BENCHMARK("Benchmark Canny (ViSP)") {
+      vpImageFilter::canny(I, Ic, 5, 40, 120, 3);
+      return Ic;
+    };
+
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+    cv::Mat img, img_blur, edges;
+    BENCHMARK("Benchmark Canny (OpenCV)") {
+      vpImageConvert::convert(I, img);
+      cv::GaussianBlur(img, img_blur, cv::Size(5, 5), 0, 0);
+      cv::Canny(img_blur, edges, 40, 120, 3);
+      vpImageConvert::convert(edges, Ic);
+      return Ic;
+    };
+#endif
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  // Initialize the random generator for reproducible values
+  srand(0);
+
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark comparing naive code, ViSP and OpenCV implementations");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
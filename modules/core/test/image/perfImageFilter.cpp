@@ -0,0 +1,511 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark separable image filters.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfImageFilter.cpp
+
+  \brief Check the separable filters of vpImageFilter against the per-pixel
+  functions, and benchmark them.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpImageIo.h>
+
+namespace
+{
+bool runBenchmark = false;
+
+// Per-pixel implementations of the separable filters
+template <class Type> void filterXNaive(const vpImage<Type> &I, vpImage<double> &dIx, const double *filter, unsigned int size)
+{
+  dIx.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
+      dIx[i][j] = vpImageFilter::filterXLeftBorder(I, i, j, filter, size);
+    }
+    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
+      dIx[i][j] = vpImageFilter::filterX(I, i, j, filter, size);
+    }
+    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
+      dIx[i][j] = vpImageFilter::filterXRightBorder(I, i, j, filter, size);
+    }
+  }
+}
+
+template <class Type> void filterYNaive(const vpImage<Type> &I, vpImage<double> &dIy, const double *filter, unsigned int size)
+{
+  dIy.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      if (i < (size - 1) / 2) {
+        dIy[i][j] = vpImageFilter::filterYTopBorder(I, i, j, filter, size);
+      } else if (i < I.getHeight() - (size - 1) / 2) {
+        dIy[i][j] = vpImageFilter::filterY(I, i, j, filter, size);
+      } else {
+        dIy[i][j] = vpImageFilter::filterYBottomBorder(I, i, j, filter, size);
+      }
+    }
+  }
+}
+
+void filterXNaive(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter, unsigned int size)
+{
+  dIx.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      if (j < (size - 1) / 2) {
+        dIx[i][j].R = static_cast<unsigned char>(vpImageFilter::filterXLeftBorderR(I, i, j, filter, size));
+        dIx[i][j].G = static_cast<unsigned char>(vpImageFilter::filterXLeftBorderG(I, i, j, filter, size));
+        dIx[i][j].B = static_cast<unsigned char>(vpImageFilter::filterXLeftBorderB(I, i, j, filter, size));
+      } else if (j < I.getWidth() - (size - 1) / 2) {
+        dIx[i][j].R = static_cast<unsigned char>(vpImageFilter::filterXR(I, i, j, filter, size));
+        dIx[i][j].G = static_cast<unsigned char>(vpImageFilter::filterXG(I, i, j, filter, size));
+        dIx[i][j].B = static_cast<unsigned char>(vpImageFilter::filterXB(I, i, j, filter, size));
+      } else {
+        dIx[i][j].R = static_cast<unsigned char>(vpImageFilter::filterXRightBorderR(I, i, j, filter, size));
+        dIx[i][j].G = static_cast<unsigned char>(vpImageFilter::filterXRightBorderG(I, i, j, filter, size));
+        dIx[i][j].B = static_cast<unsigned char>(vpImageFilter::filterXRightBorderB(I, i, j, filter, size));
+      }
+    }
+  }
+}
+
+void filterYNaive(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIy, const double *filter, unsigned int size)
+{
+  dIy.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      if (i < (size - 1) / 2) {
+        dIy[i][j].R = static_cast<unsigned char>(vpImageFilter::filterYTopBorderR(I, i, j, filter, size));
+        dIy[i][j].G = static_cast<unsigned char>(vpImageFilter::filterYTopBorderG(I, i, j, filter, size));
+        dIy[i][j].B = static_cast<unsigned char>(vpImageFilter::filterYTopBorderB(I, i, j, filter, size));
+      } else if (i < I.getHeight() - (size - 1) / 2) {
+        dIy[i][j].R = static_cast<unsigned char>(vpImageFilter::filterYR(I, i, j, filter, size));
+        dIy[i][j].G = static_cast<unsigned char>(vpImageFilter::filterYG(I, i, j, filter, size));
+        dIy[i][j].B = static_cast<unsigned char>(vpImageFilter::filterYB(I, i, j, filter, size));
+      } else {
+        dIy[i][j].R = static_cast<unsigned char>(vpImageFilter::filterYBottomBorderR(I, i, j, filter, size));
+        dIy[i][j].G = static_cast<unsigned char>(vpImageFilter::filterYBottomBorderG(I, i, j, filter, size));
+        dIy[i][j].B = static_cast<unsigned char>(vpImageFilter::filterYBottomBorderB(I, i, j, filter, size));
+      }
+    }
+  }
+}
+
+template <class Type> void getGradXNaive(const vpImage<Type> &I, vpImage<double> &dIx, const double *filter, unsigned int size)
+{
+  dIx.resize(I.getHeight(), I.getWidth(), 0);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
+      dIx[i][j] = vpImageFilter::derivativeFilterX(I, i, j, filter, size);
+    }
+  }
+}
+
+template <class Type> void getGradYNaive(const vpImage<Type> &I, vpImage<double> &dIy, const double *filter, unsigned int size)
+{
+  dIy.resize(I.getHeight(), I.getWidth(), 0);
+  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      dIy[i][j] = vpImageFilter::derivativeFilterY(I, i, j, filter, size);
+    }
+  }
+}
+
+void getGaussPyramidalNaive(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI)
+{
+  const unsigned int w = I.getWidth() / 2, h = I.getHeight() / 2;
+  vpImage<unsigned char> GIx(I.getHeight(), w);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    GIx[i][0] = I[i][0];
+    for (unsigned int j = 1; j < w - 1; j++) {
+      GIx[i][j] = vpImageFilter::filterGaussXPyramidal(I, i, 2 * j);
+    }
+    GIx[i][w - 1] = I[i][2 * w - 1];
+  }
+
+  GI.resize(h, w);
+  for (unsigned int j = 0; j < w; j++) {
+    GI[0][j] = GIx[0][j];
+    for (unsigned int i = 1; i < h - 1; i++) {
+      GI[i][j] = vpImageFilter::filterGaussYPyramidal(GIx, 2 * i, j);
+    }
+    GI[h - 1][j] = GIx[2 * h - 1][j];
+  }
+}
+
+void generateImage(vpImage<unsigned char> &I, unsigned int height, unsigned int width)
+{
+  I.resize(height, width);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<unsigned char>(rand() % 256);
+  }
+}
+
+void generateImage(vpImage<vpRGBa> &I, unsigned int height, unsigned int width)
+{
+  I.resize(height, width);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = vpRGBa(static_cast<unsigned char>(rand() % 256), static_cast<unsigned char>(rand() % 256),
+                         static_cast<unsigned char>(rand() % 256));
+  }
+}
+
+template <class Type> bool isEqual(const vpImage<Type> &I1, const vpImage<Type> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    if (!(I1.bitmap[i] == I2.bitmap[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool isEqual(const vpImage<vpRGBa> &I1, const vpImage<vpRGBa> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    if (I1.bitmap[i].R != I2.bitmap[i].R || I1.bitmap[i].G != I2.bitmap[i].G || I1.bitmap[i].B != I2.bitmap[i].B) {
+      return false;
+    }
+  }
+  return true;
+}
+
+double maxDifference(const vpImage<float> &I1, const vpImage<double> &I2)
+{
+  double diff = 0;
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    diff = (std::max)(diff, std::fabs(I1.bitmap[i] - I2.bitmap[i]));
+  }
+  return diff;
+}
+
+const unsigned int imageSizes[][2] = {{9, 9}, {11, 30}, {31, 33}, {48, 71}, {120, 161}};
+const unsigned int kernelSizes[] = {3, 5, 7, 9};
+}
+
+TEST_CASE("Separable filters compared to the per-pixel functions", "[vpImageFilter]") {
+  for (size_t s = 0; s < sizeof(imageSizes) / sizeof(imageSizes[0]); s++) {
+    vpImage<unsigned char> I;
+    generateImage(I, imageSizes[s][0], imageSizes[s][1]);
+    vpImage<double> I_double(I.getHeight(), I.getWidth());
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      I_double.bitmap[i] = I.bitmap[i];
+    }
+
+    for (size_t k = 0; k < sizeof(kernelSizes) / sizeof(kernelSizes[0]); k++) {
+      const unsigned int size = kernelSizes[k];
+      INFO("Image " << I.getHeight() << "x" << I.getWidth() << ", kernel size " << size);
+      std::vector<double> filter((size + 1) / 2);
+      vpImageFilter::getGaussianKernel(filter.data(), size);
+
+      vpImage<double> I_naive, I_naive_tmp, I_filtered;
+      filterXNaive(I, I_naive, filter.data(), size);
+      vpImageFilter::filterX(I, I_filtered, filter.data(), size);
+      CHECK(isEqual(I_filtered, I_naive));
+      vpImageFilter::filterX(I_double, I_filtered, filter.data(), size);
+      CHECK(isEqual(I_filtered, I_naive));
+
+      filterYNaive(I, I_naive, filter.data(), size);
+      vpImageFilter::filterY(I, I_filtered, filter.data(), size);
+      CHECK(isEqual(I_filtered, I_naive));
+      vpImageFilter::filterY(I_double, I_filtered, filter.data(), size);
+      CHECK(isEqual(I_filtered, I_naive));
+
+      filterXNaive(I, I_naive_tmp, filter.data(), size);
+      filterYNaive(I_naive_tmp, I_naive, filter.data(), size);
+      vpImageFilter::filter(I, I_filtered, filter.data(), size);
+      CHECK(isEqual(I_filtered, I_naive));
+      vpImageFilter::gaussianBlur(I_double, I_filtered, size);
+      CHECK(isEqual(I_filtered, I_naive));
+
+      // In place filtering
+      I_filtered = I_double;
+      vpImageFilter::gaussianBlur(I_filtered, I_filtered, size);
+      CHECK(isEqual(I_filtered, I_naive));
+    }
+  }
+}
+
+TEST_CASE("Color separable filters compared to the per-pixel functions", "[vpImageFilter]") {
+  for (size_t s = 0; s < sizeof(imageSizes) / sizeof(imageSizes[0]); s++) {
+    vpImage<vpRGBa> I;
+    generateImage(I, imageSizes[s][0], imageSizes[s][1]);
+
+    for (size_t k = 0; k < sizeof(kernelSizes) / sizeof(kernelSizes[0]); k++) {
+      const unsigned int size = kernelSizes[k];
+      INFO("Image " << I.getHeight() << "x" << I.getWidth() << ", kernel size " << size);
+      std::vector<double> filter((size + 1) / 2);
+      vpImageFilter::getGaussianKernel(filter.data(), size);
+
+      vpImage<vpRGBa> I_naive, I_naive_tmp, I_filtered;
+      filterXNaive(I, I_naive, filter.data(), size);
+      vpImageFilter::filterX(I, I_filtered, filter.data(), size);
+      CHECK(isEqual(I_filtered, I_naive));
+
+      filterYNaive(I, I_naive, filter.data(), size);
+      vpImageFilter::filterY(I, I_filtered, filter.data(), size);
+      CHECK(isEqual(I_filtered, I_naive));
+
+      filterXNaive(I, I_naive_tmp, filter.data(), size);
+      filterYNaive(I_naive_tmp, I_naive, filter.data(), size);
+      vpImageFilter::gaussianBlur(I, I_filtered, size);
+      CHECK(isEqual(I_filtered, I_naive));
+    }
+  }
+}
+
+TEST_CASE("Gradients compared to the per-pixel functions", "[vpImageFilter]") {
+  for (size_t s = 0; s < sizeof(imageSizes) / sizeof(imageSizes[0]); s++) {
+    vpImage<unsigned char> I;
+    generateImage(I, imageSizes[s][0], imageSizes[s][1]);
+
+    for (size_t k = 0; k < sizeof(kernelSizes) / sizeof(kernelSizes[0]); k++) {
+      const unsigned int size = kernelSizes[k];
+      INFO("Image " << I.getHeight() << "x" << I.getWidth() << ", kernel size " << size);
+      std::vector<double> filter((size + 1) / 2), derivativeFilter((size + 1) / 2);
+      vpImageFilter::getGaussianKernel(filter.data(), size);
+      vpImageFilter::getGaussianDerivativeKernel(derivativeFilter.data(), size);
+
+      vpImage<double> I_naive, I_naive_tmp, I_filtered;
+      getGradXNaive(I, I_naive, derivativeFilter.data(), size);
+      vpImageFilter::getGradX(I, I_filtered, derivativeFilter.data(), size);
+      CHECK(isEqual(I_filtered, I_naive));
+
+      getGradYNaive(I, I_naive, derivativeFilter.data(), size);
+      vpImageFilter::getGradY(I, I_filtered, derivativeFilter.data(), size);
+      CHECK(isEqual(I_filtered, I_naive));
+
+      filterYNaive(I, I_naive_tmp, filter.data(), size);
+      getGradXNaive(I_naive_tmp, I_naive, derivativeFilter.data(), size);
+      vpImageFilter::getGradXGauss2D(I, I_filtered, filter.data(), derivativeFilter.data(), size);
+      CHECK(isEqual(I_filtered, I_naive));
+      vpImage<float> I_float;
+      vpImageFilter::getGradXGauss2D(I, I_float, filter.data(), derivativeFilter.data(), size);
+      CHECK(maxDifference(I_float, I_naive) < 1e-3);
+
+      filterXNaive(I, I_naive_tmp, filter.data(), size);
+      getGradYNaive(I_naive_tmp, I_naive, derivativeFilter.data(), size);
+      vpImageFilter::getGradYGauss2D(I, I_filtered, filter.data(), derivativeFilter.data(), size);
+      CHECK(isEqual(I_filtered, I_naive));
+      vpImageFilter::getGradYGauss2D(I, I_float, filter.data(), derivativeFilter.data(), size);
+      CHECK(maxDifference(I_float, I_naive) < 1e-3);
+    }
+  }
+}
+
+TEST_CASE("Single precision filters", "[vpImageFilter]") {
+  for (size_t s = 0; s < sizeof(imageSizes) / sizeof(imageSizes[0]); s++) {
+    vpImage<unsigned char> I;
+    generateImage(I, imageSizes[s][0], imageSizes[s][1]);
+
+    for (size_t k = 0; k < sizeof(kernelSizes) / sizeof(kernelSizes[0]); k++) {
+      const unsigned int size = kernelSizes[k];
+      INFO("Image " << I.getHeight() << "x" << I.getWidth() << ", kernel size " << size);
+      std::vector<double> filter((size + 1) / 2);
+      vpImageFilter::getGaussianKernel(filter.data(), size);
+
+      vpImage<double> I_double;
+      vpImage<float> I_float;
+      vpImageFilter::filterX(I, I_double, filter.data(), size);
+      vpImageFilter::filterX(I, I_float, filter.data(), size);
+      CHECK(maxDifference(I_float, I_double) < 1e-3);
+
+      vpImageFilter::filterY(I, I_double, filter.data(), size);
+      vpImageFilter::filterY(I, I_float, filter.data(), size);
+      CHECK(maxDifference(I_float, I_double) < 1e-3);
+
+      vpImageFilter::gaussianBlur(I, I_double, size);
+      vpImageFilter::gaussianBlur(I, I_float, size);
+      CHECK(maxDifference(I_float, I_double) < 1e-3);
+    }
+  }
+}
+
+TEST_CASE("Gaussian pyramid compared to the per-pixel functions", "[vpImageFilter]") {
+  const unsigned int sizes[][2] = {{4, 4}, {5, 7}, {17, 33}, {18, 40}, {31, 53}, {120, 161}};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    vpImage<unsigned char> I;
+    generateImage(I, sizes[s][0], sizes[s][1]);
+    INFO("Image " << I.getHeight() << "x" << I.getWidth());
+
+    vpImage<unsigned char> GIx_naive(I.getHeight(), I.getWidth() / 2), GI_naive, GI;
+    const unsigned int w = I.getWidth() / 2;
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      GIx_naive[i][0] = I[i][0];
+      for (unsigned int j = 1; j < w - 1; j++) {
+        GIx_naive[i][j] = vpImageFilter::filterGaussXPyramidal(I, i, 2 * j);
+      }
+      GIx_naive[i][w - 1] = I[i][2 * w - 1];
+    }
+    vpImageFilter::getGaussXPyramidal(I, GI);
+    CHECK(isEqual(GI, GIx_naive));
+
+    getGaussPyramidalNaive(I, GI_naive);
+    vpImageFilter::getGaussYPyramidal(GIx_naive, GI);
+    CHECK(isEqual(GI, GI_naive));
+
+#if !defined(VISP_HAVE_OPENCV)
+    vpImageFilter::getGaussPyramidal(I, GI);
+    CHECK(isEqual(GI, GI_naive));
+
+    // In place filtering
+    GI = I;
+    vpImageFilter::getGaussPyramidal(GI, GI);
+    CHECK(isEqual(GI, GI_naive));
+#endif
+  }
+}
+
+TEST_CASE("Benchmark separable filters", "[benchmark]") {
+  if (runBenchmark) {
+    vpImage<unsigned char> I;
+    std::string imgPath = vpIoTools::createFilePath(vpIoTools::getViSPImagesDataPath(), "Klimt/Klimt.pgm");
+    if (vpIoTools::checkFilename(imgPath)) {
+      vpImageIo::read(I, imgPath);
+    } else {
+      generateImage(I, 480, 640);
+    }
+    vpImage<vpRGBa> I_color;
+    generateImage(I_color, I.getHeight(), I.getWidth());
+
+    const unsigned int size = 7;
+    std::vector<double> filter((size + 1) / 2), derivativeFilter((size + 1) / 2);
+    vpImageFilter::getGaussianKernel(filter.data(), size);
+    vpImageFilter::getGaussianDerivativeKernel(derivativeFilter.data(), size);
+    vpImage<double> I_tmp, I_blur;
+    vpImage<float> I_blur_float;
+    vpImage<vpRGBa> I_color_tmp, I_color_blur;
+    vpImage<unsigned char> I_pyr, I_pyr_tmp;
+
+    BENCHMARK("Benchmark Gaussian blur (naive code)") {
+      filterXNaive(I, I_tmp, filter.data(), size);
+      filterYNaive(I_tmp, I_blur, filter.data(), size);
+      return I_blur;
+    };
+
+    BENCHMARK("Benchmark Gaussian blur (ViSP)") {
+      vpImageFilter::gaussianBlur(I, I_blur, size);
+      return I_blur;
+    };
+
+    BENCHMARK("Benchmark Gaussian blur float (ViSP)") {
+      vpImageFilter::gaussianBlur(I, I_blur_float, size);
+      return I_blur_float;
+    };
+
+    BENCHMARK("Benchmark color Gaussian blur (naive code)") {
+      filterXNaive(I_color, I_color_tmp, filter.data(), size);
+      filterYNaive(I_color_tmp, I_color_blur, filter.data(), size);
+      return I_color_blur;
+    };
+
+    BENCHMARK("Benchmark color Gaussian blur (ViSP)") {
+      vpImageFilter::gaussianBlur(I_color, I_color_blur, size);
+      return I_color_blur;
+    };
+
+    BENCHMARK("Benchmark gradient along X (naive code)") {
+      filterYNaive(I, I_tmp, filter.data(), size);
+      getGradXNaive(I_tmp, I_blur, derivativeFilter.data(), size);
+      return I_blur;
+    };
+
+    BENCHMARK("Benchmark gradient along X (ViSP)") {
+      vpImageFilter::getGradXGauss2D(I, I_blur, filter.data(), derivativeFilter.data(), size);
+      return I_blur;
+    };
+
+    BENCHMARK("Benchmark Gaussian pyramid (naive code)") {
+      getGaussPyramidalNaive(I, I_pyr);
+      return I_pyr;
+    };
+
+    BENCHMARK("Benchmark Gaussian pyramid (ViSP)") {
+      vpImageFilter::getGaussPyramidal(I, I_pyr);
+      return I_pyr;
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  // Initialize the random generator for reproducible values
+  srand(0);
+
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark comparing naive code and ViSP implementations");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
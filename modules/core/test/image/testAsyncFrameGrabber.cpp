@@ -0,0 +1,384 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the asynchronous frame grabber.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testAsyncFrameGrabber.cpp
+
+  \brief Test the asynchronous frame grabber reading an image sequence with
+  vpDiskGrabber, and compare the loop time with synchronous acquisitions.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <iostream>
+#include <vector>
+
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/io/vpAsyncFrameGrabber.h>
+#include <visp3/io/vpDiskGrabber.h>
+#include <visp3/io/vpImageIo.h>
+
+namespace
+{
+
+bool runBenchmark = false;
+
+const unsigned int nbImages = 30;
+
+std::string getOutputPath()
+{
+  std::string username;
+  vpIoTools::getUserName(username);
+#if defined(_WIN32)
+  std::string opath = vpIoTools::createFilePath("C:/temp", username);
+#else
+  std::string opath = vpIoTools::createFilePath("/tmp", username);
+#endif
+  opath = vpIoTools::createFilePath(opath, "test_async_frame_grabber");
+  vpIoTools::makeDirectory(opath);
+  return opath;
+}
+
+// The index of an image is its first pixel
+void generateImage(unsigned int index, vpImage<unsigned char> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I[i][j] = static_cast<unsigned char>((i * 3 + j * 7 + index) & 0xFF);
+    }
+  }
+}
+
+// Write the sequence read by vpDiskGrabber and return its generic name
+std::string writeSequence()
+{
+  const std::string pattern = getOutputPath() + "/image_%04d.pgm";
+  vpImage<unsigned char> I(48, 64);
+  for (unsigned int i = 0; i < nbImages; i++) {
+    char filename[FILENAME_MAX];
+    sprintf(filename, pattern.c_str(), i);
+    generateImage(i, I);
+    vpImageIo::write(I, filename);
+  }
+  return pattern;
+}
+
+void removeSequence(const std::string &pattern)
+{
+  for (unsigned int i = 0; i < nbImages; i++) {
+    char filename[FILENAME_MAX];
+    sprintf(filename, pattern.c_str(), i);
+    vpIoTools::remove(filename);
+  }
+}
+
+bool sameImage(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    if (I1.bitmap[i] != I2.bitmap[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void waitEndOfCapture(const vpAsyncFrameGrabber &g)
+{
+  while (g.isCapturing()) {
+    vpTime::wait(1);
+  }
+}
+
+// Emulate a camera that delivers an image every period ms
+class vpSlowGrabber : public vpFrameGrabber
+{
+public:
+  explicit vpSlowGrabber(double period) : m_period(period), m_index(0), m_I(480, 640) {}
+
+  void open(vpImage<unsigned char> &I)
+  {
+    m_index = 0;
+    I = m_I;
+    width = I.getWidth();
+    height = I.getHeight();
+    init = true;
+  }
+  void open(vpImage<vpRGBa> &I)
+  {
+    m_index = 0;
+    vpImageConvert::convert(m_I, I);
+    width = I.getWidth();
+    height = I.getHeight();
+    init = true;
+  }
+  void acquire(vpImage<unsigned char> &I)
+  {
+    vpTime::wait(m_period);
+    generateImage(m_index++, m_I);
+    I = m_I;
+  }
+  void acquire(vpImage<vpRGBa> &I)
+  {
+    vpTime::wait(m_period);
+    generateImage(m_index++, m_I);
+    vpImageConvert::convert(m_I, I);
+  }
+  void close() { init = false; }
+
+private:
+  double m_period;
+  unsigned int m_index;
+  vpImage<unsigned char> m_I;
+};
+
+} // namespace
+
+TEST_CASE("Deliver every frame", "[vpAsyncFrameGrabber]")
+{
+  const std::string pattern = writeSequence();
+  vpDiskGrabber reader;
+  reader.setGenericName(pattern);
+
+  vpAsyncFrameGrabber g(&reader);
+  g.setDeliveryMode(vpAsyncFrameGrabber::EVERY_FRAME);
+  g.setBufferSize(2);
+  vpImage<unsigned char> I, I_ref(48, 64);
+  g.open(I);
+  CHECK(g.isOpen());
+  CHECK(g.getHeight() == 48);
+  CHECK(g.getWidth() == 64);
+
+  // The capture thread waits when the buffers are filled
+  while (g.getNbFramesAvailable() < 2) {
+    vpTime::wait(1);
+  }
+  vpTime::wait(20);
+  CHECK(g.getNbFramesCaptured() == 2);
+  CHECK(g.getNbFramesAvailable() == 2);
+
+  double previous = 0;
+  for (unsigned int i = 0; i < nbImages; i++) {
+    double timestamp;
+    g.acquire(I, timestamp);
+    generateImage(i, I_ref);
+    CHECK(sameImage(I, I_ref));
+    CHECK(timestamp >= previous);
+    previous = timestamp;
+  }
+
+  // End of the sequence
+  CHECK_THROWS_AS(g.acquire(I), vpException);
+  CHECK_FALSE(g.isCapturing());
+  CHECK(g.getNbFramesCaptured() == nbImages);
+  CHECK(g.getNbFramesDropped() == 0);
+  g.close();
+  CHECK_FALSE(g.isOpen());
+  removeSequence(pattern);
+}
+
+TEST_CASE("Deliver the latest frame", "[vpAsyncFrameGrabber]")
+{
+  const std::string pattern = writeSequence();
+  vpDiskGrabber reader;
+  reader.setGenericName(pattern);
+
+  vpAsyncFrameGrabber g(&reader);
+  g.setBufferSize(3);
+  vpImage<unsigned char> I, I_ref(48, 64);
+
+  SECTION("The older frames are dropped")
+  {
+    g.open(I);
+    waitEndOfCapture(g);
+    g.acquire(I);
+    generateImage(nbImages - 1, I_ref);
+    CHECK(sameImage(I, I_ref));
+    CHECK(g.getNbFramesCaptured() == nbImages);
+    CHECK(g.getNbFramesDropped() == nbImages - 1);
+    CHECK_THROWS_AS(g.acquire(I), vpException);
+  }
+
+  SECTION("The frames are delivered in the capture order")
+  {
+    g.open(I);
+    unsigned int nbDelivered = 0;
+    int previous = -1;
+    try {
+      for (;;) {
+        g.acquire(I);
+        nbDelivered++;
+        const int index = I[0][0];
+        CHECK(index > previous);
+        previous = index;
+        vpTime::wait(2);
+      }
+    } catch (const vpException &) {
+    }
+    CHECK(previous == static_cast<int>(nbImages - 1));
+    CHECK(nbDelivered + g.getNbFramesDropped() == nbImages);
+  }
+  g.close();
+  removeSequence(pattern);
+}
+
+TEST_CASE("Convert the captured images", "[vpAsyncFrameGrabber]")
+{
+  const std::string pattern = writeSequence();
+  vpDiskGrabber reader;
+  reader.setGenericName(pattern);
+
+  vpAsyncFrameGrabber g(&reader);
+  g.setDeliveryMode(vpAsyncFrameGrabber::EVERY_FRAME);
+  vpImage<vpRGBa> Ic;
+  g.open(Ic);
+
+  // The images are read in color and converted back to grayscale
+  vpImage<unsigned char> I, I_ref(48, 64);
+  vpImage<vpRGBa> Ic_ref;
+  for (unsigned int i = 0; i < nbImages; i++) {
+    if (i % 2) {
+      g.acquire(I);
+    } else {
+      g.acquire(Ic);
+      vpImageConvert::convert(Ic, I);
+    }
+    generateImage(i, I_ref);
+    vpImageConvert::convert(I_ref, Ic_ref);
+    vpImageConvert::convert(Ic_ref, I_ref);
+    CHECK(sameImage(I, I_ref));
+  }
+  g.close();
+  removeSequence(pattern);
+}
+
+TEST_CASE("Report errors", "[vpAsyncFrameGrabber]")
+{
+  vpImage<unsigned char> I;
+  vpAsyncFrameGrabber g;
+  CHECK_THROWS_AS(g.open(I), vpException);
+  CHECK_THROWS_AS(g.acquire(I), vpException);
+
+  // The first image is read by open()
+  vpDiskGrabber reader;
+  reader.setGenericName(getOutputPath() + "/missing_%04d.pgm");
+  g.setFrameGrabber(&reader);
+  CHECK_THROWS_AS(g.open(I), vpException);
+  CHECK_FALSE(g.isOpen());
+
+  vpSlowGrabber camera(1);
+  g.setFrameGrabber(&camera);
+  g.open(I);
+  CHECK_THROWS_AS(g.open(I), vpException);
+  CHECK_THROWS_AS(g.setBufferSize(1), vpException);
+  CHECK_THROWS_AS(g.setDeliveryMode(vpAsyncFrameGrabber::EVERY_FRAME), vpException);
+  CHECK_THROWS_AS(g.setFrameGrabber(&reader), vpException);
+  g.acquire(I);
+  g.close();
+  CHECK_FALSE(camera.init);
+}
+
+TEST_CASE("Asynchronous frame grabber benchmark", "[benchmark]")
+{
+  if (runBenchmark) {
+    // A 30 Hz camera and a processing time of 20 ms per image
+    const double period = 33, processing = 20;
+    vpImage<unsigned char> I;
+
+    vpSlowGrabber camera(period);
+    camera.open(I);
+    BENCHMARK("vpFrameGrabber::acquire()")
+    {
+      camera.acquire(I);
+      vpTime::wait(processing);
+      return I[0][0];
+    };
+    camera.close();
+
+    vpAsyncFrameGrabber g(&camera);
+    g.open(I);
+    BENCHMARK("vpAsyncFrameGrabber::acquire()")
+    {
+      g.acquire(I);
+      vpTime::wait(processing);
+      return I[0][0];
+    };
+    g.close();
+    std::cout << "vpAsyncFrameGrabber: " << g.getNbFramesCaptured() << " frames captured, "
+              << g.getNbFramesDropped() << " dropped" << std::endl;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark comparing the loop time with synchronous acquisitions"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
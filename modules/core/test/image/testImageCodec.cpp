@@ -0,0 +1,438 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test in-memory image encoding and decoding.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageCodec.cpp
+
+  \brief Test in-memory JPEG, PNG and PGM/PPM encoding and decoding, and the
+  JPEG decoding at reduced resolution.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpImageCodec.h>
+#include <visp3/io/vpImageIo.h>
+
+namespace
+{
+
+bool runBenchmark = false;
+
+std::string getOutputPath()
+{
+  std::string username;
+  vpIoTools::getUserName(username);
+#if defined(_WIN32)
+  std::string opath = vpIoTools::createFilePath("C:/temp", username);
+#else
+  std::string opath = vpIoTools::createFilePath("/tmp", username);
+#endif
+  opath = vpIoTools::createFilePath(opath, "test_image_codec");
+  vpIoTools::makeDirectory(opath);
+  return opath;
+}
+
+std::vector<unsigned char> readFile(const std::string &filename)
+{
+  std::ifstream file(filename.c_str(), std::ios::binary);
+  return std::vector<unsigned char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Smooth image with some texture, that compresses well in JPEG
+void generateImage(vpImage<unsigned char> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      double v = 128 + 60 * std::sin(i / 23.0) * std::cos(j / 31.0) + 40 * std::sin((i + j) / 57.0);
+      I[i][j] = static_cast<unsigned char>(v);
+    }
+  }
+}
+
+void generateImage(vpImage<vpRGBa> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I[i][j] = vpRGBa(static_cast<unsigned char>(128 + 100 * std::sin(i / 29.0)),
+                       static_cast<unsigned char>(128 + 100 * std::cos(j / 37.0)),
+                       static_cast<unsigned char>(128 + 100 * std::sin((i + j) / 43.0)));
+    }
+  }
+}
+
+bool sameImage(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    if (I1.bitmap[i] != I2.bitmap[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool sameImage(const vpImage<vpRGBa> &I1, const vpImage<vpRGBa> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    if (I1.bitmap[i].R != I2.bitmap[i].R || I1.bitmap[i].G != I2.bitmap[i].G || I1.bitmap[i].B != I2.bitmap[i].B) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Mean absolute difference between an image decoded at reduced resolution and
+// the average of the corresponding blocks of the full resolution image
+double scaledDifference(const vpImage<unsigned char> &Ifull, const vpImage<unsigned char> &Iscaled,
+                        unsigned int scaleDenom)
+{
+  double diff = 0;
+  for (unsigned int i = 0; i < Iscaled.getHeight(); i++) {
+    for (unsigned int j = 0; j < Iscaled.getWidth(); j++) {
+      double sum = 0;
+      unsigned int count = 0;
+      for (unsigned int ii = i * scaleDenom; ii < std::min((i + 1) * scaleDenom, Ifull.getHeight()); ii++) {
+        for (unsigned int jj = j * scaleDenom; jj < std::min((j + 1) * scaleDenom, Ifull.getWidth()); jj++) {
+          sum += Ifull[ii][jj];
+          count++;
+        }
+      }
+      diff += std::fabs(sum / count - Iscaled[i][j]);
+    }
+  }
+  return diff / Iscaled.getSize();
+}
+} // namespace
+
+TEST_CASE("PGM and PPM in-memory encoding and decoding", "[image_codec]")
+{
+  const std::string opath = getOutputPath();
+  vpImageCodec codec;
+  std::vector<unsigned char> buffer;
+
+  vpImage<unsigned char> I(47, 61), I_decoded;
+  generateImage(I);
+  codec.encodePGM(I, buffer);
+  vpImageIo::writePGM(I, opath + "/codec.pgm");
+  CHECK(buffer == readFile(opath + "/codec.pgm"));
+  codec.decodePNM(I_decoded, &buffer[0], buffer.size());
+  CHECK(sameImage(I, I_decoded));
+
+  vpImage<vpRGBa> Ic(33, 19), Ic_decoded;
+  generateImage(Ic);
+  codec.encodePPM(Ic, buffer);
+  vpImageIo::writePPM(Ic, opath + "/codec.ppm");
+  CHECK(buffer == readFile(opath + "/codec.ppm"));
+  codec.decode(Ic_decoded, &buffer[0], buffer.size());
+  CHECK(sameImage(Ic, Ic_decoded));
+
+  // Conversions follow vpImageIo::readPPM() and vpImageIo::readPGM()
+  vpImage<unsigned char> I_ref;
+  vpImageIo::readPPM(I_ref, opath + "/codec.ppm");
+  codec.decode(I_decoded, &buffer[0], buffer.size());
+  CHECK(sameImage(I_ref, I_decoded));
+
+  // Header with comments
+  const std::string pgm = "P5\n# comment\n3 2 # width height\n255\n" + std::string("abcdef");
+  codec.decodePNM(I_decoded, reinterpret_cast<const unsigned char *>(pgm.c_str()), pgm.size());
+  REQUIRE(I_decoded.getWidth() == 3);
+  REQUIRE(I_decoded.getHeight() == 2);
+  CHECK(I_decoded[1][2] == 'f');
+
+  // Truncated data
+  CHECK_THROWS_AS(codec.decodePNM(I_decoded, reinterpret_cast<const unsigned char *>(pgm.c_str()), pgm.size() - 1),
+                  vpImageException);
+}
+
+TEST_CASE("PNG in-memory encoding and decoding", "[image_codec]")
+{
+  const std::string opath = getOutputPath();
+  vpImageCodec codec;
+  std::vector<unsigned char> buffer;
+
+  // The same codec is reused for images of different sizes
+  for (unsigned int size = 16; size <= 256; size *= 4) {
+    vpImage<unsigned char> I(size, size + 3), I_decoded;
+    generateImage(I);
+    codec.encodePNG(I, buffer);
+    codec.decodePNG(I_decoded, &buffer[0], buffer.size());
+    CHECK(sameImage(I, I_decoded));
+
+    vpImage<vpRGBa> Ic(size + 5, size), Ic_decoded;
+    generateImage(Ic);
+    codec.setPNGCompressionLevel(size == 16 ? 0 : 9);
+    codec.encodePNG(Ic, buffer);
+    codec.decode(Ic_decoded, &buffer[0], buffer.size());
+    CHECK(sameImage(Ic, Ic_decoded));
+  }
+
+  // Decoding a file written by vpImageIo gives the same image than vpImageIo::read()
+  vpImage<vpRGBa> Ic(120, 160);
+  generateImage(Ic);
+  vpImageIo::write(Ic, opath + "/codec.png");
+  buffer = readFile(opath + "/codec.png");
+  vpImage<unsigned char> I_ref, I_decoded;
+  vpImageIo::read(I_ref, opath + "/codec.png");
+  codec.decode(I_decoded, &buffer[0], buffer.size());
+  CHECK(sameImage(I_ref, I_decoded));
+  vpImage<vpRGBa> Ic_ref, Ic_decoded;
+  vpImageIo::read(Ic_ref, opath + "/codec.png");
+  codec.decodePNG(Ic_decoded, &buffer[0], buffer.size());
+  CHECK(sameImage(Ic_ref, Ic_decoded));
+
+  // Corrupted data
+  buffer.resize(buffer.size() / 2);
+  CHECK_THROWS_AS(codec.decodePNG(I_decoded, &buffer[0], buffer.size()), vpImageException);
+  buffer.assign(100, 0);
+  CHECK_THROWS_AS(codec.decodePNG(I_decoded, &buffer[0], buffer.size()), vpImageException);
+}
+
+TEST_CASE("JPEG in-memory encoding and decoding", "[image_codec]")
+{
+  const std::string opath = getOutputPath();
+  vpImageCodec codec;
+  std::vector<unsigned char> buffer;
+
+  vpImage<unsigned char> I(240, 320), I_ref, I_decoded;
+  generateImage(I);
+  vpImageIo::writeJPEG(I, opath + "/codec.jpg");
+  vpImageIo::readJPEG(I_ref, opath + "/codec.jpg");
+  codec.encodeJPEG(I, buffer);
+  codec.decodeJPEG(I_decoded, &buffer[0], buffer.size());
+  CHECK(sameImage(I_ref, I_decoded));
+
+  vpImage<vpRGBa> Ic(241, 319), Ic_ref, Ic_decoded;
+  generateImage(Ic);
+  vpImageIo::writeJPEG(Ic, opath + "/codec_color.jpg");
+  vpImageIo::readJPEG(Ic_ref, opath + "/codec_color.jpg");
+  codec.encodeJPEG(Ic, buffer);
+  codec.decode(Ic_decoded, &buffer[0], buffer.size());
+  CHECK(sameImage(Ic_ref, Ic_decoded));
+
+  // A lower quality gives a smaller buffer
+  size_t size75 = buffer.size();
+  codec.setJPEGQuality(20);
+  CHECK(codec.getJPEGQuality() == 20);
+  codec.encodeJPEG(Ic, buffer);
+  CHECK(buffer.size() < size75);
+  CHECK_THROWS_AS(codec.setJPEGQuality(101), vpException);
+
+  // Errors are reported by exceptions and the codec remains usable
+  std::vector<unsigned char> truncated(buffer.begin(), buffer.begin() + buffer.size() / 2);
+  CHECK_THROWS_AS(codec.decodeJPEG(Ic_decoded, &truncated[0], truncated.size()), vpImageException);
+  std::vector<unsigned char> garbage(1000, 0xFF);
+  CHECK_THROWS_AS(codec.decodeJPEG(I_decoded, &garbage[0], garbage.size()), vpImageException);
+  CHECK_THROWS_AS(codec.decodeJPEG(I_decoded, &buffer[0], buffer.size(), 3), vpException);
+  vpImage<unsigned char> I_empty;
+  CHECK_THROWS_AS(codec.encodeJPEG(I_empty, truncated), vpImageException);
+  codec.decodeJPEG(Ic_decoded, &buffer[0], buffer.size());
+  CHECK(Ic_decoded.getWidth() == Ic.getWidth());
+  CHECK(Ic_decoded.getHeight() == Ic.getHeight());
+}
+
+TEST_CASE("JPEG decoding at reduced resolution", "[image_codec]")
+{
+  vpImageCodec codec;
+  std::vector<unsigned char> buffer;
+  vpImage<unsigned char> I(483, 645), Ifull;
+  generateImage(I);
+  codec.setJPEGQuality(95);
+  codec.encodeJPEG(I, buffer);
+  codec.decodeJPEG(Ifull, &buffer[0], buffer.size());
+
+  vpImage<vpRGBa> Ic(483, 645), Ic_full;
+  generateImage(Ic);
+  std::vector<unsigned char> buffer_color;
+  codec.encodeJPEG(Ic, buffer_color);
+  codec.decodeJPEG(Ic_full, &buffer_color[0], buffer_color.size());
+  vpImage<unsigned char> Ic_full_gray;
+  vpImageConvert::convert(Ic_full, Ic_full_gray);
+
+  for (unsigned int scaleDenom = 1; scaleDenom <= 8; scaleDenom *= 2) {
+    unsigned int width = 0, height = 0;
+    vpImageCodec::getJPEGScaledSize(I.getWidth(), I.getHeight(), scaleDenom, width, height);
+    CHECK(width == (I.getWidth() + scaleDenom - 1) / scaleDenom);
+    CHECK(height == (I.getHeight() + scaleDenom - 1) / scaleDenom);
+
+    vpImage<unsigned char> Iscaled;
+    codec.decodeJPEG(Iscaled, &buffer[0], buffer.size(), scaleDenom);
+    REQUIRE(Iscaled.getWidth() == width);
+    REQUIRE(Iscaled.getHeight() == height);
+    double diff = scaledDifference(Ifull, Iscaled, scaleDenom);
+    INFO("Scale 1/" << scaleDenom << ": mean difference with the block average " << diff);
+    CHECK(diff < 1.0);
+
+    vpImage<vpRGBa> Ic_scaled;
+    vpImage<unsigned char> Ic_scaled_gray;
+    codec.decodeJPEG(Ic_scaled, &buffer_color[0], buffer_color.size(), scaleDenom);
+    REQUIRE(Ic_scaled.getWidth() == width);
+    REQUIRE(Ic_scaled.getHeight() == height);
+    vpImageConvert::convert(Ic_scaled, Ic_scaled_gray);
+    diff = scaledDifference(Ic_full_gray, Ic_scaled_gray, scaleDenom);
+    INFO("Color scale 1/" << scaleDenom << ": mean difference with the block average " << diff);
+    CHECK(diff < 1.0);
+  }
+}
+
+TEST_CASE("vpImageIo in-memory encoding and decoding", "[image_codec]")
+{
+  vpImage<vpRGBa> Ic(64, 80), Ic_decoded;
+  generateImage(Ic);
+  std::vector<unsigned char> buffer;
+
+  const char *formats[] = {"ppm", ".png", "image.PNG"};
+  for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+    vpImageIo::encode(Ic, formats[i], buffer);
+    vpImageIo::decode(Ic_decoded, &buffer[0], buffer.size());
+    CHECK(sameImage(Ic, Ic_decoded));
+  }
+
+  vpImage<unsigned char> I(64, 80), I_decoded;
+  generateImage(I);
+  vpImageIo::encode(I, "pgm", buffer);
+  CHECK(buffer[0] == 'P');
+  CHECK(buffer[1] == '5');
+  vpImageIo::decode(I_decoded, &buffer[0], buffer.size());
+  CHECK(sameImage(I, I_decoded));
+  vpImageIo::encode(I, "jpeg", buffer);
+  vpImageIo::decode(I_decoded, &buffer[0], buffer.size());
+  CHECK(I_decoded.getSize() == I.getSize());
+
+  CHECK_THROWS_AS(vpImageIo::encode(I, "tiff", buffer), vpImageException);
+  buffer.assign(16, 'x');
+  CHECK_THROWS_AS(vpImageIo::decode(I_decoded, &buffer[0], buffer.size()), vpImageException);
+}
+
+TEST_CASE("Benchmark in-memory JPEG decoding", "[benchmark]")
+{
+  if (runBenchmark) {
+    vpImage<vpRGBa> Ic(1080, 1920);
+    generateImage(Ic);
+    vpImageCodec codec;
+    std::vector<unsigned char> buffer;
+    codec.encodeJPEG(Ic, buffer);
+    const std::string filename = getOutputPath() + "/codec_benchmark.jpg";
+    vpImageIo::writeJPEG(Ic, filename);
+
+    vpImage<unsigned char> I, I_preview;
+    BENCHMARK("vpImageIo::readJPEG() 1920x1080")
+    {
+      vpImageIo::readJPEG(I, filename);
+      return I;
+    };
+
+    BENCHMARK("vpImageCodec::decodeJPEG() 1920x1080")
+    {
+      codec.decodeJPEG(I, &buffer[0], buffer.size());
+      return I;
+    };
+
+    BENCHMARK("Full decoding + vpImageTools::resize() 480x270")
+    {
+      codec.decodeJPEG(I, &buffer[0], buffer.size());
+      vpImageTools::resize(I, I_preview, 480, 270, vpImageTools::INTERPOLATION_LINEAR);
+      return I_preview;
+    };
+
+    BENCHMARK("vpImageCodec::decodeJPEG() at 1/4 480x270")
+    {
+      codec.decodeJPEG(I_preview, &buffer[0], buffer.size(), 4);
+      return I_preview;
+    };
+
+    std::vector<unsigned char> encoded;
+    BENCHMARK("vpImageIo::writeJPEG() 1920x1080")
+    {
+      vpImageIo::writeJPEG(Ic, filename);
+      return filename;
+    };
+
+    BENCHMARK("vpImageCodec::encodeJPEG() 1920x1080")
+    {
+      codec.encodeJPEG(Ic, encoded);
+      return encoded.size();
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark comparing in-memory and file JPEG decoding"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
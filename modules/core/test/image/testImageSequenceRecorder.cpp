@@ -0,0 +1,321 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test asynchronous recording of image sequences.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageSequenceRecorder.cpp
+
+  \brief Test the asynchronous image sequence recorder, and compare the time
+  spent in saveFrame() with vpVideoWriter.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <iostream>
+#include <vector>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/io/vpImageIo.h>
+#include <visp3/io/vpImageSequenceRecorder.h>
+#include <visp3/io/vpVideoWriter.h>
+
+namespace
+{
+
+bool runBenchmark = false;
+
+std::string getOutputPath()
+{
+  std::string username;
+  vpIoTools::getUserName(username);
+#if defined(_WIN32)
+  std::string opath = vpIoTools::createFilePath("C:/temp", username);
+#else
+  std::string opath = vpIoTools::createFilePath("/tmp", username);
+#endif
+  opath = vpIoTools::createFilePath(opath, "test_image_sequence_recorder");
+  vpIoTools::makeDirectory(opath);
+  return opath;
+}
+
+std::string getFrameName(const std::string &pattern, unsigned int index)
+{
+  char name[FILENAME_MAX];
+  sprintf(name, pattern.c_str(), index);
+  return std::string(name);
+}
+
+void generateImage(unsigned int index, vpImage<unsigned char> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I[i][j] = static_cast<unsigned char>((i * 3 + j * 7 + index * 11) & 0xFF);
+    }
+  }
+}
+
+void generateImage(unsigned int index, vpImage<vpRGBa> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I[i][j] = vpRGBa(static_cast<unsigned char>((i + index) & 0xFF), static_cast<unsigned char>((j + index) & 0xFF),
+                       static_cast<unsigned char>((i * j + index) & 0xFF));
+    }
+  }
+}
+
+bool sameImage(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    if (I1.bitmap[i] != I2.bitmap[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool sameImage(const vpImage<vpRGBa> &I1, const vpImage<vpRGBa> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    if (I1.bitmap[i].R != I2.bitmap[i].R || I1.bitmap[i].G != I2.bitmap[i].G || I1.bitmap[i].B != I2.bitmap[i].B) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class Type> void checkSequence(const std::string &pattern, unsigned int nbThreads)
+{
+  const unsigned int firstFrame = 5, nbFrames = 40, queueSize = 4;
+  vpImageSequenceRecorder recorder;
+  recorder.setFileName(pattern);
+  recorder.setFirstFrameIndex(firstFrame);
+  recorder.setNbThreads(nbThreads);
+  recorder.setQueueSize(queueSize);
+  recorder.open();
+  CHECK(recorder.isOpen());
+
+  vpImage<Type> I(48, 64);
+  for (unsigned int i = 0; i < nbFrames; i++) {
+    generateImage(i, I);
+    CHECK(recorder.saveFrame(I));
+    CHECK(recorder.getQueueDepth() <= queueSize);
+  }
+  recorder.close();
+  CHECK_FALSE(recorder.isOpen());
+
+  CHECK(recorder.getCurrentFrameIndex() == firstFrame + nbFrames);
+  CHECK(recorder.getNbFramesWritten() == nbFrames);
+  CHECK(recorder.getNbFramesDropped() == 0);
+  CHECK(recorder.getQueueDepth() == 0);
+  CHECK(recorder.getMaxQueueDepth() >= 1);
+  CHECK(recorder.getMaxQueueDepth() <= queueSize);
+  CHECK(recorder.getMeanEncodeLatency() <= recorder.getMaxEncodeLatency());
+
+  // Each image is written in the file of its index, whatever the number of encoders
+  vpImage<Type> I_ref(48, 64), I_read;
+  for (unsigned int i = 0; i < nbFrames; i++) {
+    const std::string filename = getFrameName(pattern, firstFrame + i);
+    REQUIRE(vpIoTools::checkFilename(filename));
+    generateImage(i, I_ref);
+    vpImageIo::read(I_read, filename);
+    CHECK(sameImage(I_read, I_ref));
+    vpIoTools::remove(filename);
+  }
+}
+
+} // namespace
+
+TEST_CASE("Record a sequence with several encoders", "[vpImageSequenceRecorder]")
+{
+  const std::string opath = getOutputPath();
+
+  SECTION("Grayscale PGM, 1 encoder") { checkSequence<unsigned char>(opath + "/gray_%04d.pgm", 1); }
+  SECTION("Grayscale PGM, 3 encoders") { checkSequence<unsigned char>(opath + "/gray_%04d.pgm", 3); }
+  SECTION("Color PPM, 3 encoders") { checkSequence<vpRGBa>(opath + "/color_%04d.ppm", 3); }
+#if defined(VISP_HAVE_PNG)
+  SECTION("Color PNG, 3 encoders") { checkSequence<vpRGBa>(opath + "/color_%04d.png", 3); }
+#endif
+}
+
+TEST_CASE("Drop frames when the queue is full", "[vpImageSequenceRecorder]")
+{
+  const std::string pattern = getOutputPath() + "/drop_%04d.pgm";
+  const unsigned int nbFrames = 50;
+
+  vpImageSequenceRecorder recorder;
+  recorder.setFileName(pattern);
+  recorder.setNbThreads(1);
+  recorder.setQueueSize(1);
+  recorder.setBackpressurePolicy(vpImageSequenceRecorder::DROP_POLICY);
+  recorder.open();
+
+  vpImage<unsigned char> I(480, 640);
+  std::vector<bool> queued(nbFrames);
+  for (unsigned int i = 0; i < nbFrames; i++) {
+    generateImage(i, I);
+    queued[i] = recorder.saveFrame(I);
+  }
+  recorder.close();
+
+  CHECK(queued[0]);
+  CHECK(recorder.getCurrentFrameIndex() == nbFrames);
+  CHECK(recorder.getNbFramesWritten() + recorder.getNbFramesDropped() == nbFrames);
+  CHECK(recorder.getMaxQueueDepth() == 1);
+
+  // A dropped frame keeps its index, no file is written for it
+  unsigned int nbWritten = 0;
+  for (unsigned int i = 0; i < nbFrames; i++) {
+    const std::string filename = getFrameName(pattern, i);
+    const bool wasQueued = queued[i];
+    CHECK(vpIoTools::checkFilename(filename) == wasQueued);
+    if (wasQueued) {
+      nbWritten++;
+      vpIoTools::remove(filename);
+    }
+  }
+  CHECK(nbWritten == recorder.getNbFramesWritten());
+}
+
+TEST_CASE("Report errors", "[vpImageSequenceRecorder]")
+{
+  vpImageSequenceRecorder recorder;
+  CHECK_THROWS_AS(recorder.open(), vpException);
+  CHECK_THROWS_AS(recorder.setFileName("video.mpeg"), vpException);
+
+  vpImage<unsigned char> I(10, 10, 0);
+  CHECK_THROWS_AS(recorder.saveFrame(I), vpException);
+
+  // The directory doesn't exist, the encoding error is reported by close()
+  recorder.setFileName(getOutputPath() + "/missing_directory/image_%04d.pgm");
+  recorder.open();
+  CHECK_THROWS_AS(recorder.setNbThreads(4), vpException);
+  CHECK(recorder.saveFrame(I));
+  CHECK_THROWS_AS(recorder.close(), vpException);
+  CHECK_FALSE(recorder.isOpen());
+}
+
+TEST_CASE("Image sequence recorder benchmark", "[benchmark]")
+{
+  if (runBenchmark) {
+    const std::string opath = getOutputPath();
+#if defined(VISP_HAVE_PNG)
+    const std::string extension = "png";
+#else
+    const std::string extension = "pgm";
+#endif
+    vpImage<unsigned char> I(720, 1280);
+    generateImage(0, I);
+
+    // Emulate a 100 Hz loop, the images are written by the loop
+    vpVideoWriter writer;
+    writer.setFileName(opath + "/writer_%04d." + extension);
+    writer.open(I);
+    BENCHMARK("vpVideoWriter::saveFrame()")
+    {
+      vpTime::wait(10);
+      writer.resetFrameCounter();
+      writer.saveFrame(I);
+      return writer.getCurrentFrameIndex();
+    };
+    writer.close();
+    vpIoTools::remove(writer.getFrameName(0));
+
+    // Emulate a 100 Hz loop, the images are written by 2 threads in the background
+    vpImageSequenceRecorder recorder;
+    recorder.setFileName(opath + "/recorder_%04d." + extension);
+    recorder.setBackpressurePolicy(vpImageSequenceRecorder::DROP_POLICY);
+    recorder.open();
+    unsigned int index = 0;
+    BENCHMARK("vpImageSequenceRecorder::saveFrame()")
+    {
+      vpTime::wait(10);
+      return recorder.saveFrame(I);
+    };
+    index = recorder.getCurrentFrameIndex();
+    recorder.close();
+    std::cout << "vpImageSequenceRecorder: " << recorder.getNbFramesWritten() << " frames written, "
+              << recorder.getNbFramesDropped() << " dropped, max queue depth " << recorder.getMaxQueueDepth()
+              << ", encode latency " << recorder.getMeanEncodeLatency() << " ms (max "
+              << recorder.getMaxEncodeLatency() << " ms)" << std::endl;
+    for (unsigned int i = 0; i < index; i++) {
+      vpIoTools::remove(getFrameName(opath + "/recorder_%04d." + extension, i));
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark comparing the time spent in saveFrame() with vpVideoWriter"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
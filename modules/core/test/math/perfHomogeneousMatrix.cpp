@@ -0,0 +1,308 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark homogeneous matrix operations.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpFixedHomogeneousMatrix.h>
+#include <visp3/core/vpFixedVelocityTwistMatrix.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpVelocityTwistMatrix.h>
+
+namespace
+{
+
+bool runBenchmark = false;
+
+double getRandomValues(double min, double max)
+{
+  return (max - min) * ((double)rand() / (double)RAND_MAX) + min;
+}
+
+vpHomogeneousMatrix generateRandomPose()
+{
+  vpTranslationVector t(getRandomValues(-1, 1), getRandomValues(-1, 1), getRandomValues(-1, 1));
+  vpThetaUVector tu(getRandomValues(-M_PI, M_PI) / 2, getRandomValues(-M_PI, M_PI) / 2,
+                    getRandomValues(-M_PI, M_PI) / 2);
+  return vpHomogeneousMatrix(t, tu);
+}
+
+template <typename Type> bool equalMatrix(const vpArray2D<Type> &A, const vpArray2D<Type> &B, double tol = 1e-9)
+{
+  if (A.getRows() != B.getRows() || A.getCols() != B.getCols()) {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < A.getRows(); i++) {
+    for (unsigned int j = 0; j < A.getCols(); j++) {
+      if (!vpMath::equal(A[i][j], B[i][j], tol)) {
+        std::cerr << "Error: A[" << i << "][" << j << "]=" << A[i][j] << " != B[" << i << "][" << j
+                  << "]=" << B[i][j] << std::endl;
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Copy of the former vpHomogeneousMatrix::operator*() that uses temporaries
+vpHomogeneousMatrix compose_regular(const vpHomogeneousMatrix &aMb, const vpHomogeneousMatrix &bMc)
+{
+  vpHomogeneousMatrix p;
+
+  vpRotationMatrix R1, R2, R;
+  vpTranslationVector T1, T2, T;
+
+  aMb.extract(T1);
+  bMc.extract(T2);
+
+  aMb.extract(R1);
+  bMc.extract(R2);
+
+  R = R1 * R2;
+
+  T = R1 * T2 + T1;
+
+  p.insert(T);
+  p.insert(R);
+
+  return p;
+}
+
+// Copy of the former vpHomogeneousMatrix::inverse() that uses temporaries
+vpHomogeneousMatrix inverse_regular(const vpHomogeneousMatrix &M)
+{
+  vpHomogeneousMatrix Mi;
+
+  vpRotationMatrix R;
+  M.extract(R);
+  vpTranslationVector T;
+  M.extract(T);
+
+  vpTranslationVector RtT;
+  RtT = -(R.t() * T);
+
+  Mi.insert(R.t());
+  Mi.insert(RtT);
+
+  return Mi;
+}
+}
+
+TEST_CASE("Fixed-size transformations", "[transformation]") {
+  for (int iter = 0; iter < 10; iter++) {
+    vpHomogeneousMatrix aMb = generateRandomPose(), bMc = generateRandomPose();
+
+    vpHomogeneousMatrix aMc_true = compose_regular(aMb, bMc);
+    CHECK(equalMatrix(aMb * bMc, aMc_true));
+    vpHomogeneousMatrix aMc = aMb;
+    aMc *= bMc;
+    CHECK(equalMatrix(aMc, aMc_true));
+    vpHomogeneousMatrix aMc_fixed = vpFixedHomogeneousMatrix(aMb) * vpFixedHomogeneousMatrix(bMc);
+    CHECK(equalMatrix(aMc_fixed, aMc_true));
+
+    vpHomogeneousMatrix bMa_true = inverse_regular(aMb);
+    CHECK(equalMatrix(aMb.inverse(), bMa_true));
+    vpHomogeneousMatrix bMa = aMb;
+    bMa.inverse(bMa);
+    CHECK(equalMatrix(bMa, bMa_true));
+    vpHomogeneousMatrix bMa_fixed = vpFixedHomogeneousMatrix(aMb).inverse();
+    CHECK(equalMatrix(bMa_fixed, bMa_true));
+
+    vpTranslationVector t;
+    vpThetaUVector tu;
+    aMb.extract(t);
+    aMb.extract(tu);
+    vpHomogeneousMatrix aMb_fixed = vpFixedHomogeneousMatrix(vpFixedTranslationVector(t), vpFixedThetaUVector(tu));
+    CHECK(equalMatrix(aMb_fixed, aMb));
+
+    vpTranslationVector b_p(0.1, -0.2, 0.3);
+    vpTranslationVector a_p = vpFixedHomogeneousMatrix(aMb) * vpFixedTranslationVector(b_p);
+    CHECK(equalMatrix(a_p, aMb * b_p));
+
+    vpVelocityTwistMatrix aVb(aMb), bVc(bMc);
+    vpVelocityTwistMatrix aVc = vpFixedVelocityTwistMatrix(aVb) * vpFixedVelocityTwistMatrix(bVc);
+    CHECK(equalMatrix(aVc, aVb * bVc));
+    vpVelocityTwistMatrix aVb_fixed = vpFixedVelocityTwistMatrix(vpFixedHomogeneousMatrix(aMb));
+    CHECK(equalMatrix(aVb_fixed, aVb));
+
+    vpColVector v(6);
+    for (unsigned int i = 0; i < 6; i++) {
+      v[i] = getRandomValues(-1, 1);
+    }
+    CHECK(equalMatrix(vpFixedVelocityTwistMatrix(aVb) * v, aVb * v));
+
+    vpHomogeneousMatrix M_true = vpExponentialMap::direct(v, 0.04);
+    vpHomogeneousMatrix M;
+    vpExponentialMap::direct(v, 0.04, M);
+    CHECK(equalMatrix(M, M_true));
+    CHECK(equalMatrix(vpExponentialMap::inverse(M, 0.04), v));
+  }
+}
+
+TEST_CASE("Benchmark homogeneous matrix operations", "[benchmark]") {
+  if (runBenchmark) {
+    // Pose chain of a camera mounted on a robot end-effector
+    const unsigned int nbPoses = 6;
+    std::vector<vpHomogeneousMatrix> poses;
+    std::vector<vpFixedHomogeneousMatrix> fixedPoses;
+    for (unsigned int i = 0; i < nbPoses; i++) {
+      poses.push_back(generateRandomPose());
+      fixedPoses.push_back(vpFixedHomogeneousMatrix(poses.back()));
+    }
+
+    vpHomogeneousMatrix M_true;
+    BENCHMARK("Pose chain - Naive code") {
+      M_true.eye();
+      for (unsigned int i = 0; i < nbPoses; i++) {
+        M_true = compose_regular(M_true, poses[i]);
+      }
+      return M_true;
+    };
+
+    vpHomogeneousMatrix M;
+    BENCHMARK("Pose chain - ViSP") {
+      M.eye();
+      for (unsigned int i = 0; i < nbPoses; i++) {
+        M *= poses[i];
+      }
+      return M;
+    };
+    REQUIRE(equalMatrix(M, M_true));
+
+    vpFixedHomogeneousMatrix M_fixed;
+    BENCHMARK("Pose chain - ViSP fixed-size") {
+      M_fixed.eye();
+      for (unsigned int i = 0; i < nbPoses; i++) {
+        M_fixed *= fixedPoses[i];
+      }
+      return M_fixed;
+    };
+    REQUIRE(equalMatrix(vpHomogeneousMatrix(M_fixed), M_true));
+
+    vpHomogeneousMatrix Mi_true;
+    BENCHMARK("Inverse - Naive code") {
+      Mi_true = inverse_regular(poses[0]);
+      return Mi_true;
+    };
+
+    vpHomogeneousMatrix Mi;
+    BENCHMARK("Inverse - ViSP") {
+      poses[0].inverse(Mi);
+      return Mi;
+    };
+    REQUIRE(equalMatrix(Mi, Mi_true));
+
+    vpFixedHomogeneousMatrix Mi_fixed;
+    BENCHMARK("Inverse - ViSP fixed-size") {
+      Mi_fixed = fixedPoses[0].inverse();
+      return Mi_fixed;
+    };
+    REQUIRE(equalMatrix(vpHomogeneousMatrix(Mi_fixed), Mi_true));
+
+    vpColVector v(6);
+    for (unsigned int i = 0; i < 6; i++) {
+      v[i] = getRandomValues(-1, 1);
+    }
+
+    vpHomogeneousMatrix dM_true;
+    BENCHMARK("Exponential map - ViSP") {
+      dM_true = vpExponentialMap::direct(v, 0.04);
+      return dM_true;
+    };
+
+    vpHomogeneousMatrix dM;
+    BENCHMARK("Exponential map - ViSP in-place") {
+      vpExponentialMap::direct(v, 0.04, dM);
+      return dM;
+    };
+    REQUIRE(equalMatrix(dM, dM_true));
+
+    vpVelocityTwistMatrix aVb(poses[0]), bVc(poses[1]), aVc_true;
+    BENCHMARK("Velocity twist product - ViSP") {
+      aVc_true = aVb * bVc;
+      return aVc_true;
+    };
+
+    vpFixedVelocityTwistMatrix aVb_fixed(aVb), bVc_fixed(bVc), aVc_fixed;
+    BENCHMARK("Velocity twist product - ViSP fixed-size") {
+      aVc_fixed = aVb_fixed * bVc_fixed;
+      return aVc_fixed;
+    };
+    REQUIRE(equalMatrix(vpVelocityTwistMatrix(aVc_fixed), aVc_true));
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  // Initialize the random generator for reproducible values
+  srand(0);
+
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark comparing naive code with ViSP implementation");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,326 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark and check the M-estimator weights of vpRobust.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfRobust.cpp
+
+  \brief Check that the weights computed by vpRobust are identical to the ones
+  of the original implementation based on a recursive quickselect and scalar
+  influence functions, and benchmark both implementations.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+#include <visp3/core/vpGaussRand.h>
+#include <visp3/core/vpRobust.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+
+bool g_runBenchmark = false;
+
+// Original vpRobust implementation used as reference
+class vpRobustReference
+{
+public:
+  vpRobustReference() : m_normres(), m_sorted_normres(), m_sorted_residues(), m_noiseThreshold(0.0017) {}
+
+  void MEstimator(vpRobust::vpRobustEstimatorType method, const vpColVector &residues, vpColVector &weights)
+  {
+    unsigned int n_data = residues.getRows();
+    m_normres.resize(n_data);
+    m_sorted_normres.resize(n_data);
+    m_sorted_residues = residues;
+
+    unsigned int ind_med = (unsigned int)(ceil(n_data / 2.0)) - 1;
+    double med = select(m_sorted_residues, 0, (int)n_data - 1, (int)ind_med);
+    for (unsigned int i = 0; i < n_data; i++) {
+      m_normres[i] = (fabs(residues[i] - med));
+      m_sorted_normres[i] = (fabs(m_sorted_residues[i] - med));
+    }
+    double normmedian = select(m_sorted_normres, 0, (int)n_data - 1, (int)ind_med);
+    double sigma = 1.4826 * normmedian;
+    if (sigma < m_noiseThreshold) {
+      sigma = m_noiseThreshold;
+    }
+
+    switch (method) {
+    case vpRobust::TUKEY:
+      psiTukey(sigma, m_normres, weights);
+      break;
+    case vpRobust::CAUCHY:
+      psiCauchy(sigma, m_normres, weights);
+      break;
+    case vpRobust::HUBER:
+      psiHuber(sigma, m_normres, weights);
+      break;
+    }
+  }
+
+private:
+  void psiTukey(double sig, const vpColVector &x, vpColVector &weights)
+  {
+    double cst_const = 4.6851;
+    for (unsigned int i = 0; i < x.getRows(); i++) {
+      if (std::fabs(sig) <= std::numeric_limits<double>::epsilon() &&
+          std::fabs(weights[i]) > std::numeric_limits<double>::epsilon()) {
+        weights[i] = 1;
+        continue;
+      }
+      double xi_sig = x[i] / sig;
+      if ((std::fabs(xi_sig) <= (cst_const)) && std::fabs(weights[i]) > std::numeric_limits<double>::epsilon()) {
+        weights[i] = vpMath::sqr(1 - vpMath::sqr(xi_sig / cst_const));
+      } else {
+        weights[i] = 0;
+      }
+    }
+  }
+
+  void psiHuber(double sig, const vpColVector &x, vpColVector &weights)
+  {
+    double c = 1.2107;
+    for (unsigned int i = 0; i < x.getRows(); i++) {
+      if (std::fabs(weights[i]) > std::numeric_limits<double>::epsilon()) {
+        double xi_sig = x[i] / sig;
+        if (fabs(xi_sig) <= c)
+          weights[i] = 1;
+        else
+          weights[i] = c / fabs(xi_sig);
+      }
+    }
+  }
+
+  void psiCauchy(double sig, const vpColVector &x, vpColVector &weights)
+  {
+    double const_sig = 2.3849 * sig;
+    for (unsigned int i = 0; i < x.getRows(); i++) {
+      weights[i] = 1 / (1 + vpMath::sqr(x[i] / (const_sig)));
+    }
+  }
+
+  int partition(vpColVector &a, int l, int r)
+  {
+    int i = l - 1;
+    int j = r;
+    double v = a[(unsigned int)r];
+
+    for (;;) {
+      while (a[(unsigned int)++i] < v)
+        ;
+      while (v < a[(unsigned int)--j])
+        if (j == l)
+          break;
+      if (i >= j)
+        break;
+      std::swap(a[(unsigned int)i], a[(unsigned int)j]);
+    }
+    std::swap(a[(unsigned int)i], a[(unsigned int)r]);
+    return i;
+  }
+
+  double select(vpColVector &a, int l, int r, int k)
+  {
+    while (r > l) {
+      int i = partition(a, l, r);
+      if (i >= k)
+        r = i - 1;
+      if (i <= k)
+        l = i + 1;
+    }
+    return a[(unsigned int)k];
+  }
+
+  vpColVector m_normres;
+  vpColVector m_sorted_normres;
+  vpColVector m_sorted_residues;
+  double m_noiseThreshold;
+};
+
+// Gaussian residues with a proportion of outliers
+vpColVector generateResidues(unsigned int size, double outlierRatio, long seed)
+{
+  vpGaussRand noise(0.5, 0.1, seed);
+  vpUniRand uniform(seed);
+  vpColVector residues(size);
+  for (unsigned int i = 0; i < size; i++) {
+    residues[i] = uniform() < outlierRatio ? uniform.uniform(-20.0, 20.0) : noise();
+  }
+  return residues;
+}
+
+bool sameWeights(const vpColVector &w1, const vpColVector &w2)
+{
+  return w1.getRows() == w2.getRows() && memcmp(w1.data, w2.data, w1.getRows() * sizeof(double)) == 0;
+}
+} // namespace
+
+TEST_CASE("vpRobust weights are identical to the reference implementation", "[robust]")
+{
+  const vpRobust::vpRobustEstimatorType methods[] = {vpRobust::TUKEY, vpRobust::CAUCHY, vpRobust::HUBER};
+  const unsigned int sizes[] = {1, 2, 3, 17, 1000, 10001};
+
+  for (size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); m++) {
+    vpRobust robust;
+    vpRobustReference reference;
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+      vpColVector residues = generateResidues(sizes[s], 0.2, static_cast<long>(s + 1));
+      const vpColVector residues_copy = residues;
+      vpColVector w(sizes[s], 1), w_ref(sizes[s], 1);
+
+      // Several iterations, rejected points remain rejected with Tukey and Huber
+      for (int iter = 0; iter < 3; iter++) {
+        robust.MEstimator(methods[m], residues, w);
+        reference.MEstimator(methods[m], residues, w_ref);
+        INFO("Method " << methods[m] << ", " << sizes[s] << " residues, iteration " << iter);
+        CHECK(sameWeights(w, w_ref));
+        residues *= 0.5;
+      }
+      // The residues are not modified
+      CHECK(sameWeights(residues, residues_copy * 0.125));
+    }
+  }
+
+  // Noise threshold reached: identical residues
+  vpRobust robust;
+  vpRobustReference reference;
+  vpColVector residues(100, 1.0), w(100, 1), w_ref(100, 1);
+  w[3] = w_ref[3] = 0;
+  robust.MEstimator(vpRobust::TUKEY, residues, w);
+  reference.MEstimator(vpRobust::TUKEY, residues, w_ref);
+  CHECK(sameWeights(w, w_ref));
+  CHECK(w[3] == 0);
+}
+
+TEST_CASE("vpRobust with weights of the previous iteration", "[robust]")
+{
+  vpColVector residues = generateResidues(5000, 0.3, 42);
+  vpColVector weights(residues.getRows(), 1);
+  for (unsigned int i = 0; i < weights.getRows(); i += 7) {
+    weights[i] = 0;
+  }
+
+  vpRobust robust;
+  robust.setThreshold(0);
+  vpColVector w = weights;
+  robust.MEstimator(vpRobust::TUKEY, residues, residues, w);
+  for (unsigned int i = 0; i < w.getRows(); i += 7) {
+    CHECK(w[i] == 0);
+  }
+  for (unsigned int i = 0; i < w.getRows(); i++) {
+    CHECK(w[i] >= 0);
+    CHECK(w[i] <= 1);
+  }
+}
+
+TEST_CASE("Benchmark vpRobust", "[benchmark]")
+{
+  if (g_runBenchmark) {
+    const unsigned int sizes[] = {1000, 10000, 100000};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+      const vpColVector residues = generateResidues(sizes[s], 0.2, 1);
+      vpColVector w(sizes[s], 1), w_ref(sizes[s], 1);
+      vpRobust robust;
+      vpRobustReference reference;
+
+      std::ostringstream oss;
+      oss << "Reference Tukey - " << sizes[s] << " residues";
+      BENCHMARK(oss.str().c_str())
+      {
+        reference.MEstimator(vpRobust::TUKEY, residues, w_ref);
+        return w_ref;
+      };
+
+      oss.str("");
+      oss << "vpRobust Tukey - " << sizes[s] << " residues";
+      BENCHMARK(oss.str().c_str())
+      {
+        robust.MEstimator(vpRobust::TUKEY, residues, w);
+        return w;
+      };
+
+      oss.str("");
+      oss << "vpRobust Huber - " << sizes[s] << " residues";
+      BENCHMARK(oss.str().c_str())
+      {
+        robust.MEstimator(vpRobust::HUBER, residues, w);
+        return w;
+      };
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli() // Get Catch's composite command line parser
+    | Opt(g_runBenchmark)  // bind variable to a new option, with a hint string
+    ["--benchmark"]        // the option names it will respond to
+    ("run benchmark?");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,136 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test vpPointCloud.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testPointCloud.cpp
+
+  \brief Test organized point cloud with contiguous coordinates.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpPointCloud.h>
+
+TEST_CASE("Owned coordinates", "[vpPointCloud]") {
+  const unsigned int width = 7, height = 5;
+  vpPointCloud pointcloud(width, height);
+  CHECK(pointcloud.getSize() == width * height);
+  CHECK(pointcloud.isOwner());
+
+  for (unsigned int i = 0; i < pointcloud.getSize(); i++) {
+    pointcloud.set(i, static_cast<float>(i), static_cast<float>(2 * i), static_cast<float>(3 * i));
+  }
+
+  // Coordinates are stored as separate arrays
+  const float *x = pointcloud.getX();
+  CHECK(pointcloud.getY() == x + width * height);
+  CHECK(pointcloud.getZ() == x + 2 * width * height);
+
+  // Same size: no reallocation and coordinates are kept
+  pointcloud.resize(height, width);
+  CHECK(pointcloud.getX() == x);
+  CHECK(pointcloud.getZ(10) == 30.0f);
+
+  std::vector<vpColVector> points;
+  pointcloud.convert(points);
+  REQUIRE(points.size() == width * height);
+  CHECK(points[4][1] == 8.0);
+  CHECK(points[4][3] == 1.0);
+
+  vpPointCloud copy;
+  copy.buildFrom(points, height, width);
+  for (unsigned int i = 0; i < copy.getSize(); i++) {
+    CHECK(copy.getX(i) == pointcloud.getX(i));
+    CHECK(copy.getY(i) == pointcloud.getY(i));
+    CHECK(copy.getZ(i) == pointcloud.getZ(i));
+  }
+
+  CHECK_THROWS_AS(copy.buildFrom(points, width, width), vpException);
+}
+
+TEST_CASE("Wrapped coordinates", "[vpPointCloud]") {
+  const unsigned int width = 4, height = 3;
+  std::vector<float> xyz(3 * width * height);
+  for (size_t i = 0; i < xyz.size(); i++) {
+    xyz[i] = static_cast<float>(i);
+  }
+
+  vpPointCloud pointcloud(&xyz[0], &xyz[1], &xyz[2], width, height, 3);
+  CHECK_FALSE(pointcloud.isOwner());
+  CHECK(pointcloud.getX() == &xyz[0]);
+  for (unsigned int i = 0; i < pointcloud.getSize(); i++) {
+    CHECK(pointcloud.getX(i) == xyz[3 * i]);
+    CHECK(pointcloud.getY(i) == xyz[3 * i + 1]);
+    CHECK(pointcloud.getZ(i) == xyz[3 * i + 2]);
+  }
+
+  // The buffer is not copied
+  xyz[5] = -1.0f;
+  CHECK(pointcloud.getZ(1) == -1.0f);
+
+  // A copy owns its coordinates
+  vpPointCloud copy = pointcloud;
+  CHECK(copy.isOwner());
+  CHECK(copy.getStride() == 1);
+  xyz[5] = 5.0f;
+  CHECK(copy.getZ(1) == -1.0f);
+
+  CHECK_THROWS_AS(pointcloud.wrap(&xyz[0], &xyz[1], &xyz[2], width, height, 0), vpException);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main()
+{
+  return 0;
+}
+#endif
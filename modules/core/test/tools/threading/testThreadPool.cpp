@@ -0,0 +1,197 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test vpThreadPool.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testThreadPool.cpp
+
+  \brief Test pool of reusable threads.
+*/
+
+#include <iostream>
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpThreadPool.h>
+
+TEST_CASE("Run batches of tasks", "[vpThreadPool]") {
+  for (unsigned int nbThreads = 1; nbThreads <= 4; nbThreads++) {
+    vpThreadPool pool(nbThreads);
+    CHECK(pool.getNbThreads() == nbThreads);
+
+    std::vector<int> results(100, 0);
+    std::vector<std::function<void()> > tasks;
+    for (size_t i = 0; i < results.size(); i++) {
+      tasks.push_back([&results, i]() { results[i] += static_cast<int>(i); });
+    }
+
+    // The same pool is reused for several batches
+    for (int iter = 0; iter < 10; iter++) {
+      pool.run(tasks);
+    }
+
+    for (size_t i = 0; i < results.size(); i++) {
+      CHECK(results[i] == static_cast<int>(10 * i));
+    }
+  }
+}
+
+TEST_CASE("Change the number of threads", "[vpThreadPool]") {
+  vpThreadPool pool(2);
+  pool.setNbThreads(3);
+  CHECK(pool.getNbThreads() == 3);
+
+  std::vector<int> results(8, 0);
+  std::vector<std::function<void()> > tasks;
+  for (size_t i = 0; i < results.size(); i++) {
+    tasks.push_back([&results, i]() { results[i] = 1; });
+  }
+  pool.run(tasks);
+
+  for (size_t i = 0; i < results.size(); i++) {
+    CHECK(results[i] == 1);
+  }
+}
+
+TEST_CASE("Exception thrown by a task", "[vpThreadPool]") {
+  vpThreadPool pool(3);
+
+  std::vector<int> results(6, 0);
+  std::vector<std::function<void()> > tasks;
+  for (size_t i = 0; i < results.size(); i++) {
+    tasks.push_back([&results, i]() {
+      if (i == 2) {
+        throw vpException(vpException::fatalError, "Task %d failed", static_cast<int>(i));
+      }
+      results[i] = 1;
+    });
+  }
+
+  CHECK_THROWS_AS(pool.run(tasks), vpException);
+
+  // The other tasks have been executed and the pool is still usable
+  for (size_t i = 0; i < results.size(); i++) {
+    CHECK(results[i] == (i == 2 ? 0 : 1));
+  }
+
+  tasks.erase(tasks.begin() + 2);
+  CHECK_NOTHROW(pool.run(tasks));
+}
+
+TEST_CASE("Parallel for loop", "[vpThreadPool]") {
+  for (unsigned int nbThreads = 1; nbThreads <= 4; nbThreads++) {
+    vpThreadPool pool(nbThreads);
+
+    for (int grainSize = 0; grainSize <= 7; grainSize += 7) {
+      std::vector<int> results(1003, 0);
+      pool.parallelFor(0, static_cast<int>(results.size()), [&results](int start, int end) {
+        for (int i = start; i < end; i++) {
+          results[i] += i;
+        }
+      }, 0, grainSize);
+
+      for (size_t i = 0; i < results.size(); i++) {
+        CHECK(results[i] == static_cast<int>(i));
+      }
+    }
+
+    // Empty range
+    bool called = false;
+    pool.parallelFor(10, 10, [&called](int, int) { called = true; });
+    CHECK_FALSE(called);
+  }
+}
+
+TEST_CASE("Tasks running tasks on the same pool", "[vpThreadPool]") {
+  vpThreadPool pool(3);
+
+  std::vector<int> results(4 * 100, 0);
+  std::vector<std::function<void()> > tasks;
+  for (int i = 0; i < 4; i++) {
+    tasks.push_back([&pool, &results, i]() {
+      pool.parallelFor(i * 100, (i + 1) * 100, [&results](int start, int end) {
+        for (int j = start; j < end; j++) {
+          results[j] = j;
+        }
+      });
+    });
+  }
+  pool.run(tasks);
+
+  for (size_t i = 0; i < results.size(); i++) {
+    CHECK(results[i] == static_cast<int>(i));
+  }
+}
+
+TEST_CASE("Global pool", "[vpThreadPool]") {
+  vpThreadPool &pool = vpThreadPool::getGlobalInstance();
+  CHECK(&pool == &vpThreadPool::getGlobalInstance());
+  CHECK(pool.getNbThreads() >= 1);
+
+  std::vector<int> results(64, 0);
+  pool.parallelFor(0, static_cast<int>(results.size()), [&results](int start, int end) {
+    for (int i = start; i < end; i++) {
+      results[i] = 1;
+    }
+  }, 2);
+
+  for (size_t i = 0; i < results.size(); i++) {
+    CHECK(results[i] == 1);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main()
+{
+  return 0;
+}
+#endif
@@ -277,6 +277,7 @@ public:
   void setAprilTagRefineDecode(bool refineDecode);
   void setAprilTagRefineEdges(bool refineEdges);
   void setAprilTagRefinePose(bool refinePose);
+  void setAprilTagTracking(bool tracking, unsigned int fullDetectionPeriod = 10, double roiMargin = 0.5);
 
   /*! Allow to enable the display of overlay tag information in the windows
    * (vpDisplay) associated to the input image. */
@@ -35,6 +35,8 @@
 #include <visp3/core/vpConfig.h>
 
 #ifdef VISP_HAVE_APRILTAG
+#include <algorithm>
+#include <limits>
 #include <map>
 
 #include <apriltag.h>
@@ -56,6 +58,7 @@
 #endif
 
 #include <visp3/core/vpDisplay.h>
+#include <visp3/core/vpMath.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/vision/vpPose.h>
@@ -66,7 +69,8 @@ class vpDetectorAprilTag::Impl
 public:
   Impl(const vpAprilTagFamily &tagFamily, const vpPoseEstimationMethod &method)
     : m_poseEstimationMethod(method), m_tagsId(), m_tagFamily(tagFamily),
-      m_td(NULL), m_tf(NULL), m_detections(NULL), m_zAlignedWithCameraFrame(false)
+      m_td(NULL), m_tf(NULL), m_detections(NULL), m_zAlignedWithCameraFrame(false), m_tracking(false),
+      m_trackingPeriod(10), m_trackingMargin(0.5), m_framesSinceFullDetection(0), m_tracks()
   {
     switch (m_tagFamily) {
     case TAG_36h11:
@@ -135,7 +139,9 @@ public:
 
   Impl(const Impl &o)
     : m_poseEstimationMethod(o.m_poseEstimationMethod), m_tagsId(o.m_tagsId), m_tagFamily(o.m_tagFamily),
-      m_td(NULL), m_tf(NULL), m_detections(NULL), m_zAlignedWithCameraFrame(o.m_zAlignedWithCameraFrame)
+      m_td(NULL), m_tf(NULL), m_detections(NULL), m_zAlignedWithCameraFrame(o.m_zAlignedWithCameraFrame),
+      m_tracking(o.m_tracking), m_trackingPeriod(o.m_trackingPeriod), m_trackingMargin(o.m_trackingMargin),
+      m_framesSinceFullDetection(o.m_framesSinceFullDetection), m_tracks(o.m_tracks)
   {
     switch (m_tagFamily) {
     case TAG_36h11:
@@ -306,17 +312,35 @@ public:
 
     const bool computePose = (cMo_vec != NULL);
 
-    image_u8_t im = {/*.width =*/(int32_t)I.getWidth(),
-                     /*.height =*/(int32_t)I.getHeight(),
-                     /*.stride =*/(int32_t)I.getWidth(),
-                     /*.buf =*/I.bitmap};
-
     if (m_detections) {
       apriltag_detections_destroy(m_detections);
       m_detections = NULL;
     }
 
-    m_detections = apriltag_detector_detect(m_td, &im);
+    std::vector<int> detectionTracks;
+    if (m_tracking && !m_tracks.empty() && m_framesSinceFullDetection + 1 < m_trackingPeriod) {
+      m_detections = detectInRois(I, detectionTracks);
+    }
+
+    if (m_detections == NULL) {
+      image_u8_t im = {/*.width =*/(int32_t)I.getWidth(),
+                       /*.height =*/(int32_t)I.getHeight(),
+                       /*.stride =*/(int32_t)I.getWidth(),
+                       /*.buf =*/I.bitmap};
+
+      m_detections = apriltag_detector_detect(m_td, &im);
+      if (m_tracking) {
+        matchTracks(m_detections, detectionTracks);
+      }
+      m_framesSinceFullDetection = 0;
+    } else {
+      m_framesSinceFullDetection++;
+    }
+
+    if (m_tracking) {
+      updateTracks(detectionTracks);
+    }
+
     int nb_detections = zarray_size(m_detections);
     bool detected = nb_detections > 0;
 
@@ -377,6 +401,194 @@ public:
     return detected;
   }
 
+  // Detect the tags only in padded regions around their predicted locations. The regions are views on the
+  // input image (the stride is the image width), so no pixel is copied. Return NULL when a tracked tag is lost
+  // or when the regions cover most of the image, in which case a full frame detection is required.
+  zarray_t *detectInRois(const vpImage<unsigned char> &I, std::vector<int> &detectionTracks)
+  {
+    const int width = static_cast<int>(I.getWidth()), height = static_cast<int>(I.getHeight());
+
+    std::vector<vpTrackingRoi> rois;
+    for (size_t i = 0; i < m_tracks.size(); i++) {
+      const vpTrackedTag &track = m_tracks[i];
+      double umin = std::numeric_limits<double>::max(), umax = -std::numeric_limits<double>::max();
+      double vmin = std::numeric_limits<double>::max(), vmax = -std::numeric_limits<double>::max();
+      for (int j = 0; j < 4; j++) {
+        umin = std::min(umin, track.p[j][0] + track.v[0]);
+        umax = std::max(umax, track.p[j][0] + track.v[0]);
+        vmin = std::min(vmin, track.p[j][1] + track.v[1]);
+        vmax = std::max(vmax, track.p[j][1] + track.v[1]);
+      }
+      const double margin = m_trackingMargin * std::max(umax - umin, vmax - vmin) + 2.0;
+
+      vpTrackingRoi roi;
+      roi.left = std::max(0, vpMath::round(umin - margin));
+      roi.top = std::max(0, vpMath::round(vmin - margin));
+      roi.right = std::min(width, vpMath::round(umax + margin) + 1);
+      roi.bottom = std::min(height, vpMath::round(vmax + margin) + 1);
+      if (roi.right - roi.left < 8 || roi.bottom - roi.top < 8) {
+        // The tag is predicted to leave the image
+        return NULL;
+      }
+      rois.push_back(roi);
+    }
+
+    // Merge overlapping regions so that each pixel is processed at most once
+    for (bool merged = true; merged;) {
+      merged = false;
+      for (size_t i = 0; i < rois.size() && !merged; i++) {
+        for (size_t j = i + 1; j < rois.size() && !merged; j++) {
+          if (rois[i].left < rois[j].right && rois[j].left < rois[i].right && rois[i].top < rois[j].bottom &&
+              rois[j].top < rois[i].bottom) {
+            rois[i].left = std::min(rois[i].left, rois[j].left);
+            rois[i].top = std::min(rois[i].top, rois[j].top);
+            rois[i].right = std::max(rois[i].right, rois[j].right);
+            rois[i].bottom = std::max(rois[i].bottom, rois[j].bottom);
+            rois.erase(rois.begin() + static_cast<std::ptrdiff_t>(j));
+            merged = true;
+          }
+        }
+      }
+    }
+
+    size_t area = 0;
+    for (size_t i = 0; i < rois.size(); i++) {
+      area += static_cast<size_t>(rois[i].right - rois[i].left) * static_cast<size_t>(rois[i].bottom - rois[i].top);
+    }
+    if (2 * area > I.getSize()) {
+      return NULL;
+    }
+
+    zarray_t *detections = zarray_create(sizeof(apriltag_detection_t *));
+    for (size_t i = 0; i < rois.size(); i++) {
+      const vpTrackingRoi &roi = rois[i];
+      image_u8_t im = {/*.width =*/roi.right - roi.left,
+                       /*.height =*/roi.bottom - roi.top,
+                       /*.stride =*/width,
+                       /*.buf =*/I.bitmap + static_cast<size_t>(roi.top) * I.getWidth() + roi.left};
+
+      zarray_t *roiDetections = apriltag_detector_detect(m_td, &im);
+      for (int j = 0; j < zarray_size(roiDetections); j++) {
+        apriltag_detection_t *det;
+        zarray_get(roiDetections, j, &det);
+
+        // Express the detection in the full image
+        for (int k = 0; k < 4; k++) {
+          det->p[k][0] += roi.left;
+          det->p[k][1] += roi.top;
+        }
+        det->c[0] += roi.left;
+        det->c[1] += roi.top;
+        for (int k = 0; k < 3; k++) {
+          MATD_EL(det->H, 0, k) += roi.left * MATD_EL(det->H, 2, k);
+          MATD_EL(det->H, 1, k) += roi.top * MATD_EL(det->H, 2, k);
+        }
+
+        zarray_add(detections, &det);
+      }
+      // The detections are now owned by detections
+      zarray_destroy(roiDetections);
+    }
+
+    if (matchTracks(detections, detectionTracks) < m_tracks.size()) {
+      apriltag_detections_destroy(detections);
+      return NULL;
+    }
+
+    return detections;
+  }
+
+  // Associate each detection with the closest track of the same id around its predicted location.
+  // Return the number of tracks that are matched.
+  size_t matchTracks(zarray_t *detections, std::vector<int> &detectionTracks) const
+  {
+    const int nb_detections = zarray_size(detections);
+    detectionTracks.assign(static_cast<size_t>(nb_detections), -1);
+
+    size_t nbMatches = 0;
+    for (size_t i = 0; i < m_tracks.size(); i++) {
+      const vpTrackedTag &track = m_tracks[i];
+      const double u = track.c[0] + track.v[0], v = track.c[1] + track.v[1];
+      double size = 0;
+      for (int j = 0; j < 4; j++) {
+        size = std::max(size, std::fabs(track.p[j][0] - track.c[0]) + std::fabs(track.p[j][1] - track.c[1]));
+      }
+      double bestDist = size * size;
+      int bestIndex = -1;
+      for (int j = 0; j < nb_detections; j++) {
+        apriltag_detection_t *det;
+        zarray_get(detections, j, &det);
+        if (det->id != track.id || detectionTracks[static_cast<size_t>(j)] >= 0) {
+          continue;
+        }
+        const double dist = (det->c[0] - u) * (det->c[0] - u) + (det->c[1] - v) * (det->c[1] - v);
+        if (dist <= bestDist) {
+          bestDist = dist;
+          bestIndex = j;
+        }
+      }
+      if (bestIndex >= 0) {
+        detectionTracks[static_cast<size_t>(bestIndex)] = static_cast<int>(i);
+        nbMatches++;
+      }
+    }
+
+    return nbMatches;
+  }
+
+  // Replace the tracks by the current detections, keeping the motion and the pose of the matched ones.
+  // After this call, the track index is the detection index.
+  void updateTracks(const std::vector<int> &detectionTracks)
+  {
+    std::vector<vpTrackedTag> tracks(static_cast<size_t>(zarray_size(m_detections)));
+    for (size_t i = 0; i < tracks.size(); i++) {
+      apriltag_detection_t *det;
+      zarray_get(m_detections, static_cast<int>(i), &det);
+
+      vpTrackedTag &track = tracks[i];
+      track.id = det->id;
+      for (int j = 0; j < 4; j++) {
+        track.p[j][0] = det->p[j][0];
+        track.p[j][1] = det->p[j][1];
+      }
+      track.c[0] = det->c[0];
+      track.c[1] = det->c[1];
+
+      const int index = detectionTracks[i];
+      if (index >= 0) {
+        const vpTrackedTag &previous = m_tracks[static_cast<size_t>(index)];
+        track.v[0] = track.c[0] - previous.c[0];
+        track.v[1] = track.c[1] - previous.c[1];
+        track.cMo = previous.cMo;
+        track.tagSize = previous.tagSize;
+      }
+    }
+    m_tracks.swap(tracks);
+  }
+
+  // Refine with virtual visual servoing the pose of a tracked tag, starting from its pose in the previous frame.
+  // Return false when the refinement did not converge to a valid pose, in which case the pose has to be initialized.
+  bool refineTrackedPose(vpPose &pose, const vpCameraParameters &cam, vpHomogeneousMatrix &cMo) const
+  {
+    try {
+      pose.computePose(vpPose::VIRTUAL_VS, cMo);
+    } catch (const vpException &) {
+      return false;
+    }
+
+    for (unsigned int i = 0; i < 3; i++) {
+      for (unsigned int j = 0; j < 4; j++) {
+        if (vpMath::isNaN(cMo[i][j]) || vpMath::isInf(cMo[i][j])) {
+          return false;
+        }
+      }
+    }
+
+    // Reject a pose behind the camera or whose RMS reprojection error is above 2 pixels
+    const double residual = pose.computeResidual(cMo) * cam.get_px() * cam.get_py() / 4.0;
+    return cMo[2][3] > 0 && residual < 4.0;
+  }
+
   bool getPose(size_t tagIndex, double tagSize, const vpCameraParameters &cam, vpHomogeneousMatrix &cMo, vpHomogeneousMatrix *cMo2,
                double *projErrors, double *projErrors2) {
     if (m_detections == NULL) {
@@ -408,49 +620,6 @@ public:
     //To keep compatibility, we maintain the same convention than before and there is setZAlignedWithCameraAxis().
     //Under the hood, we use aligned frames everywhere and transform the pose according to the option.
 
-    vpHomogeneousMatrix cMo_homography_ortho_iter;
-    if (m_poseEstimationMethod == HOMOGRAPHY_ORTHOGONAL_ITERATION ||
-        m_poseEstimationMethod == BEST_RESIDUAL_VIRTUAL_VS) {
-      double fx = cam.get_px(), fy = cam.get_py();
-      double cx = cam.get_u0(), cy = cam.get_v0();
-
-      apriltag_detection_info_t info;
-      info.det = det;
-      info.tagsize = tagSize;
-      info.fx = fx;
-      info.fy = fy;
-      info.cx = cx;
-      info.cy = cy;
-
-      //projErrors and projErrors2 will be override later
-      getPoseWithOrthogonalMethod(info, cMo, cMo2, projErrors, projErrors2);
-      cMo_homography_ortho_iter = cMo;
-    }
-
-    vpHomogeneousMatrix cMo_homography;
-    if (m_poseEstimationMethod == HOMOGRAPHY || m_poseEstimationMethod == HOMOGRAPHY_VIRTUAL_VS ||
-        m_poseEstimationMethod == BEST_RESIDUAL_VIRTUAL_VS) {
-      double fx = cam.get_px(), fy = cam.get_py();
-      double cx = cam.get_u0(), cy = cam.get_v0();
-
-      apriltag_detection_info_t info;
-      info.det = det;
-      info.tagsize = tagSize;
-      info.fx = fx;
-      info.fy = fy;
-      info.cx = cx;
-      info.cy = cy;
-
-      apriltag_pose_t pose;
-      estimate_pose_for_tag_homography(&info, &pose);
-      convertHomogeneousMatrix(pose, cMo);
-
-      matd_destroy(pose.R);
-      matd_destroy(pose.t);
-
-      cMo_homography = cMo;
-    }
-
     // Add marker object points
     vpPose pose;
     vpPoint pt;
@@ -488,46 +657,104 @@ public:
 
     pose.addPoints(pts);
 
-    if (m_poseEstimationMethod != HOMOGRAPHY && m_poseEstimationMethod != HOMOGRAPHY_VIRTUAL_VS &&
-        m_poseEstimationMethod != HOMOGRAPHY_ORTHOGONAL_ITERATION) {
-      if (m_poseEstimationMethod == BEST_RESIDUAL_VIRTUAL_VS) {
-        vpHomogeneousMatrix cMo_dementhon, cMo_lagrange;
+    // When tracking, refine the pose of the tag from its pose in the previous frame
+    bool poseFromTrack = false;
+    if (m_tracking && tagIndex < m_tracks.size() && m_tracks[tagIndex].tagSize == tagSize &&
+        m_poseEstimationMethod != HOMOGRAPHY && m_poseEstimationMethod != HOMOGRAPHY_ORTHOGONAL_ITERATION) {
+      cMo = m_tracks[tagIndex].cMo;
+      poseFromTrack = refineTrackedPose(pose, cam, cMo);
+    }
 
-        double residual_dementhon = std::numeric_limits<double>::max(),
-               residual_lagrange = std::numeric_limits<double>::max();
-        double residual_homography = pose.computeResidual(cMo_homography);
-        double residual_homography_ortho_iter = pose.computeResidual(cMo_homography_ortho_iter);
+    if (!poseFromTrack) {
+      vpHomogeneousMatrix cMo_homography_ortho_iter;
+      if (m_poseEstimationMethod == HOMOGRAPHY_ORTHOGONAL_ITERATION ||
+          m_poseEstimationMethod == BEST_RESIDUAL_VIRTUAL_VS) {
+        double fx = cam.get_px(), fy = cam.get_py();
+        double cx = cam.get_u0(), cy = cam.get_v0();
+
+        apriltag_detection_info_t info;
+        info.det = det;
+        info.tagsize = tagSize;
+        info.fx = fx;
+        info.fy = fy;
+        info.cx = cx;
+        info.cy = cy;
+
+        //projErrors and projErrors2 will be override later
+        getPoseWithOrthogonalMethod(info, cMo, cMo2, projErrors, projErrors2);
+        cMo_homography_ortho_iter = cMo;
+      }
 
-        if (pose.computePose(vpPose::DEMENTHON, cMo_dementhon)) {
-          residual_dementhon = pose.computeResidual(cMo_dementhon);
-        }
+      vpHomogeneousMatrix cMo_homography;
+      if (m_poseEstimationMethod == HOMOGRAPHY || m_poseEstimationMethod == HOMOGRAPHY_VIRTUAL_VS ||
+          m_poseEstimationMethod == BEST_RESIDUAL_VIRTUAL_VS) {
+        double fx = cam.get_px(), fy = cam.get_py();
+        double cx = cam.get_u0(), cy = cam.get_v0();
+
+        apriltag_detection_info_t info;
+        info.det = det;
+        info.tagsize = tagSize;
+        info.fx = fx;
+        info.fy = fy;
+        info.cx = cx;
+        info.cy = cy;
+
+        apriltag_pose_t pose;
+        estimate_pose_for_tag_homography(&info, &pose);
+        convertHomogeneousMatrix(pose, cMo);
+
+        matd_destroy(pose.R);
+        matd_destroy(pose.t);
+
+        cMo_homography = cMo;
+      }
+
+      if (m_poseEstimationMethod != HOMOGRAPHY && m_poseEstimationMethod != HOMOGRAPHY_VIRTUAL_VS &&
+          m_poseEstimationMethod != HOMOGRAPHY_ORTHOGONAL_ITERATION) {
+        if (m_poseEstimationMethod == BEST_RESIDUAL_VIRTUAL_VS) {
+          vpHomogeneousMatrix cMo_dementhon, cMo_lagrange;
+
+          double residual_dementhon = std::numeric_limits<double>::max(),
+                 residual_lagrange = std::numeric_limits<double>::max();
+          double residual_homography = pose.computeResidual(cMo_homography);
+          double residual_homography_ortho_iter = pose.computeResidual(cMo_homography_ortho_iter);
+
+          if (pose.computePose(vpPose::DEMENTHON, cMo_dementhon)) {
+            residual_dementhon = pose.computeResidual(cMo_dementhon);
+          }
+
+          if (pose.computePose(vpPose::LAGRANGE, cMo_lagrange)) {
+            residual_lagrange = pose.computeResidual(cMo_lagrange);
+          }
 
-        if (pose.computePose(vpPose::LAGRANGE, cMo_lagrange)) {
-          residual_lagrange = pose.computeResidual(cMo_lagrange);
+          std::vector<double> residuals;
+          residuals.push_back(residual_dementhon);
+          residuals.push_back(residual_lagrange);
+          residuals.push_back(residual_homography);
+          residuals.push_back(residual_homography_ortho_iter);
+          std::vector<vpHomogeneousMatrix> poses;
+          poses.push_back(cMo_dementhon);
+          poses.push_back(cMo_lagrange);
+          poses.push_back(cMo_homography);
+          poses.push_back(cMo_homography_ortho_iter);
+
+          std::ptrdiff_t minIndex = std::min_element(residuals.begin(), residuals.end()) - residuals.begin();
+          cMo = *(poses.begin() + minIndex);
+        } else {
+          pose.computePose(m_mapOfCorrespondingPoseMethods[m_poseEstimationMethod], cMo);
         }
+      }
 
-        std::vector<double> residuals;
-        residuals.push_back(residual_dementhon);
-        residuals.push_back(residual_lagrange);
-        residuals.push_back(residual_homography);
-        residuals.push_back(residual_homography_ortho_iter);
-        std::vector<vpHomogeneousMatrix> poses;
-        poses.push_back(cMo_dementhon);
-        poses.push_back(cMo_lagrange);
-        poses.push_back(cMo_homography);
-        poses.push_back(cMo_homography_ortho_iter);
-
-        std::ptrdiff_t minIndex = std::min_element(residuals.begin(), residuals.end()) - residuals.begin();
-        cMo = *(poses.begin() + minIndex);
-      } else {
-        pose.computePose(m_mapOfCorrespondingPoseMethods[m_poseEstimationMethod], cMo);
+      if (m_poseEstimationMethod != HOMOGRAPHY &&
+          m_poseEstimationMethod != HOMOGRAPHY_ORTHOGONAL_ITERATION) {
+        // Compute final pose using VVS
+        pose.computePose(vpPose::VIRTUAL_VS, cMo);
       }
     }
 
-    if (m_poseEstimationMethod != HOMOGRAPHY &&
-        m_poseEstimationMethod != HOMOGRAPHY_ORTHOGONAL_ITERATION) {
-      // Compute final pose using VVS
-      pose.computePose(vpPose::VIRTUAL_VS, cMo);
+    if (m_tracking && tagIndex < m_tracks.size()) {
+      m_tracks[tagIndex].cMo = cMo;
+      m_tracks[tagIndex].tagSize = tagSize;
     }
 
     //Only with HOMOGRAPHY_ORTHOGONAL_ITERATION we can directly get two solutions
@@ -716,7 +943,46 @@ public:
 
   void setZAlignedWithCameraAxis(bool zAlignedWithCameraFrame) { m_zAlignedWithCameraFrame = zAlignedWithCameraFrame; }
 
+  void getTracking(bool &tracking, unsigned int &fullDetectionPeriod, double &roiMargin) const
+  {
+    tracking = m_tracking;
+    fullDetectionPeriod = m_trackingPeriod;
+    roiMargin = m_trackingMargin;
+  }
+
+  void setTracking(bool tracking, unsigned int fullDetectionPeriod, double roiMargin)
+  {
+    m_tracking = tracking;
+    m_trackingPeriod = fullDetectionPeriod;
+    m_trackingMargin = roiMargin;
+    m_framesSinceFullDetection = 0;
+    m_tracks.clear();
+  }
+
 protected:
+  struct vpTrackedTag {
+    vpTrackedTag() : id(-1), cMo(), tagSize(0)
+    {
+      for (int i = 0; i < 4; i++) {
+        p[i][0] = p[i][1] = 0;
+      }
+      c[0] = c[1] = 0;
+      v[0] = v[1] = 0;
+    }
+
+    int id;
+    double p[4][2];            //!< Corners in the last frame
+    double c[2];               //!< Center in the last frame
+    double v[2];               //!< Displacement of the center between the last two frames
+    vpHomogeneousMatrix cMo;   //!< Last pose, in the frame aligned with the camera frame
+    double tagSize;            //!< Tag size used to compute cMo, 0 when there is no pose yet
+  };
+
+  struct vpTrackingRoi {
+    int left, top, right, bottom;
+  };
+
+
   std::map<vpPoseEstimationMethod, vpPose::vpPoseMethodType> m_mapOfCorrespondingPoseMethods;
   vpPoseEstimationMethod m_poseEstimationMethod;
   std::vector<int> m_tagsId;
@@ -725,6 +991,11 @@ protected:
   apriltag_family_t *m_tf;
   zarray_t *m_detections;
   bool m_zAlignedWithCameraFrame;
+  bool m_tracking;
+  unsigned int m_trackingPeriod;
+  double m_trackingMargin;
+  unsigned int m_framesSinceFullDetection;
+  std::vector<vpTrackedTag> m_tracks;
 };
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
@@ -942,6 +1213,10 @@ void vpDetectorAprilTag::setAprilTagFamily(const vpAprilTagFamily &tagFamily)
   bool refineEdges = true;
   m_impl->getRefineEdges(refineEdges);
   bool zAxis = m_impl->getZAlignedWithCameraAxis();
+  bool tracking = false;
+  unsigned int fullDetectionPeriod = 10;
+  double roiMargin = 0.5;
+  m_impl->getTracking(tracking, fullDetectionPeriod, roiMargin);
 
   delete m_impl;
   m_impl = new Impl(tagFamily, m_poseEstimationMethod);
@@ -951,6 +1226,7 @@ void vpDetectorAprilTag::setAprilTagFamily(const vpAprilTagFamily &tagFamily)
   m_impl->setQuadSigma(quadSigma);
   m_impl->setRefineEdges(refineEdges);
   m_impl->setZAlignedWithCameraAxis(zAxis);
+  m_impl->setTracking(tracking, fullDetectionPeriod, roiMargin);
 }
 
 /*!
@@ -1038,6 +1314,33 @@ void vpDetectorAprilTag::setAprilTagRefineEdges(bool refineEdges)
   m_impl->setRefineEdges(refineEdges);
 }
 
+/*!
+  Enable or disable the tracking mode.
+
+  In tracking mode, the location of each tag detected in the previous frame is predicted assuming a constant
+  motion of its center, and the tags are searched only in regions of interest around these predictions. These
+  regions are processed in place in the input image. A detection on the full image is still performed:
+  - every \e fullDetectionPeriod frames, to find the tags that enter the field of view,
+  - when a tracked tag is not found in its region of interest,
+  - when the regions of interest cover more than half of the image.
+
+  With a pose estimation method that ends with a virtual visual servoing step, the pose of a tracked tag
+  is refined starting from its pose in the previous frame, provided that the same tag size is used.
+  The usual initialization is used when this refinement fails.
+
+  The tracking mode is intended for video streams with a few tags that are small with respect to the image.
+  Calling this function resets the tracks.
+
+  \param tracking : If true, enable the tracking mode.
+  \param fullDetectionPeriod : Number of frames between two detections on the full image.
+  \param roiMargin : Padding of the regions of interest around the predicted tag locations, as a ratio of the
+  tag size in the image.
+*/
+void vpDetectorAprilTag::setAprilTagTracking(bool tracking, unsigned int fullDetectionPeriod, double roiMargin)
+{
+  m_impl->setTracking(tracking, fullDetectionPeriod, roiMargin);
+}
+
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
 /*!
   Deprecated parameter from AprilTag 2 version.
@@ -40,6 +40,8 @@
 #define CATCH_CONFIG_RUNNER
 #include <catch.hpp>
 
+#include <limits>
+#include <visp3/core/vpImageTools.h>
 #include <visp3/core/vpIoTools.h>
 #include <visp3/detection/vpDetectorAprilTag.h>
 #include <visp3/io/vpImageIo.h>
@@ -460,6 +462,46 @@ TEST_CASE("Benchmark Apriltag detection 640x480", "[benchmark]") {
 #endif
 }
 
+TEST_CASE("Benchmark Apriltag tracking 3840x2160", "[benchmark]") {
+  const double tagSize = 0.25;
+  const vpCameraParameters cam(4200, 4200, 1920, 1080);
+  const size_t nbTags = 5;
+
+  std::string filename = vpIoTools::createFilePath(vpIoTools::getViSPImagesDataPath(),
+                                                   "AprilTag/benchmark/1920x1080/tag36_11_1920x1080.png");
+  REQUIRE(vpIoTools::checkFilename(filename));
+  vpImage<unsigned char> I_1080p, I;
+  vpImageIo::read(I_1080p, filename);
+  vpImageTools::resize(I_1080p, I, 2 * I_1080p.getWidth(), 2 * I_1080p.getHeight(),
+                       vpImageTools::INTERPOLATION_LINEAR);
+
+  vpDetectorAprilTag apriltag_detector(vpDetectorAprilTag::TAG_36h11);
+  BENCHMARK("Benchmark Apriltag detection: tag36_11 3840x2160") {
+    std::vector<vpHomogeneousMatrix> cMo_vec;
+    apriltag_detector.detect(I, tagSize, cam, cMo_vec);
+    CHECK(cMo_vec.size() == nbTags);
+    return cMo_vec;
+  };
+
+  // A detection on the full image every 10 frames, the tags are searched around their last location otherwise
+  apriltag_detector.setAprilTagTracking(true, 10);
+  BENCHMARK("Benchmark Apriltag tracking: tag36_11 3840x2160") {
+    std::vector<vpHomogeneousMatrix> cMo_vec;
+    apriltag_detector.detect(I, tagSize, cam, cMo_vec);
+    CHECK(cMo_vec.size() == nbTags);
+    return cMo_vec;
+  };
+
+  // Only the frames where the tags are searched around their last location
+  apriltag_detector.setAprilTagTracking(true, std::numeric_limits<unsigned int>::max());
+  BENCHMARK("Benchmark Apriltag tracking without full detection: tag36_11 3840x2160") {
+    std::vector<vpHomogeneousMatrix> cMo_vec;
+    apriltag_detector.detect(I, tagSize, cam, cMo_vec);
+    CHECK(cMo_vec.size() == nbTags);
+    return cMo_vec;
+  };
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session; // There must be exactly one instance
@@ -749,6 +749,61 @@ TEST_CASE("Apriltag getTagsPoints3D test", "[apriltag_get_tags_points3D_test]")
 }
 #endif // #if defined(VISP_HAVE_LAPACK) || defined(VISP_HAVE_OPENCV) || defined(VISP_HAVE_EIGEN3)
 
+TEST_CASE("Apriltag tracking test", "[apriltag_tracking_test]") {
+  const std::string filename = vpIoTools::createFilePath(vpIoTools::getViSPImagesDataPath(),
+                                                         "AprilTag/benchmark/640x480/tag36_11_640x480.png");
+  REQUIRE(vpIoTools::checkFilename(filename));
+
+  vpImage<unsigned char> I_ref;
+  vpImageIo::read(I_ref, filename);
+  REQUIRE(I_ref.getSize() == 640*480);
+
+  const double tagSize = 0.25;
+  vpCameraParameters cam;
+  cam.initPersProjWithoutDistortion(700, 700, 320, 240);
+
+  vpDetectorAprilTag detector(vpDetectorAprilTag::TAG_36h11);
+  vpDetectorAprilTag detector_tracking(vpDetectorAprilTag::TAG_36h11);
+  detector_tracking.setAprilTagTracking(true, 4);
+
+  // Translate the image at each frame so that the tags move
+  vpImage<unsigned char> I(I_ref.getHeight(), I_ref.getWidth());
+  for (unsigned int frame = 0; frame < 10; frame++) {
+    const unsigned int du = 2 * frame, dv = frame;
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        I[i][j] = (i >= dv && j >= du) ? I_ref[i - dv][j - du] : I_ref[0][0];
+      }
+    }
+
+    std::vector<vpHomogeneousMatrix> cMo_vec, cMo_vec_tracking;
+    detector.detect(I, tagSize, cam, cMo_vec);
+    detector_tracking.detect(I, tagSize, cam, cMo_vec_tracking);
+
+    std::vector<int> tagsId = detector.getTagsId();
+    std::vector<int> tagsId_tracking = detector_tracking.getTagsId();
+    std::vector<std::vector<vpImagePoint> > tagsCorners = detector.getTagsCorners();
+    std::vector<std::vector<vpImagePoint> > tagsCorners_tracking = detector_tracking.getTagsCorners();
+    REQUIRE(tagsId.size() == 5);
+    REQUIRE(tagsId_tracking.size() == tagsId.size());
+    REQUIRE(cMo_vec_tracking.size() == cMo_vec.size());
+
+    for (size_t i = 0; i < tagsId.size(); i++) {
+      size_t idx = 0;
+      while (idx < tagsId_tracking.size() && tagsId_tracking[idx] != tagsId[i]) {
+        idx++;
+      }
+      REQUIRE(idx < tagsId_tracking.size());
+
+      for (size_t j = 0; j < tagsCorners[i].size(); j++) {
+        CHECK(vpImagePoint::distance(tagsCorners[i][j], tagsCorners_tracking[idx][j]) < 0.5);
+      }
+      vpTranslationVector t_diff = cMo_vec[i].getTranslationVector() - cMo_vec_tracking[idx].getTranslationVector();
+      CHECK(t_diff.frobeniusNorm() < 1e-2 * cMo_vec[i].getTranslationVector().frobeniusNorm());
+    }
+  }
+}
+
 int main(int argc, const char *argv[])
 {
   Catch::Session session; // There must be exactly one instance
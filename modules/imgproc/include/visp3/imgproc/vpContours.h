@@ -249,6 +249,13 @@ VISP_EXPORT void drawContours(vpImage<vpRGBa> &I, const std::vector<std::vector<
 VISP_EXPORT void findContours(const vpImage<unsigned char> &I_original, vpContour &contours,
                               std::vector<std::vector<vpImagePoint> > &contourPts,
                               const vpContourRetrievalType &retrievalMode = vp::CONTOUR_RETR_TREE);
+
+struct vpConnectedComponentStats;
+
+VISP_EXPORT void findContours(const vpImage<int> &labels, int label, vpContour &contours,
+                              std::vector<std::vector<vpImagePoint> > &contourPts,
+                              const vpContourRetrievalType &retrievalMode = vp::CONTOUR_RETR_TREE,
+                              const vpConnectedComponentStats *stats = NULL);
 }
 
 #endif
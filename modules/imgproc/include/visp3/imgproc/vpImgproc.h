@@ -47,6 +47,7 @@
 
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageMorphology.h>
+#include <visp3/core/vpRect.h>
 #include <visp3/imgproc/vpContours.h>
 
 #define USE_OLD_FILL_HOLE 0
@@ -83,6 +84,17 @@ typedef enum {
                               */
 } vpAutoThresholdMethod;
 
+/*!
+  Statistics of a connected component, computed by connectedComponents().
+*/
+struct vpConnectedComponentStats {
+  unsigned int m_area;      /*!< Number of pixels of the component. */
+  vpRect m_bbox;            /*!< Bounding box of the component. */
+  vpImagePoint m_centroid;  /*!< Center of gravity of the component pixels. */
+
+  vpConnectedComponentStats() : m_area(0), m_bbox(), m_centroid() {}
+};
+
 VISP_EXPORT void adjust(vpImage<unsigned char> &I, double alpha, double beta);
 VISP_EXPORT void adjust(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, double alpha,
                         double beta);
@@ -126,7 +138,13 @@ VISP_EXPORT void unsharpMask(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires, un
 
 VISP_EXPORT void
 connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
-                    const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
+                    const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4,
+                    unsigned int nbThreads = 1);
+VISP_EXPORT void
+connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                    std::vector<vpConnectedComponentStats> &stats,
+                    const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4,
+                    unsigned int nbThreads = 1);
 
 VISP_EXPORT void fillHoles(vpImage<unsigned char> &I
 #if USE_OLD_FILL_HOLE
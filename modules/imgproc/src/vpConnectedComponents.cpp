@@ -36,71 +36,318 @@
  *
  *****************************************************************************/
 
+
 /*!
   \file vpConnectedComponents.cpp
   \brief Basic connected components.
 */
 
-#include <queue>
+#include <algorithm>
+#include <limits>
+#include <string.h>
+#include <visp3/core/vpEndian.h>
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/imgproc/vpImgproc.h>
 
 namespace
 {
-void getNeighbors(const vpImage<unsigned char> &I, std::queue<vpImagePoint> &listOfNeighbors, unsigned int i,
-                  unsigned int j, const vpImageMorphology::vpConnexityType &connexity)
+// Horizontal run of pixels of the same value in the rows of a stripe
+struct vpRun {
+  unsigned int m_begin, m_end; // [m_begin, m_end) columns
+  unsigned char m_value;
+};
+
+// Runs of the rows [m_i_begin, m_i_end), the runs of row i being
+// m_runs[m_row_runs[i - m_i_begin]] to m_runs[m_row_runs[i - m_i_begin + 1] - 1]
+struct vpStripe {
+  vpStripe() : m_i_begin(0), m_i_end(0), m_runs(), m_row_runs(), m_parent(), m_offset(0) {}
+
+  unsigned int m_i_begin, m_i_end;
+  std::vector<vpRun> m_runs;
+  std::vector<size_t> m_row_runs;
+  std::vector<size_t> m_parent;
+  size_t m_offset; // index of the first run of the stripe among all the runs
+};
+
+// Runs are the nodes of a union-find forest where a run always points to a
+// smaller or equal index. The root of a tree is thus the first run of the
+// component in raster order.
+size_t findRoot(const std::vector<size_t> &parent, size_t node)
 {
-  unsigned char currValue = I[i][j];
+  while (parent[node] < node) {
+    node = parent[node];
+  }
+  return node;
+}
 
-  if (connexity == vpImageMorphology::CONNEXITY_4) {
-    // Top
-    if (I[i - 1][j] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i - 1, j));
+// Link the trees of two nodes, the root of the merged tree being the
+// smallest one, and shorten the paths of the two nodes
+void merge(std::vector<size_t> &parent, size_t node1, size_t node2)
+{
+  size_t root1 = findRoot(parent, node1);
+  size_t root2 = findRoot(parent, node2);
+  if (root1 > root2) {
+    std::swap(root1, root2);
+  }
+  parent[root2] = root1;
+  parent[node1] = root1;
+  parent[node2] = root1;
+}
+
+// Merge the runs [begin, end) of a row with the connected runs [up_begin,
+// up_end) of the previous row, the nodes of the runs being shifted by offset
+// and up_offset. With the 8-connexity, runs touching by a corner are connected.
+void mergeRows(const std::vector<vpRun> &up_runs, size_t up_begin, size_t up_end, size_t up_offset,
+               const std::vector<vpRun> &runs, size_t begin, size_t end, size_t offset, std::vector<size_t> &parent,
+               unsigned int d)
+{
+  size_t up = up_begin;
+  for (size_t k = begin; k < end && up < up_end; k++) {
+    const vpRun &run = runs[k];
+    while (up < up_end && up_runs[up].m_end + d <= run.m_begin) {
+      up++;
     }
+    for (size_t l = up; l < up_end && up_runs[l].m_begin < run.m_end + d; l++) {
+      if (up_runs[l].m_value == run.m_value) {
+        merge(parent, offset + k, up_offset + l);
+      }
+    }
+  }
+}
 
-    // Left
-    if (I[i][j - 1] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i, j - 1));
+// Return the first column from j whose value differs from value, comparing
+// 8 pixels at once in the long runs
+unsigned int findRunEnd(const unsigned char *src, unsigned int j, unsigned int width, unsigned char value)
+{
+  const unsigned long long pattern = 0x0101010101010101ULL * value;
+  while (j + 8 <= width) {
+    unsigned long long pixels;
+    memcpy(&pixels, src + j, sizeof(pixels));
+    if (pixels != pattern) {
+#if defined(VISP_LITTLE_ENDIAN) && defined(__GNUC__)
+      // Index of the first differing byte
+      return j + (static_cast<unsigned int>(__builtin_ctzll(pixels ^ pattern)) >> 3);
+#else
+      break;
+#endif
     }
+    j += 8;
+  }
 
-    // Right
-    if (I[i][j + 1] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i, j + 1));
+  while (j < width && src[j] == value) {
+    j++;
+  }
+  return j;
+}
+
+// Return the first column from j whose value is 0
+unsigned int findZero(const unsigned char *src, unsigned int j, unsigned int width)
+{
+  while (j + 8 <= width) {
+    unsigned long long pixels;
+    memcpy(&pixels, src + j, sizeof(pixels));
+    // The high bit of the first zero byte is set
+    const unsigned long long zeros = (pixels - 0x0101010101010101ULL) & ~pixels & 0x8080808080808080ULL;
+    if (zeros != 0) {
+#if defined(VISP_LITTLE_ENDIAN) && defined(__GNUC__)
+      return j + (static_cast<unsigned int>(__builtin_ctzll(zeros)) >> 3);
+#else
+      break;
+#endif
     }
+    j += 8;
+  }
 
-    // Bottom
-    if (I[i + 1][j] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i + 1, j));
+  while (j < width && src[j] != 0) {
+    j++;
+  }
+  return j;
+}
+
+// First scan of a stripe: extract the runs and connect them. The rows above
+// the stripe are ignored, so that stripes can be processed concurrently.
+// When background is true, the runs of 0 are extracted instead of the other
+// values.
+void labelStripe(const vpImage<unsigned char> &I, vpStripe &stripe, unsigned int d, bool background = false)
+{
+  const unsigned int width = I.getWidth();
+  stripe.m_runs.clear();
+  stripe.m_row_runs.assign(1, 0);
+
+  for (unsigned int i = stripe.m_i_begin; i < stripe.m_i_end; i++) {
+    const unsigned char *src = I[i];
+    unsigned int j = background ? findZero(src, 0, width) : findRunEnd(src, 0, width, 0);
+    while (j < width) {
+      vpRun run;
+      run.m_begin = j;
+      run.m_value = src[j];
+      j = findRunEnd(src, j + 1, width, run.m_value);
+      run.m_end = j;
+      stripe.m_runs.push_back(run);
+
+      j = background ? findZero(src, j, width) : findRunEnd(src, j, width, 0);
     }
-  } else {
-    for (int cpt1 = -1; cpt1 <= 1; cpt1++) {
-      for (int cpt2 = -1; cpt2 <= 1; cpt2++) {
-        // Everything except the current position
-        if (cpt1 != 0 || cpt2 != 0) {
-          if (I[(int)i + cpt1][(int)j + cpt2] == currValue) {
-            listOfNeighbors.push(vpImagePoint((int)i + cpt1, (int)j + cpt2));
-          }
-        }
+    stripe.m_row_runs.push_back(stripe.m_runs.size());
+  }
+
+  stripe.m_parent.resize(stripe.m_runs.size());
+  for (size_t k = 0; k < stripe.m_parent.size(); k++) {
+    stripe.m_parent[k] = k;
+  }
+  for (size_t r = 1; r + 1 < stripe.m_row_runs.size(); r++) {
+    mergeRows(stripe.m_runs, stripe.m_row_runs[r - 1], stripe.m_row_runs[r], 0, stripe.m_runs, stripe.m_row_runs[r],
+              stripe.m_row_runs[r + 1], 0, stripe.m_parent, d);
+  }
+}
+
+struct vpComponentAccumulator {
+  vpComponentAccumulator()
+    : m_area(0), m_sum_i(0), m_sum_j(0), m_min_i(std::numeric_limits<unsigned int>::max()),
+      m_min_j(std::numeric_limits<unsigned int>::max()), m_max_i(0), m_max_j(0)
+  {
+  }
+
+  void add(const vpComponentAccumulator &other)
+  {
+    m_area += other.m_area;
+    m_sum_i += other.m_sum_i;
+    m_sum_j += other.m_sum_j;
+    m_min_i = (std::min)(m_min_i, other.m_min_i);
+    m_min_j = (std::min)(m_min_j, other.m_min_j);
+    m_max_i = (std::max)(m_max_i, other.m_max_i);
+    m_max_j = (std::max)(m_max_j, other.m_max_j);
+  }
+
+  unsigned int m_area;
+  double m_sum_i, m_sum_j;
+  unsigned int m_min_i, m_min_j, m_max_i, m_max_j;
+};
+
+// Second scan: write the final labels of the runs of a stripe and accumulate
+// the statistics of the components
+void relabelStripe(const vpStripe &stripe, const std::vector<int> &final_labels, vpImage<int> &labels,
+                   std::vector<vpComponentAccumulator> *accumulators)
+{
+  const unsigned int width = labels.getWidth();
+  for (unsigned int i = stripe.m_i_begin; i < stripe.m_i_end; i++) {
+    int *dst = labels[i];
+    unsigned int j = 0;
+    const size_t r = i - stripe.m_i_begin;
+    for (size_t k = stripe.m_row_runs[r]; k < stripe.m_row_runs[r + 1]; k++) {
+      const vpRun &run = stripe.m_runs[k];
+      const int label = final_labels[stripe.m_offset + k];
+      std::fill(dst + j, dst + run.m_begin, 0);
+      std::fill(dst + run.m_begin, dst + run.m_end, label);
+      j = run.m_end;
+
+      if (accumulators != NULL) {
+        vpComponentAccumulator &acc = (*accumulators)[label - 1];
+        const unsigned int length = run.m_end - run.m_begin;
+        acc.m_area += length;
+        acc.m_sum_i += static_cast<double>(i) * length;
+        acc.m_sum_j += 0.5 * (run.m_begin + run.m_end - 1.0) * length;
+        acc.m_min_i = (std::min)(acc.m_min_i, i);
+        acc.m_max_i = i; // rows are scanned in increasing order
+        acc.m_min_j = (std::min)(acc.m_min_j, run.m_begin);
+        acc.m_max_j = (std::max)(acc.m_max_j, run.m_end - 1);
       }
     }
+    std::fill(dst + j, dst + width, 0);
   }
 }
 
-void visitNeighbors(vpImage<unsigned char> &I_copy, std::queue<vpImagePoint> &listOfNeighbors, vpImage<int> &labels,
-                    int current_label, const vpImageMorphology::vpConnexityType &connexity)
+void labelComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                     std::vector<vp::vpConnectedComponentStats> *stats,
+                     const vpImageMorphology::vpConnexityType &connexity, unsigned int nbThreads)
 {
-  // Visit the neighbors
-  while (!listOfNeighbors.empty()) {
-    vpImagePoint imPt = listOfNeighbors.front();
-    unsigned int i = (unsigned int)imPt.get_i();
-    unsigned int j = (unsigned int)imPt.get_j();
-    listOfNeighbors.pop();
-
-    if (I_copy[i][j]) {
-      getNeighbors(I_copy, listOfNeighbors, i, j, connexity);
-
-      // Reset current position and set label
-      I_copy[i][j] = 0;
-      labels[i][j] = current_label;
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  const unsigned int d = connexity == vpImageMorphology::CONNEXITY_8 ? 1 : 0;
+  labels.resize(height, width);
+
+  unsigned int nbStripes = 1;
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool &pool = vpThreadPool::getGlobalInstance();
+  if (nbThreads == 0 || nbThreads > pool.getNbThreads()) {
+    nbThreads = pool.getNbThreads();
+  }
+  nbStripes = (std::min)(nbThreads, height);
+#else
+  (void)nbThreads;
+#endif
+
+  std::vector<vpStripe> stripes(nbStripes);
+  for (unsigned int s = 0; s < nbStripes; s++) {
+    stripes[s].m_i_begin = static_cast<unsigned int>((static_cast<unsigned long long>(height) * s) / nbStripes);
+    stripes[s].m_i_end = static_cast<unsigned int>((static_cast<unsigned long long>(height) * (s + 1)) / nbStripes);
+  }
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  pool.parallelFor(0, static_cast<int>(nbStripes), [&](int start, int end) {
+    for (int s = start; s < end; s++) {
+      labelStripe(I, stripes[s], d);
+    }
+  }, nbThreads, 1);
+#else
+  labelStripe(I, stripes[0], d);
+#endif
+
+  // Gather the forests of the stripes and connect the runs across the stripe borders
+  size_t nbRuns = 0;
+  for (unsigned int s = 0; s < nbStripes; s++) {
+    stripes[s].m_offset = nbRuns;
+    nbRuns += stripes[s].m_runs.size();
+  }
+
+  std::vector<size_t> parent(nbRuns);
+  for (unsigned int s = 0; s < nbStripes; s++) {
+    const vpStripe &stripe = stripes[s];
+    for (size_t k = 0; k < stripe.m_parent.size(); k++) {
+      parent[stripe.m_offset + k] = stripe.m_offset + stripe.m_parent[k];
+    }
+
+    if (s > 0) {
+      const vpStripe &prev = stripes[s - 1];
+      mergeRows(prev.m_runs, prev.m_row_runs[prev.m_row_runs.size() - 2], prev.m_runs.size(), prev.m_offset,
+                stripe.m_runs, 0, stripe.m_row_runs[1], stripe.m_offset, parent, d);
+    }
+  }
+
+  // Roots get consecutive labels in increasing order, parents being resolved
+  // before their children. Components are thus numbered in raster order.
+  std::vector<int> final_labels(nbRuns);
+  int current_label = 0;
+  for (size_t k = 0; k < nbRuns; k++) {
+    final_labels[k] = parent[k] < k ? final_labels[parent[k]] : ++current_label;
+  }
+  nbComponents = current_label;
+
+  std::vector<std::vector<vpComponentAccumulator> > accumulators;
+  if (stats != NULL) {
+    accumulators.resize(nbStripes, std::vector<vpComponentAccumulator>(static_cast<size_t>(nbComponents)));
+  }
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  pool.parallelFor(0, static_cast<int>(nbStripes), [&](int start, int end) {
+    for (int s = start; s < end; s++) {
+      relabelStripe(stripes[s], final_labels, labels, stats != NULL ? &accumulators[s] : NULL);
+    }
+  }, nbThreads, 1);
+#else
+  relabelStripe(stripes[0], final_labels, labels, stats != NULL ? &accumulators[0] : NULL);
+#endif
+
+  if (stats != NULL) {
+    stats->resize(static_cast<size_t>(nbComponents));
+    for (int k = 0; k < nbComponents; k++) {
+      vpComponentAccumulator &acc = accumulators[0][k];
+      for (unsigned int s = 1; s < nbStripes; s++) {
+        acc.add(accumulators[s][k]);
+      }
+
+      vp::vpConnectedComponentStats &stat = (*stats)[k];
+      stat.m_area = acc.m_area;
+      stat.m_bbox = vpRect(acc.m_min_j, acc.m_min_i, acc.m_max_j - acc.m_min_j + 1, acc.m_max_i - acc.m_min_i + 1);
+      stat.m_centroid = vpImagePoint(acc.m_sum_i / acc.m_area, acc.m_sum_j / acc.m_area);
     }
   }
 }
@@ -109,64 +356,109 @@ void visitNeighbors(vpImage<unsigned char> &I_copy, std::queue<vpImagePoint> &li
 /*!
   \ingroup group_imgproc_connected_components
 
-  Perform connected components detection.
+  Perform connected components detection. Neighbouring pixels are connected
+  when they have the same value.
+
+  Labelling is done in two scans: the first one extracts the runs of pixels
+  of each row and merges the connected runs with a union-find, the second one
+  writes the final labels run by run. With several threads, the image is split
+  into stripes of rows that are processed concurrently, the runs being merged
+  at the stripe borders. Whatever the number of threads, components are
+  numbered from 1 in the raster order of their first pixel.
 
   \param I : Input image (0 means background).
   \param labels : Label image that contain for each position the component
   label. \param nbComponents : Number of connected components. \param
   connexity : Type of connexity.
+  \param nbThreads : Number of threads. If 0, all the threads of the global
+  vpThreadPool are used. Only available with c++11 or higher, otherwise the
+  labelling is sequential.
 */
 void vp::connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
-                             const vpImageMorphology::vpConnexityType &connexity)
+                             const vpImageMorphology::vpConnexityType &connexity, unsigned int nbThreads)
 {
   if (I.getSize() == 0) {
     return;
   }
 
-  labels.resize(I.getHeight(), I.getWidth());
+  labelComponents(I, labels, nbComponents, NULL, connexity, nbThreads);
+}
 
-  vpImage<unsigned char> I_copy(I.getHeight() + 2, I.getWidth() + 2);
-  // Copy and add border
-  for (unsigned int i = 0; i < I_copy.getHeight(); i++) {
-    if (i == 0 || i == I_copy.getHeight() - 1) {
-      memset(I_copy[i], 0, sizeof(unsigned char) * I_copy.getWidth());
-    } else {
-      I_copy[i][0] = 0;
-      memcpy(I_copy[i] + 1, I[i - 1], sizeof(unsigned char) * I.getWidth());
-      I_copy[i][I_copy.getWidth() - 1] = 0;
-    }
-  }
+/*!
+  \ingroup group_imgproc_connected_components
 
-  vpImage<int> labels_copy(I.getHeight() + 2, I.getWidth() + 2, 0);
+  Perform connected components detection and compute the statistics of each
+  component during the relabelling scan.
+
+  \param I : Input image (0 means background).
+  \param labels : Label image that contain for each position the component
+  label.
+  \param nbComponents : Number of connected components.
+  \param stats : Statistics of the components, stats[k] corresponds to the
+  label k+1.
+  \param connexity : Type of connexity.
+  \param nbThreads : Number of threads. If 0, all the threads of the global
+  vpThreadPool are used.
 
-  int current_label = 1;
-  std::queue<vpImagePoint> listOfNeighbors;
+  \sa connectedComponents(const vpImage<unsigned char> &, vpImage<int> &, int &, const vpImageMorphology::vpConnexityType &, unsigned int)
+*/
+void vp::connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                             std::vector<vpConnectedComponentStats> &stats,
+                             const vpImageMorphology::vpConnexityType &connexity, unsigned int nbThreads)
+{
+  stats.clear();
+  if (I.getSize() == 0) {
+    return;
+  }
 
-  for (unsigned int cpt1 = 0; cpt1 < I.getHeight(); cpt1++) {
-    unsigned int i = cpt1 + 1;
+  labelComponents(I, labels, nbComponents, &stats, connexity, nbThreads);
+}
 
-    for (unsigned int cpt2 = 0; cpt2 < I.getWidth(); cpt2++) {
-      unsigned int j = cpt2 + 1;
+#if !USE_OLD_FILL_HOLE
+/*!
+  \ingroup group_imgproc_morph
 
-      if (I_copy[i][j] && labels_copy[i][j] == 0) {
-        // Get all the neighbors relative to the current position
-        getNeighbors(I_copy, listOfNeighbors, i, j, connexity);
+  Fill the holes in a binary image. The holes are the 4-connected background
+  components that do not touch the image border. They are found with the
+  runs and the union-find of connectedComponents(), without writing a label
+  image. The holes are set to 255 and the foreground pixels keep their
+  value.
 
-        // Reset current position and set label
-        I_copy[i][j] = 0;
-        labels_copy[i][j] = current_label;
+  \param I : Input binary image (0 means background, 255 means foreground).
+*/
+void vp::fillHoles(vpImage<unsigned char> &I)
+{
+  if (I.getSize() == 0) {
+    return;
+  }
 
-        visitNeighbors(I_copy, listOfNeighbors, labels_copy, current_label, connexity);
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  vpStripe stripe;
+  stripe.m_i_end = height;
+  labelStripe(I, stripe, 0, true);
 
-        // Increment label
-        current_label++;
+  // Point each run to its root and flag the roots of the components touching the border
+  std::vector<size_t> &parent = stripe.m_parent;
+  std::vector<bool> border(parent.size(), false);
+  for (unsigned int i = 0; i < height; i++) {
+    for (size_t k = stripe.m_row_runs[i]; k < stripe.m_row_runs[i + 1]; k++) {
+      parent[k] = parent[parent[k]];
+      const vpRun &run = stripe.m_runs[k];
+      if (i == 0 || i == height - 1 || run.m_begin == 0 || run.m_end == width) {
+        border[parent[k]] = true;
       }
     }
   }
 
-  for (unsigned int i = 0; i < labels.getHeight(); i++) {
-    memcpy(labels[i], labels_copy[i + 1] + 1, sizeof(int) * labels.getWidth());
+  // Holes are set to 255, foreground pixels keep their value
+  for (unsigned int i = 0; i < height; i++) {
+    unsigned char *dst = I[i];
+    for (size_t k = stripe.m_row_runs[i]; k < stripe.m_row_runs[i + 1]; k++) {
+      const vpRun &run = stripe.m_runs[k];
+      if (!border[parent[k]]) {
+        memset(dst + run.m_begin, 255, run.m_end - run.m_begin);
+      }
+    }
   }
-
-  nbComponents = current_label - 1;
 }
+#endif
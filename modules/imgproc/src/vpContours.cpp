@@ -287,40 +287,23 @@ void vp::drawContours(vpImage<vpRGBa> &I, const std::vector<std::vector<vpImageP
   }
 }
 
-/*!
-  \ingroup group_imgproc_contours
-
-  Extract contours from a binary image.
-
-  \param I_original : Input binary image (0 means background, 1 means
-  foreground, other values are not allowed). \param contours : Detected
-  contours. \param contourPts : List of contours, each contour contains a list
-  of contour points. \param retrievalMode : Contour retrieval mode.
-*/
-void vp::findContours(const vpImage<unsigned char> &I_original, vpContour &contours,
-                      std::vector<std::vector<vpImagePoint> > &contourPts, const vpContourRetrievalType &retrievalMode)
+namespace
 {
-  if (I_original.getSize() == 0) {
-    return;
+void translateContours(vp::vpContour &contour, const vpImagePoint &offset)
+{
+  for (size_t k = 0; k < contour.m_points.size(); k++) {
+    contour.m_points[k] += offset;
   }
 
-  // Clear output results
-  contourPts.clear();
-
-  // Copy uchar I_original into int I + padding
-  vpImage<int> I(I_original.getHeight() + 2, I_original.getWidth() + 2);
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    if (i == 0 || i == I.getHeight() - 1) {
-      memset(I.bitmap, 0, sizeof(int) * I.getWidth());
-    } else {
-      I[i][0] = 0;
-      for (unsigned int j = 0; j < I_original.getWidth(); j++) {
-        I[i][j + 1] = I_original[i - 1][j];
-      }
-      I[i][I.getWidth() - 1] = 0;
-    }
+  for (std::vector<vp::vpContour *>::iterator it = contour.m_children.begin(); it != contour.m_children.end(); ++it) {
+    translateContours(**it, offset);
   }
+}
 
+// Suzuki border following on a padded image (0 background, 1 foreground)
+void findContoursPadded(vpImage<int> &I, vp::vpContour &contours, std::vector<std::vector<vpImagePoint> > &contourPts,
+                        const vp::vpContourRetrievalType &retrievalMode)
+{
   // Ref: http://openimaj.org/
   // Ref: Satoshi Suzuki and others. Topological structural analysis of
   // digitized binary images by border following.
@@ -329,9 +312,9 @@ void vp::findContours(const vpImage<unsigned char> &I_original, vpContour &conto
 
   // Background contour
   // By default the root contour is a hole contour
-  vpContour *root = new vpContour(vp::CONTOUR_HOLE);
+  vp::vpContour *root = new vp::vpContour(vp::CONTOUR_HOLE);
 
-  std::map<int, vpContour *> borderMap;
+  std::map<int, vp::vpContour *> borderMap;
   borderMap[lnbd] = root;
 
   for (unsigned int i = 0; i < I.getHeight(); i++) {
@@ -344,8 +327,8 @@ void vp::findContours(const vpImage<unsigned char> &I_original, vpContour &conto
       bool isHole = isHoleBorderStart(I, i, j);
 
       if (isOuter || isHole) { // else (1) (c)
-        vpContour *border = new vpContour;
-        vpContour *borderPrime = NULL;
+        vp::vpContour *border = new vp::vpContour;
+        vp::vpContour *borderPrime = NULL;
         vpImagePoint from(i, j);
 
         if (isOuter) {
@@ -404,7 +387,7 @@ void vp::findContours(const vpImage<unsigned char> &I_original, vpContour &conto
           I[i][j] = -nbd;
         }
 
-        if (retrievalMode == CONTOUR_RETR_LIST || retrievalMode == CONTOUR_RETR_TREE) {
+        if (retrievalMode == vp::CONTOUR_RETR_LIST || retrievalMode == vp::CONTOUR_RETR_TREE) {
           // Add contour points
           contourPts.push_back(border->m_points);
         }
@@ -419,11 +402,11 @@ void vp::findContours(const vpImage<unsigned char> &I_original, vpContour &conto
     }
   }
 
-  if (retrievalMode == CONTOUR_RETR_EXTERNAL || retrievalMode == CONTOUR_RETR_LIST) {
+  if (retrievalMode == vp::CONTOUR_RETR_EXTERNAL || retrievalMode == vp::CONTOUR_RETR_LIST) {
     // Delete contours content
     contours.m_parent = NULL;
 
-    for (std::vector<vpContour *>::iterator it = contours.m_children.begin(); it != contours.m_children.end(); ++it) {
+    for (std::vector<vp::vpContour *>::iterator it = contours.m_children.begin(); it != contours.m_children.end(); ++it) {
       (*it)->m_parent = NULL;
       if (*it != NULL) {
         delete *it;
@@ -434,15 +417,15 @@ void vp::findContours(const vpImage<unsigned char> &I_original, vpContour &conto
     contours.m_children.clear();
   }
 
-  if (retrievalMode == CONTOUR_RETR_EXTERNAL) {
+  if (retrievalMode == vp::CONTOUR_RETR_EXTERNAL) {
     // Add only external contours
-    for (std::vector<vpContour *>::const_iterator it = root->m_children.begin(); it != root->m_children.end(); ++it) {
+    for (std::vector<vp::vpContour *>::const_iterator it = root->m_children.begin(); it != root->m_children.end(); ++it) {
       // Save children
-      std::vector<vpContour *> children_copy = (*it)->m_children;
+      std::vector<vp::vpContour *> children_copy = (*it)->m_children;
       // Erase children
       (*it)->m_children.clear();
       // Copy contour
-      contours.m_children.push_back(new vpContour(**it));
+      contours.m_children.push_back(new vp::vpContour(**it));
       // Restore children
       (*it)->m_children = children_copy;
       // Set parent to children
@@ -451,18 +434,115 @@ void vp::findContours(const vpImage<unsigned char> &I_original, vpContour &conto
       }
       contourPts.push_back((*it)->m_points);
     }
-  } else if (retrievalMode == CONTOUR_RETR_LIST) {
+  } else if (retrievalMode == vp::CONTOUR_RETR_LIST) {
     getContoursList(*root, 0, contours);
 
     // Set parent to root
-    for (std::vector<vpContour *>::iterator it = contours.m_children.begin(); it != contours.m_children.end(); ++it) {
+    for (std::vector<vp::vpContour *>::iterator it = contours.m_children.begin(); it != contours.m_children.end(); ++it) {
       (*it)->m_parent = &contours;
     }
   } else {
-    // CONTOUR_RETR_TREE
+    // vp::CONTOUR_RETR_TREE
     contours = *root;
   }
 
   delete root;
   root = NULL;
 }
+} // namespace
+
+/*!
+  \ingroup group_imgproc_contours
+
+  Extract contours from a binary image.
+
+  \param I_original : Input binary image (0 means background, 1 means
+  foreground, other values are not allowed). \param contours : Detected
+  contours. \param contourPts : List of contours, each contour contains a list
+  of contour points. \param retrievalMode : Contour retrieval mode.
+*/
+void vp::findContours(const vpImage<unsigned char> &I_original, vpContour &contours,
+                      std::vector<std::vector<vpImagePoint> > &contourPts, const vpContourRetrievalType &retrievalMode)
+{
+  if (I_original.getSize() == 0) {
+    return;
+  }
+
+  // Clear output results
+  contourPts.clear();
+
+  // Copy uchar I_original into int I + padding
+  vpImage<int> I(I_original.getHeight() + 2, I_original.getWidth() + 2);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    if (i == 0 || i == I.getHeight() - 1) {
+      memset(I[i], 0, sizeof(int) * I.getWidth());
+    } else {
+      I[i][0] = 0;
+      for (unsigned int j = 0; j < I_original.getWidth(); j++) {
+        I[i][j + 1] = I_original[i - 1][j];
+      }
+      I[i][I.getWidth() - 1] = 0;
+    }
+  }
+
+  findContoursPadded(I, contours, contourPts, retrievalMode);
+}
+
+/*!
+  \ingroup group_imgproc_contours
+
+  Extract the contours of a connected component, reusing the labels computed
+  by connectedComponents() instead of thresholding the image again. Only the
+  bounding box of the component is scanned when its statistics are given.
+
+  \param labels : Label image computed by connectedComponents().
+  \param label : Label of the component.
+  \param contours : Detected contours.
+  \param contourPts : List of contours, each contour contains a list of
+  contour points.
+  \param retrievalMode : Contour retrieval mode.
+  \param stats : Statistics of the component, as computed by
+  connectedComponents(), or NULL to scan the whole label image.
+*/
+void vp::findContours(const vpImage<int> &labels, int label, vpContour &contours,
+                      std::vector<std::vector<vpImagePoint> > &contourPts, const vpContourRetrievalType &retrievalMode,
+                      const vpConnectedComponentStats *stats)
+{
+  if (labels.getSize() == 0) {
+    return;
+  }
+
+  // Clear output results
+  contourPts.clear();
+
+  unsigned int top = 0, left = 0, height = labels.getHeight(), width = labels.getWidth();
+  if (stats != NULL && stats->m_area > 0) {
+    top = static_cast<unsigned int>(stats->m_bbox.getTop());
+    left = static_cast<unsigned int>(stats->m_bbox.getLeft());
+    height = static_cast<unsigned int>(stats->m_bbox.getHeight());
+    width = static_cast<unsigned int>(stats->m_bbox.getWidth());
+  }
+
+  // Binary image of the component + padding
+  vpImage<int> I(height + 2, width + 2, 0);
+  for (unsigned int i = 0; i < height; i++) {
+    const int *src = labels[top + i] + left;
+    int *dst = I[i + 1] + 1;
+    for (unsigned int j = 0; j < width; j++) {
+      dst[j] = src[j] == label ? 1 : 0;
+    }
+  }
+
+  findContoursPadded(I, contours, contourPts, retrievalMode);
+
+  // Contour points are expressed in the label image frame
+  if (top != 0 || left != 0) {
+    vpImagePoint offset(top, left);
+    for (size_t k = 0; k < contourPts.size(); k++) {
+      for (size_t l = 0; l < contourPts[k].size(); l++) {
+        contourPts[k][l] += offset;
+      }
+    }
+    translateContours(contours, offset);
+  }
+}
@@ -44,25 +44,21 @@
 #include <visp3/core/vpImageTools.h>
 #include <visp3/imgproc/vpImgproc.h>
 
+#if USE_OLD_FILL_HOLE
 /*!
   \ingroup group_imgproc_morph
 
   Fill the holes in a binary image.
 
   \param I : Input binary image (0 means background, 255 means foreground).
+  \param connexity : Type of connexity.
 */
-void vp::fillHoles(vpImage<unsigned char> &I
-#if USE_OLD_FILL_HOLE
-                   ,
-                   const vpImageMorphology::vpConnexityType &connexity
-#endif
-)
+void vp::fillHoles(vpImage<unsigned char> &I, const vpImageMorphology::vpConnexityType &connexity)
 {
   if (I.getSize() == 0) {
     return;
   }
 
-#if USE_OLD_FILL_HOLE
   // Code similar to Matlab imfill(BW,'holes')
   // Replaced by flood fill as imfill use imreconstruct
   // and our reconstruct implementation is naive and inefficient
@@ -100,29 +96,8 @@ void vp::fillHoles(vpImage<unsigned char> &I
       I[i][j] = 255 - I_reconstruct[i + 1][j + 1];
     }
   }
-#else
-  // Create flood fill mask
-  vpImage<unsigned char> flood_fill_mask(I.getHeight() + 2, I.getWidth() + 2, 0);
-  // Copy I to mask + add border padding
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    memcpy(flood_fill_mask[i + 1] + 1, I[i], sizeof(unsigned char) * I.getWidth());
-  }
-
-  // Perform flood fill
-  vp::floodFill(flood_fill_mask, vpImagePoint(0, 0), 0, 255);
-
-  // Get current mask
-  vpImage<unsigned char> mask(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < mask.getHeight(); i++) {
-    memcpy(mask[i], flood_fill_mask[i + 1] + 1, sizeof(unsigned char) * mask.getWidth());
-  }
-
-  // Get image with holes filled
-  vpImage<unsigned char> I_white(I.getHeight(), I.getWidth(), 255), I_holes;
-  vpImageTools::imageSubtract(I_white, mask, I_holes);
-  vpImageTools::imageAdd(I, I_holes, I, true);
-#endif
 }
+#endif
 
 /*!
   \ingroup group_imgproc_morph
@@ -0,0 +1,368 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark connected components labelling.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfConnectedComponents.cpp
+
+  \brief Compare the union-find connected components with the former flood
+  fill labelling.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <queue>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+namespace
+{
+
+bool runBenchmark = false;
+
+// Random blobs of a few grey levels, so that neighbouring components may
+// have different values
+void generateImage(unsigned int height, unsigned int width, unsigned int nbBlobs, unsigned int nbValues,
+                   vpImage<unsigned char> &I)
+{
+  I.resize(height, width, 0);
+  for (unsigned int k = 0; k < nbBlobs; k++) {
+    int ci = rand() % height, cj = rand() % width;
+    int radius = 1 + rand() % 12;
+    unsigned char value = static_cast<unsigned char>(1 + rand() % nbValues);
+    for (int i = ci - radius; i <= ci + radius; i++) {
+      for (int j = cj - radius; j <= cj + radius; j++) {
+        if (i >= 0 && j >= 0 && i < static_cast<int>(height) && j < static_cast<int>(width) &&
+            (i - ci) * (i - ci) + (j - cj) * (j - cj) <= radius * radius && rand() % 8 != 0) {
+          I[i][j] = value;
+        }
+      }
+    }
+  }
+}
+
+// Copy of the former breadth-first labelling
+void connectedComponentsFlood(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                              const vpImageMorphology::vpConnexityType &connexity)
+{
+  labels.resize(I.getHeight(), I.getWidth(), 0);
+  int current_label = 0;
+  std::queue<std::pair<int, int> > listOfNeighbors;
+  const int height = static_cast<int>(I.getHeight()), width = static_cast<int>(I.getWidth());
+
+  for (int i0 = 0; i0 < height; i0++) {
+    for (int j0 = 0; j0 < width; j0++) {
+      if (I[i0][j0] == 0 || labels[i0][j0] != 0) {
+        continue;
+      }
+
+      current_label++;
+      const unsigned char value = I[i0][j0];
+      labels[i0][j0] = current_label;
+      listOfNeighbors.push(std::make_pair(i0, j0));
+      while (!listOfNeighbors.empty()) {
+        int i = listOfNeighbors.front().first, j = listOfNeighbors.front().second;
+        listOfNeighbors.pop();
+        for (int di = -1; di <= 1; di++) {
+          for (int dj = -1; dj <= 1; dj++) {
+            if ((di == 0 && dj == 0) || (connexity == vpImageMorphology::CONNEXITY_4 && di != 0 && dj != 0)) {
+              continue;
+            }
+            int ii = i + di, jj = j + dj;
+            if (ii >= 0 && jj >= 0 && ii < height && jj < width && I[ii][jj] == value && labels[ii][jj] == 0) {
+              labels[ii][jj] = current_label;
+              listOfNeighbors.push(std::make_pair(ii, jj));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  nbComponents = current_label;
+}
+
+// Copy of the former flood fill based implementation
+void fillHolesFlood(vpImage<unsigned char> &I)
+{
+  vpImage<unsigned char> flood_fill_mask(I.getHeight() + 2, I.getWidth() + 2, 0);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    memcpy(flood_fill_mask[i + 1] + 1, I[i], sizeof(unsigned char) * I.getWidth());
+  }
+
+  vp::floodFill(flood_fill_mask, vpImagePoint(0, 0), 0, 255);
+
+  vpImage<unsigned char> mask(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < mask.getHeight(); i++) {
+    memcpy(mask[i], flood_fill_mask[i + 1] + 1, sizeof(unsigned char) * mask.getWidth());
+  }
+
+  vpImage<unsigned char> I_white(I.getHeight(), I.getWidth(), 255), I_holes;
+  vpImageTools::imageSubtract(I_white, mask, I_holes);
+  vpImageTools::imageAdd(I, I_holes, I, true);
+}
+}
+
+TEST_CASE("Connected components labelling", "[connected_components]") {
+  vpThreadPool::getGlobalInstance().setNbThreads(4);
+
+  const unsigned int sizes[][2] = {{1, 1}, {1, 37}, {41, 1}, {3, 5}, {97, 131}, {240, 320}};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    for (unsigned int nbValues = 1; nbValues <= 3; nbValues++) {
+      vpImage<unsigned char> I;
+      generateImage(sizes[s][0], sizes[s][1], sizes[s][0] * sizes[s][1] / 40 + 1, nbValues, I);
+
+      for (int c = 0; c < 2; c++) {
+        vpImageMorphology::vpConnexityType connexity =
+            c == 0 ? vpImageMorphology::CONNEXITY_4 : vpImageMorphology::CONNEXITY_8;
+        vpImage<int> labels_true;
+        int nbComponents_true = 0;
+        connectedComponentsFlood(I, labels_true, nbComponents_true, connexity);
+
+        for (unsigned int nbThreads = 1; nbThreads <= 4; nbThreads++) {
+          INFO("Image " << I.getHeight() << "x" << I.getWidth() << ", connexity " << (c == 0 ? 4 : 8) << ", "
+                        << nbThreads << " threads");
+          vpImage<int> labels;
+          int nbComponents = 0;
+          vp::connectedComponents(I, labels, nbComponents, connexity, nbThreads);
+          CHECK(nbComponents == nbComponents_true);
+          CHECK((labels == labels_true));
+
+          std::vector<vp::vpConnectedComponentStats> stats;
+          vp::connectedComponents(I, labels, nbComponents, stats, connexity, nbThreads);
+          REQUIRE(stats.size() == static_cast<size_t>(nbComponents_true));
+
+          // Statistics computed from the labels
+          std::vector<unsigned int> area(stats.size(), 0);
+          std::vector<double> sum_i(stats.size(), 0), sum_j(stats.size(), 0);
+          std::vector<double> min_i(stats.size(), I.getHeight()), min_j(stats.size(), I.getWidth());
+          std::vector<double> max_i(stats.size(), 0), max_j(stats.size(), 0);
+          for (unsigned int i = 0; i < I.getHeight(); i++) {
+            for (unsigned int j = 0; j < I.getWidth(); j++) {
+              if (labels_true[i][j] != 0) {
+                size_t k = static_cast<size_t>(labels_true[i][j] - 1);
+                area[k]++;
+                sum_i[k] += i;
+                sum_j[k] += j;
+                min_i[k] = (std::min)(min_i[k], static_cast<double>(i));
+                min_j[k] = (std::min)(min_j[k], static_cast<double>(j));
+                max_i[k] = (std::max)(max_i[k], static_cast<double>(i));
+                max_j[k] = (std::max)(max_j[k], static_cast<double>(j));
+              }
+            }
+          }
+
+          for (size_t k = 0; k < stats.size(); k++) {
+            CHECK(stats[k].m_area == area[k]);
+            CHECK(stats[k].m_bbox.getTop() == Approx(min_i[k]));
+            CHECK(stats[k].m_bbox.getLeft() == Approx(min_j[k]));
+            CHECK(stats[k].m_bbox.getBottom() == Approx(max_i[k]));
+            CHECK(stats[k].m_bbox.getRight() == Approx(max_j[k]));
+            CHECK(stats[k].m_centroid.get_i() == Approx(sum_i[k] / area[k]));
+            CHECK(stats[k].m_centroid.get_j() == Approx(sum_j[k] / area[k]));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Fill holes", "[connected_components]") {
+  for (int iter = 0; iter < 10; iter++) {
+    vpImage<unsigned char> I;
+    generateImage(60 + rand() % 60, 60 + rand() % 60, 20, 1, I);
+    vpImageTools::binarise(I, (unsigned char)1, (unsigned char)255, (unsigned char)0, (unsigned char)255,
+                           (unsigned char)255);
+
+    vpImage<unsigned char> I_true = I;
+    fillHolesFlood(I_true);
+    vp::fillHoles(I);
+    CHECK((I == I_true));
+  }
+}
+
+TEST_CASE("Fill holes keeps the foreground values", "[connected_components]") {
+  for (int iter = 0; iter < 10; iter++) {
+    vpImage<unsigned char> I;
+    generateImage(60 + rand() % 60, 60 + rand() % 60, 20, 3, I);
+
+    // The former implementation sets the foreground to 255 too
+    vpImage<unsigned char> I_true = I;
+    fillHolesFlood(I_true);
+    for (unsigned int k = 0; k < I.getSize(); k++) {
+      if (I.bitmap[k] != 0) {
+        I_true.bitmap[k] = I.bitmap[k];
+      }
+    }
+    vp::fillHoles(I);
+    CHECK((I == I_true));
+  }
+
+  // Ring of value 100 around a hole
+  vpImage<unsigned char> I(7, 7, 0);
+  for (unsigned int i = 1; i < 6; i++) {
+    for (unsigned int j = 1; j < 6; j++) {
+      I[i][j] = (i == 1 || i == 5 || j == 1 || j == 5) ? 100 : 0;
+    }
+  }
+  vp::fillHoles(I);
+  CHECK(I[0][0] == 0);
+  CHECK(I[1][1] == 100);
+  CHECK(I[3][3] == 255);
+}
+
+TEST_CASE("Contours of a connected component", "[connected_components]") {
+  vpImage<unsigned char> I;
+  generateImage(120, 160, 30, 1, I);
+
+  vpImage<int> labels;
+  int nbComponents = 0;
+  std::vector<vp::vpConnectedComponentStats> stats;
+  vp::connectedComponents(I, labels, nbComponents, stats, vpImageMorphology::CONNEXITY_8);
+
+  for (int k = 0; k < nbComponents; k++) {
+    vpImage<unsigned char> I_component(I.getHeight(), I.getWidth());
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      I_component.bitmap[i] = labels.bitmap[i] == k + 1 ? 1 : 0;
+    }
+
+    vp::vpContour contours_true;
+    std::vector<std::vector<vpImagePoint> > contourPts_true;
+    vp::findContours(I_component, contours_true, contourPts_true);
+
+    vp::vpContour contours, contours_bbox;
+    std::vector<std::vector<vpImagePoint> > contourPts, contourPts_bbox;
+    vp::findContours(labels, k + 1, contours, contourPts);
+    vp::findContours(labels, k + 1, contours_bbox, contourPts_bbox, vp::CONTOUR_RETR_TREE, &stats[k]);
+
+    CHECK(contourPts == contourPts_true);
+    CHECK(contourPts_bbox == contourPts_true);
+    REQUIRE(contours_bbox.m_children.size() == contours_true.m_children.size());
+    for (size_t c = 0; c < contours_true.m_children.size(); c++) {
+      CHECK(contours_bbox.m_children[c]->m_points == contours_true.m_children[c]->m_points);
+    }
+  }
+}
+
+TEST_CASE("Benchmark connected components", "[benchmark]") {
+  if (runBenchmark) {
+    vpImage<unsigned char> I;
+    generateImage(1080, 1920, 20000, 1, I);
+
+    vpImage<int> labels_true;
+    int nbComponents_true = 0;
+    BENCHMARK("Connected components - Flood fill") {
+      connectedComponentsFlood(I, labels_true, nbComponents_true, vpImageMorphology::CONNEXITY_8);
+      return nbComponents_true;
+    };
+
+    vpImage<int> labels;
+    int nbComponents = 0;
+    BENCHMARK("Connected components - ViSP") {
+      vp::connectedComponents(I, labels, nbComponents, vpImageMorphology::CONNEXITY_8);
+      return nbComponents;
+    };
+    REQUIRE((labels == labels_true));
+
+    const unsigned int nbThreads = vpThreadPool::getGlobalInstance().getNbThreads();
+    BENCHMARK("Connected components - ViSP multi-threaded") {
+      vp::connectedComponents(I, labels, nbComponents, vpImageMorphology::CONNEXITY_8, nbThreads);
+      return nbComponents;
+    };
+    REQUIRE((labels == labels_true));
+
+    std::vector<vp::vpConnectedComponentStats> stats;
+    BENCHMARK("Connected components - ViSP with statistics") {
+      vp::connectedComponents(I, labels, nbComponents, stats, vpImageMorphology::CONNEXITY_8);
+      return nbComponents;
+    };
+
+    vpImageTools::binarise(I, (unsigned char)1, (unsigned char)255, (unsigned char)0, (unsigned char)255,
+                           (unsigned char)255);
+    vpImage<unsigned char> I_fill;
+    BENCHMARK("Fill holes - Flood fill") {
+      I_fill = I;
+      fillHolesFlood(I_fill);
+      return I_fill.bitmap[0];
+    };
+
+    BENCHMARK("Fill holes - ViSP") {
+      I_fill = I;
+      vp::fillHoles(I_fill);
+      return I_fill.bitmap[0];
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  // Initialize the random generator for reproducible values
+  srand(0);
+
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark comparing the former flood fill with ViSP implementation");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
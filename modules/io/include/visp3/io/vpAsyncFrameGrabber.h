@@ -0,0 +1,166 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Asynchronous image acquisition from a frame grabber.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpAsyncFrameGrabber.h
+  \brief Asynchronous image acquisition from a frame grabber.
+*/
+
+#ifndef vpAsyncFrameGrabber_H
+#define vpAsyncFrameGrabber_H
+
+#include <visp3/core/vpConfig.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+
+#include <visp3/core/vpFrameGrabber.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+
+/*!
+  \class vpAsyncFrameGrabber
+
+  \ingroup group_io_video
+
+  \brief Acquire the images of any vpFrameGrabber in the background.
+
+  The acquire() function of a frame grabber blocks until the next image is
+  captured and converted, or read and decoded in the case of vpDiskGrabber or
+  vpVideoReader, so that the acquisition time adds to the processing time of
+  the loop that uses the images. This class wraps a frame grabber and calls
+  its acquire() function in a capture thread, that stores the images in a
+  ring of buffers allocated by open(). acquire() then only has to copy an
+  image already captured into the image of the caller, which keeps its
+  memory, and thus a display attached to it, when the size does not change.
+  The image is converted when its type is not the one passed to open().
+
+  Each image is associated to the time in ms given by vpTime::measureTimeMs()
+  when the wrapped acquire() returned. The images are delivered according to
+  the vpDeliveryMode:
+  - with LATEST_FRAME, acquire() returns the most recent image that was not
+    delivered yet. The older images that were not delivered are discarded
+    and counted as dropped, and the capture thread never waits, recycling the
+    oldest buffer when the consumer is late. This is the mode suited to a
+    camera used in a visual servoing loop.
+  - with EVERY_FRAME, acquire() returns the images in the order of their
+    capture and none is dropped: when all the buffers are filled, the capture
+    thread waits until acquire() releases one. This is the mode suited to
+    process all the images of a sequence read from the disk.
+
+  acquire() waits until an image is available. When the wrapped acquire()
+  throws, for example at the end of a sequence read by vpDiskGrabber, the
+  capture thread stops, the images already captured are still delivered and
+  the next call to acquire() throws the exception message.
+
+  \code
+#include <iostream>
+#include <visp3/io/vpAsyncFrameGrabber.h>
+#include <visp3/io/vpDiskGrabber.h>
+
+int main()
+{
+  vpImage<unsigned char> I;
+  vpDiskGrabber reader;
+  reader.setGenericName("./image/image%04d.pgm");
+
+  vpAsyncFrameGrabber g(&reader);
+  g.setDeliveryMode(vpAsyncFrameGrabber::EVERY_FRAME);
+  g.open(I);
+  try {
+    for (;;) {
+      double timestamp;
+      g.acquire(I, timestamp); // The next image is read while I is processed
+      // Here the code to process I
+    }
+  } catch (const vpException &e) {
+    std::cout << "End of the sequence: " << e.getStringMessage() << std::endl;
+  }
+  g.close();
+  std::cout << g.getNbFramesCaptured() << " frames captured" << std::endl;
+}
+  \endcode
+
+  \note The wrapped frame grabber is used by the capture thread between
+  open() and close() and must not be used directly meanwhile.
+
+  \note This class requires c++11 or higher.
+*/
+class VISP_EXPORT vpAsyncFrameGrabber : public vpFrameGrabber
+{
+public:
+  //! Images returned by acquire()
+  typedef enum {
+    LATEST_FRAME, //!< The most recent image, the older ones being dropped
+    EVERY_FRAME   //!< All the images in the order of their capture
+  } vpDeliveryMode;
+
+  vpAsyncFrameGrabber();
+  explicit vpAsyncFrameGrabber(vpFrameGrabber *grabber);
+  virtual ~vpAsyncFrameGrabber();
+
+  void acquire(vpImage<unsigned char> &I);
+  void acquire(vpImage<vpRGBa> &I);
+  void acquire(vpImage<unsigned char> &I, double &timestamp);
+  void acquire(vpImage<vpRGBa> &I, double &timestamp);
+
+  void close();
+
+  unsigned int getBufferSize() const;
+  vpDeliveryMode getDeliveryMode() const;
+  vpFrameGrabber *getFrameGrabber() const;
+  unsigned int getNbFramesAvailable() const;
+  unsigned int getNbFramesCaptured() const;
+  unsigned int getNbFramesDropped() const;
+
+  bool isCapturing() const;
+  bool isOpen() const;
+
+  void open(vpImage<unsigned char> &I);
+  void open(vpImage<vpRGBa> &I);
+
+  void setBufferSize(unsigned int bufferSize);
+  void setDeliveryMode(vpDeliveryMode mode);
+  void setFrameGrabber(vpFrameGrabber *grabber);
+
+private:
+  vpAsyncFrameGrabber(const vpAsyncFrameGrabber &);            // noncopyable
+  vpAsyncFrameGrabber &operator=(const vpAsyncFrameGrabber &); //
+
+  class Impl;
+  Impl *m_impl;
+};
+
+#endif
+#endif
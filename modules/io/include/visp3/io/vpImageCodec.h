@@ -0,0 +1,154 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * In-memory image encoding and decoding.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpImageCodec.h
+  \brief In-memory image encoding and decoding.
+*/
+
+#ifndef vpImageCodec_H
+#define vpImageCodec_H
+
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+
+/*!
+  \class vpImageCodec
+
+  \ingroup group_io_image
+
+  \brief Encode and decode JPEG, PNG and PGM/PPM images in memory.
+
+  Contrary to vpImageIo::read() and vpImageIo::write() that work with files,
+  this class compresses an image into a byte buffer and decompresses an
+  image from a byte buffer. It is intended to send images with vpNetwork,
+  vpClient or vpServer, or to store them in a database, without a round trip
+  through the file system.
+
+  A vpImageCodec instance keeps its codec contexts (libjpeg compression and
+  decompression objects, row pointers, scratch buffers) from one call to the
+  next. When a stream of images is encoded or decoded, using the same
+  instance and the same output buffer avoids any allocation once the first
+  image is processed. A vpImageCodec instance must not be used by several
+  threads at the same time; use one instance per thread.
+
+  JPEG images can also be decoded at 1/2, 1/4 or 1/8 of their resolution.
+  The reduction is done by libjpeg during the inverse DCT, which is much
+  faster than a full resolution decoding followed by vpImageTools::resize().
+  This is well suited to build previews or the top levels of an image
+  pyramid.
+
+  \code
+#include <visp3/io/vpImageCodec.h>
+
+int main()
+{
+  vpImage<vpRGBa> I(480, 640);
+  vpImageCodec codec;
+  std::vector<unsigned char> buffer;
+
+  codec.setJPEGQuality(90);
+  codec.encodeJPEG(I, buffer); // buffer can now be sent over the network
+
+  vpImage<unsigned char> preview;
+  codec.decodeJPEG(preview, &buffer[0], buffer.size(), 4); // 160x120 gray level image
+}
+  \endcode
+
+  This class relies on libjpeg and libpng when available. Otherwise OpenCV or
+  the built-in stb_image library are used; the scaled JPEG decoding is then
+  done by averaging the pixels of the full resolution image.
+
+  \sa vpImageIo::encode(), vpImageIo::decode()
+*/
+class VISP_EXPORT vpImageCodec
+{
+public:
+  vpImageCodec();
+  virtual ~vpImageCodec();
+
+  void decode(vpImage<unsigned char> &I, const unsigned char *data, size_t size);
+  void decode(vpImage<vpRGBa> &I, const unsigned char *data, size_t size);
+
+  void decodeJPEG(vpImage<unsigned char> &I, const unsigned char *data, size_t size, unsigned int scaleDenom = 1);
+  void decodeJPEG(vpImage<vpRGBa> &I, const unsigned char *data, size_t size, unsigned int scaleDenom = 1);
+
+  void decodePNG(vpImage<unsigned char> &I, const unsigned char *data, size_t size);
+  void decodePNG(vpImage<vpRGBa> &I, const unsigned char *data, size_t size);
+
+  void decodePNM(vpImage<unsigned char> &I, const unsigned char *data, size_t size);
+  void decodePNM(vpImage<vpRGBa> &I, const unsigned char *data, size_t size);
+
+  void encodeJPEG(const vpImage<unsigned char> &I, std::vector<unsigned char> &buffer);
+  void encodeJPEG(const vpImage<vpRGBa> &I, std::vector<unsigned char> &buffer);
+
+  void encodePGM(const vpImage<unsigned char> &I, std::vector<unsigned char> &buffer);
+  void encodePGM(const vpImage<vpRGBa> &I, std::vector<unsigned char> &buffer);
+
+  void encodePNG(const vpImage<unsigned char> &I, std::vector<unsigned char> &buffer);
+  void encodePNG(const vpImage<vpRGBa> &I, std::vector<unsigned char> &buffer);
+
+  void encodePPM(const vpImage<unsigned char> &I, std::vector<unsigned char> &buffer);
+  void encodePPM(const vpImage<vpRGBa> &I, std::vector<unsigned char> &buffer);
+
+  /*!
+    Return the quality factor used by encodeJPEG().
+  */
+  inline int getJPEGQuality() const { return m_jpegQuality; }
+  /*!
+    Return the zlib compression level used by encodePNG().
+  */
+  inline int getPNGCompressionLevel() const { return m_pngCompressionLevel; }
+
+  static void getJPEGScaledSize(unsigned int width, unsigned int height, unsigned int scaleDenom,
+                                unsigned int &scaledWidth, unsigned int &scaledHeight);
+
+  void setJPEGQuality(int quality);
+  void setPNGCompressionLevel(int level);
+
+private:
+  vpImageCodec(const vpImageCodec &);            // noncopyable
+  vpImageCodec &operator=(const vpImageCodec &); //
+
+  class Impl;
+  Impl *m_impl;
+  int m_jpegQuality;
+  int m_pngCompressionLevel;
+};
+
+#endif
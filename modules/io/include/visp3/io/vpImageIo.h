@@ -47,10 +47,12 @@
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageView.h>
 #include <visp3/core/vpRGBa.h>
 
 #include <iostream>
 #include <stdio.h>
+#include <vector>
 
 /*!
   \class vpImageIo
@@ -99,6 +101,11 @@ int main()
   read/write jpeg images. It supposes that `libjpeg` is installed.
 
   \include tutorial-image-reader.cpp
+
+  Images can also be encoded into and decoded from a memory buffer with
+  encode() and decode(), for example to send them over the network. To
+  process a stream of images, or to decode JPEG images at a reduced
+  resolution, use vpImageCodec that keeps its codec contexts between calls.
 */
 
 class VISP_EXPORT vpImageIo
@@ -129,6 +136,14 @@ public:
 
   static void write(const vpImage<unsigned char> &I, const std::string &filename);
   static void write(const vpImage<vpRGBa> &I, const std::string &filename);
+  static void write(const vpImageView<const unsigned char> &I, const std::string &filename);
+  static void write(const vpImageView<const vpRGBa> &I, const std::string &filename);
+
+  static void decode(vpImage<unsigned char> &I, const unsigned char *data, size_t size);
+  static void decode(vpImage<vpRGBa> &I, const unsigned char *data, size_t size);
+
+  static void encode(const vpImage<unsigned char> &I, const std::string &format, std::vector<unsigned char> &buffer);
+  static void encode(const vpImage<vpRGBa> &I, const std::string &format, std::vector<unsigned char> &buffer);
 
   static void readPFM(vpImage<float> &I, const std::string &filename);
 
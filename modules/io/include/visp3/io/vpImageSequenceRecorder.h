@@ -0,0 +1,154 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Asynchronous recording of image sequences.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpImageSequenceRecorder.h
+  \brief Asynchronous recording of image sequences.
+*/
+
+#ifndef vpImageSequenceRecorder_H
+#define vpImageSequenceRecorder_H
+
+#include <visp3/core/vpConfig.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+
+#include <string>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+
+/*!
+  \class vpImageSequenceRecorder
+
+  \ingroup group_io_video
+
+  \brief Record a sequence of images in the background.
+
+  Contrary to vpVideoWriter::saveFrame(), saveFrame() does not encode the
+  image: it copies it in a buffer of a bounded queue and returns. A pool of
+  encoder threads writes the queued images with vpImageIo::write(), so that
+  the compression of JPEG or PNG images doesn't delay the loop that produces
+  them, for example a visual servoing loop.
+
+  The file names are built like vpVideoWriter does, from a template such as
+  "./image/image%04d.png" where the frame index is substituted. Each frame
+  index is attributed when saveFrame() is called and the images are dequeued
+  in that order, so the recorded sequence is the same whatever the number of
+  encoder threads.
+
+  The buffers of the queue are allocated once and recycled. When all of them
+  are in use because the encoders are slower than the producer, the
+  behavior depends on the vpBackpressurePolicy:
+  - with BLOCK_POLICY, saveFrame() waits until a buffer is released,
+  - with DROP_POLICY, saveFrame() discards the image and returns false. The
+    frame index is still consumed, so that the index of a recorded image
+    remains the index of the loop iteration that produced it.
+
+  The queue depth, the number of dropped frames and the time spent to encode
+  the images can be monitored while recording.
+
+  \code
+#include <iostream>
+#include <visp3/io/vpImageSequenceRecorder.h>
+
+int main()
+{
+  vpImage<unsigned char> I(480, 640);
+  vpImageSequenceRecorder recorder;
+  recorder.setFileName("./image/image%04d.png");
+  recorder.setNbThreads(2);
+  recorder.setBackpressurePolicy(vpImageSequenceRecorder::DROP_POLICY);
+  recorder.open();
+  for (unsigned int iter = 0; iter < 1000; iter++) {
+    // Here the code to capture or create an image and store it in I
+    recorder.saveFrame(I);
+  }
+  recorder.close(); // Wait until all the queued images are written
+  std::cout << recorder.getNbFramesDropped() << " frames dropped, "
+            << recorder.getMeanEncodeLatency() << " ms per frame" << std::endl;
+}
+  \endcode
+
+  \note This class requires c++11 or higher.
+*/
+class VISP_EXPORT vpImageSequenceRecorder
+{
+public:
+  //! Behavior of saveFrame() when the queue is full
+  typedef enum {
+    BLOCK_POLICY, //!< Wait until a queued image is written
+    DROP_POLICY   //!< Discard the image
+  } vpBackpressurePolicy;
+
+  vpImageSequenceRecorder();
+  virtual ~vpImageSequenceRecorder();
+
+  void close();
+
+  vpBackpressurePolicy getBackpressurePolicy() const;
+  unsigned int getCurrentFrameIndex() const;
+  double getMaxEncodeLatency() const;
+  unsigned int getMaxQueueDepth() const;
+  double getMeanEncodeLatency() const;
+  unsigned int getNbFramesDropped() const;
+  unsigned int getNbFramesWritten() const;
+  unsigned int getNbThreads() const;
+  unsigned int getQueueDepth() const;
+  unsigned int getQueueSize() const;
+
+  bool isOpen() const;
+
+  void open();
+
+  bool saveFrame(const vpImage<unsigned char> &I);
+  bool saveFrame(const vpImage<vpRGBa> &I);
+
+  void setBackpressurePolicy(vpBackpressurePolicy policy);
+  void setFileName(const std::string &filename);
+  void setFirstFrameIndex(unsigned int firstFrame);
+  void setNbThreads(unsigned int nbThreads);
+  void setQueueSize(unsigned int queueSize);
+
+private:
+  vpImageSequenceRecorder(const vpImageSequenceRecorder &);            // noncopyable
+  vpImageSequenceRecorder &operator=(const vpImageSequenceRecorder &); //
+
+  class Impl;
+  Impl *m_impl;
+};
+
+#endif
+#endif
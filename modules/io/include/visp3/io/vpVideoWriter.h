@@ -211,6 +211,7 @@ public:
     \return Returns the current frame index.
   */
   inline unsigned int getCurrentFrameIndex() const { return frameCount; }
+  std::string getFrameName(unsigned int frameIndex) const;
 
   void open(vpImage<vpRGBa> &I);
   void open(vpImage<unsigned char> &I);
@@ -0,0 +1,1105 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * In-memory image encoding and decoding.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpImageCodec.cpp
+  \brief In-memory image encoding and decoding.
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <setjmp.h>
+
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageException.h>
+#include <visp3/io/vpImageCodec.h>
+
+#if defined(_WIN32)
+// Include WinSock2.h before windows.h to ensure that winsock.h is not
+// included by windows.h since winsock.h and winsock2.h are incompatible
+#include <WinSock2.h>
+#include <windows.h>
+#endif
+
+#if defined(VISP_HAVE_JPEG)
+#include <jerror.h>
+#include <jpeglib.h>
+#endif
+
+#if defined(VISP_HAVE_PNG)
+#include <png.h>
+#endif
+
+// Same rule as in vpImageIo.cpp that compiles the stb_image implementation
+#if !defined(VISP_HAVE_OPENCV)
+#if !defined(VISP_HAVE_JPEG) || !defined(VISP_HAVE_PNG)
+#include <stb_image.h>
+#include <stb_image_write.h>
+#define VISP_IMAGE_CODEC_USE_STB
+#endif
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+void vp_checkBuffer(const unsigned char *data, size_t size, const char *format)
+{
+  if (data == NULL || size == 0) {
+    throw(vpImageException(vpImageException::ioError, "Cannot decode %s image: empty buffer", format));
+  }
+}
+
+void vp_checkScaleDenom(unsigned int scaleDenom)
+{
+  if (scaleDenom != 1 && scaleDenom != 2 && scaleDenom != 4 && scaleDenom != 8) {
+    throw(vpException(vpException::badValue, "JPEG scale denominator %u is not 1, 2, 4 or 8", scaleDenom));
+  }
+}
+
+// Read an integer of a PNM header, skipping white spaces and comments
+bool vp_readPNMHeaderValue(const unsigned char *data, size_t size, size_t &pos, unsigned int &value)
+{
+  while (pos < size) {
+    if (data[pos] == '#') {
+      while (pos < size && data[pos] != '\n') {
+        pos++;
+      }
+    } else if (isspace(data[pos])) {
+      pos++;
+    } else {
+      break;
+    }
+  }
+  if (pos >= size || !isdigit(data[pos])) {
+    return false;
+  }
+  value = 0;
+  while (pos < size && isdigit(data[pos])) {
+    if (value > 100000000) {
+      return false;
+    }
+    value = 10 * value + static_cast<unsigned int>(data[pos] - '0');
+    pos++;
+  }
+  return true;
+}
+
+// Decode a PGM P5 or PPM P6 header and return the position of the pixels
+size_t vp_decodeHeaderPNM(const unsigned char *data, size_t size, unsigned int &w, unsigned int &h, bool &color)
+{
+  vp_checkBuffer(data, size, "PNM");
+  unsigned int maxval = 0;
+  size_t pos = 2;
+  if (size < 2 || data[0] != 'P' || (data[1] != '5' && data[1] != '6') ||
+      !vp_readPNMHeaderValue(data, size, pos, w) || !vp_readPNMHeaderValue(data, size, pos, h) ||
+      !vp_readPNMHeaderValue(data, size, pos, maxval) || pos >= size || !isspace(data[pos])) {
+    throw(vpImageException(vpImageException::ioError, "Cannot decode PNM image: invalid header"));
+  }
+  pos++;
+  if (w > 100000 || h > 100000) {
+    throw(vpException(vpException::badValue, "Bad PNM image size %ux%u", w, h));
+  }
+  if (maxval == 0 || maxval > 255) {
+    throw(vpImageException(vpImageException::ioError, "Bad PNM maxval %u", maxval));
+  }
+  color = (data[1] == '6');
+  size_t nbytes = static_cast<size_t>(w) * h * (color ? 3 : 1);
+  if (size - pos < nbytes) {
+    throw(vpImageException(vpImageException::ioError, "Cannot decode PNM image: only %u of %u bytes",
+                           static_cast<unsigned int>(size - pos), static_cast<unsigned int>(nbytes)));
+  }
+  return pos;
+}
+
+void vp_writePNMHeader(const char *magic, unsigned int width, unsigned int height, size_t dataSize,
+                       std::vector<unsigned char> &buffer)
+{
+  char header[64];
+  int length = sprintf(header, "%s\n%u %u\n255\n", magic, width, height);
+  buffer.resize(static_cast<size_t>(length) + dataSize);
+  memcpy(&buffer[0], header, static_cast<size_t>(length));
+}
+
+#if !defined(VISP_HAVE_JPEG)
+// Reduce the resolution of an image by averaging blocks of scaleDenom x
+// scaleDenom pixels, as done by the DCT scaling of libjpeg.
+void vp_downscale(const unsigned char *src, unsigned int width, unsigned int height, unsigned int nbChannels,
+                  unsigned int scaleDenom, unsigned char *dst)
+{
+  unsigned int scaledWidth = 0, scaledHeight = 0;
+  vpImageCodec::getJPEGScaledSize(width, height, scaleDenom, scaledWidth, scaledHeight);
+  for (unsigned int i = 0; i < scaledHeight; i++) {
+    unsigned int i_end = std::min((i + 1) * scaleDenom, height);
+    for (unsigned int j = 0; j < scaledWidth; j++) {
+      unsigned int j_end = std::min((j + 1) * scaleDenom, width);
+      unsigned int count = (i_end - i * scaleDenom) * (j_end - j * scaleDenom);
+      for (unsigned int c = 0; c < nbChannels; c++) {
+        unsigned int sum = 0;
+        for (unsigned int ii = i * scaleDenom; ii < i_end; ii++) {
+          for (unsigned int jj = j * scaleDenom; jj < j_end; jj++) {
+            sum += src[(ii * width + jj) * nbChannels + c];
+          }
+        }
+        dst[(i * scaledWidth + j) * nbChannels + c] = static_cast<unsigned char>((sum + count / 2) / count);
+      }
+    }
+  }
+}
+#endif
+
+#if !defined(VISP_HAVE_JPEG) || !defined(VISP_HAVE_PNG)
+#if defined(VISP_IMAGE_CODEC_USE_STB)
+void vp_stbWrite(void *context, void *data, int size)
+{
+  std::vector<unsigned char> *buffer = static_cast<std::vector<unsigned char> *>(context);
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  buffer->insert(buffer->end(), bytes, bytes + size);
+}
+#endif
+
+// Decoding with OpenCV or stb_image when libjpeg or libpng is not available
+void vp_fallbackDecode(const unsigned char *data, size_t size, vpImage<unsigned char> *Ig, vpImage<vpRGBa> *Ic)
+{
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+  cv::Mat raw(1, static_cast<int>(size), CV_8UC1, const_cast<unsigned char *>(data));
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+  cv::Mat M = cv::imdecode(raw, Ig != NULL ? cv::IMREAD_GRAYSCALE : cv::IMREAD_COLOR);
+#else
+  cv::Mat M = cv::imdecode(raw, Ig != NULL ? CV_LOAD_IMAGE_GRAYSCALE : CV_LOAD_IMAGE_COLOR);
+#endif
+  if (M.empty()) {
+    throw(vpImageException(vpImageException::ioError, "Cannot decode image"));
+  }
+  if (Ig != NULL) {
+    vpImageConvert::convert(M, *Ig);
+  } else {
+    vpImageConvert::convert(M, *Ic);
+  }
+#elif defined(VISP_IMAGE_CODEC_USE_STB)
+  int width = 0, height = 0, channels = 0;
+  unsigned char *image = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &channels,
+                                               Ig != NULL ? STBI_grey : STBI_rgb_alpha);
+  if (image == NULL) {
+    throw(vpImageException(vpImageException::ioError, "Cannot decode image: %s", stbi_failure_reason()));
+  }
+  if (Ig != NULL) {
+    Ig->init(image, static_cast<unsigned int>(height), static_cast<unsigned int>(width), true);
+  } else {
+    Ic->init(reinterpret_cast<vpRGBa *>(image), static_cast<unsigned int>(height), static_cast<unsigned int>(width),
+             true);
+  }
+  stbi_image_free(image);
+#else
+  (void)data;
+  (void)size;
+  (void)Ig;
+  (void)Ic;
+  throw(vpException(vpException::functionNotImplementedError, "In-memory decoding requires OpenCV 2.4.8 or higher"));
+#endif
+}
+
+// Encoding with OpenCV or stb_image when libjpeg or libpng is not available
+void vp_fallbackEncode(const vpImage<unsigned char> *Ig, const vpImage<vpRGBa> *Ic, bool jpeg, int quality,
+                       int compressionLevel, std::vector<unsigned char> &buffer)
+{
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+  cv::Mat M;
+  if (Ig != NULL) {
+    vpImageConvert::convert(*Ig, M);
+  } else {
+    vpImageConvert::convert(*Ic, M);
+  }
+  std::vector<int> params(2);
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+  params[0] = jpeg ? cv::IMWRITE_JPEG_QUALITY : cv::IMWRITE_PNG_COMPRESSION;
+#else
+  params[0] = jpeg ? CV_IMWRITE_JPEG_QUALITY : CV_IMWRITE_PNG_COMPRESSION;
+#endif
+  params[1] = jpeg ? quality : compressionLevel;
+  if (!cv::imencode(jpeg ? ".jpg" : ".png", M, buffer, params)) {
+    throw(vpImageException(vpImageException::ioError, "Cannot encode image"));
+  }
+#elif defined(VISP_IMAGE_CODEC_USE_STB)
+  (void)compressionLevel;
+  int width = static_cast<int>(Ig != NULL ? Ig->getWidth() : Ic->getWidth());
+  int height = static_cast<int>(Ig != NULL ? Ig->getHeight() : Ic->getHeight());
+  int comp = Ig != NULL ? STBI_grey : STBI_rgb_alpha;
+  const void *bitmap = Ig != NULL ? static_cast<const void *>(Ig->bitmap) : static_cast<const void *>(Ic->bitmap);
+  buffer.clear();
+  int res = jpeg ? stbi_write_jpg_to_func(vp_stbWrite, &buffer, width, height, comp, bitmap, quality)
+                 : stbi_write_png_to_func(vp_stbWrite, &buffer, width, height, comp, bitmap, width * comp);
+  if (res == 0) {
+    throw(vpImageException(vpImageException::ioError, "Cannot encode image"));
+  }
+#else
+  (void)Ig;
+  (void)Ic;
+  (void)jpeg;
+  (void)quality;
+  (void)compressionLevel;
+  (void)buffer;
+  throw(vpException(vpException::functionNotImplementedError, "In-memory encoding requires OpenCV 2.4.8 or higher"));
+#endif
+}
+#endif
+
+#if defined(VISP_HAVE_JPEG)
+// libjpeg calls error_exit() on fatal errors and expects it not to return.
+// The default handler exits the program: jump back to the codec instead.
+struct vpJpegErrorManager {
+  struct jpeg_error_mgr pub;
+  jmp_buf setjmpBuffer;
+  char message[JMSG_LENGTH_MAX];
+};
+
+void vp_jpegErrorExit(j_common_ptr cinfo)
+{
+  vpJpegErrorManager *err = reinterpret_cast<vpJpegErrorManager *>(cinfo->err);
+  (*cinfo->err->format_message)(cinfo, err->message);
+  longjmp(err->setjmpBuffer, 1);
+}
+
+void vp_jpegOutputMessage(j_common_ptr) {}
+
+// Destination manager that appends the compressed data to a std::vector.
+// The vector is grown by doubling its size and shrunk to the data size at
+// the end, so that its capacity is kept for the next image.
+struct vpJpegDestination {
+  struct jpeg_destination_mgr pub;
+  std::vector<unsigned char> *buffer;
+};
+
+void vp_jpegInitDestination(j_compress_ptr cinfo)
+{
+  vpJpegDestination *dest = reinterpret_cast<vpJpegDestination *>(cinfo->dest);
+  dest->buffer->resize(std::max<size_t>(dest->buffer->capacity(), 4096));
+  dest->pub.next_output_byte = &(*dest->buffer)[0];
+  dest->pub.free_in_buffer = dest->buffer->size();
+}
+
+boolean vp_jpegEmptyOutputBuffer(j_compress_ptr cinfo)
+{
+  vpJpegDestination *dest = reinterpret_cast<vpJpegDestination *>(cinfo->dest);
+  size_t used = dest->buffer->size();
+  dest->buffer->resize(2 * used);
+  dest->pub.next_output_byte = &(*dest->buffer)[used];
+  dest->pub.free_in_buffer = used;
+  return TRUE;
+}
+
+void vp_jpegTermDestination(j_compress_ptr cinfo)
+{
+  vpJpegDestination *dest = reinterpret_cast<vpJpegDestination *>(cinfo->dest);
+  dest->buffer->resize(dest->buffer->size() - dest->pub.free_in_buffer);
+}
+
+// Source manager reading from memory. Contrary to the stdio source manager,
+// a truncated stream is an error.
+void vp_jpegInitSource(j_decompress_ptr) {}
+
+boolean vp_jpegFillInputBuffer(j_decompress_ptr cinfo)
+{
+  ERREXIT(cinfo, JERR_INPUT_EOF);
+  return FALSE;
+}
+
+void vp_jpegSkipInputData(j_decompress_ptr cinfo, long num_bytes)
+{
+  if (num_bytes <= 0) {
+    return;
+  }
+  if (static_cast<size_t>(num_bytes) > cinfo->src->bytes_in_buffer) {
+    ERREXIT(cinfo, JERR_INPUT_EOF);
+  }
+  cinfo->src->next_input_byte += num_bytes;
+  cinfo->src->bytes_in_buffer -= static_cast<size_t>(num_bytes);
+}
+
+void vp_jpegTermSource(j_decompress_ptr) {}
+#endif
+
+#if defined(VISP_HAVE_PNG)
+// libpng errors are reported by a long jump to png_jmpbuf() after the
+// message is saved in the error pointer of the png structure.
+void vp_pngError(png_structp png_ptr, png_const_charp message)
+{
+  char *buffer = static_cast<char *>(png_get_error_ptr(png_ptr));
+  strncpy(buffer, message, 255);
+  buffer[255] = '\0';
+  longjmp(png_jmpbuf(png_ptr), 1);
+}
+
+void vp_pngWarning(png_structp, png_const_charp) {}
+
+struct vpPngSource {
+  const unsigned char *data;
+  size_t size;
+  size_t offset;
+};
+
+void vp_pngReadData(png_structp png_ptr, png_bytep data, png_size_t length)
+{
+  vpPngSource *src = static_cast<vpPngSource *>(png_get_io_ptr(png_ptr));
+  if (length > src->size - src->offset) {
+    png_error(png_ptr, "Premature end of PNG data");
+  }
+  memcpy(data, src->data + src->offset, length);
+  src->offset += length;
+}
+
+void vp_pngWriteData(png_structp png_ptr, png_bytep data, png_size_t length)
+{
+  std::vector<unsigned char> *buffer = static_cast<std::vector<unsigned char> *>(png_get_io_ptr(png_ptr));
+  buffer->insert(buffer->end(), data, data + length);
+}
+
+void vp_pngFlushData(png_structp) {}
+#endif
+} // namespace
+
+class vpImageCodec::Impl
+{
+public:
+  Impl()
+#if defined(VISP_HAVE_PNG)
+    : m_pngRows(), m_pngData()
+#endif
+  {
+#if defined(VISP_HAVE_JPEG)
+    m_cinfo.err = jpeg_std_error(&m_cerr.pub);
+    jpeg_create_compress(&m_cinfo);
+    m_cerr.pub.error_exit = vp_jpegErrorExit;
+    m_cerr.pub.output_message = vp_jpegOutputMessage;
+    m_cerr.message[0] = '\0';
+    m_dest.pub.init_destination = vp_jpegInitDestination;
+    m_dest.pub.empty_output_buffer = vp_jpegEmptyOutputBuffer;
+    m_dest.pub.term_destination = vp_jpegTermDestination;
+    m_dest.buffer = NULL;
+    m_cinfo.dest = &m_dest.pub;
+
+    m_dinfo.err = jpeg_std_error(&m_derr.pub);
+    jpeg_create_decompress(&m_dinfo);
+    m_derr.pub.error_exit = vp_jpegErrorExit;
+    m_derr.pub.output_message = vp_jpegOutputMessage;
+    m_derr.message[0] = '\0';
+    m_src.init_source = vp_jpegInitSource;
+    m_src.fill_input_buffer = vp_jpegFillInputBuffer;
+    m_src.skip_input_data = vp_jpegSkipInputData;
+    m_src.resync_to_restart = jpeg_resync_to_restart;
+    m_src.term_source = vp_jpegTermSource;
+    m_src.next_input_byte = NULL;
+    m_src.bytes_in_buffer = 0;
+    m_dinfo.src = &m_src;
+#endif
+#if defined(VISP_HAVE_PNG)
+    m_pngMessage[0] = '\0';
+#endif
+  }
+
+  ~Impl()
+  {
+#if defined(VISP_HAVE_JPEG)
+    jpeg_destroy_compress(&m_cinfo);
+    jpeg_destroy_decompress(&m_dinfo);
+#endif
+  }
+
+#if defined(VISP_HAVE_JPEG)
+  void decodeJPEG(const unsigned char *data, size_t size, unsigned int scaleDenom, vpImage<unsigned char> *Ig,
+                  vpImage<vpRGBa> *Ic)
+  {
+    // Recover from a previous call interrupted by an exception
+    jpeg_abort_decompress(&m_dinfo);
+    if (setjmp(m_derr.setjmpBuffer)) {
+      jpeg_abort_decompress(&m_dinfo);
+      throw(vpImageException(vpImageException::ioError, "Cannot decode JPEG image: %s", m_derr.message));
+    }
+
+    m_src.next_input_byte = data;
+    m_src.bytes_in_buffer = size;
+    jpeg_read_header(&m_dinfo, TRUE);
+
+    m_dinfo.scale_num = 1;
+    m_dinfo.scale_denom = scaleDenom;
+    if (Ig != NULL) {
+      // For color images, libjpeg only keeps the luminance channel
+      m_dinfo.out_color_space = JCS_GRAYSCALE;
+    } else {
+#if defined(JCS_ALPHA_EXTENSIONS)
+      m_dinfo.out_color_space = JCS_EXT_RGBA;
+#else
+      m_dinfo.out_color_space = JCS_RGB;
+#endif
+    }
+    jpeg_start_decompress(&m_dinfo);
+
+    unsigned int width = m_dinfo.output_width;
+    unsigned int height = m_dinfo.output_height;
+    if (Ig != NULL) {
+      if ((width != Ig->getWidth()) || (height != Ig->getHeight())) {
+        Ig->resize(height, width);
+      }
+      while (m_dinfo.output_scanline < m_dinfo.output_height) {
+        JSAMPROW row = (*Ig)[m_dinfo.output_scanline];
+        jpeg_read_scanlines(&m_dinfo, &row, 1);
+      }
+    } else {
+      if ((width != Ic->getWidth()) || (height != Ic->getHeight())) {
+        Ic->resize(height, width);
+      }
+#if defined(JCS_ALPHA_EXTENSIONS)
+      while (m_dinfo.output_scanline < m_dinfo.output_height) {
+        JSAMPROW row = reinterpret_cast<JSAMPROW>((*Ic)[m_dinfo.output_scanline]);
+        jpeg_read_scanlines(&m_dinfo, &row, 1);
+      }
+#else
+      m_jpegRow.resize(3 * width);
+      while (m_dinfo.output_scanline < m_dinfo.output_height) {
+        unsigned char *output = reinterpret_cast<unsigned char *>((*Ic)[m_dinfo.output_scanline]);
+        JSAMPROW row = &m_jpegRow[0];
+        jpeg_read_scanlines(&m_dinfo, &row, 1);
+        vpImageConvert::RGBToRGBa(row, output, width);
+      }
+#endif
+    }
+
+    jpeg_finish_decompress(&m_dinfo);
+  }
+
+  void encodeJPEG(const unsigned char *bitmap, unsigned int width, unsigned int height, bool color, int quality,
+                  std::vector<unsigned char> &buffer)
+  {
+    jpeg_abort_compress(&m_cinfo);
+    if (setjmp(m_cerr.setjmpBuffer)) {
+      jpeg_abort_compress(&m_cinfo);
+      buffer.clear();
+      throw(vpImageException(vpImageException::ioError, "Cannot encode JPEG image: %s", m_cerr.message));
+    }
+
+    m_dest.buffer = &buffer;
+    m_cinfo.image_width = width;
+    m_cinfo.image_height = height;
+    if (color) {
+#if defined(JCS_EXTENSIONS)
+      m_cinfo.input_components = 4;
+      m_cinfo.in_color_space = JCS_EXT_RGBX;
+#else
+      m_cinfo.input_components = 3;
+      m_cinfo.in_color_space = JCS_RGB;
+#endif
+    } else {
+      m_cinfo.input_components = 1;
+      m_cinfo.in_color_space = JCS_GRAYSCALE;
+    }
+    jpeg_set_defaults(&m_cinfo);
+    jpeg_set_quality(&m_cinfo, quality, TRUE);
+    jpeg_start_compress(&m_cinfo, TRUE);
+
+    unsigned int rowbytes = width * static_cast<unsigned int>(color ? sizeof(vpRGBa) : 1);
+#if !defined(JCS_EXTENSIONS)
+    if (color) {
+      m_jpegRow.resize(3 * width);
+    }
+#endif
+    while (m_cinfo.next_scanline < m_cinfo.image_height) {
+      JSAMPROW row = const_cast<JSAMPROW>(bitmap + m_cinfo.next_scanline * rowbytes);
+#if !defined(JCS_EXTENSIONS)
+      if (color) {
+        vpImageConvert::RGBaToRGB(row, &m_jpegRow[0], width);
+        row = &m_jpegRow[0];
+      }
+#endif
+      jpeg_write_scanlines(&m_cinfo, &row, 1);
+    }
+
+    jpeg_finish_compress(&m_cinfo);
+  }
+#endif
+
+#if defined(VISP_HAVE_PNG)
+  void decodePNG(const unsigned char *data, size_t size, vpImage<unsigned char> *Ig, vpImage<vpRGBa> *Ic)
+  {
+    if (size < 8 || png_sig_cmp(const_cast<png_bytep>(data), 0, 8)) {
+      throw(vpImageException(vpImageException::ioError, "Cannot decode PNG image: invalid signature"));
+    }
+
+    png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, m_pngMessage, vp_pngError, vp_pngWarning);
+    if (png_ptr == NULL) {
+      throw(vpImageException(vpImageException::ioError, "Cannot create PNG read structure"));
+    }
+    png_infop info_ptr = png_create_info_struct(png_ptr);
+    if (info_ptr == NULL) {
+      png_destroy_read_struct(&png_ptr, NULL, NULL);
+      throw(vpImageException(vpImageException::ioError, "Cannot create PNG info structure"));
+    }
+    vpPngSource src;
+    src.data = data;
+    src.size = size;
+    src.offset = 0;
+
+    if (setjmp(png_jmpbuf(png_ptr))) {
+      png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
+      throw(vpImageException(vpImageException::ioError, "Cannot decode PNG image: %s", m_pngMessage));
+    }
+
+    png_set_read_fn(png_ptr, &src, vp_pngReadData);
+    png_read_info(png_ptr, info_ptr);
+
+    unsigned int width = png_get_image_width(png_ptr, info_ptr);
+    unsigned int height = png_get_image_height(png_ptr, info_ptr);
+    int bit_depth = png_get_bit_depth(png_ptr, info_ptr);
+    int color_type = png_get_color_type(png_ptr, info_ptr);
+
+    // Transformations to get 8 bits gray or RGBA pixels
+    if (color_type == PNG_COLOR_TYPE_PALETTE)
+      png_set_palette_to_rgb(png_ptr);
+    if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8)
+      png_set_expand(png_ptr);
+    if (bit_depth == 16)
+      png_set_strip_16(png_ptr);
+    if (Ig != NULL) {
+      if (color_type & PNG_COLOR_MASK_ALPHA)
+        png_set_strip_alpha(png_ptr);
+    } else {
+      if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
+        png_set_gray_to_rgb(png_ptr);
+      if (!(color_type & PNG_COLOR_MASK_ALPHA))
+        png_set_filler(png_ptr, vpRGBa::alpha_default, PNG_FILLER_AFTER);
+    }
+    png_set_interlace_handling(png_ptr);
+    png_read_update_info(png_ptr, info_ptr);
+
+    unsigned int channels = png_get_channels(png_ptr, info_ptr);
+    unsigned char *bitmap = NULL;
+    if (Ig != NULL) {
+      if ((width != Ig->getWidth()) || (height != Ig->getHeight())) {
+        Ig->resize(height, width);
+      }
+      bitmap = Ig->bitmap;
+    } else {
+      if ((width != Ic->getWidth()) || (height != Ic->getHeight())) {
+        Ic->resize(height, width);
+      }
+      bitmap = reinterpret_cast<unsigned char *>(Ic->bitmap);
+    }
+
+    // Rows are decoded in place, except color rows of a gray level image
+    bool inPlace = (Ig != NULL) ? (channels == 1) : (channels == 4);
+    size_t rowbytes = png_get_rowbytes(png_ptr, info_ptr);
+    if (!inPlace) {
+      m_pngData.resize(rowbytes * height);
+    }
+    m_pngRows.resize(height);
+    for (unsigned int i = 0; i < height; i++) {
+      m_pngRows[i] = inPlace ? bitmap + i * rowbytes : &m_pngData[i * rowbytes];
+    }
+    png_read_image(png_ptr, &m_pngRows[0]);
+    png_read_end(png_ptr, NULL);
+
+    if (!inPlace) {
+      vpImageConvert::RGBToGrey(&m_pngData[0], bitmap, width * height);
+    }
+
+    png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
+  }
+
+  void encodePNG(const unsigned char *bitmap, unsigned int width, unsigned int height, bool color,
+                 int compressionLevel, std::vector<unsigned char> &buffer)
+  {
+    png_structp png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, m_pngMessage, vp_pngError, vp_pngWarning);
+    if (png_ptr == NULL) {
+      throw(vpImageException(vpImageException::ioError, "Cannot create PNG write structure"));
+    }
+    png_infop info_ptr = png_create_info_struct(png_ptr);
+    if (info_ptr == NULL) {
+      png_destroy_write_struct(&png_ptr, NULL);
+      throw(vpImageException(vpImageException::ioError, "Cannot create PNG info structure"));
+    }
+
+    if (setjmp(png_jmpbuf(png_ptr))) {
+      png_destroy_write_struct(&png_ptr, &info_ptr);
+      buffer.clear();
+      throw(vpImageException(vpImageException::ioError, "Cannot encode PNG image: %s", m_pngMessage));
+    }
+
+    buffer.clear();
+    png_set_write_fn(png_ptr, &buffer, vp_pngWriteData, vp_pngFlushData);
+    png_set_compression_level(png_ptr, compressionLevel);
+    png_set_IHDR(png_ptr, info_ptr, width, height, 8, color ? PNG_COLOR_TYPE_RGB : PNG_COLOR_TYPE_GRAY,
+                 PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+    png_write_info(png_ptr, info_ptr);
+    if (color) {
+      // Drop the alpha channel of vpRGBa pixels
+      png_set_filler(png_ptr, 0, PNG_FILLER_AFTER);
+    }
+
+    size_t rowbytes = width * (color ? sizeof(vpRGBa) : 1);
+    m_pngRows.resize(height);
+    for (unsigned int i = 0; i < height; i++) {
+      m_pngRows[i] = const_cast<png_bytep>(bitmap + i * rowbytes);
+    }
+    png_write_image(png_ptr, &m_pngRows[0]);
+    png_write_end(png_ptr, NULL);
+
+    png_destroy_write_struct(&png_ptr, &info_ptr);
+  }
+#endif
+
+private:
+#if defined(VISP_HAVE_JPEG)
+  struct jpeg_compress_struct m_cinfo;
+  struct jpeg_decompress_struct m_dinfo;
+  vpJpegErrorManager m_cerr;
+  vpJpegErrorManager m_derr;
+  vpJpegDestination m_dest;
+  struct jpeg_source_mgr m_src;
+  std::vector<unsigned char> m_jpegRow;
+#endif
+#if defined(VISP_HAVE_PNG)
+  std::vector<png_bytep> m_pngRows;
+  std::vector<unsigned char> m_pngData;
+  char m_pngMessage[256];
+#endif
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor. The JPEG quality is set to 75 and the PNG compression
+  level to 6, the default values of libjpeg and zlib that are also used by
+  vpImageIo::writeJPEG() and vpImageIo::writePNG().
+*/
+vpImageCodec::vpImageCodec() : m_impl(new Impl()), m_jpegQuality(75), m_pngCompressionLevel(6) {}
+
+/*!
+  Destructor that releases the codec contexts.
+*/
+vpImageCodec::~vpImageCodec() { delete m_impl; }
+
+/*!
+  Decode an image whose format (JPEG, PNG, PGM P5 or PPM P6) is deduced from
+  the first bytes of the buffer. A color image is converted into a gray level
+  image.
+
+  \param I : Decoded image. Memory is allocated only if the size changes.
+  \param data : Encoded image.
+  \param size : Size in bytes of \e data.
+
+  \exception vpImageException::ioError : If the format is not recognized or
+  the data is corrupted.
+*/
+void vpImageCodec::decode(vpImage<unsigned char> &I, const unsigned char *data, size_t size)
+{
+  vp_checkBuffer(data, size, "the");
+  if (size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF) {
+    decodeJPEG(I, data, size);
+  } else if (size >= 4 && data[0] == 0x89 && data[1] == 'P' && data[2] == 'N' && data[3] == 'G') {
+    decodePNG(I, data, size);
+  } else if (size >= 2 && data[0] == 'P' && (data[1] == '5' || data[1] == '6')) {
+    decodePNM(I, data, size);
+  } else {
+    throw(vpImageException(vpImageException::ioError, "Cannot decode image: unknown format"));
+  }
+}
+
+/*!
+  Decode an image whose format (JPEG, PNG, PGM P5 or PPM P6) is deduced from
+  the first bytes of the buffer. A gray level image is converted into a color
+  image.
+
+  \param I : Decoded image. Memory is allocated only if the size changes.
+  \param data : Encoded image.
+  \param size : Size in bytes of \e data.
+
+  \exception vpImageException::ioError : If the format is not recognized or
+  the data is corrupted.
+*/
+void vpImageCodec::decode(vpImage<vpRGBa> &I, const unsigned char *data, size_t size)
+{
+  vp_checkBuffer(data, size, "the");
+  if (size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF) {
+    decodeJPEG(I, data, size);
+  } else if (size >= 4 && data[0] == 0x89 && data[1] == 'P' && data[2] == 'N' && data[3] == 'G') {
+    decodePNG(I, data, size);
+  } else if (size >= 2 && data[0] == 'P' && (data[1] == '5' || data[1] == '6')) {
+    decodePNM(I, data, size);
+  } else {
+    throw(vpImageException(vpImageException::ioError, "Cannot decode image: unknown format"));
+  }
+}
+
+/*!
+  Decode a JPEG image, optionally at a reduced resolution. A color image is
+  converted into a gray level image by keeping its luminance.
+
+  \param I : Decoded image. Memory is allocated only if the size changes.
+  \param data : JPEG data.
+  \param size : Size in bytes of \e data.
+  \param scaleDenom : Resolution reduction factor: 1, 2, 4 or 8. The size of
+  the decoded image is given by getJPEGScaledSize().
+
+  \exception vpImageException::ioError : If the data is not a valid JPEG
+  image.
+  \exception vpException::badValue : If \e scaleDenom is not 1, 2, 4 or 8.
+*/
+void vpImageCodec::decodeJPEG(vpImage<unsigned char> &I, const unsigned char *data, size_t size,
+                              unsigned int scaleDenom)
+{
+  vp_checkBuffer(data, size, "JPEG");
+  vp_checkScaleDenom(scaleDenom);
+#if defined(VISP_HAVE_JPEG)
+  m_impl->decodeJPEG(data, size, scaleDenom, &I, NULL);
+#else
+  if (scaleDenom == 1) {
+    vp_fallbackDecode(data, size, &I, NULL);
+  } else {
+    vpImage<unsigned char> Ifull;
+    vp_fallbackDecode(data, size, &Ifull, NULL);
+    unsigned int width = 0, height = 0;
+    getJPEGScaledSize(Ifull.getWidth(), Ifull.getHeight(), scaleDenom, width, height);
+    if ((width != I.getWidth()) || (height != I.getHeight())) {
+      I.resize(height, width);
+    }
+    vp_downscale(Ifull.bitmap, Ifull.getWidth(), Ifull.getHeight(), 1, scaleDenom, I.bitmap);
+  }
+#endif
+}
+
+/*!
+  Decode a JPEG image, optionally at a reduced resolution. A gray level image
+  is converted into a color image.
+
+  \param I : Decoded image. Memory is allocated only if the size changes.
+  \param data : JPEG data.
+  \param size : Size in bytes of \e data.
+  \param scaleDenom : Resolution reduction factor: 1, 2, 4 or 8. The size of
+  the decoded image is given by getJPEGScaledSize().
+
+  \exception vpImageException::ioError : If the data is not a valid JPEG
+  image.
+  \exception vpException::badValue : If \e scaleDenom is not 1, 2, 4 or 8.
+*/
+void vpImageCodec::decodeJPEG(vpImage<vpRGBa> &I, const unsigned char *data, size_t size, unsigned int scaleDenom)
+{
+  vp_checkBuffer(data, size, "JPEG");
+  vp_checkScaleDenom(scaleDenom);
+#if defined(VISP_HAVE_JPEG)
+  m_impl->decodeJPEG(data, size, scaleDenom, NULL, &I);
+#else
+  if (scaleDenom == 1) {
+    vp_fallbackDecode(data, size, NULL, &I);
+  } else {
+    vpImage<vpRGBa> Ifull;
+    vp_fallbackDecode(data, size, NULL, &Ifull);
+    unsigned int width = 0, height = 0;
+    getJPEGScaledSize(Ifull.getWidth(), Ifull.getHeight(), scaleDenom, width, height);
+    if ((width != I.getWidth()) || (height != I.getHeight())) {
+      I.resize(height, width);
+    }
+    vp_downscale(reinterpret_cast<unsigned char *>(Ifull.bitmap), Ifull.getWidth(), Ifull.getHeight(), 4,
+                 scaleDenom, reinterpret_cast<unsigned char *>(I.bitmap));
+  }
+#endif
+}
+
+/*!
+  Decode a PNG image. A color image is converted into a gray level image with
+  the \f$0,299 r + 0,587 g + 0,114 b\f$ formula.
+
+  \param I : Decoded image. Memory is allocated only if the size changes.
+  \param data : PNG data.
+  \param size : Size in bytes of \e data.
+
+  \exception vpImageException::ioError : If the data is not a valid PNG image.
+*/
+void vpImageCodec::decodePNG(vpImage<unsigned char> &I, const unsigned char *data, size_t size)
+{
+  vp_checkBuffer(data, size, "PNG");
+#if defined(VISP_HAVE_PNG)
+  m_impl->decodePNG(data, size, &I, NULL);
+#else
+  vp_fallbackDecode(data, size, &I, NULL);
+#endif
+}
+
+/*!
+  Decode a PNG image. A gray level image is converted into a color image.
+
+  \param I : Decoded image. Memory is allocated only if the size changes.
+  \param data : PNG data.
+  \param size : Size in bytes of \e data.
+
+  \exception vpImageException::ioError : If the data is not a valid PNG image.
+*/
+void vpImageCodec::decodePNG(vpImage<vpRGBa> &I, const unsigned char *data, size_t size)
+{
+  vp_checkBuffer(data, size, "PNG");
+#if defined(VISP_HAVE_PNG)
+  m_impl->decodePNG(data, size, NULL, &I);
+#else
+  vp_fallbackDecode(data, size, NULL, &I);
+#endif
+}
+
+/*!
+  Decode a PGM P5 or PPM P6 image with a maximum value lower or equal to 255.
+  A PPM image is converted into a gray level image with the \f$0,299 r +
+  0,587 g + 0,114 b\f$ formula.
+
+  \param I : Decoded image. Memory is allocated only if the size changes.
+  \param data : PGM or PPM data.
+  \param size : Size in bytes of \e data.
+
+  \exception vpImageException::ioError : If the data is not a valid PGM P5 or
+  PPM P6 image.
+*/
+void vpImageCodec::decodePNM(vpImage<unsigned char> &I, const unsigned char *data, size_t size)
+{
+  unsigned int w = 0, h = 0;
+  bool color = false;
+  size_t pos = vp_decodeHeaderPNM(data, size, w, h, color);
+
+  if ((h != I.getHeight()) || (w != I.getWidth())) {
+    I.resize(h, w);
+  }
+  if (color) {
+    vpImageConvert::RGBToGrey(const_cast<unsigned char *>(data + pos), I.bitmap, w * h);
+  } else if (w * h > 0) {
+    memcpy(I.bitmap, data + pos, w * h);
+  }
+}
+
+/*!
+  Decode a PGM P5 or PPM P6 image with a maximum value lower or equal to 255.
+  A PGM image is converted into a color image.
+
+  \param I : Decoded image. Memory is allocated only if the size changes.
+  \param data : PGM or PPM data.
+  \param size : Size in bytes of \e data.
+
+  \exception vpImageException::ioError : If the data is not a valid PGM P5 or
+  PPM P6 image.
+*/
+void vpImageCodec::decodePNM(vpImage<vpRGBa> &I, const unsigned char *data, size_t size)
+{
+  unsigned int w = 0, h = 0;
+  bool color = false;
+  size_t pos = vp_decodeHeaderPNM(data, size, w, h, color);
+
+  if ((h != I.getHeight()) || (w != I.getWidth())) {
+    I.resize(h, w);
+  }
+  unsigned char *output = reinterpret_cast<unsigned char *>(I.bitmap);
+  if (color) {
+    vpImageConvert::RGBToRGBa(const_cast<unsigned char *>(data + pos), output, w * h);
+  } else {
+    vpImageConvert::GreyToRGBa(const_cast<unsigned char *>(data + pos), output, w * h);
+  }
+}
+
+/*!
+  Encode a gray level image in JPEG with the quality set by setJPEGQuality().
+
+  \param I : Image to encode.
+  \param buffer : JPEG data. Its capacity is kept from one call to the next.
+*/
+void vpImageCodec::encodeJPEG(const vpImage<unsigned char> &I, std::vector<unsigned char> &buffer)
+{
+#if defined(VISP_HAVE_JPEG)
+  m_impl->encodeJPEG(I.bitmap, I.getWidth(), I.getHeight(), false, m_jpegQuality, buffer);
+#else
+  vp_fallbackEncode(&I, NULL, true, m_jpegQuality, m_pngCompressionLevel, buffer);
+#endif
+}
+
+/*!
+  Encode a color image in JPEG with the quality set by setJPEGQuality(). The
+  alpha channel is ignored.
+
+  \param I : Image to encode.
+  \param buffer : JPEG data. Its capacity is kept from one call to the next.
+*/
+void vpImageCodec::encodeJPEG(const vpImage<vpRGBa> &I, std::vector<unsigned char> &buffer)
+{
+#if defined(VISP_HAVE_JPEG)
+  m_impl->encodeJPEG(reinterpret_cast<const unsigned char *>(I.bitmap), I.getWidth(), I.getHeight(), true,
+                     m_jpegQuality, buffer);
+#else
+  vp_fallbackEncode(NULL, &I, true, m_jpegQuality, m_pngCompressionLevel, buffer);
+#endif
+}
+
+/*!
+  Encode a gray level image in PGM P5.
+
+  \param I : Image to encode.
+  \param buffer : PGM data, identical to the content of the file written by
+  vpImageIo::writePGM().
+*/
+void vpImageCodec::encodePGM(const vpImage<unsigned char> &I, std::vector<unsigned char> &buffer)
+{
+  size_t nbytes = I.getSize();
+  vp_writePNMHeader("P5", I.getWidth(), I.getHeight(), nbytes, buffer);
+  if (nbytes > 0) {
+    memcpy(&buffer[buffer.size() - nbytes], I.bitmap, nbytes);
+  }
+}
+
+/*!
+  Encode a color image in PGM P5 after its conversion into a gray level image.
+
+  \param I : Image to encode.
+  \param buffer : PGM data.
+*/
+void vpImageCodec::encodePGM(const vpImage<vpRGBa> &I, std::vector<unsigned char> &buffer)
+{
+  size_t nbytes = I.getSize();
+  vp_writePNMHeader("P5", I.getWidth(), I.getHeight(), nbytes, buffer);
+  if (nbytes > 0) {
+    vpImageConvert::RGBaToGrey(reinterpret_cast<unsigned char *>(I.bitmap), &buffer[buffer.size() - nbytes],
+                               I.getSize());
+  }
+}
+
+/*!
+  Encode a gray level image in PNG with the compression level set by
+  setPNGCompressionLevel().
+
+  \param I : Image to encode.
+  \param buffer : PNG data.
+*/
+void vpImageCodec::encodePNG(const vpImage<unsigned char> &I, std::vector<unsigned char> &buffer)
+{
+#if defined(VISP_HAVE_PNG)
+  m_impl->encodePNG(I.bitmap, I.getWidth(), I.getHeight(), false, m_pngCompressionLevel, buffer);
+#else
+  vp_fallbackEncode(&I, NULL, false, m_jpegQuality, m_pngCompressionLevel, buffer);
+#endif
+}
+
+/*!
+  Encode a color image in PNG with the compression level set by
+  setPNGCompressionLevel(). The alpha channel is ignored.
+
+  \param I : Image to encode.
+  \param buffer : PNG data.
+*/
+void vpImageCodec::encodePNG(const vpImage<vpRGBa> &I, std::vector<unsigned char> &buffer)
+{
+#if defined(VISP_HAVE_PNG)
+  m_impl->encodePNG(reinterpret_cast<const unsigned char *>(I.bitmap), I.getWidth(), I.getHeight(), true,
+                    m_pngCompressionLevel, buffer);
+#else
+  vp_fallbackEncode(NULL, &I, false, m_jpegQuality, m_pngCompressionLevel, buffer);
+#endif
+}
+
+/*!
+  Encode a gray level image in PPM P6 after its conversion into a color
+  image.
+
+  \param I : Image to encode.
+  \param buffer : PPM data.
+*/
+void vpImageCodec::encodePPM(const vpImage<unsigned char> &I, std::vector<unsigned char> &buffer)
+{
+  size_t nbytes = 3 * static_cast<size_t>(I.getSize());
+  vp_writePNMHeader("P6", I.getWidth(), I.getHeight(), nbytes, buffer);
+  unsigned char *output = &buffer[0] + (buffer.size() - nbytes);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    output[3 * i] = output[3 * i + 1] = output[3 * i + 2] = I.bitmap[i];
+  }
+}
+
+/*!
+  Encode a color image in PPM P6. The alpha channel is ignored.
+
+  \param I : Image to encode.
+  \param buffer : PPM data, identical to the content of the file written by
+  vpImageIo::writePPM().
+*/
+void vpImageCodec::encodePPM(const vpImage<vpRGBa> &I, std::vector<unsigned char> &buffer)
+{
+  size_t nbytes = 3 * static_cast<size_t>(I.getSize());
+  vp_writePNMHeader("P6", I.getWidth(), I.getHeight(), nbytes, buffer);
+  if (nbytes > 0) {
+    vpImageConvert::RGBaToRGB(reinterpret_cast<unsigned char *>(I.bitmap), &buffer[buffer.size() - nbytes],
+                              I.getSize());
+  }
+}
+
+/*!
+  Compute the size of a JPEG image decoded by decodeJPEG() with a resolution
+  reduction factor.
+
+  \param width, height : Size of the JPEG image.
+  \param scaleDenom : Resolution reduction factor: 1, 2, 4 or 8.
+  \param scaledWidth, scaledHeight : Size of the decoded image, rounded up.
+*/
+void vpImageCodec::getJPEGScaledSize(unsigned int width, unsigned int height, unsigned int scaleDenom,
+                                     unsigned int &scaledWidth, unsigned int &scaledHeight)
+{
+  vp_checkScaleDenom(scaleDenom);
+  scaledWidth = (width + scaleDenom - 1) / scaleDenom;
+  scaledHeight = (height + scaleDenom - 1) / scaleDenom;
+}
+
+/*!
+  Set the quality factor used by encodeJPEG().
+
+  \param quality : Quality in [0, 100]. The default value is 75.
+*/
+void vpImageCodec::setJPEGQuality(int quality)
+{
+  if (quality < 0 || quality > 100) {
+    throw(vpException(vpException::badValue, "JPEG quality %d is not in [0, 100]", quality));
+  }
+  m_jpegQuality = quality;
+}
+
+/*!
+  Set the zlib compression level used by encodePNG().
+
+  \param level : Compression level in [0, 9], 0 being no compression and 9 the
+  best compression. The default value is 6.
+*/
+void vpImageCodec::setPNGCompressionLevel(int level)
+{
+  if (level < 0 || level > 9) {
+    throw(vpException(vpException::badValue, "PNG compression level %d is not in [0, 9]", level));
+  }
+  m_pngCompressionLevel = level;
+}
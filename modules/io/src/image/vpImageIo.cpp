@@ -43,7 +43,9 @@
 
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageConvert.h> //image  conversion
+#include <visp3/core/vpImageTools.h>
 #include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpImageCodec.h>
 #include <visp3/io/vpImageIo.h>
 
 #if defined(_WIN32)
@@ -217,7 +219,10 @@ std::string vpImageIo::getExtension(const std::string &filename)
 {
   // extract the extension
   size_t dot = filename.find_last_of(".");
-  std::string ext = filename.substr(dot, filename.size() - 1);
+  if (dot == std::string::npos) {
+    return std::string();
+  }
+  std::string ext = filename.substr(dot);
   return ext;
 }
 
@@ -586,6 +591,147 @@ void vpImageIo::write(const vpImage<vpRGBa> &I, const std::string &filename)
   }
 }
 
+/*!
+  Write a region of interest or a padded image in the file which name is
+  given by \e filename. The pixels are copied only when the rows of the view
+  are not contiguous.
+
+  \param I : View to write.
+  \param filename : Name of the file containing the image. The supported
+  formats are the ones of write(const vpImage<unsigned char> &, const std::string &).
+ */
+void vpImageIo::write(const vpImageView<const unsigned char> &I, const std::string &filename)
+{
+  if (I.isContiguous() && I.getSize() > 0) {
+    const vpImage<unsigned char> I_wrap(const_cast<unsigned char *>(I.getData()), I.getHeight(), I.getWidth(), false);
+    write(I_wrap, filename);
+  } else {
+    vpImage<unsigned char> I_crop;
+    vpImageTools::crop(I, I_crop);
+    write(I_crop, filename);
+  }
+}
+
+/*!
+  Write a region of interest or a padded color image in the file which name
+  is given by \e filename. The pixels are copied only when the rows of the
+  view are not contiguous.
+
+  \param I : View to write.
+  \param filename : Name of the file containing the image. The supported
+  formats are the ones of write(const vpImage<vpRGBa> &, const std::string &).
+ */
+void vpImageIo::write(const vpImageView<const vpRGBa> &I, const std::string &filename)
+{
+  if (I.isContiguous() && I.getSize() > 0) {
+    const vpImage<vpRGBa> I_wrap(const_cast<vpRGBa *>(I.getData()), I.getHeight(), I.getWidth(), false);
+    write(I_wrap, filename);
+  } else {
+    vpImage<vpRGBa> I_crop;
+    vpImageTools::crop(I, I_crop);
+    write(I_crop, filename);
+  }
+}
+
+/*!
+  Decode an image stored in memory, for example received from the network.
+  The format is deduced from the first bytes of the buffer. Supported formats
+  are JPEG, PNG, PGM P5 and PPM P6. A color image is converted into a gray
+  level image.
+
+  This function uses a temporary vpImageCodec. When a stream of images has to
+  be decoded, use a vpImageCodec instance instead to keep the codec contexts
+  from one image to the next.
+
+  \param I : Decoded image. Memory is allocated only if the size changes.
+  \param data : Encoded image.
+  \param size : Size in bytes of \e data.
+ */
+void vpImageIo::decode(vpImage<unsigned char> &I, const unsigned char *data, size_t size)
+{
+  vpImageCodec codec;
+  codec.decode(I, data, size);
+}
+
+/*!
+  Decode a color image stored in memory, for example received from the
+  network. The format is deduced from the first bytes of the buffer.
+  Supported formats are JPEG, PNG, PGM P5 and PPM P6.
+
+  This function uses a temporary vpImageCodec. When a stream of images has to
+  be decoded, use a vpImageCodec instance instead to keep the codec contexts
+  from one image to the next.
+
+  \param I : Decoded image. Memory is allocated only if the size changes.
+  \param data : Encoded image.
+  \param size : Size in bytes of \e data.
+ */
+void vpImageIo::decode(vpImage<vpRGBa> &I, const unsigned char *data, size_t size)
+{
+  vpImageCodec codec;
+  codec.decode(I, data, size);
+}
+
+/*!
+  Encode an image in memory, for example to send it over the network.
+
+  \param I : Image to encode.
+  \param format : Image format given as an extension or a file name, for
+  example "jpg", ".png" or "image.pgm". Supported formats are JPEG, PNG, PGM
+  and PPM.
+  \param buffer : Encoded image.
+ */
+void vpImageIo::encode(const vpImage<unsigned char> &I, const std::string &format, std::vector<unsigned char> &buffer)
+{
+  vpImageCodec codec;
+  switch (getFormat(format.find('.') == std::string::npos ? "." + format : format)) {
+  case FORMAT_PGM:
+    codec.encodePGM(I, buffer);
+    break;
+  case FORMAT_PPM:
+    codec.encodePPM(I, buffer);
+    break;
+  case FORMAT_JPEG:
+    codec.encodeJPEG(I, buffer);
+    break;
+  case FORMAT_PNG:
+    codec.encodePNG(I, buffer);
+    break;
+  default:
+    throw(vpImageException(vpImageException::ioError, "Cannot encode image in \"%s\" format", format.c_str()));
+  }
+}
+
+/*!
+  Encode a color image in memory, for example to send it over the network.
+
+  \param I : Image to encode.
+  \param format : Image format given as an extension or a file name, for
+  example "jpg", ".png" or "image.ppm". Supported formats are JPEG, PNG, PGM
+  and PPM.
+  \param buffer : Encoded image.
+ */
+void vpImageIo::encode(const vpImage<vpRGBa> &I, const std::string &format, std::vector<unsigned char> &buffer)
+{
+  vpImageCodec codec;
+  switch (getFormat(format.find('.') == std::string::npos ? "." + format : format)) {
+  case FORMAT_PGM:
+    codec.encodePGM(I, buffer);
+    break;
+  case FORMAT_PPM:
+    codec.encodePPM(I, buffer);
+    break;
+  case FORMAT_JPEG:
+    codec.encodeJPEG(I, buffer);
+    break;
+  case FORMAT_PNG:
+    codec.encodePNG(I, buffer);
+    break;
+  default:
+    throw(vpImageException(vpImageException::ioError, "Cannot encode image in \"%s\" format", format.c_str()));
+  }
+}
+
 //--------------------------------------------------------------------------
 // PFM
 //--------------------------------------------------------------------------
@@ -0,0 +1,549 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Asynchronous image acquisition from a frame grabber.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpAsyncFrameGrabber.cpp
+  \brief Asynchronous image acquisition from a frame grabber.
+*/
+
+#include <visp3/io/vpAsyncFrameGrabber.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpTime.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Copy an image in a recycled buffer, the memory being reallocated only when the size changes
+template <class Type> void copyImage(const vpImage<Type> &src, vpImage<Type> &dst)
+{
+  if (dst.getHeight() != src.getHeight() || dst.getWidth() != src.getWidth()) {
+    dst.resize(src.getHeight(), src.getWidth());
+  }
+  if (src.getSize() > 0) {
+    memcpy(static_cast<void *>(dst.bitmap), static_cast<const void *>(src.bitmap), src.getSize() * sizeof(Type));
+  }
+}
+}
+
+class vpAsyncFrameGrabber::Impl
+{
+public:
+  Impl()
+    : m_grabber(NULL), m_mode(LATEST_FRAME), m_bufferSize(3), m_color(false), m_isOpen(false), m_stop(false),
+      m_capturing(false), m_frames(), m_free(), m_ready(), m_thread(), m_mutex(), m_frameCaptured(),
+      m_frameReleased(), m_nbCaptured(0), m_nbDropped(0), m_error()
+  {
+  }
+
+  ~Impl()
+  {
+    try {
+      close();
+    } catch (...) {
+    }
+  }
+
+  template <class Type> void acquire(vpImage<Type> &I, double &timestamp)
+  {
+    size_t index = 0;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (!m_isOpen) {
+        throw(vpException(vpException::notInitialized, "The asynchronous frame grabber has to be open first"));
+      }
+      m_frameCaptured.wait(lock, [this] { return !m_ready.empty() || !m_capturing; });
+      if (m_ready.empty()) {
+        throw(vpException(vpException::ioError, "Cannot acquire an image: %s", m_error.c_str()));
+      }
+
+      if (m_mode == LATEST_FRAME) {
+        while (m_ready.size() > 1) {
+          m_free.push_back(m_ready.front());
+          m_ready.pop_front();
+          m_nbDropped++;
+        }
+      }
+      index = m_ready.front();
+      m_ready.pop_front();
+    }
+
+    // The buffer is owned by the caller until it is released
+    const vpFrame &frame = m_frames[index];
+    getImage(frame, I);
+    timestamp = frame.timestamp;
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_free.push_back(index);
+    }
+    m_frameReleased.notify_one();
+  }
+
+  void close()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_isOpen) {
+        return;
+      }
+      m_stop = true;
+    }
+    m_frameReleased.notify_all();
+
+    // Wait until the wrapped acquire() returns
+    if (m_thread.joinable()) {
+      m_thread.join();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_isOpen = false;
+      m_ready.clear();
+    }
+    m_grabber->close();
+  }
+
+  unsigned int getBufferSize() const { return m_bufferSize; }
+
+  vpDeliveryMode getDeliveryMode() const { return m_mode; }
+
+  vpFrameGrabber *getFrameGrabber() const { return m_grabber; }
+
+  unsigned int getNbFramesAvailable() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<unsigned int>(m_ready.size());
+  }
+
+  unsigned int getNbFramesCaptured() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_nbCaptured;
+  }
+
+  unsigned int getNbFramesDropped() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_nbDropped;
+  }
+
+  bool isCapturing() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capturing;
+  }
+
+  bool isOpen() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isOpen;
+  }
+
+  template <class Type> void open(vpImage<Type> &I)
+  {
+    if (m_grabber == NULL) {
+      throw(vpException(vpException::notInitialized, "No frame grabber to acquire the images from"));
+    }
+    if (isOpen()) {
+      throw(vpException(vpException::fatalError, "The asynchronous frame grabber is already open"));
+    }
+    m_grabber->open(I);
+
+    // Allocate the buffers with the size of the first image
+    m_frames.clear();
+    m_frames.resize(m_bufferSize);
+    m_free.clear();
+    for (unsigned int i = 0; i < m_bufferSize; i++) {
+      setSize(I, m_frames[i]);
+      m_free.push_back(m_bufferSize - 1 - i);
+    }
+    m_ready.clear();
+    m_color = isColor(I);
+    m_nbCaptured = m_nbDropped = 0;
+    m_error.clear();
+    m_stop = false;
+    m_capturing = true;
+    m_isOpen = true;
+
+    m_thread = std::thread(&Impl::capture, this);
+  }
+
+  void setBufferSize(unsigned int bufferSize)
+  {
+    checkClosed();
+    m_bufferSize = std::max(1u, bufferSize);
+  }
+
+  void setDeliveryMode(vpDeliveryMode mode)
+  {
+    checkClosed();
+    m_mode = mode;
+  }
+
+  void setFrameGrabber(vpFrameGrabber *grabber)
+  {
+    checkClosed();
+    m_grabber = grabber;
+  }
+
+private:
+  struct vpFrame {
+    vpFrame() : I(), Ic(), timestamp(0) {}
+
+    vpImage<unsigned char> I;
+    vpImage<vpRGBa> Ic;
+    double timestamp;
+  };
+
+  Impl(const Impl &);            // noncopyable
+  Impl &operator=(const Impl &); //
+
+  // Loop of the capture thread, that returns once stopped or when the wrapped acquire() throws
+  void capture()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+      // With LATEST_FRAME the oldest image is recycled when the consumer is late
+      m_frameReleased.wait(
+          lock, [this] { return m_stop || !m_free.empty() || (m_mode == LATEST_FRAME && !m_ready.empty()); });
+      if (m_stop) {
+        break;
+      }
+      size_t index = 0;
+      if (!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+      } else {
+        index = m_ready.front();
+        m_ready.pop_front();
+        m_nbDropped++;
+      }
+      lock.unlock();
+
+      vpFrame &frame = m_frames[index];
+      std::string error;
+      try {
+        if (m_color) {
+          m_grabber->acquire(frame.Ic);
+        } else {
+          m_grabber->acquire(frame.I);
+        }
+      } catch (const vpException &e) {
+        error = e.getStringMessage();
+      } catch (const std::exception &e) {
+        error = e.what();
+      }
+      frame.timestamp = vpTime::measureTimeMs();
+
+      lock.lock();
+      if (!error.empty()) {
+        m_error = error;
+        m_free.push_back(index);
+        break;
+      }
+      m_ready.push_back(index);
+      m_nbCaptured++;
+      m_frameCaptured.notify_one();
+    }
+    m_capturing = false;
+    m_frameCaptured.notify_all();
+  }
+
+  void checkClosed() const
+  {
+    if (isOpen()) {
+      throw(vpException(vpException::fatalError, "Cannot change the settings of an open asynchronous frame grabber"));
+    }
+  }
+
+  void getImage(const vpFrame &frame, vpImage<unsigned char> &I) const
+  {
+    if (m_color) {
+      vpImageConvert::convert(frame.Ic, I);
+    } else {
+      copyImage(frame.I, I);
+    }
+  }
+
+  void getImage(const vpFrame &frame, vpImage<vpRGBa> &I) const
+  {
+    if (m_color) {
+      copyImage(frame.Ic, I);
+    } else {
+      vpImageConvert::convert(frame.I, I);
+    }
+  }
+
+  static bool isColor(const vpImage<unsigned char> &) { return false; }
+
+  static bool isColor(const vpImage<vpRGBa> &) { return true; }
+
+  static void setSize(const vpImage<unsigned char> &I, vpFrame &frame) { frame.I.resize(I.getHeight(), I.getWidth()); }
+
+  static void setSize(const vpImage<vpRGBa> &I, vpFrame &frame) { frame.Ic.resize(I.getHeight(), I.getWidth()); }
+
+  vpFrameGrabber *m_grabber;
+  vpDeliveryMode m_mode;
+  unsigned int m_bufferSize;
+  bool m_color;
+  bool m_isOpen;
+  bool m_stop;
+  bool m_capturing;
+  std::vector<vpFrame> m_frames;
+  std::vector<size_t> m_free;
+  std::deque<size_t> m_ready;
+  std::thread m_thread;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_frameCaptured;
+  std::condition_variable m_frameReleased;
+  unsigned int m_nbCaptured;
+  unsigned int m_nbDropped;
+  std::string m_error;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor. The frame grabber to wrap has to be set with
+  setFrameGrabber() before open().
+*/
+vpAsyncFrameGrabber::vpAsyncFrameGrabber() : m_impl(new Impl) {}
+
+/*!
+  Constructor that wraps a frame grabber.
+
+  \param grabber : Frame grabber used by the capture thread. It is not owned
+  and has to outlive this object or the call to close().
+*/
+vpAsyncFrameGrabber::vpAsyncFrameGrabber(vpFrameGrabber *grabber) : m_impl(new Impl)
+{
+  m_impl->setFrameGrabber(grabber);
+}
+
+/*!
+  Destructor. Stop the capture thread and close the wrapped frame grabber.
+*/
+vpAsyncFrameGrabber::~vpAsyncFrameGrabber() { delete m_impl; }
+
+/*!
+  Get the next image according to the delivery mode, waiting until it is
+  captured.
+
+  \param I : Image acquired. When its type differs from the type of the image
+  passed to open(), the captured image is converted.
+
+  \exception vpException::notInitialized : The frame grabber is not open.
+  \exception vpException::ioError : All the captured images were delivered
+  and the wrapped frame grabber failed to acquire the next one.
+*/
+void vpAsyncFrameGrabber::acquire(vpImage<unsigned char> &I)
+{
+  double timestamp;
+  m_impl->acquire(I, timestamp);
+}
+
+/*!
+  Get the next image according to the delivery mode, waiting until it is
+  captured.
+
+  \param I : Image acquired. When its type differs from the type of the image
+  passed to open(), the captured image is converted.
+
+  \exception vpException::notInitialized : The frame grabber is not open.
+  \exception vpException::ioError : All the captured images were delivered
+  and the wrapped frame grabber failed to acquire the next one.
+*/
+void vpAsyncFrameGrabber::acquire(vpImage<vpRGBa> &I)
+{
+  double timestamp;
+  m_impl->acquire(I, timestamp);
+}
+
+/*!
+  Get the next image according to the delivery mode and its capture time,
+  waiting until it is captured.
+
+  \param I : Image acquired. When its type differs from the type of the image
+  passed to open(), the captured image is converted.
+  \param timestamp : Time in ms given by vpTime::measureTimeMs() when the
+  wrapped frame grabber returned the image.
+
+  \exception vpException::notInitialized : The frame grabber is not open.
+  \exception vpException::ioError : All the captured images were delivered
+  and the wrapped frame grabber failed to acquire the next one.
+*/
+void vpAsyncFrameGrabber::acquire(vpImage<unsigned char> &I, double &timestamp) { m_impl->acquire(I, timestamp); }
+
+/*!
+  Get the next image according to the delivery mode and its capture time,
+  waiting until it is captured.
+
+  \param I : Image acquired. When its type differs from the type of the image
+  passed to open(), the captured image is converted.
+  \param timestamp : Time in ms given by vpTime::measureTimeMs() when the
+  wrapped frame grabber returned the image.
+
+  \exception vpException::notInitialized : The frame grabber is not open.
+  \exception vpException::ioError : All the captured images were delivered
+  and the wrapped frame grabber failed to acquire the next one.
+*/
+void vpAsyncFrameGrabber::acquire(vpImage<vpRGBa> &I, double &timestamp) { m_impl->acquire(I, timestamp); }
+
+/*!
+  Stop the capture thread, discard the images that were not delivered and
+  close the wrapped frame grabber. The capture thread stops once the wrapped
+  acquire() returns.
+*/
+void vpAsyncFrameGrabber::close()
+{
+  m_impl->close();
+  init = false;
+}
+
+/*!
+  Return the number of image buffers.
+*/
+unsigned int vpAsyncFrameGrabber::getBufferSize() const { return m_impl->getBufferSize(); }
+
+/*!
+  Return the images returned by acquire().
+*/
+vpAsyncFrameGrabber::vpDeliveryMode vpAsyncFrameGrabber::getDeliveryMode() const { return m_impl->getDeliveryMode(); }
+
+/*!
+  Return the wrapped frame grabber.
+*/
+vpFrameGrabber *vpAsyncFrameGrabber::getFrameGrabber() const { return m_impl->getFrameGrabber(); }
+
+/*!
+  Return the number of images captured and not delivered yet.
+*/
+unsigned int vpAsyncFrameGrabber::getNbFramesAvailable() const { return m_impl->getNbFramesAvailable(); }
+
+/*!
+  Return the number of images captured since open().
+*/
+unsigned int vpAsyncFrameGrabber::getNbFramesCaptured() const { return m_impl->getNbFramesCaptured(); }
+
+/*!
+  Return the number of images captured and discarded without being delivered
+  since open(), which only happens with LATEST_FRAME.
+*/
+unsigned int vpAsyncFrameGrabber::getNbFramesDropped() const { return m_impl->getNbFramesDropped(); }
+
+/*!
+  Return true while the capture thread runs, that is between open() and
+  close() until the wrapped frame grabber fails to acquire an image.
+*/
+bool vpAsyncFrameGrabber::isCapturing() const { return m_impl->isCapturing(); }
+
+/*!
+  Return true between open() and close().
+*/
+bool vpAsyncFrameGrabber::isOpen() const { return m_impl->isOpen(); }
+
+/*!
+  Open the wrapped frame grabber, allocate the image buffers with the size of
+  the first image and start the capture thread. The images are captured as
+  grayscale images.
+
+  \param I : Image initialized by the wrapped open().
+
+  \exception vpException::notInitialized : No frame grabber is set.
+  \exception vpException::fatalError : The frame grabber is already open.
+*/
+void vpAsyncFrameGrabber::open(vpImage<unsigned char> &I)
+{
+  m_impl->open(I);
+  width = I.getWidth();
+  height = I.getHeight();
+  init = true;
+}
+
+/*!
+  Open the wrapped frame grabber, allocate the image buffers with the size of
+  the first image and start the capture thread. The images are captured as
+  color images.
+
+  \param I : Image initialized by the wrapped open().
+
+  \exception vpException::notInitialized : No frame grabber is set.
+  \exception vpException::fatalError : The frame grabber is already open.
+*/
+void vpAsyncFrameGrabber::open(vpImage<vpRGBa> &I)
+{
+  m_impl->open(I);
+  width = I.getWidth();
+  height = I.getHeight();
+  init = true;
+}
+
+/*!
+  Set the number of image buffers. Default is 3. With EVERY_FRAME, it is the
+  number of images that can be captured in advance. Has to be called before
+  open().
+*/
+void vpAsyncFrameGrabber::setBufferSize(unsigned int bufferSize) { m_impl->setBufferSize(bufferSize); }
+
+/*!
+  Set the images returned by acquire(). Default is LATEST_FRAME. Has to be
+  called before open().
+*/
+void vpAsyncFrameGrabber::setDeliveryMode(vpDeliveryMode mode) { m_impl->setDeliveryMode(mode); }
+
+/*!
+  Set the frame grabber used by the capture thread. It is not owned and has
+  to outlive this object or the call to close(). Has to be called before
+  open().
+*/
+void vpAsyncFrameGrabber::setFrameGrabber(vpFrameGrabber *grabber) { m_impl->setFrameGrabber(grabber); }
+
+#elif !defined(VISP_BUILD_SHARED_LIBS)
+// Work arround to avoid warning:
+// libvisp_io.a(vpAsyncFrameGrabber.cpp.o) has no symbols
+void dummy_vpAsyncFrameGrabber(){};
+#endif
@@ -0,0 +1,526 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Asynchronous recording of image sequences.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpImageSequenceRecorder.cpp
+  \brief Asynchronous recording of image sequences.
+*/
+
+#include <visp3/io/vpImageSequenceRecorder.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <visp3/core/vpTime.h>
+#include <visp3/io/vpImageIo.h>
+#include <visp3/io/vpVideoWriter.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Copy an image in a recycled buffer, the memory being reallocated only when the size changes
+template <class Type> void copyImage(const vpImage<Type> &src, vpImage<Type> &dst)
+{
+  if (dst.getHeight() != src.getHeight() || dst.getWidth() != src.getWidth()) {
+    dst.resize(src.getHeight(), src.getWidth());
+  }
+  if (src.getSize() > 0) {
+    memcpy(static_cast<void *>(dst.bitmap), static_cast<const void *>(src.bitmap), src.getSize() * sizeof(Type));
+  }
+}
+}
+
+class vpImageSequenceRecorder::Impl
+{
+public:
+  Impl()
+    : m_writer(), m_policy(BLOCK_POLICY), m_nbThreads(2), m_queueSize(16), m_firstFrame(0), m_frameIndex(0),
+      m_isOpen(false), m_stop(false), m_frames(), m_free(), m_pending(), m_threads(), m_mutex(), m_frameQueued(),
+      m_frameReleased(), m_nbWritten(0), m_nbDropped(0), m_maxDepth(0), m_totalLatency(0), m_maxLatency(0),
+      m_error()
+  {
+  }
+
+  ~Impl()
+  {
+    try {
+      close();
+    } catch (...) {
+    }
+  }
+
+  void close()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_isOpen) {
+        return;
+      }
+      m_stop = true;
+    }
+    m_frameQueued.notify_all();
+    m_frameReleased.notify_all();
+
+    // The encoders write the queued images before exiting
+    for (size_t i = 0; i < m_threads.size(); i++) {
+      m_threads[i].join();
+    }
+    m_threads.clear();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isOpen = false;
+    checkError();
+  }
+
+  vpBackpressurePolicy getBackpressurePolicy() const { return m_policy; }
+
+  unsigned int getCurrentFrameIndex() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_frameIndex;
+  }
+
+  double getMaxEncodeLatency() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxLatency;
+  }
+
+  unsigned int getMaxQueueDepth() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maxDepth;
+  }
+
+  double getMeanEncodeLatency() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_nbWritten > 0 ? m_totalLatency / m_nbWritten : 0.;
+  }
+
+  unsigned int getNbFramesDropped() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_nbDropped;
+  }
+
+  unsigned int getNbFramesWritten() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_nbWritten;
+  }
+
+  unsigned int getNbThreads() const { return m_nbThreads; }
+
+  unsigned int getQueueDepth() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<unsigned int>(m_frames.size() - m_free.size());
+  }
+
+  unsigned int getQueueSize() const { return m_queueSize; }
+
+  bool isOpen() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isOpen;
+  }
+
+  void open()
+  {
+    if (isOpen()) {
+      throw(vpException(vpException::fatalError, "The image sequence recorder is already open"));
+    }
+    // Throw if the file name is not set or is not an image sequence
+    m_writer.getFrameName(m_firstFrame);
+
+    m_frames.clear();
+    m_frames.resize(m_queueSize);
+    m_free.clear();
+    for (unsigned int i = 0; i < m_queueSize; i++) {
+      m_free.push_back(m_queueSize - 1 - i);
+    }
+    m_pending.clear();
+    m_frameIndex = m_firstFrame;
+    m_nbWritten = m_nbDropped = m_maxDepth = 0;
+    m_totalLatency = m_maxLatency = 0;
+    m_error.clear();
+    m_stop = false;
+    m_isOpen = true;
+
+    for (unsigned int i = 0; i < m_nbThreads; i++) {
+      m_threads.push_back(std::thread(&Impl::encode, this));
+    }
+  }
+
+  template <class Type> bool saveFrame(const vpImage<Type> &I)
+  {
+    size_t index = 0;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (!m_isOpen) {
+        throw(vpException(vpException::notInitialized, "The image sequence recorder has to be open first"));
+      }
+      checkError();
+
+      if (m_free.empty()) {
+        if (m_policy == DROP_POLICY) {
+          m_nbDropped++;
+          m_frameIndex++;
+          return false;
+        }
+        m_frameReleased.wait(lock, [this] { return !m_free.empty() || !m_error.empty(); });
+        checkError();
+      }
+
+      index = m_free.back();
+      m_free.pop_back();
+      m_frames[index].name = m_writer.getFrameName(m_frameIndex++);
+    }
+
+    // The buffer is owned by the caller until it is queued
+    vpFrame &frame = m_frames[index];
+    frame.color = setImage(I, frame);
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_pending.push_back(index);
+      m_maxDepth = std::max(m_maxDepth, static_cast<unsigned int>(m_frames.size() - m_free.size()));
+    }
+    m_frameQueued.notify_one();
+
+    return true;
+  }
+
+  void setBackpressurePolicy(vpBackpressurePolicy policy)
+  {
+    checkClosed();
+    m_policy = policy;
+  }
+
+  void setFileName(const std::string &filename)
+  {
+    checkClosed();
+    m_writer.setFileName(filename);
+    // Throw if the file name is a video
+    m_writer.getFrameName(0);
+  }
+
+  void setFirstFrameIndex(unsigned int firstFrame)
+  {
+    checkClosed();
+    m_firstFrame = firstFrame;
+    m_frameIndex = firstFrame;
+  }
+
+  void setNbThreads(unsigned int nbThreads)
+  {
+    checkClosed();
+    m_nbThreads = std::max(1u, nbThreads);
+  }
+
+  void setQueueSize(unsigned int queueSize)
+  {
+    checkClosed();
+    m_queueSize = std::max(1u, queueSize);
+  }
+
+private:
+  struct vpFrame {
+    vpFrame() : I(), Ic(), color(false), name() {}
+
+    vpImage<unsigned char> I;
+    vpImage<vpRGBa> Ic;
+    bool color;
+    std::string name;
+  };
+
+  Impl(const Impl &);            // noncopyable
+  Impl &operator=(const Impl &); //
+
+  // Has to be called with the mutex locked
+  void checkError() const
+  {
+    if (!m_error.empty()) {
+      throw(vpException(vpException::ioError, "Cannot record the image sequence: %s", m_error.c_str()));
+    }
+  }
+
+  void checkClosed() const
+  {
+    if (isOpen()) {
+      throw(vpException(vpException::fatalError, "Cannot change the settings of an open image sequence recorder"));
+    }
+  }
+
+  // Loop of the encoder threads, that returns once stopped and the queue is empty
+  void encode()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+      m_frameQueued.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+      if (m_pending.empty()) {
+        return;
+      }
+      const size_t index = m_pending.front();
+      m_pending.pop_front();
+      lock.unlock();
+
+      const vpFrame &frame = m_frames[index];
+      std::string error;
+      const double t = vpTime::measureTimeMs();
+      try {
+        if (frame.color) {
+          vpImageIo::write(frame.Ic, frame.name);
+        } else {
+          vpImageIo::write(frame.I, frame.name);
+        }
+      } catch (const vpException &e) {
+        error = frame.name + ": " + e.getStringMessage();
+      } catch (const std::exception &e) {
+        error = frame.name + ": " + e.what();
+      }
+      const double latency = vpTime::measureTimeMs() - t;
+
+      lock.lock();
+      if (error.empty()) {
+        m_nbWritten++;
+        m_totalLatency += latency;
+        m_maxLatency = std::max(m_maxLatency, latency);
+      } else if (m_error.empty()) {
+        m_error = error;
+      }
+      m_free.push_back(index);
+      m_frameReleased.notify_one();
+    }
+  }
+
+  static bool setImage(const vpImage<unsigned char> &I, vpFrame &frame)
+  {
+    copyImage(I, frame.I);
+    return false;
+  }
+
+  static bool setImage(const vpImage<vpRGBa> &I, vpFrame &frame)
+  {
+    copyImage(I, frame.Ic);
+    return true;
+  }
+
+  vpVideoWriter m_writer;
+  vpBackpressurePolicy m_policy;
+  unsigned int m_nbThreads;
+  unsigned int m_queueSize;
+  unsigned int m_firstFrame;
+  unsigned int m_frameIndex;
+  bool m_isOpen;
+  bool m_stop;
+  std::vector<vpFrame> m_frames;
+  std::vector<size_t> m_free;
+  std::deque<size_t> m_pending;
+  std::vector<std::thread> m_threads;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_frameQueued;
+  std::condition_variable m_frameReleased;
+  unsigned int m_nbWritten;
+  unsigned int m_nbDropped;
+  unsigned int m_maxDepth;
+  double m_totalLatency;
+  double m_maxLatency;
+  std::string m_error;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor. The images are written by 2 encoder threads through a
+  queue of 16 images, saveFrame() blocking when the queue is full.
+*/
+vpImageSequenceRecorder::vpImageSequenceRecorder() : m_impl(new Impl) {}
+
+/*!
+  Destructor. Wait until the queued images are written.
+*/
+vpImageSequenceRecorder::~vpImageSequenceRecorder() { delete m_impl; }
+
+/*!
+  Wait until all the queued images are written and stop the encoder threads.
+
+  \exception vpException::ioError : An image could not be written.
+*/
+void vpImageSequenceRecorder::close() { m_impl->close(); }
+
+/*!
+  Return the behavior of saveFrame() when the queue is full.
+*/
+vpImageSequenceRecorder::vpBackpressurePolicy vpImageSequenceRecorder::getBackpressurePolicy() const
+{
+  return m_impl->getBackpressurePolicy();
+}
+
+/*!
+  Return the index of the next frame passed to saveFrame().
+*/
+unsigned int vpImageSequenceRecorder::getCurrentFrameIndex() const { return m_impl->getCurrentFrameIndex(); }
+
+/*!
+  Return the longest time in ms spent to encode and write an image since
+  open().
+*/
+double vpImageSequenceRecorder::getMaxEncodeLatency() const { return m_impl->getMaxEncodeLatency(); }
+
+/*!
+  Return the largest number of images that were simultaneously queued or
+  being encoded since open().
+*/
+unsigned int vpImageSequenceRecorder::getMaxQueueDepth() const { return m_impl->getMaxQueueDepth(); }
+
+/*!
+  Return the mean time in ms spent to encode and write an image since open().
+*/
+double vpImageSequenceRecorder::getMeanEncodeLatency() const { return m_impl->getMeanEncodeLatency(); }
+
+/*!
+  Return the number of images discarded by saveFrame() since open(), which
+  only happens with DROP_POLICY.
+*/
+unsigned int vpImageSequenceRecorder::getNbFramesDropped() const { return m_impl->getNbFramesDropped(); }
+
+/*!
+  Return the number of images written since open().
+*/
+unsigned int vpImageSequenceRecorder::getNbFramesWritten() const { return m_impl->getNbFramesWritten(); }
+
+/*!
+  Return the number of encoder threads.
+*/
+unsigned int vpImageSequenceRecorder::getNbThreads() const { return m_impl->getNbThreads(); }
+
+/*!
+  Return the number of images that are queued or being encoded.
+*/
+unsigned int vpImageSequenceRecorder::getQueueDepth() const { return m_impl->getQueueDepth(); }
+
+/*!
+  Return the maximum number of images that can be queued.
+*/
+unsigned int vpImageSequenceRecorder::getQueueSize() const { return m_impl->getQueueSize(); }
+
+/*!
+  Return true between open() and close().
+*/
+bool vpImageSequenceRecorder::isOpen() const { return m_impl->isOpen(); }
+
+/*!
+  Allocate the queue, reset the frame index to the first frame index and the
+  statistics, and start the encoder threads.
+
+  \exception vpImageException::noFileNameError : The file name template is not set.
+*/
+void vpImageSequenceRecorder::open() { m_impl->open(); }
+
+/*!
+  Queue an image to be written in the file corresponding to the current frame
+  index, and increment the frame index.
+
+  \param I : Image to record. It is copied, so it can be modified as soon as
+  this function returns.
+  \return false if the image is discarded because the queue is full and the
+  policy is DROP_POLICY, true otherwise.
+
+  \exception vpException::ioError : A previous image could not be written.
+*/
+bool vpImageSequenceRecorder::saveFrame(const vpImage<unsigned char> &I) { return m_impl->saveFrame(I); }
+
+/*!
+  Queue an image to be written in the file corresponding to the current frame
+  index, and increment the frame index.
+
+  \param I : Image to record. It is copied, so it can be modified as soon as
+  this function returns.
+  \return false if the image is discarded because the queue is full and the
+  policy is DROP_POLICY, true otherwise.
+
+  \exception vpException::ioError : A previous image could not be written.
+*/
+bool vpImageSequenceRecorder::saveFrame(const vpImage<vpRGBa> &I) { return m_impl->saveFrame(I); }
+
+/*!
+  Set the behavior of saveFrame() when the queue is full. Default is
+  BLOCK_POLICY. Has to be called before open().
+*/
+void vpImageSequenceRecorder::setBackpressurePolicy(vpBackpressurePolicy policy)
+{
+  m_impl->setBackpressurePolicy(policy);
+}
+
+/*!
+  Set the file name template of the image sequence, for example
+  "./image/image%04d.jpeg". The supported formats are the image formats of
+  vpVideoWriter. Has to be called before open().
+
+  \exception vpException::badValue : The file name is not an image sequence.
+*/
+void vpImageSequenceRecorder::setFileName(const std::string &filename) { m_impl->setFileName(filename); }
+
+/*!
+  Set the index of the first frame. Default is 0. Has to be called before
+  open().
+*/
+void vpImageSequenceRecorder::setFirstFrameIndex(unsigned int firstFrame) { m_impl->setFirstFrameIndex(firstFrame); }
+
+/*!
+  Set the number of encoder threads. Default is 2. Has to be called before
+  open().
+*/
+void vpImageSequenceRecorder::setNbThreads(unsigned int nbThreads) { m_impl->setNbThreads(nbThreads); }
+
+/*!
+  Set the maximum number of images that can be queued. Default is 16. Has to
+  be called before open().
+*/
+void vpImageSequenceRecorder::setQueueSize(unsigned int queueSize) { m_impl->setQueueSize(queueSize); }
+
+#elif !defined(VISP_BUILD_SHARED_LIBS)
+// Work arround to avoid warning:
+// libvisp_io.a(vpImageSequenceRecorder.cpp.o) has no symbols
+void dummy_vpImageSequenceRecorder(){};
+#endif
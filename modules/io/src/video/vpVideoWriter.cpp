@@ -211,11 +211,7 @@ void vpVideoWriter::saveFrame(vpImage<vpRGBa> &I)
   }
 
   if (formatType == FORMAT_PGM || formatType == FORMAT_PPM || formatType == FORMAT_JPEG || formatType == FORMAT_PNG) {
-    char name[FILENAME_MAX];
-
-    sprintf(name, fileName, frameCount);
-
-    vpImageIo::write(I, name);
+    vpImageIo::write(I, getFrameName(frameCount));
   } else {
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
     cv::Mat matFrame;
@@ -244,11 +240,7 @@ void vpVideoWriter::saveFrame(vpImage<unsigned char> &I)
   }
 
   if (formatType == FORMAT_PGM || formatType == FORMAT_PPM || formatType == FORMAT_JPEG || formatType == FORMAT_PNG) {
-    char name[FILENAME_MAX];
-
-    sprintf(name, fileName, frameCount);
-
-    vpImageIo::write(I, name);
+    vpImageIo::write(I, getFrameName(frameCount));
   } else {
 #if VISP_HAVE_OPENCV_VERSION >= 0x030000
     cv::Mat matFrame, rgbMatFrame;
@@ -266,6 +258,30 @@ void vpVideoWriter::saveFrame(vpImage<unsigned char> &I)
   frameCount++;
 }
 
+/*!
+  Gets the name of the file in which a frame of the image sequence is saved.
+
+  \param frameIndex : Index of the frame.
+  \return The file name template set with setFileName() where the frame
+  index is substituted, for example "./image/image0012.jpeg" for the frame 12
+  when the template is "./image/image%04d.jpeg".
+*/
+std::string vpVideoWriter::getFrameName(unsigned int frameIndex) const
+{
+  if (!initFileName) {
+    throw(vpImageException(vpImageException::noFileNameError, "filename empty"));
+  }
+
+  if (formatType != FORMAT_PGM && formatType != FORMAT_PPM && formatType != FORMAT_JPEG && formatType != FORMAT_PNG) {
+    throw(vpException(vpException::badValue, "%s is not an image sequence", fileName));
+  }
+
+  char name[FILENAME_MAX];
+  sprintf(name, fileName, frameIndex);
+
+  return std::string(name);
+}
+
 /*!
   Deallocates parameters use to write the video or the image sequence.
 */
@@ -63,8 +63,13 @@
 
   To avoid the aliasing especially when the camera is very near from the image
   plane, a bilinear interpolation can be done for every pixels which have to
-  be filled in. By default this functionality is not used because it consumes
-  lot of time.
+  be filled in. By default this functionality is not used.
+
+  The planes are rasterized row by row: along a row, the texture coordinates
+  and the inverse of the depth are ratios of affine functions of the column,
+  which are updated incrementally. The rows are rendered by the threads of
+  vpThreadPool::getGlobalInstance(), and the static getImage() functions that
+  render a list of planes test the depth of each pixel in a float depth image.
 
   The  following example explain how to use the class.
 
@@ -204,6 +209,8 @@ private:
   // boolean to tell if the points in the camera frame have to be clipped
   bool needClipping;
 
+  unsigned int m_nbThreads;
+
 public:
   explicit vpImageSimulator(const vpColorPlan &col = COLORED);
   vpImageSimulator(const vpImageSimulator &text);
@@ -239,8 +246,17 @@ public:
   void getImage(vpImage<unsigned char> &I, const vpCameraParameters &cam, vpMatrix &zBuffer);
   void getImage(vpImage<vpRGBa> &I, const vpCameraParameters &cam, vpMatrix &zBuffer);
 
-  static void getImage(vpImage<unsigned char> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam);
-  static void getImage(vpImage<vpRGBa> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam);
+  static void getImage(vpImage<unsigned char> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam,
+                       unsigned int nbThreads = 0);
+  static void getImage(vpImage<vpRGBa> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam,
+                       unsigned int nbThreads = 0);
+
+  /*!
+    Return the number of threads used to render the rows of the image.
+
+    \sa setNbThreads()
+  */
+  unsigned int getNbThreads() const { return m_nbThreads; }
 
   std::vector<vpColVector> get3DcornersTextureRectangle();
 
@@ -263,6 +279,18 @@ public:
     bgColor = color;
   }
 
+  /*!
+    Set the number of threads used by the getImage() functions of this plane
+    to render the rows of the image. The result does not depend on the number
+    of threads. Limiting it is useful when several images are already
+    generated in parallel.
+
+    \param nbThreads : Number of threads. 0 means all the threads of
+    vpThreadPool::getGlobalInstance(), 1 renders the rows sequentially.
+    Default value is 0.
+  */
+  void setNbThreads(unsigned int nbThreads) { m_nbThreads = nbThreads; }
+
   /*!
    This function allows to set the background to a texture instead of the
    default black background.
@@ -283,22 +311,24 @@ private:
   // sinon invisible.
   bool isVisible() { return visible; }
 
-  // function that project a point x,y on the plane, return true if the
-  // projection is on the limited plane
-  // and in this case return the corresponding image pixel Ipixelplan
-  bool getPixel(const vpImagePoint &iP, unsigned char &Ipixelplan);
-  bool getPixel(const vpImagePoint &iP, vpRGBa &Ipixelplan);
-  bool getPixel(vpImage<unsigned char> &Isrc, const vpImagePoint &iP, unsigned char &Ipixelplan);
-  bool getPixel(vpImage<vpRGBa> &Isrc, const vpImagePoint &iP, vpRGBa &Ipixelplan);
-  bool getPixelDepth(const vpImagePoint &iP, double &Zpixelplan);
   bool getPixelVisibility(const vpImagePoint &iP, double &Zpixelplan);
 
-  // operation 3D de base :
-  void project(const vpColVector &_vin, const vpHomogeneousMatrix &_cMt, vpColVector &_vout);
-  // donne coordonnes homogenes de _v;
-  void getHomogCoord(const vpColVector &_v, vpColVector &_vH);
-  // donne coordonnes _v en fction coord homogenes _vH;
-  void getCoordFromHomog(const vpColVector &_vH, vpColVector &_v);
+  // Projection of the plane in an image of a given size, computed once per
+  // getImage() call and used to render the rows of the image
+  struct vpRaster;
+  void initRaster(unsigned int height, unsigned int width, const vpCameraParameters &cam, vpRaster &raster);
+  template <class Type, class Texture, class DepthTest>
+  void rasterize(vpImage<Type> &I, const vpImage<Texture> &texture, const vpRaster &raster, DepthTest &depthTest,
+                 unsigned int top, unsigned int bottom) const;
+  template <class Type, class Texture, class DepthTest>
+  void render(vpImage<Type> &I, const vpImage<Texture> &texture, const vpCameraParameters &cam, DepthTest &depthTest);
+  template <class Type>
+  static void render(vpImage<Type> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam,
+                     unsigned int nbThreads);
+  template <class Type>
+  static void rasterize(vpImage<Type> &I, const std::vector<vpImageSimulator *> &simList,
+                        const std::vector<vpRaster> &rasters, vpImage<float> &depth, unsigned int top,
+                        unsigned int bottom);
 
   void getRoi(const unsigned int &Iwidth, const unsigned int &Iheight, const vpCameraParameters &cam,
               const std::vector<vpPoint> &point, vpRect &rect);
@@ -37,6 +37,9 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <limits>
+
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpMatrixException.h>
 #include <visp3/core/vpMeterPixelConversion.h>
@@ -45,10 +48,358 @@
 #include <visp3/core/vpRotationMatrix.h>
 #include <visp3/robot/vpImageSimulator.h>
 
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <visp3/core/vpThreadPool.h>
+#endif
+
 #ifdef VISP_HAVE_MODULE_IO
 #include <visp3/io/vpImageIo.h>
 #endif
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Number of image rows rendered by a task
+const unsigned int bandSize = 16;
+
+// Depth test of getImage() without z-buffer
+struct vpNoDepthTest {
+  bool operator()(unsigned int, unsigned int, double) const { return true; }
+};
+
+// Depth test with the z coordinates of a matrix, negative values meaning that no plane was drawn
+class vpMatrixDepthTest
+{
+public:
+  explicit vpMatrixDepthTest(vpMatrix &zBuffer) : m_zBuffer(zBuffer) {}
+
+  bool operator()(unsigned int i, unsigned int j, double z) const
+  {
+    double &zb = m_zBuffer[i][j];
+    if (z < zb || zb < 0) {
+      zb = z;
+      return true;
+    }
+    return false;
+  }
+
+private:
+  vpMatrix &m_zBuffer;
+};
+
+// Depth test with the z coordinates of a float image initialized to the largest float
+class vpFloatDepthTest
+{
+public:
+  explicit vpFloatDepthTest(vpImage<float> &depth) : m_depth(depth) {}
+
+  bool operator()(unsigned int i, unsigned int j, double z) const
+  {
+    float &zb = m_depth[i][j];
+    const float zf = static_cast<float>(z);
+    if (zf < zb) {
+      zb = zf;
+      return true;
+    }
+    return false;
+  }
+
+private:
+  vpImage<float> &m_depth;
+};
+
+// Bilinear interpolation at (y, x) in 16.16 fixed point, same result as vpImage<unsigned char>::getValue()
+inline unsigned char interpolate(const vpImage<unsigned char> &I, int64_t y, int64_t x)
+{
+  const unsigned int i = static_cast<unsigned int>(y >> 16), j = static_cast<unsigned int>(x >> 16);
+  const unsigned int i1 = std::min(i + 1, I.getHeight() - 1), j1 = std::min(j + 1, I.getWidth() - 1);
+  const int64_t rratio = y & 0xFFFF, cratio = x & 0xFFFF;
+  const int64_t rfrac = 0x10000 - rratio, cfrac = 0x10000 - cratio;
+  const unsigned char *up = I[i], *down = I[i1];
+  return static_cast<unsigned char>(
+      ((up[j] * rfrac + down[j] * rratio) * cfrac + (up[j1] * rfrac + down[j1] * rratio) * cratio) >> 32);
+}
+
+// Bilinear interpolation at (y, x) in 16.16 fixed point, rounded like vpImage<vpRGBa>::getValue()
+inline vpRGBa interpolate(const vpImage<vpRGBa> &I, int64_t y, int64_t x)
+{
+  const unsigned int i = static_cast<unsigned int>(y >> 16), j = static_cast<unsigned int>(x >> 16);
+  const unsigned int i1 = std::min(i + 1, I.getHeight() - 1), j1 = std::min(j + 1, I.getWidth() - 1);
+  const int64_t rratio = y & 0xFFFF, cratio = x & 0xFFFF;
+  const int64_t rfrac = 0x10000 - rratio, cfrac = 0x10000 - cratio;
+  const int64_t half = static_cast<int64_t>(1) << 31;
+  const vpRGBa &p00 = I[i][j], &p01 = I[i][j1], &p10 = I[i1][j], &p11 = I[i1][j1];
+  const int64_t R = (p00.R * rfrac + p10.R * rratio) * cfrac + (p01.R * rfrac + p11.R * rratio) * cratio;
+  const int64_t G = (p00.G * rfrac + p10.G * rratio) * cfrac + (p01.G * rfrac + p11.G * rratio) * cratio;
+  const int64_t B = (p00.B * rfrac + p10.B * rratio) * cfrac + (p01.B * rfrac + p11.B * rratio) * cratio;
+  return vpRGBa(static_cast<unsigned char>((R + half) >> 32), static_cast<unsigned char>((G + half) >> 32),
+                static_cast<unsigned char>((B + half) >> 32));
+}
+
+// Texture value at the normalized coordinates 0 < u < 1 and 0 < v < 1
+template <class Type> inline Type sample(const vpImage<Type> &texture, double u, double v, bool bilinear)
+{
+  const double i = v * (texture.getHeight() - 1);
+  const double j = u * (texture.getWidth() - 1);
+  if (bilinear) {
+    return interpolate(texture, static_cast<int64_t>(i * 0x10000), static_cast<int64_t>(j * 0x10000));
+  }
+  return texture[static_cast<unsigned int>(i)][static_cast<unsigned int>(j)];
+}
+
+inline void setPixel(unsigned char &dst, unsigned char src) { dst = src; }
+
+inline void setPixel(unsigned char &dst, const vpRGBa &src)
+{
+  dst = static_cast<unsigned char>(0.2126 * src.R + 0.7152 * src.G + 0.0722 * src.B);
+}
+
+inline void setPixel(vpRGBa &dst, unsigned char src) { dst = vpRGBa(src, src, src); }
+
+inline void setPixel(vpRGBa &dst, const vpRGBa &src) { dst = src; }
+
+// Draw the pixel (i, j) whose texture coordinates are u = U / W and v = V / W, and depth distance / W
+template <class Type, class Texture, class DepthTest>
+inline void shade(Type &dst, const vpImage<Texture> &texture, DepthTest &depthTest, unsigned int i, unsigned int j,
+                  double U, double V, double W, double distance, bool bilinear)
+{
+  if (W > 0 && U > 0 && V > 0 && U < W && V < W) {
+    const double invW = 1. / W;
+    if (depthTest(i, j, distance * invW)) {
+      setPixel(dst, sample(texture, U * invW, V * invW, bilinear));
+    }
+  }
+}
+}
+
+struct vpImageSimulator::vpRaster {
+  vpRaster() : distance(0), distortion(false), cam(), x(), y(), top(0), bottom(0), left(0), right(0)
+  {
+    for (unsigned int k = 0; k < 3; k++) {
+      hu[k] = hv[k] = hw[k] = 0;
+    }
+  }
+
+  // Without distortion, u = (hu . (j, i, 1)) / (hw . (j, i, 1)) is the texture coordinate along the first side of
+  // the plane, v the one along the second side and Z = distance / (hw . (j, i, 1)) the depth of the pixel (i, j).
+  // With distortion, (j, i) is replaced by the normalized coordinates (x, y) of the pixel.
+  double hu[3];
+  double hv[3];
+  double hw[3];
+  double distance;
+  bool distortion;
+  vpCameraParameters cam;
+  // Projection of the plane, in pixel, used to bound the rows without distortion
+  std::vector<double> x;
+  std::vector<double> y;
+  // Rows and columns to render
+  unsigned int top;
+  unsigned int bottom;
+  unsigned int left;
+  unsigned int right;
+};
+
+void vpImageSimulator::initRaster(unsigned int height, unsigned int width, const vpCameraParameters &cam,
+                                  vpRaster &raster)
+{
+  const std::vector<vpPoint> &points = needClipping ? ptClipped : pt;
+  getRoi(width, height, cam, points, rect);
+  raster.top = static_cast<unsigned int>(rect.getTop());
+  raster.bottom = static_cast<unsigned int>(rect.getBottom());
+  raster.left = static_cast<unsigned int>(rect.getLeft());
+  raster.right = static_cast<unsigned int>(rect.getRight());
+
+  // The ray (x, y, 1) intersects the plane at Z = distance / (n . (x, y, 1)), and the texture coordinates of the
+  // intersection are its projections on the sides of the plane
+  double X0_u = 0, X0_v = 0;
+  for (unsigned int k = 0; k < 3; k++) {
+    X0_u += X0_2_optim[k] * vbase_u_optim[k];
+    X0_v += X0_2_optim[k] * vbase_v_optim[k];
+  }
+  const double norm_u = frobeniusNorm_u * frobeniusNorm_u;
+  const double norm_v = fronbniusNorm_v * fronbniusNorm_v;
+  double hu[3], hv[3], hw[3];
+  for (unsigned int k = 0; k < 3; k++) {
+    hu[k] = (distance * vbase_u_optim[k] - X0_u * normal_Cam_optim[k]) / norm_u;
+    hv[k] = (distance * vbase_v_optim[k] - X0_v * normal_Cam_optim[k]) / norm_v;
+    hw[k] = normal_Cam_optim[k];
+  }
+  raster.distance = distance;
+  raster.distortion = (cam.get_projModel() != vpCameraParameters::perspectiveProjWithoutDistortion);
+  raster.cam = cam;
+  raster.x.clear();
+  raster.y.clear();
+
+  if (raster.distortion) {
+    for (unsigned int k = 0; k < 3; k++) {
+      raster.hu[k] = hu[k];
+      raster.hv[k] = hv[k];
+      raster.hw[k] = hw[k];
+    }
+  } else {
+    // Substitute x = (j - u0) / px and y = (i - v0) / py
+    const double px = cam.get_px(), py = cam.get_py(), u0 = cam.get_u0(), v0 = cam.get_v0();
+    double *h[3] = {hu, hv, hw};
+    double *r[3] = {raster.hu, raster.hv, raster.hw};
+    for (unsigned int k = 0; k < 3; k++) {
+      r[k][0] = h[k][0] / px;
+      r[k][1] = h[k][1] / py;
+      r[k][2] = h[k][2] - h[k][0] * u0 / px - h[k][1] * v0 / py;
+    }
+    for (size_t k = 0; k < points.size(); k++) {
+      raster.x.push_back(points[k].get_x() * px + u0);
+      raster.y.push_back(points[k].get_y() * py + v0);
+    }
+  }
+}
+
+template <class Type, class Texture, class DepthTest>
+void vpImageSimulator::rasterize(vpImage<Type> &I, const vpImage<Texture> &texture, const vpRaster &raster,
+                                 DepthTest &depthTest, unsigned int top, unsigned int bottom) const
+{
+  const bool bilinear = (interp == BILINEAR_INTERPOLATION);
+  top = std::max(top, raster.top);
+  bottom = std::min(bottom, raster.bottom);
+
+  for (unsigned int i = top; i < bottom; i++) {
+    Type *row = I[i];
+    if (raster.distortion) {
+      for (unsigned int j = raster.left; j < raster.right; j++) {
+        double x = 0, y = 0;
+        vpPixelMeterConversion::convertPoint(raster.cam, static_cast<double>(j), static_cast<double>(i), x, y);
+        const double U = raster.hu[0] * x + raster.hu[1] * y + raster.hu[2];
+        const double V = raster.hv[0] * x + raster.hv[1] * y + raster.hv[2];
+        const double W = raster.hw[0] * x + raster.hw[1] * y + raster.hw[2];
+        shade(row[j], texture, depthTest, i, j, U, V, W, raster.distance, bilinear);
+      }
+      continue;
+    }
+
+    // Columns where the projection of the plane intersects the rows i - 1 to i + 1, the pixels being then
+    // selected by their texture coordinates
+    const double ymin = i - 1., ymax = i + 1.;
+    double xmin = std::numeric_limits<double>::max(), xmax = -std::numeric_limits<double>::max();
+    for (size_t k = 0, n = raster.x.size(); k < n; k++) {
+      const size_t l = (k + 1) % n;
+      const double x0 = raster.x[k], y0 = raster.y[k], x1 = raster.x[l], y1 = raster.y[l];
+      if (std::max(y0, y1) < ymin || std::min(y0, y1) > ymax) {
+        continue;
+      }
+      double t0 = 0, t1 = 1;
+      if (y0 != y1) {
+        t0 = std::min(std::max((ymin - y0) / (y1 - y0), 0.), 1.);
+        t1 = std::min(std::max((ymax - y0) / (y1 - y0), 0.), 1.);
+      }
+      const double xa = x0 + t0 * (x1 - x0), xb = x0 + t1 * (x1 - x0);
+      xmin = std::min(xmin, std::min(xa, xb));
+      xmax = std::max(xmax, std::max(xa, xb));
+    }
+    if (xmin > xmax || xmax < raster.left || xmin >= raster.right) {
+      continue;
+    }
+    const unsigned int left = std::max(raster.left, static_cast<unsigned int>(std::max(xmin, 0.)));
+    const unsigned int right = static_cast<unsigned int>(std::min(static_cast<double>(raster.right), xmax + 1.));
+
+    // Incremental evaluation along the row
+    double U = raster.hu[0] * left + raster.hu[1] * i + raster.hu[2];
+    double V = raster.hv[0] * left + raster.hv[1] * i + raster.hv[2];
+    double W = raster.hw[0] * left + raster.hw[1] * i + raster.hw[2];
+    for (unsigned int j = left; j <= right && j < raster.right; j++) {
+      shade(row[j], texture, depthTest, i, j, U, V, W, raster.distance, bilinear);
+      U += raster.hu[0];
+      V += raster.hv[0];
+      W += raster.hw[0];
+    }
+  }
+}
+
+template <class Type, class Texture, class DepthTest>
+void vpImageSimulator::render(vpImage<Type> &I, const vpImage<Texture> &texture, const vpCameraParameters &cam,
+                              DepthTest &depthTest)
+{
+  vpRaster raster;
+  initRaster(I.getHeight(), I.getWidth(), cam, raster);
+  if (raster.bottom <= raster.top) {
+    return;
+  }
+  const int nbBands = static_cast<int>((raster.bottom - raster.top + bandSize - 1) / bandSize);
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, nbBands,
+                                                [&](int start, int end) {
+                                                  rasterize(I, texture, raster, depthTest,
+                                                            raster.top + start * bandSize,
+                                                            raster.top + end * bandSize);
+                                                },
+                                                m_nbThreads, 1);
+#else
+  rasterize(I, texture, raster, depthTest, raster.top, raster.top + nbBands * bandSize);
+#endif
+}
+
+template <class Type>
+void vpImageSimulator::render(vpImage<Type> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam,
+                              unsigned int nbThreads)
+{
+  std::vector<vpImageSimulator *> simList;
+  for (std::list<vpImageSimulator>::iterator it = list.begin(); it != list.end(); ++it) {
+    if (it->visible) {
+      simList.push_back(&(*it));
+    }
+  }
+  if (simList.empty()) {
+    return;
+  }
+
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  std::vector<vpRaster> rasters(simList.size());
+  unsigned int top = height, bottom = 0;
+  for (size_t k = 0; k < simList.size(); k++) {
+    simList[k]->initRaster(height, width, cam, rasters[k]);
+    if (rasters[k].bottom > rasters[k].top) {
+      top = std::min(top, rasters[k].top);
+      bottom = std::max(bottom, rasters[k].bottom);
+    }
+  }
+  if (bottom <= top) {
+    return;
+  }
+
+  vpImage<float> depth(height, width);
+  const int nbBands = static_cast<int>((bottom - top + bandSize - 1) / bandSize);
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, nbBands,
+                                                [&](int start, int end) {
+                                                  rasterize(I, simList, rasters, depth, top + start * bandSize,
+                                                            std::min(bottom, top + end * bandSize));
+                                                },
+                                                nbThreads, 1);
+#else
+  (void)nbThreads;
+  rasterize(I, simList, rasters, depth, top, bottom);
+#endif
+}
+
+template <class Type>
+void vpImageSimulator::rasterize(vpImage<Type> &I, const std::vector<vpImageSimulator *> &simList,
+                                 const std::vector<vpRaster> &rasters, vpImage<float> &depth, unsigned int top,
+                                 unsigned int bottom)
+{
+  // The planes are drawn in the list order, a pixel being replaced by a strictly closer one
+  std::fill(depth[top], depth[top] + (bottom - top) * depth.getWidth(), std::numeric_limits<float>::max());
+  vpFloatDepthTest depthTest(depth);
+  for (size_t k = 0; k < simList.size(); k++) {
+    const vpImageSimulator &sim = *simList[k];
+    if (sim.colorI == GRAY_SCALED) {
+      sim.rasterize(I, sim.Ig, rasters[k], depthTest, top, bottom);
+    } else {
+      sim.rasterize(I, sim.Ic, rasters[k], depthTest, top, bottom);
+    }
+  }
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
   Basic constructor.
 
@@ -63,7 +414,8 @@ vpImageSimulator::vpImageSimulator(const vpColorPlan &col)
   : cMt(), pt(), ptClipped(), interp(SIMPLE), normal_obj(), normal_Cam(), normal_Cam_optim(), distance(1.),
     visible_result(1.), visible(false), X0_2_optim(NULL), frobeniusNorm_u(0.), fronbniusNorm_v(0.), vbase_u(),
     vbase_v(), vbase_u_optim(NULL), vbase_v_optim(NULL), Xinter_optim(NULL), listTriangle(), colorI(col), Ig(), Ic(),
-    rect(), cleanPrevImage(false), setBackgroundTexture(false), bgColor(vpColor::white), focal(), needClipping(false)
+    rect(), cleanPrevImage(false), setBackgroundTexture(false), bgColor(vpColor::white), focal(), needClipping(false),
+    m_nbThreads(0)
 {
   for (int i = 0; i < 4; i++)
     X[i].resize(3);
@@ -101,7 +453,7 @@ vpImageSimulator::vpImageSimulator(const vpImageSimulator &text)
     visible_result(1.), visible(false), X0_2_optim(NULL), frobeniusNorm_u(0.), fronbniusNorm_v(0.), vbase_u(),
     vbase_v(), vbase_u_optim(NULL), vbase_v_optim(NULL), Xinter_optim(NULL), listTriangle(), colorI(GRAY_SCALED), Ig(),
     Ic(), rect(), cleanPrevImage(false), setBackgroundTexture(false), bgColor(vpColor::white), focal(),
-    needClipping(false)
+    needClipping(false), m_nbThreads(text.m_nbThreads)
 {
   pt.resize(4);
   for (unsigned int i = 0; i < 4; i++) {
@@ -175,6 +527,7 @@ vpImageSimulator &vpImageSimulator::operator=(const vpImageSimulator &sim)
 
   colorI = sim.colorI;
   interp = sim.interp;
+  m_nbThreads = sim.m_nbThreads;
 
   setCameraPosition(sim.cMt);
 
@@ -203,44 +556,11 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, const vpCameraParamet
   }
 
   if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
+    vpNoDepthTest depthTest;
+    if (colorI == GRAY_SCALED)
+      render(I, Ig, cam, depthTest);
     else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    unsigned char *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan = 0;
-          if (getPixel(ip, Ipixelplan)) {
-            *(bitmap + i * width + j) = Ipixelplan;
-            nb_point_dessine++;
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            unsigned char pixelgrey =
-                (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
-            *(bitmap + i * width + j) = pixelgrey;
-            nb_point_dessine++;
-          }
-        }
-      }
-    }
+      render(I, Ic, cam, depthTest);
   }
 }
 
@@ -263,35 +583,10 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, vpImage<unsigned char
       }
     }
   }
-  if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
-    else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    unsigned char *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
 
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        unsigned char Ipixelplan = 0;
-        if (getPixel(Isrc, ip, Ipixelplan)) {
-          *(bitmap + i * width + j) = Ipixelplan;
-          nb_point_dessine++;
-        }
-      }
-    }
+  if (visible) {
+    vpNoDepthTest depthTest;
+    render(I, Isrc, cam, depthTest);
   }
 }
 
@@ -324,51 +619,13 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, const vpCameraParamet
       }
     }
   }
+
   if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
+    vpMatrixDepthTest depthTest(zBuffer);
+    if (colorI == GRAY_SCALED)
+      render(I, Ig, cam, depthTest);
     else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    unsigned char *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              *(bitmap + i * width + j) = Ipixelplan;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              unsigned char pixelgrey =
-                  (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
-              *(bitmap + i * width + j) = pixelgrey;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        }
-      }
-    }
+      render(I, Ic, cam, depthTest);
   }
 }
 
@@ -390,46 +647,11 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, const vpCameraParameters &ca
   }
 
   if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
+    vpNoDepthTest depthTest;
+    if (colorI == GRAY_SCALED)
+      render(I, Ig, cam, depthTest);
     else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    vpRGBa *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            vpRGBa pixelcolor;
-            pixelcolor.R = Ipixelplan;
-            pixelcolor.G = Ipixelplan;
-            pixelcolor.B = Ipixelplan;
-            *(bitmap + i * width + j) = pixelcolor;
-            nb_point_dessine++;
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            *(bitmap + i * width + j) = Ipixelplan;
-            nb_point_dessine++;
-          }
-        }
-      }
-    }
+      render(I, Ic, cam, depthTest);
   }
 }
 
@@ -453,34 +675,8 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, vpImage<vpRGBa> &Isrc, const
   }
 
   if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
-    else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    vpRGBa *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        vpRGBa Ipixelplan;
-        if (getPixel(Isrc, ip, Ipixelplan)) {
-          *(bitmap + i * width + j) = Ipixelplan;
-          nb_point_dessine++;
-        }
-      }
-    }
+    vpNoDepthTest depthTest;
+    render(I, Isrc, cam, depthTest);
   }
 }
 
@@ -512,53 +708,13 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, const vpCameraParameters &ca
       }
     }
   }
+
   if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
+    vpMatrixDepthTest depthTest(zBuffer);
+    if (colorI == GRAY_SCALED)
+      render(I, Ig, cam, depthTest);
     else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    vpRGBa *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              vpRGBa pixelcolor;
-              pixelcolor.R = Ipixelplan;
-              pixelcolor.G = Ipixelplan;
-              pixelcolor.B = Ipixelplan;
-              *(bitmap + i * width + j) = pixelcolor;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              *(bitmap + i * width + j) = Ipixelplan;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        }
-      }
-    }
+      render(I, Ic, cam, depthTest);
   }
 }
 
@@ -665,97 +821,15 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, const vpCameraParameters &ca
   \param I : The image used to store the result
   \param list : List of vpImageSimulator to project
   \param cam : The parameters of the virtual camera
+  \param nbThreads : Maximum number of threads of the pool returned by
+  vpThreadPool::getGlobalInstance(). If 0, all the threads of the pool are
+  used. The number of threads set with setNbThreads() to the planes of the
+  list is not used.
 */
 void vpImageSimulator::getImage(vpImage<unsigned char> &I, std::list<vpImageSimulator> &list,
-                                const vpCameraParameters &cam)
+                                const vpCameraParameters &cam, unsigned int nbThreads)
 {
-
-  unsigned int width = I.getWidth();
-  unsigned int height = I.getHeight();
-
-  unsigned int nbsimList = (unsigned int)list.size();
-
-  if (nbsimList < 1)
-    return;
-
-  vpImageSimulator **simList = new vpImageSimulator *[nbsimList];
-
-  double topFinal = height + 1;
-  ;
-  double bottomFinal = -1;
-  double leftFinal = width + 1;
-  double rightFinal = -1;
-
-  unsigned int unvisible = 0;
-  unsigned int indexSimu = 0;
-  for (std::list<vpImageSimulator>::iterator it = list.begin(); it != list.end(); ++it, ++indexSimu) {
-    vpImageSimulator *sim = &(*it);
-    if (sim->visible)
-      simList[indexSimu] = sim;
-    else
-      unvisible++;
-  }
-  nbsimList = nbsimList - unvisible;
-
-  if (nbsimList < 1) {
-    delete[] simList;
-    return;
-  }
-
-  for (unsigned int i = 0; i < nbsimList; i++) {
-    if (!simList[i]->needClipping)
-      simList[i]->getRoi(width, height, cam, simList[i]->pt, simList[i]->rect);
-    else
-      simList[i]->getRoi(width, height, cam, simList[i]->ptClipped, simList[i]->rect);
-
-    if (topFinal > simList[i]->rect.getTop())
-      topFinal = simList[i]->rect.getTop();
-    if (bottomFinal < simList[i]->rect.getBottom())
-      bottomFinal = simList[i]->rect.getBottom();
-    if (leftFinal > simList[i]->rect.getLeft())
-      leftFinal = simList[i]->rect.getLeft();
-    if (rightFinal < simList[i]->rect.getRight())
-      rightFinal = simList[i]->rect.getRight();
-  }
-
-  double zmin = -1;
-  int indice = -1;
-  unsigned char *bitmap = I.bitmap;
-  vpImagePoint ip;
-
-  for (unsigned int i = (unsigned int)topFinal; i < (unsigned int)bottomFinal; i++) {
-    for (unsigned int j = (unsigned int)leftFinal; j < (unsigned int)rightFinal; j++) {
-      zmin = -1;
-      double x = 0, y = 0;
-      ip.set_ij(i, j);
-      vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-      ip.set_ij(y, x);
-      for (int k = 0; k < (int)nbsimList; k++) {
-        double z = 0;
-        if (simList[k]->getPixelDepth(ip, z)) {
-          if (z < zmin || zmin < 0) {
-            zmin = z;
-            indice = k;
-          }
-        }
-      }
-      if (indice >= 0) {
-        if (simList[indice]->colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan = 255;
-          simList[indice]->getPixel(ip, Ipixelplan);
-          *(bitmap + i * width + j) = Ipixelplan;
-        } else if (simList[indice]->colorI == COLORED) {
-          vpRGBa Ipixelplan(255, 255, 255);
-          simList[indice]->getPixel(ip, Ipixelplan);
-          unsigned char pixelgrey =
-              (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
-          *(bitmap + i * width + j) = pixelgrey;
-        }
-      }
-    }
-  }
-
-  delete[] simList;
+  render(I, list, cam, nbThreads);
 }
 
 /*!
@@ -863,101 +937,15 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, std::list<vpImageSimu
   \param I : The image used to store the result
   \param list : List of vpImageSimulator to project
   \param cam : The parameters of the virtual camera
+  \param nbThreads : Maximum number of threads of the pool returned by
+  vpThreadPool::getGlobalInstance(). If 0, all the threads of the pool are
+  used. The number of threads set with setNbThreads() to the planes of the
+  list is not used.
 */
-void vpImageSimulator::getImage(vpImage<vpRGBa> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam)
+void vpImageSimulator::getImage(vpImage<vpRGBa> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam,
+                                unsigned int nbThreads)
 {
-
-  unsigned int width = I.getWidth();
-  unsigned int height = I.getHeight();
-
-  unsigned int nbsimList = (unsigned int)list.size();
-
-  if (nbsimList < 1)
-    return;
-
-  vpImageSimulator **simList = new vpImageSimulator *[nbsimList];
-
-  double topFinal = height + 1;
-  ;
-  double bottomFinal = -1;
-  double leftFinal = width + 1;
-  double rightFinal = -1;
-
-  unsigned int unvisible = 0;
-  unsigned int indexSimu = 0;
-  for (std::list<vpImageSimulator>::iterator it = list.begin(); it != list.end(); ++it, ++indexSimu) {
-    vpImageSimulator *sim = &(*it);
-    if (sim->visible)
-      simList[indexSimu] = sim;
-    else
-      unvisible++;
-  }
-
-  nbsimList = nbsimList - unvisible;
-
-  if (nbsimList < 1) {
-    delete[] simList;
-    return;
-  }
-
-  for (unsigned int i = 0; i < nbsimList; i++) {
-    if (!simList[i]->needClipping)
-      simList[i]->getRoi(width, height, cam, simList[i]->pt, simList[i]->rect);
-    else
-      simList[i]->getRoi(width, height, cam, simList[i]->ptClipped, simList[i]->rect);
-
-    if (topFinal > simList[i]->rect.getTop())
-      topFinal = simList[i]->rect.getTop();
-    if (bottomFinal < simList[i]->rect.getBottom())
-      bottomFinal = simList[i]->rect.getBottom();
-    if (leftFinal > simList[i]->rect.getLeft())
-      leftFinal = simList[i]->rect.getLeft();
-    if (rightFinal < simList[i]->rect.getRight())
-      rightFinal = simList[i]->rect.getRight();
-  }
-
-  double zmin = -1;
-  int indice = -1;
-  vpRGBa *bitmap = I.bitmap;
-  vpImagePoint ip;
-
-  for (unsigned int i = (unsigned int)topFinal; i < (unsigned int)bottomFinal; i++) {
-    for (unsigned int j = (unsigned int)leftFinal; j < (unsigned int)rightFinal; j++) {
-      zmin = -1;
-      double x = 0, y = 0;
-      ip.set_ij(i, j);
-      vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-      ip.set_ij(y, x);
-      for (int k = 0; k < (int)nbsimList; k++) {
-        double z = 0;
-        if (simList[k]->getPixelDepth(ip, z)) {
-          if (z < zmin || zmin < 0) {
-            zmin = z;
-            indice = k;
-          }
-        }
-      }
-      if (indice >= 0) {
-        if (simList[indice]->colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan = 255;
-          simList[indice]->getPixel(ip, Ipixelplan);
-          vpRGBa pixelcolor;
-          pixelcolor.R = Ipixelplan;
-          pixelcolor.G = Ipixelplan;
-          pixelcolor.B = Ipixelplan;
-          *(bitmap + i * width + j) = pixelcolor;
-        } else if (simList[indice]->colorI == COLORED) {
-          vpRGBa Ipixelplan(255, 255, 255);
-          simList[indice]->getPixel(ip, Ipixelplan);
-          // unsigned char pixelgrey = 0.2126 * Ipixelplan.R + 0.7152 *
-          // Ipixelplan.G + 0.0722 * Ipixelplan.B;
-          *(bitmap + i * width + j) = Ipixelplan;
-        }
-      }
-    }
-  }
-
-  delete[] simList;
+  render(I, list, cam, nbThreads);
 }
 
 /*!
@@ -1003,7 +991,9 @@ void vpImageSimulator::setCameraPosition(const vpHomogeneousMatrix &cMt_)
 
   if (visible) {
     for (unsigned int i = 0; i < 4; i++) {
-      project(X[i], cMt, X2[i]);
+      for (unsigned int j = 0; j < 3; j++) {
+        X2[i][j] = cMt[j][0] * X[i][0] + cMt[j][1] * X[i][1] + cMt[j][2] * X[i][2] + cMt[j][3];
+      }
       pt[i].track(cMt);
       if (pt[i].get_Z() < 0)
         needClipping = true;
@@ -1231,237 +1221,6 @@ void vpImageSimulator::init(const char *file_image, const std::vector<vpPoint> &
 }
 #endif
 
-bool vpImageSimulator::getPixel(const vpImagePoint &iP, unsigned char &Ipixelplan)
-{
-  //  std::cout << "In get Pixel" << std::endl;
-  // test si pixel dans zone projetee
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP)){
-  ////      std::cout << "The pixel is inside the projected area" <<
-  /// std::endl;
-  //    return false;}
-
-  // methoed algebrique
-  double z;
-
-  // calcul de la profondeur de l'intersection
-  z = distance / (normal_Cam_optim[0] * iP.get_u() + normal_Cam_optim[1] * iP.get_v() + normal_Cam_optim[2]);
-  // calcul coordonnees 3D intersection
-  Xinter_optim[0] = iP.get_u() * z;
-  Xinter_optim[1] = iP.get_v() * z;
-  Xinter_optim[2] = z;
-
-  // recuperation des coordonnes de l'intersection dans le plan objet
-  // repere plan object :
-  //	centre = X0_2_optim[i] (premier point definissant le plan)
-  //	base =  u:(X[1]-X[0]) et v:(X[3]-X[0])
-  // ici j'ai considere que le plan est un rectangle => coordonnees sont
-  // simplement obtenu par un produit scalaire
-  double u = 0, v = 0;
-  for (unsigned int i = 0; i < 3; i++) {
-    double diff = (Xinter_optim[i] - X0_2_optim[i]);
-    u += diff * vbase_u_optim[i];
-    v += diff * vbase_v_optim[i];
-  }
-  u = u / (frobeniusNorm_u * frobeniusNorm_u);
-  v = v / (fronbniusNorm_v * fronbniusNorm_v);
-
-  if (u > 0 && v > 0 && u < 1. && v < 1.) {
-    double i2, j2;
-    i2 = v * (Ig.getHeight() - 1);
-    j2 = u * (Ig.getWidth() - 1);
-    if (interp == BILINEAR_INTERPOLATION)
-      Ipixelplan = Ig.getValue(i2, j2);
-    else if (interp == SIMPLE)
-      Ipixelplan = Ig[(unsigned int)i2][(unsigned int)j2];
-    return true;
-  } else
-    return false;
-}
-
-bool vpImageSimulator::getPixel(vpImage<unsigned char> &Isrc, const vpImagePoint &iP, unsigned char &Ipixelplan)
-{
-  // test si pixel dans zone projetee
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP))
-  //    return false;
-
-  // methoed algebrique
-  double z;
-
-  // calcul de la profondeur de l'intersection
-  z = distance / (normal_Cam_optim[0] * iP.get_u() + normal_Cam_optim[1] * iP.get_v() + normal_Cam_optim[2]);
-  // calcul coordonnees 3D intersection
-  Xinter_optim[0] = iP.get_u() * z;
-  Xinter_optim[1] = iP.get_v() * z;
-  Xinter_optim[2] = z;
-
-  // recuperation des coordonnes de l'intersection dans le plan objet
-  // repere plan object :
-  //	centre = X0_2_optim[i] (premier point definissant le plan)
-  //	base =  u:(X[1]-X[0]) et v:(X[3]-X[0])
-  // ici j'ai considere que le plan est un rectangle => coordonnees sont
-  // simplement obtenu par un produit scalaire
-  double u = 0, v = 0;
-  for (unsigned int i = 0; i < 3; i++) {
-    double diff = (Xinter_optim[i] - X0_2_optim[i]);
-    u += diff * vbase_u_optim[i];
-    v += diff * vbase_v_optim[i];
-  }
-  u = u / (frobeniusNorm_u * frobeniusNorm_u);
-  v = v / (fronbniusNorm_v * fronbniusNorm_v);
-
-  if (u > 0 && v > 0 && u < 1. && v < 1.) {
-    double i2, j2;
-    i2 = v * (Isrc.getHeight() - 1);
-    j2 = u * (Isrc.getWidth() - 1);
-    if (interp == BILINEAR_INTERPOLATION)
-      Ipixelplan = Isrc.getValue(i2, j2);
-    else if (interp == SIMPLE)
-      Ipixelplan = Isrc[(unsigned int)i2][(unsigned int)j2];
-    return true;
-  } else
-    return false;
-}
-
-bool vpImageSimulator::getPixel(const vpImagePoint &iP, vpRGBa &Ipixelplan)
-{
-  // test si pixel dans zone projetee
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP))
-  //    return false;
-
-  // methoed algebrique
-  double z;
-
-  // calcul de la profondeur de l'intersection
-  z = distance / (normal_Cam_optim[0] * iP.get_u() + normal_Cam_optim[1] * iP.get_v() + normal_Cam_optim[2]);
-  // calcul coordonnees 3D intersection
-  Xinter_optim[0] = iP.get_u() * z;
-  Xinter_optim[1] = iP.get_v() * z;
-  Xinter_optim[2] = z;
-
-  // recuperation des coordonnes de l'intersection dans le plan objet
-  // repere plan object :
-  //	centre = X0_2_optim[i] (premier point definissant le plan)
-  //	base =  u:(X[1]-X[0]) et v:(X[3]-X[0])
-  // ici j'ai considere que le plan est un rectangle => coordonnees sont
-  // simplement obtenu par un produit scalaire
-  double u = 0, v = 0;
-  for (unsigned int i = 0; i < 3; i++) {
-    double diff = (Xinter_optim[i] - X0_2_optim[i]);
-    u += diff * vbase_u_optim[i];
-    v += diff * vbase_v_optim[i];
-  }
-  u = u / (frobeniusNorm_u * frobeniusNorm_u);
-  v = v / (fronbniusNorm_v * fronbniusNorm_v);
-
-  if (u > 0 && v > 0 && u < 1. && v < 1.) {
-    double i2, j2;
-    i2 = v * (Ic.getHeight() - 1);
-    j2 = u * (Ic.getWidth() - 1);
-    if (interp == BILINEAR_INTERPOLATION)
-      Ipixelplan = Ic.getValue(i2, j2);
-    else if (interp == SIMPLE)
-      Ipixelplan = Ic[(unsigned int)i2][(unsigned int)j2];
-    return true;
-  } else
-    return false;
-}
-
-bool vpImageSimulator::getPixel(vpImage<vpRGBa> &Isrc, const vpImagePoint &iP, vpRGBa &Ipixelplan)
-{
-  // test si pixel dans zone projetee
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP))
-  //    return false;
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-
-  // methoed algebrique
-  double z;
-
-  // calcul de la profondeur de l'intersection
-  z = distance / (normal_Cam_optim[0] * iP.get_u() + normal_Cam_optim[1] * iP.get_v() + normal_Cam_optim[2]);
-  // calcul coordonnees 3D intersection
-  Xinter_optim[0] = iP.get_u() * z;
-  Xinter_optim[1] = iP.get_v() * z;
-  Xinter_optim[2] = z;
-
-  // recuperation des coordonnes de l'intersection dans le plan objet
-  // repere plan object :
-  //	centre = X0_2_optim[i] (premier point definissant le plan)
-  //	base =  u:(X[1]-X[0]) et v:(X[3]-X[0])
-  // ici j'ai considere que le plan est un rectangle => coordonnees sont
-  // simplement obtenu par un produit scalaire
-  double u = 0, v = 0;
-  for (unsigned int i = 0; i < 3; i++) {
-    double diff = (Xinter_optim[i] - X0_2_optim[i]);
-    u += diff * vbase_u_optim[i];
-    v += diff * vbase_v_optim[i];
-  }
-  u = u / (frobeniusNorm_u * frobeniusNorm_u);
-  v = v / (fronbniusNorm_v * fronbniusNorm_v);
-
-  if (u > 0 && v > 0 && u < 1. && v < 1.) {
-    double i2, j2;
-    i2 = v * (Isrc.getHeight() - 1);
-    j2 = u * (Isrc.getWidth() - 1);
-    if (interp == BILINEAR_INTERPOLATION)
-      Ipixelplan = Isrc.getValue(i2, j2);
-    else if (interp == SIMPLE)
-      Ipixelplan = Isrc[(unsigned int)i2][(unsigned int)j2];
-    return true;
-  } else
-    return false;
-}
-
-bool vpImageSimulator::getPixelDepth(const vpImagePoint &iP, double &Zpixelplan)
-{
-  // test si pixel dans zone projetee
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP))
-  //    return false;
-
-  Zpixelplan = distance / (normal_Cam_optim[0] * iP.get_u() + normal_Cam_optim[1] * iP.get_v() + normal_Cam_optim[2]);
-  return true;
-}
-
 bool vpImageSimulator::getPixelVisibility(const vpImagePoint &iP, double &Visipixelplan)
 {
   // test si pixel dans zone projetee
@@ -1480,26 +1239,6 @@ bool vpImageSimulator::getPixelVisibility(const vpImagePoint &iP, double &Visipi
   return true;
 }
 
-void vpImageSimulator::project(const vpColVector &_vin, const vpHomogeneousMatrix &_cMt, vpColVector &_vout)
-{
-  vpColVector XH(4);
-  getHomogCoord(_vin, XH);
-  getCoordFromHomog(_cMt * XH, _vout);
-}
-
-void vpImageSimulator::getHomogCoord(const vpColVector &_v, vpColVector &_vH)
-{
-  for (unsigned int i = 0; i < 3; i++)
-    _vH[i] = _v[i];
-  _vH[3] = 1.;
-}
-
-void vpImageSimulator::getCoordFromHomog(const vpColVector &_vH, vpColVector &_v)
-{
-  for (unsigned int i = 0; i < 3; i++)
-    _v[i] = _vH[i] / _vH[3];
-}
-
 void vpImageSimulator::getRoi(const unsigned int &Iwidth, const unsigned int &Iheight, const vpCameraParameters &cam,
                               const std::vector<vpPoint> &point, vpRect &rectangle)
 {
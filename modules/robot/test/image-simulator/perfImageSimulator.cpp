@@ -0,0 +1,330 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark the image simulator.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfImageSimulator.cpp
+
+  \brief Check the images rendered by vpImageSimulator against the projection
+  of fronto-parallel planes, and benchmark the rendering of textured planes.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <cmath>
+#include <list>
+
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/robot/vpImageSimulator.h>
+
+namespace
+{
+
+bool runBenchmark = false;
+
+const double halfWidth = 0.2, halfHeight = 0.15;
+
+// Corners of a plane centered on the origin of its frame: top left, top right, bottom right, bottom left
+std::vector<vpPoint> getCorners()
+{
+  std::vector<vpPoint> X;
+  X.push_back(vpPoint(-halfWidth, -halfHeight, 0));
+  X.push_back(vpPoint(halfWidth, -halfHeight, 0));
+  X.push_back(vpPoint(halfWidth, halfHeight, 0));
+  X.push_back(vpPoint(-halfWidth, halfHeight, 0));
+  return X;
+}
+
+void generateTexture(vpImage<vpRGBa> &I)
+{
+  vpUniRand rng(1234);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I[i][j] = vpRGBa(static_cast<unsigned char>(i * 2 + j), static_cast<unsigned char>(rng.uniform(0, 256)),
+                       static_cast<unsigned char>(i ^ j));
+    }
+  }
+}
+
+// Texture coordinates of the pixel (i, j) in a fronto-parallel plane at depth Z
+void getTextureCoordinates(const vpCameraParameters &cam, double Z, unsigned int i, unsigned int j, double &u,
+                           double &v)
+{
+  const double X = Z * (j - cam.get_u0()) / cam.get_px();
+  const double Y = Z * (i - cam.get_v0()) / cam.get_py();
+  u = (X + halfWidth) / (2 * halfWidth);
+  v = (Y + halfHeight) / (2 * halfHeight);
+}
+
+} // namespace
+
+TEST_CASE("Render a fronto-parallel plane", "[vpImageSimulator]")
+{
+  const vpCameraParameters cam(600, 600, 320, 240);
+  const double Z = 1.;
+  vpImage<unsigned char> texture(120, 256);
+  for (unsigned int i = 0; i < texture.getHeight(); i++) {
+    for (unsigned int j = 0; j < texture.getWidth(); j++) {
+      texture[i][j] = static_cast<unsigned char>(j);
+    }
+  }
+  vpImageSimulator sim(vpImageSimulator::GRAY_SCALED);
+  sim.init(texture, getCorners());
+  sim.setCameraPosition(vpHomogeneousMatrix(0, 0, Z, 0, 0, 0));
+
+  SECTION("Nearest texel")
+  {
+    vpImage<unsigned char> I(480, 640, 0);
+    sim.getImage(I, cam);
+    unsigned int nbInside = 0, nbExpected = 0;
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        double u, v;
+        getTextureCoordinates(cam, Z, i, j, u, v);
+        // Skip the pixels on the border of the plane, where rounding decides
+        if (u < 1e-6 || v < 1e-6 || u > 1 - 1e-6 || v > 1 - 1e-6) {
+          continue;
+        }
+        if (u > 0 && v > 0 && u < 1 && v < 1) {
+          nbInside++;
+          // The texture is a ramp along the columns, the texel may differ when u is rounded to an integer column
+          const double j2 = u * (texture.getWidth() - 1);
+          const bool onTexelBorder = std::fabs(j2 - vpMath::round(j2)) < 1e-6;
+          if (I[i][j] == static_cast<unsigned int>(j2) || onTexelBorder) {
+            nbExpected++;
+          }
+        } else {
+          CHECK(I[i][j] == 0);
+        }
+      }
+    }
+    CHECK(nbInside > 0);
+    CHECK(nbExpected == nbInside);
+  }
+
+  SECTION("Bilinear interpolation")
+  {
+    sim.setInterpolationType(vpImageSimulator::BILINEAR_INTERPOLATION);
+    vpImage<unsigned char> I(480, 640, 0);
+    sim.getImage(I, cam);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        double u, v;
+        getTextureCoordinates(cam, Z, i, j, u, v);
+        if (u > 1e-6 && v > 1e-6 && u < 1 - 1e-6 && v < 1 - 1e-6) {
+          // The texture is a ramp along the columns
+          CHECK(std::fabs(I[i][j] - u * (texture.getWidth() - 1)) < 1.01);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Render a list of planes", "[vpImageSimulator]")
+{
+  const vpCameraParameters cam(600, 600, 320, 240);
+  vpImage<unsigned char> dark(60, 80, 50), bright(60, 80, 200);
+
+  // The bright plane is behind the dark one and shifted to the right
+  vpImageSimulator simDark(vpImageSimulator::GRAY_SCALED), simBright(vpImageSimulator::GRAY_SCALED);
+  simDark.init(dark, getCorners());
+  simDark.setCameraPosition(vpHomogeneousMatrix(0, 0, 1, 0, 0, 0));
+  simBright.init(bright, getCorners());
+  simBright.setCameraPosition(vpHomogeneousMatrix(0.2, 0, 1.5, 0, 0, 0));
+
+  std::list<vpImageSimulator> front, back;
+  front.push_back(simDark);
+  front.push_back(simBright);
+  back.push_back(simBright);
+  back.push_back(simDark);
+
+  vpImage<unsigned char> I1(480, 640, 10), I2(480, 640, 10);
+  vpImageSimulator::getImage(I1, front, cam);
+  vpImageSimulator::getImage(I2, back, cam);
+
+  // The order of the list doesn't matter
+  bool sameImage = (I1 == I2);
+  CHECK(sameImage);
+
+  // Dark plane only, overlap, bright plane only and background
+  CHECK(I1[240][250] == 50);
+  CHECK(I1[240][430] == 50);
+  CHECK(I1[240][460] == 200);
+  CHECK(I1[20][320] == 10);
+  CHECK(I1[240][20] == 10);
+  CHECK(I1[240][630] == 10);
+
+  // Same result as the planes drawn one after the other with a z-buffer
+  vpImage<unsigned char> I3(480, 640, 10);
+  vpMatrix zBuffer(480, 640, -1);
+  simBright.getImage(I3, cam, zBuffer);
+  simDark.getImage(I3, cam, zBuffer);
+  sameImage = (I1 == I3);
+  CHECK(sameImage);
+  CHECK(zBuffer[240][320] == Approx(1.));
+  CHECK(zBuffer[240][460] == Approx(1.5));
+  CHECK(zBuffer[20][320] < 0);
+
+  // Color output
+  vpImage<vpRGBa> Ic(480, 640, vpRGBa(10, 10, 10));
+  vpImageSimulator::getImage(Ic, front, cam);
+  unsigned int nbDifferences = 0;
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    const vpRGBa &c = Ic.bitmap[i];
+    if (c.R != I1.bitmap[i] || c.G != I1.bitmap[i] || c.B != I1.bitmap[i]) {
+      nbDifferences++;
+    }
+  }
+  CHECK(nbDifferences == 0);
+}
+
+TEST_CASE("Render with a given number of threads", "[vpImageSimulator]")
+{
+  const vpCameraParameters cam(600, 600, 320, 240);
+  vpImage<vpRGBa> texture(120, 160);
+  generateTexture(texture);
+
+  vpImageSimulator sim(vpImageSimulator::COLORED);
+  sim.init(texture, getCorners());
+  sim.setInterpolationType(vpImageSimulator::BILINEAR_INTERPOLATION);
+  sim.setCameraPosition(vpHomogeneousMatrix(0.02, -0.01, 0.8, vpMath::rad(10), vpMath::rad(-15), vpMath::rad(20)));
+  CHECK(sim.getNbThreads() == 0);
+
+  vpImage<vpRGBa> Iref(480, 640, vpRGBa(0)), I(480, 640, vpRGBa(0));
+  sim.getImage(Iref, cam);
+
+  std::list<vpImageSimulator> list;
+  list.push_back(sim);
+  vpImage<vpRGBa> IlistRef(480, 640, vpRGBa(0));
+  vpImageSimulator::getImage(IlistRef, list, cam);
+
+  const unsigned int nbThreads[] = {1, 2, 3};
+  for (size_t k = 0; k < sizeof(nbThreads) / sizeof(nbThreads[0]); k++) {
+    sim.setNbThreads(nbThreads[k]);
+    // The number of threads is copied with the simulator
+    vpImageSimulator copy(sim);
+    CHECK(copy.getNbThreads() == nbThreads[k]);
+
+    I = vpRGBa(0);
+    copy.getImage(I, cam);
+    bool sameImage = (I == Iref);
+    CHECK(sameImage);
+
+    I = vpRGBa(0);
+    vpImageSimulator::getImage(I, list, cam, nbThreads[k]);
+    sameImage = (I == IlistRef);
+    CHECK(sameImage);
+  }
+}
+
+TEST_CASE("Image simulator benchmark", "[benchmark]")
+{
+  if (runBenchmark) {
+    const vpCameraParameters cam(600, 600, 320, 240);
+    vpImage<vpRGBa> texture(480, 640);
+    generateTexture(texture);
+    vpImage<vpRGBa> I(480, 640);
+
+    vpImageSimulator sim(vpImageSimulator::COLORED);
+    sim.init(texture, getCorners());
+    sim.setCameraPosition(vpHomogeneousMatrix(0.02, -0.01, 0.5, vpMath::rad(10), vpMath::rad(-20), vpMath::rad(30)));
+    BENCHMARK("Plane covering the image")
+    {
+      sim.getImage(I, cam);
+      return I[240][320].R;
+    };
+    sim.setInterpolationType(vpImageSimulator::BILINEAR_INTERPOLATION);
+    BENCHMARK("Plane covering the image, bilinear interpolation")
+    {
+      sim.getImage(I, cam);
+      return I[240][320].R;
+    };
+
+    vpUniRand rng(1234);
+    std::list<vpImageSimulator> list;
+    for (unsigned int k = 0; k < 20; k++) {
+      vpImageSimulator plane(vpImageSimulator::COLORED);
+      plane.init(texture, getCorners());
+      plane.setInterpolationType(vpImageSimulator::BILINEAR_INTERPOLATION);
+      plane.setCameraPosition(vpHomogeneousMatrix(rng.uniform(-0.3, 0.3), rng.uniform(-0.2, 0.2),
+                                                  rng.uniform(0.6, 1.2), vpMath::rad(rng.uniform(-40, 40)),
+                                                  vpMath::rad(rng.uniform(-40, 40)), vpMath::rad(rng.uniform(-180, 180))));
+      list.push_back(plane);
+    }
+    BENCHMARK("20 overlapping planes, bilinear interpolation")
+    {
+      vpImageSimulator::getImage(I, list, cam);
+      return I[240][320].R;
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark of the image simulator"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
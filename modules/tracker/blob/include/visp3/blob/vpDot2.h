@@ -121,10 +121,15 @@
   A line by line explanation of this last example is also provided in
   \ref tutorial-tracking-blob, section \ref tracking_blob_tracking.
 
-  \sa vpDot
+  To track many dots in the same image, vpDot2Tracker updates all of them in
+  a single pass over their search windows.
+
+  \sa vpDot, vpDot2Tracker
 */
 class VISP_EXPORT vpDot2 : public vpTracker
 {
+  friend class vpDot2Tracker;
+
 public:
   vpDot2();
   explicit vpDot2(const vpImagePoint &ip);
@@ -428,6 +433,7 @@ private:
   bool findFirstBorder(const vpImage<unsigned char> &I, const unsigned int &u, const unsigned int &v,
                        unsigned int &border_u, unsigned int &border_v);
   void computeMeanGrayLevel(const vpImage<unsigned char> &I);
+  void updateGrayLevels();
 
   /*!
 
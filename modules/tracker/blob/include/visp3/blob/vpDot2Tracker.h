@@ -0,0 +1,180 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Track several dots in a single pass over the image.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpDot2Tracker.h
+  \brief Track several vpDot2 blobs in a single pass over their search windows.
+*/
+
+#ifndef vpDot2Tracker_hh
+#define vpDot2Tracker_hh
+
+#include <visp3/blob/vpDot2.h>
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+
+#include <vector>
+
+/*!
+  \class vpDot2Tracker
+
+  \ingroup module_blob
+
+  \brief Track a set of blobs described by vpDot2 in a single pass over the
+  union of their search windows.
+
+  Calling vpDot2::track() on each dot of a calibration grid or of a fiducial
+  target follows the border of every dot separately and, when a dot is lost,
+  scans its search window again. This class updates all the dots at once:
+
+  - The search window of each dot is centered on its previous center of
+    gravity and is setSearchWindowScale() times larger than the dot (80 by 80
+    pixels if the size of the dot is unknown), as in vpDot2::track().
+  - Dots that share the same gray level bounds and whose windows overlap are
+    gathered in a group. Each group binarizes the union of its windows once,
+    encodes it into runs of admissible pixels and labels the 8-connected runs.
+  - The moments of the connected components are accumulated from the runs in
+    closed form, without following the borders.
+  - Each dot takes the component that contains its previous center of gravity
+    if it passes vpDot2 validity tests. Otherwise, as vpDot2::track() does, it
+    takes the valid component of its window that is the closest to the window
+    center.
+  - The groups are independent and are tracked concurrently on the threads of
+    vpThreadPool::getGlobalInstance() when c++11 is available. The results do
+    not depend on the number of threads.
+
+  Contrary to vpDot2, the moments (vpDot2::m00, vpDot2::m10...) are computed
+  from the pixels of the blob rather than from the polygon that joins its
+  border pixels. The surface of a blob is thus larger by about half its
+  perimeter, and the center of gravity is the mean position of the pixels. The
+  list of edges is not computed: vpDot2::getEdges() returns an empty list once
+  a dot has been tracked by this class.
+
+  A lost dot does not throw an exception: it keeps its previous parameters and
+  isTracked() returns false until it is found again.
+
+  \code
+#include <visp3/blob/vpDot2Tracker.h>
+
+int main()
+{
+  vpImage<unsigned char> I;
+  // Acquire the first image and initialize the dots
+  vpDot2Tracker tracker;
+  for (size_t i = 0; i < ips.size(); i++) {
+    vpDot2 dot;
+    dot.initTracking(I, ips[i]);
+    tracker.addDot(dot);
+  }
+
+  while (1) {
+    // Acquire a new image in I
+    tracker.track(I);
+    for (unsigned int i = 0; i < tracker.getNbDots(); i++) {
+      if (tracker.isTracked(i)) {
+        vpImagePoint cog = tracker.getDot(i).getCog();
+      }
+    }
+  }
+}
+  \endcode
+
+  \sa vpDot2
+*/
+class VISP_EXPORT vpDot2Tracker
+{
+public:
+  vpDot2Tracker();
+  explicit vpDot2Tracker(const std::vector<vpDot2> &dots);
+
+  void addDot(const vpDot2 &dot);
+  void clear();
+
+  const vpDot2 &getDot(unsigned int i) const;
+  vpDot2 &getDot(unsigned int i);
+  /*!
+    Return the tracked dots.
+  */
+  const std::vector<vpDot2> &getDots() const { return m_dots; }
+  /*!
+    Return the number of dots.
+  */
+  unsigned int getNbDots() const { return static_cast<unsigned int>(m_dots.size()); }
+  /*!
+    Return the number of threads used to track the groups of dots.
+
+    \sa setNbThreads()
+  */
+  unsigned int getNbThreads() const { return m_nbThreads; }
+  /*!
+    Return the ratio between the size of the search window and the size of a
+    dot.
+
+    \sa setSearchWindowScale()
+  */
+  double getSearchWindowScale() const { return m_searchWindowScale; }
+
+  bool isTracked(unsigned int i) const;
+
+  /*!
+    Set the number of threads used to track the groups of dots.
+
+    \param nbThreads : Number of threads. 0 means all the threads of
+    vpThreadPool::getGlobalInstance(), 1 tracks the groups sequentially.
+    Default value is 0.
+  */
+  void setNbThreads(unsigned int nbThreads) { m_nbThreads = nbThreads; }
+  void setSearchWindowScale(double scale);
+
+  void track(const vpImage<unsigned char> &I);
+
+private:
+  //! Search window of a dot, bounds included
+  struct vpSearchWindow {
+    int u_min, u_max, v_min, v_max;
+  };
+
+  vpSearchWindow computeSearchWindow(const vpImage<unsigned char> &I, const vpDot2 &dot) const;
+  void trackGroup(const vpImage<unsigned char> &I, const std::vector<unsigned int> &group,
+                  const std::vector<vpSearchWindow> &windows);
+
+  std::vector<vpDot2> m_dots;
+  //! 1 if the corresponding dot was found in the last image
+  std::vector<unsigned char> m_tracked;
+  unsigned int m_nbThreads;
+  double m_searchWindowScale;
+};
+
+#endif
@@ -554,25 +554,8 @@ void vpDot2::track(const vpImage<unsigned char> &I, bool canMakeTheWindowGrow)
                               "The center of gravity of the dot is not in the image"));
   }
 
-  // Get dots center of gravity
-  // unsigned int u = (unsigned int) this->cog.get_u();
-  // unsigned int v = (unsigned int) this->cog.get_v();
   // Updates the min and max gray levels for the next iteration
-  // double Ip = pow((double)I[v][u]/255,1/gamma);
-  double Ip = pow(getMeanGrayLevel() / 255, 1 / gamma);
-  // printf("current value of gray level center : %i\n", I[v][u]);
-
-  // getMeanGrayLevel(I);
-  if (Ip - (1 - grayLevelPrecision) < 0) {
-    gray_level_min = 0;
-  } else {
-    gray_level_min = (unsigned int)(255 * pow(Ip - (1 - grayLevelPrecision), gamma));
-    if (gray_level_min > 255)
-      gray_level_min = 255;
-  }
-  gray_level_max = (unsigned int)(255 * pow(Ip + (1 - grayLevelPrecision), gamma));
-  if (gray_level_max > 255)
-    gray_level_max = 255;
+  updateGrayLevels();
 
   // printf("%i %i \n",gray_level_max,gray_level_min);
   if (graphics) {
@@ -2291,6 +2274,27 @@ void vpDot2::computeMeanGrayLevel(const vpImage<unsigned char> &I)
   }
 }
 
+/*!
+  Update the min and max gray levels of the dot around its mean gray level,
+  according to the gray level precision.
+
+  \sa setGrayLevelPrecision(), getMeanGrayLevel()
+*/
+void vpDot2::updateGrayLevels()
+{
+  double Ip = pow(getMeanGrayLevel() / 255, 1 / gamma);
+  if (Ip - (1 - grayLevelPrecision) < 0) {
+    gray_level_min = 0;
+  } else {
+    gray_level_min = (unsigned int)(255 * pow(Ip - (1 - grayLevelPrecision), gamma));
+    if (gray_level_min > 255)
+      gray_level_min = 255;
+  }
+  gray_level_max = (unsigned int)(255 * pow(Ip + (1 - grayLevelPrecision), gamma));
+  if (gray_level_max > 255)
+    gray_level_max = 255;
+}
+
 /*!
   Define a number of dots from a file.
   If the file does not exist, define it by clicking an image, the dots are
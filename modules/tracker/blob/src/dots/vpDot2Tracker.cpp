@@ -0,0 +1,560 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Track several dots in a single pass over the image.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpDot2Tracker.cpp
+  \brief Track several vpDot2 blobs in a single pass over their search windows.
+*/
+
+#include <visp3/blob/vpDot2Tracker.h>
+#include <visp3/core/vpDisplay.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/core/vpTrackingException.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+// Horizontal segment [u_begin, u_end] of the row v
+struct vpDotRun {
+  int v;
+  int u_begin;
+  int u_end;
+};
+
+// Connected component built from the runs
+struct vpDotComponent {
+  double m00, m10, m01, m11, m20, m02;
+  int u_min, u_max, v_min, v_max;
+  bool truncated; // true if it touches the border of the scanned region
+};
+
+bool compareRunBegin(const vpDotRun &a, const vpDotRun &b) { return a.u_begin < b.u_begin; }
+
+unsigned int findRoot(std::vector<unsigned int> &parent, unsigned int i)
+{
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+// The root of a set is its smallest element
+void unite(std::vector<unsigned int> &parent, unsigned int i, unsigned int j)
+{
+  unsigned int ri = findRoot(parent, i);
+  unsigned int rj = findRoot(parent, j);
+  if (ri < rj) {
+    parent[rj] = ri;
+  } else if (rj < ri) {
+    parent[ri] = rj;
+  }
+}
+
+// Sum of the squares of the integers from 0 to k
+double sumOfSquares(double k) { return k * (k + 1.) * (2. * k + 1.) / 6.; }
+
+// Check that the sorted disjoint spans cover [u_begin, u_end]
+bool isCovered(const std::vector<vpDotRun> &spans, unsigned int first, unsigned int last, int u_begin, int u_end)
+{
+  for (unsigned int s = first; s < last; s++) {
+    if (spans[s].u_begin <= u_begin && u_begin <= spans[s].u_end) {
+      return u_end <= spans[s].u_end;
+    }
+  }
+  return false;
+}
+
+void setMoments(vpDot2 &dot, const vpDotComponent &c)
+{
+  dot.m00 = c.m00;
+  dot.m10 = c.m10;
+  dot.m01 = c.m01;
+  dot.m11 = c.m11;
+  dot.m20 = c.m20;
+  dot.m02 = c.m02;
+
+  double u = c.m10 / c.m00;
+  double v = c.m01 / c.m00;
+  dot.mu11 = c.m11 - u * c.m01;
+  dot.mu02 = c.m02 - v * c.m01;
+  dot.mu20 = c.m20 - u * c.m10;
+
+  dot.setCog(vpImagePoint(v, u));
+  dot.setWidth(c.u_max - c.u_min + 1);
+  dot.setHeight(c.v_max - c.v_min + 1);
+  dot.setArea(c.m00);
+}
+}
+
+/*!
+  Default constructor.
+*/
+vpDot2Tracker::vpDot2Tracker() : m_dots(), m_tracked(), m_nbThreads(0), m_searchWindowScale(5.) {}
+
+/*!
+  Create a tracker for the given dots.
+
+  \param dots : Dots initialized with vpDot2::initTracking().
+*/
+vpDot2Tracker::vpDot2Tracker(const std::vector<vpDot2> &dots)
+  : m_dots(dots), m_tracked(dots.size(), 0), m_nbThreads(0), m_searchWindowScale(5.)
+{
+}
+
+/*!
+  Add a dot to track.
+
+  \param dot : Dot initialized with vpDot2::initTracking(). The tracker keeps
+  a copy of the dot, which can be retrieved with getDot().
+*/
+void vpDot2Tracker::addDot(const vpDot2 &dot)
+{
+  m_dots.push_back(dot);
+  m_tracked.push_back(0);
+}
+
+/*!
+  Remove all the dots.
+*/
+void vpDot2Tracker::clear()
+{
+  m_dots.clear();
+  m_tracked.clear();
+}
+
+/*!
+  Return the dot of index \e i.
+
+  \exception vpException::dimensionError : If \e i is not a valid index.
+*/
+const vpDot2 &vpDot2Tracker::getDot(unsigned int i) const
+{
+  if (i >= m_dots.size()) {
+    throw vpException(vpException::dimensionError, "Dot index %u out of range [0, %u[", i,
+                      static_cast<unsigned int>(m_dots.size()));
+  }
+  return m_dots[i];
+}
+
+/*!
+  Return the dot of index \e i, for instance to modify its tracking
+  parameters.
+
+  \exception vpException::dimensionError : If \e i is not a valid index.
+*/
+vpDot2 &vpDot2Tracker::getDot(unsigned int i)
+{
+  if (i >= m_dots.size()) {
+    throw vpException(vpException::dimensionError, "Dot index %u out of range [0, %u[", i,
+                      static_cast<unsigned int>(m_dots.size()));
+  }
+  return m_dots[i];
+}
+
+/*!
+  Return true if the dot of index \e i was found by the last call to track().
+
+  \exception vpException::dimensionError : If \e i is not a valid index.
+*/
+bool vpDot2Tracker::isTracked(unsigned int i) const
+{
+  if (i >= m_tracked.size()) {
+    throw vpException(vpException::dimensionError, "Dot index %u out of range [0, %u[", i,
+                      static_cast<unsigned int>(m_tracked.size()));
+  }
+  return m_tracked[i] != 0;
+}
+
+/*!
+  Set the ratio between the size of the search window of a dot and the size
+  of the dot. The window is centered on the previous center of gravity of the
+  dot.
+
+  \param scale : Ratio greater or equal to 1. Default value is 5, as in
+  vpDot2::track().
+
+  \exception vpException::badValue : If \e scale is lower than 1.
+*/
+void vpDot2Tracker::setSearchWindowScale(double scale)
+{
+  if (scale < 1.) {
+    throw vpException(vpException::badValue, "The search window scale %f should be greater or equal to 1", scale);
+  }
+  m_searchWindowScale = scale;
+}
+
+/*!
+  Return the search window of a dot, clipped to the image. The window is empty
+  if the dot is out of the image.
+*/
+vpDot2Tracker::vpSearchWindow vpDot2Tracker::computeSearchWindow(const vpImage<unsigned char> &I,
+                                                                 const vpDot2 &dot) const
+{
+  double w = 80., h = 80.;
+  if (std::fabs(dot.getWidth()) > std::numeric_limits<double>::epsilon() &&
+      std::fabs(dot.getHeight()) > std::numeric_limits<double>::epsilon()) {
+    w = dot.getWidth() * m_searchWindowScale;
+    h = dot.getHeight() * m_searchWindowScale;
+  }
+
+  vpImagePoint cog = dot.getCog();
+  int u = static_cast<int>(cog.get_u() - w / 2.0);
+  int v = static_cast<int>(cog.get_v() - h / 2.0);
+
+  vpSearchWindow window;
+  window.u_min = std::max(u, 0);
+  window.v_min = std::max(v, 0);
+  window.u_max = std::min(u + static_cast<int>(w) - 1, static_cast<int>(I.getWidth()) - 1);
+  window.v_max = std::min(v + static_cast<int>(h) - 1, static_cast<int>(I.getHeight()) - 1);
+  return window;
+}
+
+/*!
+  Track a group of dots sharing the same gray levels, from a single labeling
+  of the union of their search windows.
+
+  \param I : Image to process.
+  \param group : Indexes of the dots of the group.
+  \param windows : Search windows of all the dots.
+*/
+void vpDot2Tracker::trackGroup(const vpImage<unsigned char> &I, const std::vector<unsigned int> &group,
+                               const std::vector<vpSearchWindow> &windows)
+{
+  if (m_dots[group[0]].gray_level_max < m_dots[group[0]].gray_level_min) {
+    return;
+  }
+
+  // A pixel is admissible if gray_min <= I[v][u] <= gray_max, tested with a
+  // single unsigned comparison
+  const unsigned char gray_min = static_cast<unsigned char>(m_dots[group[0]].gray_level_min);
+  const unsigned char gray_range = static_cast<unsigned char>(m_dots[group[0]].gray_level_max - gray_min);
+  const int width = static_cast<int>(I.getWidth());
+  const int height = static_cast<int>(I.getHeight());
+
+  int v_min = height, v_max = -1;
+  for (size_t k = 0; k < group.size(); k++) {
+    v_min = std::min(v_min, windows[group[k]].v_min);
+    v_max = std::max(v_max, windows[group[k]].v_max);
+  }
+  const unsigned int nbRows = static_cast<unsigned int>(v_max - v_min + 1);
+
+  // Union of the windows, as sorted disjoint spans for each row
+  std::vector<vpDotRun> spans;
+  std::vector<unsigned int> spanBegin(nbRows + 1);
+  std::vector<vpDotRun> rowSpans;
+  for (unsigned int r = 0; r < nbRows; r++) {
+    int v = v_min + static_cast<int>(r);
+    spanBegin[r] = static_cast<unsigned int>(spans.size());
+    rowSpans.clear();
+    for (size_t k = 0; k < group.size(); k++) {
+      const vpSearchWindow &w = windows[group[k]];
+      if (v >= w.v_min && v <= w.v_max) {
+        vpDotRun span = {v, w.u_min, w.u_max};
+        rowSpans.push_back(span);
+      }
+    }
+    std::sort(rowSpans.begin(), rowSpans.end(), compareRunBegin);
+    for (size_t s = 0; s < rowSpans.size(); s++) {
+      if (spans.size() > spanBegin[r] && rowSpans[s].u_begin <= spans.back().u_end + 1) {
+        spans.back().u_end = std::max(spans.back().u_end, rowSpans[s].u_end);
+      } else {
+        spans.push_back(rowSpans[s]);
+      }
+    }
+  }
+  spanBegin[nbRows] = static_cast<unsigned int>(spans.size());
+
+  // Run-length encoding of the pixels with admissible gray levels
+  std::vector<vpDotRun> runs;
+  std::vector<bool> runTruncated;
+  std::vector<unsigned int> runBegin(nbRows + 1);
+  for (unsigned int r = 0; r < nbRows; r++) {
+    int v = v_min + static_cast<int>(r);
+    const unsigned char *row = I[static_cast<unsigned int>(v)];
+    runBegin[r] = static_cast<unsigned int>(runs.size());
+    for (unsigned int s = spanBegin[r]; s < spanBegin[r + 1]; s++) {
+      const vpDotRun &span = spans[s];
+      int u = span.u_begin;
+      while (u <= span.u_end) {
+        while (u <= span.u_end && static_cast<unsigned char>(row[u] - gray_min) > gray_range) {
+          u++;
+        }
+        if (u > span.u_end) {
+          break;
+        }
+        vpDotRun run;
+        run.v = v;
+        run.u_begin = u;
+        while (u <= span.u_end && static_cast<unsigned char>(row[u] - gray_min) <= gray_range) {
+          u++;
+        }
+        run.u_end = u - 1;
+
+        // A run ending on the border of the scanned region may continue
+        // outside, except on the image border
+        bool truncated = (run.u_begin == span.u_begin && run.u_begin > 0) ||
+                         (run.u_end == span.u_end && run.u_end < width - 1);
+        int u_begin = std::max(run.u_begin - 1, 0);
+        int u_end = std::min(run.u_end + 1, width - 1);
+        if (!truncated && v > 0) {
+          truncated = (r == 0) || !isCovered(spans, spanBegin[r - 1], spanBegin[r], u_begin, u_end);
+        }
+        if (!truncated && v < height - 1) {
+          truncated = (r == nbRows - 1) || !isCovered(spans, spanBegin[r + 1], spanBegin[r + 2], u_begin, u_end);
+        }
+        runs.push_back(run);
+        runTruncated.push_back(truncated);
+      }
+    }
+  }
+  runBegin[nbRows] = static_cast<unsigned int>(runs.size());
+
+  // 8-connected labeling of the runs
+  std::vector<unsigned int> parent(runs.size());
+  for (unsigned int i = 0; i < parent.size(); i++) {
+    parent[i] = i;
+  }
+  for (unsigned int r = 1; r < nbRows; r++) {
+    unsigned int j = runBegin[r - 1];
+    for (unsigned int i = runBegin[r]; i < runBegin[r + 1]; i++) {
+      while (j < runBegin[r] && runs[j].u_end + 1 < runs[i].u_begin) {
+        j++;
+      }
+      for (unsigned int k = j; k < runBegin[r] && runs[k].u_begin <= runs[i].u_end + 1; k++) {
+        unite(parent, k, i);
+      }
+    }
+  }
+
+  // Moments of the components, accumulated from the runs
+  std::vector<unsigned int> label(runs.size());
+  std::vector<vpDotComponent> components;
+  for (unsigned int i = 0; i < runs.size(); i++) {
+    unsigned int root = findRoot(parent, i);
+    if (root == i) {
+      vpDotComponent c = {0., 0., 0., 0., 0., 0., width, -1, height, -1, false};
+      label[i] = static_cast<unsigned int>(components.size());
+      components.push_back(c);
+    } else {
+      label[i] = label[root];
+    }
+
+    const vpDotRun &run = runs[i];
+    vpDotComponent &c = components[label[i]];
+    double n = run.u_end - run.u_begin + 1;
+    double su = 0.5 * (run.u_begin + run.u_end) * n;
+    double su2 = sumOfSquares(run.u_end) - sumOfSquares(run.u_begin - 1);
+    double v = run.v;
+    c.m00 += n;
+    c.m10 += su;
+    c.m01 += v * n;
+    c.m11 += v * su;
+    c.m20 += su2;
+    c.m02 += v * v * n;
+    c.u_min = std::min(c.u_min, run.u_begin);
+    c.u_max = std::max(c.u_max, run.u_end);
+    c.v_min = std::min(c.v_min, run.v);
+    c.v_max = std::max(c.v_max, run.v);
+    c.truncated = c.truncated || runTruncated[i];
+  }
+
+  for (size_t k = 0; k < group.size(); k++) {
+    const unsigned int i = group[k];
+    const vpDot2 &wantedDot = m_dots[i];
+    const vpSearchWindow &w = windows[i];
+    vpDot2 dot(wantedDot);
+    dot.graphics = false;
+    dot.direction_list.clear();
+    dot.ip_edges_list.clear();
+
+    // First try the component that contains the previous center of gravity
+    int found = -1;
+    int u = static_cast<int>(wantedDot.cog.get_u());
+    int v = static_cast<int>(wantedDot.cog.get_v());
+    int primary = -1;
+    if (v >= v_min && v <= v_max) {
+      unsigned int r = static_cast<unsigned int>(v - v_min);
+      for (unsigned int j = runBegin[r]; j < runBegin[r + 1]; j++) {
+        if (runs[j].u_begin <= u && u <= runs[j].u_end) {
+          primary = static_cast<int>(label[j]);
+          break;
+        }
+      }
+    }
+    if (primary >= 0 && !components[primary].truncated && components[primary].m00 > 1.) {
+      setMoments(dot, components[primary]);
+      dot.setArea(I);
+      if (dot.isValid(I, wantedDot)) {
+        found = primary;
+      }
+    }
+
+    // Otherwise take the valid component of the window the closest to its
+    // center
+    if (found < 0) {
+      double center_u = w.u_min + (w.u_max - w.u_min + 1) / 2.0 - 0.5;
+      double center_v = w.v_min + (w.v_max - w.v_min + 1) / 2.0 - 0.5;
+      double minDist = std::numeric_limits<double>::max();
+      for (unsigned int c = 0; c < components.size(); c++) {
+        const vpDotComponent &component = components[c];
+        if (static_cast<int>(c) == primary || component.truncated || component.m00 <= 1.) {
+          continue;
+        }
+        double cog_u = component.m10 / component.m00;
+        double cog_v = component.m01 / component.m00;
+        if (cog_u < w.u_min || cog_u > w.u_max || cog_v < w.v_min || cog_v > w.v_max) {
+          continue;
+        }
+        double dist = vpMath::sqr(cog_u - center_u) + vpMath::sqr(cog_v - center_v);
+        if (dist >= minDist) {
+          continue;
+        }
+        setMoments(dot, component);
+        dot.setArea(I, w.u_min, w.v_min, static_cast<unsigned int>(w.u_max - w.u_min + 1),
+                    static_cast<unsigned int>(w.v_max - w.v_min + 1));
+        if (dot.isValid(I, wantedDot)) {
+          found = static_cast<int>(c);
+          minDist = dist;
+        }
+      }
+    }
+
+    if (found < 0) {
+      continue;
+    }
+
+    const vpDotComponent &component = components[found];
+    setMoments(dot, component);
+    dot.bbox_u_min = component.u_min;
+    dot.bbox_u_max = component.u_max;
+    dot.bbox_v_min = component.v_min;
+    dot.bbox_v_max = component.v_max;
+    dot.setArea(I);
+    if (!dot.isInImage(I)) {
+      continue;
+    }
+    try {
+      dot.computeMeanGrayLevel(I);
+    } catch (const vpTrackingException &) {
+      continue;
+    }
+    dot.updateGrayLevels();
+    dot.graphics = wantedDot.graphics;
+
+    m_dots[i] = dot;
+    m_tracked[i] = 1;
+  }
+}
+
+/*!
+  Track all the dots in a new image.
+
+  The dots that are not found keep their previous parameters, and
+  isTracked() returns false for them.
+
+  \param I : Image to process.
+*/
+void vpDot2Tracker::track(const vpImage<unsigned char> &I)
+{
+  const unsigned int nbDots = getNbDots();
+  m_tracked.assign(nbDots, 0);
+
+  std::vector<vpSearchWindow> windows(nbDots);
+  std::vector<unsigned int> parent(nbDots);
+  for (unsigned int i = 0; i < nbDots; i++) {
+    windows[i] = computeSearchWindow(I, m_dots[i]);
+    parent[i] = i;
+  }
+
+  // Gather the dots whose windows overlap and that share the same gray levels
+  for (unsigned int i = 0; i < nbDots; i++) {
+    const vpSearchWindow &wi = windows[i];
+    if (wi.u_min > wi.u_max || wi.v_min > wi.v_max) {
+      continue;
+    }
+    for (unsigned int j = 0; j < i; j++) {
+      const vpSearchWindow &wj = windows[j];
+      if (wj.u_min > wj.u_max || wj.v_min > wj.v_max) {
+        continue;
+      }
+      if (m_dots[i].gray_level_min == m_dots[j].gray_level_min &&
+          m_dots[i].gray_level_max == m_dots[j].gray_level_max && wi.u_min <= wj.u_max && wj.u_min <= wi.u_max &&
+          wi.v_min <= wj.v_max && wj.v_min <= wi.v_max) {
+        unite(parent, i, j);
+      }
+    }
+  }
+
+  std::vector<std::vector<unsigned int> > groups;
+  std::vector<int> groupIndex(nbDots, -1);
+  for (unsigned int i = 0; i < nbDots; i++) {
+    const vpSearchWindow &wi = windows[i];
+    if (wi.u_min > wi.u_max || wi.v_min > wi.v_max) {
+      continue;
+    }
+    unsigned int root = findRoot(parent, i);
+    if (groupIndex[root] < 0) {
+      groupIndex[root] = static_cast<int>(groups.size());
+      groups.push_back(std::vector<unsigned int>());
+    }
+    groups[static_cast<size_t>(groupIndex[root])].push_back(i);
+  }
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(groups.size()),
+                                                [&](int start, int end) {
+                                                  for (int g = start; g < end; g++) {
+                                                    trackGroup(I, groups[static_cast<size_t>(g)], windows);
+                                                  }
+                                                },
+                                                m_nbThreads, 1);
+#else
+  for (size_t g = 0; g < groups.size(); g++) {
+    trackGroup(I, groups[g], windows);
+  }
+#endif
+
+  for (unsigned int i = 0; i < nbDots; i++) {
+    if (m_tracked[i] && m_dots[i].graphics) {
+      vpDisplay::displayCross(I, m_dots[i].cog, 3 * m_dots[i].thickness + 8, vpColor::red, m_dots[i].thickness);
+    }
+  }
+}
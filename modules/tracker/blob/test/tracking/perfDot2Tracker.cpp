@@ -0,0 +1,254 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark the tracking of many dots.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfDot2Tracker.cpp
+
+  \brief Compare the tracking of a grid of dots with vpDot2Tracker and with
+  independent vpDot2::track() calls.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/blob/vpDot2Tracker.h>
+
+namespace
+{
+
+bool runBenchmark = false;
+
+// Grid of white discs on a dark background, translated by (du, dv)
+void generateImage(vpImage<unsigned char> &I, unsigned int nbRows, unsigned int nbCols, double spacing,
+                   double radius, double du, double dv, std::vector<vpImagePoint> &centers, int missing = -1)
+{
+  I.resize(static_cast<unsigned int>((nbRows + 1) * spacing), static_cast<unsigned int>((nbCols + 1) * spacing), 30);
+  centers.clear();
+  for (unsigned int i = 0; i < nbRows; i++) {
+    for (unsigned int j = 0; j < nbCols; j++) {
+      vpImagePoint center((i + 1) * spacing + dv, (j + 1) * spacing + du);
+      if (static_cast<int>(centers.size()) != missing) {
+        for (int v = static_cast<int>(center.get_v() - radius) - 1; v <= center.get_v() + radius + 1; v++) {
+          for (int u = static_cast<int>(center.get_u() - radius) - 1; u <= center.get_u() + radius + 1; u++) {
+            if (vpMath::sqr(u - center.get_u()) + vpMath::sqr(v - center.get_v()) <= radius * radius) {
+              I[v][u] = 220;
+            }
+          }
+        }
+      }
+      centers.push_back(center);
+    }
+  }
+}
+
+std::vector<vpDot2> initDots(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &centers)
+{
+  std::vector<vpDot2> dots(centers.size());
+  for (size_t i = 0; i < centers.size(); i++) {
+    dots[i].initTracking(I, centers[i]);
+  }
+  return dots;
+}
+
+vpDot2Tracker trackDots(const std::vector<vpDot2> &dots, const vpImage<unsigned char> &I, unsigned int nbThreads,
+                        double scale = 5.)
+{
+  vpDot2Tracker tracker(dots);
+  tracker.setNbThreads(nbThreads);
+  tracker.setSearchWindowScale(scale);
+  tracker.track(I);
+  return tracker;
+}
+}
+
+TEST_CASE("vpDot2Tracker follows a translated grid of dots", "[vpDot2Tracker]")
+{
+  vpImage<unsigned char> I0, I1;
+  std::vector<vpImagePoint> centers0, centers1;
+  generateImage(I0, 8, 10, 40., 6.5, 0., 0., centers0);
+  generateImage(I1, 8, 10, 40., 6.5, 2.3, -1.7, centers1);
+  std::vector<vpDot2> dots = initDots(I0, centers0);
+
+  vpDot2Tracker tracker = trackDots(dots, I1, 0);
+  REQUIRE(tracker.getNbDots() == dots.size());
+  for (unsigned int i = 0; i < tracker.getNbDots(); i++) {
+    REQUIRE(tracker.isTracked(i));
+    vpDot2 dot(dots[i]);
+    dot.track(I1);
+    const vpDot2 &batchDot = tracker.getDot(i);
+    CHECK(vpImagePoint::distance(batchDot.getCog(), centers1[i]) < 0.15);
+    CHECK(vpImagePoint::distance(batchDot.getCog(), dot.getCog()) < 0.2);
+    CHECK(batchDot.getWidth() == dot.getWidth());
+    CHECK(batchDot.getHeight() == dot.getHeight());
+    CHECK(batchDot.getGrayLevelMin() == dot.getGrayLevelMin());
+    CHECK(batchDot.getGrayLevelMax() == dot.getGrayLevelMax());
+  }
+}
+
+TEST_CASE("vpDot2Tracker does not depend on the number of threads", "[vpDot2Tracker]")
+{
+  vpImage<unsigned char> I0, I1;
+  std::vector<vpImagePoint> centers0, centers1;
+  generateImage(I0, 8, 10, 40., 6.5, 0., 0., centers0);
+  generateImage(I1, 8, 10, 40., 6.5, 2.3, -1.7, centers1);
+  std::vector<vpDot2> dots = initDots(I0, centers0);
+
+  // With small windows, each dot is tracked in its own group
+  vpDot2Tracker reference = trackDots(dots, I1, 1, 2.);
+  for (unsigned int nbThreads = 2; nbThreads <= 4; nbThreads++) {
+    vpDot2Tracker tracker = trackDots(dots, I1, nbThreads, 2.);
+    for (unsigned int i = 0; i < tracker.getNbDots(); i++) {
+      REQUIRE(tracker.isTracked(i) == reference.isTracked(i));
+      CHECK(tracker.getDot(i).getCog() == reference.getDot(i).getCog());
+      CHECK(tracker.getDot(i).m00 == reference.getDot(i).m00);
+      CHECK(tracker.getDot(i).mu11 == reference.getDot(i).mu11);
+    }
+  }
+
+  // The grouping of the dots does not change the result
+  vpDot2Tracker merged = trackDots(dots, I1, 1, 5.);
+  for (unsigned int i = 0; i < merged.getNbDots(); i++) {
+    REQUIRE(merged.isTracked(i));
+    CHECK(merged.getDot(i).getCog() == reference.getDot(i).getCog());
+  }
+}
+
+TEST_CASE("vpDot2Tracker reports lost dots and finds moved dots", "[vpDot2Tracker]")
+{
+  vpImage<unsigned char> I0, I1;
+  std::vector<vpImagePoint> centers0, centers1;
+  generateImage(I0, 4, 5, 40., 6.5, 0., 0., centers0);
+
+  SECTION("Lost dot")
+  {
+    const int missing = 7;
+    generateImage(I1, 4, 5, 40., 6.5, 1., 1., centers1, missing);
+    std::vector<vpDot2> dots = initDots(I0, centers0);
+    vpDot2Tracker tracker = trackDots(dots, I1, 0);
+    for (unsigned int i = 0; i < tracker.getNbDots(); i++) {
+      CHECK(tracker.isTracked(i) == (static_cast<int>(i) != missing));
+    }
+    CHECK(tracker.getDot(missing).getCog() == dots[missing].getCog());
+  }
+
+  SECTION("Large motion")
+  {
+    // The previous center of gravity is out of the dots
+    generateImage(I1, 4, 5, 40., 6.5, 11., -9., centers1);
+    std::vector<vpDot2> dots = initDots(I0, centers0);
+    vpDot2Tracker tracker = trackDots(dots, I1, 0);
+    for (unsigned int i = 0; i < tracker.getNbDots(); i++) {
+      REQUIRE(tracker.isTracked(i));
+      CHECK(vpImagePoint::distance(tracker.getDot(i).getCog(), centers1[i]) < 0.1);
+    }
+  }
+}
+
+TEST_CASE("vpDot2Tracker benchmark", "[benchmark]")
+{
+  if (runBenchmark) {
+    vpImage<unsigned char> I0, I1;
+    std::vector<vpImagePoint> centers0, centers1;
+    generateImage(I0, 10, 20, 30., 5.5, 0., 0., centers0);
+    generateImage(I1, 10, 20, 30., 5.5, 1.6, -2.2, centers1);
+    std::vector<vpDot2> dots = initDots(I0, centers0);
+
+    BENCHMARK("vpDot2::track() - 200 dots")
+    {
+      std::vector<vpDot2> tracked(dots);
+      for (size_t i = 0; i < tracked.size(); i++) {
+        tracked[i].track(I1);
+      }
+      return tracked;
+    };
+
+    BENCHMARK("vpDot2Tracker - 200 dots - 1 thread") { return trackDots(dots, I1, 1); };
+
+    BENCHMARK("vpDot2Tracker - 200 dots - all threads") { return trackDots(dots, I1, 0); };
+
+    BENCHMARK("vpDot2Tracker - 200 dots - small windows - all threads") { return trackDots(dots, I1, 0, 2.); };
+
+    // Every dot moved more than its radius: vpDot2 searches them again
+    generateImage(I1, 10, 20, 30., 5.5, 7., 6., centers1);
+
+    BENCHMARK("vpDot2::track() - 200 moved dots")
+    {
+      std::vector<vpDot2> tracked(dots);
+      for (size_t i = 0; i < tracked.size(); i++) {
+        tracked[i].track(I1);
+      }
+      return tracked;
+    };
+
+    BENCHMARK("vpDot2Tracker - 200 moved dots - all threads") { return trackDots(dots, I1, 0); };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark comparing vpDot2::track() and vpDot2Tracker");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
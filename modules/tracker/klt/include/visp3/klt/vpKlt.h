@@ -0,0 +1,213 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Native pyramidal Lucas-Kanade feature tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpKlt.h
+
+  \brief Native KLT (Kanade-Lucas-Tomasi) feature tracker.
+*/
+
+#ifndef _vpKlt_h_
+#define _vpKlt_h_
+
+#include <vector>
+
+#include <visp3/core/vpColor.h>
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImagePoint.h>
+
+/*!
+  \class vpKlt
+
+  \ingroup module_klt
+
+  \brief KLT (Kanade-Lucas-Tomasi) feature tracker working directly on
+  vpImage, that does not require OpenCV.
+
+  The API follows the one of vpKltOpencv with vpImage and vpImagePoint
+  instead of the OpenCV types:
+  - initTracking() detects Shi-Tomasi corners, or Harris corners if
+  setUseHarris() is enabled. The corners are at least getMinDistance()
+  pixels apart, and their location is refined to subpixel accuracy by a
+  parabolic fit of the corner response.
+  - track() follows the features with the iterative pyramidal Lucas-Kanade
+  method. As in OpenCV, the windows are interpolated with fixed-point
+  bilinear weights and the iterations process 4 pixels at a time with SSE2.
+  The features are tracked in parallel on the threads of
+  vpThreadPool::getGlobalInstance().
+
+  The image pyramid of the last frame is kept between the calls. It becomes
+  the previous pyramid of the next track() call, and calling initTracking()
+  on the frame that was just tracked, to add new features, does not build it
+  again.
+
+  \code
+#include <visp3/klt/vpKlt.h>
+
+void trackFeatures(const std::vector<vpImage<unsigned char> > &frames)
+{
+  vpKlt tracker;
+  tracker.setMaxFeatures(200);
+  tracker.setWindowSize(10);
+  tracker.setQuality(0.01);
+  tracker.setMinDistance(15);
+  tracker.setPyramidLevels(3);
+
+  tracker.initTracking(frames[0]);
+  for (size_t i = 1; i < frames.size(); i++) {
+    tracker.track(frames[i]);
+  }
+}
+  \endcode
+*/
+class VISP_EXPORT vpKlt
+{
+public:
+  vpKlt();
+  virtual ~vpKlt();
+
+  void addFeature(const float &x, const float &y);
+  void addFeature(const long &id, const float &x, const float &y);
+  void addFeature(const vpImagePoint &ip);
+
+  void display(const vpImage<unsigned char> &I, const vpColor &color = vpColor::red, unsigned int thickness = 1);
+  void display(const vpImage<vpRGBa> &I, const vpColor &color = vpColor::red, unsigned int thickness = 1);
+
+  //! Get the size of the averaging block used by the corner detector.
+  int getBlockSize() const { return m_blockSize; }
+  //! Get the threshold used to stop the Lucas-Kanade iterations.
+  double getEpsilon() const { return m_epsilon; }
+  void getFeature(const int &index, long &id, float &x, float &y) const;
+  //! Get the list of current features.
+  std::vector<vpImagePoint> getFeatures() const { return m_points[1]; }
+  //! Get the unique id of each feature.
+  std::vector<long> getFeaturesId() const { return m_points_id; }
+  //! Get the free parameter of the Harris detector.
+  double getHarrisFreeParameter() const { return m_harris_k; }
+  //! Get the maximum number of features to track in the image.
+  int getMaxFeatures() const { return m_maxCount; }
+  //! Get the maximum number of Lucas-Kanade iterations per pyramid level.
+  int getMaxIterations() const { return m_maxIterations; }
+  //! Get the minimal Euclidean distance between detected corners during
+  //! initialization.
+  double getMinDistance() const { return m_minDistance; }
+  //! Get the minimal eigen value of the spatial gradient matrix under which
+  //! a feature is lost.
+  double getMinEigThreshold() const { return m_minEigThreshold; }
+  //! Get the number of threads used to track the features.
+  unsigned int getNbThreads() const { return m_nbThreads; }
+  //! Get the number of current features.
+  int getNbFeatures() const { return (int)m_points[1].size(); }
+  //! Get the number of previous features.
+  int getNbPrevFeatures() const { return (int)m_points[0].size(); }
+  //! Get the list of previous features.
+  std::vector<vpImagePoint> getPrevFeatures() const { return m_points[0]; }
+  //! Get the maximal pyramid level.
+  int getPyramidLevels() const { return m_pyrMaxLevel; }
+  //! Get the parameter characterizing the minimal accepted quality of image
+  //! corners.
+  double getQuality() const { return m_qualityLevel; }
+  //! Get the size of the window used to track the features.
+  int getWindowSize() const { return m_winSize; }
+
+  void initTracking(const vpImage<unsigned char> &I, const vpImage<bool> *mask = NULL);
+  void initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts);
+  void initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts,
+                    const std::vector<long> &ids);
+
+  void track(const vpImage<unsigned char> &I);
+
+  void setBlockSize(int blockSize);
+  void setHarrisFreeParameter(double harris_k);
+  void setInitialGuess(const std::vector<vpImagePoint> &guess_pts);
+  void setInitialGuess(const std::vector<vpImagePoint> &init_pts, const std::vector<vpImagePoint> &guess_pts,
+                       const std::vector<long> &fid);
+  void setMaxFeatures(int maxCount);
+  void setMinDistance(double minDistance);
+  void setMinEigThreshold(double minEigThreshold);
+  /*!
+    Set the number of threads used to track the features. If 0, all the
+    threads of vpThreadPool::getGlobalInstance() are used.
+  */
+  void setNbThreads(unsigned int nbThreads) { m_nbThreads = nbThreads; }
+  void setPyramidLevels(int pyrMaxLevel);
+  void setQuality(double qualityLevel);
+  void setTermCriteria(int maxIterations, double epsilon);
+  void setUseHarris(int useHarrisDetector);
+  void setWindowSize(int winSize);
+  void suppressFeature(const int &index);
+
+protected:
+  //! Gaussian pyramid of a frame, built level by level when needed.
+  struct Pyramid {
+    Pyramid() : levels(), derivatives(), nbLevels(0), nbDerivatives(0) {}
+
+    std::vector<vpImage<unsigned char> > levels;
+    //! Interleaved Scharr derivatives (dx, dy) of each level.
+    std::vector<std::vector<short> > derivatives;
+    //! Number of valid levels.
+    unsigned int nbLevels;
+    //! Number of levels whose derivatives are valid.
+    unsigned int nbDerivatives;
+  };
+
+  void buildPyramid(Pyramid &pyr, unsigned int nbLevels);
+  void computeDerivatives(Pyramid &pyr, unsigned int nbLevels);
+  void detectFeatures(const vpImage<bool> *mask);
+  unsigned int getNbPyramidLevels(const vpImage<unsigned char> &I) const;
+  void setCurrentImage(const vpImage<unsigned char> &I);
+
+  Pyramid m_pyramids[2];                 //!< Pyramids of the previous and current frames
+  unsigned int m_current;                //!< Index of the pyramid of the current frame
+  std::vector<vpImagePoint> m_points[2]; //!< Previous [0] and current [1] keypoint location
+  std::vector<long> m_points_id;         //!< Keypoint id
+  int m_maxCount;
+  int m_maxIterations;
+  double m_epsilon;
+  int m_winSize;
+  double m_qualityLevel;
+  double m_minDistance;
+  double m_minEigThreshold;
+  double m_harris_k;
+  int m_blockSize;
+  int m_useHarrisDetector;
+  int m_pyrMaxLevel;
+  long m_next_points_id;
+  bool m_initial_guess;
+  unsigned int m_nbThreads;
+};
+
+#endif
@@ -0,0 +1,1025 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Native pyramidal Lucas-Kanade feature tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpKlt.cpp
+
+  \brief Native KLT (Kanade-Lucas-Tomasi) feature tracker.
+*/
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpDisplay.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpTrackingException.h>
+#include <visp3/klt/vpKlt.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <visp3/core/vpThreadPool.h>
+#endif
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Fixed-point precision of the bilinear weights
+const int W_BITS = 14;
+// Scale of the sums of products of derivatives
+const float FLT_SCALE = 1.f / (1 << 20);
+
+inline int descale(int x, int n) { return (x + (1 << (n - 1))) >> n; }
+
+inline int clampIndex(int v, int size) { return v < 0 ? 0 : (v >= size ? size - 1 : v); }
+
+// Scharr derivatives of rows [start, end) of I, interleaved (dx, dy), with
+// replicated borders
+void computeScharrRows(const vpImage<unsigned char> &I, short *deriv, int start, int end)
+{
+  const int w = static_cast<int>(I.getWidth());
+  const int h = static_cast<int>(I.getHeight());
+  for (int y = start; y < end; y++) {
+    const unsigned char *r0 = I[clampIndex(y - 1, h)];
+    const unsigned char *r1 = I[y];
+    const unsigned char *r2 = I[clampIndex(y + 1, h)];
+    short *d = deriv + 2 * y * w;
+    for (int x = 0; x < w; x++) {
+      const int xm = clampIndex(x - 1, w);
+      const int xp = clampIndex(x + 1, w);
+      d[2 * x] = static_cast<short>(3 * (r0[xp] + r2[xp] - r0[xm] - r2[xm]) + 10 * (r1[xp] - r1[xm]));
+      d[2 * x + 1] = static_cast<short>(3 * (r2[xm] + r2[xp] - r0[xm] - r0[xp]) + 10 * (r2[x] - r0[x]));
+    }
+  }
+}
+
+// Corner response of rows [start, end) of I: minimal eigen value of the
+// gradient covariance summed over a block, or Harris response
+void computeCornerResponseRows(const vpImage<unsigned char> &I, int blockSize, bool useHarris, double harris_k,
+                               vpImage<float> &response, int start, int end)
+{
+  const int w = static_cast<int>(I.getWidth());
+  const int h = static_cast<int>(I.getHeight());
+  const int r = blockSize / 2;
+  std::vector<float> a(w), b(w), c(w);
+
+  for (int y = start; y < end; y++) {
+    float *R = response[y];
+    if (y < r + 1 || y >= h - r - 1) {
+      std::fill(R, R + w, 0.f);
+      continue;
+    }
+
+    // Sum of the gradient products over the rows of the block
+    std::fill(a.begin(), a.end(), 0.f);
+    std::fill(b.begin(), b.end(), 0.f);
+    std::fill(c.begin(), c.end(), 0.f);
+    for (int yy = y - r; yy <= y + r; yy++) {
+      const unsigned char *r0 = I[yy - 1];
+      const unsigned char *r1 = I[yy];
+      const unsigned char *r2 = I[yy + 1];
+      for (int x = 1; x < w - 1; x++) {
+        const float gx = static_cast<float>((r0[x + 1] + 2 * r1[x + 1] + r2[x + 1]) - (r0[x - 1] + 2 * r1[x - 1] + r2[x - 1]));
+        const float gy = static_cast<float>((r2[x - 1] + 2 * r2[x] + r2[x + 1]) - (r0[x - 1] + 2 * r0[x] + r0[x + 1]));
+        a[x] += gx * gx;
+        b[x] += gx * gy;
+        c[x] += gy * gy;
+      }
+    }
+
+    std::fill(R, R + w, 0.f);
+    for (int x = r + 1; x < w - r - 1; x++) {
+      float sa = 0, sb = 0, sc = 0;
+      for (int xx = x - r; xx <= x + r; xx++) {
+        sa += a[xx];
+        sb += b[xx];
+        sc += c[xx];
+      }
+      if (useHarris) {
+        R[x] = static_cast<float>(sa * sc - sb * sb - harris_k * (sa + sc) * (sa + sc));
+      } else {
+        R[x] = 0.5f * ((sa + sc) - std::sqrt((sa - sc) * (sa - sc) + 4.f * sb * sb));
+      }
+    }
+  }
+}
+
+struct Candidate {
+  float response;
+  int index;
+
+  bool operator<(const Candidate &other) const
+  {
+    return response > other.response || (response == other.response && index < other.index);
+  }
+};
+
+// Offset in [-0.5, 0.5] of the maximum of the parabola through 3 values
+inline float parabolaPeak(float left, float center, float right)
+{
+  const float den = left - 2.f * center + right;
+  if (den >= 0.f) {
+    return 0.f;
+  }
+  const float offset = 0.5f * (left - right) / den;
+  return std::max(-0.5f, std::min(0.5f, offset));
+}
+
+struct LKParameters {
+  int winSize;
+  int maxIterations;
+  float epsilon2;
+  float minEigThreshold;
+  bool useSSE2;
+};
+
+// Pyramidal Lucas-Kanade tracking of a single point. Iwin and dIwin are
+// buffers of winSize^2 and 2 winSize^2 values.
+bool trackPoint(const std::vector<vpImage<unsigned char> > &prevLevels,
+                const std::vector<std::vector<short> > &prevDerivatives,
+                const std::vector<vpImage<unsigned char> > &nextLevels, int nbLevels, const LKParameters &params,
+                float prevX, float prevY, float &nextX, float &nextY, short *Iwin, short *dIwin)
+{
+  const int winSize = params.winSize;
+  const float halfWin = (winSize - 1) * 0.5f;
+  bool status = true;
+
+  for (int level = nbLevels - 1; level >= 0; level--) {
+    const vpImage<unsigned char> &I = prevLevels[static_cast<size_t>(level)];
+    const vpImage<unsigned char> &J = nextLevels[static_cast<size_t>(level)];
+    const short *deriv = &prevDerivatives[static_cast<size_t>(level)][0];
+    const int w = static_cast<int>(I.getWidth());
+    const int h = static_cast<int>(I.getHeight());
+    const float scale = 1.f / (1 << level);
+
+    float px = prevX * scale - halfWin;
+    float py = prevY * scale - halfWin;
+    float nx, ny;
+    if (level == nbLevels - 1) {
+      nx = nextX * scale;
+      ny = nextY * scale;
+    } else {
+      nx = nextX * 2.f;
+      ny = nextY * 2.f;
+    }
+    nextX = nx;
+    nextY = ny;
+
+    int ix = static_cast<int>(std::floor(px));
+    int iy = static_cast<int>(std::floor(py));
+    if (ix < -winSize || ix >= w || iy < -winSize || iy >= h) {
+      if (level == 0) {
+        status = false;
+      }
+      continue;
+    }
+
+    float a = px - ix;
+    float b = py - iy;
+    int iw00 = vpMath::round((1.f - a) * (1.f - b) * (1 << W_BITS));
+    int iw01 = vpMath::round(a * (1.f - b) * (1 << W_BITS));
+    int iw10 = vpMath::round((1.f - a) * b * (1 << W_BITS));
+    int iw11 = (1 << W_BITS) - iw00 - iw01 - iw10;
+
+    // Window and derivatives of the previous image, and spatial gradient
+    // matrix
+    bool inside = ix >= 0 && iy >= 0 && ix + winSize < w && iy + winSize < h;
+    float iA11 = 0, iA12 = 0, iA22 = 0;
+    for (int y = 0; y < winSize; y++) {
+      const int y0 = inside ? iy + y : clampIndex(iy + y, h);
+      const int y1 = inside ? y0 + 1 : clampIndex(iy + y + 1, h);
+      for (int x = 0; x < winSize; x++) {
+        const int x0 = inside ? ix + x : clampIndex(ix + x, w);
+        const int x1 = inside ? x0 + 1 : clampIndex(ix + x + 1, w);
+        const int k = y * winSize + x;
+
+        Iwin[k] = static_cast<short>(
+            descale(I[y0][x0] * iw00 + I[y0][x1] * iw01 + I[y1][x0] * iw10 + I[y1][x1] * iw11, W_BITS - 5));
+
+        const short *d00 = deriv + 2 * (y0 * w + x0);
+        const short *d01 = deriv + 2 * (y0 * w + x1);
+        const short *d10 = deriv + 2 * (y1 * w + x0);
+        const short *d11 = deriv + 2 * (y1 * w + x1);
+        const int ixval = descale(d00[0] * iw00 + d01[0] * iw01 + d10[0] * iw10 + d11[0] * iw11, W_BITS);
+        const int iyval = descale(d00[1] * iw00 + d01[1] * iw01 + d10[1] * iw10 + d11[1] * iw11, W_BITS);
+        dIwin[2 * k] = static_cast<short>(ixval);
+        dIwin[2 * k + 1] = static_cast<short>(iyval);
+
+        iA11 += static_cast<float>(ixval * ixval);
+        iA12 += static_cast<float>(ixval * iyval);
+        iA22 += static_cast<float>(iyval * iyval);
+      }
+    }
+
+    const float A11 = iA11 * FLT_SCALE;
+    const float A12 = iA12 * FLT_SCALE;
+    const float A22 = iA22 * FLT_SCALE;
+    float D = A11 * A22 - A12 * A12;
+    const float minEig =
+        (A22 + A11 - std::sqrt((A11 - A22) * (A11 - A22) + 4.f * A12 * A12)) / (2 * winSize * winSize);
+
+    if (minEig < params.minEigThreshold || D < FLT_EPSILON) {
+      if (level == 0) {
+        status = false;
+      }
+      continue;
+    }
+    D = 1.f / D;
+
+    nx -= halfWin;
+    ny -= halfWin;
+    float prevDeltaX = 0, prevDeltaY = 0;
+
+    for (int j = 0; j < params.maxIterations; j++) {
+      const int jx = static_cast<int>(std::floor(nx));
+      const int jy = static_cast<int>(std::floor(ny));
+      if (jx < -winSize || jx >= w || jy < -winSize || jy >= h) {
+        if (level == 0) {
+          status = false;
+        }
+        break;
+      }
+
+      a = nx - jx;
+      b = ny - jy;
+      iw00 = vpMath::round((1.f - a) * (1.f - b) * (1 << W_BITS));
+      iw01 = vpMath::round(a * (1.f - b) * (1 << W_BITS));
+      iw10 = vpMath::round((1.f - a) * b * (1 << W_BITS));
+      iw11 = (1 << W_BITS) - iw00 - iw01 - iw10;
+
+      inside = jx >= 0 && jy >= 0 && jx + winSize < w && jy + winSize < h;
+      float ib1 = 0, ib2 = 0;
+      for (int y = 0; y < winSize; y++) {
+        const short *Iptr = Iwin + y * winSize;
+        const short *dIptr = dIwin + 2 * y * winSize;
+        int x = 0;
+
+        if (inside) {
+          const unsigned char *src = J[jy + y] + jx;
+          const unsigned char *src1 = src + w;
+#if VISP_HAVE_SSE2
+          if (params.useSSE2) {
+            const __m128i qw0 = _mm_set1_epi32((iw00 & 0xffff) | (iw01 << 16));
+            const __m128i qw1 = _mm_set1_epi32((iw10 & 0xffff) | (iw11 << 16));
+            const __m128i qdelta = _mm_set1_epi32(1 << (W_BITS - 5 - 1));
+            const __m128i z = _mm_setzero_si128();
+            __m128 qb = _mm_setzero_ps();
+
+            for (; x + 4 <= winSize; x += 4) {
+              int v00, v01, v10, v11;
+              memcpy(&v00, src + x, sizeof(int));
+              memcpy(&v01, src + x + 1, sizeof(int));
+              memcpy(&v10, src1 + x, sizeof(int));
+              memcpy(&v11, src1 + x + 1, sizeof(int));
+              const __m128i p00 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(v00), z);
+              const __m128i p01 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(v01), z);
+              const __m128i p10 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(v10), z);
+              const __m128i p11 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(v11), z);
+
+              __m128i t = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(p00, p01), qw0),
+                                        _mm_madd_epi16(_mm_unpacklo_epi16(p10, p11), qw1));
+              t = _mm_srai_epi32(_mm_add_epi32(t, qdelta), W_BITS - 5);
+
+              const __m128i Ival = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(Iptr + x));
+              const __m128i diff = _mm_sub_epi32(t, _mm_srai_epi32(_mm_unpacklo_epi16(Ival, Ival), 16));
+              const __m128i diff16 = _mm_packs_epi32(diff, diff);
+              const __m128i diff2 = _mm_unpacklo_epi16(diff16, diff16);
+              const __m128i dI = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dIptr + 2 * x));
+              const __m128i lo = _mm_mullo_epi16(diff2, dI);
+              const __m128i hi = _mm_mulhi_epi16(diff2, dI);
+              const __m128i prod = _mm_add_epi32(_mm_unpacklo_epi16(lo, hi), _mm_unpackhi_epi16(lo, hi));
+              qb = _mm_add_ps(qb, _mm_cvtepi32_ps(prod));
+            }
+
+            float buf[4];
+            _mm_storeu_ps(buf, qb);
+            ib1 += buf[0] + buf[2];
+            ib2 += buf[1] + buf[3];
+          }
+#endif
+          for (; x < winSize; x++) {
+            const int val = descale(src[x] * iw00 + src[x + 1] * iw01 + src1[x] * iw10 + src1[x + 1] * iw11,
+                                    W_BITS - 5);
+            const int diff = val - Iptr[x];
+            ib1 += static_cast<float>(diff * dIptr[2 * x]);
+            ib2 += static_cast<float>(diff * dIptr[2 * x + 1]);
+          }
+        } else {
+          const int y0 = clampIndex(jy + y, h);
+          const int y1 = clampIndex(jy + y + 1, h);
+          for (; x < winSize; x++) {
+            const int x0 = clampIndex(jx + x, w);
+            const int x1 = clampIndex(jx + x + 1, w);
+            const int val = descale(J[y0][x0] * iw00 + J[y0][x1] * iw01 + J[y1][x0] * iw10 + J[y1][x1] * iw11,
+                                    W_BITS - 5);
+            const int diff = val - Iptr[x];
+            ib1 += static_cast<float>(diff * dIptr[2 * x]);
+            ib2 += static_cast<float>(diff * dIptr[2 * x + 1]);
+          }
+        }
+      }
+
+      const float b1 = ib1 * FLT_SCALE;
+      const float b2 = ib2 * FLT_SCALE;
+      const float deltaX = (A12 * b2 - A22 * b1) * D;
+      const float deltaY = (A12 * b1 - A11 * b2) * D;
+
+      nx += deltaX;
+      ny += deltaY;
+      nextX = nx + halfWin;
+      nextY = ny + halfWin;
+
+      if (deltaX * deltaX + deltaY * deltaY <= params.epsilon2) {
+        break;
+      }
+
+      // Oscillation between two positions
+      if (j > 0 && std::fabs(deltaX + prevDeltaX) < 0.01f && std::fabs(deltaY + prevDeltaY) < 0.01f) {
+        nextX -= deltaX * 0.5f;
+        nextY -= deltaY * 0.5f;
+        break;
+      }
+      prevDeltaX = deltaX;
+      prevDeltaY = deltaY;
+    }
+  }
+
+  return status;
+}
+
+// Track the points [start, end)
+void trackPoints(const std::vector<vpImage<unsigned char> > &prevLevels,
+                 const std::vector<std::vector<short> > &prevDerivatives,
+                 const std::vector<vpImage<unsigned char> > &nextLevels, int nbLevels, const LKParameters &params,
+                 const std::vector<vpImagePoint> &prevPts, std::vector<vpImagePoint> &nextPts,
+                 std::vector<unsigned char> &status, int start, int end)
+{
+  std::vector<short> Iwin(static_cast<size_t>(params.winSize * params.winSize));
+  std::vector<short> dIwin(2 * Iwin.size());
+
+  for (int i = start; i < end; i++) {
+    float nextX = static_cast<float>(nextPts[static_cast<size_t>(i)].get_u());
+    float nextY = static_cast<float>(nextPts[static_cast<size_t>(i)].get_v());
+    status[static_cast<size_t>(i)] =
+        trackPoint(prevLevels, prevDerivatives, nextLevels, nbLevels, params,
+                   static_cast<float>(prevPts[static_cast<size_t>(i)].get_u()),
+                   static_cast<float>(prevPts[static_cast<size_t>(i)].get_v()), nextX, nextY, &Iwin[0], &dIwin[0])
+            ? 1
+            : 0;
+    nextPts[static_cast<size_t>(i)].set_uv(nextX, nextY);
+  }
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor.
+*/
+vpKlt::vpKlt()
+  : m_current(0), m_points_id(), m_maxCount(500), m_maxIterations(20), m_epsilon(0.03), m_winSize(10),
+    m_qualityLevel(0.01), m_minDistance(15), m_minEigThreshold(1e-4), m_harris_k(0.04), m_blockSize(3),
+    m_useHarrisDetector(0), m_pyrMaxLevel(3), m_next_points_id(0), m_initial_guess(false), m_nbThreads(0)
+{
+}
+
+vpKlt::~vpKlt() {}
+
+/*!
+  Number of pyramid levels used for an image: getPyramidLevels() + 1 levels,
+  as long as the window fits in the smallest one.
+*/
+unsigned int vpKlt::getNbPyramidLevels(const vpImage<unsigned char> &I) const
+{
+  unsigned int nbLevels = 1;
+  unsigned int w = I.getWidth(), h = I.getHeight();
+  for (int level = 1; level <= m_pyrMaxLevel; level++) {
+    w /= 2;
+    h /= 2;
+    if (w < static_cast<unsigned int>(m_winSize) || h < static_cast<unsigned int>(m_winSize)) {
+      break;
+    }
+    nbLevels++;
+  }
+  return nbLevels;
+}
+
+/*!
+  Make \e I the image of the current pyramid. Nothing is done if the current
+  pyramid was already built from the same image, so that the pyramid of a
+  frame that is tracked and then re-seeded is built once.
+*/
+void vpKlt::setCurrentImage(const vpImage<unsigned char> &I)
+{
+  Pyramid &pyr = m_pyramids[m_current];
+  if (pyr.nbLevels > 0 && pyr.levels[0].getHeight() == I.getHeight() && pyr.levels[0].getWidth() == I.getWidth() &&
+      (I.getSize() == 0 || memcmp(pyr.levels[0].bitmap, I.bitmap, I.getSize()) == 0)) {
+    return;
+  }
+
+  if (pyr.levels.empty()) {
+    pyr.levels.resize(1);
+  }
+  pyr.levels[0] = I;
+  pyr.nbLevels = 1;
+  pyr.nbDerivatives = 0;
+}
+
+/*!
+  Build the missing levels of the pyramid, up to \e nbLevels levels.
+*/
+void vpKlt::buildPyramid(Pyramid &pyr, unsigned int nbLevels)
+{
+  if (pyr.levels.size() < nbLevels) {
+    pyr.levels.resize(nbLevels);
+  }
+  for (; pyr.nbLevels < nbLevels; pyr.nbLevels++) {
+    vpImageFilter::getGaussPyramidal(pyr.levels[pyr.nbLevels - 1], pyr.levels[pyr.nbLevels]);
+  }
+}
+
+/*!
+  Compute the missing Scharr derivatives of the pyramid, up to \e nbLevels
+  levels that should already be built.
+*/
+void vpKlt::computeDerivatives(Pyramid &pyr, unsigned int nbLevels)
+{
+  if (pyr.derivatives.size() < nbLevels) {
+    pyr.derivatives.resize(nbLevels);
+  }
+  for (; pyr.nbDerivatives < nbLevels; pyr.nbDerivatives++) {
+    const vpImage<unsigned char> &I = pyr.levels[pyr.nbDerivatives];
+    std::vector<short> &deriv = pyr.derivatives[pyr.nbDerivatives];
+    deriv.resize(2 * static_cast<size_t>(I.getSize()) + 1);
+    short *d = &deriv[0];
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+    vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(I.getHeight()), [&I, d](int start, int end) {
+      computeScharrRows(I, d, start, end);
+    }, m_nbThreads);
+#else
+    computeScharrRows(I, d, 0, static_cast<int>(I.getHeight()));
+#endif
+  }
+}
+
+/*!
+  Detect corners in the image of the current pyramid and replace the
+  features by them.
+*/
+void vpKlt::detectFeatures(const vpImage<bool> *mask)
+{
+  const vpImage<unsigned char> &I = m_pyramids[m_current].levels[0];
+  const int w = static_cast<int>(I.getWidth());
+  const int h = static_cast<int>(I.getHeight());
+  if (mask != NULL && (mask->getWidth() != I.getWidth() || mask->getHeight() != I.getHeight())) {
+    throw vpTrackingException(vpTrackingException::initializationError,
+                              "The mask size (%dx%d) differs from the image size (%dx%d)", mask->getWidth(),
+                              mask->getHeight(), I.getWidth(), I.getHeight());
+  }
+
+  const int blockSize = std::max(1, m_blockSize);
+  const bool useHarris = m_useHarrisDetector != 0;
+  const double harris_k = m_harris_k;
+  vpImage<float> response(I.getHeight(), I.getWidth());
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, h, [&](int start, int end) {
+    computeCornerResponseRows(I, blockSize, useHarris, harris_k, response, start, end);
+  }, m_nbThreads);
+#else
+  computeCornerResponseRows(I, blockSize, useHarris, harris_k, response, 0, h);
+#endif
+
+  float maxResponse = 0;
+  for (unsigned int i = 0; i < response.getSize(); i++) {
+    maxResponse = std::max(maxResponse, response.bitmap[i]);
+  }
+  if (maxResponse <= 0) {
+    return;
+  }
+  const float threshold = static_cast<float>(m_qualityLevel * maxResponse);
+
+  // Local maxima of the response above the threshold
+  std::vector<Candidate> candidates;
+  for (int y = 1; y < h - 1; y++) {
+    const float *R0 = response[y - 1];
+    const float *R1 = response[y];
+    const float *R2 = response[y + 1];
+    for (int x = 1; x < w - 1; x++) {
+      const float val = R1[x];
+      if (val > threshold && val >= R1[x - 1] && val >= R1[x + 1] && val >= R0[x - 1] && val >= R0[x] &&
+          val >= R0[x + 1] && val >= R2[x - 1] && val >= R2[x] && val >= R2[x + 1] &&
+          (mask == NULL || (*mask)[y][x])) {
+        Candidate c;
+        c.response = val;
+        c.index = y * w + x;
+        candidates.push_back(c);
+      }
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  // Keep the strongest corners that are at least m_minDistance apart, using
+  // a grid of cells of that size
+  const double minDistance = std::max(m_minDistance, 0.0);
+  const int cellSize = std::max(1, static_cast<int>(std::ceil(minDistance)));
+  const int gridW = (w + cellSize - 1) / cellSize;
+  const int gridH = (h + cellSize - 1) / cellSize;
+  std::vector<std::vector<int> > grid(static_cast<size_t>(gridW * gridH));
+  const size_t maxCount = m_maxCount > 0 ? static_cast<size_t>(m_maxCount) : candidates.size();
+
+  std::vector<int> corners;
+  for (size_t i = 0; i < candidates.size() && corners.size() < maxCount; i++) {
+    const int x = candidates[i].index % w;
+    const int y = candidates[i].index / w;
+    const int cx = x / cellSize;
+    const int cy = y / cellSize;
+
+    bool keep = true;
+    if (minDistance >= 1) {
+      for (int gy = std::max(cy - 1, 0); gy <= std::min(cy + 1, gridH - 1) && keep; gy++) {
+        for (int gx = std::max(cx - 1, 0); gx <= std::min(cx + 1, gridW - 1) && keep; gx++) {
+          const std::vector<int> &cell = grid[static_cast<size_t>(gy * gridW + gx)];
+          for (size_t k = 0; k < cell.size(); k++) {
+            const int dx = cell[k] % w - x;
+            const int dy = cell[k] / w - y;
+            if (dx * dx + dy * dy < minDistance * minDistance) {
+              keep = false;
+              break;
+            }
+          }
+        }
+      }
+    }
+
+    if (keep) {
+      grid[static_cast<size_t>(cy * gridW + cx)].push_back(candidates[i].index);
+      corners.push_back(candidates[i].index);
+    }
+  }
+
+  // Subpixel location from a parabolic fit of the response
+  for (size_t i = 0; i < corners.size(); i++) {
+    const int x = corners[i] % w;
+    const int y = corners[i] / w;
+    const float dx = parabolaPeak(response[y][x - 1], response[y][x], response[y][x + 1]);
+    const float dy = parabolaPeak(response[y - 1][x], response[y][x], response[y + 1][x]);
+    m_points[1].push_back(vpImagePoint(y + dy, x + dx));
+    m_points_id.push_back(m_next_points_id++);
+  }
+}
+
+/*!
+  Initialise the tracking by extracting KLT keypoints on the provided image.
+
+  \param I : Grey level image used as input.
+  \param mask : Image mask used to restrict the keypoint detection area. If
+  mask is NULL, all the image will be considered.
+
+  \exception vpTrackingException::initializationError : If the mask size
+  differs from the image size.
+*/
+void vpKlt::initTracking(const vpImage<unsigned char> &I, const vpImage<bool> *mask)
+{
+  m_next_points_id = 0;
+  setCurrentImage(I);
+
+  for (size_t i = 0; i < 2; i++) {
+    m_points[i].clear();
+  }
+  m_points_id.clear();
+
+  detectFeatures(mask);
+}
+
+/*!
+  Set the points that will be used as initialization during the next call to
+  track().
+
+  \param I : Input image.
+  \param pts : Vector of points that should be tracked.
+*/
+void vpKlt::initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts)
+{
+  m_initial_guess = false;
+  m_points[1] = pts;
+  m_next_points_id = 0;
+  m_points_id.clear();
+  for (size_t i = 0; i < m_points[1].size(); i++) {
+    m_points_id.push_back(m_next_points_id++);
+  }
+
+  setCurrentImage(I);
+}
+
+/*!
+  Set the points that will be used as initialization during the next call to
+  track().
+
+  \param I : Input image.
+  \param pts : Vector of points that should be tracked.
+  \param ids : Corresponding point ids. If its size differs from the one of
+  \e pts, new ids are given to the points.
+*/
+void vpKlt::initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts,
+                         const std::vector<long> &ids)
+{
+  m_initial_guess = false;
+  m_points[1] = pts;
+  m_points_id.clear();
+
+  if (ids.size() != pts.size()) {
+    m_next_points_id = 0;
+    for (size_t i = 0; i < m_points[1].size(); i++)
+      m_points_id.push_back(m_next_points_id++);
+  } else {
+    long max = 0;
+    for (size_t i = 0; i < m_points[1].size(); i++) {
+      m_points_id.push_back(ids[i]);
+      if (ids[i] > max)
+        max = ids[i];
+    }
+    m_next_points_id = max + 1;
+  }
+
+  setCurrentImage(I);
+}
+
+/*!
+  Track KLT keypoints using the iterative Lucas-Kanade method with pyramids.
+  The features that are lost are removed.
+
+  \param I : Input image.
+*/
+void vpKlt::track(const vpImage<unsigned char> &I)
+{
+  if (m_points[1].size() == 0)
+    throw vpTrackingException(vpTrackingException::fatalError, "Not enough key points to track.");
+
+  if (m_pyramids[m_current].nbLevels == 0) {
+    // No previous frame
+    setCurrentImage(I);
+  }
+
+  Pyramid &prev = m_pyramids[m_current];
+  m_current = 1 - m_current;
+  setCurrentImage(I);
+  Pyramid &next = m_pyramids[m_current];
+
+  if (prev.levels[0].getWidth() != I.getWidth() || prev.levels[0].getHeight() != I.getHeight()) {
+    throw vpTrackingException(vpTrackingException::fatalError, "The image size changed during the tracking.");
+  }
+
+  const unsigned int nbLevels = getNbPyramidLevels(I);
+  buildPyramid(prev, nbLevels);
+  computeDerivatives(prev, nbLevels);
+  buildPyramid(next, nbLevels);
+
+  if (m_initial_guess) {
+    m_initial_guess = false;
+  } else {
+    std::swap(m_points[1], m_points[0]);
+    m_points[1] = m_points[0];
+  }
+
+  LKParameters params;
+  params.winSize = std::max(m_winSize, 2);
+  params.maxIterations = m_maxIterations;
+  params.epsilon2 = static_cast<float>(m_epsilon * m_epsilon);
+  params.minEigThreshold = static_cast<float>(m_minEigThreshold);
+#if VISP_HAVE_SSE2
+  params.useSSE2 = vpCPUFeatures::checkSSE2();
+#else
+  params.useSSE2 = false;
+#endif
+
+  const int nbPoints = static_cast<int>(m_points[0].size());
+  std::vector<unsigned char> status(static_cast<size_t>(nbPoints), 0);
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, nbPoints, [&](int start, int end) {
+    trackPoints(prev.levels, prev.derivatives, next.levels, static_cast<int>(nbLevels), params, m_points[0],
+                m_points[1], status, start, end);
+  }, m_nbThreads, 8);
+#else
+  trackPoints(prev.levels, prev.derivatives, next.levels, static_cast<int>(nbLevels), params, m_points[0],
+              m_points[1], status, 0, nbPoints);
+#endif
+
+  // Remove points that are lost
+  size_t nbKept = 0;
+  for (size_t i = 0; i < status.size(); i++) {
+    if (status[i]) {
+      m_points[0][nbKept] = m_points[0][i];
+      m_points[1][nbKept] = m_points[1][i];
+      m_points_id[nbKept] = m_points_id[i];
+      nbKept++;
+    }
+  }
+  m_points[0].resize(nbKept);
+  m_points[1].resize(nbKept);
+  m_points_id.resize(nbKept);
+}
+
+/*!
+  Get the 'index'th feature image coordinates. Beware that
+  getFeature(i,...) may not represent the same feature before and
+  after a tracking iteration (if a feature is lost, features are
+  shifted in the array).
+
+  \param index : Index of feature.
+  \param id : id of the feature.
+  \param x : x coordinate.
+  \param y : y coordinate.
+*/
+void vpKlt::getFeature(const int &index, long &id, float &x, float &y) const
+{
+  if ((size_t)index >= m_points[1].size()) {
+    throw(vpException(vpException::badValue, "Feature [%d] doesn't exist", index));
+  }
+
+  x = static_cast<float>(m_points[1][(size_t)index].get_u());
+  y = static_cast<float>(m_points[1][(size_t)index].get_v());
+  id = m_points_id[(size_t)index];
+}
+
+/*!
+  Display features position and id.
+
+  \param I : Image used as background. Display should be initialized on it.
+  \param color : Color used to display the features.
+  \param thickness : Thickness of the drawings.
+*/
+void vpKlt::display(const vpImage<unsigned char> &I, const vpColor &color, unsigned int thickness)
+{
+  for (size_t i = 0; i < m_points[1].size(); i++) {
+    vpImagePoint ip(vpMath::round(m_points[1][i].get_v()), vpMath::round(m_points[1][i].get_u()));
+    vpDisplay::displayCross(I, ip, 10, color, thickness);
+
+    std::ostringstream id;
+    id << m_points_id[i];
+    ip.set_u(vpMath::round(m_points[1][i].get_u() + 5));
+    vpDisplay::displayText(I, ip, id.str(), color);
+  }
+}
+
+/*!
+  Display features position and id.
+
+  \param I : Image used as background. Display should be initialized on it.
+  \param color : Color used to display the features.
+  \param thickness : Thickness of the drawings.
+*/
+void vpKlt::display(const vpImage<vpRGBa> &I, const vpColor &color, unsigned int thickness)
+{
+  for (size_t i = 0; i < m_points[1].size(); i++) {
+    vpImagePoint ip(vpMath::round(m_points[1][i].get_v()), vpMath::round(m_points[1][i].get_u()));
+    vpDisplay::displayCross(I, ip, 10, color, thickness);
+
+    std::ostringstream id;
+    id << m_points_id[i];
+    ip.set_u(vpMath::round(m_points[1][i].get_u() + 5));
+    vpDisplay::displayText(I, ip, id.str(), color);
+  }
+}
+
+/*!
+  Set the maximum number of features to track in the image.
+
+  \param maxCount : Maximum number of features to detect and track. Default
+  value is set to 500.
+*/
+void vpKlt::setMaxFeatures(int maxCount) { m_maxCount = maxCount; }
+
+/*!
+  Set the size of the window used to track the features.
+
+  \param winSize : Side length of the window in pixels. Default value is set
+  to 10.
+*/
+void vpKlt::setWindowSize(int winSize) { m_winSize = winSize; }
+
+/*!
+  Set the parameter characterizing the minimal accepted quality of image
+  corners.
+
+  \param qualityLevel : Quality level parameter. Default value is set to 0.01.
+  The parameter value is multiplied by the best corner quality measure, which
+  is the minimal eigenvalue or the Harris function response. The corners with
+  the quality measure less than the product are rejected.
+*/
+void vpKlt::setQuality(double qualityLevel) { m_qualityLevel = qualityLevel; }
+
+/*!
+  Set the free parameter of the Harris detector.
+
+  \param harris_k : Free parameter of the Harris detector. Default value is
+  set to 0.04.
+*/
+void vpKlt::setHarrisFreeParameter(double harris_k) { m_harris_k = harris_k; }
+
+/*!
+  Set the parameter indicating whether to use a Harris detector or
+  the minimal eigenvalue of gradient matrices for corner detection.
+
+  \param useHarrisDetector : If 1, use the Harris detector. If 0 (default
+  value), use the minimal eigenvalue (Shi-Tomasi).
+*/
+void vpKlt::setUseHarris(int useHarrisDetector) { m_useHarrisDetector = useHarrisDetector; }
+
+/*!
+  Set the minimal Euclidean distance between detected corners during
+  initialization.
+
+  \param minDistance : Minimal possible Euclidean distance between the
+  detected corners. Default value is set to 15.
+*/
+void vpKlt::setMinDistance(double minDistance) { m_minDistance = minDistance; }
+
+/*!
+  Set the minimal eigen value threshold used to reject a point during the
+  tracking. The eigen value of the spatial gradient matrix is divided by the
+  number of pixels of the window.
+
+  \param minEigThreshold : Minimal eigen value threshold. Default value is
+  set to 1e-4.
+*/
+void vpKlt::setMinEigThreshold(double minEigThreshold) { m_minEigThreshold = minEigThreshold; }
+
+/*!
+  Set the size of the averaging block used by the corner detector.
+
+  \param blockSize : Size of an average block for computing a derivative
+  covariation matrix over each pixel neighborhood. Default value is set to 3.
+*/
+void vpKlt::setBlockSize(int blockSize) { m_blockSize = blockSize; }
+
+/*!
+  Set the maximal pyramid level.
+
+  \param pyrMaxLevel : 0-based maximal pyramid level number; if set to 0,
+  pyramids are not used (single level), if set to 1, two levels are used, and
+  so on. Default value is set to 3.
+*/
+void vpKlt::setPyramidLevels(int pyrMaxLevel) { m_pyrMaxLevel = pyrMaxLevel; }
+
+/*!
+  Set the criteria used to stop the Lucas-Kanade iterations at each pyramid
+  level.
+
+  \param maxIterations : Maximum number of iterations. Default value is set
+  to 20.
+  \param epsilon : The iterations stop when the update of the feature
+  location is smaller than this value in pixels. Default value is set to 0.03.
+*/
+void vpKlt::setTermCriteria(int maxIterations, double epsilon)
+{
+  m_maxIterations = maxIterations;
+  m_epsilon = epsilon;
+}
+
+/*!
+  Set the points that will be used as initial guess during the next call to
+  track(). A typical usage of this function is to predict the position of the
+  features before the next call to track().
+
+  \param guess_pts : Vector of points that should be tracked. The size of this
+  vector should be the same as the one returned by getFeatures(). If this is
+  not the case, an exception is returned. Note also that the id of the points
+  is not modified.
+
+  \sa initTracking()
+*/
+void vpKlt::setInitialGuess(const std::vector<vpImagePoint> &guess_pts)
+{
+  if (guess_pts.size() != m_points[1].size()) {
+    throw(vpException(vpException::badValue,
+                      "Cannot set initial guess: size feature vector [%d] "
+                      "and guess vector [%d] doesn't match",
+                      m_points[1].size(), guess_pts.size()));
+  }
+
+  m_points[0] = m_points[1];
+  m_points[1] = guess_pts;
+  m_initial_guess = true;
+}
+
+/*!
+  Set the points that will be used as initial guess during the next call to
+  track().
+
+  \param init_pts : Initial points (could be obtained from getPrevFeatures()
+  or getFeatures()).
+  \param guess_pts : Prediction of the new position of the initial points.
+  The size of this vector must be the same as the size of the vector of
+  initial points.
+  \param fid : Identifiers of the initial points.
+*/
+void vpKlt::setInitialGuess(const std::vector<vpImagePoint> &init_pts, const std::vector<vpImagePoint> &guess_pts,
+                            const std::vector<long> &fid)
+{
+  if (guess_pts.size() != init_pts.size()) {
+    throw(vpException(vpException::badValue,
+                      "Cannot set initial guess: size init vector [%d] and "
+                      "guess vector [%d] doesn't match",
+                      init_pts.size(), guess_pts.size()));
+  }
+
+  m_points[0] = init_pts;
+  m_points[1] = guess_pts;
+  m_points_id = fid;
+  m_initial_guess = true;
+}
+
+/*!
+  Add a keypoint at the end of the feature list. The id of the feature is set
+  to ensure that it is unique.
+
+  \param x,y : Coordinates of the feature in the image.
+*/
+void vpKlt::addFeature(const float &x, const float &y)
+{
+  m_points[1].push_back(vpImagePoint(y, x));
+  m_points_id.push_back(m_next_points_id++);
+}
+
+/*!
+  Add a keypoint at the end of the feature list.
+
+  \warning This function doesn't ensure that the id of the feature is unique.
+  You should rather use addFeature(const float &, const float &) or
+  addFeature(const vpImagePoint &).
+
+  \param id : Feature id. Should be unique
+  \param x,y : Coordinates of the feature in the image.
+*/
+void vpKlt::addFeature(const long &id, const float &x, const float &y)
+{
+  m_points[1].push_back(vpImagePoint(y, x));
+  m_points_id.push_back(id);
+  if (id >= m_next_points_id)
+    m_next_points_id = id + 1;
+}
+
+/*!
+  Add a keypoint at the end of the feature list. The id of the feature is set
+  to ensure that it is unique.
+
+  \param ip : Coordinates of the feature in the image.
+*/
+void vpKlt::addFeature(const vpImagePoint &ip)
+{
+  m_points[1].push_back(ip);
+  m_points_id.push_back(m_next_points_id++);
+}
+
+/*!
+  Remove the feature with the given index as parameter.
+
+  \param index : Index of the feature to remove.
+*/
+void vpKlt::suppressFeature(const int &index)
+{
+  if ((size_t)index >= m_points[1].size()) {
+    throw(vpException(vpException::badValue, "Feature [%d] doesn't exist", index));
+  }
+
+  m_points[1].erase(m_points[1].begin() + index);
+  m_points_id.erase(m_points_id.begin() + index);
+}
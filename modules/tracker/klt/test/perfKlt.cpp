@@ -0,0 +1,296 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test and benchmark the native KLT tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfKlt.cpp
+
+  \brief Test the accuracy of the native KLT tracker on a synthetic
+  translation and benchmark the detection and the tracking.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include <visp3/core/vpTrackingException.h>
+#include <visp3/klt/vpKlt.h>
+
+namespace
+{
+
+bool runBenchmark = false;
+
+// The window of the features close to the border is partly outside of the
+// image at the coarse pyramid levels, where the translated content cannot be
+// recovered
+bool isInside(const vpImagePoint &ip, const vpImage<unsigned char> &I, double margin = 24)
+{
+  return ip.get_u() > margin && ip.get_v() > margin && ip.get_u() < I.getWidth() - margin &&
+         ip.get_v() < I.getHeight() - margin;
+}
+
+// Textured image translated by (tu, tv)
+void generateImage(vpImage<unsigned char> &I, unsigned int height, unsigned int width, double tu, double tv)
+{
+  I.resize(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      const double u = j - tu, v = i - tv;
+      const double val = 128 + 50 * std::sin(0.21 * u) * std::cos(0.17 * v) + 30 * std::sin(0.05 * u + 0.09 * v) +
+                         20 * std::cos(0.13 * u - 0.31 * v) + 30 * std::sin(0.03 * u) * std::cos(0.04 * v);
+      I[i][j] = static_cast<unsigned char>(vpMath::round(std::max(0.0, std::min(255.0, val))));
+    }
+  }
+}
+
+// Track the features of I0 in I1 and return the max error on the translation
+// of the features far from the border
+double trackTranslation(vpKlt &klt, const vpImage<unsigned char> &I0, const vpImage<unsigned char> &I1, double tu,
+                        double tv)
+{
+  klt.initTracking(I0);
+  const std::vector<vpImagePoint> init = klt.getFeatures();
+  const std::vector<long> initIds = klt.getFeaturesId();
+  klt.track(I1);
+  const std::vector<vpImagePoint> pts = klt.getFeatures();
+  const std::vector<long> ids = klt.getFeaturesId();
+
+  double maxError = 0;
+  for (size_t i = 0; i < pts.size(); i++) {
+    const vpImagePoint &ip0 = init[static_cast<size_t>(ids[i] - initIds[0])];
+    if (!isInside(ip0, I0)) {
+      continue;
+    }
+    const double error = std::max(std::fabs(pts[i].get_u() - ip0.get_u() - tu), std::fabs(pts[i].get_v() - ip0.get_v() - tv));
+    maxError = std::max(maxError, error);
+  }
+  return maxError;
+}
+}
+
+TEST_CASE("KLT detection", "[klt]")
+{
+  vpImage<unsigned char> I;
+  generateImage(I, 240, 320, 0, 0);
+
+  vpKlt klt;
+  klt.setMaxFeatures(200);
+  klt.setMinDistance(10);
+
+  SECTION("Minimal distance")
+  {
+    klt.initTracking(I);
+    const std::vector<vpImagePoint> pts = klt.getFeatures();
+    CHECK(pts.size() > 50);
+    CHECK(pts.size() <= 200);
+    for (size_t i = 0; i < pts.size(); i++) {
+      for (size_t j = i + 1; j < pts.size(); j++) {
+        CHECK(vpImagePoint::distance(pts[i], pts[j]) > 9);
+      }
+    }
+  }
+
+  SECTION("Mask")
+  {
+    vpImage<bool> mask(I.getHeight(), I.getWidth(), false);
+    for (unsigned int i = 60; i < 180; i++) {
+      for (unsigned int j = 80; j < 240; j++) {
+        mask[i][j] = true;
+      }
+    }
+    klt.initTracking(I, &mask);
+    const std::vector<vpImagePoint> pts = klt.getFeatures();
+    CHECK(pts.size() > 0);
+    for (size_t i = 0; i < pts.size(); i++) {
+      CHECK(pts[i].get_i() > 59);
+      CHECK(pts[i].get_i() < 180);
+      CHECK(pts[i].get_j() > 79);
+      CHECK(pts[i].get_j() < 240);
+    }
+  }
+}
+
+TEST_CASE("KLT tracking of a translation", "[klt]")
+{
+  const double tu = 3.4, tv = -2.7;
+  vpImage<unsigned char> I0, I1;
+  generateImage(I0, 240, 320, 0, 0);
+  generateImage(I1, 240, 320, tu, tv);
+
+  vpKlt klt;
+  klt.setMaxFeatures(200);
+  klt.setMinDistance(10);
+  klt.setTermCriteria(30, 0.01);
+  const double maxError = trackTranslation(klt, I0, I1, tu, tv);
+  CHECK(klt.getNbFeatures() > 50);
+  CHECK(maxError < 0.15);
+
+  SECTION("Same result whatever the number of threads")
+  {
+    klt.setNbThreads(1);
+    trackTranslation(klt, I0, I1, tu, tv);
+    const std::vector<vpImagePoint> ref = klt.getFeatures();
+
+    klt.setNbThreads(4);
+    trackTranslation(klt, I0, I1, tu, tv);
+    const std::vector<vpImagePoint> pts = klt.getFeatures();
+    REQUIRE(pts.size() == ref.size());
+    for (size_t i = 0; i < pts.size(); i++) {
+      CHECK(pts[i] == ref[i]);
+    }
+  }
+
+  SECTION("Re-seed the features after tracking")
+  {
+    const std::vector<vpImagePoint> prev = klt.getPrevFeatures();
+    const std::vector<vpImagePoint> pts = klt.getFeatures();
+    const std::vector<long> ids = klt.getFeaturesId();
+    klt.initTracking(I1, pts, ids);
+    klt.track(I0);
+    const std::vector<vpImagePoint> back = klt.getFeatures();
+    const std::vector<long> backIds = klt.getFeaturesId();
+    CHECK(back.size() > 50);
+    for (size_t i = 0, j = 0; i < back.size(); i++) {
+      while (ids[j] != backIds[i]) {
+        j++;
+      }
+      if (isInside(prev[j], I0)) {
+        CHECK(std::fabs(back[i].get_u() - prev[j].get_u()) < 0.15);
+        CHECK(std::fabs(back[i].get_v() - prev[j].get_v()) < 0.15);
+      }
+    }
+  }
+
+  SECTION("Initial guess")
+  {
+    klt.initTracking(I0);
+    std::vector<vpImagePoint> guess = klt.getFeatures();
+    for (size_t i = 0; i < guess.size(); i++) {
+      guess[i] += vpImagePoint(tv, tu);
+    }
+    klt.setPyramidLevels(0);
+    klt.setInitialGuess(guess);
+    klt.track(I1);
+    const std::vector<vpImagePoint> prev = klt.getPrevFeatures();
+    const std::vector<vpImagePoint> pts = klt.getFeatures();
+    CHECK(pts.size() > 50);
+    for (size_t i = 0; i < pts.size(); i++) {
+      if (isInside(prev[i], I0)) {
+        CHECK(std::fabs(pts[i].get_u() - prev[i].get_u() - tu) < 0.15);
+        CHECK(std::fabs(pts[i].get_v() - prev[i].get_v() - tv) < 0.15);
+      }
+    }
+  }
+
+  SECTION("No feature to track")
+  {
+    vpKlt empty;
+    CHECK_THROWS_AS(empty.track(I0), vpTrackingException);
+  }
+}
+
+TEST_CASE("KLT benchmark", "[benchmark]")
+{
+  if (runBenchmark) {
+    vpImage<unsigned char> I0, I1;
+    generateImage(I0, 480, 640, 0, 0);
+    generateImage(I1, 480, 640, 1.3, 0.8);
+
+    vpKlt klt;
+    klt.setMaxFeatures(1000);
+    klt.setMinDistance(5);
+
+    BENCHMARK("Detection")
+    {
+      klt.initTracking(I0);
+      return klt.getNbFeatures();
+    };
+
+    const std::vector<vpImagePoint> pts = klt.getFeatures();
+    BENCHMARK("Tracking")
+    {
+      klt.initTracking(I0, pts);
+      klt.track(I1);
+      return klt.getNbFeatures();
+    };
+
+    klt.setNbThreads(1);
+    BENCHMARK("Tracking - 1 thread")
+    {
+      klt.initTracking(I0, pts);
+      klt.track(I1);
+      return klt.getNbFeatures();
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli() // Get Catch's composite command line parser
+             | Opt(runBenchmark) // bind variable to a new option, with a hint string
+                   ["--benchmark"] // the option names it will respond to
+             ("run benchmark of the KLT detection and tracking"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
@@ -117,6 +117,7 @@ public:
   virtual void track(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud);
 #endif
   virtual void track(const std::vector<vpColVector> &point_cloud, unsigned int width, unsigned int height);
+  virtual void track(const vpPointCloud &point_cloud);
 
 protected:
   //! Set of faces describing the object used only for display with scan line.
@@ -171,5 +172,10 @@ protected:
 #endif
   void segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
                          unsigned int height);
+  void segmentPointCloud(const vpPointCloud &point_cloud);
+
+private:
+  template <class PointCloud>
+  void segmentPointCloudFaces(const PointCloud &point_cloud, unsigned int width, unsigned int height);
 };
 #endif
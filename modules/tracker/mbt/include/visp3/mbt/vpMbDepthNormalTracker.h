@@ -120,6 +120,7 @@ public:
   virtual void track(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud);
 #endif
   virtual void track(const std::vector<vpColVector> &point_cloud, unsigned int width, unsigned int height);
+  virtual void track(const vpPointCloud &point_cloud);
 
 protected:
   //! Method to estimate the desired features
@@ -186,5 +187,10 @@ protected:
 #endif
   void segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
                          unsigned int height);
+  void segmentPointCloud(const vpPointCloud &point_cloud);
+
+private:
+  template <class PointCloud>
+  void segmentPointCloudFaces(const PointCloud &point_cloud, unsigned int width, unsigned int height);
 };
 #endif
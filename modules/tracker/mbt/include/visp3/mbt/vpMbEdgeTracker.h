@@ -328,6 +328,8 @@ protected:
   vpRobust m_robust_edge;
   //! Display features
   std::vector<std::vector<double> > m_featuresToBeDisplayedEdge;
+  //! Number of threads used to track the moving edges of the lines
+  unsigned int m_nbThreads;
 
 public:
   vpMbEdgeTracker();
@@ -366,6 +368,13 @@ public:
 
   virtual unsigned int getNbPoints(unsigned int level = 0) const;
 
+  /*!
+    Return the number of threads used to track the moving edges of the lines.
+
+    \sa setNbThreads()
+  */
+  inline unsigned int getNbThreads() const { return m_nbThreads; }
+
   /*!
     Return the scales levels used for the tracking.
 
@@ -478,6 +487,17 @@ public:
 
   void setMovingEdge(const vpMe &me);
 
+  /*!
+    Set the number of threads used to track the moving edges of the lines,
+    which are processed concurrently with vpThreadPool::getGlobalInstance()
+    when c++11 is available. The tracking results do not depend on this
+    number.
+
+    \param nbThreads : Number of threads. 0 means all the threads of the
+    pool, 1 tracks the lines sequentially. Default value is 0.
+  */
+  inline void setNbThreads(unsigned int nbThreads) { m_nbThreads = nbThreads; }
+
   virtual void setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cdMo);
   virtual void setPose(const vpImage<vpRGBa> &I_color, const vpHomogeneousMatrix &cdMo);
 
@@ -201,6 +201,15 @@ public:
   virtual unsigned int getNbPolygon() const;
   virtual void getNbPolygon(std::map<std::string, unsigned int> &mapOfNbPolygons) const;
 
+  /*!
+    Return the number of threads used to process the cameras concurrently.
+    0 means that all the threads of vpThreadPool::getGlobalInstance() are
+    used.
+
+    \sa setNbThreads()
+  */
+  virtual inline unsigned int getNbThreads() const { return m_nbThreads; }
+
   virtual vpMbtPolygon *getPolygon(unsigned int index);
   virtual vpMbtPolygon *getPolygon(const std::string &cameraName, unsigned int index);
 
@@ -220,6 +229,16 @@ public:
 
   virtual inline vpColVector getRobustWeights() const { return m_w; }
 
+  /*!
+    Return the time in ms spent in each stage of the last call to track().
+    Keys are \e "preTracking", \e "computeVVSInit",
+    \e "computeVVSInteractionMatrixAndResidu", \e "computeVVSWeights",
+    \e "computeVVSPoseEstimation", \e "computeVVS" and \e "postTracking".
+    Times of the stages called at each virtual visual servoing iteration are
+    accumulated over all the iterations.
+  */
+  virtual inline std::map<std::string, double> getStageTimes() const { return m_mapOfStageTimes; }
+
   virtual int getTrackerType() const;
 
   virtual void init(const vpImage<unsigned char> &I);
@@ -386,6 +405,8 @@ public:
   virtual void setMovingEdge(const vpMe &me1, const vpMe &me2);
   virtual void setMovingEdge(const std::map<std::string, vpMe> &mapOfMe);
 
+  virtual void setNbThreads(unsigned int nbThreads);
+
   virtual void setNearClippingDistance(const double &dist);
   virtual void setNearClippingDistance(const double &dist1, const double &dist2);
   virtual void setNearClippingDistance(const std::map<std::string, double> &mapOfDists);
@@ -455,6 +476,11 @@ public:
                      std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                      std::map<std::string, unsigned int> &mapOfPointCloudHeights);
 
+  virtual void track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                     std::map<std::string, const vpPointCloud *> &mapOfPointClouds);
+  virtual void track(std::map<std::string, const vpImage<vpRGBa> *> &mapOfColorImages,
+                     std::map<std::string, const vpPointCloud *> &mapOfPointClouds);
+
 protected:
   virtual void computeProjectionError();
 
@@ -478,6 +504,14 @@ protected:
 
   virtual void initFaceFromLines(vpMbtPolygon &polygon);
 
+#ifdef VISP_HAVE_PCL
+  virtual void postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                            std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds);
+#endif
+  virtual void postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                            std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                            std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+
 #ifdef VISP_HAVE_PCL
   virtual void preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
                            std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds);
@@ -486,6 +520,8 @@ protected:
                            std::map<std::string, const std::vector<vpColVector> *> &mapOfPointClouds,
                            std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                            std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+  virtual void preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                           std::map<std::string, const vpPointCloud *> &mapOfPointClouds);
 
 private:
   class TrackerWrapper : public vpMbEdgeTracker,
@@ -612,6 +648,7 @@ private:
     virtual void preTracking(const vpImage<unsigned char> *const ptr_I = NULL,
                              const std::vector<vpColVector> *const point_cloud = NULL,
                              const unsigned int pointcloud_width = 0, const unsigned int pointcloud_height = 0);
+    virtual void preTracking(const vpImage<unsigned char> *const ptr_I, const vpPointCloud *const point_cloud);
 
     virtual void reInitModel(const vpImage<unsigned char> * const I, const vpImage<vpRGBa> * const I_color,
                              const std::string &cad_name, const vpHomogeneousMatrix &cMo, bool verbose = false,
@@ -629,6 +666,72 @@ private:
                          const vpHomogeneousMatrix &cdMo);
   };
 
+  //! Per camera stages of the tracking that can be processed concurrently
+  enum vpCameraStage {
+    PRE_TRACKING_STAGE,
+    PRE_TRACKING_PCL_STAGE,
+    PRE_TRACKING_CONTIGUOUS_STAGE,
+    VVS_INIT_STAGE,
+    VVS_INTERACTION_MATRIX_AND_RESIDU_STAGE,
+    VVS_WEIGHTS_STAGE,
+    VVS_NORMAL_EQUATIONS_STAGE,
+    POST_TRACKING_STAGE,
+    POST_TRACKING_PCL_STAGE
+  };
+
+  //! Inputs and outputs of a per camera stage
+  struct CameraData {
+    CameraData()
+      : tracker(NULL), I(NULL), pointcloud(NULL), contiguousPointcloud(NULL),
+#ifdef VISP_HAVE_PCL
+        pclPointcloud(),
+#endif
+        pointcloudWidth(0), pointcloudHeight(0), cMcRef(), cVo(), L(), computeLTL_true(false), num(0), den(0)
+    {
+      for (unsigned int i = 0; i < 36; i++) {
+        LTL[i] = LTL_true[i] = 0;
+      }
+      for (unsigned int i = 0; i < 6; i++) {
+        LTR[i] = 0;
+      }
+    }
+
+    TrackerWrapper *tracker;
+    const vpImage<unsigned char> *I;
+    const std::vector<vpColVector> *pointcloud;
+    //! Point cloud whose coordinates are stored in contiguous arrays
+    const vpPointCloud *contiguousPointcloud;
+#ifdef VISP_HAVE_PCL
+    pcl::PointCloud<pcl::PointXYZ>::ConstPtr pclPointcloud;
+#endif
+    unsigned int pointcloudWidth;
+    unsigned int pointcloudHeight;
+    //! Transformation from the reference camera frame to this camera frame
+    vpHomogeneousMatrix cMcRef;
+    //! Velocity twist matrix associated to cMcRef
+    vpVelocityTwistMatrix cVo;
+    //! Interaction matrix of this camera expressed in the reference camera frame
+    vpMatrix L;
+    //! If true, VVS_NORMAL_EQUATIONS_STAGE also accumulates the unweighted LTL_true
+    bool computeLTL_true;
+    //! Row-major \f$ {\bf L}^\top {\bf W}^2 {\bf L} \f$ of this camera in the reference camera frame
+    double LTL[36];
+    //! \f$ {\bf L}^\top {\bf W}^2 {\bf e} \f$ of this camera in the reference camera frame
+    double LTR[6];
+    //! Row-major \f$ {\bf L}^\top {\bf L} \f$ without the weights, used to detect the dof that cannot be estimated
+    double LTL_true[36];
+    //! Sum of the weighted squared errors
+    double num;
+    //! Sum of the weights
+    double den;
+  };
+
+  void computeCameraStage(vpCameraStage stage);
+  void computeCameraStage(vpCameraStage stage, size_t index);
+  void computeCameraNormalEquations(CameraData &data) const;
+  void initCameraData(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages);
+  void resetStageTimes();
+
 protected:
   //! (s - s*)
   vpColVector m_error;
@@ -654,5 +757,11 @@ protected:
   vpColVector m_w;
   //! Weighted error
   vpColVector m_weightedError;
+  //! Number of threads used to process the cameras concurrently (0 for all the threads of the global pool)
+  unsigned int m_nbThreads;
+  //! Per camera data of the stage being processed, ordered as m_mapOfTrackers
+  std::vector<CameraData> m_cameraData;
+  //! Time in ms spent in each stage of the last tracking
+  std::map<std::string, double> m_mapOfStageTimes;
 };
 #endif
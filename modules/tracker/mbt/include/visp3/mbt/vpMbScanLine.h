@@ -67,6 +67,19 @@
 
   \ingroup group_mbt_faces
 
+  Render the polygons of a scene along Y-axis (image rows) and X-axis (image
+  columns) scanlines, to compute the mask of the visible faces and the visible
+  parts of the model lines.
+
+  The scanlines are gathered in bands of consecutive lines stored in flat
+  buffers that are kept from one call of drawScene() to the next. The bands
+  are rendered concurrently on the threads of
+  vpThreadPool::getGlobalInstance() when c++11 is available. The edges of the
+  scene are identified by integers, the visible samples of an edge being
+  stored contiguously.
+
+  drawScene() compares the polygons with those of the previous call and only
+  renders again the bands crossed by the polygons that changed.
  */
 class VISP_EXPORT vpMbScanLine
 {
@@ -81,9 +94,9 @@ public:
 
   //! Structure to define a scanline intersection.
   struct vpMbScanLineSegment {
-    vpMbScanLineSegment() : type(START), edge(), p(0), P1(0), P2(0), Z1(0), Z2(0), ID(0), b_sample_Y(false) {}
+    vpMbScanLineSegment() : type(START), edge(-1), p(0), P1(0), P2(0), Z1(0), Z2(0), ID(0), b_sample_Y(false) {}
     vpMbScanLineType type;
-    vpMbScanLineEdge edge;
+    int edge;      // Index of the edge in the scene
     double p;      // This value can be either x or y-coordinate value depending if
                    // the structure is used in X or Y-axis scanlines computation.
     double P1, P2; // Same comment as previous value.
@@ -126,13 +139,53 @@ public:
   };
 
 private:
+  //! Consecutive Y-axis or X-axis scanlines [first, last[ rendered together.
+  struct vpMbScanLineBand {
+    vpMbScanLineBand()
+      : b_Y(true), first(0), last(0), dirty(true), samples(), raw(), local(), segments(), lineBegin(), stack()
+    {
+    }
+    bool b_Y;
+    unsigned int first, last;
+    bool dirty;
+    //! Visible samples of the edges, as (edge, scanline) pairs.
+    std::vector<std::pair<int, int> > samples;
+    // Buffers kept between two renderings
+    std::vector<std::pair<unsigned int, vpMbScanLineSegment> > raw, local;
+    std::vector<vpMbScanLineSegment> segments;
+    std::vector<unsigned int> lineBegin;
+    std::vector<std::pair<double, vpMbScanLineSegment> > stack;
+  };
+
   unsigned int w, h;
   vpCameraParameters K;
   unsigned int maskBorder;
   vpImage<unsigned char> mask;
   vpImage<int> primitive_ids;
-  std::map<vpMbScanLineEdge, std::set<int>, vpMbScanLineEdgeComparator> visibility_samples;
   double depthTreshold;
+  unsigned int m_nbThreads;
+
+  // Scene of the last call to drawScene()
+  bool m_rendered;
+  unsigned int m_renderedMaskBorder;
+  double m_renderedDepthTreshold;
+  //! X, Y, Z coordinates of the vertices in the camera frame.
+  std::vector<double> m_points;
+  //! Vertices projected with createVectorFromPoint().
+  std::vector<double> m_projections;
+  //! Index of the first vertex of each polygon.
+  std::vector<unsigned int> m_polygonBegin;
+  std::vector<int> m_polygonIds;
+  //! Index of the edge joining each vertex to the next one.
+  std::vector<int> m_edgeIds;
+  //! Bounds (y min, y max, x min, x max) of each polygon in pixels.
+  std::vector<double> m_extents;
+  std::map<vpMbScanLineEdge, int, vpMbScanLineEdgeComparator> m_edgeIndex;
+  std::vector<vpMbScanLineBand> m_bands;
+  vpImage<unsigned char> m_maskX, m_maskY;
+  //! Sorted visible samples of the edge i in [m_edgeSampleBegin[i], m_edgeSampleBegin[i+1][.
+  std::vector<unsigned int> m_edgeSampleBegin;
+  std::vector<int> m_edgeSamples;
 
 public:
 #if defined(DEBUG_DISP)
@@ -157,6 +210,17 @@ public:
   double getDepthTreshold() { return depthTreshold; }
   unsigned int getMaskBorder() { return maskBorder; }
   const vpImage<unsigned char> &getMask() const { return mask; }
+  /*!
+    Return the number of distinct edges of the scene of the last call to
+    drawScene().
+  */
+  unsigned int getNbEdges() const { return static_cast<unsigned int>(m_edgeIndex.size()); }
+  /*!
+    Return the number of threads used to render the scanlines.
+
+    \sa setNbThreads()
+  */
+  unsigned int getNbThreads() const { return m_nbThreads; }
   const vpImage<int> &getPrimitiveIDs() const { return primitive_ids; }
 
   void queryLineVisibility(const vpPoint &a, const vpPoint &b, std::vector<std::pair<vpPoint, vpPoint> > &lines,
@@ -171,23 +235,36 @@ public:
   */
   void setDepthTreshold(const double &treshold) { depthTreshold = treshold; }
   void setMaskBorder(const unsigned int &mb) { maskBorder = mb; }
+  /*!
+    Set the number of threads used to render the scanlines. The result does
+    not depend on the number of threads.
+
+    \param nbThreads : Number of threads. 0 means all the threads of
+    vpThreadPool::getGlobalInstance(), 1 renders the scanlines sequentially.
+    Default value is 0.
+  */
+  void setNbThreads(unsigned int nbThreads) { m_nbThreads = nbThreads; }
 
 private:
-  void createScanLinesFromLocals(std::vector<std::vector<vpMbScanLineSegment> > &scanlines,
-                                 std::vector<std::vector<vpMbScanLineSegment> > &localScanlines,
-                                 const unsigned int &size);
+  void createScanLinesFromLocals(vpMbScanLineBand &band);
+
+  void drawBand(vpMbScanLineBand &band);
+
+  void drawLineY(const double *a, const double *b, const int edge, const int ID, vpMbScanLineBand &band,
+                 std::vector<std::pair<unsigned int, vpMbScanLineSegment> > &scanlines);
+
+  void drawLineX(const double *a, const double *b, const int edge, const int ID, vpMbScanLineBand &band,
+                 std::vector<std::pair<unsigned int, vpMbScanLineSegment> > &scanlines);
 
-  void drawLineY(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &line_ID, const int ID,
-                 std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
+  void drawPolygon(unsigned int polygon, vpMbScanLineBand &band);
 
-  void drawLineX(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &line_ID, const int ID,
-                 std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
+  void markDirtyBands(double y_min, double y_max, double x_min, double x_max);
 
-  void drawPolygonY(const std::vector<std::pair<vpPoint, unsigned int> > &polygon, const int ID,
-                    std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
+  void updateEdgeIndex(const std::vector<std::vector<std::pair<vpPoint, unsigned int> > *> &polygons,
+                       const std::vector<bool> &moved);
 
-  void drawPolygonX(const std::vector<std::pair<vpPoint, unsigned int> > &polygon, const int ID,
-                    std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
+  void renderLinesX(vpMbScanLineBand &band);
+  void renderLinesY(vpMbScanLineBand &band);
 
   // Static functions
   static vpMbScanLineEdge makeMbScanLineEdge(const vpPoint &a, const vpPoint &b);
@@ -805,6 +805,9 @@ protected:
                                         vpColVector &R, const vpColVector &error, vpColVector &error_prev,
                                         vpColVector &LTR, double &mu, vpColVector &v, const vpColVector *const w = NULL,
                                         vpColVector *const m_w_prev = NULL);
+  void computeVVSPoseEstimation(const bool isoJoIdentity_, unsigned int iter, const vpMatrix &LTL,
+                                const vpColVector &LTR, const vpColVector &error, vpColVector &error_prev, double &mu,
+                                vpColVector &v, const vpColVector *const w = NULL, vpColVector *const m_w_prev = NULL);
   virtual void computeVVSWeights(vpRobust &robust, const vpColVector &error, vpColVector &w);
 
 #ifdef VISP_HAVE_COIN3D
@@ -45,6 +45,7 @@
 #endif
 
 #include <visp3/core/vpPlane.h>
+#include <visp3/core/vpPointCloud.h>
 #include <visp3/mbt/vpMbTracker.h>
 #include <visp3/mbt/vpMbtDistanceLine.h>
 
@@ -107,6 +108,14 @@ public:
 #endif
                               , const vpImage<bool> *mask = NULL
   );
+  bool computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const vpPointCloud &point_cloud, unsigned int stepX,
+                              unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                              ,
+                              vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                              , const vpImage<bool> *mask = NULL
+  );
 
   void computeInteractionMatrixAndResidu(const vpHomogeneousMatrix &cMo, vpMatrix &L, vpColVector &error);
 
@@ -226,6 +235,17 @@ protected:
   std::vector<PolygonLine> m_polygonLines;
 
 protected:
+  template <class PointCloud>
+  bool computeDesiredFeaturesOrganized(const vpHomogeneousMatrix &cMo, unsigned int width, unsigned int height,
+                                       const PointCloud &point_cloud, unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                       ,
+                                       vpImage<unsigned char> &debugImage,
+                                       std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                       , const vpImage<bool> *mask
+  );
+
   void computeROI(const vpHomogeneousMatrix &cMo, unsigned int width, unsigned int height,
                   std::vector<vpImagePoint> &roiPts
 #if DEBUG_DISPLAY_DEPTH_DENSE
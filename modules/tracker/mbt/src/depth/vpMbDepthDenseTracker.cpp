@@ -540,68 +540,94 @@ void vpMbDepthDenseTracker::setDepthDenseFilteringOccupancyRatio(double occupanc
   }
 }
 
+namespace
+{
+// Access to the size of the point clouds and to the desired features of a face, with the same arguments whatever
+// the type of the point cloud
 #ifdef VISP_HAVE_PCL
-void vpMbDepthDenseTracker::segmentPointCloud(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud)
+inline unsigned int getWidth(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud, unsigned int)
 {
-  m_depthDenseListOfActiveFaces.clear();
+  return point_cloud->width;
+}
+inline unsigned int getHeight(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud, unsigned int)
+{
+  return point_cloud->height;
+}
+#endif
+inline unsigned int getWidth(const std::vector<vpColVector> &, unsigned int width) { return width; }
+inline unsigned int getHeight(const std::vector<vpColVector> &, unsigned int height) { return height; }
+inline unsigned int getWidth(const vpPointCloud &point_cloud, unsigned int) { return point_cloud.getWidth(); }
+inline unsigned int getHeight(const vpPointCloud &point_cloud, unsigned int) { return point_cloud.getHeight(); }
 
+#ifdef VISP_HAVE_PCL
+inline bool computeDesiredFeatures(vpMbtFaceDepthDense *face, const vpHomogeneousMatrix &cMo, unsigned int,
+                                   unsigned int, const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud,
+                                   unsigned int stepX, unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_DENSE
-  if (!m_debugDisp_depthDense->isInitialised()) {
-    m_debugImage_depthDense.resize(point_cloud->height, point_cloud->width);
-    m_debugDisp_depthDense->init(m_debugImage_depthDense, 50, 0, "Debug display dense depth tracker");
-  }
-
-  m_debugImage_depthDense = 0;
-  std::vector<std::vector<vpImagePoint> > roiPts_vec;
+                                   ,
+                                   vpImage<unsigned char> &debugImage,
+                                   std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                   , const vpImage<bool> *mask)
+{
+  return face->computeDesiredFeatures(cMo, point_cloud, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                      ,
+                                      debugImage, roiPts_vec
+#endif
+                                      , mask);
+}
 #endif
 
-  for (std::vector<vpMbtFaceDepthDense *>::iterator it = m_depthDenseFaces.begin();
-       it != m_depthDenseFaces.end(); ++it) {
-    vpMbtFaceDepthDense *face = *it;
-
-    if (face->isVisible() && face->isTracked()) {
+inline bool computeDesiredFeatures(vpMbtFaceDepthDense *face, const vpHomogeneousMatrix &cMo, unsigned int width,
+                                   unsigned int height, const std::vector<vpColVector> &point_cloud,
+                                   unsigned int stepX, unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_DENSE
-      std::vector<std::vector<vpImagePoint> > roiPts_vec_;
+                                   ,
+                                   vpImage<unsigned char> &debugImage,
+                                   std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-      if (face->computeDesiredFeatures(m_cMo, point_cloud, m_depthDenseSamplingStepX, m_depthDenseSamplingStepY
+                                   , const vpImage<bool> *mask)
+{
+  return face->computeDesiredFeatures(cMo, width, height, point_cloud, stepX, stepY
 #if DEBUG_DISPLAY_DEPTH_DENSE
-                                       ,
-                                       m_debugImage_depthDense, roiPts_vec_
+                                      ,
+                                      debugImage, roiPts_vec
 #endif
-                                       , m_mask
-                                       )) {
-        m_depthDenseListOfActiveFaces.push_back(*it);
+                                      , mask);
+}
 
+inline bool computeDesiredFeatures(vpMbtFaceDepthDense *face, const vpHomogeneousMatrix &cMo, unsigned int,
+                                   unsigned int, const vpPointCloud &point_cloud, unsigned int stepX,
+                                   unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_DENSE
-        roiPts_vec.insert(roiPts_vec.end(), roiPts_vec_.begin(), roiPts_vec_.end());
+                                   ,
+                                   vpImage<unsigned char> &debugImage,
+                                   std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-      }
-    }
-  }
-
+                                   , const vpImage<bool> *mask)
+{
+  return face->computeDesiredFeatures(cMo, point_cloud, stepX, stepY
 #if DEBUG_DISPLAY_DEPTH_DENSE
-  vpDisplay::display(m_debugImage_depthDense);
-
-  for (size_t i = 0; i < roiPts_vec.size(); i++) {
-    if (roiPts_vec[i].empty())
-      continue;
-
-    for (size_t j = 0; j < roiPts_vec[i].size() - 1; j++) {
-      vpDisplay::displayLine(m_debugImage_depthDense, roiPts_vec[i][j], roiPts_vec[i][j + 1], vpColor::red, 2);
-    }
-    vpDisplay::displayLine(m_debugImage_depthDense, roiPts_vec[i][0], roiPts_vec[i][roiPts_vec[i].size() - 1],
-                           vpColor::red, 2);
-  }
-
-  vpDisplay::flush(m_debugImage_depthDense);
+                                      ,
+                                      debugImage, roiPts_vec
 #endif
+                                      , mask);
+}
 }
-#endif
 
-void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
-                                              unsigned int height)
+/*!
+  Compute the desired features of the visible and tracked faces, whatever
+  the type of the point cloud. \a width and \a height are only used when the
+  point cloud does not know its size.
+*/
+template <class PointCloud>
+void vpMbDepthDenseTracker::segmentPointCloudFaces(const PointCloud &point_cloud, unsigned int width,
+                                                   unsigned int height)
 {
   m_depthDenseListOfActiveFaces.clear();
+  width = getWidth(point_cloud, width);
+  height = getHeight(point_cloud, height);
 
 #if DEBUG_DISPLAY_DEPTH_DENSE
   if (!m_debugDisp_depthDense->isInitialised()) {
@@ -621,14 +647,14 @@ void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &po
 #if DEBUG_DISPLAY_DEPTH_DENSE
       std::vector<std::vector<vpImagePoint> > roiPts_vec_;
 #endif
-      if (face->computeDesiredFeatures(m_cMo, width, height, point_cloud, m_depthDenseSamplingStepX,
-                                       m_depthDenseSamplingStepY
+      if (computeDesiredFeatures(face, m_cMo, width, height, point_cloud, m_depthDenseSamplingStepX,
+                                 m_depthDenseSamplingStepY
 #if DEBUG_DISPLAY_DEPTH_DENSE
-                                       ,
-                                       m_debugImage_depthDense, roiPts_vec_
+                                 ,
+                                 m_debugImage_depthDense, roiPts_vec_
 #endif
-                                       , m_mask
-                                       )) {
+                                 , m_mask
+                                 )) {
         m_depthDenseListOfActiveFaces.push_back(*it);
 
 #if DEBUG_DISPLAY_DEPTH_DENSE
@@ -656,6 +682,24 @@ void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &po
 #endif
 }
 
+#ifdef VISP_HAVE_PCL
+void vpMbDepthDenseTracker::segmentPointCloud(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud)
+{
+  segmentPointCloudFaces(point_cloud, 0, 0);
+}
+#endif
+
+void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
+                                              unsigned int height)
+{
+  segmentPointCloudFaces(point_cloud, width, height);
+}
+
+void vpMbDepthDenseTracker::segmentPointCloud(const vpPointCloud &point_cloud)
+{
+  segmentPointCloudFaces(point_cloud, 0, 0);
+}
+
 void vpMbDepthDenseTracker::setOgreVisibilityTest(const bool &v)
 {
   vpMbTracker::setOgreVisibilityTest(v);
@@ -741,6 +785,22 @@ void vpMbDepthDenseTracker::track(const std::vector<vpColVector> &point_cloud, u
   computeVisibility(width, height);
 }
 
+/*!
+  Track the object in a point cloud whose coordinates are stored in
+  contiguous arrays, see vpPointCloud. The point cloud is neither copied nor
+  converted.
+
+  \param point_cloud : Organized point cloud.
+*/
+void vpMbDepthDenseTracker::track(const vpPointCloud &point_cloud)
+{
+  segmentPointCloud(point_cloud);
+
+  computeVVS();
+
+  computeVisibility(point_cloud.getWidth(), point_cloud.getHeight());
+}
+
 void vpMbDepthDenseTracker::initCircle(const vpPoint & /*p1*/, const vpPoint & /*p2*/, const vpPoint & /*p3*/,
                                        double /*radius*/, int /*idFace*/, const std::string & /*name*/)
 {
@@ -584,74 +584,95 @@ void vpMbDepthNormalTracker::setUseDepthNormalTracking(const std::string &name,
 
 void vpMbDepthNormalTracker::testTracking() {}
 
+namespace
+{
+// Access to the size of the point clouds and to the desired features of a face, with the same arguments whatever
+// the type of the point cloud
 #ifdef VISP_HAVE_PCL
-void vpMbDepthNormalTracker::segmentPointCloud(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud)
+inline unsigned int getWidth(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud, unsigned int)
 {
-  m_depthNormalListOfActiveFaces.clear();
-  m_depthNormalListOfDesiredFeatures.clear();
+  return point_cloud->width;
+}
+inline unsigned int getHeight(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud, unsigned int)
+{
+  return point_cloud->height;
+}
+#endif
+inline unsigned int getWidth(const std::vector<vpColVector> &, unsigned int width) { return width; }
+inline unsigned int getHeight(const std::vector<vpColVector> &, unsigned int height) { return height; }
+inline unsigned int getWidth(const vpPointCloud &point_cloud, unsigned int) { return point_cloud.getWidth(); }
+inline unsigned int getHeight(const vpPointCloud &point_cloud, unsigned int) { return point_cloud.getHeight(); }
 
+#ifdef VISP_HAVE_PCL
+inline bool computeDesiredFeatures(vpMbtFaceDepthNormal *face, const vpHomogeneousMatrix &cMo, unsigned int width,
+                                   unsigned int height, const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud,
+                                   vpColVector &desired_features, unsigned int stepX, unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-  if (!m_debugDisp_depthNormal->isInitialised()) {
-    m_debugImage_depthNormal.resize(point_cloud->height, point_cloud->width);
-    m_debugDisp_depthNormal->init(m_debugImage_depthNormal, 50, 0, "Debug display normal depth tracker");
-  }
-
-  m_debugImage_depthNormal = 0;
-  std::vector<std::vector<vpImagePoint> > roiPts_vec;
+                                   ,
+                                   vpImage<unsigned char> &debugImage,
+                                   std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                   , const vpImage<bool> *mask)
+{
+  return face->computeDesiredFeatures(cMo, width, height, point_cloud, desired_features, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                      ,
+                                      debugImage, roiPts_vec
+#endif
+                                      , mask);
+}
 #endif
 
-  for (std::vector<vpMbtFaceDepthNormal *>::iterator it = m_depthNormalFaces.begin(); it != m_depthNormalFaces.end();
-       ++it) {
-    vpMbtFaceDepthNormal *face = *it;
-
-    if (face->isVisible() && face->isTracked()) {
-      vpColVector desired_features;
-
+inline bool computeDesiredFeatures(vpMbtFaceDepthNormal *face, const vpHomogeneousMatrix &cMo, unsigned int width,
+                                   unsigned int height, const std::vector<vpColVector> &point_cloud,
+                                   vpColVector &desired_features, unsigned int stepX, unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-      std::vector<std::vector<vpImagePoint> > roiPts_vec_;
+                                   ,
+                                   vpImage<unsigned char> &debugImage,
+                                   std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-      if (face->computeDesiredFeatures(m_cMo, point_cloud->width, point_cloud->height, point_cloud, desired_features,
-                                       m_depthNormalSamplingStepX, m_depthNormalSamplingStepY
+                                   , const vpImage<bool> *mask)
+{
+  return face->computeDesiredFeatures(cMo, width, height, point_cloud, desired_features, stepX, stepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-                                       ,
-                                       m_debugImage_depthNormal, roiPts_vec_
+                                      ,
+                                      debugImage, roiPts_vec
 #endif
-                                       , m_mask
-                                       )) {
-        m_depthNormalListOfDesiredFeatures.push_back(desired_features);
-        m_depthNormalListOfActiveFaces.push_back(face);
+                                      , mask);
+}
 
+inline bool computeDesiredFeatures(vpMbtFaceDepthNormal *face, const vpHomogeneousMatrix &cMo, unsigned int,
+                                   unsigned int, const vpPointCloud &point_cloud, vpColVector &desired_features,
+                                   unsigned int stepX, unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-        roiPts_vec.insert(roiPts_vec.end(), roiPts_vec_.begin(), roiPts_vec_.end());
+                                   ,
+                                   vpImage<unsigned char> &debugImage,
+                                   std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-      }
-    }
-  }
-
+                                   , const vpImage<bool> *mask)
+{
+  return face->computeDesiredFeatures(cMo, point_cloud, desired_features, stepX, stepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-  vpDisplay::display(m_debugImage_depthNormal);
-
-  for (size_t i = 0; i < roiPts_vec.size(); i++) {
-    if (roiPts_vec[i].empty())
-      continue;
-
-    for (size_t j = 0; j < roiPts_vec[i].size() - 1; j++) {
-      vpDisplay::displayLine(m_debugImage_depthNormal, roiPts_vec[i][j], roiPts_vec[i][j + 1], vpColor::red, 2);
-    }
-    vpDisplay::displayLine(m_debugImage_depthNormal, roiPts_vec[i][0], roiPts_vec[i][roiPts_vec[i].size() - 1],
-                           vpColor::red, 2);
-  }
-
-  vpDisplay::flush(m_debugImage_depthNormal);
+                                      ,
+                                      debugImage, roiPts_vec
 #endif
+                                      , mask);
+}
 }
-#endif
 
-void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
-                                               unsigned int height)
+/*!
+  Compute the desired features of the visible and tracked faces, whatever
+  the type of the point cloud. \a width and \a height are only used when the
+  point cloud does not know its size.
+*/
+template <class PointCloud>
+void vpMbDepthNormalTracker::segmentPointCloudFaces(const PointCloud &point_cloud, unsigned int width,
+                                                    unsigned int height)
 {
   m_depthNormalListOfActiveFaces.clear();
   m_depthNormalListOfDesiredFeatures.clear();
+  width = getWidth(point_cloud, width);
+  height = getHeight(point_cloud, height);
 
 #if DEBUG_DISPLAY_DEPTH_NORMAL
   if (!m_debugDisp_depthNormal->isInitialised()) {
@@ -673,15 +694,14 @@ void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &p
 #if DEBUG_DISPLAY_DEPTH_NORMAL
       std::vector<std::vector<vpImagePoint> > roiPts_vec_;
 #endif
-
-      if (face->computeDesiredFeatures(m_cMo, width, height, point_cloud, desired_features, m_depthNormalSamplingStepX,
-                                       m_depthNormalSamplingStepY
+      if (computeDesiredFeatures(face, m_cMo, width, height, point_cloud, desired_features, m_depthNormalSamplingStepX,
+                                 m_depthNormalSamplingStepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-                                       ,
-                                       m_debugImage_depthNormal, roiPts_vec_
+                                 ,
+                                 m_debugImage_depthNormal, roiPts_vec_
 #endif
-                                       , m_mask
-                                       )) {
+                                 , m_mask
+                                 )) {
         m_depthNormalListOfDesiredFeatures.push_back(desired_features);
         m_depthNormalListOfActiveFaces.push_back(face);
 
@@ -710,6 +730,24 @@ void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &p
 #endif
 }
 
+#ifdef VISP_HAVE_PCL
+void vpMbDepthNormalTracker::segmentPointCloud(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud)
+{
+  segmentPointCloudFaces(point_cloud, 0, 0);
+}
+#endif
+
+void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
+                                               unsigned int height)
+{
+  segmentPointCloudFaces(point_cloud, width, height);
+}
+
+void vpMbDepthNormalTracker::segmentPointCloud(const vpPointCloud &point_cloud)
+{
+  segmentPointCloudFaces(point_cloud, 0, 0);
+}
+
 void vpMbDepthNormalTracker::setCameraParameters(const vpCameraParameters &cam)
 {
   m_cam = cam;
@@ -815,6 +853,22 @@ void vpMbDepthNormalTracker::track(const std::vector<vpColVector> &point_cloud,
   computeVisibility(width, height);
 }
 
+/*!
+  Track the object in a point cloud whose coordinates are stored in
+  contiguous arrays, see vpPointCloud. The point cloud is neither copied nor
+  converted.
+
+  \param point_cloud : Organized point cloud.
+*/
+void vpMbDepthNormalTracker::track(const vpPointCloud &point_cloud)
+{
+  segmentPointCloud(point_cloud);
+
+  computeVVS();
+
+  computeVisibility(point_cloud.getWidth(), point_cloud.getHeight());
+}
+
 void vpMbDepthNormalTracker::initCircle(const vpPoint & /*p1*/, const vpPoint & /*p2*/, const vpPoint & /*p3*/,
                                         double /*radius*/, int /*idFace*/, const std::string & /*name*/)
 {
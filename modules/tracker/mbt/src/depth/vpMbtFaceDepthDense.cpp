@@ -270,15 +270,27 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
 }
 #endif
 
-bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
-                                                 unsigned int height, const std::vector<vpColVector> &point_cloud,
-                                                 unsigned int stepX, unsigned int stepY
+namespace
+{
+// Access to the coordinates of the organized point clouds
+inline double getX(const std::vector<vpColVector> &point_cloud, unsigned int index) { return point_cloud[index][0]; }
+inline double getY(const std::vector<vpColVector> &point_cloud, unsigned int index) { return point_cloud[index][1]; }
+inline double getZ(const std::vector<vpColVector> &point_cloud, unsigned int index) { return point_cloud[index][2]; }
+inline double getX(const vpPointCloud &point_cloud, unsigned int index) { return point_cloud.getX(index); }
+inline double getY(const vpPointCloud &point_cloud, unsigned int index) { return point_cloud.getY(index); }
+inline double getZ(const vpPointCloud &point_cloud, unsigned int index) { return point_cloud.getZ(index); }
+}
+
+template <class PointCloud>
+bool vpMbtFaceDepthDense::computeDesiredFeaturesOrganized(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                          unsigned int height, const PointCloud &point_cloud,
+                                                          unsigned int stepX, unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_DENSE
-                                                 ,
-                                                 vpImage<unsigned char> &debugImage,
-                                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                                          ,
+                                                          vpImage<unsigned char> &debugImage,
+                                                          std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-                                                 , const vpImage<bool> *mask
+                                                          , const vpImage<bool> *mask
 )
 {
   m_pointCloudFace.clear();
@@ -340,32 +352,32 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
                          : polygon_2d.isInside(vpImagePoint(i, j)))) {
         totalTheoreticalPoints++;
 
-        if (vpMeTracker::inMask(mask, i, j) && point_cloud[i * width + j][2] > 0) {
+        if (vpMeTracker::inMask(mask, i, j) && getZ(point_cloud, i * width + j) > 0) {
           totalPoints++;
 
           if (checkSSE2) {
 #if USE_SSE
             if (!push) {
               push = true;
-              prev_x = point_cloud[i * width + j][0];
-              prev_y = point_cloud[i * width + j][1];
-              prev_z = point_cloud[i * width + j][2];
+              prev_x = getX(point_cloud, i * width + j);
+              prev_y = getY(point_cloud, i * width + j);
+              prev_z = getZ(point_cloud, i * width + j);
             } else {
               push = false;
               m_pointCloudFace.push_back(prev_x);
-              m_pointCloudFace.push_back(point_cloud[i * width + j][0]);
+              m_pointCloudFace.push_back(getX(point_cloud, i * width + j));
 
               m_pointCloudFace.push_back(prev_y);
-              m_pointCloudFace.push_back(point_cloud[i * width + j][1]);
+              m_pointCloudFace.push_back(getY(point_cloud, i * width + j));
 
               m_pointCloudFace.push_back(prev_z);
-              m_pointCloudFace.push_back(point_cloud[i * width + j][2]);
+              m_pointCloudFace.push_back(getZ(point_cloud, i * width + j));
             }
 #endif
           } else {
-            m_pointCloudFace.push_back(point_cloud[i * width + j][0]);
-            m_pointCloudFace.push_back(point_cloud[i * width + j][1]);
-            m_pointCloudFace.push_back(point_cloud[i * width + j][2]);
+            m_pointCloudFace.push_back(getX(point_cloud, i * width + j));
+            m_pointCloudFace.push_back(getY(point_cloud, i * width + j));
+            m_pointCloudFace.push_back(getZ(point_cloud, i * width + j));
           }
 
 #if DEBUG_DISPLAY_DEPTH_DENSE
@@ -392,6 +404,44 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
   return true;
 }
 
+bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                 unsigned int height, const std::vector<vpColVector> &point_cloud,
+                                                 unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                                 ,
+                                                 vpImage<unsigned char> &debugImage,
+                                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                 , const vpImage<bool> *mask
+)
+{
+  return computeDesiredFeaturesOrganized(cMo, width, height, point_cloud, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                         ,
+                                         debugImage, roiPts_vec
+#endif
+                                         , mask);
+}
+
+bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const vpPointCloud &point_cloud,
+                                                 unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                                 ,
+                                                 vpImage<unsigned char> &debugImage,
+                                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                 , const vpImage<bool> *mask
+)
+{
+  return computeDesiredFeaturesOrganized(cMo, point_cloud.getWidth(), point_cloud.getHeight(), point_cloud, stepX,
+                                         stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                         ,
+                                         debugImage, roiPts_vec
+#endif
+                                         , mask);
+}
+
 void vpMbtFaceDepthDense::computeVisibility() { m_isVisible = m_polygon->isVisible(); }
 
 void vpMbtFaceDepthDense::computeVisibilityDisplay()
@@ -307,17 +307,28 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
 }
 #endif
 
-bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
-                                                  unsigned int height,
-                                                  const std::vector<vpColVector> &point_cloud,
-                                                  vpColVector &desired_features, unsigned int stepX,
-                                                  unsigned int stepY
+namespace
+{
+// Access to the coordinates of the organized point clouds
+inline double getX(const std::vector<vpColVector> &point_cloud, unsigned int index) { return point_cloud[index][0]; }
+inline double getY(const std::vector<vpColVector> &point_cloud, unsigned int index) { return point_cloud[index][1]; }
+inline double getZ(const std::vector<vpColVector> &point_cloud, unsigned int index) { return point_cloud[index][2]; }
+inline double getX(const vpPointCloud &point_cloud, unsigned int index) { return point_cloud.getX(index); }
+inline double getY(const vpPointCloud &point_cloud, unsigned int index) { return point_cloud.getY(index); }
+inline double getZ(const vpPointCloud &point_cloud, unsigned int index) { return point_cloud.getZ(index); }
+}
+
+template <class PointCloud>
+bool vpMbtFaceDepthNormal::computeDesiredFeaturesOrganized(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                           unsigned int height, const PointCloud &point_cloud,
+                                                           vpColVector &desired_features, unsigned int stepX,
+                                                           unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-                                                  ,
-                                                  vpImage<unsigned char> &debugImage,
-                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                                           ,
+                                                           vpImage<unsigned char> &debugImage,
+                                                           std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-                                                  , const vpImage<bool> *mask
+                                                           , const vpImage<bool> *mask
 )
 {
   m_faceActivated = false;
@@ -374,15 +385,15 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
   double x = 0.0, y = 0.0;
   for (unsigned int i = top; i < bottom; i += stepY) {
     for (unsigned int j = left; j < right; j += stepX) {
-      if (vpMeTracker::inMask(mask, i, j) && point_cloud[i * width + j][2] > 0 &&
+      if (vpMeTracker::inMask(mask, i, j) && getZ(point_cloud, i * width + j) > 0 &&
           (m_useScanLine ? (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
                             j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
                             m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
                          : polygon_2d.isInside(vpImagePoint(i, j)))) {
         // Add point
-        point_cloud_face.push_back(point_cloud[i * width + j][0]);
-        point_cloud_face.push_back(point_cloud[i * width + j][1]);
-        point_cloud_face.push_back(point_cloud[i * width + j][2]);
+        point_cloud_face.push_back(getX(point_cloud, i * width + j));
+        point_cloud_face.push_back(getY(point_cloud, i * width + j));
+        point_cloud_face.push_back(getZ(point_cloud, i * width + j));
 
         if (m_featureEstimationMethod == ROBUST_FEATURE_ESTIMATION) {
           // Add point for custom method for plane equation estimation
@@ -394,7 +405,7 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
               push = true;
               prev_x = x;
               prev_y = y;
-              prev_z = point_cloud[i * width + j][2];
+              prev_z = getZ(point_cloud, i * width + j);
             } else {
               push = false;
               point_cloud_face_custom.push_back(prev_x);
@@ -404,13 +415,13 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
               point_cloud_face_custom.push_back(y);
 
               point_cloud_face_custom.push_back(prev_z);
-              point_cloud_face_custom.push_back(point_cloud[i * width + j][2]);
+              point_cloud_face_custom.push_back(getZ(point_cloud, i * width + j));
             }
 #endif
           } else {
             point_cloud_face_custom.push_back(x);
             point_cloud_face_custom.push_back(y);
-            point_cloud_face_custom.push_back(point_cloud[i * width + j][2]);
+            point_cloud_face_custom.push_back(getZ(point_cloud, i * width + j));
           }
         }
 
@@ -465,6 +476,47 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
   return true;
 }
 
+bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                  unsigned int height,
+                                                  const std::vector<vpColVector> &point_cloud,
+                                                  vpColVector &desired_features, unsigned int stepX,
+                                                  unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                                  ,
+                                                  vpImage<unsigned char> &debugImage,
+                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                  , const vpImage<bool> *mask
+)
+{
+  return computeDesiredFeaturesOrganized(cMo, width, height, point_cloud, desired_features, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                         ,
+                                         debugImage, roiPts_vec
+#endif
+                                         , mask);
+}
+
+bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const vpPointCloud &point_cloud,
+                                                  vpColVector &desired_features, unsigned int stepX,
+                                                  unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                                  ,
+                                                  vpImage<unsigned char> &debugImage,
+                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                  , const vpImage<bool> *mask
+)
+{
+  return computeDesiredFeaturesOrganized(cMo, point_cloud.getWidth(), point_cloud.getHeight(), point_cloud,
+                                         desired_features, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                         ,
+                                         debugImage, roiPts_vec
+#endif
+                                         , mask);
+}
+
 #ifdef VISP_HAVE_PCL
 bool vpMbtFaceDepthNormal::computeDesiredFeaturesPCL(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud_face,
                                                      vpColVector &desired_features, vpColVector &desired_normal,
@@ -57,6 +57,10 @@
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
 #include <visp3/vision/vpPose.h>
 
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <visp3/core/vpThreadPool.h>
+#endif
+
 #include <float.h>
 #include <limits>
 #include <map>
@@ -71,7 +75,7 @@ vpMbEdgeTracker::vpMbEdgeTracker()
     percentageGdPt(0.4), scales(1), Ipyramid(0), scaleLevel(0), nbFeaturesForProjErrorComputation(0), m_factor(),
     m_robustLines(), m_robustCylinders(), m_robustCircles(), m_wLines(), m_wCylinders(), m_wCircles(), m_errorLines(),
     m_errorCylinders(), m_errorCircles(), m_L_edge(), m_error_edge(), m_w_edge(), m_weightedError_edge(),
-    m_robust_edge(), m_featuresToBeDisplayedEdge()
+    m_robust_edge(), m_featuresToBeDisplayedEdge(), m_nbThreads(0)
 {
   scales[0] = true;
 
@@ -1637,6 +1641,9 @@ void vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
 {
   const bool doNotTrack = false;
 
+  // The moving edges are initialized first since it temporarily changes the
+  // moving edge parameters. The lines are then tracked independently.
+  std::vector<vpMbtDistanceLine *> linesToTrack;
   for (std::list<vpMbtDistanceLine *>::const_iterator it = lines[scaleLevel].begin(); it != lines[scaleLevel].end();
        ++it) {
     vpMbtDistanceLine *l = *it;
@@ -1644,10 +1651,24 @@ void vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
       if (l->meline.empty()) {
         l->initMovingEdge(I, m_cMo, doNotTrack, m_mask);
       }
-      l->trackMovingEdge(I);
+      linesToTrack.push_back(l);
     }
   }
 
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(linesToTrack.size()),
+                                                [&I, &linesToTrack](int start, int end) {
+                                                  for (int i = start; i < end; i++) {
+                                                    linesToTrack[static_cast<size_t>(i)]->trackMovingEdge(I);
+                                                  }
+                                                },
+                                                m_nbThreads);
+#else
+  for (size_t i = 0; i < linesToTrack.size(); i++) {
+    linesToTrack[i]->trackMovingEdge(I);
+  }
+#endif
+
   for (std::list<vpMbtDistanceCylinder *>::const_iterator it = cylinders[scaleLevel].begin();
        it != cylinders[scaleLevel].end(); ++it) {
     vpMbtDistanceCylinder *cy = *it;
@@ -37,12 +37,15 @@
 
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/core/vpTime.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
 
 vpMbGenericTracker::vpMbGenericTracker()
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_nbThreads(0), m_cameraData(), m_mapOfStageTimes()
 {
   m_mapOfTrackers["Camera"] = new TrackerWrapper(EDGE_TRACKER);
 
@@ -62,7 +65,8 @@ vpMbGenericTracker::vpMbGenericTracker()
 
 vpMbGenericTracker::vpMbGenericTracker(unsigned int nbCameras, int trackerType)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_nbThreads(0), m_cameraData(), m_mapOfStageTimes()
 {
   if (nbCameras == 0) {
     throw vpException(vpTrackingException::fatalError, "Cannot use no camera!");
@@ -98,7 +102,8 @@ vpMbGenericTracker::vpMbGenericTracker(unsigned int nbCameras, int trackerType)
 
 vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_nbThreads(0), m_cameraData(), m_mapOfStageTimes()
 {
   if (trackerTypes.empty()) {
     throw vpException(vpException::badValue, "There is no camera!");
@@ -137,7 +142,8 @@ vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes)
 vpMbGenericTracker::vpMbGenericTracker(const std::vector<std::string> &cameraNames,
                                        const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_nbThreads(0), m_cameraData(), m_mapOfStageTimes()
 {
   if (cameraNames.size() != trackerTypes.size() || cameraNames.empty()) {
     throw vpException(vpTrackingException::badValue,
@@ -274,6 +280,7 @@ void vpMbGenericTracker::computeProjectionError()
 
 void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages)
 {
+  double t_vvs = vpTime::measureTimeMs();
   computeVVSInit(mapOfImages);
 
   if (m_error.getRows() < 4) {
@@ -284,7 +291,7 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
   double normRes_1 = -1;
   unsigned int iter = 0;
 
-  vpMatrix LTL;
+  vpMatrix LTL, LTL_true;
   vpColVector LTR, v;
   vpColVector error_prev;
 
@@ -294,7 +301,7 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
   bool isoJoIdentity_ = true;
 
   // Covariance
-  vpColVector W_true(m_error.getRows());
+  vpColVector W_true(computeCovariance ? m_error.getRows() : 0);
   vpMatrix L_true, LVJ_true;
 
   // Create the map of VelocityTwistMatrices
@@ -336,7 +343,38 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
     if (!reStartFromLastIncrement) {
       computeVVSWeights();
 
-      if (computeCovariance) {
+      double num = 0;
+      double den = 0;
+      if (!computeCovariance) {
+        // Each camera adds the contribution of its weighted features to its own
+        // normal equations, summed in the order of m_mapOfTrackers
+        for (size_t i = 0; i < m_cameraData.size(); i++) {
+          m_cameraData[i].computeLTL_true = (iter == 0);
+        }
+        computeCameraStage(VVS_NORMAL_EQUATIONS_STAGE);
+
+        LTL.resize(6, 6, true, false);
+        LTR.resize(6, true);
+        if (iter == 0) {
+          LTL_true.resize(6, 6, true, false);
+        }
+        for (size_t i = 0; i < m_cameraData.size(); i++) {
+          const CameraData &data = m_cameraData[i];
+          for (unsigned int k = 0; k < 36; k++) {
+            LTL.data[k] += data.LTL[k];
+          }
+          for (unsigned int k = 0; k < 6; k++) {
+            LTR[k] += data.LTR[k];
+          }
+          if (iter == 0) {
+            for (unsigned int k = 0; k < 36; k++) {
+              LTL_true.data[k] += data.LTL_true[k];
+            }
+          }
+          num += data.num;
+          den += data.den;
+        }
+      } else {
         L_true = m_L;
         if (!isoJoIdentity_) {
           vpVelocityTwistMatrix cVo;
@@ -358,7 +396,10 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
           cVo.buildFrom(m_cMo);
 
           vpMatrix K; // kernel
-          unsigned int rank = (m_L * cVo).kernel(K);
+          // The singular values of (L cVo)^T (L cVo) being the squares of the
+          // ones of L cVo, the relative threshold of the rank is squared
+          const vpMatrix V(cVo);
+          unsigned int rank = computeCovariance ? (m_L * cVo).kernel(K) : (V.t() * LTL_true * V).kernel(K, 1e-12);
           if (rank == 0) {
             throw vpException(vpException::fatalError, "Rank=0, cannot estimate the pose !");
           }
@@ -373,13 +414,10 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
         }
       }
 
-      // Weighting
-      double num = 0;
-      double den = 0;
-
+      // Weighting of the stacked interaction matrix
       unsigned int start_index = 0;
       for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-           it != m_mapOfTrackers.end(); ++it) {
+           computeCovariance && it != m_mapOfTrackers.end(); ++it) {
         TrackerWrapper *tracker = it->second;
 
         if (tracker->m_trackerType & EDGE_TRACKER) {
@@ -456,7 +494,13 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
       normRes_1 = normRes;
       normRes = sqrt(num / den);
 
-      computeVVSPoseEstimation(isoJoIdentity_, iter, m_L, LTL, m_weightedError, m_error, error_prev, LTR, mu, v);
+      double t_pose = vpTime::measureTimeMs();
+      if (computeCovariance) {
+        computeVVSPoseEstimation(isoJoIdentity_, iter, m_L, LTL, m_weightedError, m_error, error_prev, LTR, mu, v);
+      } else {
+        computeVVSPoseEstimation(isoJoIdentity_, iter, LTL, LTR, m_error, error_prev, mu, v);
+      }
+      m_mapOfStageTimes["computeVVSPoseEstimation"] += vpTime::measureTimeMs() - t_pose;
 
       cMo_prev = m_cMo;
 
@@ -494,6 +538,8 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
       tracker->updateMovingEdgeWeights();
     }
   }
+
+  m_mapOfStageTimes["computeVVS"] += vpTime::measureTimeMs() - t_vvs;
 }
 
 void vpMbGenericTracker::computeVVSInit()
@@ -503,22 +549,27 @@ void vpMbGenericTracker::computeVVSInit()
 
 void vpMbGenericTracker::computeVVSInit(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages)
 {
-  unsigned int nbFeatures = 0;
+  double t = vpTime::measureTimeMs();
+  initCameraData(mapOfImages);
+  computeCameraStage(VVS_INIT_STAGE);
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-       it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->computeVVSInit(mapOfImages[it->first]);
-
-    nbFeatures += tracker->m_error.getRows();
+  unsigned int nbFeatures = 0;
+  for (size_t i = 0; i < m_cameraData.size(); i++) {
+    nbFeatures += m_cameraData[i].tracker->m_error.getRows();
   }
 
-  m_L.resize(nbFeatures, 6, false, false);
+  // The stacked interaction matrix is only needed for the covariance,
+  // otherwise the normal equations are accumulated per camera
+  if (computeCovariance) {
+    m_L.resize(nbFeatures, 6, false, false);
+    m_weightedError.resize(nbFeatures, false);
+  }
   m_error.resize(nbFeatures, false);
 
-  m_weightedError.resize(nbFeatures, false);
   m_w.resize(nbFeatures, false);
   m_w = 1;
+
+  m_mapOfStageTimes["computeVVSInit"] += vpTime::measureTimeMs() - t;
 }
 
 void vpMbGenericTracker::computeVVSInteractionMatrixAndResidu()
@@ -532,39 +583,332 @@ void vpMbGenericTracker::computeVVSInteractionMatrixAndResidu(
     std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
     std::map<std::string, vpVelocityTwistMatrix> &mapOfVelocityTwist)
 {
-  unsigned int start_index = 0;
-
+  double t = vpTime::measureTimeMs();
+  initCameraData(mapOfImages);
+  size_t idx = 0;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-       it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
+       it != m_mapOfTrackers.end(); ++it, ++idx) {
+    m_cameraData[idx].cMcRef = m_mapOfCameraTransformationMatrix[it->first];
+    m_cameraData[idx].cVo = mapOfVelocityTwist[it->first];
+  }
 
-    tracker->m_cMo = m_mapOfCameraTransformationMatrix[it->first] * m_cMo;
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-    vpHomogeneousMatrix c_curr_tTc_curr0 = m_mapOfCameraTransformationMatrix[it->first] * m_cMo * tracker->c0Mo.inverse();
-    tracker->ctTc0 = c_curr_tTc_curr0;
-#endif
+  computeCameraStage(VVS_INTERACTION_MATRIX_AND_RESIDU_STAGE);
 
-    tracker->computeVVSInteractionMatrixAndResidu(mapOfImages[it->first]);
+  // Stack the per camera features in the order of m_mapOfTrackers, whatever
+  // the order in which the cameras have been processed
+  unsigned int start_index = 0;
+  for (size_t i = 0; i < m_cameraData.size(); i++) {
+    TrackerWrapper *tracker = m_cameraData[i].tracker;
 
-    m_L.insert(tracker->m_L * mapOfVelocityTwist[it->first], start_index, 0);
+    if (computeCovariance) {
+      m_L.insert(m_cameraData[i].L, start_index, 0);
+    }
     m_error.insert(start_index, tracker->m_error);
 
     start_index += tracker->m_error.getRows();
   }
+
+  m_mapOfStageTimes["computeVVSInteractionMatrixAndResidu"] += vpTime::measureTimeMs() - t;
 }
 
 void vpMbGenericTracker::computeVVSWeights()
 {
-  unsigned int start_index = 0;
+  double t = vpTime::measureTimeMs();
+  computeCameraStage(VVS_WEIGHTS_STAGE);
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-       it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->computeVVSWeights();
+  unsigned int start_index = 0;
+  for (size_t i = 0; i < m_cameraData.size(); i++) {
+    TrackerWrapper *tracker = m_cameraData[i].tracker;
 
     m_w.insert(start_index, tracker->m_w);
     start_index += tracker->m_w.getRows();
   }
+
+  m_mapOfStageTimes["computeVVSWeights"] += vpTime::measureTimeMs() - t;
+}
+
+void vpMbGenericTracker::resetStageTimes()
+{
+  m_mapOfStageTimes.clear();
+  m_mapOfStageTimes["preTracking"] = 0;
+  m_mapOfStageTimes["computeVVSInit"] = 0;
+  m_mapOfStageTimes["computeVVSInteractionMatrixAndResidu"] = 0;
+  m_mapOfStageTimes["computeVVSWeights"] = 0;
+  m_mapOfStageTimes["computeVVSPoseEstimation"] = 0;
+  m_mapOfStageTimes["computeVVS"] = 0;
+  m_mapOfStageTimes["postTracking"] = 0;
+}
+
+/*!
+  Process a stage of the tracking for all the cameras. The cameras are
+  processed concurrently with the pool returned by
+  vpThreadPool::getGlobalInstance() when there are several cameras and more
+  than one thread is allowed, sequentially otherwise. The edge tracker of
+  each camera runs its own loops on the same pool, such that the cores are
+  not oversubscribed.
+
+  m_cameraData has to be initialized before with initCameraData().
+
+  \sa setNbThreads()
+*/
+void vpMbGenericTracker::computeCameraStage(vpCameraStage stage)
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  if (m_nbThreads != 1 && m_cameraData.size() > 1) {
+    vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(m_cameraData.size()),
+                                                  [&](int start, int end) {
+                                                    for (int i = start; i < end; ++i)
+                                                      computeCameraStage(stage, static_cast<size_t>(i));
+                                                  },
+                                                  m_nbThreads, 1);
+    return;
+  }
+#endif
+
+  for (size_t i = 0; i < m_cameraData.size(); i++) {
+    computeCameraStage(stage, i);
+  }
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Add the contribution of a row of the interaction matrix with the weight wi:
+// LTL += wi^2 Li^T Li on the upper triangle and LTR += wi^2 Li^T ei
+inline void addWeightedRow(const double *Li, double ei, double wi, double *LTL, double *LTR)
+{
+  const double w2 = wi * wi;
+  for (unsigned int r = 0; r < 6; r++) {
+    const double wLr = w2 * Li[r];
+    for (unsigned int c = r; c < 6; c++) {
+      LTL[6 * r + c] += wLr * Li[c];
+    }
+    LTR[r] += wLr * ei;
+  }
+}
+
+inline void addRow(const double *Li, double *LTL)
+{
+  for (unsigned int r = 0; r < 6; r++) {
+    for (unsigned int c = r; c < 6; c++) {
+      LTL[6 * r + c] += Li[r] * Li[c];
+    }
+  }
+}
+
+// Express the normal equations of the camera frame in the reference camera
+// frame: (L cVo)^T W (L cVo) = cVo^T (L^T W L) cVo, the upper triangle of
+// LTL being filled beforehand
+void changeNormalEquationsFrame(const vpVelocityTwistMatrix &cVo, double *LTL, double *LTR)
+{
+  for (unsigned int r = 0; r < 6; r++) {
+    for (unsigned int c = 0; c < r; c++) {
+      LTL[6 * r + c] = LTL[6 * c + r];
+    }
+  }
+
+  double tmp[36];
+  for (unsigned int r = 0; r < 6; r++) {
+    for (unsigned int c = 0; c < 6; c++) {
+      double sum = 0;
+      for (unsigned int k = 0; k < 6; k++) {
+        sum += LTL[6 * r + k] * cVo[k][c];
+      }
+      tmp[6 * r + c] = sum;
+    }
+  }
+  for (unsigned int r = 0; r < 6; r++) {
+    for (unsigned int c = 0; c < 6; c++) {
+      double sum = 0;
+      for (unsigned int k = 0; k < 6; k++) {
+        sum += cVo[k][r] * tmp[6 * k + c];
+      }
+      LTL[6 * r + c] = sum;
+    }
+  }
+
+  if (LTR != NULL) {
+    double g[6];
+    for (unsigned int r = 0; r < 6; r++) {
+      double sum = 0;
+      for (unsigned int k = 0; k < 6; k++) {
+        sum += cVo[k][r] * LTR[k];
+      }
+      g[r] = sum;
+    }
+    for (unsigned int r = 0; r < 6; r++) {
+      LTR[r] = g[r];
+    }
+  }
+}
+
+double getFeatureFactor(const std::map<vpMbGenericTracker::vpTrackerType, double> &factors,
+                        vpMbGenericTracker::vpTrackerType type)
+{
+  std::map<vpMbGenericTracker::vpTrackerType, double>::const_iterator it = factors.find(type);
+  return it != factors.end() ? it->second : 0.0;
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Accumulate the weighted normal equations of a single camera directly from
+  the interaction matrix and the residual computed by its tracker, without
+  stacking them with the ones of the other cameras. The weights are the ones
+  of the stacked path: robust weight times feature type factor, and the
+  edge factor for the moving edges.
+*/
+void vpMbGenericTracker::computeCameraNormalEquations(CameraData &data) const
+{
+  const TrackerWrapper *tracker = data.tracker;
+  const vpMatrix &L = tracker->m_L;
+  const vpColVector &error = tracker->m_error;
+
+  for (unsigned int k = 0; k < 36; k++) {
+    data.LTL[k] = data.LTL_true[k] = 0;
+  }
+  for (unsigned int k = 0; k < 6; k++) {
+    data.LTR[k] = 0;
+  }
+  data.num = data.den = 0;
+
+  unsigned int start_index = 0;
+  for (int type = 0; type < 4; type++) {
+    unsigned int nbRows = 0;
+    double factor = 0;
+    const vpColVector *w = NULL;
+
+    if (type == 0 && (tracker->m_trackerType & EDGE_TRACKER)) {
+      nbRows = tracker->m_error_edge.getRows();
+      factor = getFeatureFactor(m_mapOfFeatureFactors, EDGE_TRACKER);
+      w = &tracker->m_w_edge;
+    }
+#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+    else if (type == 1 && (tracker->m_trackerType & KLT_TRACKER)) {
+      nbRows = tracker->m_error_klt.getRows();
+      factor = getFeatureFactor(m_mapOfFeatureFactors, KLT_TRACKER);
+      w = &tracker->m_w_klt;
+    }
+#endif
+    else if (type == 2 && (tracker->m_trackerType & DEPTH_NORMAL_TRACKER)) {
+      nbRows = tracker->m_error_depthNormal.getRows();
+      factor = getFeatureFactor(m_mapOfFeatureFactors, DEPTH_NORMAL_TRACKER);
+      w = &tracker->m_w_depthNormal;
+    } else if (type == 3 && (tracker->m_trackerType & DEPTH_DENSE_TRACKER)) {
+      nbRows = tracker->m_error_depthDense.getRows();
+      factor = getFeatureFactor(m_mapOfFeatureFactors, DEPTH_DENSE_TRACKER);
+      w = &tracker->m_w_depthDense;
+    }
+
+    for (unsigned int i = 0; i < nbRows; i++) {
+      double wi = (*w)[i] * factor;
+      if (type == 0) {
+        wi *= tracker->m_factor[i];
+      }
+
+      const double ei = error[start_index + i];
+      addWeightedRow(L[start_index + i], ei, wi, data.LTL, data.LTR);
+      if (data.computeLTL_true) {
+        addRow(L[start_index + i], data.LTL_true);
+      }
+
+      data.num += wi * ei * ei;
+      data.den += wi;
+    }
+
+    start_index += nbRows;
+  }
+
+  changeNormalEquationsFrame(data.cVo, data.LTL, data.LTR);
+  if (data.computeLTL_true) {
+    changeNormalEquationsFrame(data.cVo, data.LTL_true, NULL);
+  }
+}
+
+/*!
+  Process a stage of the tracking for a single camera. Only the data owned by
+  the corresponding TrackerWrapper and m_cameraData[index] are modified, such
+  that different cameras can be processed concurrently.
+*/
+void vpMbGenericTracker::computeCameraStage(vpCameraStage stage, size_t index)
+{
+  CameraData &data = m_cameraData[index];
+  TrackerWrapper *tracker = data.tracker;
+
+  switch (stage) {
+  case PRE_TRACKING_STAGE:
+    tracker->preTracking(data.I, data.pointcloud, data.pointcloudWidth, data.pointcloudHeight);
+    break;
+
+#ifdef VISP_HAVE_PCL
+  case PRE_TRACKING_PCL_STAGE:
+    tracker->preTracking(data.I, data.pclPointcloud);
+    break;
+#endif
+
+  case PRE_TRACKING_CONTIGUOUS_STAGE:
+    tracker->preTracking(data.I, data.contiguousPointcloud);
+    break;
+
+  case VVS_INIT_STAGE:
+    tracker->computeVVSInit(data.I);
+    break;
+
+  case VVS_INTERACTION_MATRIX_AND_RESIDU_STAGE: {
+    tracker->m_cMo = data.cMcRef * m_cMo;
+#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+    vpHomogeneousMatrix c_curr_tTc_curr0 = data.cMcRef * m_cMo * tracker->c0Mo.inverse();
+    tracker->ctTc0 = c_curr_tTc_curr0;
+#endif
+
+    tracker->computeVVSInteractionMatrixAndResidu(data.I);
+    if (computeCovariance) {
+      data.L = tracker->m_L * data.cVo;
+    }
+    break;
+  }
+
+  case VVS_WEIGHTS_STAGE:
+    tracker->computeVVSWeights();
+    break;
+
+  case VVS_NORMAL_EQUATIONS_STAGE:
+    computeCameraNormalEquations(data);
+    break;
+
+  case POST_TRACKING_STAGE:
+#ifdef VISP_HAVE_PCL
+  case POST_TRACKING_PCL_STAGE:
+#endif
+    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
+      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
+    }
+
+#ifdef VISP_HAVE_PCL
+    if (stage == POST_TRACKING_PCL_STAGE) {
+      tracker->postTracking(data.I, data.pclPointcloud);
+    } else
+#endif
+    {
+      tracker->postTracking(data.I, data.pointcloudWidth, data.pointcloudHeight);
+    }
+
+    if (displayFeatures) {
+#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+      if (tracker->m_trackerType & KLT_TRACKER) {
+        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
+      }
+#endif
+
+      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
+        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
+      }
+    }
+    break;
+
+  default:
+    break;
+  }
 }
 
 /*!
@@ -3007,15 +3351,71 @@ void vpMbGenericTracker::loadModel(const std::map<std::string, std::string> &map
   }
 }
 
+/*!
+  Fill m_cameraData with the tracker and the image of each camera, in the
+  order of m_mapOfTrackers. The lookups in the maps are done here such that
+  the per camera stages do not modify shared containers.
+*/
+void vpMbGenericTracker::initCameraData(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages)
+{
+  m_cameraData.resize(m_mapOfTrackers.size());
+
+  size_t idx = 0;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it, ++idx) {
+    m_cameraData[idx].tracker = it->second;
+    m_cameraData[idx].I = mapOfImages[it->first];
+  }
+}
+
+#ifdef VISP_HAVE_PCL
+void vpMbGenericTracker::postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                                      std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds)
+{
+  double t = vpTime::measureTimeMs();
+  initCameraData(mapOfImages);
+  size_t idx = 0;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it, ++idx) {
+    m_cameraData[idx].pclPointcloud = mapOfPointClouds[it->first];
+  }
+
+  computeCameraStage(POST_TRACKING_PCL_STAGE);
+  m_mapOfStageTimes["postTracking"] += vpTime::measureTimeMs() - t;
+}
+#endif
+
+void vpMbGenericTracker::postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                                      std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                                      std::map<std::string, unsigned int> &mapOfPointCloudHeights)
+{
+  double t = vpTime::measureTimeMs();
+  initCameraData(mapOfImages);
+  size_t idx = 0;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it, ++idx) {
+    m_cameraData[idx].pointcloudWidth = mapOfPointCloudWidths[it->first];
+    m_cameraData[idx].pointcloudHeight = mapOfPointCloudHeights[it->first];
+  }
+
+  computeCameraStage(POST_TRACKING_STAGE);
+  m_mapOfStageTimes["postTracking"] += vpTime::measureTimeMs() - t;
+}
+
 #ifdef VISP_HAVE_PCL
 void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
                                      std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds)
 {
+  double t = vpTime::measureTimeMs();
+  initCameraData(mapOfImages);
+  size_t idx = 0;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-       it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
+       it != m_mapOfTrackers.end(); ++it, ++idx) {
+    m_cameraData[idx].pclPointcloud = mapOfPointClouds[it->first];
   }
+
+  computeCameraStage(PRE_TRACKING_PCL_STAGE);
+  m_mapOfStageTimes["preTracking"] += vpTime::measureTimeMs() - t;
 }
 #endif
 
@@ -3024,12 +3424,33 @@ void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigne
                                      std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                                      std::map<std::string, unsigned int> &mapOfPointCloudHeights)
 {
+  double t = vpTime::measureTimeMs();
+  initCameraData(mapOfImages);
+  size_t idx = 0;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-       it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first], mapOfPointCloudWidths[it->first],
-                         mapOfPointCloudHeights[it->first]);
+       it != m_mapOfTrackers.end(); ++it, ++idx) {
+    m_cameraData[idx].pointcloud = mapOfPointClouds[it->first];
+    m_cameraData[idx].pointcloudWidth = mapOfPointCloudWidths[it->first];
+    m_cameraData[idx].pointcloudHeight = mapOfPointCloudHeights[it->first];
   }
+
+  computeCameraStage(PRE_TRACKING_STAGE);
+  m_mapOfStageTimes["preTracking"] += vpTime::measureTimeMs() - t;
+}
+
+void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                                     std::map<std::string, const vpPointCloud *> &mapOfPointClouds)
+{
+  double t = vpTime::measureTimeMs();
+  initCameraData(mapOfImages);
+  size_t idx = 0;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it, ++idx) {
+    m_cameraData[idx].contiguousPointcloud = mapOfPointClouds[it->first];
+  }
+
+  computeCameraStage(PRE_TRACKING_CONTIGUOUS_STAGE);
+  m_mapOfStageTimes["preTracking"] += vpTime::measureTimeMs() - t;
 }
 
 /*!
@@ -4373,6 +4794,37 @@ void vpMbGenericTracker::setMovingEdge(const std::map<std::string, vpMe> &mapOfM
   }
 }
 
+/*!
+  Set the number of threads used to process the cameras concurrently. The
+  moving-edge, KLT and depth stages of each camera, the computation of the
+  per camera residuals and interaction matrices and the update of the
+  features after the pose estimation are dispatched on the pool returned by
+  vpThreadPool::getGlobalInstance(). The per camera contributions are always
+  stacked in the same order, such that the estimated pose does not depend on
+  the number of threads.
+
+  The number of threads is also given to the edge tracker of each camera,
+  which tracks the moving edges of its lines concurrently on the same pool.
+  The pool never runs more threads than it owns, whatever the nesting.
+
+  \param nbThreads : Number of threads. If 0 (default), all the threads of
+  the global pool are used. With 1, the cameras are processed sequentially.
+
+  \note Parallel processing requires c++11 or higher. Otherwise, the cameras
+  are always processed sequentially.
+
+  \sa getNbThreads(), getStageTimes(), vpMbEdgeTracker::setNbThreads()
+*/
+void vpMbGenericTracker::setNbThreads(unsigned int nbThreads)
+{
+  m_nbThreads = nbThreads;
+
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    it->second->vpMbEdgeTracker::setNbThreads(nbThreads);
+  }
+}
+
 /*!
   Set the near distance for clipping.
 
@@ -5183,6 +5635,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     }
   }
 
+  resetStageTimes();
   preTracking(mapOfImages, mapOfPointClouds);
 
   try {
@@ -5194,28 +5647,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-       it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointClouds);
 
   computeProjectionError();
 }
@@ -5265,6 +5697,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
     }
   }
 
+  resetStageTimes();
   preTracking(mapOfImages, mapOfPointClouds);
 
   try {
@@ -5276,28 +5709,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-       it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointClouds);
 
   computeProjectionError();
 }
@@ -5345,6 +5757,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     }
   }
 
+  resetStageTimes();
   preTracking(mapOfImages, mapOfPointClouds, mapOfPointCloudWidths, mapOfPointCloudHeights);
 
   try {
@@ -5356,28 +5769,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-       it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
 
   computeProjectionError();
 }
@@ -5431,6 +5823,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
     }
   }
 
+  resetStageTimes();
   preTracking(mapOfImages, mapOfPointClouds, mapOfPointCloudWidths, mapOfPointCloudHeights);
 
   try {
@@ -5442,32 +5835,106 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
 
   testTracking();
 
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
+
+  computeProjectionError();
+}
+
+/*!
+  Realize the tracking of the object in the images and in point clouds whose
+  coordinates are stored in contiguous arrays. The point clouds are neither
+  copied nor converted, see vpPointCloud.
+
+  \throw vpException : if the tracking is supposed to have failed
+
+  \param mapOfImages : Map of images.
+  \param mapOfPointClouds : Map of pointclouds.
+*/
+void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                               std::map<std::string, const vpPointCloud *> &mapOfPointClouds)
+{
+  std::map<std::string, unsigned int> mapOfPointCloudWidths, mapOfPointCloudHeights;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
 
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
+    if ((tracker->m_trackerType & (EDGE_TRACKER |
+#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+                                   KLT_TRACKER |
+#endif
+                                   DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
+      throw vpException(vpException::fatalError, "Bad tracker type: %d", tracker->m_trackerType);
     }
 
-    tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
-
-    if (displayFeatures) {
+    if (tracker->m_trackerType & (EDGE_TRACKER
 #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
+                                  | KLT_TRACKER
 #endif
+                                  ) &&
+        mapOfImages[it->first] == NULL) {
+      throw vpException(vpException::fatalError, "Image pointer is NULL!");
+    }
 
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
+    const vpPointCloud *point_cloud = mapOfPointClouds[it->first];
+    if (tracker->m_trackerType & (DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER) && point_cloud == NULL) {
+      throw vpException(vpException::fatalError, "Pointcloud is NULL!");
     }
+
+    mapOfPointCloudWidths[it->first] = point_cloud != NULL ? point_cloud->getWidth() : 0;
+    mapOfPointCloudHeights[it->first] = point_cloud != NULL ? point_cloud->getHeight() : 0;
   }
 
+  resetStageTimes();
+  preTracking(mapOfImages, mapOfPointClouds);
+
+  try {
+    computeVVS(mapOfImages);
+  } catch (...) {
+    covarianceMatrix = -1;
+    throw; // throw the original exception
+  }
+
+  testTracking();
+
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
+
   computeProjectionError();
 }
 
+/*!
+  Realize the tracking of the object in the color images and in point clouds
+  whose coordinates are stored in contiguous arrays. The point clouds are
+  neither copied nor converted, see vpPointCloud.
+
+  \throw vpException : if the tracking is supposed to have failed
+
+  \param mapOfColorImages : Map of images.
+  \param mapOfPointClouds : Map of pointclouds.
+*/
+void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &mapOfColorImages,
+                               std::map<std::string, const vpPointCloud *> &mapOfPointClouds)
+{
+  std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    const vpImage<vpRGBa> *I_color = mapOfColorImages[it->first];
+
+    if (tracker->m_trackerType & (EDGE_TRACKER
+#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+                                  | KLT_TRACKER
+#endif
+                                  ) && I_color != NULL) {
+      vpImageConvert::convert(*I_color, tracker->m_I);
+      mapOfImages[it->first] = &tracker->m_I; // update grayscale image buffer
+    } else {
+      mapOfImages[it->first] = NULL;
+    }
+  }
+
+  track(mapOfImages, mapOfPointClouds);
+}
+
 /** TrackerWrapper **/
 vpMbGenericTracker::TrackerWrapper::TrackerWrapper()
   : m_error(), m_L(), m_trackerType(EDGE_TRACKER), m_w(), m_weightedError()
@@ -6519,6 +6986,48 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
   }
 }
 
+void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char> *const ptr_I,
+                                                     const vpPointCloud *const point_cloud)
+{
+  if (m_trackerType & EDGE_TRACKER) {
+    try {
+      vpMbEdgeTracker::trackMovingEdge(*ptr_I);
+    } catch (...) {
+      std::cerr << "Error in moving edge tracking" << std::endl;
+      throw;
+    }
+  }
+
+#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+  if (m_trackerType & KLT_TRACKER) {
+    try {
+      vpMbKltTracker::preTracking(*ptr_I);
+    } catch (const vpException &e) {
+      std::cerr << "Error in KLT tracking: " << e.what() << std::endl;
+      throw;
+    }
+  }
+#endif
+
+  if (m_trackerType & DEPTH_NORMAL_TRACKER) {
+    try {
+      vpMbDepthNormalTracker::segmentPointCloud(*point_cloud);
+    } catch (...) {
+      std::cerr << "Error in Depth tracking" << std::endl;
+      throw;
+    }
+  }
+
+  if (m_trackerType & DEPTH_DENSE_TRACKER) {
+    try {
+      vpMbDepthDenseTracker::segmentPointCloud(*point_cloud);
+    } catch (...) {
+      std::cerr << "Error in Depth dense tracking" << std::endl;
+      throw;
+    }
+  }
+}
+
 void vpMbGenericTracker::TrackerWrapper::reInitModel(const vpImage<unsigned char> * const I, const vpImage<vpRGBa> * const I_color,
                                                      const std::string &cad_name, const vpHomogeneousMatrix &cMo, bool verbose,
                                                      const vpHomogeneousMatrix &T)
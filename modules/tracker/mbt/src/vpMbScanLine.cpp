@@ -45,10 +45,12 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstring>
 #include <iostream>
 #include <utility>
 
 #include <visp3/core/vpMeterPixelConversion.h>
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/mbt/vpMbScanLine.h>
 
 #if defined(DEBUG_DISP)
@@ -58,8 +60,23 @@
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
+namespace
+{
+// Number of scanlines of a band
+const unsigned int bandSize = 16;
+
+bool compareLine(const std::pair<unsigned int, vpMbScanLine::vpMbScanLineSegment> &a,
+                 const std::pair<unsigned int, vpMbScanLine::vpMbScanLineSegment> &b)
+{
+  return a.first < b.first;
+}
+}
+
 vpMbScanLine::vpMbScanLine()
-  : w(0), h(0), K(), maskBorder(0), mask(), primitive_ids(), visibility_samples(), depthTreshold(1e-06)
+  : w(0), h(0), K(), maskBorder(0), mask(), primitive_ids(), depthTreshold(1e-06), m_nbThreads(0), m_rendered(false),
+    m_renderedMaskBorder(0), m_renderedDepthTreshold(0), m_points(), m_projections(), m_polygonBegin(),
+    m_polygonIds(), m_edgeIds(), m_extents(), m_edgeIndex(), m_bands(), m_maskX(), m_maskY(), m_edgeSampleBegin(),
+    m_edgeSamples()
 #if defined(DEBUG_DISP)
     ,
     dispMaskDebug(NULL), dispLineDebug(NULL), linedebugImg()
@@ -84,17 +101,19 @@ vpMbScanLine::~vpMbScanLine()
 #endif
 }
 /*!
-  Compute the intersections between Y-axis scanlines and a given line (two
-  points polygon).
+  Compute the intersections between the Y-axis scanlines of a band and a
+  given line (two points polygon).
 
   \param a : First point of the line.
   \param b : Second point of the line.
-  \param edge : Pair with the two points of the line.
+  \param edge : Index of the line in the edges of the scene.
   \param ID : Id of the given line (has to be know when using queries).
-  \param scanlines : Resulting intersections.
+  \param band : Band of scanlines.
+  \param scanlines : Resulting intersections, with the index of their
+  scanline in the band.
 */
-void vpMbScanLine::drawLineY(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &edge, const int ID,
-                             std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
+void vpMbScanLine::drawLineY(const double *a, const double *b, const int edge, const int ID, vpMbScanLineBand &band,
+                             std::vector<std::pair<unsigned int, vpMbScanLineSegment> > &scanlines)
 {
   double x0 = a[0] / a[2];
   double y0 = a[1] / a[2];
@@ -112,8 +131,8 @@ void vpMbScanLine::drawLineY(const vpColVector &a, const vpColVector &b, const v
   if (y0 >= h - 1 || y1 < 0 || std::fabs(y1 - y0) <= std::numeric_limits<double>::epsilon())
     return;
 
-  const unsigned int _y0 = (std::max)((unsigned int)0, (unsigned int)(std::ceil(y0)));
-  const double _y1 = (std::min)((double)h, (double)y1);
+  const unsigned int _y0 = (std::max)(band.first, (unsigned int)((std::max)(0.0, std::ceil(y0))));
+  const double _y1 = (std::min)((double)band.last, (double)y1);
 
   const bool b_sample_Y = (std::fabs(y0 - y1) > std::fabs(x0 - x1));
 
@@ -128,22 +147,24 @@ void vpMbScanLine::drawLineY(const vpColVector &a, const vpColVector &b, const v
     s.ID = ID;
     s.edge = edge;
     s.b_sample_Y = b_sample_Y;
-    scanlines[y].push_back(s);
+    scanlines.push_back(std::make_pair(y - band.first, s));
   }
 }
 
 /*!
-  Compute the intersections between X-axis scanlines and a given line (two
-  points polygon).
+  Compute the intersections between the X-axis scanlines of a band and a
+  given line (two points polygon).
 
   \param a : First point of the line.
   \param b : Second point of the line.
-  \param edge : Pair with the two points of the line.
+  \param edge : Index of the line in the edges of the scene.
   \param ID : Id of the given line (has to be know when using queries).
-  \param scanlines : Resulting intersections.
+  \param band : Band of scanlines.
+  \param scanlines : Resulting intersections, with the index of their
+  scanline in the band.
 */
-void vpMbScanLine::drawLineX(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &edge, const int ID,
-                             std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
+void vpMbScanLine::drawLineX(const double *a, const double *b, const int edge, const int ID, vpMbScanLineBand &band,
+                             std::vector<std::pair<unsigned int, vpMbScanLineSegment> > &scanlines)
 {
   double x0 = a[0] / a[2];
   double y0 = a[1] / a[2];
@@ -161,8 +182,8 @@ void vpMbScanLine::drawLineX(const vpColVector &a, const vpColVector &b, const v
   if (x0 >= w - 1 || x1 < 0 || std::fabs(x1 - x0) <= std::numeric_limits<double>::epsilon())
     return;
 
-  const unsigned int _x0 = (std::max)((unsigned int)0, (unsigned int)(std::ceil(x0)));
-  const double _x1 = (std::min)((double)w, (double)x1);
+  const unsigned int _x0 = (std::max)(band.first, (unsigned int)((std::max)(0.0, std::ceil(x0))));
+  const double _x1 = (std::min)((double)band.last, (double)x1);
 
   const bool b_sample_Y = (std::fabs(y0 - y1) > std::fabs(x0 - x1));
 
@@ -177,99 +198,71 @@ void vpMbScanLine::drawLineX(const vpColVector &a, const vpColVector &b, const v
     s.ID = ID;
     s.edge = edge;
     s.b_sample_Y = b_sample_Y;
-    scanlines[x].push_back(s);
+    scanlines.push_back(std::make_pair(x - band.first, s));
   }
 }
 
 /*!
-  Compute the Y-axis scanlines intersections of a polygon.
+  Compute the intersections of a polygon with the scanlines of a band.
 
-  \param polygon : Polygon composed by an array of lines.
-  \param ID : ID of the polygon (has to be know when using queries).
-  \param scanlines : Resulting intersections.
+  \param polygon : Index of the polygon in the scene.
+  \param band : Band of scanlines, whose buffer of intersections is completed.
 */
-void vpMbScanLine::drawPolygonY(const std::vector<std::pair<vpPoint, unsigned int> > &polygon, const int ID,
-                                std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
+void vpMbScanLine::drawPolygon(unsigned int polygon, vpMbScanLineBand &band)
 {
-  if (polygon.size() < 2)
-    return;
-
-  if (polygon.size() == 2) {
-    vpColVector p1, p2;
-    createVectorFromPoint(polygon.front().first, p1, K);
-    createVectorFromPoint(polygon.back().first, p2, K);
-
-    drawLineY(p1, p2, makeMbScanLineEdge(polygon.front().first, polygon.back().first), ID, scanlines);
-    return;
-  }
-
-  std::vector<std::vector<vpMbScanLineSegment> > local_scanlines;
-  local_scanlines.resize(h);
-
-  for (size_t i = 0; i < polygon.size(); ++i) {
-    vpColVector p1, p2;
-    createVectorFromPoint(polygon[i].first, p1, K);
-    createVectorFromPoint(polygon[(i + 1) % polygon.size()].first, p2, K);
-
-    drawLineY(p1, p2, makeMbScanLineEdge(polygon[i].first, polygon[(i + 1) % polygon.size()].first), ID,
-              local_scanlines);
-  }
+  const unsigned int begin = m_polygonBegin[polygon];
+  const unsigned int size = m_polygonBegin[polygon + 1] - begin;
+  const int ID = m_polygonIds[polygon];
 
-  createScanLinesFromLocals(scanlines, local_scanlines, h);
-}
-
-/*!
-  Compute the X-axis scanlines intersections of a polygon.
-
-  \param polygon : Polygon composed by an array of lines.
-  \param ID : ID of the polygon (has to be know when using queries).
-  \param scanlines : Resulting intersections.
-*/
-void vpMbScanLine::drawPolygonX(const std::vector<std::pair<vpPoint, unsigned int> > &polygon, const int ID,
-                                std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
-{
-  if (polygon.size() < 2)
+  if (size < 2)
     return;
 
-  if (polygon.size() == 2) {
-    vpColVector p1, p2;
-    createVectorFromPoint(polygon.front().first, p1, K);
-    createVectorFromPoint(polygon.back().first, p2, K);
-
-    drawLineX(p1, p2, makeMbScanLineEdge(polygon.front().first, polygon.back().first), ID, scanlines);
+  if (size == 2) {
+    const double *p1 = &m_projections[3 * begin];
+    const double *p2 = &m_projections[3 * (begin + 1)];
+    if (band.b_Y)
+      drawLineY(p1, p2, m_edgeIds[begin], ID, band, band.raw);
+    else
+      drawLineX(p1, p2, m_edgeIds[begin], ID, band, band.raw);
     return;
   }
 
-  std::vector<std::vector<vpMbScanLineSegment> > local_scanlines;
-  local_scanlines.resize(w);
-
-  for (size_t i = 0; i < polygon.size(); ++i) {
-    vpColVector p1, p2;
-    createVectorFromPoint(polygon[i].first, p1, K);
-    createVectorFromPoint(polygon[(i + 1) % polygon.size()].first, p2, K);
-
-    drawLineX(p1, p2, makeMbScanLineEdge(polygon[i].first, polygon[(i + 1) % polygon.size()].first), ID,
-              local_scanlines);
+  band.local.clear();
+  for (unsigned int i = 0; i < size; ++i) {
+    const double *p1 = &m_projections[3 * (begin + i)];
+    const double *p2 = &m_projections[3 * (begin + (i + 1) % size)];
+    if (band.b_Y)
+      drawLineY(p1, p2, m_edgeIds[begin + i], ID, band, band.local);
+    else
+      drawLineX(p1, p2, m_edgeIds[begin + i], ID, band, band.local);
   }
 
-  createScanLinesFromLocals(scanlines, local_scanlines, w);
+  createScanLinesFromLocals(band);
 }
 
 /*!
-  Organise local scanlines in a global scanline vector.
+  Organise the intersections of a polygon with the scanlines of a band in the
+  buffer of the band.
   It also marks the computed intersections as starting or ending points.
-  This function will only be called by the drawPolygons functions.
+  This function will only be called by drawPolygon().
 
-  \param scanlines : Global scanline vector.
-  \param localScanlines : Local scanline vector (X or Y-axis).
-  \param size : Corresponding size (typically the width or the height).
+  \param band : Band of scanlines.
 */
-void vpMbScanLine::createScanLinesFromLocals(std::vector<std::vector<vpMbScanLineSegment> > &scanlines,
-                                             std::vector<std::vector<vpMbScanLineSegment> > &localScanlines,
-                                             const unsigned int &size)
+void vpMbScanLine::createScanLinesFromLocals(vpMbScanLineBand &band)
 {
-  for (unsigned int j = 0; j < size; ++j) {
-    std::vector<vpMbScanLineSegment> &scanline = localScanlines[j];
+  std::vector<std::pair<unsigned int, vpMbScanLineSegment> > &local = band.local;
+  std::stable_sort(local.begin(), local.end(), compareLine);
+
+  size_t first = 0;
+  while (first < local.size()) {
+    size_t last = first + 1;
+    while (last < local.size() && local[last].first == local[first].first)
+      ++last;
+
+    std::vector<vpMbScanLineSegment> &scanline = band.segments;
+    scanline.clear();
+    for (size_t i = first; i < last; ++i)
+      scanline.push_back(local[i].second);
     sort(scanline.begin(), scanline.end(),
          vpMbScanLineSegmentComparator()); // Not sure its necessary
 
@@ -281,7 +274,7 @@ void vpMbScanLine::createScanLinesFromLocals(std::vector<std::vector<vpMbScanLin
         s.P1 = s.p * s.Z1;
         b_start = false;
       } else {
-        vpMbScanLineSegment &prev = scanlines[j].back();
+        vpMbScanLineSegment &prev = band.raw.back().second;
         s.type = END;
         s.P1 = prev.P1;
         s.Z1 = prev.Z1;
@@ -290,56 +283,79 @@ void vpMbScanLine::createScanLinesFromLocals(std::vector<std::vector<vpMbScanLin
         prev.Z2 = s.Z2;
         b_start = true;
       }
-      scanlines[j].push_back(s);
+      band.raw.push_back(std::make_pair(local[first].first, s));
     }
+    first = last;
   }
 }
 
 /*!
-  Render a scene of polygons and compute scanlines intersections in order to
-  use queries.
+  Render the scanlines of a band: compute the intersections of the polygons
+  with the scanlines, then the visible parts of the polygons and of the
+  edges.
 
-  \param polygons : List of polygons composed by arrays of lines.
-  \param listPolyIndices : List of polygons IDs (has to be know when using
-  queries). \param cam : Camera parameters. \param width : Width of the image
-  (render window). \param height : Height of the image (render window).
+  \param band : Band of scanlines.
 */
-void vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, unsigned int> > *> &polygons,
-                             std::vector<int> listPolyIndices, const vpCameraParameters &cam, unsigned int width,
-                             unsigned int height)
+void vpMbScanLine::drawBand(vpMbScanLineBand &band)
 {
-  this->w = width;
-  this->h = height;
-  this->K = cam;
-
-  visibility_samples.clear();
-
-  std::vector<std::vector<vpMbScanLineSegment> > scanlinesY;
-  scanlinesY.resize(h);
-  std::vector<std::vector<vpMbScanLineSegment> > scanlinesX;
-  scanlinesX.resize(w);
-
-  mask.resize(h, w, 0);
-
-  vpImage<unsigned char> maskY(h, w, 0);
-  vpImage<unsigned char> maskX(h, w, 0);
-
-  primitive_ids.resize(h, w, -1);
+  if (band.b_Y) {
+    for (unsigned int y = band.first; y < band.last; ++y) {
+      std::fill(primitive_ids[y], primitive_ids[y] + w, -1);
+      std::fill(mask[y], mask[y] + w, 0);
+      std::fill(m_maskY[y], m_maskY[y] + w, 0);
+    }
+  } else if (maskBorder != 0) {
+    for (unsigned int y = 0; y < h; ++y)
+      std::fill(m_maskX[y] + band.first, m_maskX[y] + band.last, 0);
+  }
 
-  for (unsigned int ID = 0; ID < polygons.size(); ++ID) {
-    drawPolygonY(*(polygons[ID]), listPolyIndices[ID], scanlinesY);
-    drawPolygonX(*(polygons[ID]), listPolyIndices[ID], scanlinesX);
+  band.raw.clear();
+  for (unsigned int i = 0; i + 1 < m_polygonBegin.size(); ++i) {
+    const double *extent = &m_extents[4 * i + (band.b_Y ? 0 : 2)];
+    if (extent[1] < band.first || extent[0] > band.last)
+      continue;
+    drawPolygon(i, band);
   }
 
-  // Y
-  int last_ID = -1;
-  vpMbScanLineSegment last_visible;
-  for (unsigned int y = 0; y < scanlinesY.size(); ++y) {
-    std::vector<vpMbScanLineSegment> &scanline = scanlinesY[y];
-    sort(scanline.begin(), scanline.end(), vpMbScanLineSegmentComparator());
+  // Group the intersections by scanline, keeping the order of the polygons
+  const unsigned int nbLines = band.last - band.first;
+  band.lineBegin.assign(nbLines + 1, 0);
+  for (size_t i = 0; i < band.raw.size(); ++i)
+    band.lineBegin[band.raw[i].first + 1]++;
+  for (unsigned int j = 0; j < nbLines; ++j)
+    band.lineBegin[j + 1] += band.lineBegin[j];
+  band.segments.resize(band.raw.size());
+  for (size_t i = 0; i < band.raw.size(); ++i)
+    band.segments[band.lineBegin[band.raw[i].first]++] = band.raw[i].second;
+  for (unsigned int j = nbLines; j > 0; --j)
+    band.lineBegin[j] = band.lineBegin[j - 1];
+  band.lineBegin[0] = 0;
+
+  band.samples.clear();
+  if (band.b_Y)
+    renderLinesY(band);
+  else
+    renderLinesX(band);
+}
 
-    std::vector<std::pair<double, vpMbScanLineSegment> > stack;
-    for (size_t i = 0; i < scanline.size(); ++i) {
+/*!
+  Compute the visible polygons along the Y-axis scanlines of a band, and the
+  visible samples of the edges that are sampled along the Y-axis.
+
+  \param band : Band of Y-axis scanlines.
+*/
+void vpMbScanLine::renderLinesY(vpMbScanLineBand &band)
+{
+  std::vector<std::pair<double, vpMbScanLineSegment> > &stack = band.stack;
+  for (unsigned int y = band.first; y < band.last; ++y) {
+    vpMbScanLineSegment *scanline = band.segments.empty() ? NULL : &band.segments[0] + band.lineBegin[y - band.first];
+    const size_t size = band.lineBegin[y - band.first + 1] - band.lineBegin[y - band.first];
+    std::sort(scanline, scanline + size, vpMbScanLineSegmentComparator());
+
+    int last_ID = -1;
+    vpMbScanLineSegment last_visible;
+    stack.clear();
+    for (size_t i = 0; i < size; ++i) {
       const vpMbScanLineSegment &s = scanline[i];
 
       switch (s.type) {
@@ -363,7 +379,7 @@ void vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, un
         const vpMbScanLineSegment &s0 = stack[j].second;
         stack[j].first = mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
       }
-      sort(stack.begin(), stack.end(), vpMbScanLineSegmentComparator());
+      std::iter_swap(stack.begin(), std::min_element(stack.begin(), stack.end(), vpMbScanLineSegmentComparator()));
 
       int new_ID = stack.empty() ? -1 : stack.front().second.ID;
 
@@ -372,27 +388,27 @@ void vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, un
           switch (s.type) {
           case POINT:
             if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
-              visibility_samples[s.edge].insert((int)y);
+              band.samples.push_back(std::make_pair(s.edge, (int)y));
             break;
           case START:
             if (new_ID == s.ID)
-              visibility_samples[s.edge].insert((int)y);
+              band.samples.push_back(std::make_pair(s.edge, (int)y));
             break;
           case END:
             if (last_ID == s.ID)
-              visibility_samples[s.edge].insert((int)y);
+              band.samples.push_back(std::make_pair(s.edge, (int)y));
             break;
           }
 
         // This part will only be used for MbKltTracking
         if (last_ID != -1) {
-          const unsigned int x0 = (std::max)((unsigned int)0, (unsigned int)(std::ceil(last_visible.p)));
+          const unsigned int x0 = (unsigned int)((std::max)(0.0, std::ceil(last_visible.p)));
           double x1 = (std::min)((double)w, (double)s.p);
           for (unsigned int x = x0 + maskBorder; x < x1 - maskBorder; ++x) {
             primitive_ids[(unsigned int)y][(unsigned int)x] = last_visible.ID;
 
             if (maskBorder != 0)
-              maskY[(unsigned int)y][(unsigned int)x] = 255;
+              m_maskY[(unsigned int)y][(unsigned int)x] = 255;
             else
               mask[(unsigned int)y][(unsigned int)x] = 255;
           }
@@ -406,15 +422,26 @@ void vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, un
       }
     }
   }
+}
 
-  // X
-  last_ID = -1;
-  for (unsigned int x = 0; x < scanlinesX.size(); ++x) {
-    std::vector<vpMbScanLineSegment> &scanline = scanlinesX[x];
-    sort(scanline.begin(), scanline.end(), vpMbScanLineSegmentComparator());
+/*!
+  Compute the visible polygons along the X-axis scanlines of a band, and the
+  visible samples of the edges that are sampled along the X-axis.
 
-    std::vector<std::pair<double, vpMbScanLineSegment> > stack;
-    for (size_t i = 0; i < scanline.size(); ++i) {
+  \param band : Band of X-axis scanlines.
+*/
+void vpMbScanLine::renderLinesX(vpMbScanLineBand &band)
+{
+  std::vector<std::pair<double, vpMbScanLineSegment> > &stack = band.stack;
+  for (unsigned int x = band.first; x < band.last; ++x) {
+    vpMbScanLineSegment *scanline = band.segments.empty() ? NULL : &band.segments[0] + band.lineBegin[x - band.first];
+    const size_t size = band.lineBegin[x - band.first + 1] - band.lineBegin[x - band.first];
+    std::sort(scanline, scanline + size, vpMbScanLineSegmentComparator());
+
+    int last_ID = -1;
+    vpMbScanLineSegment last_visible;
+    stack.clear();
+    for (size_t i = 0; i < size; ++i) {
       const vpMbScanLineSegment &s = scanline[i];
 
       switch (s.type) {
@@ -438,7 +465,7 @@ void vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, un
         const vpMbScanLineSegment &s0 = stack[j].second;
         stack[j].first = mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
       }
-      sort(stack.begin(), stack.end(), vpMbScanLineSegmentComparator());
+      std::iter_swap(stack.begin(), std::min_element(stack.begin(), stack.end(), vpMbScanLineSegmentComparator()));
 
       int new_ID = stack.empty() ? -1 : stack.front().second.ID;
 
@@ -447,26 +474,26 @@ void vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, un
           switch (s.type) {
           case POINT:
             if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
-              visibility_samples[s.edge].insert((int)x);
+              band.samples.push_back(std::make_pair(s.edge, (int)x));
             break;
           case START:
             if (new_ID == s.ID)
-              visibility_samples[s.edge].insert((int)x);
+              band.samples.push_back(std::make_pair(s.edge, (int)x));
             break;
           case END:
             if (last_ID == s.ID)
-              visibility_samples[s.edge].insert((int)x);
+              band.samples.push_back(std::make_pair(s.edge, (int)x));
             break;
           }
 
         // This part will only be used for MbKltTracking
         if (maskBorder != 0 && last_ID != -1) {
-          const unsigned int y0 = (std::max)((unsigned int)0, (unsigned int)(std::ceil(last_visible.p)));
+          const unsigned int y0 = (unsigned int)((std::max)(0.0, std::ceil(last_visible.p)));
           double y1 = (std::min)((double)h, (double)s.p);
           for (unsigned int y = y0 + maskBorder; y < y1 - maskBorder; ++y) {
             // primitive_ids[(unsigned int)y][(unsigned int)x] =
             // last_visible.ID;
-            maskX[(unsigned int)y][(unsigned int)x] = 255;
+            m_maskX[(unsigned int)y][(unsigned int)x] = 255;
           }
         }
 
@@ -478,12 +505,249 @@ void vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, un
       }
     }
   }
+}
+
+/*!
+  Mark as dirty the bands crossed by a polygon.
+
+  \param y_min, y_max : Bounds of the polygon along the Y-axis in pixels.
+  \param x_min, x_max : Bounds of the polygon along the X-axis in pixels.
+*/
+void vpMbScanLine::markDirtyBands(double y_min, double y_max, double x_min, double x_max)
+{
+  for (size_t i = 0; i < m_bands.size(); ++i) {
+    vpMbScanLineBand &band = m_bands[i];
+    const double lower = band.b_Y ? y_min : x_min;
+    const double upper = band.b_Y ? y_max : x_max;
+    if (!(upper + 1 < band.first || lower - 1 > band.last))
+      band.dirty = true;
+  }
+}
+
+/*!
+  Rebuild the edge index from the current polygons, so that the edges of the
+  polygons that moved do not pile up in it. The samples of the bands that are
+  not rendered again only belong to the polygons that did not move: their ids
+  are renumbered.
+
+  \param polygons : List of polygons composed by arrays of lines.
+  \param moved : True for the polygons that differ from the previous call.
+*/
+void vpMbScanLine::updateEdgeIndex(const std::vector<std::vector<std::pair<vpPoint, unsigned int> > *> &polygons,
+                                   const std::vector<bool> &moved)
+{
+  std::map<vpMbScanLineEdge, int, vpMbScanLineEdgeComparator> edgeIndex;
+  std::vector<int> newIds(m_edgeIndex.size(), -1);
+  for (unsigned int i = 0; i < polygons.size(); ++i) {
+    const unsigned int begin = m_polygonBegin[i];
+    const unsigned int size = m_polygonBegin[i + 1] - begin;
+    for (unsigned int j = 0; j < size && (size > 2 || j == 0); ++j) {
+      const vpPoint &P = (*polygons[i])[j].first;
+      const vpPoint &Q = (*polygons[i])[(j + 1) % size].first;
+      std::pair<std::map<vpMbScanLineEdge, int, vpMbScanLineEdgeComparator>::iterator, bool> edge =
+          edgeIndex.insert(std::make_pair(makeMbScanLineEdge(P, Q), (int)edgeIndex.size()));
+      if (!moved[i])
+        newIds[(size_t)m_edgeIds[begin + j]] = edge.first->second;
+      m_edgeIds[begin + j] = edge.first->second;
+    }
+  }
+  m_edgeIndex.swap(edgeIndex);
+
+  for (size_t i = 0; i < m_bands.size(); ++i) {
+    std::vector<std::pair<int, int> > &samples = m_bands[i].samples;
+    if (m_bands[i].dirty)
+      continue;
+    size_t nbSamples = 0;
+    for (size_t j = 0; j < samples.size(); ++j) {
+      const int id = newIds[(size_t)samples[j].first];
+      if (id >= 0)
+        samples[nbSamples++] = std::make_pair(id, samples[j].second);
+    }
+    samples.resize(nbSamples);
+  }
+}
+
+/*!
+  Render a scene of polygons and compute scanlines intersections in order to
+  use queries.
+
+  Only the bands of scanlines crossed by the polygons that differ from the
+  previous call are rendered again, unless the camera parameters, the size of
+  the image, the mask border, the depth threshold or the list of polygons
+  changed.
+
+  \param polygons : List of polygons composed by arrays of lines.
+  \param listPolyIndices : List of polygons IDs (has to be know when using
+  queries). \param cam : Camera parameters. \param width : Width of the image
+  (render window). \param height : Height of the image (render window).
+*/
+void vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, unsigned int> > *> &polygons,
+                             std::vector<int> listPolyIndices, const vpCameraParameters &cam, unsigned int width,
+                             unsigned int height)
+{
+  std::vector<unsigned int> polygonBegin(polygons.size() + 1, 0);
+  for (size_t i = 0; i < polygons.size(); ++i)
+    polygonBegin[i + 1] = polygonBegin[i] + (unsigned int)polygons[i]->size();
+
+  std::vector<double> points(3 * polygonBegin.back());
+  for (size_t i = 0; i < polygons.size(); ++i)
+    for (size_t j = 0; j < polygons[i]->size(); ++j) {
+      const vpPoint &P = (*polygons[i])[j].first;
+      double *point = &points[3 * (polygonBegin[i] + j)];
+      point[0] = P.get_X();
+      point[1] = P.get_Y();
+      point[2] = P.get_Z();
+    }
+
+  const bool full = !m_rendered || width != w || height != h || cam.get_px() < K.get_px() ||
+                    cam.get_px() > K.get_px() || cam.get_py() < K.get_py() || cam.get_py() > K.get_py() ||
+                    cam.get_u0() < K.get_u0() || cam.get_u0() > K.get_u0() || cam.get_v0() < K.get_v0() ||
+                    cam.get_v0() > K.get_v0() || maskBorder != m_renderedMaskBorder ||
+                    depthTreshold < m_renderedDepthTreshold || depthTreshold > m_renderedDepthTreshold ||
+                    polygonBegin != m_polygonBegin || listPolyIndices != m_polygonIds;
+
+  this->w = width;
+  this->h = height;
+  this->K = cam;
+
+  if (full) {
+    m_edgeIndex.clear();
+    m_polygonBegin = polygonBegin;
+    m_polygonIds = listPolyIndices;
+    m_projections.resize(points.size());
+    m_edgeIds.resize(polygonBegin.back());
+    m_extents.resize(4 * polygons.size());
+
+    m_bands.clear();
+    for (unsigned int first = 0; first < h; first += bandSize) {
+      vpMbScanLineBand band;
+      band.first = first;
+      band.last = (std::min)(h, first + bandSize);
+      m_bands.push_back(band);
+    }
+    for (unsigned int first = 0; first < w; first += bandSize) {
+      vpMbScanLineBand band;
+      band.b_Y = false;
+      band.first = first;
+      band.last = (std::min)(w, first + bandSize);
+      m_bands.push_back(band);
+    }
+
+    mask.resize(h, w, 0);
+    primitive_ids.resize(h, w, -1);
+    m_maskX.resize(h, w, 0);
+    m_maskY.resize(h, w, 0);
+  }
+
+  bool changed = full;
+  std::vector<bool> moved(polygons.size(), full);
+  for (unsigned int i = 0; i < polygons.size(); ++i) {
+    const unsigned int begin = polygonBegin[i];
+    const unsigned int size = polygonBegin[i + 1] - begin;
+    double *extent = &m_extents[4 * i];
+    if (!full) {
+      if (size == 0 || std::memcmp(&points[3 * begin], &m_points[3 * begin], 3 * size * sizeof(double)) == 0)
+        continue;
+      markDirtyBands(extent[0], extent[1], extent[2], extent[3]);
+      changed = true;
+      moved[i] = true;
+    }
+
+    extent[0] = extent[2] = std::numeric_limits<double>::max();
+    extent[1] = extent[3] = -std::numeric_limits<double>::max();
+    bool b_undefined = false;
+    for (unsigned int j = 0; j < size; ++j) {
+      const vpPoint &P = (*polygons[i])[j].first;
+      double *projection = &m_projections[3 * (begin + j)];
+      projection[0] = P.get_X() * K.get_px() + K.get_u0() * P.get_Z();
+      projection[1] = P.get_Y() * K.get_py() + K.get_v0() * P.get_Z();
+      projection[2] = P.get_Z();
+
+      const double x = projection[0] / projection[2];
+      const double y = projection[1] / projection[2];
+      if (vpMath::isNaN(x) || vpMath::isNaN(y) || vpMath::isInf(x) || vpMath::isInf(y)) {
+        b_undefined = true;
+      } else {
+        extent[0] = (std::min)(extent[0], y);
+        extent[1] = (std::max)(extent[1], y);
+        extent[2] = (std::min)(extent[2], x);
+        extent[3] = (std::max)(extent[3], x);
+      }
+
+      if (full && (size > 2 || j == 0)) {
+        const vpPoint &Q = (*polygons[i])[(j + 1) % size].first;
+        std::pair<std::map<vpMbScanLineEdge, int, vpMbScanLineEdgeComparator>::iterator, bool> edge =
+            m_edgeIndex.insert(std::make_pair(makeMbScanLineEdge(P, Q), (int)m_edgeIndex.size()));
+        m_edgeIds[begin + j] = edge.first->second;
+      }
+    }
+    // A polygon whose projection is not defined crosses all the bands
+    if (b_undefined) {
+      extent[0] = extent[2] = -std::numeric_limits<double>::max();
+      extent[1] = extent[3] = std::numeric_limits<double>::max();
+    }
+    if (!full)
+      markDirtyBands(extent[0], extent[1], extent[2], extent[3]);
+  }
+  m_points.swap(points);
+  m_rendered = true;
+  m_renderedMaskBorder = maskBorder;
+  m_renderedDepthTreshold = depthTreshold;
+
+  if (!changed)
+    return;
+  if (!full)
+    updateEdgeIndex(polygons, moved);
+
+  std::vector<unsigned int> dirtyBands;
+  for (unsigned int i = 0; i < m_bands.size(); ++i)
+    if (m_bands[i].dirty)
+      dirtyBands.push_back(i);
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(dirtyBands.size()),
+                                                [&](int start, int end) {
+                                                  for (int i = start; i < end; ++i)
+                                                    drawBand(m_bands[dirtyBands[static_cast<size_t>(i)]]);
+                                                },
+                                                m_nbThreads, 1);
+#else
+  for (size_t i = 0; i < dirtyBands.size(); ++i)
+    drawBand(m_bands[dirtyBands[i]]);
+#endif
+
+  for (size_t i = 0; i < dirtyBands.size(); ++i)
+    m_bands[dirtyBands[i]].dirty = false;
 
   if (maskBorder != 0)
     for (unsigned int i = 0; i < h; i++)
       for (unsigned int j = 0; j < w; j++)
-        if (maskX[i][j] == 255 && maskY[i][j] == 255)
-          mask[i][j] = 255;
+        mask[i][j] = (m_maskX[i][j] == 255 && m_maskY[i][j] == 255) ? 255 : 0;
+
+  // Gather the visible samples of each edge, sorted and without duplicates
+  const size_t nbEdges = m_edgeIndex.size();
+  m_edgeSampleBegin.assign(nbEdges + 1, 0);
+  for (size_t i = 0; i < m_bands.size(); ++i)
+    for (size_t j = 0; j < m_bands[i].samples.size(); ++j)
+      m_edgeSampleBegin[m_bands[i].samples[j].first + 1]++;
+  for (size_t e = 0; e < nbEdges; ++e)
+    m_edgeSampleBegin[e + 1] += m_edgeSampleBegin[e];
+  m_edgeSamples.resize(m_edgeSampleBegin.back());
+  for (size_t i = 0; i < m_bands.size(); ++i)
+    for (size_t j = 0; j < m_bands[i].samples.size(); ++j)
+      m_edgeSamples[m_edgeSampleBegin[m_bands[i].samples[j].first]++] = m_bands[i].samples[j].second;
+  unsigned int nbSamples = 0, begin = 0;
+  for (size_t e = 0; e < nbEdges; ++e) {
+    const unsigned int end = m_edgeSampleBegin[e];
+    std::sort(m_edgeSamples.begin() + begin, m_edgeSamples.begin() + end);
+    m_edgeSampleBegin[e] = nbSamples;
+    for (unsigned int i = begin; i < end; ++i)
+      if (nbSamples == m_edgeSampleBegin[e] || m_edgeSamples[nbSamples - 1] != m_edgeSamples[i])
+        m_edgeSamples[nbSamples++] = m_edgeSamples[i];
+    begin = end;
+  }
+  m_edgeSampleBegin[nbEdges] = nbSamples;
+  m_edgeSamples.resize(nbSamples);
 
 #if (defined(VISP_HAVE_X11) || defined(VISP_HAVE_GDI)) && defined(DEBUG_DISP)
   if (!dispMaskDebug->isInitialised()) {
@@ -556,7 +820,13 @@ void vpMbScanLine::queryLineVisibility(const vpPoint &a, const vpPoint &b,
 #endif
   }
 
-  if (!visibility_samples.count(edge))
+  std::map<vpMbScanLineEdge, int, vpMbScanLineEdgeComparator>::const_iterator it_edge = m_edgeIndex.find(edge);
+  if (it_edge == m_edgeIndex.end())
+    return;
+
+  const unsigned int samples_begin = m_edgeSampleBegin[(size_t)it_edge->second];
+  const unsigned int samples_end = m_edgeSampleBegin[(size_t)it_edge->second + 1];
+  if (samples_begin == samples_end)
     return;
 
   // Initialized as the biggest difference between the two points is on the
@@ -597,13 +867,12 @@ void vpMbScanLine::queryLineVisibility(const vpPoint &a, const vpPoint &b,
   const int _v0 = (std::max)(0, int(std::ceil(*v0)));
   const int _v1 = (std::min)((int)(size - 1), (int)(std::ceil(*v1) - 1));
 
-  const std::set<int> &visible_samples = visibility_samples[edge];
   int last = _v0;
   vpPoint line_start;
   vpPoint line_end;
   bool b_line_started = false;
-  for (std::set<int>::const_iterator it = visible_samples.begin(); it != visible_samples.end(); ++it) {
-    const int v = *it;
+  for (unsigned int i = samples_begin; i < samples_end; ++i) {
+    const int v = m_edgeSamples[i];
     const double alpha = getAlpha(v, (*v0) * (*w0), (*w0), (*v1) * (*w1), (*w1));
     // const vpPoint p = mix(a, b, alpha);
     const vpPoint p = mix(a_, b_, alpha);
@@ -2927,61 +2927,75 @@ void vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity_, unsigned i
                                            vpColVector &error_prev, vpColVector &LTR, double &mu, vpColVector &v,
                                            const vpColVector *const w, vpColVector *const m_w_prev)
 {
-  if (isoJoIdentity_) {
-    LTL = L.AtA();
-    computeJTR(L, R, LTR);
+  LTL = L.AtA();
+  computeJTR(L, R, LTR);
+  computeVVSPoseEstimation(isoJoIdentity_, iter, LTL, LTR, error, error_prev, mu, v, w, m_w_prev);
+}
 
-    switch (m_optimizationMethod) {
-    case vpMbTracker::LEVENBERG_MARQUARDT_OPT: {
-      vpMatrix LMA(LTL.getRows(), LTL.getCols());
-      LMA.eye();
-      vpMatrix LTLmuI = LTL + (LMA * mu);
-      v = -m_lambda * LTLmuI.pseudoInverse(LTLmuI.getRows() * std::numeric_limits<double>::epsilon()) * LTR;
+/*!
+  Compute the pose increment of a virtual visual servoing iteration from the
+  normal equations \f$ {\bf L}^\top {\bf W} {\bf L} \f$ and
+  \f$ {\bf L}^\top {\bf W} {\bf e} \f$, already accumulated from the
+  weighted features. Contrary to the overload that takes the stacked
+  interaction matrix, the cost does not depend on the number of features.
+
+  \param isoJoIdentity_ : False if some degrees of freedom cannot be estimated
+  and have to be removed with oJo.
+  \param iter : Index of the iteration.
+  \param LTL : 6x6 matrix \f$ {\bf L}^\top {\bf W} {\bf L} \f$.
+  \param LTR : 6-dimension vector \f$ {\bf L}^\top {\bf W} {\bf e} \f$.
+  \param error : Residual of the current iteration, stored in \e error_prev
+  by the Levenberg-Marquardt method.
+  \param error_prev : Residual of the previous iteration.
+  \param mu : Levenberg-Marquardt damping factor.
+  \param v : Resulting velocity.
+  \param w : Weights of the current iteration, stored in \e m_w_prev by the
+  Levenberg-Marquardt method if both are not NULL.
+  \param m_w_prev : Weights of the previous iteration.
+*/
+void vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity_, unsigned int iter, const vpMatrix &LTL,
+                                           const vpColVector &LTR, const vpColVector &error, vpColVector &error_prev,
+                                           double &mu, vpColVector &v, const vpColVector *const w,
+                                           vpColVector *const m_w_prev)
+{
+  // With dof removed, L is replaced by L cVo oJo, hence L^T L by
+  // (cVo oJo)^T L^T L (cVo oJo) and the velocity has to be expressed back
+  // in the camera frame
+  vpVelocityTwistMatrix cVo;
+  vpMatrix J;
+  vpMatrix H = LTL;
+  vpColVector g = LTR;
+  if (!isoJoIdentity_) {
+    cVo.buildFrom(m_cMo);
+    J = cVo * oJo;
+    H = J.t() * LTL * J;
+    g = J.t() * LTR;
+  }
 
-      if (iter != 0)
-        mu /= 10.0;
+  switch (m_optimizationMethod) {
+  case vpMbTracker::LEVENBERG_MARQUARDT_OPT: {
+    vpMatrix LMA(H.getRows(), H.getCols());
+    LMA.eye();
+    vpMatrix LTLmuI = H + (LMA * mu);
+    v = -m_lambda * LTLmuI.pseudoInverse(LTLmuI.getRows() * std::numeric_limits<double>::epsilon()) * g;
 
-      error_prev = error;
-      if (w != NULL && m_w_prev != NULL)
-        *m_w_prev = *w;
-      break;
-    }
+    if (iter != 0)
+      mu /= 10.0;
 
-    case vpMbTracker::GAUSS_NEWTON_OPT:
-    default:
-      v = -m_lambda * LTL.pseudoInverse(LTL.getRows() * std::numeric_limits<double>::epsilon()) * LTR;
-      break;
-    }
-  } else {
-    vpVelocityTwistMatrix cVo;
-    cVo.buildFrom(m_cMo);
-    vpMatrix LVJ = (L * (cVo * oJo));
-    vpMatrix LVJTLVJ = (LVJ).AtA();
-    vpColVector LVJTR;
-    computeJTR(LVJ, R, LVJTR);
-
-    switch (m_optimizationMethod) {
-    case vpMbTracker::LEVENBERG_MARQUARDT_OPT: {
-      vpMatrix LMA(LVJTLVJ.getRows(), LVJTLVJ.getCols());
-      LMA.eye();
-      vpMatrix LTLmuI = LVJTLVJ + (LMA * mu);
-      v = -m_lambda * LTLmuI.pseudoInverse(LTLmuI.getRows() * std::numeric_limits<double>::epsilon()) * LVJTR;
-      v = cVo * v;
-
-      if (iter != 0)
-        mu /= 10.0;
-
-      error_prev = error;
-      if (w != NULL && m_w_prev != NULL)
-        *m_w_prev = *w;
-      break;
-    }
-    case vpMbTracker::GAUSS_NEWTON_OPT:
-    default:
-      v = -m_lambda * LVJTLVJ.pseudoInverse(LVJTLVJ.getRows() * std::numeric_limits<double>::epsilon()) * LVJTR;
-      v = cVo * v;
-      break;
-    }
+    error_prev = error;
+    if (w != NULL && m_w_prev != NULL)
+      *m_w_prev = *w;
+    break;
+  }
+
+  case vpMbTracker::GAUSS_NEWTON_OPT:
+  default:
+    v = -m_lambda * H.pseudoInverse(H.getRows() * std::numeric_limits<double>::epsilon()) * g;
+    break;
+  }
+
+  if (!isoJoIdentity_) {
+    v = cVo * v;
   }
 }
 
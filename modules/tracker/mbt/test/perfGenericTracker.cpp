@@ -115,8 +115,143 @@ bool read_data(const std::string &input_directory, int cpt, const vpCameraParame
 
   return true;
 }
+
+// Model of a square of 20 cm in the plane z = 0
+std::string writeSquareModel()
+{
+#if defined(_WIN32)
+  std::string tmp_dir = "C:/temp/";
+#else
+  std::string tmp_dir = "/tmp/";
+#endif
+  tmp_dir += vpIoTools::getUserName() + "/perfGenericTracker/";
+  vpIoTools::makeDirectory(tmp_dir);
+  const std::string filename = tmp_dir + "square.cao";
+  std::ofstream file(filename.c_str());
+  file << "V1\n"
+       << "4\n"
+       << "-0.1 -0.1 0\n0.1 -0.1 0\n0.1 0.1 0\n-0.1 0.1 0\n"
+       << "0\n0\n"
+       << "1\n4 3 2 1 0\n"
+       << "0\n0\n";
+  return filename;
+}
+
+// Image of the square, dark on a bright background, and point cloud of the
+// plane of the square
+void renderSquare(const vpCameraParameters &cam, const vpHomogeneousMatrix &cMo, vpImage<unsigned char> &I,
+                  std::vector<vpColVector> &pointcloud)
+{
+  I.resize(480, 640);
+  pointcloud.resize(I.getSize());
+  const vpHomogeneousMatrix oMc = cMo.inverse();
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      double x = 0, y = 0;
+      vpPixelMeterConversion::convertPoint(cam, j, i, x, y);
+      // Intersection of the ray with the plane z = 0 of the object frame
+      const double dz = oMc[2][0] * x + oMc[2][1] * y + oMc[2][2];
+      const double Z = -oMc[2][3] / dz;
+      const double X_o = oMc[0][0] * x * Z + oMc[0][1] * y * Z + oMc[0][2] * Z + oMc[0][3];
+      const double Y_o = oMc[1][0] * x * Z + oMc[1][1] * y * Z + oMc[1][2] * Z + oMc[1][3];
+      const bool inside = std::fabs(X_o) < 0.1 && std::fabs(Y_o) < 0.1;
+      I[i][j] = inside ? 40 : 200;
+
+      vpColVector pt3d(4, 1.0);
+      pt3d[0] = inside ? x * Z : 0;
+      pt3d[1] = inside ? y * Z : 0;
+      pt3d[2] = inside ? Z : 0;
+      pointcloud[i * I.getWidth() + j] = pt3d;
+    }
+  }
+}
+
+// Track the square from a perturbed pose with or without the covariance,
+// i.e. with the stacked interaction matrix or with the normal equations
+// accumulated per camera
+vpHomogeneousMatrix trackSquare(int depthTrackerType, bool computeCovariance)
+{
+  const vpCameraParameters cam(600, 600, 320, 240);
+  const vpHomogeneousMatrix cMo(0.01, -0.02, 0.6, vpMath::rad(20), vpMath::rad(-10), vpMath::rad(15));
+  vpImage<unsigned char> I;
+  std::vector<vpColVector> pointcloud;
+  renderSquare(cam, cMo, I, pointcloud);
+
+  std::vector<std::string> cameraNames(1, "Camera1");
+  std::vector<int> trackerTypes(1, vpMbGenericTracker::EDGE_TRACKER);
+  if (depthTrackerType) {
+    cameraNames.push_back("Camera2");
+    trackerTypes.push_back(depthTrackerType);
+  }
+  vpMbGenericTracker tracker(cameraNames, trackerTypes);
+  std::map<std::string, vpCameraParameters> mapOfCameraParameters;
+  mapOfCameraParameters["Camera1"] = cam;
+  if (depthTrackerType) {
+    mapOfCameraParameters["Camera2"] = cam;
+  }
+  tracker.setCameraParameters(mapOfCameraParameters);
+  if (depthTrackerType) {
+    tracker.loadModel(writeSquareModel(), writeSquareModel());
+  } else {
+    tracker.loadModel(writeSquareModel());
+  }
+  vpMe me;
+  me.setMaskSize(5);
+  me.setMaskNumber(180);
+  me.setRange(8);
+  me.setThreshold(10000);
+  me.setMu1(0.5);
+  me.setMu2(0.5);
+  me.setSampleStep(4);
+  tracker.setMovingEdge(me);
+  tracker.setCovarianceComputation(computeCovariance);
+
+  const vpHomogeneousMatrix cMo_init =
+      cMo * vpHomogeneousMatrix(0.003, -0.002, 0.002, vpMath::rad(1), vpMath::rad(-1), vpMath::rad(1));
+  std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+  mapOfImages["Camera1"] = &I;
+  std::map<std::string, vpHomogeneousMatrix> mapOfInitPoses;
+  mapOfInitPoses["Camera1"] = cMo_init;
+  if (depthTrackerType) {
+    mapOfImages["Camera2"] = &I;
+    mapOfInitPoses["Camera2"] = cMo_init;
+  }
+  tracker.initFromPose(mapOfImages, mapOfInitPoses);
+  mapOfImages.erase("Camera2");
+
+  std::map<std::string, const std::vector<vpColVector> *> mapOfPointclouds;
+  std::map<std::string, unsigned int> mapOfWidths, mapOfHeights;
+  if (depthTrackerType) {
+    mapOfPointclouds["Camera2"] = &pointcloud;
+    mapOfWidths["Camera2"] = I.getWidth();
+    mapOfHeights["Camera2"] = I.getHeight();
+  }
+  tracker.track(mapOfImages, mapOfPointclouds, mapOfWidths, mapOfHeights);
+  const vpHomogeneousMatrix cMo_tracked = tracker.getPose();
+
+  // The tracking must get closer to the true pose whatever the path
+  const vpPoseVector error(cMo_tracked * cMo.inverse()), error_init(cMo_init * cMo.inverse());
+  CHECK(error.getTranslationVector().frobeniusNorm() < error_init.getTranslationVector().frobeniusNorm());
+  CHECK(error.getThetaUVector().getTheta() < error_init.getThetaUVector().getTheta());
+  return cMo_tracked;
+}
 } //anonymous namespace
 
+TEST_CASE("Normal equations give the same pose as the stacked interaction matrix", "[mbt]") {
+  const int depthTrackerTypes[] = {0, vpMbGenericTracker::DEPTH_DENSE_TRACKER,
+                                   vpMbGenericTracker::DEPTH_NORMAL_TRACKER};
+  for (size_t k = 0; k < sizeof(depthTrackerTypes) / sizeof(depthTrackerTypes[0]); k++) {
+    INFO("Depth tracker type: " << depthTrackerTypes[k]);
+    const vpHomogeneousMatrix cMo_stacked = trackSquare(depthTrackerTypes[k], true);
+    const vpHomogeneousMatrix cMo_normal = trackSquare(depthTrackerTypes[k], false);
+    for (unsigned int i = 0; i < 3; i++) {
+      for (unsigned int j = 0; j < 4; j++) {
+        CHECK(cMo_normal[i][j] == Approx(cMo_stacked[i][j]).margin(1e-9));
+      }
+    }
+  }
+}
+
 TEST_CASE("Benchmark generic tracker", "[benchmark]") {
   if (runBenchmark) {
     std::vector<int> tracker_type(2);
@@ -292,6 +427,75 @@ TEST_CASE("Benchmark generic tracker", "[benchmark]") {
         CHECK(sqrt(tu_err.sumSquare()) < max_rotation_error);
       }
     }
+
+    // Cameras processed sequentially vs concurrently
+    {
+      std::map<std::string, int> mapOfTrackerTypes;
+      mapOfTrackerTypes["Camera1"] = vpMbGenericTracker::EDGE_TRACKER;
+      mapOfTrackerTypes["Camera2"] = vpMbGenericTracker::DEPTH_DENSE_TRACKER;
+
+      std::vector<unsigned int> nbThreads = {1, 0};
+      std::vector<std::string> benchmarkNames = {
+        "Edge + Depth dense MBT (sequential cameras)",
+        "Edge + Depth dense MBT (parallel cameras)"
+      };
+
+      std::map<std::string, unsigned int> mapOfWidths, mapOfHeights;
+      mapOfWidths["Camera2"] = I_depth_raw.getWidth();
+      mapOfHeights["Camera2"] = I_depth_raw.getHeight();
+
+      std::vector<vpHomogeneousMatrix> cMo_final(nbThreads.size());
+      for (size_t idx = 0; idx < nbThreads.size(); idx++) {
+        tracker.resetTracker();
+        tracker.setTrackerType(mapOfTrackerTypes);
+        tracker.setNbThreads(nbThreads[idx]);
+
+        tracker.loadConfigFile(configFileCam1, configFileCam2);
+        tracker.loadModel(input_directory + "/Models/chateau.cao", input_directory + "/Models/chateau.cao");
+        tracker.loadModel(input_directory + "/Models/cube.cao", false, T);
+
+        std::map<std::string, double> stageTimes;
+        size_t nbTracking = 0;
+
+        BENCHMARK(benchmarkNames[idx].c_str())
+        {
+          tracker.initFromPose(images.front(), cMo_truth_all.front());
+
+          vpHomogeneousMatrix cMo;
+          for (size_t i = 0; i < images.size(); i++) {
+            std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+            mapOfImages["Camera1"] = &images[i];
+
+            std::map<std::string, const std::vector<vpColVector> *> mapOfPointclouds;
+            mapOfPointclouds["Camera2"] = &pointclouds[i];
+
+            tracker.track(mapOfImages, mapOfPointclouds, mapOfWidths, mapOfHeights);
+            cMo = tracker.getPose();
+
+            std::map<std::string, double> times = tracker.getStageTimes();
+            for (std::map<std::string, double>::const_iterator it = times.begin(); it != times.end(); ++it) {
+              stageTimes[it->first] += it->second;
+            }
+            nbTracking++;
+          }
+
+          return cMo;
+        };
+        cMo_final[idx] = tracker.getPose();
+
+        std::cout << benchmarkNames[idx] << ", mean time per frame and per stage:" << std::endl;
+        for (std::map<std::string, double>::const_iterator it = stageTimes.begin(); it != stageTimes.end(); ++it) {
+          std::cout << "  " << it->first << ": " << it->second / nbTracking << " ms" << std::endl;
+        }
+      }
+
+      // The per camera contributions are merged in a deterministic order
+      for (unsigned int i = 0; i < 4; i++) {
+        for (unsigned int j = 0; j < 4; j++) {
+          CHECK(cMo_final[0][i][j] == Approx(cMo_final[1][i][j]).margin(1e-9));
+        }
+      }
+    }
   } //if (runBenchmark)
 }
 
@@ -0,0 +1,355 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark the scanline visibility renderer.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfMbScanLine.cpp
+
+  \brief Check that the scanline renderer gives the same results whatever the
+  number of threads and whether the scene is rendered from scratch or updated.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/mbt/vpMbScanLine.h>
+
+namespace
+{
+
+bool runBenchmark = false;
+
+typedef std::vector<std::pair<vpPoint, unsigned int> > vpPolygon3D;
+
+// Faces of random boxes in the object frame
+std::vector<std::vector<vpPoint> > generateBoxes(unsigned int nbBoxes)
+{
+  vpUniRand rng(1234);
+  const int faces[6][4] = {{0, 1, 3, 2}, {4, 6, 7, 5}, {0, 4, 5, 1}, {2, 3, 7, 6}, {0, 2, 6, 4}, {1, 5, 7, 3}};
+  std::vector<std::vector<vpPoint> > boxes;
+  for (unsigned int b = 0; b < nbBoxes; b++) {
+    double c[3] = {rng.uniform(-0.3, 0.3), rng.uniform(-0.2, 0.2), rng.uniform(-0.2, 0.2)};
+    double s = rng.uniform(0.02, 0.1);
+    for (unsigned int i = 0; i < 6; i++) {
+      std::vector<vpPoint> face;
+      for (unsigned int j = 0; j < 4; j++) {
+        int k = faces[i][j];
+        face.push_back(vpPoint(c[0] + ((k & 1) ? s : -s), c[1] + ((k & 2) ? s : -s), c[2] + ((k & 4) ? s : -s)));
+      }
+      boxes.push_back(face);
+    }
+  }
+  return boxes;
+}
+
+// Faces in the camera frame
+void changeFrame(const std::vector<std::vector<vpPoint> > &faces, const vpHomogeneousMatrix &cMo,
+                 std::vector<vpPolygon3D> &polygons)
+{
+  polygons.resize(faces.size());
+  for (size_t i = 0; i < faces.size(); i++) {
+    polygons[i].clear();
+    for (size_t j = 0; j < faces[i].size(); j++) {
+      vpPoint P = faces[i][j];
+      P.changeFrame(cMo);
+      polygons[i].push_back(std::make_pair(P, static_cast<unsigned int>(j)));
+    }
+  }
+}
+
+void render(vpMbScanLine &renderer, std::vector<vpPolygon3D> &polygons)
+{
+  std::vector<vpPolygon3D *> ptrs;
+  std::vector<int> ids;
+  for (size_t i = 0; i < polygons.size(); i++) {
+    ptrs.push_back(&polygons[i]);
+    ids.push_back(static_cast<int>(i));
+  }
+  renderer.drawScene(ptrs, ids, vpCameraParameters(600, 600, 320, 240), 640, 480);
+}
+
+std::vector<std::vector<std::pair<vpPoint, vpPoint> > > queryEdges(vpMbScanLine &renderer,
+                                                                   const std::vector<vpPolygon3D> &polygons)
+{
+  std::vector<std::vector<std::pair<vpPoint, vpPoint> > > visibleLines;
+  for (size_t i = 0; i < polygons.size(); i++) {
+    for (size_t j = 0; j < polygons[i].size(); j++) {
+      std::vector<std::pair<vpPoint, vpPoint> > lines;
+      renderer.queryLineVisibility(polygons[i][j].first, polygons[i][(j + 1) % polygons[i].size()].first, lines);
+      visibleLines.push_back(lines);
+    }
+  }
+  return visibleLines;
+}
+
+template <typename Type> bool isSameImage(const vpImage<Type> &I1, const vpImage<Type> &I2)
+{
+  return I1.getHeight() == I2.getHeight() && I1.getWidth() == I2.getWidth() &&
+         std::equal(I1.bitmap, I1.bitmap + I1.getSize(), I2.bitmap);
+}
+
+bool isSamePoint(const vpPoint &P1, const vpPoint &P2)
+{
+  return P1.get_X() == P2.get_X() && P1.get_Y() == P2.get_Y() && P1.get_Z() == P2.get_Z();
+}
+
+void checkSameRendering(vpMbScanLine &renderer, vpMbScanLine &reference, const std::vector<vpPolygon3D> &polygons)
+{
+  CHECK(isSameImage(renderer.getMask(), reference.getMask()));
+  CHECK(isSameImage(renderer.getPrimitiveIDs(), reference.getPrimitiveIDs()));
+
+  std::vector<std::vector<std::pair<vpPoint, vpPoint> > > lines = queryEdges(renderer, polygons);
+  std::vector<std::vector<std::pair<vpPoint, vpPoint> > > referenceLines = queryEdges(reference, polygons);
+  REQUIRE(lines.size() == referenceLines.size());
+  for (size_t i = 0; i < lines.size(); i++) {
+    REQUIRE(lines[i].size() == referenceLines[i].size());
+    for (size_t j = 0; j < lines[i].size(); j++) {
+      CHECK(isSamePoint(lines[i][j].first, referenceLines[i][j].first));
+      CHECK(isSamePoint(lines[i][j].second, referenceLines[i][j].second));
+    }
+  }
+}
+}
+
+TEST_CASE("vpMbScanLine hides the polygons that are behind", "[vpMbScanLine]")
+{
+  // A square in front of the left half of a larger one
+  std::vector<std::vector<vpPoint> > faces(2);
+  faces[0].push_back(vpPoint(-0.2, -0.2, 1.));
+  faces[0].push_back(vpPoint(0.2, -0.2, 1.));
+  faces[0].push_back(vpPoint(0.2, 0.2, 1.));
+  faces[0].push_back(vpPoint(-0.2, 0.2, 1.));
+  faces[1].push_back(vpPoint(-0.3, -0.1, 0.8));
+  faces[1].push_back(vpPoint(0., -0.1, 0.8));
+  faces[1].push_back(vpPoint(0., 0.1, 0.8));
+  faces[1].push_back(vpPoint(-0.3, 0.1, 0.8));
+  std::vector<vpPolygon3D> polygons;
+  changeFrame(faces, vpHomogeneousMatrix(), polygons);
+
+  for (unsigned int maskBorder = 0; maskBorder <= 5; maskBorder += 5) {
+    vpMbScanLine renderer;
+    renderer.setMaskBorder(maskBorder);
+    render(renderer, polygons);
+
+    // Image of the square: [200, 440] x [120, 360], image of the occluding
+    // square: [95, 320] x [165, 315]
+    const vpImage<int> &ids = renderer.getPrimitiveIDs();
+    CHECK(ids[140][400] == 0);
+    CHECK(ids[240][250] == 1);
+    CHECK(ids[240][400] == 0);
+    CHECK(ids[20][20] == -1);
+    CHECK(renderer.getMask()[140][400] == 255);
+    CHECK(renderer.getMask()[20][20] == 0);
+
+    // The top edge of the large square is visible, its left edge is
+    // partially hidden
+    std::vector<std::pair<vpPoint, vpPoint> > lines;
+    renderer.queryLineVisibility(polygons[0][0].first, polygons[0][1].first, lines);
+    REQUIRE(lines.size() == 1);
+    CHECK(std::fabs(lines[0].first.get_X() - lines[0].second.get_X()) > 0.39);
+    renderer.queryLineVisibility(polygons[0][3].first, polygons[0][0].first, lines);
+    CHECK(lines.size() == 2);
+  }
+}
+
+TEST_CASE("vpMbScanLine does not depend on the number of threads", "[vpMbScanLine]")
+{
+  std::vector<std::vector<vpPoint> > faces = generateBoxes(50);
+  std::vector<vpPolygon3D> polygons;
+  changeFrame(faces, vpHomogeneousMatrix(0.01, -0.02, 1., vpMath::rad(10), vpMath::rad(-15), vpMath::rad(5)),
+              polygons);
+
+  for (unsigned int maskBorder = 0; maskBorder <= 5; maskBorder += 5) {
+    vpMbScanLine reference;
+    reference.setNbThreads(1);
+    reference.setMaskBorder(maskBorder);
+    render(reference, polygons);
+    for (unsigned int nbThreads = 2; nbThreads <= 4; nbThreads++) {
+      vpMbScanLine renderer;
+      renderer.setNbThreads(nbThreads);
+      renderer.setMaskBorder(maskBorder);
+      render(renderer, polygons);
+      checkSameRendering(renderer, reference, polygons);
+    }
+  }
+}
+
+TEST_CASE("vpMbScanLine updates the scene as if it was rendered from scratch", "[vpMbScanLine]")
+{
+  std::vector<std::vector<vpPoint> > faces = generateBoxes(50);
+  vpHomogeneousMatrix cMo(0.01, -0.02, 1., vpMath::rad(10), vpMath::rad(-15), vpMath::rad(5));
+  std::vector<vpPolygon3D> polygons;
+  changeFrame(faces, cMo, polygons);
+
+  for (unsigned int maskBorder = 0; maskBorder <= 5; maskBorder += 5) {
+    vpMbScanLine renderer;
+    renderer.setMaskBorder(maskBorder);
+    render(renderer, polygons);
+
+    SECTION("Same scene")
+    {
+      render(renderer, polygons);
+      vpMbScanLine reference;
+      reference.setMaskBorder(maskBorder);
+      render(reference, polygons);
+      checkSameRendering(renderer, reference, polygons);
+    }
+
+    SECTION("One box moved")
+    {
+      std::vector<vpPolygon3D> moved(polygons);
+      for (size_t i = 18; i < 24; i++) {
+        for (size_t j = 0; j < moved[i].size(); j++) {
+          moved[i][j].first.set_X(moved[i][j].first.get_X() + 0.01);
+        }
+      }
+      render(renderer, moved);
+      vpMbScanLine reference;
+      reference.setMaskBorder(maskBorder);
+      render(reference, moved);
+      checkSameRendering(renderer, reference, moved);
+    }
+
+    SECTION("New pose")
+    {
+      std::vector<vpPolygon3D> moved;
+      changeFrame(faces, vpHomogeneousMatrix(0.002, 0.001, 0.002, 0., vpMath::rad(0.5), 0.) * cMo, moved);
+      render(renderer, moved);
+      vpMbScanLine reference;
+      reference.setMaskBorder(maskBorder);
+      render(reference, moved);
+      checkSameRendering(renderer, reference, moved);
+    }
+  }
+}
+
+TEST_CASE("vpMbScanLine keeps the edges of the current scene only", "[vpMbScanLine]")
+{
+  // A single cube has 12 edges shared by its faces
+  std::vector<std::vector<vpPoint> > faces = generateBoxes(1);
+  vpHomogeneousMatrix cMo(0.01, -0.02, 1., vpMath::rad(10), vpMath::rad(-15), vpMath::rad(5));
+  std::vector<vpPolygon3D> polygons;
+  changeFrame(faces, cMo, polygons);
+
+  vpMbScanLine renderer;
+  render(renderer, polygons);
+  REQUIRE(renderer.getNbEdges() == 12);
+
+  const vpHomogeneousMatrix cdMc(0.001, -0.0005, 0.001, 0., vpMath::rad(0.2), vpMath::rad(0.1));
+  for (unsigned int i = 0; i < 200; i++) {
+    cMo = cdMc * cMo;
+    changeFrame(faces, cMo, polygons);
+    render(renderer, polygons);
+    CHECK(renderer.getNbEdges() == 12);
+  }
+
+  vpMbScanLine reference;
+  render(reference, polygons);
+  checkSameRendering(renderer, reference, polygons);
+}
+
+TEST_CASE("vpMbScanLine benchmark", "[benchmark]")
+{
+  if (runBenchmark) {
+    std::vector<std::vector<vpPoint> > faces = generateBoxes(200);
+    vpHomogeneousMatrix cMo(0.01, -0.02, 1., vpMath::rad(10), vpMath::rad(-15), vpMath::rad(5));
+    std::vector<vpPolygon3D> polygons, moved;
+    changeFrame(faces, cMo, polygons);
+    changeFrame(faces, vpHomogeneousMatrix(0.002, 0.001, 0.002, 0., vpMath::rad(0.5), 0.) * cMo, moved);
+
+    BENCHMARK("Render 1200 faces")
+    {
+      vpMbScanLine renderer;
+      render(renderer, polygons);
+      return renderer.getMask()[0][0];
+    };
+
+    vpMbScanLine renderer;
+    render(renderer, polygons);
+
+    BENCHMARK("Query the visibility of 4800 edges") { return queryEdges(renderer, polygons).size(); };
+
+    BENCHMARK("Render 1200 faces again with the same pose")
+    {
+      render(renderer, polygons);
+      return renderer.getMask()[0][0];
+    };
+
+    BENCHMARK("Render 1200 faces after a small pose change")
+    {
+      render(renderer, polygons);
+      render(renderer, moved);
+      return renderer.getMask()[0][0];
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark of the scanline renderer");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
@@ -50,6 +50,8 @@
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpMatrix.h>
 
+#include <vector>
+
 /*!
   \class vpMe
   \ingroup module_me
@@ -91,6 +93,11 @@ private:
   vpMatrix *mask; //! Array of matrices defining the different masks (one for
                   //! every angle step).
 
+private:
+  //! Integer coefficients of the masks, with rows padded to m_maskStride
+  std::vector<short> m_maskCoefficients;
+  unsigned int m_maskStride;
+
 public:
   vpMe();
   vpMe(const vpMe &me);
@@ -116,8 +123,28 @@ public:
     Get the matrix of the mask.
 
     \return the value of mask.
+
+    \warning The moving edges are tracked with an integer copy of these
+    matrices. If they are modified, initMask() has to be called again.
   */
   inline vpMatrix *getMask() const { return mask; }
+  /*!
+    Get the integer coefficients of a mask. Row \e a of the mask starts at
+    index \e a * getMaskCoefficientsStride() and is padded with zeros.
+
+    \param index : Index of the mask, in [0, getMaskNumber()[.
+    \return Pointer to the coefficients.
+  */
+  inline const short *getMaskCoefficients(unsigned int index) const
+  {
+    return m_maskCoefficients.empty() ? NULL : &m_maskCoefficients[index * mask_size * m_maskStride];
+  }
+  /*!
+    Get the number of coefficients between two rows of the masks returned by
+    getMaskCoefficients(). It is a multiple of 8, larger than or equal to
+    getMaskSize().
+  */
+  inline unsigned int getMaskCoefficientsStride() const { return m_maskStride; }
   /*!
     Return the number of mask  applied to determine the object contour. The
     number of mask determines the precision of the normal of the edge for
@@ -355,6 +355,19 @@ void vpMe::initMask()
     angle[k++] = i;
 
   calcul_masques(angle, mask_size, mask);
+
+  // The coefficients are integers in [-100, 100]: keep a copy with rows
+  // padded to a multiple of 8 values, that can be processed with SIMD
+  m_maskStride = ((mask_size + 7) / 8) * 8;
+  m_maskCoefficients.assign(n_mask * mask_size * m_maskStride, 0);
+  for (k = 0; k < n_mask; k++) {
+    for (unsigned int a = 0; a < mask_size; a++) {
+      short *row = &m_maskCoefficients[(k * mask_size + a) * m_maskStride];
+      for (unsigned int b = 0; b < mask_size; b++) {
+        row[b] = static_cast<short>(mask[k][a][b]);
+      }
+    }
+  }
 }
 
 void vpMe::print()
@@ -375,7 +388,8 @@ void vpMe::print()
 
 vpMe::vpMe()
   : threshold(1500), mu1(0.5), mu2(0.5), min_samplestep(4), anglestep(1), mask_sign(0), range(4), sample_step(10),
-    ntotal_sample(0), points_to_track(500), mask_size(5), n_mask(180), strip(2), mask(NULL)
+    ntotal_sample(0), points_to_track(500), mask_size(5), n_mask(180), strip(2), mask(NULL), m_maskCoefficients(),
+    m_maskStride(0)
 {
   // ntotal_sample = 0; // not sure that it is used
   // points_to_track = 500; // not sure that it is used
@@ -386,7 +400,8 @@ vpMe::vpMe()
 
 vpMe::vpMe(const vpMe &me)
   : threshold(1500), mu1(0.5), mu2(0.5), min_samplestep(4), anglestep(1), mask_sign(0), range(4), sample_step(10),
-    ntotal_sample(0), points_to_track(500), mask_size(5), n_mask(180), strip(2), mask(NULL)
+    ntotal_sample(0), points_to_track(500), mask_size(5), n_mask(180), strip(2), mask(NULL), m_maskCoefficients(),
+    m_maskStride(0)
 {
   *this = me;
 }
@@ -46,10 +46,16 @@
 #include <cmath>  // std::fabs
 #include <limits> // numeric_limits
 #include <stdlib.h>
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/me/vpMe.h>
 #include <visp3/me/vpMeSite.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 static bool horsImage(int i, int j, int half, int rows, int cols)
 {
@@ -61,6 +67,79 @@ static bool horsImage(int i, int j, int half, int rows, int cols)
   // > (cols - half - 3) )) ;
   return ((0 < (half_1 - i)) || ((i - rows + half_3) > 0) || (0 < (half_1 - j)) || ((j - cols + half_3) > 0));
 }
+
+namespace
+{
+bool useSSE2()
+{
+#if VISP_HAVE_SSE2
+  static const bool sse2 = vpCPUFeatures::checkSSE2();
+  return sse2;
+#else
+  return false;
+#endif
+}
+
+// Index of the mask that corresponds to the tangent of a site whose normal
+// has the angle alpha
+unsigned int getMaskIndex(double alpha, const vpMe *me)
+{
+  // Calculate tangent angle from normal
+  double theta = alpha + M_PI / 2;
+  // Move tangent angle to within 0->M_PI for a positive
+  // mask index
+  while (theta < 0)
+    theta += M_PI;
+  while (theta > M_PI)
+    theta -= M_PI;
+
+  // Convert radians to degrees
+  int thetadeg = vpMath::round(theta * 180 / M_PI);
+
+  if (abs(thetadeg) == 180) {
+    thetadeg = 0;
+  }
+
+  return (unsigned int)(thetadeg / (double)me->getAngleStep());
+}
+
+// Convolution of the msize x msize patch of I whose top left corner is
+// (i0, j0) with integer mask coefficients whose rows are padded to stride
+int convolveMask(const vpImage<unsigned char> &I, int i0, int j0, const short *mask, unsigned int msize,
+                 unsigned int stride, bool sse2)
+{
+  const unsigned int width = I.getWidth();
+  const unsigned char *src = I.bitmap + static_cast<unsigned int>(i0) * width + static_cast<unsigned int>(j0);
+  int conv = 0;
+
+#if VISP_HAVE_SSE2
+  // The padded rows are read at once when they do not go past the end of
+  // the image: the mask is 0 for the additional pixels
+  if (sse2 && static_cast<size_t>(i0 + msize - 1) * width + j0 + stride <= I.getSize()) {
+    const __m128i z = _mm_setzero_si128();
+    __m128i sum = _mm_setzero_si128();
+    for (unsigned int a = 0; a < msize; a++, src += width, mask += stride) {
+      for (unsigned int b = 0; b < stride; b += 8) {
+        const __m128i pix = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + b)), z);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(pix, _mm_loadu_si128(reinterpret_cast<const __m128i *>(mask + b))));
+      }
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+  }
+#else
+  (void)sse2;
+#endif
+
+  for (unsigned int a = 0; a < msize; a++, src += width, mask += stride) {
+    for (unsigned int b = 0; b < msize; b++) {
+      conv += mask[b] * src[b];
+    }
+  }
+  return conv;
+}
+}
 #endif
 
 void vpMeSite::init()
@@ -306,39 +385,9 @@ double vpMeSite::convolution(const vpImage<unsigned char> &I, const vpMe *me)
     i = 0;
     j = 0;
   } else {
-    // Calculate tangent angle from normal
-    double theta = alpha + M_PI / 2;
-    // Move tangent angle to within 0->M_PI for a positive
-    // mask index
-    while (theta < 0)
-      theta += M_PI;
-    while (theta > M_PI)
-      theta -= M_PI;
-
-    // Convert radians to degrees
-    int thetadeg = vpMath::round(theta * 180 / M_PI);
-
-    if (abs(thetadeg) == 180) {
-      thetadeg = 0;
-    }
-
-    unsigned int index_mask = (unsigned int)(thetadeg / (double)me->getAngleStep());
-
-    unsigned int i_ = static_cast<unsigned int>(i);
-    unsigned int j_ = static_cast<unsigned int>(j);
-    unsigned int half_ = static_cast<unsigned int>(half);
-
-    unsigned int ihalf = i_ - half_;
-    unsigned int jhalf = j_ - half_;
-
-    for (unsigned int a = 0; a < msize; a++) {
-      unsigned int ihalfa = ihalf + a;
-      for (unsigned int b = 0; b < msize; b++) {
-        conv += mask_sign * me->getMask()[index_mask][a][b] *
-                //	  I(i-half+a,j-half+b) ;
-                I(ihalfa, jhalf + b);
-      }
-    }
+    // The coefficients of the masks are integers, so is the convolution
+    conv = mask_sign * convolveMask(I, i - half, j - half, me->getMaskCoefficients(getMaskIndex(alpha, me)), msize,
+                                    me->getMaskCoefficientsStride(), useSSE2());
   }
 
   return (conv);
@@ -354,154 +403,18 @@ double vpMeSite::convolution(const vpImage<unsigned char> &I, const vpMe *me)
 */
 void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, bool test_contraste)
 {
-  //   vpMeSite  *list_query_pixels ;
-  //   int  max_rank =0 ;
-  //   int max_rank1=0 ;
-  //   int max_rank2 = 0;
-  //   double  convolution = 0 ;
-  //   double  max_convolution = 0 ;
-  //   double max = 0 ;
-  //   double contraste = 0;
-  //   //  vpDisplay::display(I) ;
-  //   //  vpERROR_TRACE("getclcik %d",me->getRange()) ;
-  //   //  vpDisplay::getClick(I) ;
-  //
-  //   // range = +/- range of pixels within which the correspondent
-  //   // of the current pixel will be sought
-  //   int range  = me->getRange() ;
-  //
-  //   //  std::cout << i << "  " << j<<"  " << range << "  " << suppress  <<
-  //   std::endl ; list_query_pixels = getQueryList(I, range) ;
-  //
-  //   double  contraste_max = 1 + me->getMu2();
-  //   double  contraste_min = 1 - me->getMu1();
-  //
-  //   // array in which likelihood ratios will be stored
-  //   double  *likelihood= new double[ 2 * range + 1 ] ;
-  //
-  //   int ii_1 = i ;
-  //   int jj_1 = j ;
-  //   i_1 = i ;
-  //   j_1 = j ;
-  //   double threshold;
-  //   threshold = me->getThreshold();
-  //
-  //   //    std::cout <<"---------------------"<<std::endl ;
-  //   for(int n = 0 ; n < 2 * range + 1 ; n++)
-  //     {
-  //
-  //       //   convolution results
-  //       convolution = list_query_pixels[n].convolution(I, me) ;
-  //
-  //       // luminance ratio of reference pixel to potential correspondent
-  //       pixel
-  //       // the luminance must be similar, hence the ratio value should
-  //       // lay between, for instance, 0.5 and 1.5 (parameter tolerance)
-  //       if( test_contraste )
-  // 	{
-  // 	  // Include this to eliminate temporal calculation
-  // 	  if (convlt==0)
-  // 	    {
-  // 	      std::cout << "vpMeSite::track : Division by zero  convlt = 0" <<
-  // std::endl ; 	      delete []list_query_pixels ; 	      delete
-  // []likelihood;
-  // 	      throw(vpTrackingException(vpTrackingException::initializationError,
-  // 					"Division by zero")) ;
-  // 	    }
-  //
-  // // 	  contraste = fabs(convolution / convlt) ;
-  // 	  contraste = convolution / convlt ;
-  // 	  // likelihood ratios
-  // 	  if((contraste > contraste_min) && (contraste < contraste_max))
-  // 	    likelihood[n] = fabs(convolution + convlt ) ;
-  // 	  else
-  // 	    likelihood[n] = 0 ;
-  // 	}
-  //       else
-  // 	likelihood[n] = fabs(2*convolution) ;
-  //
-  //
-  //       // establishment of the maximal likelihood ratios's  rank
-  //       // in the array, the value of the likelihood ratio can now be
-  //     // referenced by its rank in the array
-  //     if (likelihood[n] > max)
-  //     {
-  //       max_convolution= convolution;
-  //       max = likelihood[n] ;
-  //       max_rank = n ;
-  //       max_rank2 = max_rank1;
-  //       max_rank1 = max_rank;
-  //     }
-  //
-  //   }
-  //
-  //   // test on the likelihood threshold if threshold==-1 then
-  //   // the me->threshold is  selected
-  //
-  //   vpImagePoint ip;
-  //
-  //   //  if (test_contrast)
-  //   if(max > threshold)
-  //     {
-  //       if ((selectDisplay==RANGE_RESULT)||(selectDisplay==RESULT))
-  // 	{
-  // 	  ip.set_i( list_query_pixels[max_rank].i );
-  // 	  ip.set_j( list_query_pixels[max_rank].j );
-  // 	  vpDisplay::displayPoint(I, ip, vpColor::red);
-  // 	}
-  //
-  //       *this = list_query_pixels[max_rank] ;//The vpMeSite is replaced by
-  //       the vpMeSite of max likelihood normGradient =
-  //       vpMath::sqr(max_convolution);
-  //
-  //       convlt = max_convolution;
-  //       i_1 = ii_1; //list_query_pixels[max_rank].i ;
-  //       j_1 = jj_1; //list_query_pixels[max_rank].j ;
-  //       delete []list_query_pixels ;
-  //       delete []likelihood;
-  //     }
-  //   else //none of the query sites is better than the threshold
-  //     {
-  //       if ((selectDisplay==RANGE_RESULT)||(selectDisplay==RESULT))
-  // 	{
-  // 	  ip.set_i( list_query_pixels[max_rank].i );
-  // 	  ip.set_j( list_query_pixels[max_rank].j );
-  // 	  vpDisplay::displayPoint(I, ip, vpColor::green);
-  // 	}
-  //       normGradient = 0 ;
-  //       if(max == 0)
-  // 	suppress = 1; // contrast suppression
-  //       else
-  // 	suppress = 2; // threshold suppression
-  //
-  //       delete []list_query_pixels ;
-  //       delete []likelihood; // modif portage
-  //     }
-
   int max_rank = -1;
-  //   int max_rank1=-1 ;
-  //   int max_rank2 = -1;
   double max_convolution = 0;
   double max = 0;
   double contraste = 0;
-  //  vpDisplay::display(I) ;
-  //  vpERROR_TRACE("getclcik %d",me->range) ;
-  //  vpDisplay::getClick(I) ;
 
   // range = +/- range of pixels within which the correspondent
   // of the current pixel will be sought
-  unsigned int range = me->getRange();
-
-  //  std::cout << i << "  " << j<<"  " << range << "  " << suppress  <<
-  //  std::endl ;
-  vpMeSite *list_query_pixels = getQueryList(I, (int)range);
+  const int range = static_cast<int>(me->getRange());
 
   double contraste_max = 1 + me->getMu2();
   double contraste_min = 1 - me->getMu1();
 
-  // array in which likelihood ratios will be stored
-  double *likelihood = new double[2 * range + 1];
-
   int ii_1 = i;
   int jj_1 = j;
   i_1 = i;
@@ -510,68 +423,110 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, bool test_
   threshold = me->getThreshold();
   double diff = 1e6;
 
-  //    std::cout <<"---------------------"<<std::endl ;
-  for (unsigned int n = 0; n < 2 * range + 1; n++) {
+  // The query sites along the normal share the angle of this site, hence the
+  // same mask
+  const int height_ = static_cast<int>(I.getHeight());
+  const int width_ = static_cast<int>(I.getWidth());
+  const unsigned int msize = me->getMaskSize();
+  const int half = (static_cast<int>(msize) - 1) >> 1;
+  const int border = half + me->getStrip();
+  const short *mask = me->getMaskCoefficients(getMaskIndex(alpha, me));
+  const unsigned int stride = me->getMaskCoefficientsStride();
+  const bool sse2 = useSSE2();
+
+  double salpha = sin(alpha);
+  double calpha = cos(alpha);
+  double max_ifloat = 0, max_jfloat = 0;
+  int max_i = 0, max_j = 0, first_i = 0, first_j = 0;
+  vpImagePoint ip;
+
+  for (int k = -range; k <= range; k++) {
+    double ii = (ifloat + k * salpha);
+    double jj = (jfloat + k * calpha);
+    int qi = static_cast<int>(ii);
+    int qj = static_cast<int>(jj);
+
+    // Display
+    if ((selectDisplay == RANGE_RESULT) || (selectDisplay == RANGE)) {
+      ip.set_i(ii);
+      ip.set_j(jj);
+      vpDisplay::displayCross(I, ip, 1, vpColor::yellow);
+    }
+
     //   convolution results
-    double convolution_ = list_query_pixels[n].convolution(I, me);
+    double convolution_ = 0.0;
+    if (horsImage(qi, qj, border, height_, width_)) {
+      qi = 0;
+      qj = 0;
+    } else {
+      convolution_ = mask_sign * convolveMask(I, qi - half, qj - half, mask, msize, stride, sse2);
+    }
+
+    if (k == -range) {
+      first_i = qi;
+      first_j = qj;
+    }
 
     // luminance ratio of reference pixel to potential correspondent pixel
     // the luminance must be similar, hence the ratio value should
     // lay between, for instance, 0.5 and 1.5 (parameter tolerance)
+    bool better = false;
     if (test_contraste) {
-      likelihood[n] = fabs(convolution_ + convlt);
-      if (likelihood[n] > threshold) {
+      double likelihood = fabs(convolution_ + convlt);
+      if (likelihood > threshold) {
         contraste = convolution_ / convlt;
         if ((contraste > contraste_min) && (contraste < contraste_max) && fabs(1 - contraste) < diff) {
           diff = fabs(1 - contraste);
-          max_convolution = convolution_;
-          max = likelihood[n];
-          max_rank = (int)n;
-          // 	    max_rank2 = max_rank1;
-          // 	    max_rank1 = max_rank;
+          max = likelihood;
+          better = true;
         }
       }
+    } else {
+      double likelihood = fabs(2 * convolution_);
+      if (likelihood > max && likelihood > threshold) {
+        max = likelihood;
+        better = true;
+      }
     }
 
-    else {
-      likelihood[n] = fabs(2 * convolution_);
-      if (likelihood[n] > max && likelihood[n] > threshold) {
-        max_convolution = convolution_;
-        max = likelihood[n];
-        max_rank = (int)n;
-        //           max_rank2 = max_rank1;
-        //           max_rank1 = max_rank;
-      }
+    if (better) {
+      max_convolution = convolution_;
+      max_rank = k + range;
+      max_i = qi;
+      max_j = qj;
+      max_ifloat = ii;
+      max_jfloat = jj;
     }
   }
 
-  // test on the likelihood threshold if threshold==-1 then
-  // the me->threshold is  selected
-
-  vpImagePoint ip;
-
-  //  if (test_contrast)
   if (max_rank >= 0) {
     if ((selectDisplay == RANGE_RESULT) || (selectDisplay == RESULT)) {
-      ip.set_i(list_query_pixels[max_rank].i);
-      ip.set_j(list_query_pixels[max_rank].j);
+      ip.set_i(max_i);
+      ip.set_j(max_j);
       vpDisplay::displayPoint(I, ip, vpColor::red);
     }
 
-    *this = list_query_pixels[max_rank]; // The vpMeSite2 is replaced by the
-                                         // vpMeSite2 of max likelihood
+    // The site is replaced by the query site of max likelihood
+    i = max_i;
+    j = max_j;
+    ifloat = max_ifloat;
+    jfloat = max_jfloat;
+    v = 0;
+    weight = 1;
+    state = NO_SUPPRESSION;
+#ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
+    suppress = 0;
+#endif
     normGradient = vpMath::sqr(max_convolution);
 
     convlt = max_convolution;
-    i_1 = ii_1; // list_query_pixels[max_rank].i ;
-    j_1 = jj_1; // list_query_pixels[max_rank].j ;
-    delete[] list_query_pixels;
-    delete[] likelihood;
+    i_1 = ii_1;
+    j_1 = jj_1;
   } else // none of the query sites is better than the threshold
   {
     if ((selectDisplay == RANGE_RESULT) || (selectDisplay == RESULT)) {
-      ip.set_i(list_query_pixels[0].i);
-      ip.set_j(list_query_pixels[0].j);
+      ip.set_i(first_i);
+      ip.set_j(first_j);
       vpDisplay::displayPoint(I, ip, vpColor::green);
     }
     normGradient = 0;
@@ -580,9 +535,6 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, bool test_
       state = CONSTRAST; // contrast suppression
     else
       state = THRESHOLD; // threshold suppression
-
-    delete[] list_query_pixels;
-    delete[] likelihood; // modif portage
   }
 }
 
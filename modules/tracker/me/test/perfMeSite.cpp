@@ -0,0 +1,275 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Compare the moving-edge site tracking with a reference implementation.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfMeSite.cpp
+
+  \brief Compare the moving-edge site tracking with a reference
+  implementation based on the floating point masks, and benchmark it.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <visp3/core/vpUniRand.h>
+#include <visp3/me/vpMe.h>
+#include <visp3/me/vpMeSite.h>
+
+namespace
+{
+
+bool runBenchmark = false;
+
+// Image with random edges and noise
+void generateImage(vpImage<unsigned char> &I, unsigned int height, unsigned int width)
+{
+  vpUniRand rng(3);
+  I.resize(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      double val = 60 + 120 * ((i / 13 + j / 17) % 2) + 40 * std::sin(0.05 * i + 0.11 * j) + rng.uniform(-10.0, 10.0);
+      I[i][j] = static_cast<unsigned char>(std::max(0.0, std::min(255.0, val)));
+    }
+  }
+}
+
+// Convolution with the floating point masks of vpMe
+double referenceConvolution(const vpImage<unsigned char> &I, const vpMe &me, vpMeSite &site)
+{
+  int half = (static_cast<int>(me.getMaskSize()) - 1) >> 1;
+  int half_1 = half + me.getStrip() + 1, half_3 = half + me.getStrip() + 3;
+  int rows = static_cast<int>(I.getHeight()), cols = static_cast<int>(I.getWidth());
+  if ((site.i < half_1) || (site.i - rows + half_3 > 0) || (site.j < half_1) || (site.j - cols + half_3 > 0)) {
+    site.i = 0;
+    site.j = 0;
+    return 0.0;
+  }
+
+  double theta = site.alpha + M_PI / 2;
+  while (theta < 0)
+    theta += M_PI;
+  while (theta > M_PI)
+    theta -= M_PI;
+  int thetadeg = vpMath::round(theta * 180 / M_PI);
+  if (abs(thetadeg) == 180) {
+    thetadeg = 0;
+  }
+  unsigned int index_mask = (unsigned int)(thetadeg / (double)me.getAngleStep());
+
+  double conv = 0.0;
+  for (unsigned int a = 0; a < me.getMaskSize(); a++) {
+    for (unsigned int b = 0; b < me.getMaskSize(); b++) {
+      conv += site.mask_sign * me.getMask()[index_mask][a][b] * I[site.i - half + a][site.j - half + b];
+    }
+  }
+  return conv;
+}
+
+// Tracking of a site through a list of query sites
+void referenceTrack(const vpImage<unsigned char> &I, const vpMe &me, vpMeSite &site, bool test_contraste)
+{
+  int max_rank = -1;
+  double max_convolution = 0, max = 0, contraste = 0, diff = 1e6;
+  int range = static_cast<int>(me.getRange());
+  vpMeSite *query = site.getQueryList(I, range);
+  int ii_1 = site.i, jj_1 = site.j;
+  site.i_1 = site.i;
+  site.j_1 = site.j;
+
+  for (int n = 0; n < 2 * range + 1; n++) {
+    double conv = referenceConvolution(I, me, query[n]);
+    if (test_contraste) {
+      double likelihood = fabs(conv + site.convlt);
+      if (likelihood > me.getThreshold()) {
+        contraste = conv / site.convlt;
+        if ((contraste > 1 - me.getMu1()) && (contraste < 1 + me.getMu2()) && fabs(1 - contraste) < diff) {
+          diff = fabs(1 - contraste);
+          max_convolution = conv;
+          max = likelihood;
+          max_rank = n;
+        }
+      }
+    } else {
+      double likelihood = fabs(2 * conv);
+      if (likelihood > max && likelihood > me.getThreshold()) {
+        max_convolution = conv;
+        max = likelihood;
+        max_rank = n;
+      }
+    }
+  }
+
+  if (max_rank >= 0) {
+    site = query[max_rank];
+    site.normGradient = vpMath::sqr(max_convolution);
+    site.convlt = max_convolution;
+    site.i_1 = ii_1;
+    site.j_1 = jj_1;
+  } else {
+    site.normGradient = 0;
+    site.setState(std::fabs(contraste) > std::numeric_limits<double>::epsilon() ? vpMeSite::CONSTRAST
+                                                                                : vpMeSite::THRESHOLD);
+  }
+  delete[] query;
+}
+
+std::vector<vpMeSite> generateSites(const vpImage<unsigned char> &I, unsigned int nbSites)
+{
+  vpUniRand rng(7);
+  std::vector<vpMeSite> sites(nbSites);
+  for (size_t k = 0; k < sites.size(); k++) {
+    // Some sites are close to the border or outside of the image
+    sites[k].init(rng.uniform(-5.0, I.getHeight() + 5.0), rng.uniform(-5.0, I.getWidth() + 5.0),
+                  rng.uniform(-M_PI, M_PI), rng.uniform(-3000.0, 3000.0), rng.uniform(0, 2) ? 1 : -1);
+  }
+  return sites;
+}
+
+bool sameSite(const vpMeSite &s1, const vpMeSite &s2)
+{
+  return s1.i == s2.i && s1.j == s2.j && s1.i_1 == s2.i_1 && s1.j_1 == s2.j_1 && s1.ifloat == s2.ifloat &&
+         s1.jfloat == s2.jfloat && s1.v == s2.v && s1.mask_sign == s2.mask_sign && s1.alpha == s2.alpha &&
+         s1.convlt == s2.convlt && s1.normGradient == s2.normGradient && s1.weight == s2.weight &&
+         s1.getState() == s2.getState();
+}
+}
+
+TEST_CASE("Moving-edge site tracking", "[me]")
+{
+  vpImage<unsigned char> I;
+  generateImage(I, 240, 320);
+  const std::vector<vpMeSite> sites = generateSites(I, 2000);
+
+  unsigned int maskSizes[] = {3, 5, 7, 9, 11};
+  unsigned int ranges[] = {0, 4, 10};
+  for (size_t m = 0; m < sizeof(maskSizes) / sizeof(maskSizes[0]); m++) {
+    for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++) {
+      for (int test_contraste = 0; test_contraste < 2; test_contraste++) {
+        vpMe me;
+        me.setMaskSize(maskSizes[m]);
+        me.setRange(ranges[r]);
+        me.setThreshold(test_contraste ? 1000 : 5000);
+        INFO("Mask size " << maskSizes[m] << ", range " << ranges[r] << ", test contrast " << test_contraste);
+
+        unsigned int nbMatches = 0;
+        for (size_t k = 0; k < sites.size(); k++) {
+          vpMeSite site = sites[k], ref = sites[k];
+          site.track(I, &me, test_contraste != 0);
+          referenceTrack(I, me, ref, test_contraste != 0);
+          CHECK(sameSite(site, ref));
+
+          vpMeSite conv = sites[k], refConv = sites[k];
+          CHECK(conv.convolution(I, &me) == referenceConvolution(I, me, refConv));
+          CHECK(sameSite(conv, refConv));
+
+          if (ref.getState() == vpMeSite::NO_SUPPRESSION) {
+            nbMatches++;
+          }
+        }
+        CHECK(nbMatches > 0);
+      }
+    }
+  }
+}
+
+TEST_CASE("Moving-edge site tracking benchmark", "[benchmark]")
+{
+  if (runBenchmark) {
+    vpImage<unsigned char> I;
+    generateImage(I, 480, 640);
+    const std::vector<vpMeSite> sites = generateSites(I, 2000);
+    vpMe me;
+    me.setThreshold(1000);
+
+    BENCHMARK("Reference tracking")
+    {
+      std::vector<vpMeSite> tracked = sites;
+      for (size_t k = 0; k < tracked.size(); k++) {
+        referenceTrack(I, me, tracked[k], true);
+      }
+      return tracked;
+    };
+
+    BENCHMARK("vpMeSite::track()")
+    {
+      std::vector<vpMeSite> tracked = sites;
+      for (size_t k = 0; k < tracked.size(); k++) {
+        tracked[k].track(I, &me, true);
+      }
+      return tracked;
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli() // Get Catch's composite command line parser
+             | Opt(runBenchmark) // bind variable to a new option, with a hint string
+                   ["--benchmark"] // the option names it will respond to
+             ("run benchmark comparing the moving-edge site tracking with the reference implementation"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
@@ -143,6 +143,18 @@ protected:
   vpImage<double> dIy;
   vpTemplateTrackerZone zoneRef_; // Reference zone
 
+  // Coordinates of the template points stored as separate arrays for the
+  // batch warps, and results of warpTemplate() and dWarpTemplate(). The
+  // arrays built from the template are valid until invalidateTemplateCache()
+  bool templateSoAValid;
+  std::vector<double> templateU;
+  std::vector<double> templateV;
+  std::vector<double> warpedU;
+  std::vector<double> warpedV;
+  std::vector<double> dWTemplate;
+  bool dWdp0Valid;
+  std::vector<double> dWdp0Template;
+
 public:
   //! Default constructor.
   vpTemplateTracker()
@@ -155,7 +167,8 @@ public:
       useBrent(false), nbIterBrent(0), taillef(0), fgG(NULL), fgdG(NULL), ratioPixelIn(0), mod_i(0), mod_j(0),
       nbParam(), lambdaDep(0), iterationMax(0), iterationGlobale(0), diverge(false), nbIteration(0),
       useCompositionnal(false), useInverse(false), Warp(NULL), p(), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(),
-      zoneRef_()
+      zoneRef_(), templateSoAValid(false), templateU(), templateV(), warpedU(), warpedV(), dWTemplate(),
+      dWdp0Valid(false), dWdp0Template()
   {
   }
   explicit vpTemplateTracker(vpTemplateTrackerWarp *_warp);
@@ -284,6 +297,8 @@ public:
 
 protected:
   void computeEvalRMS(const vpColVector &p);
+  void dWarpCompoTemplate(const vpColVector &tp, const vpTemplateTrackerPointCompo *ptCompo = NULL);
+  void dWarpTemplate(const vpColVector &tp);
   void computeOptimalBrentGain(const vpImage<unsigned char> &I, vpColVector &tp, double tMI, vpColVector &direction,
                                double &alpha);
   virtual double getCost(const vpImage<unsigned char> &I, const vpColVector &tp) = 0;
@@ -294,7 +309,18 @@ protected:
   virtual void initPyramidal(unsigned int nbLvl, unsigned int l0);
   void initTracking(const vpImage<unsigned char> &I, vpTemplateTrackerZone &zone);
   virtual void initTrackingPyr(const vpImage<unsigned char> &I, vpTemplateTrackerZone &zone);
+  /*!
+    Discard the arrays built from the template points by warpTemplate() and
+    dWarpCompoTemplate(). To call each time \e ptTemplate, \e templateSize or
+    the content of the template points change.
+  */
+  void invalidateTemplateCache()
+  {
+    templateSoAValid = false;
+    dWdp0Valid = false;
+  }
   virtual void trackNoPyr(const vpImage<unsigned char> &I) = 0;
   virtual void trackPyr(const vpImage<unsigned char> &I);
+  void warpTemplate(const vpColVector &tp);
 };
 #endif
@@ -54,6 +54,16 @@
 /*!
   \class vpTemplateTrackerWarp
   \ingroup group_tt_warp
+
+  Base class of the warping functions used by the template trackers.
+
+  Besides the point-wise functions warpX() and dWarp(), the warps provide
+  batch versions warp(), dWarp() and dWarpCompo() that process arrays of
+  point coordinates. Each warp implements them as a loop without virtual call
+  nor vpColVector temporary, so that the trackers call a single virtual
+  function per Gauss-Newton iteration. The default implementations call the
+  point-wise functions, which allows user defined warps to only implement
+  the latter.
 */
 class VISP_EXPORT vpTemplateTrackerWarp
 {
@@ -97,6 +107,12 @@ public:
   virtual void dWarpCompo(const vpColVector &X1, const vpColVector &X2, const vpColVector &ParamM, const double *dwdp0,
                           vpMatrix &dW) = 0;
 
+  virtual void dWarp(const double *ut0, const double *vt0, const double *u, const double *v, int nb_pt,
+                     const vpColVector &p, double *dW);
+
+  virtual void dWarpCompo(const double *ut0, const double *vt0, const double *u, const double *v, int nb_pt,
+                          const vpColVector &p, const double *dwdp0, double *dW);
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
   void findWarp(const double *ut0, const double *vt0, const double *u, const double *v, int nb_pt, vpColVector &p);
 #endif
@@ -192,17 +208,7 @@ public:
     dW.resize(2, nbParam);
   }
 
-  /*!
-    Warp a list of points.
-
-    \param ut0 : List of u coordinates of the points.
-    \param vt0 : List of v coordinates of the points.
-    \param nb_pt : Number of points to consider.
-    \param p : Parameters of the warp.
-    \param u : Resulting u coordinates.
-    \param v : resulting v coordinates.
-  */
-  void warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p, double *u, double *v);
+  virtual void warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p, double *u, double *v);
 
   /*!
     Warp a point.
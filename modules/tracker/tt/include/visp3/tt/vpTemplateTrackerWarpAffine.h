@@ -181,5 +181,24 @@ public:
     \param ParamM : Parameters of the warping function.
   */
   void warpXInv(const vpColVector &vX, vpColVector &vXres, const vpColVector &ParamM);
+
+  /*!
+    Compute the derivative of the warping function according to its
+    parameters for a list of points, see vpTemplateTrackerWarp::dWarp().
+  */
+  void dWarp(const double *ut0, const double *vt0, const double *u, const double *v, int nb_pt, const vpColVector &p,
+             double *dW);
+
+  /*!
+    Compute the compositionnal derivative of the warping function for a list
+    of points, see vpTemplateTrackerWarp::dWarpCompo().
+  */
+  void dWarpCompo(const double *ut0, const double *vt0, const double *u, const double *v, int nb_pt,
+                  const vpColVector &p, const double *dwdp0, double *dW);
+
+  /*!
+    Warp a list of points, see vpTemplateTrackerWarp::warp().
+  */
+  void warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p, double *u, double *v);
 };
 #endif
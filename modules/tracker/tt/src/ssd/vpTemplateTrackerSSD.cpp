@@ -60,17 +60,10 @@ double vpTemplateTrackerSSD::getCost(const vpImage<unsigned char> &I, const vpCo
   double IW;
   int Nbpoint = 0;
 
-  Warp->computeCoeff(tp);
+  warpTemplate(tp);
   for (unsigned int point = 0; point < templateSize; point++) {
-    int i = ptTemplate[point].y;
-    int j = ptTemplate[point].x;
-    X1[0] = j;
-    X1[1] = i;
-    Warp->computeDenom(X1, tp);
-    Warp->warpX(X1, X2, tp);
-
-    double j2 = X2[0];
-    double i2 = X2[1];
+    double j2 = warpedU[point];
+    double i2 = warpedV[point];
     if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
       double Tij = ptTemplate[point].val;
       if (!blur)
@@ -98,19 +91,13 @@ double vpTemplateTrackerSSD::getSSD(const vpImage<unsigned char> &I, const vpCol
   if (pyrInitialised) {
     templateSize = templateSizePyr[0];
     ptTemplate = ptTemplatePyr[0];
+    invalidateTemplateCache();
   }
 
-  Warp->computeCoeff(tp);
+  warpTemplate(tp);
   for (unsigned int point = 0; point < templateSize; point++) {
-    int i = ptTemplate[point].y;
-    int j = ptTemplate[point].x;
-    X1[0] = j;
-    X1[1] = i;
-    Warp->computeDenom(X1, tp);
-    Warp->warpX(X1, X2, tp);
-
-    double j2 = X2[0];
-    double i2 = X2[1];
+    double j2 = warpedU[point];
+    double i2 = warpedV[point];
     if ((j2 < I.getWidth() - 1) && (i2 < I.getHeight() - 1) && (i2 > 0) && (j2 > 0)) {
       double Tij = ptTemplate[point].val;
       IW = I.getValue(i2, j2);
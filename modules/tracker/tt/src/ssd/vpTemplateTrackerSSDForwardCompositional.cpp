@@ -79,7 +79,6 @@ void vpTemplateTrackerSSDForwardCompositional::trackNoPyr(const vpImage<unsigned
   double IW, dIWx, dIWy;
   double Tij;
   unsigned int iteration = 0;
-  int i, j;
   double i2, j2;
   double alpha = 2.;
 
@@ -95,18 +94,11 @@ void vpTemplateTrackerSSDForwardCompositional::trackNoPyr(const vpImage<unsigned
     double erreur = 0;
     G = 0;
     H = 0;
-    Warp->computeCoeff(p);
+    warpTemplate(p);
+    dWarpCompoTemplate(p);
     for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
+      j2 = warpedU[point];
+      i2 = warpedV[point];
       if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
         Tij = ptTemplate[point].val;
         if (!blur)
@@ -117,10 +109,10 @@ void vpTemplateTrackerSSDForwardCompositional::trackNoPyr(const vpImage<unsigned
         dIWy = dIy.getValue(i2, j2);
         Nbpoint++;
 
-        Warp->dWarpCompo(X1, X2, p, ptTemplate[point].dW, dW);
-
+        const double *dW0 = &dWTemplate[2 * nbParam * point];
+        const double *dW1 = dW0 + nbParam;
         for (unsigned int it = 0; it < nbParam; it++)
-          tempt[it] = dW[0][it] * dIWx + dW[1][it] * dIWy;
+          tempt[it] = dW0[it] * dIWx + dW1[it] * dIWy;
 
         for (unsigned int it = 0; it < nbParam; it++)
           for (unsigned int jt = 0; jt < nbParam; jt++)
@@ -51,7 +51,8 @@ vpTemplateTracker::vpTemplateTracker(vpTemplateTrackerWarp *_warp)
     gain(1.), thresholdGradient(40), costFunctionVerification(false), blur(true), useBrent(false), nbIterBrent(3),
     taillef(7), fgG(NULL), fgdG(NULL), ratioPixelIn(0), mod_i(1), mod_j(1), nbParam(0), lambdaDep(0.001),
     iterationMax(30), iterationGlobale(0), diverge(false), nbIteration(0), useCompositionnal(true), useInverse(false),
-    Warp(_warp), p(0), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(), zoneRef_()
+    Warp(_warp), p(0), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(), zoneRef_(), templateSoAValid(false),
+    templateU(), templateV(), warpedU(), warpedV(), dWTemplate(), dWdp0Valid(false), dWdp0Template()
 {
   nbParam = Warp->getNbParam();
   p.resize(nbParam);
@@ -106,6 +107,7 @@ void vpTemplateTracker::initTracking(const vpImage<unsigned char> &I, vpTemplate
 
   templateSize = NbPointDsZone;
   ptTemplate = new vpTemplateTrackerPoint[templateSize];
+  invalidateTemplateCache();
   ptTemplateInit = true;
   ptTemplateSelect = new bool[templateSize];
   ptTemplateSelectInit = true;
@@ -181,6 +183,7 @@ void vpTemplateTracker::resetTracker()
 {
   // reset the tracker parameters
   p = 0;
+  invalidateTemplateCache();
 
   // 	vpTRACE("resetTracking");
   if (pyrInitialised) {
@@ -681,6 +684,8 @@ void vpTemplateTracker::initClick(const vpImage<unsigned char> &I, bool delaunay
     initHessienDesired(I);
     //    trackNoPyr(I);
   }
+  // The template points and their derivatives have been rebuilt
+  invalidateTemplateCache();
 }
 
 /*!
@@ -708,6 +713,8 @@ void vpTemplateTracker::initFromPoints(const vpImage<unsigned char> &I, const st
     initHessienDesired(I);
     // trackNoPyr(I);
   }
+  // The template points and their derivatives have been rebuilt
+  invalidateTemplateCache();
 }
 
 /*!
@@ -729,6 +736,8 @@ void vpTemplateTracker::initFromZone(const vpImage<unsigned char> &I, const vpTe
     initHessienDesired(I);
     //    trackNoPyr(I);
   }
+  // The template points and their derivatives have been rebuilt
+  invalidateTemplateCache();
 }
 
 void vpTemplateTracker::initHessienDesiredPyr(const vpImage<unsigned char> &I)
@@ -740,6 +749,7 @@ void vpTemplateTracker::initHessienDesiredPyr(const vpImage<unsigned char> &I)
   // ptTemplateCompo=ptTemplateCompoPyr[0];
   ptTemplate = ptTemplatePyr[0];
   ptTemplateSelect = ptTemplateSelectPyr[0];
+  invalidateTemplateCache();
   //  ptTemplateSupp=new vpTemplateTrackerPointSuppMIInv[templateSize];
   try {
     initHessienDesired(I);
@@ -768,6 +778,7 @@ void vpTemplateTracker::initHessienDesiredPyr(const vpImage<unsigned char> &I)
       ptTemplateSelect = ptTemplateSelectPyr[i];
       // ptTemplateSupp=ptTemplateSuppPyr[i];
       // ptTemplateCompo=ptTemplateCompoPyr[i];
+      invalidateTemplateCache();
       try {
         initHessienDesired(Itemp);
         ptTemplateSuppPyr[i] = ptTemplateSupp;
@@ -848,6 +859,7 @@ void vpTemplateTracker::trackPyr(const vpImage<unsigned char> &I)
           ptTemplateSelect = ptTemplateSelectPyr[i];
           ptTemplateSupp = ptTemplateSuppPyr[i];
           ptTemplateCompo = ptTemplateCompoPyr[i];
+          invalidateTemplateCache();
           H = HdesirePyr[i];
           HLM = HLMdesirePyr[i];
           HLMdesireInverse = HLMdesireInversePyr[i];
@@ -977,3 +989,74 @@ void vpTemplateTracker::initPosEvalRMS(const vpColVector &param)
     }
   }
 }
+
+/*!
+  Warp all the points of the current template with a single call to the
+  batch warp, the results being stored in \e warpedU and \e warpedV. The
+  coordinates of the template points are gathered in separate arrays the
+  first time a template is warped.
+
+  \param[in] tp : Warp function parameters.
+ */
+void vpTemplateTracker::warpTemplate(const vpColVector &tp)
+{
+  if (!templateSoAValid) {
+    templateU.resize(templateSize);
+    templateV.resize(templateSize);
+    for (unsigned int point = 0; point < templateSize; point++) {
+      templateU[point] = ptTemplate[point].x;
+      templateV[point] = ptTemplate[point].y;
+    }
+    warpedU.resize(templateSize);
+    warpedV.resize(templateSize);
+    templateSoAValid = true;
+  }
+
+  if (templateSize > 0) {
+    Warp->warp(&templateU[0], &templateV[0], static_cast<int>(templateSize), tp, &warpedU[0], &warpedV[0]);
+  }
+}
+
+/*!
+  Compute the derivative of the warp for all the points of the current
+  template, stored in \e dWTemplate as 2 rows of nbParam values per point.
+  warpTemplate() must have been called with the same parameters.
+
+  \param[in] tp : Warp function parameters.
+ */
+void vpTemplateTracker::dWarpTemplate(const vpColVector &tp)
+{
+  dWTemplate.resize(2 * nbParam * templateSize);
+  if (templateSize > 0) {
+    Warp->dWarp(&templateU[0], &templateV[0], &warpedU[0], &warpedV[0], static_cast<int>(templateSize), tp,
+                &dWTemplate[0]);
+  }
+}
+
+/*!
+  Compute the compositionnal derivative of the warp for all the points of
+  the current template, stored in \e dWTemplate as 2 rows of nbParam values
+  per point. warpTemplate() must have been called with the same parameters.
+
+  \param[in] tp : Warp function parameters.
+  \param[in] ptCompo : Points holding the derivatives of the warp at p=0. If
+  NULL, the derivatives stored in the template points are used.
+ */
+void vpTemplateTracker::dWarpCompoTemplate(const vpColVector &tp, const vpTemplateTrackerPointCompo *ptCompo)
+{
+  const unsigned int size = 2 * nbParam;
+  if (!dWdp0Valid) {
+    dWdp0Template.resize(size * templateSize);
+    for (unsigned int point = 0; point < templateSize; point++) {
+      const double *dwdp0 = ptCompo ? ptCompo[point].dW : ptTemplate[point].dW;
+      memcpy(&dWdp0Template[size * point], dwdp0, size * sizeof(double));
+    }
+    dWdp0Valid = true;
+  }
+
+  dWTemplate.resize(size * templateSize);
+  if (templateSize > 0) {
+    Warp->dWarpCompo(&templateU[0], &templateV[0], &warpedU[0], &warpedV[0], static_cast<int>(templateSize), tp,
+                     &dWdp0Template[0], &dWTemplate[0]);
+  }
+}
@@ -92,6 +92,16 @@ double vpTemplateTrackerWarp::getDistanceBetweenZoneAndWarpedZone(const vpTempla
   return res / nb_corners;
 }
 
+/*!
+  Warp a list of points.
+
+  \param ut0 : List of u coordinates (along the columns) of the points.
+  \param vt0 : List of v coordinates (along the rows) of the points.
+  \param nb_pt : Number of points to consider.
+  \param p : Parameters of the warp.
+  \param u : Resulting u coordinates.
+  \param v : Resulting v coordinates.
+*/
 void vpTemplateTrackerWarp::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p, double *u,
                                  double *v)
 {
@@ -108,6 +118,65 @@ void vpTemplateTrackerWarp::warp(const double *ut0, const double *vt0, int nb_pt
   }
 }
 
+/*!
+  Compute the derivative of the warping function according to its
+  parameters for a list of points.
+
+  \param ut0, vt0 : Coordinates of the points before warping.
+  \param u, v : Coordinates of the warped points, as returned by warp().
+  \param nb_pt : Number of points to consider.
+  \param p : Parameters of the warping function.
+  \param dW : Resulting derivatives, stored point after point as 2 rows of
+  getNbParam() values. It should refer to a 2 * getNbParam() * nb_pt array.
+*/
+void vpTemplateTrackerWarp::dWarp(const double *ut0, const double *vt0, const double *u, const double *v, int nb_pt,
+                                  const vpColVector &p, double *dW_)
+{
+  computeCoeff(p);
+  vpColVector X1(2), X2(2);
+  vpMatrix dW_pt(2, nbParam);
+  for (int i = 0; i < nb_pt; i++) {
+    X1[0] = ut0[i];
+    X1[1] = vt0[i];
+    X2[0] = u[i];
+    X2[1] = v[i];
+    computeDenom(X1, p);
+    dWarp(X1, X2, p, dW_pt);
+    memcpy(dW_ + 2 * nbParam * i, dW_pt.data, 2 * nbParam * sizeof(double));
+  }
+}
+
+/*!
+  Compute the compositionnal derivative of the warping function according to
+  its parameters for a list of points.
+
+  \param ut0, vt0 : Coordinates of the points before warping.
+  \param u, v : Coordinates of the warped points, as returned by warp().
+  \param nb_pt : Number of points to consider.
+  \param p : Parameters of the warping function.
+  \param dwdp0 : Derivatives of the warping function according to the
+  initial parameters (p=0), as returned by getdWdp0(), stored point after
+  point.
+  \param dW : Resulting derivatives, stored point after point as 2 rows of
+  getNbParam() values. It should refer to a 2 * getNbParam() * nb_pt array.
+*/
+void vpTemplateTrackerWarp::dWarpCompo(const double *ut0, const double *vt0, const double *u, const double *v,
+                                       int nb_pt, const vpColVector &p, const double *dwdp0, double *dW_)
+{
+  computeCoeff(p);
+  vpColVector X1(2), X2(2);
+  vpMatrix dW_pt(2, nbParam);
+  for (int i = 0; i < nb_pt; i++) {
+    X1[0] = ut0[i];
+    X1[1] = vt0[i];
+    X2[0] = u[i];
+    X2[1] = v[i];
+    computeDenom(X1, p);
+    dWarpCompo(X1, X2, p, dwdp0 + 2 * nbParam * i, dW_pt);
+    memcpy(dW_ + 2 * nbParam * i, dW_pt.data, 2 * nbParam * sizeof(double));
+  }
+}
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 void vpTemplateTrackerWarp::findWarp(const double *ut0, const double *vt0, const double *u, const double *v, int nb_pt,
                                      vpColVector &p)
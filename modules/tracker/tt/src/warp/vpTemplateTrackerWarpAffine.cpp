@@ -188,3 +188,49 @@ void vpTemplateTrackerWarpAffine::pRondp(const vpColVector &p1, const vpColVecto
   pres[4] = TransRes[0];
   pres[5] = TransRes[1];
 }
+
+void vpTemplateTrackerWarpAffine::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p,
+                                       double *u, double *v)
+{
+  const double a00 = 1.0 + p[0], a01 = p[2], a10 = p[1], a11 = 1.0 + p[3];
+  const double tu = p[4], tv = p[5];
+  for (int i = 0; i < nb_pt; i++) {
+    const double x = ut0[i], y = vt0[i];
+    u[i] = a00 * x + a01 * y + tu;
+    v[i] = a10 * x + a11 * y + tv;
+  }
+}
+
+void vpTemplateTrackerWarpAffine::dWarp(const double *ut0, const double *vt0, const double * /*u*/,
+                                        const double * /*v*/, int nb_pt, const vpColVector & /*p*/, double *dW_)
+{
+  for (int i = 0; i < nb_pt; i++, dW_ += 12) {
+    const double x = ut0[i], y = vt0[i];
+    dW_[0] = x;
+    dW_[1] = 0;
+    dW_[2] = y;
+    dW_[3] = 0;
+    dW_[4] = 1;
+    dW_[5] = 0;
+
+    dW_[6] = 0;
+    dW_[7] = x;
+    dW_[8] = 0;
+    dW_[9] = y;
+    dW_[10] = 0;
+    dW_[11] = 1;
+  }
+}
+
+void vpTemplateTrackerWarpAffine::dWarpCompo(const double * /*ut0*/, const double * /*vt0*/, const double * /*u*/,
+                                             const double * /*v*/, int nb_pt, const vpColVector &p,
+                                             const double *dwdp0, double *dW_)
+{
+  const double a00 = 1. + p[0], a01 = p[2], a10 = p[1], a11 = 1. + p[3];
+  for (int i = 0; i < nb_pt; i++, dwdp0 += 12, dW_ += 12) {
+    for (unsigned int k = 0; k < 6; k++) {
+      dW_[k] = a00 * dwdp0[k] + a01 * dwdp0[k + 6];
+      dW_[k + 6] = a10 * dwdp0[k] + a11 * dwdp0[k + 6];
+    }
+  }
+}
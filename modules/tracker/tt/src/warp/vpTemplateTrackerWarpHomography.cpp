@@ -218,3 +218,71 @@ void vpTemplateTrackerWarpHomography::pRondp(const vpColVector &p1, const vpColV
   vpHomography H = H1 * H2;
   getParam(H, pres);
 }
+
+void vpTemplateTrackerWarpHomography::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p,
+                                           double *u, double *v)
+{
+  const double h00 = 1. + p[0], h01 = p[3], h02 = p[6];
+  const double h10 = p[1], h11 = 1. + p[4], h12 = p[7];
+  const double h20 = p[2], h21 = p[5];
+  bool singular = false;
+  for (int i = 0; i < nb_pt; i++) {
+    const double x = ut0[i], y = vt0[i];
+    const double value = h20 * x + h21 * y + 1.;
+    singular |= (std::fabs(value) <= std::numeric_limits<double>::epsilon());
+    const double inv = 1. / value;
+    u[i] = (h00 * x + h01 * y + h02) * inv;
+    v[i] = (h10 * x + h11 * y + h12) * inv;
+  }
+
+  if (singular) {
+    throw(vpTrackingException(vpTrackingException::fatalError,
+                              "Division by zero in vpTemplateTrackerWarpHomography::warp()"));
+  }
+}
+
+void vpTemplateTrackerWarpHomography::dWarp(const double *ut0, const double *vt0, const double *u, const double *v,
+                                            int nb_pt, const vpColVector &p, double *dW_)
+{
+  const double h20 = p[2], h21 = p[5];
+  for (int i = 0; i < nb_pt; i++, dW_ += 16) {
+    const double x = ut0[i], y = vt0[i];
+    const double d = 1. / (h20 * x + h21 * y + 1.);
+    dW_[0] = x * d;
+    dW_[1] = 0;
+    dW_[2] = -x * u[i] * d;
+    dW_[3] = y * d;
+    dW_[4] = 0;
+    dW_[5] = -y * u[i] * d;
+    dW_[6] = d;
+    dW_[7] = 0;
+
+    dW_[8] = 0;
+    dW_[9] = x * d;
+    dW_[10] = -x * v[i] * d;
+    dW_[11] = 0;
+    dW_[12] = y * d;
+    dW_[13] = -y * v[i] * d;
+    dW_[14] = 0;
+    dW_[15] = d;
+  }
+}
+
+void vpTemplateTrackerWarpHomography::dWarpCompo(const double *ut0, const double *vt0, const double *u,
+                                                 const double *v, int nb_pt, const vpColVector &p,
+                                                 const double *dwdp0, double *dW_)
+{
+  const double h00 = 1. + p[0], h01 = p[3], h10 = p[1], h11 = 1. + p[4];
+  const double h20 = p[2], h21 = p[5];
+  for (int i = 0; i < nb_pt; i++, dwdp0 += 16, dW_ += 16) {
+    const double d = 1. / (h20 * ut0[i] + h21 * vt0[i] + 1.);
+    const double dwdx0 = (h00 - u[i] * h20) * d;
+    const double dwdx1 = (h10 - v[i] * h20) * d;
+    const double dwdy0 = (h01 - u[i] * h21) * d;
+    const double dwdy1 = (h11 - v[i] * h21) * d;
+    for (unsigned int k = 0; k < 8; k++) {
+      dW_[k] = dwdx0 * dwdp0[k] + dwdy0 * dwdp0[k + 8];
+      dW_[k + 8] = dwdx1 * dwdp0[k] + dwdy1 * dwdp0[k + 8];
+    }
+  }
+}
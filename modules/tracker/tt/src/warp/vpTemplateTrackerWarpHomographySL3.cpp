@@ -409,3 +409,70 @@ void vpTemplateTrackerWarpHomographySL3::pRondp(const vpColVector &p1, const vpC
   // vrai que si commutatif ...
   pres = p1 + p2;
 }
+
+void vpTemplateTrackerWarpHomographySL3::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p,
+                                              double *u, double *v)
+{
+  computeCoeff(p);
+  const double g00 = G[0][0], g01 = G[0][1], g02 = G[0][2];
+  const double g10 = G[1][0], g11 = G[1][1], g12 = G[1][2];
+  const double g20 = G[2][0], g21 = G[2][1], g22 = G[2][2];
+  for (int i = 0; i < nb_pt; i++) {
+    const double x = ut0[i], y = vt0[i];
+    const double d = x * g20 + y * g21 + g22;
+    u[i] = (x * g00 + y * g01 + g02) / d;
+    v[i] = (x * g10 + y * g11 + g12) / d;
+  }
+}
+
+void vpTemplateTrackerWarpHomographySL3::dWarp(const double *ut0, const double *vt0, const double *u,
+                                               const double *v, int nb_pt, const vpColVector &p, double *dW_)
+{
+  computeCoeff(p);
+  const double g00 = G[0][0], g01 = G[0][1], g02 = G[0][2];
+  const double g10 = G[1][0], g11 = G[1][1], g12 = G[1][2];
+  const double g20 = G[2][0], g21 = G[2][1], g22 = G[2][2];
+  for (int i = 0; i < nb_pt; i++, dW_ += 16) {
+    const double x = ut0[i], y = vt0[i];
+    const double d = x * g20 + y * g21 + g22;
+    const double a = 1. / d, bu = -u[i] / d, bv = -v[i] / d;
+    // dW = dh/dx * dGx, with dGx rows [G0, G1, G0*y, G1*x, G0*x-G1*y, G2-G1*y, G2*x, G2*y]
+    dW_[0] = a * g00 + bu * g20;
+    dW_[1] = a * g01 + bu * g21;
+    dW_[2] = a * g00 * y + bu * g20 * y;
+    dW_[3] = a * g01 * x + bu * g21 * x;
+    dW_[4] = a * (g00 * x - g01 * y) + bu * (g20 * x - g21 * y);
+    dW_[5] = a * (g02 - g01 * y) + bu * (g22 - g21 * y);
+    dW_[6] = a * g02 * x + bu * g22 * x;
+    dW_[7] = a * g02 * y + bu * g22 * y;
+
+    dW_[8] = a * g10 + bv * g20;
+    dW_[9] = a * g11 + bv * g21;
+    dW_[10] = a * g10 * y + bv * g20 * y;
+    dW_[11] = a * g11 * x + bv * g21 * x;
+    dW_[12] = a * (g10 * x - g11 * y) + bv * (g20 * x - g21 * y);
+    dW_[13] = a * (g12 - g11 * y) + bv * (g22 - g21 * y);
+    dW_[14] = a * g12 * x + bv * g22 * x;
+    dW_[15] = a * g12 * y + bv * g22 * y;
+  }
+}
+
+void vpTemplateTrackerWarpHomographySL3::dWarpCompo(const double *ut0, const double *vt0, const double *u,
+                                                    const double *v, int nb_pt, const vpColVector &p,
+                                                    const double *dwdp0, double *dW_)
+{
+  computeCoeff(p);
+  const double g00 = G[0][0], g01 = G[0][1];
+  const double g10 = G[1][0], g11 = G[1][1];
+  const double g20 = G[2][0], g21 = G[2][1], g22 = G[2][2];
+  for (int i = 0; i < nb_pt; i++, dwdp0 += 16, dW_ += 16) {
+    // Same expression as the point-wise dWarpCompo(), that multiplies by the denominator
+    const double d = ut0[i] * g20 + vt0[i] * g21 + g22;
+    const double a0 = g00 - u[i] * g20, b0 = g01 - u[i] * g21;
+    const double a1 = g10 - v[i] * g20, b1 = g11 - v[i] * g21;
+    for (unsigned int k = 0; k < 8; k++) {
+      dW_[k] = d * (a0 * dwdp0[k] + b0 * dwdp0[k + 8]);
+      dW_[k + 8] = d * (a1 * dwdp0[k] + b1 * dwdp0[k + 8]);
+    }
+  }
+}
@@ -176,3 +176,44 @@ void vpTemplateTrackerWarpRT::pRondp(const vpColVector &p1, const vpColVector &p
   pres[1] = TransRes[0];
   pres[2] = TransRes[1];
 }
+
+void vpTemplateTrackerWarpRT::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p, double *u,
+                                   double *v)
+{
+  const double c = cos(p[0]), s = sin(p[0]);
+  const double tu = p[1], tv = p[2];
+  for (int i = 0; i < nb_pt; i++) {
+    const double x = ut0[i], y = vt0[i];
+    u[i] = (c * x) - (s * y) + tu;
+    v[i] = (s * x) + (c * y) + tv;
+  }
+}
+
+void vpTemplateTrackerWarpRT::dWarp(const double *ut0, const double *vt0, const double * /*u*/, const double * /*v*/,
+                                    int nb_pt, const vpColVector &p, double *dW_)
+{
+  const double c = cos(p[0]), s = sin(p[0]);
+  for (int i = 0; i < nb_pt; i++, dW_ += 6) {
+    const double x = ut0[i], y = vt0[i];
+    dW_[0] = (-s * x) - (c * y);
+    dW_[1] = 1;
+    dW_[2] = 0;
+
+    dW_[3] = c * x - s * y;
+    dW_[4] = 0;
+    dW_[5] = 1;
+  }
+}
+
+void vpTemplateTrackerWarpRT::dWarpCompo(const double * /*ut0*/, const double * /*vt0*/, const double * /*u*/,
+                                         const double * /*v*/, int nb_pt, const vpColVector &p, const double *dwdp0,
+                                         double *dW_)
+{
+  const double c = cos(p[0]), s = sin(p[0]);
+  for (int i = 0; i < nb_pt; i++, dwdp0 += 6, dW_ += 6) {
+    for (unsigned int k = 0; k < 3; k++) {
+      dW_[k] = (c * dwdp0[k]) - (s * dwdp0[k + 3]);
+      dW_[k + 3] = (s * dwdp0[k]) + (c * dwdp0[k + 3]);
+    }
+  }
+}
@@ -186,3 +186,47 @@ void vpTemplateTrackerWarpSRT::pRondp(const vpColVector &p1, const vpColVector &
   pres[2] = TransRes[0];
   pres[3] = TransRes[1];
 }
+
+void vpTemplateTrackerWarpSRT::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p, double *u,
+                                    double *v)
+{
+  const double c = (1.0 + p[0]) * cos(p[1]), s = (1.0 + p[0]) * sin(p[1]);
+  const double tu = p[2], tv = p[3];
+  for (int i = 0; i < nb_pt; i++) {
+    const double x = ut0[i], y = vt0[i];
+    u[i] = (c * x) - (s * y) + tu;
+    v[i] = (s * x) + (c * y) + tv;
+  }
+}
+
+void vpTemplateTrackerWarpSRT::dWarp(const double *ut0, const double *vt0, const double * /*u*/, const double * /*v*/,
+                                     int nb_pt, const vpColVector &p, double *dW_)
+{
+  const double c0 = cos(p[1]), s0 = sin(p[1]);
+  const double c = (1.0 + p[0]) * c0, s = (1.0 + p[0]) * s0;
+  for (int i = 0; i < nb_pt; i++, dW_ += 8) {
+    const double x = ut0[i], y = vt0[i];
+    dW_[0] = c0 * x - s0 * y;
+    dW_[1] = (-s * x) - (c * y);
+    dW_[2] = 1;
+    dW_[3] = 0;
+
+    dW_[4] = s0 * x + c0 * y;
+    dW_[5] = c * x - s * y;
+    dW_[6] = 0;
+    dW_[7] = 1;
+  }
+}
+
+void vpTemplateTrackerWarpSRT::dWarpCompo(const double * /*ut0*/, const double * /*vt0*/, const double * /*u*/,
+                                          const double * /*v*/, int nb_pt, const vpColVector &p, const double *dwdp0,
+                                          double *dW_)
+{
+  const double c = (1. + p[0]) * cos(p[1]), s = (1.0 + p[0]) * sin(p[1]);
+  for (int i = 0; i < nb_pt; i++, dwdp0 += 8, dW_ += 8) {
+    for (unsigned int k = 0; k < 4; k++) {
+      dW_[k] = (c * dwdp0[k]) - (s * dwdp0[k + 4]);
+      dW_[k + 4] = (s * dwdp0[k]) + (c * dwdp0[k + 4]);
+    }
+  }
+}
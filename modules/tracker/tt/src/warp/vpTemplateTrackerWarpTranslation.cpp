@@ -126,3 +126,31 @@ void vpTemplateTrackerWarpTranslation::pRondp(const vpColVector &p1, const vpCol
   pres[0] = p1[0] + p2[0];
   pres[1] = p1[1] + p2[1];
 }
+
+void vpTemplateTrackerWarpTranslation::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p,
+                                            double *u, double *v)
+{
+  const double tu = p[0], tv = p[1];
+  for (int i = 0; i < nb_pt; i++) {
+    u[i] = ut0[i] + tu;
+    v[i] = vt0[i] + tv;
+  }
+}
+
+void vpTemplateTrackerWarpTranslation::dWarp(const double * /*ut0*/, const double * /*vt0*/, const double * /*u*/,
+                                             const double * /*v*/, int nb_pt, const vpColVector & /*p*/, double *dW_)
+{
+  for (int i = 0; i < nb_pt; i++, dW_ += 4) {
+    dW_[0] = 1;
+    dW_[1] = 0;
+    dW_[2] = 0;
+    dW_[3] = 1;
+  }
+}
+
+void vpTemplateTrackerWarpTranslation::dWarpCompo(const double * /*ut0*/, const double * /*vt0*/,
+                                                  const double * /*u*/, const double * /*v*/, int nb_pt,
+                                                  const vpColVector & /*p*/, const double *dwdp0, double *dW_)
+{
+  memcpy(dW_, dwdp0, 4 * static_cast<size_t>(nb_pt) * sizeof(double));
+}
@@ -56,24 +56,16 @@ vpTemplateTrackerZNCC::vpTemplateTrackerZNCC(vpTemplateTrackerWarp *warp) : vpTe
 double vpTemplateTrackerZNCC::getCost(const vpImage<unsigned char> &I, const vpColVector &tp)
 {
   double IW, Tij;
-  int i, j;
   double i2, j2;
   int Nbpoint = 0;
 
-  Warp->computeCoeff(tp);
+  warpTemplate(tp);
 
   double moyTij = 0;
   double moyIW = 0;
   for (unsigned int point = 0; point < templateSize; point++) {
-    i = ptTemplate[point].y;
-    j = ptTemplate[point].x;
-    X1[0] = j;
-    X1[1] = i;
-    Warp->computeDenom(X1, tp);
-    Warp->warpX(X1, X2, tp);
-
-    j2 = X2[0];
-    i2 = X2[1];
+    j2 = warpedU[point];
+    i2 = warpedV[point];
     if ((j2 < I.getWidth() - 1) && (i2 < I.getHeight() - 1) && (i2 > 0) && (j2 > 0)) {
       Tij = ptTemplate[point].val;
       if (!blur)
@@ -97,15 +89,8 @@ double vpTemplateTrackerZNCC::getCost(const vpImage<unsigned char> &I, const vpC
   double nom = 0; //,denom=0;
   double var1 = 0, var2 = 0;
   for (unsigned int point = 0; point < templateSize; point++) {
-    i = ptTemplate[point].y;
-    j = ptTemplate[point].x;
-    X1[0] = j;
-    X1[1] = i;
-    Warp->computeDenom(X1, tp);
-    Warp->warpX(X1, X2, tp);
-
-    j2 = X2[0];
-    i2 = X2[1];
+    j2 = warpedU[point];
+    i2 = warpedV[point];
     if ((j2 < I.getWidth() - 1) && (i2 < I.getHeight() - 1) && (i2 > 0) && (j2 > 0)) {
       Tij = ptTemplate[point].val;
       if (!blur)
@@ -162,7 +162,6 @@ void vpTemplateTrackerZNCCForwardAdditional::trackNoPyr(const vpImage<unsigned c
   double IW, dIWx, dIWy;
   double Tij;
   unsigned int iteration = 0;
-  int i, j;
   double i2, j2;
   double alpha = 2.;
 
@@ -178,21 +177,14 @@ void vpTemplateTrackerZNCCForwardAdditional::trackNoPyr(const vpImage<unsigned c
     double erreur = 0;
     G = 0;
     H = 0;
-    Warp->computeCoeff(p);
+    warpTemplate(p);
+    dWarpTemplate(p);
     double moyTij = 0;
     double moyIW = 0;
     double denom = 0;
     for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
+      j2 = warpedU[point];
+      i2 = warpedV[point];
       if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
         Tij = ptTemplate[point].val;
 
@@ -215,16 +207,8 @@ void vpTemplateTrackerZNCCForwardAdditional::trackNoPyr(const vpImage<unsigned c
     moyTij = moyTij / Nbpoint;
     moyIW = moyIW / Nbpoint;
     for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
+      j2 = warpedU[point];
+      i2 = warpedV[point];
       if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
         Tij = ptTemplate[point].val;
 
@@ -236,9 +220,10 @@ void vpTemplateTrackerZNCCForwardAdditional::trackNoPyr(const vpImage<unsigned c
         dIWx = dIx.getValue(i2, j2);
         dIWy = dIy.getValue(i2, j2);
         // Calcul du Hessien
-        Warp->dWarp(X1, X2, p, dW);
+        const double *dW0 = &dWTemplate[2 * nbParam * point];
+        const double *dW1 = dW0 + nbParam;
         for (unsigned int it = 0; it < nbParam; it++)
-          tempt[it] = dW[0][it] * dIWx + dW[1][it] * dIWy;
+          tempt[it] = dW0[it] * dIWx + dW1[it] * dIWy;
 
         double prod = (Tij - moyTij);
         for (unsigned int it = 0; it < nbParam; it++)
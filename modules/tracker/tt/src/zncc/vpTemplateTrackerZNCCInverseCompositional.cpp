@@ -242,7 +242,6 @@ void vpTemplateTrackerZNCCInverseCompositional::trackNoPyr(const vpImage<unsigne
   double Ic;
   double Iref;
   unsigned int iteration = 0;
-  int i, j;
   double i2, j2;
   initPosEvalRMS(p);
 
@@ -253,20 +252,12 @@ void vpTemplateTrackerZNCCInverseCompositional::trackNoPyr(const vpImage<unsigne
   do {
     unsigned int Nbpoint = 0;
     G = 0;
-    Warp->computeCoeff(p);
+    warpTemplate(p);
     double moyIref = 0;
     double moyIc = 0;
     for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
+      j2 = warpedU[point];
+      i2 = warpedV[point];
       if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
         Iref = ptTemplate[point].val;
 
@@ -291,16 +282,8 @@ void vpTemplateTrackerZNCCInverseCompositional::trackNoPyr(const vpImage<unsigne
       sIrefdIref = 0;
 
       for (unsigned int point = 0; point < templateSize; point++) {
-        i = ptTemplate[point].y;
-        j = ptTemplate[point].x;
-        X1[0] = j;
-        X1[1] = i;
-
-        Warp->computeDenom(X1, p);
-        Warp->warpX(X1, X2, p);
-
-        j2 = X2[0];
-        i2 = X2[1];
+        j2 = warpedU[point];
+        i2 = warpedV[point];
         if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
           Iref = ptTemplate[point].val;
 
@@ -0,0 +1,335 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark template tracker warps.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfTemplateTrackerWarp.cpp
+
+  \brief Compare the point-wise and the batch warps of the template trackers.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <cmath>
+
+#include <visp3/tt/vpTemplateTrackerSSDESM.h>
+#include <visp3/tt/vpTemplateTrackerSSDForwardCompositional.h>
+#include <visp3/tt/vpTemplateTrackerWarpAffine.h>
+#include <visp3/tt/vpTemplateTrackerWarpHomography.h>
+#include <visp3/tt/vpTemplateTrackerWarpHomographySL3.h>
+#include <visp3/tt/vpTemplateTrackerWarpRT.h>
+#include <visp3/tt/vpTemplateTrackerWarpSRT.h>
+#include <visp3/tt/vpTemplateTrackerWarpTranslation.h>
+
+namespace
+{
+
+bool runBenchmark = false;
+
+double getRandomValues(double min, double max)
+{
+  return (max - min) * ((double)rand() / (double)RAND_MAX) + min;
+}
+
+// Template points on a regular grid, as sampled by the trackers
+void generateTemplate(unsigned int width, unsigned int height, std::vector<double> &u, std::vector<double> &v)
+{
+  u.clear();
+  v.clear();
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      u.push_back(j);
+      v.push_back(i);
+    }
+  }
+}
+
+vpColVector generateParameters(const vpTemplateTrackerWarp &warp)
+{
+  vpColVector p(warp.getNbParam());
+  for (unsigned int i = 0; i < p.size(); i++) {
+    p[i] = getRandomValues(-0.05, 0.05);
+  }
+  return p;
+}
+
+// Former loop of the trackers, with a virtual call per point
+void warpPointwise(vpTemplateTrackerWarp &warp, const std::vector<double> &ut0, const std::vector<double> &vt0,
+                   const vpColVector &p, std::vector<double> &u, std::vector<double> &v)
+{
+  vpColVector X1(2), X2(2);
+  warp.computeCoeff(p);
+  for (size_t k = 0; k < ut0.size(); k++) {
+    X1[0] = ut0[k];
+    X1[1] = vt0[k];
+    warp.computeDenom(X1, p);
+    warp.warpX(X1, X2, p);
+    u[k] = X2[0];
+    v[k] = X2[1];
+  }
+}
+
+void dWarpPointwise(vpTemplateTrackerWarp &warp, const std::vector<double> &ut0, const std::vector<double> &vt0,
+                    const vpColVector &p, const std::vector<double> &dwdp0, bool compo, std::vector<double> &dW)
+{
+  const unsigned int nbParam = warp.getNbParam();
+  vpColVector X1(2), X2(2);
+  vpMatrix dW_pt(2, nbParam);
+  warp.computeCoeff(p);
+  for (size_t k = 0; k < ut0.size(); k++) {
+    X1[0] = ut0[k];
+    X1[1] = vt0[k];
+    warp.computeDenom(X1, p);
+    warp.warpX(X1, X2, p);
+    if (compo) {
+      warp.dWarpCompo(X1, X2, p, &dwdp0[2 * nbParam * k], dW_pt);
+    } else {
+      warp.dWarp(X1, X2, p, dW_pt);
+    }
+    for (unsigned int i = 0; i < 2 * nbParam; i++) {
+      dW[2 * nbParam * k + i] = dW_pt.data[i];
+    }
+  }
+}
+
+bool equalVector(const std::vector<double> &a, const std::vector<double> &b, double tol)
+{
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (std::fabs(a[i] - b[i]) > tol * (std::max)(1.0, std::fabs(b[i]))) {
+      std::cerr << "Error: a[" << i << "]=" << a[i] << " != b[" << i << "]=" << b[i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+void checkWarp(vpTemplateTrackerWarp &warp, const std::string &name)
+{
+  std::vector<double> ut0, vt0;
+  generateTemplate(100, 80, ut0, vt0);
+  const int nb_pt = static_cast<int>(ut0.size());
+  const unsigned int nbParam = warp.getNbParam();
+
+  std::vector<double> dwdp0(2 * nbParam * ut0.size());
+  for (size_t k = 0; k < ut0.size(); k++) {
+    warp.getdWdp0(static_cast<int>(vt0[k]), static_cast<int>(ut0[k]), &dwdp0[2 * nbParam * k]);
+  }
+
+  for (int iter = 0; iter < 5; iter++) {
+    const vpColVector p = generateParameters(warp);
+
+    std::vector<double> u_true(ut0.size()), v_true(ut0.size()), u(ut0.size()), v(ut0.size());
+    warpPointwise(warp, ut0, vt0, p, u_true, v_true);
+    warp.warp(&ut0[0], &vt0[0], nb_pt, p, &u[0], &v[0]);
+    INFO(name);
+    CHECK(equalVector(u, u_true, 1e-9));
+    CHECK(equalVector(v, v_true, 1e-9));
+
+    std::vector<double> dW_true(2 * nbParam * ut0.size()), dW(2 * nbParam * ut0.size());
+    dWarpPointwise(warp, ut0, vt0, p, dwdp0, false, dW_true);
+    warp.dWarp(&ut0[0], &vt0[0], &u[0], &v[0], nb_pt, p, &dW[0]);
+    CHECK(equalVector(dW, dW_true, 1e-9));
+
+    dWarpPointwise(warp, ut0, vt0, p, dwdp0, true, dW_true);
+    warp.dWarpCompo(&ut0[0], &vt0[0], &u[0], &v[0], nb_pt, p, &dwdp0[0], &dW[0]);
+    CHECK(equalVector(dW, dW_true, 1e-9));
+  }
+
+  if (runBenchmark) {
+    const vpColVector p = generateParameters(warp);
+    std::vector<double> u(ut0.size()), v(ut0.size()), dW(2 * nbParam * ut0.size());
+
+    BENCHMARK(name + " - warp point-wise") {
+      warpPointwise(warp, ut0, vt0, p, u, v);
+      return u[0];
+    };
+
+    BENCHMARK(name + " - warp batch") {
+      warp.warp(&ut0[0], &vt0[0], nb_pt, p, &u[0], &v[0]);
+      return u[0];
+    };
+
+    BENCHMARK(name + " - dWarp point-wise") {
+      dWarpPointwise(warp, ut0, vt0, p, dwdp0, false, dW);
+      return dW[0];
+    };
+
+    BENCHMARK(name + " - dWarp batch") {
+      warp.warp(&ut0[0], &vt0[0], nb_pt, p, &u[0], &v[0]);
+      warp.dWarp(&ut0[0], &vt0[0], &u[0], &v[0], nb_pt, p, &dW[0]);
+      return dW[0];
+    };
+  }
+}
+}
+
+TEST_CASE("Translation warp", "[warp]") {
+  vpTemplateTrackerWarpTranslation warp;
+  checkWarp(warp, "Translation");
+}
+
+TEST_CASE("SRT warp", "[warp]") {
+  vpTemplateTrackerWarpSRT warp;
+  checkWarp(warp, "SRT");
+}
+
+TEST_CASE("RT warp", "[warp]") {
+  vpTemplateTrackerWarpRT warp;
+  checkWarp(warp, "RT");
+}
+
+TEST_CASE("Affine warp", "[warp]") {
+  vpTemplateTrackerWarpAffine warp;
+  checkWarp(warp, "Affine");
+}
+
+TEST_CASE("Homography warp", "[warp]") {
+  vpTemplateTrackerWarpHomography warp;
+  checkWarp(warp, "Homography");
+}
+
+TEST_CASE("Homography SL3 warp", "[warp]") {
+  vpTemplateTrackerWarpHomographySL3 warp;
+  checkWarp(warp, "Homography SL3");
+}
+
+namespace
+{
+// Smooth texture translated by (tu, tv)
+void generateTexture(vpImage<unsigned char> &I, double tu, double tv)
+{
+  I.resize(120, 160);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      const double u = j - tu, v = i - tv;
+      I[i][j] =
+          static_cast<unsigned char>(128 + 50 * std::sin(u / 6.) * std::cos(v / 9.) + 40 * std::sin((u + v) / 11.));
+    }
+  }
+}
+
+std::vector<vpImagePoint> generateZone(double top, double left)
+{
+  std::vector<vpImagePoint> corners;
+  corners.push_back(vpImagePoint(top, left));
+  corners.push_back(vpImagePoint(top, left + 40));
+  corners.push_back(vpImagePoint(top + 30, left + 40));
+  corners.push_back(vpImagePoint(top, left));
+  corners.push_back(vpImagePoint(top + 30, left + 40));
+  corners.push_back(vpImagePoint(top + 30, left));
+  return corners;
+}
+
+// A tracker initialized again on a template of the same size must track as
+// a new tracker, the template arrays cached by the previous tracking being
+// discarded
+template <class Tracker> void checkReinit(const std::string &name)
+{
+  vpImage<unsigned char> I, I_moved;
+  generateTexture(I, 0, 0);
+  generateTexture(I_moved, 1.5, -1.);
+
+  vpTemplateTrackerWarpTranslation warp, warp_ref;
+  Tracker tracker(&warp), tracker_ref(&warp_ref);
+  tracker.setSampling(2, 2);
+  tracker_ref.setSampling(2, 2);
+
+  tracker.initFromPoints(I, generateZone(20, 20), false);
+  tracker.track(I_moved);
+  tracker.resetTracker();
+  tracker.initFromPoints(I, generateZone(50, 90), false);
+  tracker.track(I_moved);
+
+  tracker_ref.initFromPoints(I, generateZone(50, 90), false);
+  tracker_ref.track(I_moved);
+
+  INFO(name);
+  const vpColVector p = tracker.getp(), p_ref = tracker_ref.getp();
+  REQUIRE(p.size() == p_ref.size());
+  for (unsigned int i = 0; i < p.size(); i++) {
+    CHECK(p[i] == Approx(p_ref[i]).margin(1e-12));
+  }
+  CHECK(p_ref[0] == Approx(1.5).margin(0.1));
+  CHECK(p_ref[1] == Approx(-1.).margin(0.1));
+}
+}
+
+TEST_CASE("Tracker initialized again", "[tracker]") {
+  checkReinit<vpTemplateTrackerSSDForwardCompositional>("SSD forward compositional");
+  checkReinit<vpTemplateTrackerSSDESM>("SSD ESM");
+}
+
+int main(int argc, char *argv[])
+{
+  // Initialize the random generator for reproducible values
+  srand(0);
+
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark comparing point-wise and batch warps");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
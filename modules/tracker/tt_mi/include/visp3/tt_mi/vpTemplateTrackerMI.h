@@ -49,6 +49,16 @@
 /*!
   \class vpTemplateTrackerMI
   \ingroup group_tt_mi_tracker
+
+  Base class of the template trackers that maximize the mutual information.
+
+  The joint probability of the template and image intensities and its
+  derivatives are accumulated concurrently on the threads of
+  vpThreadPool::getGlobalInstance() when c++11 is available. The template
+  points are split into as many contiguous chunks as threads, each chunk
+  being accumulated in its own histogram. The histograms are then summed in
+  the order of the chunks, so that the tracking results only depend on the
+  number of threads set with setNbThreads(), not on the scheduling.
 */
 class VISP_EXPORT vpTemplateTrackerMI : public vpTemplateTracker
 {
@@ -114,18 +124,34 @@ protected:
   std::vector< std::vector<double> > m_d2v;
   std::vector< std::vector<double> > m_dA;
 
+  // Inputs of the joint probability for each template point, filled
+  // concurrently by the trackers before accumulateProbabilities()
+  std::vector<int> m_cr;
+  std::vector<double> m_er;
+  std::vector<int> m_ct;
+  std::vector<double> m_et;
+  std::vector<double> m_dWPoint;
+  std::vector<unsigned char> m_validPoint;
+  // Joint probabilities accumulated by the threads other than the first one
+  std::vector< std::vector<double> > m_PrtToutThreads;
+  unsigned int m_nbThreads;
+
 protected:
+  int accumulateProbabilities(bool secondOrder);
+  int accumulateProbabilities(double *prt, unsigned int first, unsigned int last, bool secondOrder);
   void computeGradient();
   void computeHessien(vpMatrix &H);
   void computeHessienNormalized(vpMatrix &H);
   void computeMI(double &MI);
   void computeProba(int &nbpoint);
+  unsigned int getNbChunks() const;
 
   double getCost(const vpImage<unsigned char> &I, const vpColVector &tp);
   double getCost(const vpImage<unsigned char> &I) { return getCost(I, p); }
   double getNormalizedCost(const vpImage<unsigned char> &I, const vpColVector &tp);
   double getNormalizedCost(const vpImage<unsigned char> &I) { return getNormalizedCost(I, p); }
   virtual void initHessienDesired(const vpImage<unsigned char> &I) = 0;
+  void initPointInputs();
   virtual void trackNoPyr(const vpImage<unsigned char> &I) = 0;
   void zeroProbabilities();
 
@@ -157,7 +183,8 @@ public:
       Prt(NULL), dPrt(NULL), Pt(NULL), Pr(NULL), d2Prt(NULL), PrtTout(NULL), dprtemp(NULL), PrtD(NULL), dPrtD(NULL),
       influBspline(0), bspline(0), Nc(0), Ncb(0), d2Ix(), d2Iy(), d2Ixy(), MI_preEstimation(0), MI_postEstimation(0),
       NMI_preEstimation(0), NMI_postEstimation(0), covarianceMatrix(), computeCovariance(false),
-      m_du(), m_dv(), m_A(), m_dB(), m_d2u(), m_d2v(), m_dA()
+      m_du(), m_dv(), m_A(), m_dB(), m_d2u(), m_d2v(), m_dA(), m_cr(), m_er(), m_ct(), m_et(), m_dWPoint(),
+      m_validPoint(), m_PrtToutThreads(), m_nbThreads(0)
   {
   }
   explicit vpTemplateTrackerMI(vpTemplateTrackerWarp *_warp);
@@ -167,6 +194,12 @@ public:
   double getMI(const vpImage<unsigned char> &I, int &nc, const int &bspline, vpColVector &tp);
   double getMI256(const vpImage<unsigned char> &I, const vpColVector &tp);
   double getNMI() const { return NMI_postEstimation; }
+  /*!
+    Return the number of threads used to accumulate the joint probability.
+
+    \sa setNbThreads()
+  */
+  unsigned int getNbThreads() const { return m_nbThreads; }
   // initialisation du Hessien en position desiree
   void setApprocHessian(vpHessienApproximationType approx) { ApproxHessian = approx; }
   void setCovarianceComputation(const bool &flag) { computeCovariance = flag; }
@@ -174,6 +207,19 @@ public:
   void setBspline(const vpBsplineType &newbs);
   void setLambda(double _l) { lambda = _l; }
   void setNc(int newNc);
+  /*!
+    Set the number of threads used to accumulate the joint probability of
+    the template and image intensities. Each thread accumulates a chunk of
+    the template points in its own histogram, and the histograms are summed
+    in a fixed order: the results are reproducible for a given number of
+    threads, and only differ from one number to another by the rounding of
+    the sums.
+
+    \param nbThreads : Number of threads. 0 means all the threads of
+    vpThreadPool::getGlobalInstance(), 1 accumulates the template points
+    sequentially. Default value is 0.
+  */
+  void setNbThreads(unsigned int nbThreads) { m_nbThreads = nbThreads; }
 };
 
 #endif
@@ -72,6 +72,8 @@ protected:
   vpColVector GInverse;
 
 protected:
+  void computePointInputs(const vpImage<unsigned char> &I, bool inverse);
+  void computePointInputs(const vpImage<unsigned char> &I, bool inverse, int start, int end);
   void initCompInverse();
   void initHessienDesired(const vpImage<unsigned char> &I);
   void trackNoPyr(const vpImage<unsigned char> &I);
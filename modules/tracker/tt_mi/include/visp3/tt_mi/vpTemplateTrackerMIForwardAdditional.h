@@ -69,6 +69,8 @@ private:
   vpMatrix KQuasiNewton;
 
 protected:
+  void computePointInputs(const vpImage<unsigned char> &I);
+  void computePointInputs(const vpImage<unsigned char> &I, int start, int end);
   void initHessienDesired(const vpImage<unsigned char> &I);
   void trackNoPyr(const vpImage<unsigned char> &I);
 
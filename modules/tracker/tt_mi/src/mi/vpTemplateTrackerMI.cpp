@@ -38,6 +38,7 @@
  *
  *****************************************************************************/
 #include <visp3/core/vpException.h>
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/tt_mi/vpTemplateTrackerMI.h>
 #include <visp3/tt_mi/vpTemplateTrackerMIBSpline.h>
 
@@ -82,7 +83,9 @@ vpTemplateTrackerMI::vpTemplateTrackerMI(vpTemplateTrackerWarp *_warp)
   : vpTemplateTracker(_warp), hessianComputation(USE_HESSIEN_NORMAL), ApproxHessian(HESSIAN_NEW), lambda(0), temp(NULL),
     Prt(NULL), dPrt(NULL), Pt(NULL), Pr(NULL), d2Prt(NULL), PrtTout(NULL), dprtemp(NULL), PrtD(NULL), dPrtD(NULL),
     influBspline(0), bspline(3), Nc(8), Ncb(0), d2Ix(), d2Iy(), d2Ixy(), MI_preEstimation(0), MI_postEstimation(0),
-    NMI_preEstimation(0), NMI_postEstimation(0), covarianceMatrix(), computeCovariance(false)
+    NMI_preEstimation(0), NMI_postEstimation(0), covarianceMatrix(), computeCovariance(false), m_du(), m_dv(), m_A(),
+    m_dB(), m_d2u(), m_d2v(), m_dA(), m_cr(), m_er(), m_ct(), m_et(), m_dWPoint(), m_validPoint(), m_PrtToutThreads(),
+    m_nbThreads(0)
 {
   Ncb = Nc + bspline;
   influBspline = bspline * bspline;
@@ -385,6 +388,131 @@ void vpTemplateTrackerMI::computeProba(int &nbpoint)
   }
 }
 
+/*!
+  Resize the per point inputs of the joint probability to the size of the
+  current template. The trackers fill them for the range of template points
+  processed by each thread before calling accumulateProbabilities().
+ */
+void vpTemplateTrackerMI::initPointInputs()
+{
+  m_cr.resize(templateSize);
+  m_er.resize(templateSize);
+  m_ct.resize(templateSize);
+  m_et.resize(templateSize);
+  m_dWPoint.resize(templateSize * nbParam);
+  m_validPoint.resize(templateSize);
+}
+
+/*!
+  Return the number of chunks of template points accumulated in separate
+  histograms. It only depends on the number of threads set with
+  setNbThreads() and on the size of the template.
+ */
+unsigned int vpTemplateTrackerMI::getNbChunks() const
+{
+  unsigned int nbChunks = 1;
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  nbChunks = (m_nbThreads > 0) ? m_nbThreads : vpThreadPool::getGlobalInstance().getNbThreads();
+  // Below a few hundred points per chunk, summing the histograms costs more
+  // than accumulating the points
+  const unsigned int minPointsPerChunk = 256;
+  nbChunks = (std::min)(nbChunks, (std::max)(templateSize / minPointsPerChunk, 1u));
+#endif
+  return nbChunks;
+}
+
+/*!
+  Accumulate in PrtTout the joint probability of the valid template points
+  and its derivatives, from the bins, offsets and derivatives of the warp
+  stored in the per point inputs. PrtTout must have been zeroed with
+  zeroProbabilities().
+
+  Each chunk of template points is accumulated in its own histogram, which
+  avoids concurrent writes. The histograms are then summed to PrtTout in the
+  order of the chunks.
+
+  \param secondOrder : If true, the second order derivatives are accumulated
+  too.
+
+  \return The number of valid template points.
+ */
+int vpTemplateTrackerMI::accumulateProbabilities(bool secondOrder)
+{
+  const unsigned int nbChunks = getNbChunks();
+  const int size = Nc * Nc * influBspline * static_cast<int>(1 + nbParam + nbParam * nbParam);
+
+  // The first chunk is directly accumulated in PrtTout
+  if (m_PrtToutThreads.size() < nbChunks - 1) {
+    m_PrtToutThreads.resize(nbChunks - 1);
+  }
+  std::vector<double *> histograms(nbChunks, PrtTout);
+  for (unsigned int chunk = 1; chunk < nbChunks; chunk++) {
+    m_PrtToutThreads[chunk - 1].assign(static_cast<size_t>(size), 0.);
+    histograms[chunk] = &m_PrtToutThreads[chunk - 1][0];
+  }
+  std::vector<int> nbPoints(nbChunks, 0);
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  const unsigned int step = templateSize / nbChunks;
+  vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(nbChunks), [&](int start, int end) {
+    for (int chunk = start; chunk < end; chunk++) {
+      const unsigned int first = static_cast<unsigned int>(chunk) * step;
+      const unsigned int last = (chunk == static_cast<int>(nbChunks) - 1) ? templateSize : first + step;
+      nbPoints[chunk] = accumulateProbabilities(histograms[chunk], first, last, secondOrder);
+    }
+  }, nbChunks, 1);
+
+  if (nbChunks > 1) {
+    // Each bin sums the chunks in the same order whatever the scheduling
+    vpThreadPool::getGlobalInstance().parallelFor(0, size, [&](int start, int end) {
+      for (unsigned int chunk = 1; chunk < nbChunks; chunk++) {
+        const double *histogram = histograms[chunk];
+        for (int i = start; i < end; i++) {
+          PrtTout[i] += histogram[i];
+        }
+      }
+    }, nbChunks);
+  }
+#else
+  nbPoints[0] = accumulateProbabilities(PrtTout, 0, templateSize, secondOrder);
+#endif
+
+  int nbpoint = 0;
+  for (unsigned int chunk = 0; chunk < nbChunks; chunk++) {
+    nbpoint += nbPoints[chunk];
+  }
+  return nbpoint;
+}
+
+/*!
+  Accumulate in \e prt the joint probability of the valid template points of
+  index in [\e first, \e last) and its derivatives.
+
+  \return The number of valid template points in the range.
+ */
+int vpTemplateTrackerMI::accumulateProbabilities(double *prt, unsigned int first, unsigned int last,
+                                                  bool secondOrder)
+{
+  int nbpoint = 0;
+  for (unsigned int point = first; point < last; point++) {
+    if (!m_validPoint[point]) {
+      continue;
+    }
+    nbpoint++;
+    int cr = m_cr[point];
+    double er = m_er[point];
+    int ct = m_ct[point];
+    double et = m_et[point];
+    double *val = &m_dWPoint[point * nbParam];
+    if (secondOrder) {
+      vpTemplateTrackerMIBSpline::PutTotPVBspline(prt, cr, er, ct, et, Nc, val, nbParam, bspline);
+    } else {
+      vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(prt, cr, er, ct, et, Nc, val, nbParam, bspline);
+    }
+  }
+  return nbpoint;
+}
+
 void vpTemplateTrackerMI::computeMI(double &MI)
 {
   unsigned int Ncb_ = (unsigned int)Ncb;
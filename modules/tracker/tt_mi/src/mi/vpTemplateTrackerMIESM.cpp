@@ -38,12 +38,9 @@
  *
  *****************************************************************************/
 
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/tt_mi/vpTemplateTrackerMIESM.h>
 
-#ifdef VISP_HAVE_OPENMP
-#include <omp.h>
-#endif
-
 vpTemplateTrackerMIESM::vpTemplateTrackerMIESM(vpTemplateTrackerWarp *_warp)
   : vpTemplateTrackerMI(_warp), minimizationMethod(USE_NEWTON), CompoInitialised(false), HDirect(), HInverse(),
     HdesireDirect(), HdesireInverse(), GDirect(), GInverse()
@@ -230,24 +227,17 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
   vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
   vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
 
-  int point;
-
   MI_preEstimation = -getCost(I, p);
 
   lambda = lambdaDep;
 
-  double i2, j2;
-  double IW;
-  int cr, ct;
-  double er, et;
-
   vpColVector dpinv(nbParam);
 
   double alpha = 2.;
 
-  int i, j;
   unsigned int iteration = 0;
-  vpColVector tptemp(nbParam);
+  const bool secondOrder =
+      (ApproxHessian != HESSIAN_NONSECOND && hessianComputation != vpTemplateTrackerMI::USE_HESSIEN_DESIRE);
 
   do {
     int Nbpoint = 0;
@@ -257,35 +247,9 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
 
     /////////////////////////////////////////////////////////////////////////
     // Inverse
-    Warp->computeCoeff(p);
-    for (point = 0; point < static_cast<int>(templateSize); point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
-
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-        Nbpoint++;
-
-        if(!blur)
-          IW=I.getValue(i2,j2);
-        else
-          IW=BI.getValue(i2,j2);
-
-        ct = ptTemplateSupp[point].ct;
-        et = ptTemplateSupp[point].et;
-        cr = static_cast<int>((IW*(Nc-1))/255.);
-        er = (IW*(Nc-1))/255.-cr;
-
-        vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam, bspline, ApproxHessian, hessianComputation==USE_HESSIEN_DESIRE);
-      }
-    }
+    warpTemplate(p);
+    computePointInputs(I, true);
+    Nbpoint = accumulateProbabilities(secondOrder);
 
     if (Nbpoint == 0) {
       diverge = true;
@@ -308,47 +272,9 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
 
       zeroProbabilities();
 
-      Warp->computeCoeff(p);
-#ifdef VISP_HAVE_OPENMP
-      int nthreads = omp_get_num_procs();
-      // std::cout << "file: " __FILE__ << " line: " << __LINE__ << "
-      // function: " << __FUNCTION__ << " nthread: " << nthreads << std::endl;
-      omp_set_num_threads(nthreads);
-#pragma omp parallel for private(point, i, j, i2, j2) default(shared)
-#endif
-      for (point = 0; point < static_cast<int>(templateSize); point++) {
-        i = ptTemplate[point].y;
-        j = ptTemplate[point].x;
-        X1[0] = j;
-        X1[1] = i;
-        Warp->computeDenom(X1, p);
-        Warp->warpX(i, j, i2, j2, p);
-        X2[0] = j2;
-        X2[1] = i2;
-
-        if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-          Nbpoint++;
-
-          if(!blur)
-            IW=I.getValue(i2,j2);
-          else
-            IW=BI.getValue(i2,j2);
-
-          double dx = dIx.getValue(i2, j2) * (Nc - 1) / 255.;
-          double dy = dIy.getValue(i2, j2) * (Nc - 1) / 255.;
-
-          ct = static_cast<int>((IW*(Nc-1))/255.);
-          et = (IW*(Nc-1))/255.-ct;
-          cr = ptTemplateSupp[point].ct;
-          er = ptTemplateSupp[point].et;
-          Warp->dWarpCompo(X1, X2, p, ptTemplateCompo[point].dW, dW);
-
-          for (unsigned int it = 0; it < nbParam; it++)
-            tptemp[it] = dW[0][it] * dx + dW[1][it] * dy;
-
-          vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout,cr, er, ct, et, Nc, tptemp.data, nbParam, bspline, ApproxHessian, hessianComputation==USE_HESSIEN_DESIRE);
-        }
-      }
+      dWarpCompoTemplate(p, ptTemplateCompo);
+      computePointInputs(I, false);
+      Nbpoint = accumulateProbabilities(secondOrder);
 
       computeProba(Nbpoint);
       computeMI(MI);
@@ -409,3 +335,71 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
 
   nbIteration = iteration;
 }
+
+/*!
+  Compute the bins and offsets of the template and image intensities of the
+  template points warped by warpTemplate(), as well as the derivatives of
+  the intensity with respect to the parameters. The template points are
+  processed concurrently, each one writing its own inputs.
+
+  \param I : Current image.
+  \param inverse : If true, compute the inputs of the inverse compositional
+  step, where the derivatives are the ones of the template. Otherwise,
+  compute the inputs of the forward compositional step from the derivatives
+  of the image, dWarpCompoTemplate() having been called.
+ */
+void vpTemplateTrackerMIESM::computePointInputs(const vpImage<unsigned char> &I, bool inverse)
+{
+  initPointInputs();
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(templateSize), [&](int start, int end) {
+    computePointInputs(I, inverse, start, end);
+  }, m_nbThreads);
+#else
+  computePointInputs(I, inverse, 0, static_cast<int>(templateSize));
+#endif
+}
+
+void vpTemplateTrackerMIESM::computePointInputs(const vpImage<unsigned char> &I, bool inverse, int start, int end)
+{
+  for (int point = start; point < end; point++) {
+    double j2 = warpedU[point];
+    double i2 = warpedV[point];
+
+    if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+      m_validPoint[point] = 1;
+
+      double IW;
+      if (!blur)
+        IW = I.getValue(i2, j2);
+      else
+        IW = BI.getValue(i2, j2);
+
+      double *tptemp = &m_dWPoint[nbParam * point];
+      if (inverse) {
+        m_ct[point] = ptTemplateSupp[point].ct;
+        m_et[point] = ptTemplateSupp[point].et;
+        m_cr[point] = static_cast<int>((IW * (Nc - 1)) / 255.);
+        m_er[point] = (IW * (Nc - 1)) / 255. - m_cr[point];
+
+        memcpy(tptemp, ptTemplate[point].dW, nbParam * sizeof(double));
+      } else {
+        double dx = dIx.getValue(i2, j2) * (Nc - 1) / 255.;
+        double dy = dIy.getValue(i2, j2) * (Nc - 1) / 255.;
+
+        m_ct[point] = static_cast<int>((IW * (Nc - 1)) / 255.);
+        m_et[point] = (IW * (Nc - 1)) / 255. - m_ct[point];
+        m_cr[point] = ptTemplateSupp[point].ct;
+        m_er[point] = ptTemplateSupp[point].et;
+
+        const double *dW0 = &dWTemplate[2 * nbParam * point];
+        const double *dW1 = dW0 + nbParam;
+        for (unsigned int it = 0; it < nbParam; it++)
+          tptemp[it] = dW0[it] * dx + dW1[it] * dy;
+      }
+    } else {
+      m_validPoint[point] = 0;
+    }
+  }
+}
@@ -38,11 +38,10 @@
  *
  *****************************************************************************/
 
-#include <visp3/tt_mi/vpTemplateTrackerMIForwardAdditional.h>
+#include <algorithm>
 
-#ifdef VISP_HAVE_OPENMP
-#include <omp.h>
-#endif
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIForwardAdditional.h>
 
 vpTemplateTrackerMIForwardAdditional::vpTemplateTrackerMIForwardAdditional(vpTemplateTrackerWarp *_warp)
   : vpTemplateTrackerMI(_warp), minimizationMethod(USE_NEWTON), p_prec(), G_prec(), KQuasiNewton()
@@ -52,8 +51,6 @@ vpTemplateTrackerMIForwardAdditional::vpTemplateTrackerMIForwardAdditional(vpTem
 
 void vpTemplateTrackerMIForwardAdditional::initHessienDesired(const vpImage<unsigned char> &I)
 {
-  dW = 0;
-
   int Nbpoint = 0;
 
   if (blur)
@@ -61,58 +58,14 @@ void vpTemplateTrackerMIForwardAdditional::initHessienDesired(const vpImage<unsi
   vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
   vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
 
-  double Tij;
-  double IW, dx, dy;
-  int cr, ct;
-  double er, et;
-
-  Nbpoint = 0;
-
   zeroProbabilities();
-  Warp->computeCoeff(p);
-  for (unsigned int point = 0; point < templateSize; point++) {
-    int i = ptTemplate[point].y;
-    int j = ptTemplate[point].x;
-    X1[0] = j;
-    X1[1] = i;
-    X2[0] = j;
-    X2[1] = i;
-
-    Warp->computeDenom(X1, p);
-    Warp->warpX(X1, X2, p);
-
-    double j2 = X2[0];
-    double i2 = X2[1];
-
-    if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-      Nbpoint++;
-      Tij = ptTemplate[point].val;
-      if (!blur)
-        IW = I.getValue(i2, j2);
-      else
-        IW = BI.getValue(i2, j2);
-
-      dx = dIx.getValue(i2, j2) * (Nc - 1) / 255.;
-      dy = dIy.getValue(i2, j2) * (Nc - 1) / 255.;
-
-      ct = static_cast<int>((IW * (Nc - 1)) / 255.);
-      cr = static_cast<int>((Tij * (Nc - 1)) / 255.);
-      et = (IW * (Nc - 1)) / 255. - ct;
-      er = (static_cast<double>(Tij) * (Nc - 1)) / 255. - cr;
-      Warp->dWarp(X1, X2, p, dW);
-
-      double *tptemp = new double[nbParam];
-      for (unsigned int it = 0; it < nbParam; it++)
-        tptemp[it] = dW[0][it] * dx + dW[1][it] * dy;
-
-      if (ApproxHessian == HESSIAN_NONSECOND)
-        vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-      else if (ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
-        vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-      delete[] tptemp;
-    }
-  }
+  computePointInputs(I);
+  if (ApproxHessian == HESSIAN_NONSECOND)
+    Nbpoint = accumulateProbabilities(false);
+  else if (ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
+    Nbpoint = accumulateProbabilities(true);
+  else
+    Nbpoint = static_cast<int>(std::count(m_validPoint.begin(), m_validPoint.end(), 1));
 
   if (Nbpoint > 0) {
     double MI;
@@ -131,8 +84,6 @@ void vpTemplateTrackerMIForwardAdditional::initHessienDesired(const vpImage<unsi
 
 void vpTemplateTrackerMIForwardAdditional::trackNoPyr(const vpImage<unsigned char> &I)
 {
-  dW = 0;
-
   int Nbpoint = 0;
   if (blur)
     vpImageFilter::filter(I, BI, fgG, taillef);
@@ -161,58 +112,13 @@ void vpTemplateTrackerMIForwardAdditional::trackNoPyr(const vpImage<unsigned cha
     // erreur=0;
 
     zeroProbabilities();
-
-    Warp->computeCoeff(p);
-#ifdef VISP_HAVE_OPENMP
-    int nthreads = omp_get_num_procs();
-    // std::cout << "file: " __FILE__ << " line: " << __LINE__ << " function:
-    // " << __FUNCTION__ << " nthread: " << nthreads << std::endl;
-    omp_set_num_threads(nthreads);
-#pragma omp parallel for default(shared)
-#endif
-    for (int point = 0; point < (int)templateSize; point++) {
-      int i = ptTemplate[point].y;
-      int j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      double j2 = X2[0];
-      double i2 = X2[1];
-
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
-        Nbpoint++;
-        double Tij = ptTemplate[point].val;
-        double IW;
-        if (!blur)
-          IW = I.getValue(i2, j2);
-        else
-          IW = BI.getValue(i2, j2);
-
-        double dx = dIx.getValue(i2, j2) * (Nc - 1) / 255.;
-        double dy = dIy.getValue(i2, j2) * (Nc - 1) / 255.;
-
-        int ct = (int)((IW * (Nc - 1)) / 255.);
-        int cr = (int)((Tij * (Nc - 1)) / 255.);
-        double et = (IW * (Nc - 1)) / 255. - ct;
-        double er = ((double)Tij * (Nc - 1)) / 255. - cr;
-
-        Warp->dWarp(X1, X2, p, dW);
-
-        double *tptemp = new double[nbParam];
-        ;
-        for (unsigned int it = 0; it < nbParam; it++)
-          tptemp[it] = (dW[0][it] * dx + dW[1][it] * dy);
-        if (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
-          vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-        else if (ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
-          vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-        delete[] tptemp;
-      }
-    }
+    computePointInputs(I);
+    if (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
+      Nbpoint = accumulateProbabilities(false);
+    else if (ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
+      Nbpoint = accumulateProbabilities(true);
+    else
+      Nbpoint = static_cast<int>(std::count(m_validPoint.begin(), m_validPoint.end(), 1));
 
     if (Nbpoint == 0) {
       diverge = true;
@@ -327,3 +233,61 @@ void vpTemplateTrackerMIForwardAdditional::trackNoPyr(const vpImage<unsigned cha
     MI_postEstimation = -1;
   }
 }
+
+/*!
+  Warp the template points with the current parameters and compute the bins
+  and offsets of the template and image intensities, as well as the
+  derivatives of the image intensity with respect to the parameters. The
+  template points are processed concurrently, each one writing its own
+  inputs.
+
+  \param I : Current image.
+ */
+void vpTemplateTrackerMIForwardAdditional::computePointInputs(const vpImage<unsigned char> &I)
+{
+  warpTemplate(p);
+  dWarpTemplate(p);
+  initPointInputs();
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(templateSize), [&](int start, int end) {
+    computePointInputs(I, start, end);
+  }, m_nbThreads);
+#else
+  computePointInputs(I, 0, static_cast<int>(templateSize));
+#endif
+}
+
+void vpTemplateTrackerMIForwardAdditional::computePointInputs(const vpImage<unsigned char> &I, int start, int end)
+{
+  for (int point = start; point < end; point++) {
+    double j2 = warpedU[point];
+    double i2 = warpedV[point];
+
+    if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+      m_validPoint[point] = 1;
+      double Tij = ptTemplate[point].val;
+      double IW;
+      if (!blur)
+        IW = I.getValue(i2, j2);
+      else
+        IW = BI.getValue(i2, j2);
+
+      double dx = dIx.getValue(i2, j2) * (Nc - 1) / 255.;
+      double dy = dIy.getValue(i2, j2) * (Nc - 1) / 255.;
+
+      m_ct[point] = (int)((IW * (Nc - 1)) / 255.);
+      m_cr[point] = (int)((Tij * (Nc - 1)) / 255.);
+      m_et[point] = (IW * (Nc - 1)) / 255. - m_ct[point];
+      m_er[point] = ((double)Tij * (Nc - 1)) / 255. - m_cr[point];
+
+      const double *dW0 = &dWTemplate[2 * nbParam * point];
+      const double *dW1 = dW0 + nbParam;
+      double *tptemp = &m_dWPoint[nbParam * point];
+      for (unsigned int it = 0; it < nbParam; it++)
+        tptemp[it] = dW0[it] * dx + dW1[it] * dy;
+    } else {
+      m_validPoint[point] = 0;
+    }
+  }
+}
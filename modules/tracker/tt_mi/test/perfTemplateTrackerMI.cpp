@@ -0,0 +1,200 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark mutual information template trackers.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfTemplateTrackerMI.cpp
+
+  \brief Check that the mutual information template trackers give
+  reproducible results when the joint probability is accumulated on several
+  threads.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <cmath>
+#include <string.h>
+
+#include <visp3/tt/vpTemplateTrackerWarpHomography.h>
+#include <visp3/tt/vpTemplateTrackerWarpHomographySL3.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIESM.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIForwardAdditional.h>
+
+namespace
+{
+
+bool runBenchmark = false;
+
+// Smooth texture translated by (du, dv)
+void generateImage(vpImage<unsigned char> &I, double du, double dv)
+{
+  I.resize(240, 320);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      double u = j - du, v = i - dv;
+      double val = 128 + 60 * sin(u / 7.) * cos(v / 9.) + 40 * sin((u + 2 * v) / 13.);
+      I[i][j] = vpMath::saturate<unsigned char>(val);
+    }
+  }
+}
+
+std::vector<vpImagePoint> getTemplateCorners()
+{
+  std::vector<vpImagePoint> corners;
+  corners.push_back(vpImagePoint(70, 100));
+  corners.push_back(vpImagePoint(70, 220));
+  corners.push_back(vpImagePoint(170, 220));
+  corners.push_back(vpImagePoint(170, 100));
+  return corners;
+}
+
+template <class Tracker>
+vpColVector track(vpTemplateTrackerWarp &warp, const vpImage<unsigned char> &I0, const vpImage<unsigned char> &I1,
+                  unsigned int nbThreads)
+{
+  Tracker tracker(&warp);
+  tracker.setSampling(2, 2);
+  tracker.setIterationMax(50);
+  tracker.setNbThreads(nbThreads);
+  tracker.initFromPoints(I0, getTemplateCorners(), true);
+  tracker.track(I1);
+  return tracker.getp();
+}
+
+template <class Tracker>
+void checkTracker(vpTemplateTrackerWarp &warp)
+{
+  const double du = 2.3, dv = -1.7;
+  vpImage<unsigned char> I0, I1;
+  generateImage(I0, 0, 0);
+  generateImage(I1, du, dv);
+
+  vpColVector p1 = track<Tracker>(warp, I0, I1, 1);
+
+  // The center of the template follows the translation of the image
+  double u0 = 160, v0 = 120, u1, v1;
+  warp.warp(&u0, &v0, 1, p1, &u1, &v1);
+  CHECK(u1 - u0 == Approx(du).margin(0.3));
+  CHECK(v1 - v0 == Approx(dv).margin(0.3));
+
+  for (unsigned int nbThreads = 2; nbThreads <= 4; nbThreads++) {
+    vpColVector p = track<Tracker>(warp, I0, I1, nbThreads);
+    vpColVector p_bis = track<Tracker>(warp, I0, I1, nbThreads);
+    REQUIRE(p.size() == p1.size());
+
+    // Same number of threads, same chunks and same results
+    CHECK(memcmp(p.data, p_bis.data, p.size() * sizeof(double)) == 0);
+
+    // Only the rounding of the sums differs from the sequential accumulation
+    for (unsigned int i = 0; i < p.size(); i++) {
+      CHECK(p[i] == Approx(p1[i]).margin(1e-6));
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("MI forward additional", "[mi]") {
+  vpTemplateTrackerWarpHomography warp;
+  checkTracker<vpTemplateTrackerMIForwardAdditional>(warp);
+}
+
+TEST_CASE("MI ESM", "[mi]") {
+  vpTemplateTrackerWarpHomographySL3 warp;
+  checkTracker<vpTemplateTrackerMIESM>(warp);
+}
+
+TEST_CASE("MI tracking benchmark", "[benchmark]") {
+  if (runBenchmark) {
+    vpImage<unsigned char> I0, I1;
+    generateImage(I0, 0, 0);
+    generateImage(I1, 2.3, -1.7);
+    vpTemplateTrackerWarpHomography warp;
+
+    BENCHMARK("Forward additional - 1 thread") {
+      return track<vpTemplateTrackerMIForwardAdditional>(warp, I0, I1, 1);
+    };
+
+    BENCHMARK("Forward additional - all threads") {
+      return track<vpTemplateTrackerMIForwardAdditional>(warp, I0, I1, 0);
+    };
+
+    vpTemplateTrackerWarpHomographySL3 warpSL3;
+
+    BENCHMARK("ESM - 1 thread") {
+      return track<vpTemplateTrackerMIESM>(warpSL3, I0, I1, 1);
+    };
+
+    BENCHMARK("ESM - all threads") {
+      return track<vpTemplateTrackerMIESM>(warpSL3, I0, I1, 0);
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark comparing sequential and multi-threaded tracking");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
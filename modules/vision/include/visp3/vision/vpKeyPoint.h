@@ -55,6 +55,7 @@
 #include <visp3/core/vpPlane.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/vision/vpBasicKeyPoint.h>
+#include <visp3/vision/vpKeyPointDatabase.h>
 #include <visp3/vision/vpPose.h>
 #ifdef VISP_HAVE_MODULE_IO
 #  include <visp3/io/vpImageIo.h>
@@ -320,6 +321,8 @@ public:
              const std::string &matcherName = "BruteForce",
              const vpFilterMatchingType &filterType = ratioDistanceThreshold);
 
+  void appendLearningData(const std::string &filename, bool saveTrainingImages = true);
+
   unsigned int buildReference(const vpImage<unsigned char> &I);
   unsigned int buildReference(const vpImage<unsigned char> &I, const vpImagePoint &iP, unsigned int height,
                               unsigned int width);
@@ -1213,6 +1216,9 @@ private:
   //! List of k-nearest neighbors for each detected keypoints (if the method
   //! chosen is based upon on knn).
   std::vector<std::vector<cv::DMatch> > m_knnMatches;
+  //! Binary learning database mapped in memory, used in place by
+  //! m_trainDescriptors when it is not empty.
+  cv::Ptr<vpKeyPointDatabase> m_learningDatabase;
   //! Map descriptor enum type to string.
   std::map<vpFeatureDescriptorType, std::string> m_mapOfDescriptorNames;
   //! Map detector enum type to string.
@@ -1220,6 +1226,9 @@ private:
   //! Map of image id to know to which training image is related a training
   //! keypoints.
   std::map<int, int> m_mapOfImageId;
+  //! Map of image id and path of the training images loaded from a learning
+  //! file that are not read yet.
+  std::map<int, std::string> m_mapOfImagePaths;
   //! Map of images to have access to the image buffer according to his image
   //! id.
   std::map<int, vpImage<unsigned char> > m_mapOfImages;
@@ -1328,6 +1337,14 @@ private:
   void initExtractor(const std::string &extractorName);
   void initExtractors(const std::vector<std::string> &extractorNames);
 
+  void addTrainingImagePath(int imageId, const std::string &path, const std::string &parent);
+  void loadLearningDatabase(const std::string &filename, const std::string &parent, bool append, int startClassId,
+                            int startImageId, cv::Ptr<vpKeyPointDatabase> &database);
+  void loadTrainingImages();
+
+  void saveLearningDatabase(const std::string &filename, bool saveTrainingImages, bool append);
+  std::map<int, std::string> writeTrainingImages(const std::string &parent, unsigned int firstIndex);
+
   void initFeatureNames();
 
   inline size_t myKeypointHash(const cv::KeyPoint &kp)
@@ -0,0 +1,159 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Memory-mapped binary learning database used by vpKeyPoint.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpKeyPointDatabase.h
+  \brief Memory-mapped binary learning database used by vpKeyPoint.
+*/
+
+#ifndef _vpKeyPointDatabase_h_
+#define _vpKeyPointDatabase_h_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpKeyPointDatabase
+  \ingroup group_vision_keypoints
+
+  \brief Versioned binary file of keypoint learning data that is memory-mapped
+  and used in place.
+
+  A database file starts with a 64 bytes header followed by one or more object
+  blocks. Each block stores the training image paths, the keypoints, the
+  optional 3D points and the descriptor matrix of one learning session. Every
+  array is stored in little-endian and starts on a 64 bytes boundary, so that
+  once the file is mapped the keypoints and the descriptors can be accessed
+  directly without any parsing or copy. New blocks are appended at the end of
+  the file with append(), the existing blocks are never rewritten.
+
+  The mapping is private: writing into the memory returned by getDescriptors()
+  is allowed but never modifies the file.
+
+  This class does not depend on OpenCV. It is used by
+  vpKeyPoint::saveLearningData(), vpKeyPoint::appendLearningData() and
+  vpKeyPoint::loadLearningData() in binary mode.
+
+  \warning Only available on little-endian machines. On other machines
+  open(), write() and append() throw a vpException.
+*/
+class VISP_EXPORT vpKeyPointDatabase
+{
+public:
+  /*!
+    Keypoint as stored in the database, with the same fields than
+    cv::KeyPoint plus the id of the training image (-1 if none).
+  */
+  struct KeyPoint {
+    float u;
+    float v;
+    float size;
+    float angle;
+    float response;
+    int octave;
+    int class_id;
+    int image_id;
+  };
+
+  /*!
+    Description of one object block. When written, the pointers refer to the
+    user data to save. When read, they point inside the mapped file.
+  */
+  struct VISP_EXPORT Object {
+    Object();
+
+    //! Map of training image id and image path.
+    std::map<int, std::string> images;
+    //! Number of keypoints, 3D points and descriptors.
+    unsigned int nbKeyPoints;
+    //! Keypoints.
+    const KeyPoint *keyPoints;
+    //! 3D points stored as consecutive (X, Y, Z) triplets, or NULL if none.
+    const float *points;
+    //! Descriptors, one row per keypoint.
+    const unsigned char *descriptors;
+    //! Size in bytes of a descriptor row in memory.
+    size_t descriptorStep;
+    //! Number of values in a descriptor row.
+    unsigned int descriptorCols;
+    //! Descriptor type (OpenCV type code, e.g. CV_8U or CV_32F).
+    int descriptorType;
+    //! Size in bytes of a descriptor value.
+    unsigned int descriptorElemSize;
+  };
+
+  vpKeyPointDatabase();
+  explicit vpKeyPointDatabase(const std::string &filename);
+  virtual ~vpKeyPointDatabase();
+
+  static void append(const std::string &filename, const Object &object);
+
+  void close();
+
+  unsigned char *getDescriptors(unsigned int index);
+  /*!
+    Return the number of object blocks in the opened database.
+  */
+  inline unsigned int getNbObjects() const { return static_cast<unsigned int>(m_objects.size()); }
+  const Object &getObject(unsigned int index) const;
+
+  static bool isDatabase(const std::string &filename);
+  /*!
+    Return true if a database is currently opened.
+  */
+  inline bool isOpen() const { return m_data != NULL; }
+
+  void open(const std::string &filename);
+
+  static void write(const std::string &filename, const Object &object);
+
+private:
+  vpKeyPointDatabase(const vpKeyPointDatabase &);            // noncopyable
+  vpKeyPointDatabase &operator=(const vpKeyPointDatabase &); //
+
+  //! Start of the file in memory.
+  unsigned char *m_data;
+  //! Size of the file in bytes.
+  size_t m_size;
+  //! True if m_data is a file mapping, false if it was read in memory.
+  bool m_mapped;
+  //! Object blocks pointing inside m_data.
+  std::vector<Object> m_objects;
+};
+
+#endif
@@ -144,7 +144,7 @@ private:
   std::vector<vpPoint> listOfPoints;
   //! If true, use a parallel RANSAC implementation
   bool useParallelRansac;
-  //! Number of threads to spawn for the parallel RANSAC implementation
+  //! Number of parts the trials are split in for the parallel RANSAC implementation
   int nbParallelRansacThreads;
   //! Stop the optimization loop when the residual change (|r-r_prec|) <=
   //! epsilon
@@ -221,6 +221,18 @@ public:
   bool poseRansac(vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneousMatrix &) = NULL);
   void poseVirtualVSrobust(vpHomogeneousMatrix &cMo);
   void poseVirtualVS(vpHomogeneousMatrix &cMo);
+
+  /*!
+    @name Pose from contiguous arrays of correspondences
+  */
+  //@{
+  bool poseRansac(const double *objectPoints, const double *imagePoints, unsigned int nbPoints,
+                  vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneousMatrix &) = NULL);
+  void poseVirtualVS(const double *objectPoints, const double *imagePoints, unsigned int nbPoints,
+                     vpHomogeneousMatrix &cMo);
+  static double computeResidual(const double *objectPoints, const double *imagePoints, unsigned int nbPoints,
+                                const vpHomogeneousMatrix &cMo);
+  //@}
   void printPoint();
   void setDistanceToPlaneForCoplanarityTest(double d);
   void setLambda(double a) { lambda = a; }
@@ -245,7 +257,7 @@ public:
     }
   }
   void setRansacMaxTrials(const int &rM) { ransacMaxTrials = rM; }
-  unsigned int getRansacNbInliers() const { return (unsigned int)ransacInliers.size(); }
+  unsigned int getRansacNbInliers() const { return (unsigned int)ransacInlierIndex.size(); }
   std::vector<unsigned int> getRansacInlierIndex() const { return ransacInlierIndex; }
   std::vector<vpPoint> getRansacInliers() const { return ransacInliers; }
 
@@ -299,8 +311,9 @@ public:
     Set the number of threads for the parallel RANSAC implementation.
 
     \note You have to enable the parallel version with setUseParallelRansac().
-    If the number of threads is 0, the number of threads to use is
-    automatically determined with C++11.
+    The trials are split into \e nb parts executed by the pool returned by
+    vpThreadPool::getGlobalInstance(). If the number of threads is 0, the
+    number of threads of this pool is used.
     \sa setUseParallelRansac
   */
   inline void setNbParallelRansacThreads(int nb) { nbParallelRansacThreads = nb; }
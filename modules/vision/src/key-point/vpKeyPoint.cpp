@@ -39,6 +39,7 @@
 #include <iomanip>
 #include <limits>
 
+#include <visp3/core/vpEndian.h>
 #include <visp3/core/vpIoTools.h>
 #include <visp3/vision/vpKeyPoint.h>
 
@@ -85,7 +86,8 @@ vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatur
   : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(), m_detectors(),
     m_extractionTime(0.), m_extractorNames(), m_extractors(), m_filteredMatches(), m_filterType(filterType),
-    m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(), m_matcher(),
+    m_imageFormat(jpgImageFormat), m_knnMatches(), m_learningDatabase(), m_mapOfImageId(), m_mapOfImagePaths(),
+    m_mapOfImages(), m_matcher(),
     m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85),
     m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100),
     m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
@@ -121,7 +123,8 @@ vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extra
   : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(), m_detectors(),
     m_extractionTime(0.), m_extractorNames(), m_extractors(), m_filteredMatches(), m_filterType(filterType),
-    m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(), m_matcher(),
+    m_imageFormat(jpgImageFormat), m_knnMatches(), m_learningDatabase(), m_mapOfImageId(), m_mapOfImagePaths(),
+    m_mapOfImages(), m_matcher(),
     m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85),
     m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100),
     m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
@@ -157,7 +160,8 @@ vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std:
   : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(detectorNames),
     m_detectors(), m_extractionTime(0.), m_extractorNames(extractorNames), m_extractors(), m_filteredMatches(),
-    m_filterType(filterType), m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(),
+    m_filterType(filterType), m_imageFormat(jpgImageFormat), m_knnMatches(), m_learningDatabase(), m_mapOfImageId(),
+    m_mapOfImagePaths(), m_mapOfImages(),
     m_matcher(), m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0),
     m_matchingRatioThreshold(0.85), m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200),
     m_nbRansacMinInlierCount(100), m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(),
@@ -231,6 +235,31 @@ void vpKeyPoint::affineSkew(double tilt, double phi, cv::Mat &img, cv::Mat &mask
   cv::invertAffineTransform(A, Ai);
 }
 
+/*!
+   Append the learning data as a new object at the end of a binary learning
+   file, without reading or rewriting the objects already saved in the file.
+   The file is created if it does not exist. The keypoint class ids and the
+   training image ids are shifted after those already in the file, and the
+   training images are numbered after the images already saved.
+
+   \param filename : Path of the binary learning file.
+   \param saveTrainingImages : If true, save also the training images on disk.
+
+   \warning Only available on little-endian machines.
+   \sa saveLearningData(), loadLearningData()
+ */
+void vpKeyPoint::appendLearningData(const std::string &filename, bool saveTrainingImages)
+{
+#if defined(VISP_LITTLE_ENDIAN)
+  saveLearningDatabase(filename, saveTrainingImages, true);
+#else
+  (void)filename;
+  (void)saveTrainingImages;
+  throw vpException(vpException::notImplementedError,
+                    "vpKeyPoint::appendLearningData() is only available on little-endian machines");
+#endif
+}
+
 /*!
    Build the reference keypoints list.
 
@@ -290,6 +319,7 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const v
   // So as no 3D point list is passed, we dont need this variables
   m_trainPoints.clear();
   m_mapOfImageId.clear();
+  m_mapOfImagePaths.clear();
   m_mapOfImages.clear();
   m_currentImageId = 1;
 
@@ -465,6 +495,7 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const s
   if (!append) {
     m_trainPoints.clear();
     m_mapOfImageId.clear();
+    m_mapOfImagePaths.clear();
     m_mapOfImages.clear();
     m_currentImageId = 0;
     m_trainKeyPoints.clear();
@@ -487,6 +518,7 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const s
   }
 
   // Save the image in a map at a specific image_id
+  m_mapOfImagePaths.erase(m_currentImageId);
   m_mapOfImages[m_currentImageId] = I;
 
   // Append reference lists
@@ -1166,6 +1198,8 @@ void vpKeyPoint::createImageMatching(vpImage<unsigned char> &IRef, vpImage<vpRGB
  */
 void vpKeyPoint::createImageMatching(vpImage<unsigned char> &ICurrent, vpImage<unsigned char> &IMatching)
 {
+  loadTrainingImages();
+
   // Nb images in the training database + the current image we want to detect
   // the object
   unsigned int nbImg = (unsigned int)(m_mapOfImages.size() + 1);
@@ -1221,6 +1255,8 @@ void vpKeyPoint::createImageMatching(vpImage<unsigned char> &ICurrent, vpImage<u
  */
 void vpKeyPoint::createImageMatching(vpImage<vpRGBa> &ICurrent, vpImage<vpRGBa> &IMatching)
 {
+  loadTrainingImages();
+
   // Nb images in the training database + the current image we want to detect
   // the object
   unsigned int nbImg = (unsigned int)(m_mapOfImages.size() + 1);
@@ -1585,6 +1621,8 @@ void vpKeyPoint::displayMatching(const vpImage<unsigned char> &ICurrent, vpImage
                                  const std::vector<vpImagePoint> &ransacInliers, unsigned int crossSize,
                                  unsigned int lineThickness)
 {
+  loadTrainingImages();
+
   if (m_mapOfImages.empty() || m_mapOfImageId.empty()) {
     // No training images so return
     std::cerr << "There is no training image loaded !" << std::endl;
@@ -1706,6 +1744,8 @@ void vpKeyPoint::displayMatching(const vpImage<vpRGBa> &ICurrent, vpImage<vpRGBa
                                  const std::vector<vpImagePoint> &ransacInliers, unsigned int crossSize,
                                  unsigned int lineThickness)
 {
+  loadTrainingImages();
+
   if (m_mapOfImages.empty() || m_mapOfImageId.empty()) {
     // No training images so return
     std::cerr << "There is no training image loaded !" << std::endl;
@@ -2787,6 +2827,8 @@ void vpKeyPoint::insertImageMatching(const vpImage<vpRGBa> &IRef, const vpImage<
  */
 void vpKeyPoint::insertImageMatching(const vpImage<unsigned char> &ICurrent, vpImage<unsigned char> &IMatching)
 {
+  loadTrainingImages();
+
   // Nb images in the training database + the current image we want to detect
   // the object
   int nbImg = (int)(m_mapOfImages.size() + 1);
@@ -2857,6 +2899,8 @@ void vpKeyPoint::insertImageMatching(const vpImage<unsigned char> &ICurrent, vpI
  */
 void vpKeyPoint::insertImageMatching(const vpImage<vpRGBa> &ICurrent, vpImage<vpRGBa> &IMatching)
 {
+  loadTrainingImages();
+
   // Nb images in the training database + the current image we want to detect
   // the object
   int nbImg = (int)(m_mapOfImages.size() + 1);
@@ -3000,6 +3044,18 @@ void vpKeyPoint::loadConfigFile(const std::string &configFile)
 /*!
    Load learning data saved on disk.
 
+   A binary learning file written by saveLearningData() or
+   appendLearningData() is memory-mapped and its descriptors are used in place
+   as train descriptors when there is a single object and nothing to append
+   to. Binary files in the previous per-value format are still supported.
+
+   The training images are not decoded here but on first use, by
+   createImageMatching(), displayMatching(), insertImageMatching() or
+   saveLearningData(). Their files are checked here: a missing or unreadable
+   training image throws a vpException::ioError. An image file that exists
+   but cannot be decoded is reported by the first of these functions that
+   uses it.
+
    \param filename : Path of the learning file.
    \param binaryMode : If true, the learning file is in a binary mode,
    otherwise it is in XML mode.
@@ -3013,6 +3069,7 @@ void vpKeyPoint::loadLearningData(const std::string &filename, bool binaryMode,
     m_trainKeyPoints.clear();
     m_trainPoints.clear();
     m_mapOfImageId.clear();
+    m_mapOfImagePaths.clear();
     m_mapOfImages.clear();
   } else {
     // In append case, find the max index of keypoint class Id
@@ -3037,7 +3094,12 @@ void vpKeyPoint::loadLearningData(const std::string &filename, bool binaryMode,
     parent += "/";
   }
 
-  if (binaryMode) {
+  // Database mapped in memory if the train descriptors are used in place
+  cv::Ptr<vpKeyPointDatabase> learningDatabase;
+
+  if (binaryMode && vpKeyPointDatabase::isDatabase(filename)) {
+    loadLearningDatabase(filename, parent, append, startClassId, startImageId, learningDatabase);
+  } else if (binaryMode) {
     std::ifstream file(filename.c_str(), std::ifstream::binary);
     if (!file.is_open()) {
       throw vpException(vpException::ioError, "Cannot open the file.");
@@ -3072,21 +3134,15 @@ void vpKeyPoint::loadLearningData(const std::string &filename, bool binaryMode,
         path[cpt] = c;
       }
       path[length] = '\0';
-
-      vpImage<unsigned char> I;
-#ifdef VISP_HAVE_MODULE_IO
-      if (vpIoTools::isAbsolutePathname(std::string(path))) {
-        vpImageIo::read(I, path);
-      } else {
-        vpImageIo::read(I, parent + path);
-      }
-
-      // Add the image previously loaded only if VISP_HAVE_MODULE_IO
-      m_mapOfImages[id + startImageId] = I;
-#endif
+      std::string imagePath(path);
 
       // Delete path
       delete[] path;
+
+#ifdef VISP_HAVE_MODULE_IO
+      // The image is read on first use, only if VISP_HAVE_MODULE_IO
+      addTrainingImagePath(id + startImageId, imagePath, parent);
+#endif
     }
 
     // Read if 3D point information are saved or not
@@ -3192,10 +3248,13 @@ void vpKeyPoint::loadLearningData(const std::string &filename, bool binaryMode,
       }
     }
 
+    // A new matrix is allocated since the previous one may be mapped in memory
     if (!append || m_trainDescriptors.empty()) {
-      trainDescriptorsTmp.copyTo(m_trainDescriptors);
+      m_trainDescriptors = trainDescriptorsTmp;
     } else {
-      cv::vconcat(m_trainDescriptors, trainDescriptorsTmp, m_trainDescriptors);
+      cv::Mat trainDescriptors;
+      cv::vconcat(m_trainDescriptors, trainDescriptorsTmp, trainDescriptors);
+      m_trainDescriptors = trainDescriptors;
     }
 
     file.close();
@@ -3228,18 +3287,10 @@ void vpKeyPoint::loadLearningData(const std::string &filename, bool binaryMode,
             // Read image_id
             int id = image_info_node.attribute("image_id").as_int();
 
-            vpImage<unsigned char> I;
 #ifdef VISP_HAVE_MODULE_IO
             std::string path(image_info_node.text().as_string());
-            // Read path to the training images
-            if (vpIoTools::isAbsolutePathname(std::string(path))) {
-              vpImageIo::read(I, path);
-            } else {
-              vpImageIo::read(I, parent + path);
-            }
-
-            // Add the image previously loaded only if VISP_HAVE_MODULE_IO
-            m_mapOfImages[id + startImageId] = I;
+            // The image is read on first use, only if VISP_HAVE_MODULE_IO
+            addTrainingImagePath(id + startImageId, path, parent);
 #endif
           }
         }
@@ -3370,10 +3421,13 @@ void vpKeyPoint::loadLearningData(const std::string &filename, bool binaryMode,
       }
     }
 
+    // A new matrix is allocated since the previous one may be mapped in memory
     if (!append || m_trainDescriptors.empty()) {
-      trainDescriptorsTmp.copyTo(m_trainDescriptors);
+      m_trainDescriptors = trainDescriptorsTmp;
     } else {
-      cv::vconcat(m_trainDescriptors, trainDescriptorsTmp, m_trainDescriptors);
+      cv::Mat trainDescriptors;
+      cv::vconcat(m_trainDescriptors, trainDescriptorsTmp, trainDescriptors);
+      m_trainDescriptors = trainDescriptors;
     }
 #else
     std::cout << "Error: pugixml is not properly built!" << std::endl;
@@ -3388,6 +3442,9 @@ void vpKeyPoint::loadLearningData(const std::string &filename, bool binaryMode,
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
 
+  // The previous database can be unmapped as it is no more used by the matcher
+  m_learningDatabase = learningDatabase;
+
   // Set _reference_computed to true as we load a learning file
   _reference_computed = true;
 
@@ -3395,6 +3452,135 @@ void vpKeyPoint::loadLearningData(const std::string &filename, bool binaryMode,
   m_currentImageId = (int)m_mapOfImages.size();
 }
 
+/*!
+   Load a binary learning database. The descriptors of a single object are
+   used in place in the mapped file, otherwise they are concatenated.
+
+   \param filename : Path of the learning database.
+   \param parent : Directory of the learning database, with a trailing slash.
+   \param append : If true, concatenate the learning data.
+   \param startClassId : Offset added to the keypoint class ids.
+   \param startImageId : Offset added to the training image ids.
+   \param database : Mapped database if the train descriptors are used in
+   place, empty pointer otherwise.
+ */
+void vpKeyPoint::loadLearningDatabase(const std::string &filename, const std::string &parent, bool append,
+                                      int startClassId, int startImageId, cv::Ptr<vpKeyPointDatabase> &database)
+{
+  database = cv::Ptr<vpKeyPointDatabase>(new vpKeyPointDatabase(filename));
+
+  size_t nbKeyPoints = 0;
+  for (unsigned int o = 0; o < database->getNbObjects(); o++) {
+    nbKeyPoints += database->getObject(o).nbKeyPoints;
+  }
+  m_trainKeyPoints.reserve(m_trainKeyPoints.size() + nbKeyPoints);
+
+  const bool appendDescriptors = append && !m_trainDescriptors.empty();
+  std::vector<cv::Mat> listOfDescriptors;
+  if (appendDescriptors) {
+    listOfDescriptors.push_back(m_trainDescriptors);
+  }
+
+  for (unsigned int o = 0; o < database->getNbObjects(); o++) {
+    const vpKeyPointDatabase::Object &object = database->getObject(o);
+
+#ifdef VISP_HAVE_MODULE_IO
+    for (std::map<int, std::string>::const_iterator it = object.images.begin(); it != object.images.end(); ++it) {
+      // The image is read on first use
+      addTrainingImagePath(it->first + startImageId, it->second, parent);
+    }
+#else
+    (void)parent;
+    if (!object.images.empty()) {
+      std::cout << "Warning: The learning file contains image data that will "
+                   "not be loaded as visp_io module "
+                   "is not available !"
+                << std::endl;
+    }
+#endif
+
+    for (unsigned int i = 0; i < object.nbKeyPoints; i++) {
+      const vpKeyPointDatabase::KeyPoint &kpt = object.keyPoints[i];
+      m_trainKeyPoints.push_back(cv::KeyPoint(cv::Point2f(kpt.u, kpt.v), kpt.size, kpt.angle, kpt.response,
+                                              kpt.octave, kpt.class_id + startClassId));
+#ifdef VISP_HAVE_MODULE_IO
+      // No training images if image_id == -1
+      if (kpt.image_id != -1) {
+        m_mapOfImageId[kpt.class_id + startClassId] = kpt.image_id + startImageId;
+      }
+#endif
+    }
+
+    if (object.points != NULL) {
+      m_trainPoints.reserve(m_trainPoints.size() + object.nbKeyPoints);
+      for (unsigned int i = 0; i < object.nbKeyPoints; i++) {
+        m_trainPoints.push_back(
+            cv::Point3f(object.points[3 * i], object.points[3 * i + 1], object.points[3 * i + 2]));
+      }
+    }
+
+    if (object.nbKeyPoints > 0) {
+      if (!listOfDescriptors.empty() && (listOfDescriptors.back().cols != static_cast<int>(object.descriptorCols) ||
+                                         listOfDescriptors.back().type() != object.descriptorType)) {
+        throw vpException(vpException::badValue, "Descriptors of different size or type in %s", filename.c_str());
+      }
+      listOfDescriptors.push_back(cv::Mat(static_cast<int>(object.nbKeyPoints), static_cast<int>(object.descriptorCols),
+                                          object.descriptorType, database->getDescriptors(o)));
+    }
+  }
+
+  if (!appendDescriptors && listOfDescriptors.size() == 1) {
+    // Used in place, the database has to stay mapped
+    m_trainDescriptors = listOfDescriptors.front();
+  } else {
+    cv::Mat trainDescriptors;
+    if (!listOfDescriptors.empty()) {
+      cv::vconcat(listOfDescriptors, trainDescriptors);
+    }
+    m_trainDescriptors = trainDescriptors;
+    database = cv::Ptr<vpKeyPointDatabase>();
+  }
+}
+
+/*!
+   Register a training image of a learning file, decoded on first use by
+   loadTrainingImages(). The file is checked here, so that a bad path is
+   reported when the learning file is loaded.
+
+   \param imageId : Id of the training image.
+   \param path : Path of the training image saved in the learning file.
+   \param parent : Directory of the learning file, with a trailing slash.
+
+   \exception vpException::ioError : If the training image file does not
+   exist or cannot be read.
+ */
+void vpKeyPoint::addTrainingImagePath(int imageId, const std::string &path, const std::string &parent)
+{
+  const std::string imagePath = vpIoTools::isAbsolutePathname(path) ? path : parent + path;
+  if (!vpIoTools::checkFilename(imagePath)) {
+    throw vpException(vpException::ioError, "Cannot read the training image %s", imagePath.c_str());
+  }
+
+  m_mapOfImagePaths[imageId] = imagePath;
+  m_mapOfImages[imageId] = vpImage<unsigned char>();
+}
+
+/*!
+   Read the training images of the learning files that are not read yet.
+
+   \exception vpImageException : If a training image cannot be decoded.
+ */
+void vpKeyPoint::loadTrainingImages()
+{
+#ifdef VISP_HAVE_MODULE_IO
+  for (std::map<int, std::string>::const_iterator it = m_mapOfImagePaths.begin(); it != m_mapOfImagePaths.end();
+       ++it) {
+    vpImageIo::read(m_mapOfImages[it->first], it->second);
+  }
+#endif
+  m_mapOfImagePaths.clear();
+}
+
 /*!
    Match keypoints based on distance between their descriptors.
 
@@ -4246,6 +4432,7 @@ void vpKeyPoint::reset()
   m_imageFormat = jpgImageFormat;
   m_knnMatches.clear();
   m_mapOfImageId.clear();
+  m_mapOfImagePaths.clear();
   m_mapOfImages.clear();
   m_matcher = cv::Ptr<cv::DescriptorMatcher>();
   m_matcherName = "BruteForce-Hamming";
@@ -4270,6 +4457,7 @@ void vpKeyPoint::reset()
   m_ransacReprojectionError = 6.0;
   m_ransacThreshold = 0.01;
   m_trainDescriptors = cv::Mat();
+  m_learningDatabase = cv::Ptr<vpKeyPointDatabase>();
   m_trainKeyPoints.clear();
   m_trainPoints.clear();
   m_trainVpPoints.clear();
@@ -4292,6 +4480,11 @@ void vpKeyPoint::reset()
 /*!
    Save the learning data in a file in XML or binary mode.
 
+   In binary mode, the learning data is saved in a versioned file aligned for
+   memory mapping (see vpKeyPointDatabase) that loadLearningData() uses in
+   place, and to which objects can be added with appendLearningData(). On
+   big-endian machines the previous per-value binary format is written.
+
    \param filename : Path of the save file.
    \param binaryMode : If true, the data are saved in binary mode, otherwise
    in XML mode.
@@ -4299,6 +4492,22 @@ void vpKeyPoint::reset()
  */
 void vpKeyPoint::saveLearningData(const std::string &filename, bool binaryMode, bool saveTrainingImages)
 {
+  if (!m_learningDatabase.empty()) {
+    // The file to overwrite may be the mapped one, detach the train
+    // descriptors before it is truncated
+    m_trainDescriptors = m_trainDescriptors.clone();
+    m_matcher->clear();
+    m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+    m_learningDatabase = cv::Ptr<vpKeyPointDatabase>();
+  }
+
+#if defined(VISP_LITTLE_ENDIAN)
+  if (binaryMode) {
+    saveLearningDatabase(filename, saveTrainingImages, false);
+    return;
+  }
+#endif
+
   std::string parent = vpIoTools::getParent(filename);
   if (!parent.empty()) {
     vpIoTools::makeDirectory(parent);
@@ -4306,51 +4515,7 @@ void vpKeyPoint::saveLearningData(const std::string &filename, bool binaryMode,
 
   std::map<int, std::string> mapOfImgPath;
   if (saveTrainingImages) {
-#ifdef VISP_HAVE_MODULE_IO
-    // Save the training image files in the same directory
-    unsigned int cpt = 0;
-
-    for (std::map<int, vpImage<unsigned char> >::const_iterator it = m_mapOfImages.begin(); it != m_mapOfImages.end();
-         ++it, cpt++) {
-      if (cpt > 999) {
-        throw vpException(vpException::fatalError, "The number of training images to save is too big !");
-      }
-
-      std::stringstream ss;
-      ss << "train_image_" << std::setfill('0') << std::setw(3) << cpt;
-
-      switch (m_imageFormat) {
-      case jpgImageFormat:
-        ss << ".jpg";
-        break;
-
-      case pngImageFormat:
-        ss << ".png";
-        break;
-
-      case ppmImageFormat:
-        ss << ".ppm";
-        break;
-
-      case pgmImageFormat:
-        ss << ".pgm";
-        break;
-
-      default:
-        ss << ".png";
-        break;
-      }
-
-      std::string imgFilename = ss.str();
-      mapOfImgPath[it->first] = imgFilename;
-      vpImageIo::write(it->second, parent + (!parent.empty() ? "/" : "") + imgFilename);
-    }
-#else
-    std::cout << "Warning: in vpKeyPoint::saveLearningData() training images "
-                 "are not saved because "
-                 "visp_io module is not available !"
-              << std::endl;
-#endif
+    mapOfImgPath = writeTrainingImages(parent, 0);
   }
 
   bool have3DInfo = m_trainPoints.size() > 0;
@@ -4623,6 +4788,169 @@ void vpKeyPoint::saveLearningData(const std::string &filename, bool binaryMode,
   }
 }
 
+/*!
+   Save the learning data in a binary learning database.
+
+   \param filename : Path of the learning database.
+   \param saveTrainingImages : If true, save also the training images on disk.
+   \param append : If true, append the learning data as a new object at the
+   end of the file, otherwise overwrite the file.
+ */
+void vpKeyPoint::saveLearningDatabase(const std::string &filename, bool saveTrainingImages, bool append)
+{
+  std::string parent = vpIoTools::getParent(filename);
+  if (!parent.empty()) {
+    vpIoTools::makeDirectory(parent);
+  }
+
+  bool have3DInfo = m_trainPoints.size() > 0;
+  if (have3DInfo && m_trainPoints.size() != m_trainKeyPoints.size()) {
+    throw vpException(vpException::fatalError, "List of keypoints and list of 3D points have different size !");
+  }
+  if (static_cast<size_t>(m_trainDescriptors.rows) != m_trainKeyPoints.size()) {
+    throw vpException(vpException::fatalError, "List of keypoints and descriptors have different size !");
+  }
+
+  // When appending, ids and image files are numbered after those already in
+  // the database
+  unsigned int firstImageIndex = 0;
+  int startClassId = 0;
+  int startImageId = 0;
+  if (append && vpIoTools::checkFilename(filename)) {
+    if (!vpKeyPointDatabase::isDatabase(filename)) {
+      throw vpException(vpException::ioError, "%s is not a binary learning database", filename.c_str());
+    }
+
+    vpKeyPointDatabase database(filename);
+    for (unsigned int o = 0; o < database.getNbObjects(); o++) {
+      const vpKeyPointDatabase::Object &object = database.getObject(o);
+      firstImageIndex += static_cast<unsigned int>(object.images.size());
+      for (std::map<int, std::string>::const_iterator it = object.images.begin(); it != object.images.end(); ++it) {
+        startImageId = std::max(startImageId, it->first + 1);
+      }
+      for (unsigned int i = 0; i < object.nbKeyPoints; i++) {
+        startClassId = std::max(startClassId, object.keyPoints[i].class_id + 1);
+        startImageId = std::max(startImageId, object.keyPoints[i].image_id + 1);
+      }
+    }
+  }
+
+  vpKeyPointDatabase::Object object;
+  if (saveTrainingImages) {
+    std::map<int, std::string> mapOfImgPath = writeTrainingImages(parent, firstImageIndex);
+    for (std::map<int, std::string>::const_iterator it = mapOfImgPath.begin(); it != mapOfImgPath.end(); ++it) {
+      object.images[it->first + startImageId] = it->second;
+    }
+  }
+
+  std::vector<vpKeyPointDatabase::KeyPoint> keyPoints(m_trainKeyPoints.size());
+  for (size_t i = 0; i < m_trainKeyPoints.size(); i++) {
+    const cv::KeyPoint &kpt = m_trainKeyPoints[i];
+    keyPoints[i].u = kpt.pt.x;
+    keyPoints[i].v = kpt.pt.y;
+    keyPoints[i].size = kpt.size;
+    keyPoints[i].angle = kpt.angle;
+    keyPoints[i].response = kpt.response;
+    keyPoints[i].octave = kpt.octave;
+    keyPoints[i].class_id = kpt.class_id + startClassId;
+    keyPoints[i].image_id = -1;
+#ifdef VISP_HAVE_MODULE_IO
+    std::map<int, int>::const_iterator it_findImgId = m_mapOfImageId.find(kpt.class_id);
+    if (saveTrainingImages && it_findImgId != m_mapOfImageId.end()) {
+      keyPoints[i].image_id = it_findImgId->second + startImageId;
+    }
+#endif
+  }
+
+  std::vector<float> points;
+  if (have3DInfo) {
+    points.resize(3 * m_trainPoints.size());
+    for (size_t i = 0; i < m_trainPoints.size(); i++) {
+      points[3 * i] = m_trainPoints[i].x;
+      points[3 * i + 1] = m_trainPoints[i].y;
+      points[3 * i + 2] = m_trainPoints[i].z;
+    }
+  }
+
+  object.nbKeyPoints = static_cast<unsigned int>(keyPoints.size());
+  object.keyPoints = keyPoints.empty() ? NULL : &keyPoints[0];
+  object.points = points.empty() ? NULL : &points[0];
+  object.descriptors = m_trainDescriptors.data;
+  object.descriptorStep = m_trainDescriptors.empty() ? 0 : m_trainDescriptors.step[0];
+  object.descriptorCols = static_cast<unsigned int>(m_trainDescriptors.cols);
+  object.descriptorType = m_trainDescriptors.type();
+  object.descriptorElemSize = static_cast<unsigned int>(m_trainDescriptors.elemSize());
+
+  if (append) {
+    vpKeyPointDatabase::append(filename, object);
+  } else {
+    vpKeyPointDatabase::write(filename, object);
+  }
+}
+
+/*!
+   Save the training images in a directory, with file names numbered from
+   \e firstIndex.
+
+   \param parent : Directory where to save the images.
+   \param firstIndex : Number of the first image file.
+   \return Map of image id and image file name relative to \e parent.
+ */
+std::map<int, std::string> vpKeyPoint::writeTrainingImages(const std::string &parent, unsigned int firstIndex)
+{
+  std::map<int, std::string> mapOfImgPath;
+#ifdef VISP_HAVE_MODULE_IO
+  loadTrainingImages();
+
+  // Save the training image files in the same directory
+  unsigned int cpt = firstIndex;
+
+  for (std::map<int, vpImage<unsigned char> >::const_iterator it = m_mapOfImages.begin(); it != m_mapOfImages.end();
+       ++it, cpt++) {
+    if (cpt > 999) {
+      throw vpException(vpException::fatalError, "The number of training images to save is too big !");
+    }
+
+    std::stringstream ss;
+    ss << "train_image_" << std::setfill('0') << std::setw(3) << cpt;
+
+    switch (m_imageFormat) {
+    case jpgImageFormat:
+      ss << ".jpg";
+      break;
+
+    case pngImageFormat:
+      ss << ".png";
+      break;
+
+    case ppmImageFormat:
+      ss << ".ppm";
+      break;
+
+    case pgmImageFormat:
+      ss << ".pgm";
+      break;
+
+    default:
+      ss << ".png";
+      break;
+    }
+
+    std::string imgFilename = ss.str();
+    mapOfImgPath[it->first] = imgFilename;
+    vpImageIo::write(it->second, parent + (!parent.empty() ? "/" : "") + imgFilename);
+  }
+#else
+  (void)parent;
+  (void)firstIndex;
+  std::cout << "Warning: in vpKeyPoint::saveLearningData() training images "
+               "are not saved because "
+               "visp_io module is not available !"
+            << std::endl;
+#endif
+  return mapOfImgPath;
+}
+
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x030000)
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 // From OpenCV 2.4.11 source code.
@@ -0,0 +1,564 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Memory-mapped binary learning database used by vpKeyPoint.
+ *
+ *****************************************************************************/
+
+#include <visp3/vision/vpKeyPointDatabase.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string.h>
+
+#include <visp3/core/vpEndian.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpIoTools.h>
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__)))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VISP_KEYPOINT_DATABASE_MMAP_POSIX
+#elif defined(_WIN32) && !defined(WINRT)
+#include <windows.h>
+#define VISP_KEYPOINT_DATABASE_MMAP_WIN32
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+/*
+  File layout (version 1), all values in little-endian:
+
+  File header (64 bytes)
+    0   char[8]  magic "VPKPTDB"
+    8   uint32   version
+    12  uint32   alignment of the sections (64)
+
+  Object block (starts on a 64 bytes boundary), header of 128 bytes
+    0   char[4]  magic "OBJ"
+    4   uint32   header size
+    8   uint64   block size, header included, multiple of 64
+    16  uint32   number of training images
+    20  uint32   number of keypoints
+    24  uint32   1 if 3D points are stored, 0 otherwise
+    28  int32    descriptor type (OpenCV type code)
+    32  uint32   number of descriptor values per row
+    36  uint32   size in bytes of a descriptor value
+    40  uint64   offset of the training images section
+    48  uint64   offset of the keypoints section
+    56  uint64   offset of the 3D points section (0 if none)
+    64  uint64   offset of the descriptors section
+  Offsets are relative to the beginning of the block. The images section is a
+  list of (int32 id, uint32 length, char[length] path) records, the other
+  sections are packed arrays starting on a 64 bytes boundary.
+*/
+const char g_fileMagic[8] = {'V', 'P', 'K', 'P', 'T', 'D', 'B', '\0'};
+const char g_objectMagic[4] = {'O', 'B', 'J', '\0'};
+const uint32_t g_version = 1;
+const size_t g_alignment = 64;
+const size_t g_fileHeaderSize = 64;
+const size_t g_objectHeaderSize = 128;
+
+size_t alignSize(size_t size) { return (size + g_alignment - 1) & ~(g_alignment - 1); }
+
+void putUInt32(unsigned char *buf, uint32_t value)
+{
+  for (int i = 0; i < 4; i++) {
+    buf[i] = static_cast<unsigned char>((value >> (8 * i)) & 0xFF);
+  }
+}
+
+void putUInt64(unsigned char *buf, uint64_t value)
+{
+  for (int i = 0; i < 8; i++) {
+    buf[i] = static_cast<unsigned char>((value >> (8 * i)) & 0xFF);
+  }
+}
+
+uint32_t getUInt32(const unsigned char *buf)
+{
+  uint32_t value = 0;
+  for (int i = 3; i >= 0; i--) {
+    value = (value << 8) | buf[i];
+  }
+  return value;
+}
+
+uint64_t getUInt64(const unsigned char *buf)
+{
+  uint64_t value = 0;
+  for (int i = 7; i >= 0; i--) {
+    value = (value << 8) | buf[i];
+  }
+  return value;
+}
+
+void checkEndianness()
+{
+#if !defined(VISP_LITTLE_ENDIAN)
+  throw vpException(vpException::notImplementedError,
+                    "vpKeyPointDatabase is only available on little-endian machines");
+#endif
+}
+
+// Check that [offset, offset + count * elemSize) lies in [0, blockSize)
+bool isInBlock(uint64_t offset, uint64_t count, uint64_t elemSize, uint64_t blockSize)
+{
+  if (offset > blockSize) {
+    return false;
+  }
+  if (elemSize != 0 && count > (blockSize - offset) / elemSize) {
+    return false;
+  }
+  return true;
+}
+
+void writePadding(std::ofstream &file, size_t &position, size_t target)
+{
+  static const char zeros[g_alignment] = {0};
+  while (position < target) {
+    size_t n = std::min(target - position, g_alignment);
+    file.write(zeros, static_cast<std::streamsize>(n));
+    position += n;
+  }
+}
+
+void writeObject(std::ofstream &file, const vpKeyPointDatabase::Object &object)
+{
+  const size_t n = object.nbKeyPoints;
+  const size_t rowSize = static_cast<size_t>(object.descriptorCols) * object.descriptorElemSize;
+  if (n > 0 && (object.keyPoints == NULL || (rowSize > 0 && object.descriptors == NULL))) {
+    throw vpException(vpException::badValue, "Missing keypoints or descriptors to save");
+  }
+  if (object.descriptorCols > 0 && object.descriptorElemSize == 0) {
+    throw vpException(vpException::badValue, "Invalid descriptor element size");
+  }
+  if (n > 1 && object.descriptorStep < rowSize) {
+    throw vpException(vpException::badValue, "Invalid descriptor step");
+  }
+
+  size_t imagesSize = 0;
+  for (std::map<int, std::string>::const_iterator it = object.images.begin(); it != object.images.end(); ++it) {
+    imagesSize += 8 + it->second.size();
+  }
+
+  const size_t imagesOffset = g_objectHeaderSize;
+  const size_t keyPointsOffset = alignSize(imagesOffset + imagesSize);
+  size_t offset = alignSize(keyPointsOffset + n * sizeof(vpKeyPointDatabase::KeyPoint));
+  size_t pointsOffset = 0;
+  if (object.points != NULL) {
+    pointsOffset = offset;
+    offset = alignSize(offset + n * 3 * sizeof(float));
+  }
+  const size_t descriptorsOffset = offset;
+  const size_t blockSize = alignSize(descriptorsOffset + n * rowSize);
+
+  unsigned char header[g_objectHeaderSize];
+  memset(header, 0, sizeof(header));
+  memcpy(header, g_objectMagic, sizeof(g_objectMagic));
+  putUInt32(header + 4, static_cast<uint32_t>(g_objectHeaderSize));
+  putUInt64(header + 8, blockSize);
+  putUInt32(header + 16, static_cast<uint32_t>(object.images.size()));
+  putUInt32(header + 20, object.nbKeyPoints);
+  putUInt32(header + 24, object.points != NULL ? 1 : 0);
+  putUInt32(header + 28, static_cast<uint32_t>(object.descriptorType));
+  putUInt32(header + 32, object.descriptorCols);
+  putUInt32(header + 36, object.descriptorElemSize);
+  putUInt64(header + 40, imagesOffset);
+  putUInt64(header + 48, keyPointsOffset);
+  putUInt64(header + 56, pointsOffset);
+  putUInt64(header + 64, descriptorsOffset);
+  file.write(reinterpret_cast<const char *>(header), sizeof(header));
+  size_t position = sizeof(header);
+
+  for (std::map<int, std::string>::const_iterator it = object.images.begin(); it != object.images.end(); ++it) {
+    unsigned char record[8];
+    putUInt32(record, static_cast<uint32_t>(it->first));
+    putUInt32(record + 4, static_cast<uint32_t>(it->second.size()));
+    file.write(reinterpret_cast<const char *>(record), sizeof(record));
+    file.write(it->second.c_str(), static_cast<std::streamsize>(it->second.size()));
+    position += sizeof(record) + it->second.size();
+  }
+
+  writePadding(file, position, keyPointsOffset);
+  file.write(reinterpret_cast<const char *>(object.keyPoints),
+             static_cast<std::streamsize>(n * sizeof(vpKeyPointDatabase::KeyPoint)));
+  position += n * sizeof(vpKeyPointDatabase::KeyPoint);
+
+  if (object.points != NULL) {
+    writePadding(file, position, pointsOffset);
+    file.write(reinterpret_cast<const char *>(object.points), static_cast<std::streamsize>(n * 3 * sizeof(float)));
+    position += n * 3 * sizeof(float);
+  }
+
+  writePadding(file, position, descriptorsOffset);
+  if (object.descriptorStep == rowSize || n <= 1) {
+    file.write(reinterpret_cast<const char *>(object.descriptors), static_cast<std::streamsize>(n * rowSize));
+  } else {
+    for (size_t i = 0; i < n; i++) {
+      file.write(reinterpret_cast<const char *>(object.descriptors + i * object.descriptorStep),
+                 static_cast<std::streamsize>(rowSize));
+    }
+  }
+  position += n * rowSize;
+  writePadding(file, position, blockSize);
+
+  if (!file) {
+    throw vpException(vpException::ioError, "Cannot write the learning data");
+  }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor of an object block to save, without any data.
+*/
+vpKeyPointDatabase::Object::Object()
+  : images(), nbKeyPoints(0), keyPoints(NULL), points(NULL), descriptors(NULL), descriptorStep(0),
+    descriptorCols(0), descriptorType(0), descriptorElemSize(0)
+{
+}
+
+/*!
+  Default constructor. Use open() to map a database.
+*/
+vpKeyPointDatabase::vpKeyPointDatabase() : m_data(NULL), m_size(0), m_mapped(false), m_objects() {}
+
+/*!
+  Constructor that maps the database \e filename.
+
+  \param filename : Path of the database file.
+  \sa open()
+*/
+vpKeyPointDatabase::vpKeyPointDatabase(const std::string &filename)
+  : m_data(NULL), m_size(0), m_mapped(false), m_objects()
+{
+  open(filename);
+}
+
+/*!
+  Destructor that unmaps the database. Pointers returned by getObject() and
+  getDescriptors() are no more valid.
+*/
+vpKeyPointDatabase::~vpKeyPointDatabase() { close(); }
+
+/*!
+  Append an object block at the end of a database file. The blocks already
+  in the file are neither read nor rewritten. If the file does not exist, it
+  is created.
+
+  \param filename : Path of the database file.
+  \param object : Learning data to save.
+*/
+void vpKeyPointDatabase::append(const std::string &filename, const Object &object)
+{
+  checkEndianness();
+
+  if (!vpIoTools::checkFilename(filename)) {
+    write(filename, object);
+    return;
+  }
+
+  std::ifstream in(filename.c_str(), std::ifstream::binary | std::ifstream::ate);
+  if (!in.is_open()) {
+    throw vpException(vpException::ioError, "Cannot open the file %s", filename.c_str());
+  }
+  const std::streamoff size = static_cast<std::streamoff>(in.tellg());
+  in.close();
+  if (size == 0) {
+    write(filename, object);
+    return;
+  }
+  if (!isDatabase(filename) || size % static_cast<std::streamoff>(g_alignment) != 0) {
+    throw vpException(vpException::ioError, "%s is not a valid keypoint database", filename.c_str());
+  }
+
+  std::ofstream file(filename.c_str(), std::ofstream::binary | std::ofstream::app);
+  if (!file.is_open()) {
+    throw vpException(vpException::ioError, "Cannot open the file %s", filename.c_str());
+  }
+  writeObject(file, object);
+}
+
+/*!
+  Unmap the database if one is opened.
+*/
+void vpKeyPointDatabase::close()
+{
+  if (m_data != NULL) {
+    if (m_mapped) {
+#if defined(VISP_KEYPOINT_DATABASE_MMAP_POSIX)
+      munmap(m_data, m_size);
+#elif defined(VISP_KEYPOINT_DATABASE_MMAP_WIN32)
+      UnmapViewOfFile(m_data);
+#endif
+    } else {
+      delete[] m_data;
+    }
+  }
+  m_data = NULL;
+  m_size = 0;
+  m_mapped = false;
+  m_objects.clear();
+}
+
+/*!
+  Return a writable pointer to the descriptors of an object block, to be used
+  in place as a descriptor matrix. The mapping is private so modifying the
+  descriptors does not change the file.
+
+  \param index : Index of the object block.
+*/
+unsigned char *vpKeyPointDatabase::getDescriptors(unsigned int index)
+{
+  // The descriptors point inside m_data which is writable
+  return const_cast<unsigned char *>(getObject(index).descriptors);
+}
+
+/*!
+  Return the description of an object block. The pointers refer to the mapped
+  file and remain valid until close() is called.
+
+  \param index : Index of the object block.
+*/
+const vpKeyPointDatabase::Object &vpKeyPointDatabase::getObject(unsigned int index) const
+{
+  if (index >= m_objects.size()) {
+    throw vpException(vpException::badValue, "Object index %u out of range [0, %u[", index,
+                      static_cast<unsigned int>(m_objects.size()));
+  }
+  return m_objects[index];
+}
+
+/*!
+  Return true if \e filename is a keypoint database written by write() or
+  append().
+
+  \param filename : Path of the file to check.
+*/
+bool vpKeyPointDatabase::isDatabase(const std::string &filename)
+{
+  std::ifstream file(filename.c_str(), std::ifstream::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  char magic[sizeof(g_fileMagic)];
+  file.read(magic, sizeof(magic));
+  return file.gcount() == static_cast<std::streamsize>(sizeof(magic)) &&
+         memcmp(magic, g_fileMagic, sizeof(magic)) == 0;
+}
+
+/*!
+  Map a database file in memory and index its object blocks. Only the block
+  headers and the image paths are read, the keypoints, 3D points and
+  descriptors are used in place.
+
+  \param filename : Path of the database file.
+
+  \exception vpException::ioError : If the file cannot be mapped, is not a
+  database, has an unsupported version or is truncated.
+*/
+void vpKeyPointDatabase::open(const std::string &filename)
+{
+  checkEndianness();
+  close();
+
+#if defined(VISP_KEYPOINT_DATABASE_MMAP_POSIX)
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw vpException(vpException::ioError, "Cannot open the file %s", filename.c_str());
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    throw vpException(vpException::ioError, "%s is not a valid keypoint database", filename.c_str());
+  }
+  size_t size = static_cast<size_t>(st.st_size);
+  void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (ptr == MAP_FAILED) {
+    throw vpException(vpException::ioError, "Cannot map the file %s", filename.c_str());
+  }
+  m_data = static_cast<unsigned char *>(ptr);
+  m_size = size;
+  m_mapped = true;
+#elif defined(VISP_KEYPOINT_DATABASE_MMAP_WIN32)
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw vpException(vpException::ioError, "Cannot open the file %s", filename.c_str());
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+    CloseHandle(file);
+    throw vpException(vpException::ioError, "%s is not a valid keypoint database", filename.c_str());
+  }
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+  void *ptr = NULL;
+  if (mapping != NULL) {
+    // The view keeps the file mapping alive, both handles can be closed
+    ptr = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(mapping);
+  }
+  CloseHandle(file);
+  if (ptr == NULL) {
+    throw vpException(vpException::ioError, "Cannot map the file %s", filename.c_str());
+  }
+  m_data = static_cast<unsigned char *>(ptr);
+  m_size = static_cast<size_t>(fileSize.QuadPart);
+  m_mapped = true;
+#else
+  std::ifstream file(filename.c_str(), std::ifstream::binary | std::ifstream::ate);
+  if (!file.is_open()) {
+    throw vpException(vpException::ioError, "Cannot open the file %s", filename.c_str());
+  }
+  std::streamoff size = static_cast<std::streamoff>(file.tellg());
+  if (size <= 0) {
+    throw vpException(vpException::ioError, "%s is not a valid keypoint database", filename.c_str());
+  }
+  m_data = new unsigned char[static_cast<size_t>(size)];
+  m_size = static_cast<size_t>(size);
+  m_mapped = false;
+  file.seekg(0, std::ifstream::beg);
+  file.read(reinterpret_cast<char *>(m_data), size);
+  if (!file) {
+    close();
+    throw vpException(vpException::ioError, "Cannot read the file %s", filename.c_str());
+  }
+#endif
+
+  if (m_size < g_fileHeaderSize || memcmp(m_data, g_fileMagic, sizeof(g_fileMagic)) != 0) {
+    close();
+    throw vpException(vpException::ioError, "%s is not a valid keypoint database", filename.c_str());
+  }
+  const uint32_t version = getUInt32(m_data + 8);
+  if (version != g_version) {
+    close();
+    throw vpException(vpException::ioError, "Unsupported keypoint database version %u in %s", version,
+                      filename.c_str());
+  }
+
+  size_t offset = g_fileHeaderSize;
+  while (offset < m_size) {
+    const unsigned char *block = m_data + offset;
+    const uint64_t remaining = m_size - offset;
+    bool valid = remaining >= g_objectHeaderSize && memcmp(block, g_objectMagic, sizeof(g_objectMagic)) == 0;
+
+    uint64_t blockSize = 0;
+    Object object;
+    if (valid) {
+      const uint32_t headerSize = getUInt32(block + 4);
+      blockSize = getUInt64(block + 8);
+      const uint32_t nbImages = getUInt32(block + 16);
+      object.nbKeyPoints = getUInt32(block + 20);
+      const bool has3D = getUInt32(block + 24) != 0;
+      object.descriptorType = static_cast<int>(getUInt32(block + 28));
+      object.descriptorCols = getUInt32(block + 32);
+      object.descriptorElemSize = getUInt32(block + 36);
+      const uint64_t imagesOffset = getUInt64(block + 40);
+      const uint64_t keyPointsOffset = getUInt64(block + 48);
+      const uint64_t pointsOffset = getUInt64(block + 56);
+      const uint64_t descriptorsOffset = getUInt64(block + 64);
+      const uint64_t rowSize = static_cast<uint64_t>(object.descriptorCols) * object.descriptorElemSize;
+      object.descriptorStep = static_cast<size_t>(rowSize);
+
+      valid = headerSize >= g_objectHeaderSize && blockSize >= headerSize && blockSize <= remaining &&
+              blockSize % g_alignment == 0 && keyPointsOffset % g_alignment == 0 &&
+              pointsOffset % g_alignment == 0 && descriptorsOffset % g_alignment == 0 &&
+              imagesOffset >= headerSize && keyPointsOffset >= imagesOffset &&
+              isInBlock(keyPointsOffset, object.nbKeyPoints, sizeof(KeyPoint), blockSize) &&
+              (!has3D || isInBlock(pointsOffset, object.nbKeyPoints, 3 * sizeof(float), blockSize)) &&
+              isInBlock(descriptorsOffset, object.nbKeyPoints, rowSize, blockSize);
+
+      // Image paths are the only data that is parsed
+      uint64_t position = imagesOffset;
+      for (uint32_t i = 0; valid && i < nbImages; i++) {
+        if (keyPointsOffset - position < 8) {
+          valid = false;
+          break;
+        }
+        const int id = static_cast<int>(getUInt32(block + position));
+        const uint32_t length = getUInt32(block + position + 4);
+        position += 8;
+        if (keyPointsOffset - position < length) {
+          valid = false;
+          break;
+        }
+        object.images[id] = std::string(reinterpret_cast<const char *>(block + position), length);
+        position += length;
+      }
+
+      if (valid) {
+        object.keyPoints = reinterpret_cast<const KeyPoint *>(block + keyPointsOffset);
+        object.points = has3D ? reinterpret_cast<const float *>(block + pointsOffset) : NULL;
+        object.descriptors = block + descriptorsOffset;
+      }
+    }
+
+    if (!valid) {
+      close();
+      throw vpException(vpException::ioError, "Keypoint database %s is truncated or corrupted", filename.c_str());
+    }
+
+    m_objects.push_back(object);
+    offset += static_cast<size_t>(blockSize);
+  }
+}
+
+/*!
+  Create a database file that contains a single object block. An existing file
+  is overwritten.
+
+  \param filename : Path of the database file.
+  \param object : Learning data to save.
+  \sa append()
+*/
+void vpKeyPointDatabase::write(const std::string &filename, const Object &object)
+{
+  checkEndianness();
+
+  std::ofstream file(filename.c_str(), std::ofstream::binary | std::ofstream::trunc);
+  if (!file.is_open()) {
+    throw vpException(vpException::ioError, "Cannot create the file %s", filename.c_str());
+  }
+
+  unsigned char header[g_fileHeaderSize];
+  memset(header, 0, sizeof(header));
+  memcpy(header, g_fileMagic, sizeof(g_fileMagic));
+  putUInt32(header + 8, g_version);
+  putUInt32(header + 12, static_cast<uint32_t>(g_alignment));
+  file.write(reinterpret_cast<const char *>(header), sizeof(header));
+
+  writeObject(file, object);
+}
@@ -0,0 +1,645 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Pose computation from contiguous arrays of correspondences.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpPoseBatch.cpp
+  \brief Pose estimation from contiguous arrays of 3D/2D correspondences
+*/
+
+#include <cmath>
+#include <float.h>
+#include <vector>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpPose.h>
+#include <visp3/vision/vpPoseException.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <functional>
+#include <visp3/core/vpThreadPool.h>
+#endif
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Correspondences stored with one contiguous array per coordinate, so that
+// the residuals of two points are computed at once with SSE2
+struct PointArrays {
+  std::vector<double> oX, oY, oZ, x, y;
+
+  void resize(size_t n)
+  {
+    oX.resize(n);
+    oY.resize(n);
+    oZ.resize(n);
+    x.resize(n);
+    y.resize(n);
+  }
+
+  unsigned int size() const { return static_cast<unsigned int>(x.size()); }
+
+  void set(const double *objectPoints, const double *imagePoints, unsigned int nbPoints)
+  {
+    resize(nbPoints);
+    for (unsigned int i = 0; i < nbPoints; i++) {
+      oX[i] = objectPoints[3 * i];
+      oY[i] = objectPoints[3 * i + 1];
+      oZ[i] = objectPoints[3 * i + 2];
+      x[i] = imagePoints[2 * i];
+      y[i] = imagePoints[2 * i + 1];
+    }
+  }
+
+  void gather(const PointArrays &pts, const std::vector<unsigned int> &index)
+  {
+    resize(index.size());
+    for (size_t i = 0; i < index.size(); i++) {
+      oX[i] = pts.oX[index[i]];
+      oY[i] = pts.oY[index[i]];
+      oZ[i] = pts.oZ[index[i]];
+      x[i] = pts.x[index[i]];
+      y[i] = pts.y[index[i]];
+    }
+  }
+};
+
+// Project a point with the pose whose row-major data is M
+inline void project(const double *M, double oX, double oY, double oZ, double &x, double &y, double &invZ)
+{
+  const double cX = M[0] * oX + M[1] * oY + M[2] * oZ + M[3];
+  const double cY = M[4] * oX + M[5] * oY + M[6] * oZ + M[7];
+  const double cZ = M[8] * oX + M[9] * oY + M[10] * oZ + M[11];
+  invZ = 1.0 / cZ;
+  x = cX * invZ;
+  y = cY * invZ;
+}
+
+#if VISP_HAVE_SSE2
+inline void project(const __m128d *M, const __m128d &oX, const __m128d &oY, const __m128d &oZ, __m128d &x,
+                    __m128d &y, __m128d &invZ)
+{
+  const __m128d cX =
+      _mm_add_pd(_mm_add_pd(_mm_mul_pd(M[0], oX), _mm_mul_pd(M[1], oY)), _mm_add_pd(_mm_mul_pd(M[2], oZ), M[3]));
+  const __m128d cY =
+      _mm_add_pd(_mm_add_pd(_mm_mul_pd(M[4], oX), _mm_mul_pd(M[5], oY)), _mm_add_pd(_mm_mul_pd(M[6], oZ), M[7]));
+  const __m128d cZ =
+      _mm_add_pd(_mm_add_pd(_mm_mul_pd(M[8], oX), _mm_mul_pd(M[9], oY)), _mm_add_pd(_mm_mul_pd(M[10], oZ), M[11]));
+  invZ = _mm_div_pd(_mm_set1_pd(1.0), cZ);
+  x = _mm_mul_pd(cX, invZ);
+  y = _mm_mul_pd(cY, invZ);
+}
+#endif
+
+// Number of points whose reprojection error is below the threshold. The
+// indexes of these points are appended to inliers if not NULL.
+unsigned int countInliers(const PointArrays &pts, const vpHomogeneousMatrix &cMo, double threshold,
+                          std::vector<unsigned int> *inliers)
+{
+  const double *M = cMo.data;
+  const double threshold2 = threshold * threshold;
+  const unsigned int n = pts.size();
+  unsigned int nbInliers = 0;
+  unsigned int i = 0;
+
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    __m128d M_sse[12];
+    for (unsigned int k = 0; k < 12; k++) {
+      M_sse[k] = _mm_set1_pd(M[k]);
+    }
+    const __m128d thresh = _mm_set1_pd(threshold2);
+
+    for (; i + 2 <= n; i += 2) {
+      __m128d x, y, invZ;
+      project(M_sse, _mm_loadu_pd(&pts.oX[i]), _mm_loadu_pd(&pts.oY[i]), _mm_loadu_pd(&pts.oZ[i]), x, y, invZ);
+      const __m128d dx = _mm_sub_pd(x, _mm_loadu_pd(&pts.x[i]));
+      const __m128d dy = _mm_sub_pd(y, _mm_loadu_pd(&pts.y[i]));
+      const __m128d err2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+      const int mask = _mm_movemask_pd(_mm_cmplt_pd(err2, thresh));
+
+      if (mask) {
+        nbInliers += static_cast<unsigned int>((mask & 1) + (mask >> 1));
+        if (inliers != NULL) {
+          if (mask & 1) {
+            inliers->push_back(i);
+          }
+          if (mask & 2) {
+            inliers->push_back(i + 1);
+          }
+        }
+      }
+    }
+  }
+#endif
+
+  for (; i < n; i++) {
+    double x, y, invZ;
+    project(M, pts.oX[i], pts.oY[i], pts.oZ[i], x, y, invZ);
+    const double err2 = vpMath::sqr(x - pts.x[i]) + vpMath::sqr(y - pts.y[i]);
+    if (err2 < threshold2) {
+      nbInliers++;
+      if (inliers != NULL) {
+        inliers->push_back(i);
+      }
+    }
+  }
+
+  return nbInliers;
+}
+
+// Add the contribution of a point to the upper triangle of L^T L and to L^T e
+inline void addNormalEquations(double x, double y, double invZ, double ex, double ey, double *LTL, double *LTe)
+{
+  const double Lx[6] = {-invZ, 0, x * invZ, x * y, -(1 + x * x), y};
+  const double Ly[6] = {0, -invZ, y * invZ, 1 + y * y, -x * y, -x};
+  for (unsigned int r = 0; r < 6; r++) {
+    for (unsigned int c = r; c < 6; c++) {
+      LTL[6 * r + c] += Lx[r] * Lx[c] + Ly[r] * Ly[c];
+    }
+    LTe[r] += Lx[r] * ex + Ly[r] * ey;
+  }
+}
+
+// Normal equations of the point-to-point reprojection error at cMo, without
+// building the interaction matrix. Returns the sum of squared residuals.
+double computeNormalEquations(const PointArrays &pts, const vpHomogeneousMatrix &cMo, vpMatrix &LTL, vpColVector &LTe)
+{
+  const double *M = cMo.data;
+  const unsigned int n = pts.size();
+  double H[36], g[6];
+  for (unsigned int k = 0; k < 36; k++) {
+    H[k] = 0;
+  }
+  for (unsigned int k = 0; k < 6; k++) {
+    g[k] = 0;
+  }
+  double residual = 0;
+  unsigned int i = 0;
+
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    __m128d M_sse[12];
+    for (unsigned int k = 0; k < 12; k++) {
+      M_sse[k] = _mm_set1_pd(M[k]);
+    }
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d one = _mm_set1_pd(1.0);
+    __m128d H_sse[36], g_sse[6], res_sse = zero;
+    for (unsigned int k = 0; k < 36; k++) {
+      H_sse[k] = zero;
+    }
+    for (unsigned int k = 0; k < 6; k++) {
+      g_sse[k] = zero;
+    }
+
+    for (; i + 2 <= n; i += 2) {
+      __m128d x, y, invZ;
+      project(M_sse, _mm_loadu_pd(&pts.oX[i]), _mm_loadu_pd(&pts.oY[i]), _mm_loadu_pd(&pts.oZ[i]), x, y, invZ);
+      const __m128d ex = _mm_sub_pd(x, _mm_loadu_pd(&pts.x[i]));
+      const __m128d ey = _mm_sub_pd(y, _mm_loadu_pd(&pts.y[i]));
+      res_sse = _mm_add_pd(res_sse, _mm_add_pd(_mm_mul_pd(ex, ex), _mm_mul_pd(ey, ey)));
+
+      const __m128d xy = _mm_mul_pd(x, y);
+      const __m128d Lx[6] = {_mm_sub_pd(zero, invZ), zero, _mm_mul_pd(x, invZ), xy,
+                             _mm_sub_pd(zero, _mm_add_pd(one, _mm_mul_pd(x, x))), y};
+      const __m128d Ly[6] = {zero, _mm_sub_pd(zero, invZ), _mm_mul_pd(y, invZ),
+                             _mm_add_pd(one, _mm_mul_pd(y, y)), _mm_sub_pd(zero, xy), _mm_sub_pd(zero, x)};
+      for (unsigned int r = 0; r < 6; r++) {
+        for (unsigned int c = r; c < 6; c++) {
+          H_sse[6 * r + c] =
+              _mm_add_pd(H_sse[6 * r + c], _mm_add_pd(_mm_mul_pd(Lx[r], Lx[c]), _mm_mul_pd(Ly[r], Ly[c])));
+        }
+        g_sse[r] = _mm_add_pd(g_sse[r], _mm_add_pd(_mm_mul_pd(Lx[r], ex), _mm_mul_pd(Ly[r], ey)));
+      }
+    }
+
+    double buf[2];
+    for (unsigned int r = 0; r < 6; r++) {
+      for (unsigned int c = r; c < 6; c++) {
+        _mm_storeu_pd(buf, H_sse[6 * r + c]);
+        H[6 * r + c] = buf[0] + buf[1];
+      }
+      _mm_storeu_pd(buf, g_sse[r]);
+      g[r] = buf[0] + buf[1];
+    }
+    _mm_storeu_pd(buf, res_sse);
+    residual = buf[0] + buf[1];
+  }
+#endif
+
+  for (; i < n; i++) {
+    double x, y, invZ;
+    project(M, pts.oX[i], pts.oY[i], pts.oZ[i], x, y, invZ);
+    const double ex = x - pts.x[i];
+    const double ey = y - pts.y[i];
+    residual += ex * ex + ey * ey;
+    addNormalEquations(x, y, invZ, ex, ey, H, g);
+  }
+
+  LTL.resize(6, 6, false, false);
+  LTe.resize(6, false);
+  for (unsigned int r = 0; r < 6; r++) {
+    for (unsigned int c = r; c < 6; c++) {
+      LTL[r][c] = LTL[c][r] = H[6 * r + c];
+    }
+    LTe[r] = g[r];
+  }
+
+  return residual;
+}
+
+// Interaction matrix and error of the points at cMo, only needed for the
+// covariance
+void computeInteractionMatrixAndError(const PointArrays &pts, const vpHomogeneousMatrix &cMo, vpMatrix &L,
+                                      vpColVector &err)
+{
+  const double *M = cMo.data;
+  const unsigned int n = pts.size();
+  L.resize(2 * n, 6, false, false);
+  err.resize(2 * n, false);
+
+  for (unsigned int i = 0; i < n; i++) {
+    double x, y, invZ;
+    project(M, pts.oX[i], pts.oY[i], pts.oZ[i], x, y, invZ);
+    err[2 * i] = x - pts.x[i];
+    err[2 * i + 1] = y - pts.y[i];
+
+    L[2 * i][0] = -invZ;
+    L[2 * i][1] = 0;
+    L[2 * i][2] = x * invZ;
+    L[2 * i][3] = x * y;
+    L[2 * i][4] = -(1 + x * x);
+    L[2 * i][5] = y;
+
+    L[2 * i + 1][0] = 0;
+    L[2 * i + 1][1] = -invZ;
+    L[2 * i + 1][2] = y * invZ;
+    L[2 * i + 1][3] = 1 + y * y;
+    L[2 * i + 1][4] = -x * y;
+    L[2 * i + 1][5] = -x;
+  }
+}
+
+// Same minimization as vpPose::poseVirtualVS(), the pseudo inverse of the
+// stacked interaction matrix being replaced by the one of L^T L
+void virtualVS(const PointArrays &pts, double lambda, int vvsIterMax, double vvsEpsilon, vpHomogeneousMatrix &cMo,
+               vpHomogeneousMatrix &cMoPrev)
+{
+  double residu_1 = 1e8;
+  double r = 1e8 - 1;
+  int iter = 0;
+
+  vpMatrix LTL, LTLp;
+  vpColVector LTe, v;
+  cMoPrev = cMo;
+  while (std::fabs(residu_1 - r) > vvsEpsilon) {
+    residu_1 = r;
+    r = computeNormalEquations(pts, cMo, LTL, LTe);
+
+    LTL.pseudoInverse(LTLp, 1e-16);
+    v = -lambda * LTLp * LTe;
+
+    cMoPrev = cMo;
+    cMo = vpExponentialMap::direct(v).inverse() * cMo;
+
+    if (iter++ > vvsIterMax) {
+      break;
+    }
+  }
+}
+
+bool isDegenerate(const PointArrays &pts, unsigned int index, const unsigned int *picked, unsigned int nbPicked)
+{
+  const double eps = 1e-6;
+  for (unsigned int k = 0; k < nbPicked; k++) {
+    const unsigned int j = picked[k];
+    if ((std::fabs(pts.oX[index] - pts.oX[j]) < eps && std::fabs(pts.oY[index] - pts.oY[j]) < eps &&
+         std::fabs(pts.oZ[index] - pts.oZ[j]) < eps) ||
+        (std::fabs(pts.x[index] - pts.x[j]) < eps && std::fabs(pts.y[index] - pts.y[j]) < eps)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+struct RansacResult {
+  RansacResult() : nbInliers(0), cMo() {}
+
+  unsigned int nbInliers;
+  vpHomogeneousMatrix cMo;
+};
+
+// RANSAC trials of a worker. The minimal sets are solved by a vpPose whose 4
+// points are updated in place, and the consensus is only counted: the list
+// of inliers is built once for the best hypothesis.
+void ransacTrials(const PointArrays &pts, int maxTrials, unsigned int seed, unsigned int nbInlierConsensus,
+                  double threshold, bool checkDegeneratePoints, bool (*func)(const vpHomogeneousMatrix &),
+                  RansacResult &result)
+{
+  const unsigned int size = pts.size();
+  const unsigned int nbMinRandom = 4;
+  vpUniRand uniRand(seed);
+
+  vpPose poseMin;
+  for (unsigned int k = 0; k < nbMinRandom; k++) {
+    poseMin.addPoint(vpPoint());
+  }
+
+  std::vector<bool> usedPt(size, false);
+  std::vector<unsigned int> usedIndex;
+  unsigned int picked[4];
+  vpHomogeneousMatrix cMo_lagrange, cMo_dementhon, cMo_tmp;
+
+  for (int nbTrials = 0; nbTrials < maxTrials && result.nbInliers < nbInlierConsensus; nbTrials++) {
+    unsigned int nbPicked = 0;
+    std::list<vpPoint>::iterator it_pt = poseMin.listP.begin();
+    while (nbPicked < nbMinRandom && usedIndex.size() < size) {
+      unsigned int r_ = static_cast<unsigned int>(uniRand.uniform(0, static_cast<int>(size)));
+      while (usedPt[r_]) {
+        r_ = static_cast<unsigned int>(uniRand.uniform(0, static_cast<int>(size)));
+      }
+      usedPt[r_] = true;
+      usedIndex.push_back(r_);
+
+      if (checkDegeneratePoints && isDegenerate(pts, r_, picked, nbPicked)) {
+        continue;
+      }
+
+      it_pt->setWorldCoordinates(pts.oX[r_], pts.oY[r_], pts.oZ[r_]);
+      it_pt->set_x(pts.x[r_]);
+      it_pt->set_y(pts.y[r_]);
+      ++it_pt;
+      picked[nbPicked++] = r_;
+    }
+
+    for (size_t k = 0; k < usedIndex.size(); k++) {
+      usedPt[usedIndex[k]] = false;
+    }
+    usedIndex.clear();
+
+    if (nbPicked < nbMinRandom) {
+      continue;
+    }
+
+    double r_lagrange = DBL_MAX;
+    double r_dementhon = DBL_MAX;
+    try {
+      poseMin.computePose(vpPose::LAGRANGE, cMo_lagrange);
+      r_lagrange = poseMin.computeResidual(cMo_lagrange);
+    } catch (...) {
+    }
+    try {
+      poseMin.computePose(vpPose::DEMENTHON, cMo_dementhon);
+      r_dementhon = poseMin.computeResidual(cMo_dementhon);
+    } catch (...) {
+    }
+    if (vpMath::isNaN(r_lagrange)) {
+      r_lagrange = DBL_MAX;
+    }
+    if (vpMath::isNaN(r_dementhon)) {
+      r_dementhon = DBL_MAX;
+    }
+    if (r_lagrange == DBL_MAX && r_dementhon == DBL_MAX) {
+      continue;
+    }
+
+    double r;
+    if (r_lagrange < r_dementhon) {
+      r = r_lagrange;
+      cMo_tmp = cMo_lagrange;
+    } else {
+      r = r_dementhon;
+      cMo_tmp = cMo_dementhon;
+    }
+    // Same criterion as vpPose::poseRansac()
+    r = sqrt(r) / (double)nbMinRandom;
+
+    if ((func != NULL && !func(cMo_tmp)) || r >= threshold) {
+      continue;
+    }
+
+    unsigned int nbInliers = countInliers(pts, cMo_tmp, threshold, NULL);
+    if (nbInliers > result.nbInliers) {
+      result.nbInliers = nbInliers;
+      result.cMo = cMo_tmp;
+    }
+  }
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Compute the sum of squared residuals expressed in meter^2 of 3D/2D
+  correspondences stored in contiguous arrays.
+
+  \param objectPoints : Array of 3 * \e nbPoints values with the
+  coordinates (oX, oY, oZ) of the points in the object frame.
+  \param imagePoints : Array of 2 * \e nbPoints values with the normalized
+  coordinates (x, y) of the points in the image plane.
+  \param nbPoints : Number of correspondences.
+  \param cMo : Pose to be tested.
+
+  \return The sum of squared residuals in meter^2.
+
+  \sa computeResidual(const vpHomogeneousMatrix &) const
+*/
+double vpPose::computeResidual(const double *objectPoints, const double *imagePoints, unsigned int nbPoints,
+                               const vpHomogeneousMatrix &cMo)
+{
+  const double *M = cMo.data;
+  double squared_error = 0;
+  for (unsigned int i = 0; i < nbPoints; i++) {
+    double x, y, invZ;
+    project(M, objectPoints[3 * i], objectPoints[3 * i + 1], objectPoints[3 * i + 2], x, y, invZ);
+    squared_error += vpMath::sqr(x - imagePoints[2 * i]) + vpMath::sqr(y - imagePoints[2 * i + 1]);
+  }
+  return squared_error;
+}
+
+/*!
+  Compute the pose using virtual visual servoing approach from 3D/2D
+  correspondences stored in contiguous arrays. The points added with
+  addPoint() are not used.
+
+  The minimization is the one of poseVirtualVS(vpHomogeneousMatrix &), but
+  the residuals and the normal equations \f${\bf L}^\top {\bf L}\f$ and
+  \f${\bf L}^\top {\bf e}\f$ are accumulated over all the points in a single
+  pass, two points at a time with SSE2. Neither vpPoint objects nor the
+  interaction matrix are created, except for the covariance matrix if
+  setCovarianceComputation() was enabled.
+
+  \param objectPoints : Array of 3 * \e nbPoints values with the
+  coordinates (oX, oY, oZ) of the points in the object frame.
+  \param imagePoints : Array of 2 * \e nbPoints values with the normalized
+  coordinates (x, y) of the points in the image plane.
+  \param nbPoints : Number of correspondences.
+  \param cMo : On input the initial pose, on output the estimated pose.
+*/
+void vpPose::poseVirtualVS(const double *objectPoints, const double *imagePoints, unsigned int nbPoints,
+                           vpHomogeneousMatrix &cMo)
+{
+  PointArrays pts;
+  pts.set(objectPoints, imagePoints, nbPoints);
+
+  vpHomogeneousMatrix cMoPrev;
+  virtualVS(pts, lambda, vvsIterMax, vvsEpsilon, cMo, cMoPrev);
+
+  if (computeCovariance) {
+    vpMatrix L;
+    vpColVector err;
+    computeInteractionMatrixAndError(pts, cMoPrev, L, err);
+    covarianceMatrix = vpMatrix::computeCovarianceMatrixVVS(cMoPrev, err, L);
+  }
+}
+
+/*!
+  Compute the pose using the Ransac approach from 3D/2D correspondences
+  stored in contiguous arrays. The points added with addPoint() are not used.
+
+  The trials follow poseRansac(vpHomogeneousMatrix &, bool (*)(const
+  vpHomogeneousMatrix &)): a pose is computed from 4 random points with the
+  Lagrange and Dementhon approaches, and the consensus set is made of the
+  points whose reprojection error is below the RANSAC threshold. The
+  differences are:
+  - the consensus test of an hypothesis only counts the inliers, two points
+  at a time with SSE2, without copying any point;
+  - if the parallel version is enabled with setUseParallelRansac(), the
+  trials are split into tasks that share the same arrays;
+  - the best hypothesis is directly refined by virtual visual servoing over
+  its consensus set;
+  - the PREFILTER_DEGENERATE_POINTS and CHECK_DEGENERATE_POINTS flags reject
+  degenerate points when picking the minimal sets only.
+
+  After the call, getRansacInlierIndex() returns the indexes of the inliers
+  in the input arrays. getRansacInliers() returns an empty vector since no
+  vpPoint is created.
+
+  \param objectPoints : Array of 3 * \e nbPoints values with the
+  coordinates (oX, oY, oZ) of the points in the object frame.
+  \param imagePoints : Array of 2 * \e nbPoints values with the normalized
+  coordinates (x, y) of the points in the image plane.
+  \param nbPoints : Number of correspondences.
+  \param cMo : Computed pose.
+  \param func : Pointer to a function that takes in parameter a
+  vpHomogeneousMatrix and returns true if the pose check is OK or false
+  otherwise.
+  \return True if we found at least 4 points with a reprojection
+  error below ransacThreshold.
+*/
+bool vpPose::poseRansac(const double *objectPoints, const double *imagePoints, unsigned int nbPoints,
+                        vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneousMatrix &))
+{
+  ransacInliers.clear();
+  ransacInlierIndex.clear();
+
+  if (nbPoints < 4) {
+    throw(vpPoseException(vpPoseException::notEnoughPointError, "Not enough point (%d) to compute the pose by ransac",
+                          nbPoints));
+  }
+
+  PointArrays pts;
+  pts.set(objectPoints, imagePoints, nbPoints);
+  const bool checkDegeneratePoints = ransacFlag != NO_FILTER;
+
+  unsigned int nbWorkers = 1;
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  if (useParallelRansac) {
+    nbWorkers = nbParallelRansacThreads <= 0 ? vpThreadPool::getGlobalInstance().getNbThreads()
+                                             : static_cast<unsigned int>(nbParallelRansacThreads);
+  }
+#endif
+
+  std::vector<RansacResult> results(nbWorkers);
+  if (nbWorkers > 1) {
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+    const int splitTrials = ransacMaxTrials / static_cast<int>(nbWorkers);
+    std::vector<std::function<void()> > tasks;
+    for (unsigned int i = 0; i < nbWorkers; i++) {
+      const int maxTrials = i < nbWorkers - 1 ? splitTrials : ransacMaxTrials - splitTrials * (nbWorkers - 1);
+      tasks.push_back([&, i, maxTrials]() {
+        ransacTrials(pts, maxTrials, i, ransacNbInlierConsensus, ransacThreshold, checkDegeneratePoints, func,
+                     results[i]);
+      });
+    }
+    vpThreadPool::getGlobalInstance().run(tasks);
+#endif
+  } else {
+    ransacTrials(pts, ransacMaxTrials, 0, ransacNbInlierConsensus, ransacThreshold, checkDegeneratePoints, func,
+                 results[0]);
+  }
+
+  // The first worker wins in case of a tie, the result does not depend on
+  // the threads that executed the tasks
+  size_t best = 0;
+  for (size_t i = 1; i < results.size(); i++) {
+    if (results[i].nbInliers > results[best].nbInliers) {
+      best = i;
+    }
+  }
+
+  if (results[best].nbInliers < 4) {
+    return false;
+  }
+
+  countInliers(pts, results[best].cMo, ransacThreshold, &ransacInlierIndex);
+
+  PointArrays inliers;
+  inliers.gather(pts, ransacInlierIndex);
+  cMo = results[best].cMo;
+  vpHomogeneousMatrix cMoPrev;
+  virtualVS(inliers, lambda, vvsIterMax, vvsEpsilon, cMo, cMoPrev);
+
+  if (computeCovariance) {
+    vpMatrix L;
+    vpColVector err;
+    computeInteractionMatrixAndError(inliers, cMoPrev, L, err);
+    covarianceMatrix = vpMatrix::computeCovarianceMatrixVVS(cMoPrev, err, L);
+  }
+
+  // As in poseRansac(), the refined pose may not respect the pose criterion
+  if (func != NULL && !func(cMo)) {
+    return false;
+  }
+
+  return true;
+}
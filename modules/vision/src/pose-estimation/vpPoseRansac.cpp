@@ -57,7 +57,7 @@
 #include <visp3/vision/vpPoseException.h>
 
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-#include <thread>
+#include <visp3/core/vpThreadPool.h>
 #endif
 
 #define eps 1e-6
@@ -400,8 +400,8 @@ bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneo
   if (executeParallelVersion) {
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
     if (nbParallelRansacThreads <= 0) {
-      // Get number of CPU threads
-      nbThreads = std::thread::hardware_concurrency();
+      // Use all the threads of the pool shared by the library
+      nbThreads = vpThreadPool::getGlobalInstance().getNbThreads();
       if (nbThreads <= 1) {
         nbThreads = 1;
         executeParallelVersion = false;
@@ -416,7 +416,6 @@ bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneo
 
   if (executeParallelVersion) {
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-    std::vector<std::thread> threadpool;
     std::vector<RansacFunctor> ransacWorkers;
 
     int splitTrials = ransacMaxTrials / nbThreads;
@@ -432,13 +431,13 @@ bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneo
       }
     }
 
-    for (auto& worker : ransacWorkers) {
-      threadpool.emplace_back(&RansacFunctor::operator(), &worker);
-    }
-
-    for (auto& th : threadpool) {
-      th.join();
+    // The trials are split between the workers, whose results do not depend
+    // on the threads executing them
+    std::vector<std::function<void()> > tasks;
+    for (auto &worker : ransacWorkers) {
+      tasks.push_back([&worker]() { worker(); });
     }
+    vpThreadPool::getGlobalInstance().run(tasks);
 
     bool successRansac = false;
     size_t best_consensus_size = 0;
@@ -0,0 +1,542 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the memory-mapped keypoint learning database.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testKeyPointDatabase.cpp
+
+  \brief Test writing, appending and mapping a keypoint learning database,
+  and compare the loading time with the legacy per-value binary format. With
+  OpenCV, check that the learning data loaded by vpKeyPoint matches like the
+  data it was built from.
+*/
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpEndian.h>
+
+#if defined(VISP_HAVE_CATCH2) && defined(VISP_LITTLE_ENDIAN)
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string.h>
+#include <vector>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpKeyPoint.h>
+#include <visp3/vision/vpKeyPointDatabase.h>
+
+namespace
+{
+
+bool runBenchmark = false;
+
+std::string getOutputPath()
+{
+  std::string username;
+  vpIoTools::getUserName(username);
+#if defined(_WIN32)
+  std::string opath = vpIoTools::createFilePath("C:/temp", username);
+#else
+  std::string opath = vpIoTools::createFilePath("/tmp", username);
+#endif
+  vpIoTools::makeDirectory(opath);
+  return opath;
+}
+
+// Learning data of one object with ORB-like 32 bytes descriptors
+struct LearningData {
+  std::vector<vpKeyPointDatabase::KeyPoint> keyPoints;
+  std::vector<float> points;
+  std::vector<unsigned char> descriptors;
+  std::map<int, std::string> images;
+
+  vpKeyPointDatabase::Object object(bool with3D) const
+  {
+    vpKeyPointDatabase::Object obj;
+    obj.images = images;
+    obj.nbKeyPoints = static_cast<unsigned int>(keyPoints.size());
+    obj.keyPoints = keyPoints.empty() ? NULL : &keyPoints[0];
+    obj.points = (with3D && !points.empty()) ? &points[0] : NULL;
+    obj.descriptors = descriptors.empty() ? NULL : &descriptors[0];
+    obj.descriptorCols = 32;
+    obj.descriptorStep = 32;
+    obj.descriptorType = 0; // CV_8U
+    obj.descriptorElemSize = 1;
+    return obj;
+  }
+};
+
+LearningData generateLearningData(unsigned int nbKeyPoints, unsigned int nbImages, long seed)
+{
+  vpUniRand rng(seed);
+  LearningData data;
+  data.keyPoints.resize(nbKeyPoints);
+  data.points.resize(3 * nbKeyPoints);
+  data.descriptors.resize(32 * nbKeyPoints);
+  for (unsigned int i = 0; i < nbImages; i++) {
+    std::stringstream ss;
+    ss << "train_image_" << seed << "_" << i << ".png";
+    data.images[static_cast<int>(i)] = ss.str();
+  }
+
+  for (unsigned int i = 0; i < nbKeyPoints; i++) {
+    vpKeyPointDatabase::KeyPoint &kpt = data.keyPoints[i];
+    kpt.u = static_cast<float>(rng.uniform(0.0, 640.0));
+    kpt.v = static_cast<float>(rng.uniform(0.0, 480.0));
+    kpt.size = 31.0f;
+    kpt.angle = static_cast<float>(rng.uniform(0.0, 360.0));
+    kpt.response = static_cast<float>(rng.uniform(0.0, 1.0));
+    kpt.octave = static_cast<int>(i % 8);
+    kpt.class_id = static_cast<int>(i);
+    kpt.image_id = nbImages > 0 ? static_cast<int>(i % nbImages) : -1;
+    for (unsigned int j = 0; j < 3; j++) {
+      data.points[3 * i + j] = static_cast<float>(rng.uniform(-0.5, 0.5));
+    }
+    for (unsigned int j = 0; j < 32; j++) {
+      data.descriptors[32 * i + j] = static_cast<unsigned char>(rng.next() & 0xFF);
+    }
+  }
+  return data;
+}
+
+void checkObject(const vpKeyPointDatabase::Object &obj, const LearningData &data, bool with3D)
+{
+  REQUIRE(obj.nbKeyPoints == data.keyPoints.size());
+  CHECK(obj.images == data.images);
+  CHECK(obj.descriptorCols == 32);
+  CHECK(obj.descriptorElemSize == 1);
+  CHECK(obj.descriptorStep == 32);
+
+  // Sections are aligned on 64 bytes boundaries
+  CHECK(reinterpret_cast<size_t>(obj.keyPoints) % 64 == 0);
+  CHECK(reinterpret_cast<size_t>(obj.descriptors) % 64 == 0);
+
+  if (!data.keyPoints.empty()) {
+    CHECK(memcmp(obj.keyPoints, &data.keyPoints[0], data.keyPoints.size() * sizeof(vpKeyPointDatabase::KeyPoint)) ==
+          0);
+    CHECK(memcmp(obj.descriptors, &data.descriptors[0], data.descriptors.size()) == 0);
+  }
+  if (with3D) {
+    REQUIRE(obj.points != NULL);
+    CHECK(reinterpret_cast<size_t>(obj.points) % 64 == 0);
+    CHECK(memcmp(obj.points, &data.points[0], data.points.size() * sizeof(float)) == 0);
+  } else {
+    CHECK(obj.points == NULL);
+  }
+}
+
+// Legacy binary format of vpKeyPoint, one value at a time
+void writeLegacy(const std::string &filename, const LearningData &data)
+{
+  std::ofstream file(filename.c_str(), std::ofstream::binary);
+  int nbImgs = 0, have3D = 1, nRows = static_cast<int>(data.keyPoints.size()), nCols = 32, type = 0;
+  vpIoTools::writeBinaryValueLE(file, nbImgs);
+  vpIoTools::writeBinaryValueLE(file, have3D);
+  vpIoTools::writeBinaryValueLE(file, nRows);
+  vpIoTools::writeBinaryValueLE(file, nCols);
+  vpIoTools::writeBinaryValueLE(file, type);
+  for (int i = 0; i < nRows; i++) {
+    const vpKeyPointDatabase::KeyPoint &kpt = data.keyPoints[static_cast<size_t>(i)];
+    vpIoTools::writeBinaryValueLE(file, kpt.u);
+    vpIoTools::writeBinaryValueLE(file, kpt.v);
+    vpIoTools::writeBinaryValueLE(file, kpt.size);
+    vpIoTools::writeBinaryValueLE(file, kpt.angle);
+    vpIoTools::writeBinaryValueLE(file, kpt.response);
+    vpIoTools::writeBinaryValueLE(file, kpt.octave);
+    vpIoTools::writeBinaryValueLE(file, kpt.class_id);
+    vpIoTools::writeBinaryValueLE(file, kpt.image_id);
+    for (int j = 0; j < 3; j++) {
+      vpIoTools::writeBinaryValueLE(file, data.points[static_cast<size_t>(3 * i + j)]);
+    }
+    file.write(reinterpret_cast<const char *>(&data.descriptors[static_cast<size_t>(32 * i)]), 32);
+  }
+}
+
+size_t readLegacy(const std::string &filename, LearningData &data)
+{
+  std::ifstream file(filename.c_str(), std::ifstream::binary);
+  int nbImgs = 0, have3D = 0, nRows = 0, nCols = 0, type = 0;
+  vpIoTools::readBinaryValueLE(file, nbImgs);
+  vpIoTools::readBinaryValueLE(file, have3D);
+  vpIoTools::readBinaryValueLE(file, nRows);
+  vpIoTools::readBinaryValueLE(file, nCols);
+  vpIoTools::readBinaryValueLE(file, type);
+  data.keyPoints.resize(static_cast<size_t>(nRows));
+  data.points.resize(static_cast<size_t>(3 * nRows));
+  data.descriptors.resize(static_cast<size_t>(nRows * nCols));
+  for (int i = 0; i < nRows; i++) {
+    vpKeyPointDatabase::KeyPoint &kpt = data.keyPoints[static_cast<size_t>(i)];
+    vpIoTools::readBinaryValueLE(file, kpt.u);
+    vpIoTools::readBinaryValueLE(file, kpt.v);
+    vpIoTools::readBinaryValueLE(file, kpt.size);
+    vpIoTools::readBinaryValueLE(file, kpt.angle);
+    vpIoTools::readBinaryValueLE(file, kpt.response);
+    vpIoTools::readBinaryValueLE(file, kpt.octave);
+    vpIoTools::readBinaryValueLE(file, kpt.class_id);
+    vpIoTools::readBinaryValueLE(file, kpt.image_id);
+    for (int j = 0; j < 3; j++) {
+      vpIoTools::readBinaryValueLE(file, data.points[static_cast<size_t>(3 * i + j)]);
+    }
+    for (int j = 0; j < nCols; j++) {
+      unsigned char value;
+      file.read(reinterpret_cast<char *>(&value), sizeof(value));
+      data.descriptors[static_cast<size_t>(nCols * i + j)] = value;
+    }
+  }
+  return data.keyPoints.size();
+}
+
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020301) && defined(VISP_HAVE_MODULE_IO)
+// Random rectangles of random grey levels, with enough corners for ORB
+vpImage<unsigned char> generateImage(long seed)
+{
+  vpUniRand rng(seed);
+  vpImage<unsigned char> I(240, 320, 128);
+  for (int k = 0; k < 80; k++) {
+    const unsigned int top = static_cast<unsigned int>(rng.uniform(0, 230));
+    const unsigned int left = static_cast<unsigned int>(rng.uniform(0, 310));
+    const unsigned int bottom = (std::min)(top + static_cast<unsigned int>(rng.uniform(8, 40)), I.getHeight());
+    const unsigned int right = (std::min)(left + static_cast<unsigned int>(rng.uniform(8, 40)), I.getWidth());
+    const unsigned char value = static_cast<unsigned char>(rng.uniform(0, 256));
+    for (unsigned int i = top; i < bottom; i++) {
+      for (unsigned int j = left; j < right; j++) {
+        I[i][j] = value;
+      }
+    }
+  }
+  return I;
+}
+
+void checkSameTrainKeyPoints(const vpKeyPoint &keypoints, const vpKeyPoint &ref)
+{
+  std::vector<cv::KeyPoint> trainKeyPoints, refTrainKeyPoints;
+  keypoints.getTrainKeyPoints(trainKeyPoints);
+  ref.getTrainKeyPoints(refTrainKeyPoints);
+  REQUIRE(trainKeyPoints.size() == refTrainKeyPoints.size());
+  for (size_t i = 0; i < refTrainKeyPoints.size(); i++) {
+    CHECK(trainKeyPoints[i].pt.x == Approx(refTrainKeyPoints[i].pt.x));
+    CHECK(trainKeyPoints[i].pt.y == Approx(refTrainKeyPoints[i].pt.y));
+    CHECK(trainKeyPoints[i].octave == refTrainKeyPoints[i].octave);
+  }
+}
+
+void checkSameMatches(const std::vector<cv::DMatch> &matches, const std::vector<cv::DMatch> &ref)
+{
+  REQUIRE(matches.size() == ref.size());
+  for (size_t i = 0; i < ref.size(); i++) {
+    CHECK(matches[i].queryIdx == ref[i].queryIdx);
+    CHECK(matches[i].trainIdx == ref[i].trainIdx);
+    CHECK(matches[i].distance == Approx(ref[i].distance));
+  }
+}
+
+// Side by side training images and current image, which requires the training images to be read
+vpImage<unsigned char> getImageMatching(vpKeyPoint &keypoints, const vpImage<unsigned char> &I)
+{
+  vpImage<unsigned char> ICurrent = I, IMatching;
+  keypoints.createImageMatching(ICurrent, IMatching);
+  keypoints.insertImageMatching(I, IMatching);
+  return IMatching;
+}
+#endif
+} // namespace
+
+TEST_CASE("Write and map a database", "[vpKeyPointDatabase]")
+{
+  const std::string filename = vpIoTools::createFilePath(getOutputPath(), "testKeyPointDatabase.bin");
+  const LearningData data = generateLearningData(1000, 3, 1);
+
+  vpKeyPointDatabase::write(filename, data.object(true));
+  CHECK(vpKeyPointDatabase::isDatabase(filename));
+
+  vpKeyPointDatabase db(filename);
+  REQUIRE(db.isOpen());
+  REQUIRE(db.getNbObjects() == 1);
+  checkObject(db.getObject(0), data, true);
+
+  // The mapping is private, modifying the descriptors does not change the file
+  db.getDescriptors(0)[0] = static_cast<unsigned char>(~data.descriptors[0]);
+  vpKeyPointDatabase db2(filename);
+  CHECK(db2.getDescriptors(0)[0] == data.descriptors[0]);
+
+  db.close();
+  CHECK(!db.isOpen());
+  CHECK_THROWS_AS(db.getObject(0), vpException);
+  vpIoTools::remove(filename);
+}
+
+TEST_CASE("Append objects to a database", "[vpKeyPointDatabase]")
+{
+  const std::string filename = vpIoTools::createFilePath(getOutputPath(), "testKeyPointDatabase.bin");
+  if (vpIoTools::checkFilename(filename)) {
+    vpIoTools::remove(filename);
+  }
+
+  std::vector<LearningData> data;
+  data.push_back(generateLearningData(500, 2, 1));
+  data.push_back(generateLearningData(0, 0, 2));
+  data.push_back(generateLearningData(777, 1, 3));
+
+  // Append creates the file
+  vpKeyPointDatabase::append(filename, data[0].object(true));
+  std::ifstream file(filename.c_str(), std::ifstream::binary | std::ifstream::ate);
+  const std::streamoff sizeAfterFirst = static_cast<std::streamoff>(file.tellg());
+  file.close();
+  for (size_t i = 1; i < data.size(); i++) {
+    vpKeyPointDatabase::append(filename, data[i].object(i == 2));
+  }
+
+  // The first block is left untouched
+  std::vector<char> firstBlock(static_cast<size_t>(sizeAfterFirst));
+  {
+    vpKeyPointDatabase::write(filename + ".ref", data[0].object(true));
+    std::ifstream ref((filename + ".ref").c_str(), std::ifstream::binary);
+    std::ifstream cur(filename.c_str(), std::ifstream::binary);
+    std::vector<char> refBlock(firstBlock.size());
+    ref.read(&refBlock[0], static_cast<std::streamsize>(refBlock.size()));
+    cur.read(&firstBlock[0], static_cast<std::streamsize>(firstBlock.size()));
+    CHECK(refBlock == firstBlock);
+    vpIoTools::remove(filename + ".ref");
+  }
+
+  vpKeyPointDatabase db(filename);
+  REQUIRE(db.getNbObjects() == data.size());
+  for (unsigned int i = 0; i < db.getNbObjects(); i++) {
+    checkObject(db.getObject(i), data[i], i != 1);
+  }
+  vpIoTools::remove(filename);
+}
+
+TEST_CASE("Detect invalid databases", "[vpKeyPointDatabase]")
+{
+  const std::string filename = vpIoTools::createFilePath(getOutputPath(), "testKeyPointDatabase.bin");
+  const LearningData data = generateLearningData(200, 1, 4);
+  vpKeyPointDatabase::write(filename, data.object(true));
+
+  std::vector<char> content;
+  {
+    std::ifstream file(filename.c_str(), std::ifstream::binary | std::ifstream::ate);
+    content.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0, std::ifstream::beg);
+    file.read(&content[0], static_cast<std::streamsize>(content.size()));
+  }
+
+  SECTION("Truncated file")
+  {
+    std::ofstream file(filename.c_str(), std::ofstream::binary | std::ofstream::trunc);
+    file.write(&content[0], static_cast<std::streamsize>(content.size() - 100));
+    file.close();
+
+    vpKeyPointDatabase db;
+    CHECK_THROWS_AS(db.open(filename), vpException);
+    CHECK(!db.isOpen());
+    CHECK_THROWS_AS(vpKeyPointDatabase::append(filename, data.object(true)), vpException);
+  }
+
+  SECTION("Unsupported version")
+  {
+    content[8] = 2;
+    std::ofstream file(filename.c_str(), std::ofstream::binary | std::ofstream::trunc);
+    file.write(&content[0], static_cast<std::streamsize>(content.size()));
+    file.close();
+
+    vpKeyPointDatabase db;
+    CHECK_THROWS_AS(db.open(filename), vpException);
+  }
+
+  SECTION("Legacy file")
+  {
+    writeLegacy(filename, data);
+    CHECK(!vpKeyPointDatabase::isDatabase(filename));
+    vpKeyPointDatabase db;
+    CHECK_THROWS_AS(db.open(filename), vpException);
+  }
+
+  vpIoTools::remove(filename);
+}
+
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020301) && defined(VISP_HAVE_MODULE_IO)
+TEST_CASE("Save, load and append vpKeyPoint learning data", "[vpKeyPoint]")
+{
+  const std::string opath = vpIoTools::createFilePath(getOutputPath(), "testKeyPointDatabase");
+  if (vpIoTools::checkDirectory(opath)) {
+    vpIoTools::remove(opath);
+  }
+  const vpImage<unsigned char> I = generateImage(6);
+
+  // Learning data built from the image, the training image is in memory
+  vpKeyPoint reference("ORB", "ORB", "BruteForce-Hamming");
+  reference.setImageFormat(vpKeyPoint::pngImageFormat);
+  REQUIRE(reference.buildReference(I) > 0);
+  reference.matchPoint(I);
+  const std::vector<cv::DMatch> refMatches = reference.getMatches();
+  REQUIRE(!refMatches.empty());
+  const vpImage<unsigned char> refMatching = getImageMatching(reference, I);
+
+  std::vector<bool> binaryModes(1, true);
+#if defined(VISP_HAVE_PUGIXML)
+  binaryModes.push_back(false);
+#endif
+
+  SECTION("Save and load")
+  {
+    for (size_t k = 0; k < binaryModes.size(); k++) {
+      const std::string filename =
+          vpIoTools::createFilePath(opath, binaryModes[k] ? "binary/learning.bin" : "xml/learning.xml");
+      reference.saveLearningData(filename, binaryModes[k], true);
+
+      vpKeyPoint keypoints("ORB", "ORB", "BruteForce-Hamming");
+      keypoints.loadLearningData(filename, binaryModes[k]);
+      checkSameTrainKeyPoints(keypoints, reference);
+      keypoints.matchPoint(I);
+      checkSameMatches(keypoints.getMatches(), refMatches);
+      bool sameImage = (getImageMatching(keypoints, I) == refMatching);
+      CHECK(sameImage);
+    }
+  }
+
+  SECTION("Append")
+  {
+    // The training data are duplicated, keep the first nearest neighbor
+    const std::string filename = vpIoTools::createFilePath(opath, "append/learning.bin");
+    reference.appendLearningData(filename, true);
+    reference.appendLearningData(filename, true);
+    vpKeyPoint appended("ORB", "ORB", "BruteForce-Hamming", vpKeyPoint::noFilterMatching);
+    appended.loadLearningData(filename, true);
+
+    // Same data concatenated when loaded
+    const std::string singleFilename = vpIoTools::createFilePath(opath, "single/learning.bin");
+    reference.saveLearningData(singleFilename, true, true);
+    vpKeyPoint concatenated("ORB", "ORB", "BruteForce-Hamming", vpKeyPoint::noFilterMatching);
+    concatenated.loadLearningData(singleFilename, true);
+    concatenated.loadLearningData(singleFilename, true, true);
+
+    std::vector<cv::KeyPoint> refTrainKeyPoints, trainKeyPoints;
+    reference.getTrainKeyPoints(refTrainKeyPoints);
+    appended.getTrainKeyPoints(trainKeyPoints);
+    CHECK(trainKeyPoints.size() == 2 * refTrainKeyPoints.size());
+    checkSameTrainKeyPoints(appended, concatenated);
+
+    appended.matchPoint(I);
+    concatenated.matchPoint(I);
+    REQUIRE(!concatenated.getMatches().empty());
+    checkSameMatches(appended.getMatches(), concatenated.getMatches());
+  }
+
+  SECTION("Missing training image")
+  {
+    for (size_t k = 0; k < binaryModes.size(); k++) {
+      const std::string filename =
+          vpIoTools::createFilePath(opath, binaryModes[k] ? "missing/learning.bin" : "missing/learning.xml");
+      reference.saveLearningData(filename, binaryModes[k], true);
+      vpIoTools::remove(vpIoTools::createFilePath(opath, "missing/train_image_000.png"));
+
+      // Reported when the learning file is loaded, not when the image is used
+      vpKeyPoint keypoints("ORB", "ORB", "BruteForce-Hamming");
+      CHECK_THROWS_AS(keypoints.loadLearningData(filename, binaryModes[k]), vpException);
+
+      reference.saveLearningData(filename, binaryModes[k], false);
+      CHECK_NOTHROW(keypoints.loadLearningData(filename, binaryModes[k]));
+    }
+  }
+
+  vpIoTools::remove(opath);
+}
+#endif
+
+TEST_CASE("Learning database benchmark", "[benchmark]")
+{
+  if (runBenchmark) {
+    const std::string opath = getOutputPath();
+    const std::string legacyFilename = vpIoTools::createFilePath(opath, "testKeyPointDatabase_legacy.bin");
+    const std::string filename = vpIoTools::createFilePath(opath, "testKeyPointDatabase.bin");
+    const LearningData data = generateLearningData(300000, 10, 5);
+    writeLegacy(legacyFilename, data);
+    vpKeyPointDatabase::write(filename, data.object(true));
+
+    BENCHMARK("Load legacy binary format")
+    {
+      LearningData loaded;
+      return readLegacy(legacyFilename, loaded);
+    };
+
+    BENCHMARK("Map database")
+    {
+      vpKeyPointDatabase db(filename);
+      return db.getObject(0).nbKeyPoints;
+    };
+
+    vpIoTools::remove(legacyFilename);
+    vpIoTools::remove(filename);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark comparing the legacy binary learning file with the mapped database"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,277 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Compare the pose estimation from contiguous arrays with the one from a
+ * list of vpPoint.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfPoseBatch.cpp
+
+  \brief Compare the pose estimation from contiguous arrays of
+  correspondences with the one from a list of vpPoint.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include <visp3/core/vpGaussRand.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpPose.h>
+
+namespace
+{
+
+bool runBenchmark = false;
+
+// Generate correspondences of points in front of the camera. A ratio of the
+// 2D points are replaced by random ones.
+void generateCorrespondences(unsigned int nbPoints, double outlierRatio, const vpHomogeneousMatrix &cMo,
+                             std::vector<double> &objectPoints, std::vector<double> &imagePoints,
+                             std::vector<bool> &isOutlier, std::vector<vpPoint> &points)
+{
+  vpUniRand rng(42);
+  vpGaussRand noise(0.0005, 0, 17);
+  objectPoints.resize(3 * nbPoints);
+  imagePoints.resize(2 * nbPoints);
+  isOutlier.resize(nbPoints);
+  points.resize(nbPoints);
+
+  for (unsigned int i = 0; i < nbPoints; i++) {
+    vpPoint &pt = points[i];
+    pt.setWorldCoordinates(rng.uniform(-0.2, 0.2), rng.uniform(-0.2, 0.2), rng.uniform(-0.1, 0.1));
+    pt.project(cMo);
+
+    isOutlier[i] = rng.uniform(0.0, 1.0) < outlierRatio;
+    if (isOutlier[i]) {
+      pt.set_x(rng.uniform(-0.5, 0.5));
+      pt.set_y(rng.uniform(-0.5, 0.5));
+    } else {
+      pt.set_x(pt.get_x() + noise());
+      pt.set_y(pt.get_y() + noise());
+    }
+
+    objectPoints[3 * i] = pt.get_oX();
+    objectPoints[3 * i + 1] = pt.get_oY();
+    objectPoints[3 * i + 2] = pt.get_oZ();
+    imagePoints[2 * i] = pt.get_x();
+    imagePoints[2 * i + 1] = pt.get_y();
+  }
+}
+
+double maxDifference(const vpHomogeneousMatrix &M1, const vpHomogeneousMatrix &M2)
+{
+  double diff = 0;
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 4; j++) {
+      diff = std::max(diff, std::fabs(M1[i][j] - M2[i][j]));
+    }
+  }
+  return diff;
+}
+}
+
+TEST_CASE("Residual and virtual visual servoing", "[vpPose]") {
+  const vpHomogeneousMatrix cMo(0.05, -0.02, 0.8, vpMath::rad(10), vpMath::rad(-15), vpMath::rad(20));
+  const vpHomogeneousMatrix cMo_init(0.06, -0.01, 0.82, vpMath::rad(12), vpMath::rad(-13), vpMath::rad(18));
+  std::vector<double> objectPoints, imagePoints;
+  std::vector<bool> isOutlier;
+  std::vector<vpPoint> points;
+
+  // Odd number of points to exercise the scalar tail of the SSE2 loops
+  generateCorrespondences(501, 0, cMo, objectPoints, imagePoints, isOutlier, points);
+
+  vpPose pose;
+  pose.addPoints(points);
+  CHECK(vpPose::computeResidual(objectPoints.data(), imagePoints.data(), 501, cMo_init) ==
+        Approx(pose.computeResidual(cMo_init)).epsilon(1e-12));
+
+  vpHomogeneousMatrix cMo_list = cMo_init, cMo_batch = cMo_init;
+  pose.setCovarianceComputation(true);
+  pose.poseVirtualVS(cMo_list);
+  const vpMatrix covariance_list = pose.getCovarianceMatrix();
+
+  vpPose poseBatch;
+  poseBatch.setCovarianceComputation(true);
+  poseBatch.poseVirtualVS(objectPoints.data(), imagePoints.data(), 501, cMo_batch);
+  const vpMatrix covariance_batch = poseBatch.getCovarianceMatrix();
+
+  CHECK(maxDifference(cMo_list, cMo_batch) < 1e-9);
+  CHECK(maxDifference(cMo, cMo_batch) < 1e-3);
+  REQUIRE(covariance_batch.getRows() == 6);
+  for (unsigned int i = 0; i < 6; i++) {
+    for (unsigned int j = 0; j < 6; j++) {
+      CHECK(covariance_batch[i][j] == Approx(covariance_list[i][j]).epsilon(1e-6).margin(1e-15));
+    }
+  }
+}
+
+TEST_CASE("RANSAC", "[vpPose]") {
+  const vpHomogeneousMatrix cMo(-0.03, 0.02, 0.7, vpMath::rad(-5), vpMath::rad(25), vpMath::rad(-10));
+  const unsigned int nbPoints = 1000;
+  std::vector<double> objectPoints, imagePoints;
+  std::vector<bool> isOutlier;
+  std::vector<vpPoint> points;
+  generateCorrespondences(nbPoints, 0.4, cMo, objectPoints, imagePoints, isOutlier, points);
+
+  std::vector<vpHomogeneousMatrix> poses;
+  std::vector<std::vector<unsigned int> > inliers;
+  for (int nbThreads = 1; nbThreads <= 4; nbThreads += 3) {
+    for (int run = 0; run < 2; run++) {
+      vpPose pose;
+      pose.setRansacThreshold(0.002);
+      pose.setRansacNbInliersToReachConsensus(nbPoints / 2);
+      pose.setRansacMaxTrials(500);
+      pose.setUseParallelRansac(nbThreads > 1);
+      pose.setNbParallelRansacThreads(nbThreads);
+
+      vpHomogeneousMatrix cMo_est;
+      REQUIRE(pose.poseRansac(objectPoints.data(), imagePoints.data(), nbPoints, cMo_est));
+      CHECK(maxDifference(cMo, cMo_est) < 2e-3);
+
+      const std::vector<unsigned int> index = pose.getRansacInlierIndex();
+      CHECK(pose.getRansacNbInliers() == index.size());
+      CHECK(pose.getRansacInliers().empty());
+      unsigned int nbTrueInliers = 0;
+      for (size_t i = 0; i < index.size(); i++) {
+        if (!isOutlier[index[i]]) {
+          nbTrueInliers++;
+        }
+      }
+      CHECK(nbTrueInliers > 0.95 * index.size());
+      CHECK(index.size() >= nbPoints / 2);
+
+      poses.push_back(cMo_est);
+      inliers.push_back(index);
+    }
+  }
+
+  // Same result when the same trials are run again
+  CHECK(maxDifference(poses[0], poses[1]) == 0);
+  CHECK(inliers[0] == inliers[1]);
+  CHECK(maxDifference(poses[2], poses[3]) == 0);
+  CHECK(inliers[2] == inliers[3]);
+
+  vpPose pose;
+  vpHomogeneousMatrix cMo_est;
+  CHECK_THROWS_AS(pose.poseRansac(objectPoints.data(), imagePoints.data(), 3, cMo_est), vpException);
+}
+
+TEST_CASE("Pose benchmark", "[benchmark]") {
+  if (runBenchmark) {
+    const vpHomogeneousMatrix cMo(0.05, -0.02, 0.8, vpMath::rad(10), vpMath::rad(-15), vpMath::rad(20));
+    const vpHomogeneousMatrix cMo_init(0.06, -0.01, 0.82, vpMath::rad(12), vpMath::rad(-13), vpMath::rad(18));
+    const unsigned int nbPoints = 5000;
+    std::vector<double> objectPoints, imagePoints;
+    std::vector<bool> isOutlier;
+    std::vector<vpPoint> points;
+
+    generateCorrespondences(nbPoints, 0, cMo, objectPoints, imagePoints, isOutlier, points);
+    BENCHMARK("Virtual visual servoing - vpPoint list") {
+      vpPose pose;
+      pose.addPoints(points);
+      vpHomogeneousMatrix M = cMo_init;
+      pose.poseVirtualVS(M);
+      return M;
+    };
+
+    BENCHMARK("Virtual visual servoing - contiguous arrays") {
+      vpPose pose;
+      vpHomogeneousMatrix M = cMo_init;
+      pose.poseVirtualVS(objectPoints.data(), imagePoints.data(), nbPoints, M);
+      return M;
+    };
+
+    generateCorrespondences(nbPoints, 0.5, cMo, objectPoints, imagePoints, isOutlier, points);
+    for (int parallel = 0; parallel < 2; parallel++) {
+      vpPose pose;
+      pose.setRansacThreshold(0.002);
+      pose.setRansacNbInliersToReachConsensus(nbPoints);
+      pose.setRansacMaxTrials(200);
+      pose.setUseParallelRansac(parallel == 1);
+
+      BENCHMARK(parallel ? "RANSAC - vpPoint list - parallel" : "RANSAC - vpPoint list") {
+        pose.clearPoint();
+        pose.addPoints(points);
+        vpHomogeneousMatrix M;
+        pose.poseRansac(M);
+        return M;
+      };
+
+      BENCHMARK(parallel ? "RANSAC - contiguous arrays - parallel" : "RANSAC - contiguous arrays") {
+        vpHomogeneousMatrix M;
+        pose.poseRansac(objectPoints.data(), imagePoints.data(), nbPoints, M);
+        return M;
+      };
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark comparing the pose estimation from vpPoint and from contiguous arrays"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
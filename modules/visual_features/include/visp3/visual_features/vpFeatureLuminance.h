@@ -74,6 +74,25 @@ public:
   \brief Class that defines the image luminance visual feature
 
   For more details see \cite Collewet08c.
+
+  Since there is one feature per pixel, the interaction matrix has as many
+  rows as pixels, i.e. about 300 000 for a 640x480 image. Control laws that
+  only need the normal equations \f$ {\bf L}^\top {\bf L} \f$ and
+  \f$ {\bf L}^\top {\bf e} \f$, like the Gauss-Newton and
+  Levenberg-Marquardt minimization of photometric visual servoing, should
+  rather call normalEquations() that accumulates them in a single
+  multi-threaded pass, without building the interaction matrix. When the
+  interaction matrix is computed at the desired position,
+  \f$ {\bf L}^\top {\bf L} \f$ is constant and interactionTransposeTimes()
+  only computes \f$ {\bf L}^\top {\bf e} \f$ at each iteration.
+
+  \code
+  vpMatrix LtL;
+  vpColVector Lte;
+  sI.buildFrom(I);
+  sI.normalEquations(sId, LtL, Lte); // L computed at the current position
+  vpColVector v = -lambda * (mu * diag + LtL).inverseByLU() * Lte;
+  \endcode
 */
 
 class VISP_EXPORT vpFeatureLuminance : public vpBasicFeature
@@ -120,6 +139,11 @@ public:
   void init(unsigned int _nbr, unsigned int _nbc, double _Z);
   vpMatrix interaction(unsigned int select = FEATURE_ALL);
   void interaction(vpMatrix &L);
+  void interactionTransposeTimes(const vpColVector &e, vpColVector &Lte, unsigned int nbThreads = 0) const;
+
+  void normalEquations(const vpColVector &e, vpMatrix &LtL, vpColVector &Lte, unsigned int nbThreads = 0) const;
+  void normalEquations(const vpBasicFeature &s_star, vpMatrix &LtL, vpColVector &Lte,
+                       unsigned int nbThreads = 0) const;
 
   vpFeatureLuminance &operator=(const vpFeatureLuminance &f);
 
@@ -130,6 +154,10 @@ public:
 
 public:
   vpCameraParameters cam;
+
+private:
+  void accumulateNormalEquations(const double *a, const double *b, vpMatrix *LtL, vpColVector &Lte,
+                                 unsigned int nbThreads) const;
 };
 
 #endif
@@ -36,6 +36,9 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <vector>
+
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpHomogeneousMatrix.h>
@@ -43,9 +46,15 @@
 #include <visp3/core/vpImageFilter.h>
 #include <visp3/core/vpMatrix.h>
 #include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpThreadPool.h>
 
 #include <visp3/visual_features/vpFeatureLuminance.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
 /*!
   \file vpFeatureLuminance.cpp
   \brief Class that defines the image luminance visual feature
@@ -258,6 +267,265 @@ vpMatrix vpFeatureLuminance::interaction(const unsigned int /* select */)
   return L;
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// 21 coefficients of the upper triangle of L^T L followed by the 6 ones of L^T e
+const unsigned int nbNormalTerms = 27;
+
+// The pixels are split in a fixed number of blocks summed in the same order
+// whatever the number of threads, so that the result does not depend on it
+const unsigned int nbNormalBlocks = 64;
+
+inline void accumulatePixel(const vpLuminance &p, double e, bool withLtL, double *acc)
+{
+  const double Zinv = 1 / p.Z;
+  const double xy = p.x * p.y;
+  double L[6];
+  L[0] = p.Ix * Zinv;
+  L[1] = p.Iy * Zinv;
+  L[2] = -(p.x * p.Ix + p.y * p.Iy) * Zinv;
+  L[3] = -p.Ix * xy - (1 + p.y * p.y) * p.Iy;
+  L[4] = (1 + p.x * p.x) * p.Ix + p.Iy * xy;
+  L[5] = p.Iy * p.x - p.Ix * p.y;
+
+  unsigned int k = 0;
+  if (withLtL) {
+    for (unsigned int i = 0; i < 6; i++) {
+      for (unsigned int j = i; j < 6; j++) {
+        acc[k++] += L[i] * L[j];
+      }
+    }
+  } else {
+    k = nbNormalTerms - 6;
+  }
+  for (unsigned int i = 0; i < 6; i++) {
+    acc[k++] += L[i] * e;
+  }
+}
+
+// Accumulate the normal equations of the pixels [start, end) with the error
+// a - b, or a when b is NULL. The terms of L^T L are left to 0 when withLtL
+// is false
+void accumulateBlock(const vpLuminance *pixInfo, const double *a, const double *b, bool withLtL, unsigned int start,
+                     unsigned int end, double *acc)
+{
+  for (unsigned int k = 0; k < nbNormalTerms; k++) {
+    acc[k] = 0;
+  }
+
+  unsigned int m = start;
+#if VISP_HAVE_SSE2
+  // Two pixels per iteration, one in each lane
+  __m128d sum[nbNormalTerms];
+  for (unsigned int k = 0; k < nbNormalTerms; k++) {
+    sum[k] = _mm_setzero_pd();
+  }
+
+  const __m128d one = _mm_set1_pd(1.0);
+  for (; m + 2 <= end; m += 2) {
+    const vpLuminance &p0 = pixInfo[m], &p1 = pixInfo[m + 1];
+    const __m128d x = _mm_set_pd(p1.x, p0.x), y = _mm_set_pd(p1.y, p0.y);
+    const __m128d Ix = _mm_set_pd(p1.Ix, p0.Ix), Iy = _mm_set_pd(p1.Iy, p0.Iy);
+    const __m128d Zinv = _mm_div_pd(one, _mm_set_pd(p1.Z, p0.Z));
+    __m128d e = _mm_loadu_pd(a + m);
+    if (b != NULL) {
+      e = _mm_sub_pd(e, _mm_loadu_pd(b + m));
+    }
+
+    const __m128d xy = _mm_mul_pd(x, y);
+    __m128d L[6];
+    L[0] = _mm_mul_pd(Ix, Zinv);
+    L[1] = _mm_mul_pd(Iy, Zinv);
+    L[2] = _mm_sub_pd(_mm_setzero_pd(), _mm_mul_pd(_mm_add_pd(_mm_mul_pd(x, Ix), _mm_mul_pd(y, Iy)), Zinv));
+    L[3] = _mm_sub_pd(_mm_sub_pd(_mm_setzero_pd(), _mm_mul_pd(Ix, xy)),
+                      _mm_mul_pd(_mm_add_pd(one, _mm_mul_pd(y, y)), Iy));
+    L[4] = _mm_add_pd(_mm_mul_pd(_mm_add_pd(one, _mm_mul_pd(x, x)), Ix), _mm_mul_pd(Iy, xy));
+    L[5] = _mm_sub_pd(_mm_mul_pd(Iy, x), _mm_mul_pd(Ix, y));
+
+    unsigned int k = 0;
+    if (withLtL) {
+      for (unsigned int i = 0; i < 6; i++) {
+        for (unsigned int j = i; j < 6; j++) {
+          sum[k] = _mm_add_pd(sum[k], _mm_mul_pd(L[i], L[j]));
+          k++;
+        }
+      }
+    } else {
+      k = nbNormalTerms - 6;
+    }
+    for (unsigned int i = 0; i < 6; i++) {
+      sum[k] = _mm_add_pd(sum[k], _mm_mul_pd(L[i], e));
+      k++;
+    }
+  }
+
+  for (unsigned int k = 0; k < nbNormalTerms; k++) {
+    double lanes[2];
+    _mm_storeu_pd(lanes, sum[k]);
+    acc[k] = lanes[0] + lanes[1];
+  }
+#endif
+
+  for (; m < end; m++) {
+    accumulatePixel(pixInfo[m], b != NULL ? a[m] - b[m] : a[m], withLtL, acc);
+  }
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+void vpFeatureLuminance::accumulateNormalEquations(const double *a, const double *b, vpMatrix *LtL, vpColVector &Lte,
+                                                   unsigned int nbThreads) const
+{
+  const bool withLtL = LtL != NULL;
+  const unsigned int blockSize = (dim_s + nbNormalBlocks - 1) / nbNormalBlocks;
+  std::vector<double> partial(nbNormalBlocks * nbNormalTerms, 0.0);
+  const vpLuminance *pixels = pixInfo;
+  const unsigned int size = dim_s;
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  double *partialPtr = partial.data();
+  vpThreadPool::getGlobalInstance().parallelFor(0, static_cast<int>(nbNormalBlocks), [=](int start, int end) {
+    for (int block = start; block < end; block++) {
+      const unsigned int first = (std::min)(block * blockSize, size);
+      const unsigned int last = (std::min)(first + blockSize, size);
+      accumulateBlock(pixels, a, b, withLtL, first, last, partialPtr + block * nbNormalTerms);
+    }
+  }, nbThreads, 1);
+#else
+  (void)nbThreads;
+  for (unsigned int block = 0; block < nbNormalBlocks; block++) {
+    const unsigned int first = (std::min)(block * blockSize, size);
+    const unsigned int last = (std::min)(first + blockSize, size);
+    accumulateBlock(pixels, a, b, withLtL, first, last, &partial[block * nbNormalTerms]);
+  }
+#endif
+
+  double acc[nbNormalTerms];
+  for (unsigned int k = 0; k < nbNormalTerms; k++) {
+    acc[k] = 0;
+  }
+  for (unsigned int block = 0; block < nbNormalBlocks; block++) {
+    for (unsigned int k = 0; k < nbNormalTerms; k++) {
+      acc[k] += partial[block * nbNormalTerms + k];
+    }
+  }
+
+  unsigned int k = 0;
+  if (withLtL) {
+    LtL->resize(6, 6, false, false);
+    for (unsigned int i = 0; i < 6; i++) {
+      for (unsigned int j = i; j < 6; j++) {
+        (*LtL)[i][j] = (*LtL)[j][i] = acc[k++];
+      }
+    }
+  } else {
+    k = nbNormalTerms - 6;
+  }
+  Lte.resize(6, false);
+  for (unsigned int i = 0; i < 6; i++) {
+    Lte[i] = acc[k++];
+  }
+}
+
+/*!
+  Compute the normal equations \f$ {\bf L}^\top {\bf L} \f$ and
+  \f$ {\bf L}^\top {\bf e} \f$ of the interaction matrix of the luminance
+  features, without building the interaction matrix. The result is the same
+  as with
+  \code
+  interaction(L);
+  LtL = L.AtA();
+  Lte = L.t() * e;
+  \endcode
+  for a cost and a memory footprint independent of the number of pixels for
+  the matrices. The pixels are split in blocks whose sums are added in a
+  fixed order, so that the result does not depend on the number of threads.
+
+  \param e : Error vector of size dimension_s(), typically computed by
+  error() from other luminance features. This is useful when the interaction
+  matrix is computed at the desired position.
+  \param LtL : Resulting 6x6 matrix \f$ {\bf L}^\top {\bf L} \f$.
+  \param Lte : Resulting 6-dimension vector \f$ {\bf L}^\top {\bf e} \f$.
+  \param nbThreads : Maximum number of threads of the pool returned by
+  vpThreadPool::getGlobalInstance(). If 0, all the threads of the pool are
+  used. Requires c++11, otherwise a single thread is used.
+
+  \exception vpException::dimensionError : If the size of \e e is not
+  dimension_s().
+*/
+void vpFeatureLuminance::normalEquations(const vpColVector &e, vpMatrix &LtL, vpColVector &Lte,
+                                         unsigned int nbThreads) const
+{
+  if (e.getRows() != dim_s) {
+    throw vpException(vpException::dimensionError, "Error vector of size %u instead of %u", e.getRows(), dim_s);
+  }
+
+  accumulateNormalEquations(e.data, NULL, &LtL, Lte, nbThreads);
+}
+
+/*!
+  Compute \f$ {\bf L}^\top {\bf e} \f$ without building the interaction
+  matrix, as normalEquations() but without \f$ {\bf L}^\top {\bf L} \f$.
+  This is useful when the interaction matrix is computed at the desired
+  position: \f$ {\bf L}^\top {\bf L} \f$ is then constant and only needs
+  to be computed once, while \f$ {\bf e} \f$ changes at each iteration.
+
+  \param e : Error vector of size dimension_s().
+  \param Lte : Resulting 6-dimension vector \f$ {\bf L}^\top {\bf e} \f$.
+  \param nbThreads : Maximum number of threads of the pool returned by
+  vpThreadPool::getGlobalInstance(). If 0, all the threads of the pool are
+  used.
+
+  \exception vpException::dimensionError : If the size of \e e is not
+  dimension_s().
+*/
+void vpFeatureLuminance::interactionTransposeTimes(const vpColVector &e, vpColVector &Lte,
+                                                   unsigned int nbThreads) const
+{
+  if (e.getRows() != dim_s) {
+    throw vpException(vpException::dimensionError, "Error vector of size %u instead of %u", e.getRows(), dim_s);
+  }
+
+  accumulateNormalEquations(e.data, NULL, NULL, Lte, nbThreads);
+}
+
+/*!
+  Compute the normal equations \f$ {\bf L}^\top {\bf L} \f$ and
+  \f$ {\bf L}^\top {\bf e} \f$ of the interaction matrix of the luminance
+  features, the error \f$ {\bf e} = (I-I^*) \f$ being computed on the fly
+  from the desired features. Neither the interaction matrix nor the error
+  vector are built.
+
+  \param s_star : Desired luminance features, built from images of the same
+  size and with the same border.
+  \param LtL : Resulting 6x6 matrix \f$ {\bf L}^\top {\bf L} \f$.
+  \param Lte : Resulting 6-dimension vector \f$ {\bf L}^\top {\bf e} \f$.
+  \param nbThreads : Maximum number of threads of the pool returned by
+  vpThreadPool::getGlobalInstance(). If 0, all the threads of the pool are
+  used.
+
+  \exception vpException::badValue : If \e s_star is not a vpFeatureLuminance.
+  \exception vpException::dimensionError : If the features do not have the
+  same dimension.
+
+  \sa normalEquations(const vpColVector &, vpMatrix &, vpColVector &, unsigned int) const
+*/
+void vpFeatureLuminance::normalEquations(const vpBasicFeature &s_star, vpMatrix &LtL, vpColVector &Lte,
+                                         unsigned int nbThreads) const
+{
+  const vpFeatureLuminance *luminance = dynamic_cast<const vpFeatureLuminance *>(&s_star);
+  if (luminance == NULL) {
+    throw vpException(vpException::badValue, "Desired features are not luminance features");
+  }
+  if (luminance->dim_s != dim_s) {
+    throw vpException(vpException::dimensionError, "Desired features of dimension %u instead of %u", luminance->dim_s,
+                      dim_s);
+  }
+
+  accumulateNormalEquations(s.data, luminance->s.data, &LtL, Lte, nbThreads);
+}
+
 /*!
   Compute the error \f$ (I-I^*)\f$ between the current and the desired
 
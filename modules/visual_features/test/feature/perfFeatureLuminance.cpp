@@ -0,0 +1,228 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Compare the normal equations of the luminance features with the ones
+ * computed from the full interaction matrix.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfFeatureLuminance.cpp
+
+  \brief Compare the streaming normal equations of vpFeatureLuminance with
+  the ones computed from the full interaction matrix.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <cmath>
+
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/visual_features/vpFeatureLuminance.h>
+
+namespace
+{
+
+bool runBenchmark = false;
+
+// Smooth textured image, shifted to simulate another camera position
+void generateImage(unsigned int height, unsigned int width, double shift, vpImage<unsigned char> &I)
+{
+  I.resize(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      const double u = j + shift, v = i + 0.5 * shift;
+      I[i][j] = static_cast<unsigned char>(127.5 + 60 * sin(u / 13.0) * cos(v / 17.0) + 60 * sin((u + v) / 29.0));
+    }
+  }
+}
+
+void buildFeatures(const vpImage<unsigned char> &I, vpFeatureLuminance &s)
+{
+  vpCameraParameters cam(600, 600, I.getWidth() / 2.0, I.getHeight() / 2.0);
+  s.init(I.getHeight(), I.getWidth(), 0.8);
+  s.setCameraParameters(cam);
+  vpImage<unsigned char> I_copy = I;
+  s.buildFrom(I_copy);
+}
+
+void checkClose(const vpMatrix &A, const vpMatrix &B)
+{
+  REQUIRE(A.getRows() == B.getRows());
+  REQUIRE(A.getCols() == B.getCols());
+  for (unsigned int i = 0; i < A.getRows(); i++) {
+    for (unsigned int j = 0; j < A.getCols(); j++) {
+      CHECK(A[i][j] == Approx(B[i][j]).epsilon(1e-9).margin(1e-6));
+    }
+  }
+}
+}
+
+TEST_CASE("Luminance normal equations", "[vpFeatureLuminance]") {
+  vpThreadPool::getGlobalInstance().setNbThreads(4);
+
+  const unsigned int sizes[][2] = {{120, 160}, {31, 27}, {23, 21}};
+  for (size_t k = 0; k < 3; k++) {
+    vpImage<unsigned char> I, Id;
+    generateImage(sizes[k][0], sizes[k][1], 3.0, I);
+    generateImage(sizes[k][0], sizes[k][1], 0.0, Id);
+
+    vpFeatureLuminance s, sd;
+    buildFeatures(I, s);
+    buildFeatures(Id, sd);
+
+    vpMatrix L;
+    s.interaction(L);
+    vpColVector e;
+    s.error(sd, e);
+    const vpMatrix LtL_ref = L.AtA();
+    const vpMatrix Lte_ref = L.t() * e;
+
+    vpMatrix LtL, LtL_single;
+    vpColVector Lte, Lte_single;
+    s.normalEquations(e, LtL, Lte);
+    checkClose(LtL, LtL_ref);
+    checkClose(Lte, Lte_ref);
+
+    // The error computed on the fly, and a result independent of the number of threads
+    s.normalEquations(sd, LtL, Lte);
+    s.normalEquations(sd, LtL_single, Lte_single, 1);
+    checkClose(LtL, LtL_ref);
+    checkClose(Lte, Lte_ref);
+    CHECK(LtL == LtL_single);
+    CHECK(Lte == Lte_single);
+
+    // L^T e alone, as computed with L^T L
+    vpColVector Lte_only;
+    s.normalEquations(e, LtL, Lte);
+    s.interactionTransposeTimes(e, Lte_only);
+    CHECK(Lte_only == Lte);
+  }
+
+  vpImage<unsigned char> I;
+  generateImage(40, 40, 0.0, I);
+  vpFeatureLuminance s, s_small;
+  buildFeatures(I, s);
+  generateImage(30, 30, 0.0, I);
+  buildFeatures(I, s_small);
+  vpMatrix LtL;
+  vpColVector Lte;
+
+  // No pixel inside the border
+  generateImage(20, 20, 0.0, I);
+  vpFeatureLuminance s_empty;
+  buildFeatures(I, s_empty);
+  s_empty.normalEquations(s_empty, LtL, Lte);
+  CHECK(LtL.getRows() == 6);
+  CHECK(LtL.frobeniusNorm() == 0);
+  CHECK(Lte.frobeniusNorm() == 0);
+
+  CHECK_THROWS_AS(s.normalEquations(s_small, LtL, Lte), vpException);
+  CHECK_THROWS_AS(s.normalEquations(vpColVector(3), LtL, Lte), vpException);
+  CHECK_THROWS_AS(s.interactionTransposeTimes(vpColVector(3), Lte), vpException);
+}
+
+TEST_CASE("Luminance normal equations benchmark", "[benchmark]") {
+  if (runBenchmark) {
+    vpImage<unsigned char> I, Id;
+    generateImage(480, 640, 3.0, I);
+    generateImage(480, 640, 0.0, Id);
+
+    vpFeatureLuminance s, sd;
+    buildFeatures(I, s);
+    buildFeatures(Id, sd);
+
+    vpMatrix L, LtL;
+    vpColVector e, Lte;
+
+    BENCHMARK("Interaction matrix, L^T L and L^T e") {
+      s.interaction(L);
+      s.error(sd, e);
+      LtL = L.AtA();
+      Lte = L.t() * e;
+      return Lte;
+    };
+
+    BENCHMARK("Normal equations (1 thread)") {
+      s.normalEquations(sd, LtL, Lte, 1);
+      return Lte;
+    };
+
+    BENCHMARK("Normal equations") {
+      s.normalEquations(sd, LtL, Lte);
+      return Lte;
+    };
+
+    s.error(sd, e);
+    BENCHMARK("L^T e only") {
+      s.interactionTransposeTimes(e, Lte);
+      return Lte;
+    };
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()   // Get Catch's composite command line parser
+      | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+      ["--benchmark"]        // the option names it will respond to
+      ("run benchmark comparing the normal equations with the full interaction matrix"); // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
@@ -82,12 +82,10 @@ int main(int argc, char **argv)
     //! [Gradients y]
     display(dIy, "Gradient dIy");
 
-//! [Canny]
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020100)
+    //! [Canny]
     vpImage<unsigned char> C;
     vpImageFilter::canny(I, C, 5, 15, 3);
     display(C, "Canny");
-#endif
     //! [Canny]
 
     //! [Convolution kernel]